@@ -71,7 +71,7 @@ namespace Fertilizer {
         return {};
     }
 
-    ConversionResult convert(const fspath& inputFile, const fspath& outputFile, bool forceConvert) {
+    ConversionResult convert(const fspath& inputFile, const fspath& outputFile, bool forceConvert, const ConversionOptions& options) {
         auto convertorIt = ConversionFunctions.find(inputFile.extension().string());
         if(convertorIt == ConversionFunctions.end()) {
             return {
@@ -99,7 +99,7 @@ namespace Fertilizer {
             std::filesystem::create_directories(outputFolder);
         }
 
-        ConversionResult result = convertorIt->second.func(inputFile, outputFile);
+        ConversionResult result = convertorIt->second.func(inputFile, outputFile, options);
 
         if(result.errorCode == ConversionResultError::Success) {
             makeTimestampsMatch(inputFile, outputFile);
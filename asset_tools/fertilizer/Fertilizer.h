@@ -21,7 +21,16 @@ namespace Fertilizer {
         std::string errorMessage;
     };
 
-    using ConversionFunction = ConversionResult(*)(const std::filesystem::path& inputFile, const std::filesystem::path& outputFile);
+    /// Options given on the command line, see README.md
+    struct ConversionOptions {
+        /// Write the vertices of models in the compact Carrot::CompressedVertex format instead of the standard glTF attributes
+        bool compressVertices = false;
+
+        /// Also write static models in the engine-native binary format (.cmodel), next to the glTF output
+        bool binaryModel = false;
+    };
+
+    using ConversionFunction = ConversionResult(*)(const std::filesystem::path& inputFile, const std::filesystem::path& outputFile, const ConversionOptions& options);
 
     /**
      * Returns true iif the format of the given file path is one Fertilizer cares about.
@@ -46,5 +55,5 @@ namespace Fertilizer {
      */
     ConversionResult copyConvert(const std::filesystem::path& inputFile, const std::filesystem::path& outputFile);
 
-    ConversionResult convert(const std::filesystem::path& inputFile, const std::filesystem::path& outputFile, bool forceConvert);
+    ConversionResult convert(const std::filesystem::path& inputFile, const std::filesystem::path& outputFile, bool forceConvert, const ConversionOptions& options = {});
 }
\ No newline at end of file
@@ -9,7 +9,7 @@
 #include <stb_image.h>
 
 namespace Fertilizer {
-    ConversionResult compressTexture(const std::filesystem::path& inputFile, const std::filesystem::path& outputFile) {
+    ConversionResult compressTexture(const std::filesystem::path& inputFile, const std::filesystem::path& outputFile, const ConversionOptions& options) {
         int w, h, comp;
         stbi_uc* pixels = stbi_load(inputFile.string().c_str(), &w, &h, &comp, 0);
         std::size_t srcSize = w * h * comp;
@@ -9,5 +9,5 @@
 #include <Fertilizer.h>
 
 namespace Fertilizer {
-    ConversionResult compressTexture(const std::filesystem::path& inputFile, const std::filesystem::path& outputFile);
+    ConversionResult compressTexture(const std::filesystem::path& inputFile, const std::filesystem::path& outputFile, const ConversionOptions& options);
 }
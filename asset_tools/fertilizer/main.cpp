@@ -24,6 +24,7 @@ int main(int argc, char** argv) {
     bool hasInput = false;
     bool hasOutput = false;
     bool forceConvert = false;
+    Fertilizer::ConversionOptions options;
     std::filesystem::path inputFile;
     std::filesystem::path outputFile;
     for (int i = 1; i < argc;) {
@@ -32,6 +33,10 @@ int main(int argc, char** argv) {
             recursive = true;
         } else if(arg == "-f" || arg == "--force") {
             forceConvert = true;
+        } else if(arg == "--compress-vertices") {
+            options.compressVertices = true;
+        } else if(arg == "--binary-model") {
+            options.binaryModel = true;
         } else {
             if(!hasInput) {
                 inputFile = arg;
@@ -107,7 +112,7 @@ int main(int argc, char** argv) {
                 const auto& input = allInputs[index];
                 const auto& output = allOutputs[index];
                 std::cout << Carrot::sprintf("Converting %s (%llu / %llu)\n", input.string().c_str(), index+1, allInputs.size());
-                Fertilizer::ConversionResult result = Fertilizer::convert(input, output, forceConvert);
+                Fertilizer::ConversionResult result = Fertilizer::convert(input, output, forceConvert, options);
                 switch(result.errorCode) {
                     case Fertilizer::ConversionResultError::Success:
                         break;
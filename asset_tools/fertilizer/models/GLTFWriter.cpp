@@ -8,12 +8,14 @@
 #include "glm/detail/type_quat.hpp"
 #include "glm/gtx/matrix_decompose.hpp"
 #include "core/scene/GLTFLoader.h" // for extension names
+#include "core/render/VertexCompression.h"
 
 namespace Fertilizer {
     static glm::mat4 carrotSpaceToGLTFSpace = glm::rotate(glm::mat4{1.0f}, -glm::pi<float>()/2.0f, glm::vec3(1,0,0));
 
     struct Payload {
         tinygltf::Model& glTFModel;
+        const ConversionOptions& options;
 
         bool exportedNodes = false;
         std::unordered_map<Carrot::IO::VFS::Path, int> textureIndices;
@@ -36,6 +38,10 @@ namespace Fertilizer {
         return { v.x, v.y, v.z, v.w };
     }
 
+    static tinygltf::Value::Array toValueArray(const glm::vec3& v) {
+        return { tinygltf::Value { static_cast<double>(v.x) }, tinygltf::Value { static_cast<double>(v.y) }, tinygltf::Value { static_cast<double>(v.z) } };
+    }
+
     static std::vector<double> vectorOfDoubles(const glm::quat& q) {
         return { q.x, q.y, q.z, q.w };
     }
@@ -219,7 +225,8 @@ namespace Fertilizer {
         std::uint32_t accessorIndex = model.accessors.size();
         for(const auto& primitive : scene.primitives) {
             const bool isSkinned = primitive.isSkinned;
-            const std::size_t vertexSize = isSkinned ? sizeof(Carrot::SkinnedVertex) : sizeof(Carrot::Vertex);
+            const bool compressVertices = payload.options.compressVertices;
+            std::size_t vertexSize = isSkinned ? sizeof(Carrot::SkinnedVertex) : sizeof(Carrot::Vertex);
             const std::size_t vertexCount = isSkinned ? primitive.skinnedVertices.size() : primitive.vertices.size();
             const void* vertexData = nullptr;
             std::vector<Carrot::SkinnedVertex> skinnedVerticesWithRemappedBoneIDs;
@@ -241,6 +248,9 @@ namespace Fertilizer {
                         const int boneID = payload.nodeMap.at(pTreeNode);
                         auto remapIter = payload.boneRemap.find(boneID);
                         if(remapIter != payload.boneRemap.end()) {
+                            // stored on 8 bits, both in SkinnedVertex and in compressed vertices
+                            verify(remapIter->second <= Carrot::VertexCompression::MaxBoneID,
+                                   Carrot::sprintf("Primitive '%s' uses bone %d, but bone IDs above %d are not supported", primitive.name.c_str(), remapIter->second, Carrot::VertexCompression::MaxBoneID));
                             return remapIter->second;
                         } else {
                             return 0;
@@ -258,6 +268,26 @@ namespace Fertilizer {
                 vertexData = primitive.vertices.data();
             }
 
+            // positions are quantized relative to the bounds of the entire primitive: vertices are shared between meshlets
+            Carrot::QuantizationBounds quantizationBounds;
+            std::vector<Carrot::CompressedVertex> compressedVertices;
+            std::vector<Carrot::CompressedSkinnedVertex> compressedSkinnedVertices;
+            if(compressVertices) {
+                if(isSkinned) {
+                    quantizationBounds = Carrot::QuantizationBounds::compute(skinnedVerticesWithRemappedBoneIDs);
+                    compressedSkinnedVertices.resize(vertexCount);
+                    Carrot::VertexCompression::compress(skinnedVerticesWithRemappedBoneIDs, quantizationBounds, compressedSkinnedVertices);
+                    vertexData = compressedSkinnedVertices.data();
+                    vertexSize = sizeof(Carrot::CompressedSkinnedVertex);
+                } else {
+                    quantizationBounds = Carrot::QuantizationBounds::compute(primitive.vertices);
+                    compressedVertices.resize(vertexCount);
+                    Carrot::VertexCompression::compress(primitive.vertices, quantizationBounds, compressedVertices);
+                    vertexData = compressedVertices.data();
+                    vertexSize = sizeof(Carrot::CompressedVertex);
+                }
+            }
+
             tinygltf::Buffer& geometryBuffer = isSkinned ? *pSkinnedGeometryBuffer : *pStaticGeometryBuffer;
             const int geometryBufferViewIndex = isSkinned ? skinnedVertexBufferViewIndex : staticVertexBufferViewIndex;
 
@@ -310,36 +340,54 @@ namespace Fertilizer {
                 accessorIndex++;
             }
 
-            int positionAccessor = makeVertexAttributeAccessor(Carrot::sprintf("%s-positions", primitive.name.c_str()),
-                                                               TINYGLTF_TYPE_VEC3, TINYGLTF_COMPONENT_TYPE_FLOAT,
-                                                               offsetof(Carrot::SkinnedVertex, pos)+geometryStartOffset);
-            glTFPrimitive.attributes["POSITION"] = positionAccessor;
-            model.accessors[positionAccessor].minValues = vectorOfDoubles(primitive.minPos);
-            model.accessors[positionAccessor].maxValues = vectorOfDoubles(primitive.maxPos);
-
-            glTFPrimitive.attributes["NORMAL"] =
-                    makeVertexAttributeAccessor(Carrot::sprintf("%s-normals", primitive.name.c_str()),
-                                                TINYGLTF_TYPE_VEC3, TINYGLTF_COMPONENT_TYPE_FLOAT,
-                                                offsetof(Carrot::SkinnedVertex, normal)+geometryStartOffset);
-            glTFPrimitive.attributes["TEXCOORD_0"] =
-                    makeVertexAttributeAccessor(Carrot::sprintf("%s-texCoords0", primitive.name.c_str()),
-                                                TINYGLTF_TYPE_VEC2, TINYGLTF_COMPONENT_TYPE_FLOAT,
-                                                offsetof(Carrot::SkinnedVertex, uv)+geometryStartOffset);
-            glTFPrimitive.attributes["TANGENT"] =
-                    makeVertexAttributeAccessor(Carrot::sprintf("%s-tangents", primitive.name.c_str()),
-                                                TINYGLTF_TYPE_VEC4, TINYGLTF_COMPONENT_TYPE_FLOAT,
-                                                offsetof(Carrot::SkinnedVertex, tangent)+geometryStartOffset);
-
-            if(isSkinned) {
-                glTFPrimitive.attributes["JOINTS_0"] =
-                        makeVertexAttributeAccessor(Carrot::sprintf("%s-joints", primitive.name.c_str()),
-                                                    TINYGLTF_TYPE_VEC4, TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE,
-                                                    offsetof(Carrot::SkinnedVertex, boneIDs)+geometryStartOffset);
-
-                glTFPrimitive.attributes["WEIGHTS_0"] =
-                        makeVertexAttributeAccessor(Carrot::sprintf("%s-weights", primitive.name.c_str()),
+            if(compressVertices) {
+                tinygltf::Accessor& accessor = model.accessors.emplace_back();
+                accessor.bufferView = geometryBufferViewIndex;
+                accessor.byteOffset = geometryStartOffset;
+                accessor.count = geometryByteCount;
+                accessor.name = Carrot::sprintf("%s-compressed-vertices", primitive.name.c_str());
+                accessor.type = TINYGLTF_TYPE_SCALAR;
+                accessor.componentType = TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE;
+
+                tinygltf::Value::Object compressedVerticesExtension;
+                compressedVerticesExtension["vertices"] = tinygltf::Value { static_cast<int>(accessorIndex) };
+                compressedVerticesExtension["skinned"] = tinygltf::Value { isSkinned };
+                compressedVerticesExtension["quantization_min"] = tinygltf::Value { toValueArray(quantizationBounds.min) };
+                compressedVerticesExtension["quantization_extent"] = tinygltf::Value { toValueArray(quantizationBounds.extent) };
+                glTFPrimitive.extensions[Carrot::Render::GLTFLoader::CARROT_COMPRESSED_VERTICES_EXTENSION_NAME] = tinygltf::Value { std::move(compressedVerticesExtension) };
+                accessorIndex++;
+            } else {
+                int positionAccessor = makeVertexAttributeAccessor(Carrot::sprintf("%s-positions", primitive.name.c_str()),
+                                                                   TINYGLTF_TYPE_VEC3, TINYGLTF_COMPONENT_TYPE_FLOAT,
+                                                                   offsetof(Carrot::SkinnedVertex, pos)+geometryStartOffset);
+                glTFPrimitive.attributes["POSITION"] = positionAccessor;
+                model.accessors[positionAccessor].minValues = vectorOfDoubles(primitive.minPos);
+                model.accessors[positionAccessor].maxValues = vectorOfDoubles(primitive.maxPos);
+
+                glTFPrimitive.attributes["NORMAL"] =
+                        makeVertexAttributeAccessor(Carrot::sprintf("%s-normals", primitive.name.c_str()),
+                                                    TINYGLTF_TYPE_VEC3, TINYGLTF_COMPONENT_TYPE_FLOAT,
+                                                    offsetof(Carrot::SkinnedVertex, normal)+geometryStartOffset);
+                glTFPrimitive.attributes["TEXCOORD_0"] =
+                        makeVertexAttributeAccessor(Carrot::sprintf("%s-texCoords0", primitive.name.c_str()),
+                                                    TINYGLTF_TYPE_VEC2, TINYGLTF_COMPONENT_TYPE_FLOAT,
+                                                    offsetof(Carrot::SkinnedVertex, uv)+geometryStartOffset);
+                glTFPrimitive.attributes["TANGENT"] =
+                        makeVertexAttributeAccessor(Carrot::sprintf("%s-tangents", primitive.name.c_str()),
                                                     TINYGLTF_TYPE_VEC4, TINYGLTF_COMPONENT_TYPE_FLOAT,
-                                                    offsetof(Carrot::SkinnedVertex, boneWeights)+geometryStartOffset);
+                                                    offsetof(Carrot::SkinnedVertex, tangent)+geometryStartOffset);
+
+                if(isSkinned) {
+                    glTFPrimitive.attributes["JOINTS_0"] =
+                            makeVertexAttributeAccessor(Carrot::sprintf("%s-joints", primitive.name.c_str()),
+                                                        TINYGLTF_TYPE_VEC4, TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE,
+                                                        offsetof(Carrot::SkinnedVertex, boneIDs)+geometryStartOffset);
+
+                    glTFPrimitive.attributes["WEIGHTS_0"] =
+                            makeVertexAttributeAccessor(Carrot::sprintf("%s-weights", primitive.name.c_str()),
+                                                        TINYGLTF_TYPE_VEC4, TINYGLTF_COMPONENT_TYPE_FLOAT,
+                                                        offsetof(Carrot::SkinnedVertex, boneWeights)+geometryStartOffset);
+                }
             }
 
             // write meshlets
@@ -451,7 +499,7 @@ namespace Fertilizer {
             verticesBufferView.byteLength = pStaticGeometryBuffer->data.size();
             verticesBufferView.byteOffset = 0;
             verticesBufferView.buffer = staticVertexBufferIndex;
-            verticesBufferView.byteStride = sizeof(Carrot::Vertex);
+            verticesBufferView.byteStride = payload.options.compressVertices ? sizeof(Carrot::CompressedVertex) : sizeof(Carrot::Vertex);
         }
         if(pSkinnedGeometryBuffer != nullptr)
         {
@@ -460,7 +508,7 @@ namespace Fertilizer {
             verticesBufferView.byteLength = pSkinnedGeometryBuffer->data.size();
             verticesBufferView.byteOffset = 0;
             verticesBufferView.buffer = skinnedVertexBufferIndex;
-            verticesBufferView.byteStride = sizeof(Carrot::SkinnedVertex);
+            verticesBufferView.byteStride = payload.options.compressVertices ? sizeof(Carrot::CompressedSkinnedVertex) : sizeof(Carrot::SkinnedVertex);
         }
     }
 
@@ -859,15 +907,22 @@ namespace Fertilizer {
         model.bufferViews[animationBufferViewIndex].byteLength = animationData.size();
     }
 
-    tinygltf::Model writeAsGLTF(const std::string& modelName, const Carrot::Render::LoadedScene& scene) {
+    tinygltf::Model writeAsGLTF(const std::string& modelName, const Carrot::Render::LoadedScene& scene, const ConversionOptions& options) {
         tinygltf::Model model;
 
         model.asset.generator = "Fertilizer v1";
         model.asset.version = "2.0";
         model.extensionsUsed.emplace_back(Carrot::Render::GLTFLoader::CARROT_MESHLETS_EXTENSION_NAME);
 
+        if(options.compressVertices) {
+            // vertices cannot be read without support for this extension
+            model.extensionsUsed.emplace_back(Carrot::Render::GLTFLoader::CARROT_COMPRESSED_VERTICES_EXTENSION_NAME);
+            model.extensionsRequired.emplace_back(Carrot::Render::GLTFLoader::CARROT_COMPRESSED_VERTICES_EXTENSION_NAME);
+        }
+
         Payload payload {
                 .glTFModel = model,
+                .options = options,
         };
 
         writeTextures(payload, scene);
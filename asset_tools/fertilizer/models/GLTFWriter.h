@@ -6,7 +6,8 @@
 
 #include <core/utils/CarrotTinyGLTF.h>
 #include <core/scene/LoadedScene.h>
+#include <Fertilizer.h>
 
 namespace Fertilizer {
-    tinygltf::Model writeAsGLTF(const std::string& modelName, const Carrot::Render::LoadedScene& scene);
+    tinygltf::Model writeAsGLTF(const std::string& modelName, const Carrot::Render::LoadedScene& scene, const ConversionOptions& options = {});
 }
\ No newline at end of file
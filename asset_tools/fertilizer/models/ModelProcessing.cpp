@@ -9,6 +9,7 @@
 #include <core/Macros.h>
 #include <core/scene/GLTFLoader.h>
 #include <models/GLTFWriter.h>
+#include <fstream>
 #include <unordered_set>
 #include <core/io/Logging.hpp>
 #include <glm/gtx/component_wise.hpp>
@@ -27,6 +28,7 @@
 #include <robin_hood.h>
 #include <core/math/Sphere.h>
 #include <core/scene/AssimpLoader.h>
+#include <core/scene/BinaryModel.h>
 #include <glm/gtx/norm.hpp>
 
 #include "assimp/Importer.hpp"
@@ -896,7 +898,33 @@ namespace Fertilizer {
         }
     }
 
-    static void processGLTFModel(const std::string& modelName, tinygltf::Model& model) {
+    /// Writes 'scene' in the binary model format, with the same name as 'outputFile' but the .cmodel extension
+    static ConversionResult writeBinaryModel(LoadedScene& scene, const std::string& modelName, const std::filesystem::path& outputFile) {
+        if(!BinaryModel::canWrite(scene)) {
+            Carrot::Log::warn("%s has skinned meshes or animations, which binary models do not support. Only the glTF file is written", modelName.c_str());
+            return {
+                .errorCode = ConversionResultError::Success,
+            };
+        }
+
+        scene.debugName = modelName;
+        const std::vector<std::uint8_t> bytes = BinaryModel::write(scene);
+        fspath binaryFile = outputFile;
+        binaryFile.replace_extension(".cmodel");
+        std::ofstream out { binaryFile, std::ios::binary };
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if(!out) {
+            return {
+                .errorCode = ConversionResultError::ModelCompressionError,
+                .errorMessage = "Could not write binary model",
+            };
+        }
+        return {
+            .errorCode = ConversionResultError::Success,
+        };
+    }
+
+    static ConversionResult processGLTFModel(const std::string& modelName, tinygltf::Model& model, const std::filesystem::path& outputFile, const ConversionOptions& options) {
         Carrot::NotificationID loadNotifID = Carrot::UserNotifications::getInstance().showNotification({.title = Carrot::sprintf("Processing %s", modelName.c_str())});
         CLEANUP(Carrot::UserNotifications::getInstance().closeNotification(loadNotifID));
 
@@ -905,16 +933,26 @@ namespace Fertilizer {
 
         processScene(scene, modelName, loadNotifID);
 
+        if(options.binaryModel) {
+            ConversionResult result = writeBinaryModel(scene, modelName, outputFile);
+            if(result.errorCode != ConversionResultError::Success) {
+                return result;
+            }
+        }
+
         // re-export model
-        tinygltf::Model reexported = std::move(writeAsGLTF(modelName, scene));
+        tinygltf::Model reexported = std::move(writeAsGLTF(modelName, scene, options));
         // keep copyright+author info
         model.asset.extras = std::move(model.asset.extras);
         model.asset.copyright = std::move(model.asset.copyright);
 
         model = std::move(reexported);
+        return {
+            .errorCode = ConversionResultError::Success,
+        };
     }
 
-    ConversionResult processAssimp(const std::filesystem::path& inputFile, const std::filesystem::path& outputFile) {
+    ConversionResult processAssimp(const std::filesystem::path& inputFile, const std::filesystem::path& outputFile, const ConversionOptions& options) {
         AssimpLoader loader;
         Assimp::Importer importer;
         LoadedScene scene = std::move(loader.load(inputFile.string(), importer));
@@ -926,8 +964,15 @@ namespace Fertilizer {
             processScene(scene, modelName, loadNotifID);
         }
 
+        if(options.binaryModel) {
+            ConversionResult result = writeBinaryModel(scene, modelName, outputFile);
+            if(result.errorCode != ConversionResultError::Success) {
+                return result;
+            }
+        }
+
         tinygltf::TinyGLTF gltf;
-        tinygltf::Model reexported = std::move(writeAsGLTF(modelName, scene));
+        tinygltf::Model reexported = std::move(writeAsGLTF(modelName, scene, options));
         if(!gltf.WriteGltfSceneToFile(&reexported, outputFile.string(), false, false, true/* pretty-print */, false)) {
             return {
                 .errorCode = ConversionResultError::ModelCompressionError,
@@ -941,7 +986,7 @@ namespace Fertilizer {
     }
 
 
-    ConversionResult processGLTF(const std::filesystem::path& inputFile, const std::filesystem::path& outputFile) {
+    ConversionResult processGLTF(const std::filesystem::path& inputFile, const std::filesystem::path& outputFile, const ConversionOptions& options) {
         using namespace tinygltf;
 
         tinygltf::TinyGLTF parser;
@@ -980,7 +1025,10 @@ namespace Fertilizer {
         // ----------
 
         // buffers are regenerated inside 'processModel' method too, so we don't copy the .bin file
-        processGLTFModel(Carrot::toString(outputFile.stem().u8string()), model);
+        ConversionResult processResult = processGLTFModel(Carrot::toString(outputFile.stem().u8string()), model, outputFile, options);
+        if(processResult.errorCode != ConversionResultError::Success) {
+            return processResult;
+        }
 
         // ----------
 
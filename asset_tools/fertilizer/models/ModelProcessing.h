@@ -8,6 +8,6 @@
 #include <Fertilizer.h>
 
 namespace Fertilizer {
-    ConversionResult processGLTF(const std::filesystem::path& inputFile, const std::filesystem::path& outputFile);
-    ConversionResult processAssimp(const std::filesystem::path& inputFile, const std::filesystem::path& outputFile);
+    ConversionResult processGLTF(const std::filesystem::path& inputFile, const std::filesystem::path& outputFile, const ConversionOptions& options);
+    ConversionResult processAssimp(const std::filesystem::path& inputFile, const std::filesystem::path& outputFile, const ConversionOptions& options);
 }
@@ -0,0 +1,327 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "Compiler.h"
+#include "FileIncluder.h"
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <core/data/ShaderMetadata.h>
+#include <core/data/ShaderReflection.h>
+#include <core/utils/stringmanip.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/filewritestream.h>
+
+// imports from glslang
+#include <SPIRV/Logger.h>
+#include <SPIRV/SpvTools.h>
+#include <SPIRV/GlslangToSpv.h>
+#include "glslang/Public/ShaderLang.h"
+#include "glslang/Public/ResourceLimits.h"
+
+namespace ShaderCompiler {
+    static std::optional<EShLanguage> parseStage(std::string_view stageStr) {
+        if(stageStr == "fragment") {
+            return EShLangFragment;
+        } else if(stageStr == "vertex") {
+            return EShLangVertex;
+        } else if(stageStr == "rgen") {
+            return EShLangRayGen;
+        } else if(stageStr == "rchit") {
+            return EShLangClosestHit;
+        } else if(stageStr == "compute") {
+            return EShLangCompute;
+        } else if(stageStr == "rmiss") {
+            return EShLangMiss;
+        } else if(stageStr == "task") {
+            return EShLangTask;
+        } else if(stageStr == "mesh") {
+            return EShLangMesh;
+        }
+        return {};
+    }
+
+    bool isValidStage(std::string_view stage) {
+        return parseStage(stage).has_value();
+    }
+
+    static Result fail(int errorCode, std::string message) {
+        Result result;
+        result.errorCode = errorCode;
+        result.errorMessage = std::move(message);
+        return result;
+    }
+
+    Result compile(const Job& job, IncludeCache& includeCache) {
+        const std::optional<EShLanguage> stageOpt = parseStage(job.stage);
+        if(!stageOpt.has_value()) {
+            return fail(-1, "Invalid stage: " + job.stage);
+        }
+        const EShLanguage stage = stageOpt.value();
+
+        const std::filesystem::path& inputFile = job.inputFile;
+        const std::filesystem::path& outputPath = job.outputFile;
+
+        if(!std::filesystem::exists(inputFile)) {
+            return fail(-3, "File does not exist: " + inputFile.string());
+        }
+
+        glslang::TShader shader(stage);
+
+        shader.setEntryPoint("main");
+        shader.setSourceEntryPoint("main");
+        shader.setEnvInput(glslang::EShSourceGlsl, stage, glslang::EShClientVulkan, glslang::EShTargetVulkan_1_2);
+        shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_2);
+        shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_5);
+
+        std::ifstream file(inputFile, std::ios::in);
+
+        std::string filecontents;
+
+        std::string line;
+        while (getline(file, line)) {
+            if (!filecontents.empty()) {
+                filecontents += '\n';
+            }
+            filecontents += line;
+        }
+
+        std::string preamble = R"(
+#extension GL_GOOGLE_include_directive : enable
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_EXT_control_flow_attributes: enable
+#extension GL_EXT_samplerless_texture_functions: enable
+#extension GL_ARB_shader_draw_parameters: enable
+)";
+        for(const std::string& define : job.defines) {
+            const std::size_t equals = define.find('=');
+            if(equals == std::string::npos) {
+                preamble += "#define " + define + "\n";
+            } else {
+                preamble += "#define " + define.substr(0, equals) + " " + define.substr(equals + 1) + "\n";
+            }
+        }
+        auto filepath = inputFile.string();
+        std::array strs {
+            filecontents.c_str(),
+        };
+        std::array names {
+                filepath.c_str(),
+        };
+        shader.setPreamble(preamble.c_str());
+        shader.setStringsWithLengthsAndNames(strs.data(), nullptr, names.data(), strs.size());
+
+        FileIncluder includer { job.basePath, includeCache };
+        TBuiltInResource Resources = *GetDefaultResources();
+        if(!shader.parse(&Resources, 460, false, EShMsgDefault, includer)) {
+            return fail(-4, std::string("Failed shader compilation. ") + shader.getInfoLog());
+        }
+
+        glslang::TProgram program;
+        program.addShader(&shader);
+        if(!program.link(EShMsgDefault)) {
+            return fail(-5, std::string("Failed shader linking. ") + program.getInfoLog());
+        }
+
+        auto& shaders = program.getShaders(stage);
+        if(shaders.empty()) {
+            return fail(-6, "No program of type " + job.stage + " has been linked. This should NOT happen!!");
+        }
+
+        if(!program.mapIO()) {
+            return fail(-7, std::string("Failed shader linking (glslang mapIO). ") + program.getInfoLog());
+        }
+
+        std::vector<std::uint32_t> spirv;
+        spv::SpvBuildLogger logger;
+        glslang::SpvOptions spvOptions;
+
+        // TODO: argument
+        spvOptions.generateDebugInfo = true;
+        spvOptions.stripDebugInfo = false;
+
+        spvOptions.disableOptimizer = true;
+        spvOptions.optimizeSize = false;
+        spvOptions.disassemble = false;
+        spvOptions.validate = true;
+        glslang::GlslangToSpv(*program.getIntermediate(stage), spirv, &logger, &spvOptions);
+
+        std::error_code ec;
+        std::filesystem::create_directories(outputPath.parent_path(), ec);
+        {
+            std::ofstream outputFile(outputPath, std::ios::binary);
+            outputFile.write(reinterpret_cast<const char *>(spirv.data()), spirv.size() * sizeof(std::uint32_t));
+        }
+
+        // reflection sidecar, read by ShaderModule instead of reflecting the SPIR-V at runtime
+        {
+            const std::span<const std::uint8_t> code { reinterpret_cast<const std::uint8_t*>(spirv.data()), spirv.size() * sizeof(std::uint32_t) };
+            const std::vector<std::uint8_t> reflection = ShaderCompiler::Reflection::fromSPIRV(code).serialise();
+
+            std::ofstream outputFile(ShaderCompiler::Reflection::getSidecarPath(outputPath), std::ios::binary);
+            outputFile.write(reinterpret_cast<const char *>(reflection.data()), reflection.size());
+        }
+
+        // runtime metadata file (for hot reload)
+        {
+            ShaderCompiler::Metadata metadata;
+            for (const auto& includedFile: includer.includedFiles) {
+                metadata.sourceFiles.push_back(std::filesystem::absolute(includedFile));
+            }
+            metadata.sourceFiles.push_back(std::filesystem::absolute(inputFile));
+
+            // hot reload recompiles a single shader, with the single shader mode
+            metadata.commandArguments = {
+                Carrot::toString(job.basePath.u8string()),
+                Carrot::toString(job.inputFile.u8string()),
+                Carrot::toString(job.outputFile.u8string()),
+                job.stage,
+            };
+            for(const std::string& define : job.defines) {
+                metadata.commandArguments.push_back("-D" + define);
+            }
+
+            auto metadataPath = outputPath;
+            metadataPath.replace_extension(".meta.json");
+            FILE *fp = fopen(Carrot::toString(metadataPath.u8string()).c_str(), "wb"); // non-Windows use "w"
+
+            char writeBuffer[65536];
+            rapidjson::FileWriteStream os(fp, writeBuffer, sizeof(writeBuffer));
+
+            rapidjson::PrettyWriter<rapidjson::FileWriteStream> writer(os);
+
+            rapidjson::Document document;
+            document.SetObject();
+
+            metadata.writeJSON(document);
+
+            document.Accept(writer);
+            fclose(fp);
+        }
+
+        // depfile (for CMake, and for the up-to-date check of batch mode)
+        {
+            std::ofstream outputFile(getDepfilePath(job));
+
+            outputFile << Carrot::toString(outputPath.u8string()) << ": ";
+            for(const auto& includedFile : includer.includedFiles) {
+                std::string path = Carrot::toString(includedFile.u8string());
+                // replace separators
+                for(std::size_t i = 0; i < path.size(); i++) {
+                    if(path[i] == '\\') {
+                        path[i] = '/';
+                    }
+                }
+                outputFile << path << " ";
+            }
+        }
+
+        Result result;
+        result.includedFiles = std::move(includer.includedFiles);
+        return result;
+    }
+
+    std::filesystem::path getDepfilePath(const Job& job) {
+        auto depfilePath = job.outputFile;
+        depfilePath.replace_extension(".spv.d");
+        return depfilePath;
+    }
+
+    std::vector<std::filesystem::path> readIncludedFiles(const Job& job) {
+        std::ifstream depfile(getDepfilePath(job));
+        if(!depfile) {
+            return {};
+        }
+        const std::string contents { std::istreambuf_iterator<char>(depfile), std::istreambuf_iterator<char>() };
+
+        // "<output>: <include> <include> ", the output can contain ':' (drive letter on Windows) but never ": "
+        const std::size_t separator = contents.find(": ");
+        if(separator == std::string::npos) {
+            return {};
+        }
+        std::vector<std::filesystem::path> includedFiles;
+        std::istringstream includes { contents.substr(separator + 2) };
+        std::string include;
+        while(includes >> include) {
+            includedFiles.emplace_back(include);
+        }
+        return includedFiles;
+    }
+
+    bool isUpToDate(const Job& job, const std::optional<std::filesystem::path>& extraDependency) {
+        std::error_code ec;
+        std::filesystem::file_time_type oldestOutput = std::filesystem::file_time_type::max();
+        std::filesystem::path metadataPath = job.outputFile;
+        metadataPath.replace_extension(".meta.json");
+        for(const std::filesystem::path& output : { job.outputFile, Reflection::getSidecarPath(job.outputFile), metadataPath, getDepfilePath(job) }) {
+            const auto outputTime = std::filesystem::last_write_time(output, ec);
+            if(ec) {
+                return false;
+            }
+            oldestOutput = std::min(oldestOutput, outputTime);
+        }
+
+        auto isOlderThanOutputs = [&](const std::filesystem::path& dependency) {
+            const auto dependencyTime = std::filesystem::last_write_time(dependency, ec);
+            return !ec && dependencyTime <= oldestOutput;
+        };
+        if(!isOlderThanOutputs(job.inputFile)) {
+            return false;
+        }
+        if(extraDependency.has_value() && !isOlderThanOutputs(extraDependency.value())) {
+            return false;
+        }
+        for(const auto& includedFile : readIncludedFiles(job)) {
+            // a removed include means the shader has to be compiled again (and will probably fail)
+            if(!isOlderThanOutputs(includedFile)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<Job> readManifest(const std::filesystem::path& manifestPath) {
+        std::ifstream manifest(manifestPath);
+        if(!manifest) {
+            throw std::runtime_error("Could not open manifest " + manifestPath.string());
+        }
+
+        std::vector<Job> jobs;
+        std::string line;
+        std::size_t lineNumber = 0;
+        while(std::getline(manifest, line)) {
+            lineNumber++;
+            if(!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if(line.empty()) {
+                continue;
+            }
+
+            std::vector<std::string> parts = Carrot::splitString(line, "\t");
+            if(parts.size() != 4 && parts.size() != 5) {
+                throw std::runtime_error(Carrot::sprintf("%s:%llu: expected 4 or 5 tab-separated values, got %llu", manifestPath.string().c_str(), lineNumber, parts.size()));
+            }
+            if(!isValidStage(parts[0])) {
+                throw std::runtime_error(Carrot::sprintf("%s:%llu: invalid stage '%s'", manifestPath.string().c_str(), lineNumber, parts[0].c_str()));
+            }
+
+            Job& job = jobs.emplace_back();
+            job.stage = std::move(parts[0]);
+            job.basePath = parts[1];
+            job.inputFile = parts[2];
+            job.outputFile = parts[3];
+            if(parts.size() == 5) {
+                for(std::string& define : Carrot::splitString(parts[4], " ")) {
+                    if(!define.empty()) {
+                        job.defines.push_back(std::move(define));
+                    }
+                }
+            }
+        }
+        return jobs;
+    }
+}
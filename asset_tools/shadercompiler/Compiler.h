@@ -0,0 +1,49 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+#include "IncludeCache.h"
+
+namespace ShaderCompiler {
+    /// Shader to compile, same as the arguments of shadercompiler in single shader mode
+    struct Job {
+        std::filesystem::path basePath; // <source folder>/resources/shaders, root of '#include <...>'
+        std::filesystem::path inputFile;
+        std::filesystem::path outputFile; // .spv, sidecars are written next to it
+        std::string stage; // see 'isValidStage'
+        std::vector<std::string> defines; // "NAME" or "NAME=VALUE", defined before the first line of the shader
+    };
+
+    struct Result {
+        int errorCode = 0; // 0 on success
+        std::string errorMessage;
+        std::vector<std::filesystem::path> includedFiles;
+    };
+
+    /// Is 'stage' one of the stages the compiler knows about (fragment, vertex, compute, ...)
+    bool isValidStage(std::string_view stage);
+
+    /// Compiles the shader, then writes the .spv and its sidecars: reflection, metadata for hot reload and depfile.
+    /// glslang::InitializeProcess must have been called. Can be called from multiple threads at once
+    Result compile(const Job& job, IncludeCache& includeCache);
+
+    /// Path of the depfile written next to the output of the job, listing the files the shader included
+    std::filesystem::path getDepfilePath(const Job& job);
+
+    /// Files included by the shader the last time it was compiled, read from its depfile. Empty if the shader was never compiled
+    std::vector<std::filesystem::path> readIncludedFiles(const Job& job);
+
+    /// Are the outputs of the job newer than its input, the files it included and 'extraDependency' (if any)?
+    bool isUpToDate(const Job& job, const std::optional<std::filesystem::path>& extraDependency);
+
+    /// Reads a list of shaders to compile: one shader per line, as "<stage>\t<base path>\t<input file>\t<output file>",
+    /// optionally followed by "\t<defines>", defines being separated by spaces.
+    /// Empty lines are ignored. Throws if the file cannot be read or a line is invalid
+    std::vector<Job> readManifest(const std::filesystem::path& manifestPath);
+}
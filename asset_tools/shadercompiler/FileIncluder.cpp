@@ -4,45 +4,40 @@
 
 #include "FileIncluder.h"
 #include <string>
-#include <fstream>
 
 namespace ShaderCompiler {
     static glslang::TShader::Includer::IncludeResult * include(
             const char* includeFile,
             const std::filesystem::path& basePath,
-            std::vector<std::filesystem::path>& includedFiles) {
+            std::vector<std::filesystem::path>& includedFiles,
+            IncludeCache& cache) {
         std::filesystem::path fullPath = basePath / includeFile;
 
-        if(!std::filesystem::exists(fullPath)) {
+        std::shared_ptr<const std::string> contents = cache.get(fullPath);
+        if(!contents) {
             return nullptr;
         }
 
-        std::ifstream inputStream(fullPath, std::fstream::binary | std::fstream::ate);
-        std::size_t headerLength = inputStream.tellg();
-        inputStream.seekg(0);
-        char* headerData = reinterpret_cast<char*>(malloc(headerLength));
-        inputStream.read(headerData, headerLength);
-
         includedFiles.push_back(fullPath);
 
-        return new glslang::TShader::Includer::IncludeResult(fullPath.string(), headerData, headerLength, nullptr);
+        // contents are owned by the cache, which outlives the shader
+        return new glslang::TShader::Includer::IncludeResult(fullPath.string(), contents->data(), contents->size(), nullptr);
     }
 
     glslang::TShader::Includer::IncludeResult *
     FileIncluder::includeSystem(const char *string, const char *string1, size_t size) {
-        return include(string, basePath, includedFiles);
+        return include(string, basePath, includedFiles, cache);
     }
 
     glslang::TShader::Includer::IncludeResult *
     FileIncluder::includeLocal(const char *string, const char *string1, size_t size) {
-        return include(string, std::filesystem::path(string1).parent_path(), includedFiles);
+        return include(string, std::filesystem::path(string1).parent_path(), includedFiles, cache);
     }
 
     void FileIncluder::releaseInclude(glslang::TShader::Includer::IncludeResult *result) {
         if(!result)
             return;
-        free((void *) result->headerData);
-        free(result);
+        delete result;
     }
 
     FileIncluder::~FileIncluder() {
@@ -6,11 +6,13 @@
 
 #include <filesystem>
 #include "glslang/Public/ShaderLang.h"
+#include "IncludeCache.h"
 
 namespace ShaderCompiler {
     class FileIncluder: public glslang::TShader::Includer {
     public:
-        explicit FileIncluder(const std::filesystem::path& basePath): basePath(basePath) {}
+        /// Included files are read through 'cache', which must outlive the includer and the shaders which use it
+        explicit FileIncluder(const std::filesystem::path& basePath, IncludeCache& cache): basePath(basePath), cache(cache) {}
 
         IncludeResult *includeSystem(const char *string, const char *string1, size_t size) override;
 
@@ -20,6 +22,7 @@ namespace ShaderCompiler {
 
         std::filesystem::path basePath;
         std::vector<std::filesystem::path> includedFiles;
+        IncludeCache& cache;
 
         ~FileIncluder() override;
     };
@@ -0,0 +1,42 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "IncludeCache.h"
+#include <fstream>
+
+namespace ShaderCompiler {
+    std::shared_ptr<const std::string> IncludeCache::get(const std::filesystem::path& path) {
+        const std::string key = path.lexically_normal().string();
+        {
+            Carrot::Async::LockGuard l { access };
+            auto it = files.find(key);
+            if(it != files.end()) {
+                hits++;
+                return it->second;
+            }
+        }
+
+        // read outside of the lock: other threads can keep using the cache meanwhile
+        std::shared_ptr<const std::string> contents;
+        std::error_code ec;
+        if(std::filesystem::is_regular_file(key, ec)) {
+            std::ifstream inputStream(key, std::fstream::binary);
+            contents = std::make_shared<const std::string>(std::istreambuf_iterator<char>(inputStream), std::istreambuf_iterator<char>());
+        }
+
+        Carrot::Async::LockGuard l { access };
+        misses++;
+        // if another thread read the same file in the meantime, keep the first version so all shaders share it
+        auto [it, inserted] = files.try_emplace(key, std::move(contents));
+        return it->second;
+    }
+
+    std::size_t IncludeCache::getHitCount() const {
+        return hits;
+    }
+
+    std::size_t IncludeCache::getMissCount() const {
+        return misses;
+    }
+}
@@ -0,0 +1,33 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <core/async/Locks.h>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace ShaderCompiler {
+    /// Contents of included files, shared by all shaders compiled by a single shadercompiler process: common headers are looked up and read
+    /// from disk once per batch instead of once per shader. Files are expected not to change while the batch is running.
+    /// Thread-safe.
+    class IncludeCache {
+    public:
+        /// Contents of the file at 'path', nullptr if there is no such file. Missing files are cached too
+        std::shared_ptr<const std::string> get(const std::filesystem::path& path);
+
+        /// How many lookups were answered without touching the disk
+        std::size_t getHitCount() const;
+        std::size_t getMissCount() const;
+
+    private:
+        Carrot::Async::SpinLock access;
+        std::unordered_map<std::string, std::shared_ptr<const std::string>> files; // key is the normalized path
+        std::atomic<std::size_t> hits { 0 };
+        std::atomic<std::size_t> misses { 0 };
+    };
+}
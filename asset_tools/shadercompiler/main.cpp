@@ -2,216 +2,226 @@
 // Created by jglrxavpok on 24/11/2021.
 //
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <iostream>
 #include <string>
 #include <fstream>
 #include <filesystem>
-#include "FileIncluder.h"
-#include <core/data/ShaderMetadata.h>
-#include <rapidjson/prettywriter.h>
-#include <rapidjson/filewritestream.h>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <unordered_set>
+#include "Compiler.h"
+#include <core/async/Locks.h>
+#include <core/async/ParallelFor.h>
 #include <core/utils/stringmanip.h>
 
 // imports from glslang
-#include <SPIRV/Logger.h>
-#include <SPIRV/SpvTools.h>
-#include <SPIRV/GlslangToSpv.h>
 #include "glslang/Public/ShaderLang.h"
-#include "glslang/Public/ResourceLimits.h"
-
-static std::filesystem::path outputList = "shadercompilerlist.txt";
 
 void showUsage() {
     std::cerr <<
-        "shadercompiler [base path] [input file] [output file] [stage]" << '\n'
-        << "\tCompiles a shader and write additional metadata next to the output." << '\n'
+        "shadercompiler [base path] [input file] [output file] [stage] [defines...]" << '\n'
+        << "\tCompiles a shader and write additional metadata and reflection data next to the output." << '\n'
         << "\t\t- [base path]: Path to <source folder>/resources/shaders" << '\n'
         << "\t\t- [input file]: Path of file inside <source folder>/resources/shaders to compile" << '\n'
         << "\t\t- [output file]: Path of file inside <build folder>/resources/shaders to compile" << '\n'
         << "\t\t- [stage]: Shader type to add" << '\n'
+        << "\t\t- [defines...]: Optional, -DNAME or -DNAME=VALUE, defined before the first line of the shader" << '\n'
+        << '\n'
+        << "shadercompiler --batch [manifest] [options]" << '\n'
+        << "\tCompiles all shaders listed in the manifest in parallel, inside a single process. Shaders which are up-to-date are skipped." << '\n'
+        << "\t\t- [manifest]: One shader per line, as the 4 arguments above separated by tabs, in the order <stage> <base path> <input file> <output file>, optionally followed by a tab and the defines separated by spaces (NAME or NAME=VALUE)" << '\n'
+        << "\t\t- -f, --force: Compile all shaders, even the ones which are up-to-date" << '\n'
+        << "\t\t- -j, --jobs [count]: How many threads to use (default: all hardware threads)" << '\n'
+        << "\t\t- --depfile [path]: Writes a depfile with the included files of all shaders, for the build system" << '\n'
+        << "\t\t- --stamp [path]: File written when all shaders compiled successfully, target of the depfile (default: output of the first shader)" << '\n'
+        << "\t\t- --extra-dependency [path]: Shaders older than this file are not up-to-date (for instance, the shadercompiler executable)" << '\n'
         << '\n'
         << std::endl;
 }
 
-int main(int argc, const char** argv) {
+static int compileSingleShader(int argc, const char** argv) {
     if(argc < 5) {
         std::cerr << "Missing arguments" << std::endl;
         showUsage();
         return -1;
     }
 
-    const char* basePath = argv[1];
-    const char* filename = argv[2];
-    const char* outFilename = argv[3];
-    const char* stageStr = argv[4];
-
-    EShLanguage stage = EShLangFragment;
-    if(strcmp(stageStr, "fragment") == 0) {
-        stage = EShLangFragment;
-    } else if(strcmp(stageStr, "vertex") == 0) {
-        stage = EShLangVertex;
-    } else if(strcmp(stageStr, "rgen") == 0) {
-        stage = EShLangRayGen;
-    } else if(strcmp(stageStr, "rchit") == 0) {
-        stage = EShLangClosestHit;
-    } else if(strcmp(stageStr, "compute") == 0) {
-        stage = EShLangCompute;
-    } else if(strcmp(stageStr, "rmiss") == 0) {
-        stage = EShLangMiss;
-    } else if(strcmp(stageStr, "task") == 0) {
-        stage = EShLangTask;
-    } else if(strcmp(stageStr, "mesh") == 0) {
-        stage = EShLangMesh;
-    } else {
-        std::cerr << "Invalid stage: " << stageStr << std::endl;
+    ShaderCompiler::Job job;
+    job.basePath = argv[1];
+    job.inputFile = argv[2];
+    job.outputFile = argv[3];
+    job.stage = argv[4];
+    if(!ShaderCompiler::isValidStage(job.stage)) {
+        std::cerr << "Invalid stage: " << job.stage << std::endl;
         return -1;
     }
+    for(int i = 5; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if(!arg.starts_with("-D") || arg.size() == 2) {
+            std::cerr << "Invalid define: " << arg << std::endl;
+            showUsage();
+            return -1;
+        }
+        job.defines.emplace_back(arg.substr(2));
+    }
 
     if(!glslang::InitializeProcess()) {
         std::cerr << "Failed to setup glslang." << std::endl;
         return -2;
     }
 
-    std::filesystem::path inputFile = filename;
-    std::filesystem::path outputPath = outFilename;
-
-    if(!std::filesystem::exists(inputFile)) {
-        std::cerr << "File does not exist: " << inputFile.string().c_str() << std::endl;
-        return -3;
+    ShaderCompiler::IncludeCache includeCache;
+    const ShaderCompiler::Result result = ShaderCompiler::compile(job, includeCache);
+    if(result.errorCode != 0) {
+        std::cerr << result.errorMessage << std::endl;
     }
+    return result.errorCode;
+}
 
-    glslang::TShader shader(stage);
-
-    shader.setEntryPoint("main");
-    shader.setSourceEntryPoint("main");
-    shader.setEnvInput(glslang::EShSourceGlsl, stage, glslang::EShClientVulkan, glslang::EShTargetVulkan_1_2);
-    shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_2);
-    shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_5);
-
-    std::ifstream file(inputFile, std::ios::in);
-
-    std::string filecontents;
-
-    std::string line;
-    while (getline(file, line)) {
-        if (!filecontents.empty()) {
-            filecontents += '\n';
+/// Single depfile for all the shaders of a batch. The build system sees the batch as a single command, so all dependencies are attached to 'target'
+static void writeBatchDepfile(const std::filesystem::path& depfilePath, const std::filesystem::path& target, const std::vector<std::vector<std::filesystem::path>>& includedFiles) {
+    std::ofstream depfile { depfilePath };
+    depfile << Carrot::toString(target.u8string()) << ":";
+    std::unordered_set<std::string> written;
+    for(const auto& files : includedFiles) {
+        for(const auto& file : files) {
+            std::string path = Carrot::toString(file.lexically_normal().u8string());
+            // replace separators
+            for(char& c : path) {
+                if(c == '\\') {
+                    c = '/';
+                }
+            }
+            if(written.insert(path).second) {
+                depfile << " " << path;
+            }
         }
-        filecontents += line;
-    }
-
-    std::string preamble = R"(
-#extension GL_GOOGLE_include_directive : enable
-#extension GL_ARB_separate_shader_objects : enable
-#extension GL_EXT_control_flow_attributes: enable
-#extension GL_EXT_samplerless_texture_functions: enable
-#extension GL_ARB_shader_draw_parameters: enable
-)";
-    auto filepath = inputFile.string();
-    std::array strs {
-        filecontents.c_str(),
-    };
-    std::array names {
-            filepath.c_str(),
-    };
-    shader.setPreamble(preamble.c_str());
-    shader.setStringsWithLengthsAndNames(strs.data(), nullptr, names.data(), strs.size());
-
-    ShaderCompiler::FileIncluder includer { basePath };
-    TBuiltInResource Resources = *GetDefaultResources();
-    if(!shader.parse(&Resources, 460, false, EShMsgDefault, includer)) {
-        std::cerr << "Failed shader compilation. " << shader.getInfoLog() << std::endl;
-        return -4;
     }
+    depfile << '\n';
+}
 
-    glslang::TProgram program;
-    program.addShader(&shader);
-    if(!program.link(EShMsgDefault)) {
-        std::cerr << "Failed shader linking. " << program.getInfoLog() << std::endl;
-        return -5;
+static int compileBatch(int argc, const char** argv) {
+    const auto start = std::chrono::steady_clock::now();
+
+    std::optional<std::filesystem::path> manifestPath;
+    std::optional<std::filesystem::path> depfilePath;
+    std::optional<std::filesystem::path> stampPath;
+    std::optional<std::filesystem::path> extraDependency;
+    bool force = false;
+    std::size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for(int i = 2; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if(arg == "-f" || arg == "--force") {
+            force = true;
+        } else if((arg == "-j" || arg == "--jobs") && hasValue) {
+            threadCount = std::max(1, std::atoi(argv[++i]));
+        } else if(arg == "--depfile" && hasValue) {
+            depfilePath = argv[++i];
+        } else if(arg == "--stamp" && hasValue) {
+            stampPath = argv[++i];
+        } else if(arg == "--extra-dependency" && hasValue) {
+            extraDependency = argv[++i];
+        } else if(!manifestPath.has_value()) {
+            manifestPath = arg;
+        } else {
+            std::cerr << "Unrecognized argument: " << arg << std::endl;
+            showUsage();
+            return -1;
+        }
     }
-
-    auto& shaders = program.getShaders(stage);
-    if(shaders.empty()) {
-        std::cerr << "No program of type " << stageStr << " has been linked. This should NOT happen!!" << std::endl;
-        return -6;
+    if(!manifestPath.has_value()) {
+        std::cerr << "Missing manifest" << std::endl;
+        showUsage();
+        return -1;
     }
 
-    if(!program.mapIO()) {
-        std::cerr << "Failed shader linking (glslang mapIO). " << program.getInfoLog() << std::endl;
-        return -7;
+    std::vector<ShaderCompiler::Job> jobs;
+    try {
+        jobs = ShaderCompiler::readManifest(manifestPath.value());
+    } catch(const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return -1;
     }
 
-    std::vector<std::uint32_t> spirv;
-    spv::SpvBuildLogger logger;
-    glslang::SpvOptions spvOptions;
-
-    // TODO: argument
-    spvOptions.generateDebugInfo = true;
-    spvOptions.stripDebugInfo = false;
-
-    spvOptions.disableOptimizer = true;
-    spvOptions.optimizeSize = false;
-    spvOptions.disassemble = false;
-    spvOptions.validate = true;
-    glslang::GlslangToSpv(*program.getIntermediate(stage), spirv, &logger, &spvOptions);
+    // included files of each job, for the batch depfile: up-to-date shaders keep the includes found the last time they were compiled
+    std::vector<std::vector<std::filesystem::path>> includedFiles;
+    includedFiles.resize(jobs.size());
+    std::vector<std::size_t> toCompile;
+    for(std::size_t i = 0; i < jobs.size(); i++) {
+        if(force || !ShaderCompiler::isUpToDate(jobs[i], extraDependency)) {
+            toCompile.push_back(i);
+        } else {
+            includedFiles[i] = ShaderCompiler::readIncludedFiles(jobs[i]);
+        }
+    }
 
-    {
-        std::ofstream outputFile(outputPath, std::ios::binary);
-        outputFile.write(reinterpret_cast<const char *>(spirv.data()), spirv.size() * sizeof(std::uint32_t));
+    if(!toCompile.empty() && !glslang::InitializeProcess()) {
+        std::cerr << "Failed to setup glslang." << std::endl;
+        return -2;
     }
 
-    // runtime metadata file (for hot reload)
-    {
-        ShaderCompiler::Metadata metadata;
-        for (const auto& includedFile: includer.includedFiles) {
-            metadata.sourceFiles.push_back(std::filesystem::absolute(includedFile));
+    ShaderCompiler::IncludeCache includeCache;
+    Carrot::Async::SpinLock outputAccess;
+    std::atomic<std::size_t> failures { 0 };
+    std::atomic<std::size_t> compiled { 0 };
+    const std::function<void(std::size_t)> compileJob = [&](std::size_t index) {
+        const std::size_t jobIndex = toCompile[index];
+        const ShaderCompiler::Job& job = jobs[jobIndex];
+        ShaderCompiler::Result result;
+        try {
+            result = ShaderCompiler::compile(job, includeCache);
+        } catch(const std::exception& e) {
+            // do not stop the other threads, the error is reported like compilation errors
+            result.errorCode = -8;
+            result.errorMessage = e.what();
         }
-        metadata.sourceFiles.push_back(std::filesystem::absolute(inputFile));
+        const std::size_t count = ++compiled;
 
-        metadata.commandArguments[0] = basePath;
-        metadata.commandArguments[1] = filename;
-        metadata.commandArguments[2] = outFilename;
-        metadata.commandArguments[3] = stageStr;
-
-        auto metadataPath = outputPath;
-        metadataPath.replace_extension(".meta.json");
-        FILE *fp = fopen(Carrot::toString(metadataPath.u8string()).c_str(), "wb"); // non-Windows use "w"
-
-        char writeBuffer[65536];
-        rapidjson::FileWriteStream os(fp, writeBuffer, sizeof(writeBuffer));
-
-        rapidjson::PrettyWriter<rapidjson::FileWriteStream> writer(os);
-
-        rapidjson::Document document;
-        document.SetObject();
+        Carrot::Async::LockGuard l { outputAccess };
+        std::cout << Carrot::sprintf("[%llu / %llu] %s\n", count, toCompile.size(), job.inputFile.string().c_str());
+        if(result.errorCode != 0) {
+            failures++;
+            std::cerr << "[" << job.inputFile.string() << "] " << result.errorMessage << std::endl;
+        }
+        includedFiles[jobIndex] = std::move(result.includedFiles);
+    };
 
-        metadata.writeJSON(document);
+    // granularity of 1: compiling a single shader is already a lot of work, and shaders have very different costs
+    threadCount = std::min(threadCount, std::max<std::size_t>(1, toCompile.size()));
+    auto parallelJob = Carrot::Async::ParallelForJob::create(toCompile.size(), compileJob, 1, threadCount);
+    std::vector<std::thread> threads;
+    for(std::size_t i = 1; i < threadCount; i++) {
+        threads.emplace_back([&]() {
+            parallelJob->work();
+        });
+    }
+    parallelJob->wait();
+    for(auto& t : threads) {
+        t.join();
+    }
 
-        document.Accept(writer);
-        fclose(fp);
+    if(depfilePath.has_value() && (stampPath.has_value() || !jobs.empty())) {
+        writeBatchDepfile(depfilePath.value(), stampPath.has_value() ? stampPath.value() : jobs[0].outputFile, includedFiles);
+    }
+    if(stampPath.has_value() && failures == 0) {
+        std::ofstream stamp { stampPath.value() };
     }
 
-    // depfile (for CMake)
-    {
-        auto depfilePath = outputPath;
-        depfilePath.replace_extension(".spv.d");
-        std::wofstream outputFile(depfilePath);
+    const float duration = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - start).count();
+    std::cout << Carrot::sprintf("Compiled %llu shaders (%llu up-to-date, %llu failed) with %llu threads in %.3f seconds. Include cache: %llu hits, %llu misses.\n",
+                                 toCompile.size(), jobs.size() - toCompile.size(), failures.load(), threadCount, duration,
+                                 includeCache.getHitCount(), includeCache.getMissCount());
+    return failures > 0 ? -4 : 0;
+}
 
-        std::filesystem::path relativeOutput = std::filesystem::relative(outputPath, std::filesystem::current_path());
-        outputFile << outputPath.c_str() << ": ";
-        for(const auto& includedFile : includer.includedFiles) {
-            std::wstring path = includedFile.c_str();
-            // replace separators
-            for(std::size_t i = 0; i < path.size(); i++) {
-                if(path[i] == L'\\') {
-                    path[i] = L'/';
-                }
-            }
-            outputFile << path << " ";
-        }
+int main(int argc, const char** argv) {
+    if(argc >= 2 && std::string_view(argv[1]) == "--batch") {
+        return compileBatch(argc, argv);
     }
-
-    return 0;
-}
\ No newline at end of file
+    return compileSingleShader(argc, argv);
+}
@@ -0,0 +1,21 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+namespace Carrot::Benchmarks {
+    /// Is an engine instance available for this run? Not the case when Carrot-Benchmarks is launched with --core-only
+    bool isEngineAvailable();
+
+    /// Skips the current benchmark if no engine instance is available. Returns true if the benchmark can run
+    inline bool requireEngine(benchmark::State& state) {
+        if(!isEngineAvailable()) {
+            state.SkipWithError("Requires the engine, do not use --core-only");
+            return false;
+        }
+        return true;
+    }
+}
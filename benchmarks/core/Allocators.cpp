@@ -0,0 +1,118 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <core/allocators/MallocAllocator.h>
+#include <core/allocators/PoolAllocator.h>
+#include <core/allocators/StackAllocator.h>
+#include <core/allocators/TLSFAllocator.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+using namespace Carrot;
+
+struct MallocKind {
+    static Allocator& get() { return MallocAllocator::instance; }
+};
+
+struct PoolKind {
+    static Allocator& get() {
+        static PoolAllocator allocator;
+        return allocator;
+    }
+};
+
+struct TLSFKind {
+    static Allocator& get() {
+        static TLSFAllocator allocator;
+        return allocator;
+    }
+};
+
+static std::uint32_t nextRandom(std::uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/// Typical small object sizes: mostly small, sometimes up to 1KiB
+static std::size_t sizeForSlot(std::size_t slot) {
+    return 16 + (slot * 37) % (slot % 8 == 0 ? 1024 : 128);
+}
+
+/// Each thread keeps a working set of live blocks, and replaces a random one at each iteration. All frees are local to the thread
+template<typename Kind>
+static void BM_LocalChurn(benchmark::State& state) {
+    constexpr std::size_t WorkingSetSize = 1024;
+    Allocator& allocator = Kind::get();
+    std::vector<MemoryBlock> blocks;
+    blocks.reserve(WorkingSetSize);
+    for(std::size_t i = 0; i < WorkingSetSize; i++) {
+        blocks.push_back(allocator.allocate(sizeForSlot(i)));
+    }
+
+    std::uint32_t random = static_cast<std::uint32_t>(state.thread_index() * 7919 + 1);
+    for(auto _ : state) {
+        const std::size_t slot = nextRandom(random) % WorkingSetSize;
+        allocator.deallocate(blocks[slot]);
+        blocks[slot] = allocator.allocate(sizeForSlot(slot));
+        benchmark::DoNotOptimize(blocks[slot].ptr);
+    }
+
+    for(const MemoryBlock& block : blocks) {
+        allocator.deallocate(block);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// Threads swap blocks through shared slots: most blocks are freed by another thread than the one which allocated them
+template<typename Kind>
+static void BM_CrossThreadChurn(benchmark::State& state) {
+    constexpr std::size_t SlotCount = 4096;
+    static std::array<std::atomic<void*>, SlotCount> slots{};
+    Allocator& allocator = Kind::get();
+
+    std::uint32_t random = static_cast<std::uint32_t>(state.thread_index() * 7919 + 1);
+    for(auto _ : state) {
+        const std::size_t slot = nextRandom(random) % SlotCount;
+        const std::size_t size = sizeForSlot(slot);
+        MemoryBlock block = allocator.allocate(size);
+        void* pPrevious = slots[slot].exchange(block.ptr, std::memory_order_acq_rel);
+        allocator.deallocate(MemoryBlock { .ptr = pPrevious, .size = size });
+    }
+
+    // threads are synchronised after the benchmark loop: the first thread can safely clean up
+    if(state.thread_index() == 0) {
+        for(std::size_t slot = 0; slot < SlotCount; slot++) {
+            allocator.deallocate(MemoryBlock { .ptr = slots[slot].exchange(nullptr), .size = sizeForSlot(slot) });
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_LocalChurn, MallocKind)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LocalChurn, PoolKind)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LocalChurn, TLSFKind)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_CrossThreadChurn, MallocKind)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_CrossThreadChurn, PoolKind)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_CrossThreadChurn, TLSFKind)->ThreadRange(1, 16)->UseRealTime();
+
+/// Per-frame scratch usage: many small allocations, then everything is released at once with 'clear'
+static void BM_StackAllocatorFrame(benchmark::State& state) {
+    const std::int64_t allocationsPerFrame = state.range(0);
+    StackAllocator allocator { MallocAllocator::instance, 64 * 1024 };
+    for(auto _ : state) {
+        for(std::int64_t i = 0; i < allocationsPerFrame; i++) {
+            MemoryBlock block = allocator.allocate(sizeForSlot(i), 16);
+            benchmark::DoNotOptimize(block.ptr);
+        }
+        allocator.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * allocationsPerFrame);
+}
+BENCHMARK(BM_StackAllocatorFrame)->Arg(1024)->Arg(16 * 1024);
@@ -0,0 +1,149 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <core/render/AnimationCompression.h>
+#include <core/render/AnimationSampler.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Carrot;
+
+/// Baked animation like the ones produced by GLTFLoader: a third of the bones do not move, others follow smooth curves
+static Animation makeAnimation(std::size_t boneCount, std::size_t keyframeCount) {
+    std::mt19937 rng { 42 }; // fixed seed: results must be comparable between runs
+    std::uniform_real_distribution<float> distribution { 0.5f, 4.0f };
+
+    struct BoneMotion {
+        bool animated;
+        float frequency;
+        float phase;
+        glm::vec3 axis;
+    };
+    std::vector<BoneMotion> motions;
+    for(std::size_t boneIndex = 0; boneIndex < boneCount; boneIndex++) {
+        motions.push_back(BoneMotion {
+            .animated = boneIndex % 3 != 0,
+            .frequency = distribution(rng),
+            .phase = distribution(rng),
+            .axis = glm::normalize(glm::vec3 { distribution(rng), distribution(rng), distribution(rng) }),
+        });
+    }
+
+    Animation animation;
+    animation.keyframeCount = static_cast<std::int32_t>(keyframeCount);
+    animation.duration = 2.0f;
+    for(std::size_t keyframeIndex = 0; keyframeIndex < keyframeCount; keyframeIndex++) {
+        const float time = animation.duration * keyframeIndex / (keyframeCount - 1);
+        Keyframe& keyframe = animation.keyframes.emplace_back(time);
+        keyframe.boneTransforms.reserve(boneCount);
+        for(std::size_t boneIndex = 0; boneIndex < boneCount; boneIndex++) {
+            const BoneMotion& motion = motions[boneIndex];
+            const float t = motion.animated ? time : 0.0f;
+            const glm::vec3 translation { boneIndex * 0.1f, std::sin(t * motion.frequency + motion.phase) * 0.2f, 0.0f };
+            keyframe.boneTransforms.push_back(glm::rotate(glm::translate(glm::mat4{1.0f}, translation), t * motion.frequency, motion.axis));
+        }
+    }
+    return animation;
+}
+
+static void BM_AnimationCompression(benchmark::State& state) {
+    const Animation animation = makeAnimation(static_cast<std::size_t>(state.range(0)), 60);
+    std::size_t compressedSize = 0;
+    std::size_t keyCount = 0;
+    for(auto _ : state) {
+        CompressedAnimation compressed = CompressedAnimation::compress(animation);
+        compressedSize = compressed.getMemorySize();
+        keyCount = compressed.getKeyCount();
+        benchmark::DoNotOptimize(compressed);
+    }
+    const std::size_t uncompressedSize = CompressedAnimation::getUncompressedMemorySize(animation);
+    state.counters["uncompressedBytes"] = static_cast<double>(uncompressedSize);
+    state.counters["compressedBytes"] = static_cast<double>(compressedSize);
+    state.counters["ratio"] = static_cast<double>(uncompressedSize) / static_cast<double>(compressedSize);
+    state.counters["keys"] = static_cast<double>(keyCount);
+}
+
+/// Reference: what the skinning shader does per vertex, done once per bone on the baked keyframes
+static void BM_SampleBakedAnimation(benchmark::State& state) {
+    const std::size_t boneCount = static_cast<std::size_t>(state.range(0));
+    const Animation animation = makeAnimation(boneCount, 60);
+    std::vector<glm::mat4> palette(boneCount);
+    double time = 0.0;
+    for(auto _ : state) {
+        const float wrappedTime = static_cast<float>(std::fmod(time, static_cast<double>(animation.duration)));
+        std::size_t keyframeIndex = 0;
+        while(keyframeIndex + 2 < animation.keyframes.size() && animation.keyframes[keyframeIndex + 1].timestamp <= wrappedTime) {
+            keyframeIndex++;
+        }
+        const Keyframe& keyframe = animation.keyframes[keyframeIndex];
+        const Keyframe& nextKeyframe = animation.keyframes[keyframeIndex + 1];
+        const float alpha = (wrappedTime - keyframe.timestamp) / (nextKeyframe.timestamp - keyframe.timestamp);
+        for(std::size_t boneIndex = 0; boneIndex < boneCount; boneIndex++) {
+            palette[boneIndex] = keyframe.boneTransforms[boneIndex] * (1.0f - alpha) + nextKeyframe.boneTransforms[boneIndex] * alpha;
+        }
+        benchmark::DoNotOptimize(palette.data());
+        time += 0.013;
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(boneCount));
+}
+
+static void BM_SampleCompressedAnimation(benchmark::State& state) {
+    const std::size_t boneCount = static_cast<std::size_t>(state.range(0));
+    const CompressedAnimation animation = CompressedAnimation::compress(makeAnimation(boneCount, 60));
+    std::vector<glm::mat4> palette(boneCount);
+    AnimationLayer layer { .pAnimation = &animation };
+    for(auto _ : state) {
+        AnimationSampler::computeSkinningPalette(std::span { &layer, 1 }, palette);
+        benchmark::DoNotOptimize(palette.data());
+        layer.time += 0.013;
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(boneCount));
+}
+
+static void BM_BlendCompressedAnimations(benchmark::State& state) {
+    const std::size_t boneCount = static_cast<std::size_t>(state.range(0));
+    const CompressedAnimation animation = CompressedAnimation::compress(makeAnimation(boneCount, 60));
+    std::vector<glm::mat4> palette(boneCount);
+    AnimationLayer layers[3] = {
+        { .pAnimation = &animation, .time = 0.0, .weight = 0.5f },
+        { .pAnimation = &animation, .time = 0.3, .weight = 0.3f },
+        { .pAnimation = &animation, .time = 0.7, .weight = 0.2f },
+    };
+    for(auto _ : state) {
+        AnimationSampler::computeSkinningPalette(layers, palette);
+        benchmark::DoNotOptimize(palette.data());
+        for(auto& layer : layers) {
+            layer.time += 0.013;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(boneCount));
+}
+
+/// Many instances sampled by multiple threads, like AnimatedInstances::computeSkinningPalettes
+static void BM_SampleInstancePalettes(benchmark::State& state) {
+    constexpr std::size_t BoneCount = 64;
+    constexpr std::size_t InstanceCount = 256;
+    static const CompressedAnimation animation = CompressedAnimation::compress(makeAnimation(BoneCount, 60));
+    std::vector<glm::mat4> palettes(BoneCount * InstanceCount);
+    double time = 0.0;
+    for(auto _ : state) {
+        for(std::size_t instanceIndex = 0; instanceIndex < InstanceCount; instanceIndex++) {
+            const AnimationLayer layer { .pAnimation = &animation, .time = time + instanceIndex * 0.01 };
+            AnimationSampler::computeSkinningPalette(std::span { &layer, 1 }, std::span { palettes }.subspan(instanceIndex * BoneCount, BoneCount));
+        }
+        benchmark::DoNotOptimize(palettes.data());
+        time += 0.013;
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(InstanceCount));
+}
+
+BENCHMARK(BM_AnimationCompression)->Arg(32)->Arg(128);
+BENCHMARK(BM_SampleBakedAnimation)->Arg(32)->Arg(128);
+BENCHMARK(BM_SampleCompressedAnimation)->Arg(32)->Arg(128);
+BENCHMARK(BM_BlendCompressedAnimations)->Arg(32)->Arg(128);
+BENCHMARK(BM_SampleInstancePalettes)->ThreadRange(1, 8)->UseRealTime();
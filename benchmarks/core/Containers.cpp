@@ -0,0 +1,192 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <glm/glm.hpp>
+#include <core/async/ParallelMap.hpp>
+#include <core/containers/KDTree.hpp>
+#include <core/containers/Vector.hpp>
+#include <core/SparseArray.hpp>
+#include <random>
+#include <vector>
+
+using namespace Carrot;
+
+struct Point {
+    glm::vec3 position;
+
+    const glm::vec3& getPosition() const {
+        return position;
+    }
+};
+
+static std::vector<Point> makePoints(std::size_t count) {
+    std::mt19937 rng { 42 }; // fixed seed: results must be comparable between runs
+    std::uniform_real_distribution<float> distribution { -100.0f, 100.0f };
+    std::vector<Point> points;
+    points.reserve(count);
+    for(std::size_t i = 0; i < count; i++) {
+        points.push_back(Point { glm::vec3 { distribution(rng), distribution(rng), distribution(rng) } });
+    }
+    return points;
+}
+
+static void BM_VectorPushBack(benchmark::State& state) {
+    const std::int64_t count = state.range(0);
+    for(auto _ : state) {
+        Vector<std::uint64_t> v;
+        v.setGrowthFactor(2.0f);
+        for(std::int64_t i = 0; i < count; i++) {
+            v.pushBack(i);
+        }
+        benchmark::DoNotOptimize(&v[0]);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_VectorPushBack)->Arg(1024)->Arg(64 * 1024);
+
+/// Reference for BM_VectorPushBack
+static void BM_StdVectorPushBack(benchmark::State& state) {
+    const std::int64_t count = state.range(0);
+    for(auto _ : state) {
+        std::vector<std::uint64_t> v;
+        for(std::int64_t i = 0; i < count; i++) {
+            v.push_back(i);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_StdVectorPushBack)->Arg(1024)->Arg(64 * 1024);
+
+static void BM_VectorIterate(benchmark::State& state) {
+    const std::int64_t count = state.range(0);
+    Vector<std::uint64_t> v;
+    v.resize(count);
+    v.fill(1);
+    for(auto _ : state) {
+        std::uint64_t sum = 0;
+        for(const std::uint64_t& value : v) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_VectorIterate)->Arg(64 * 1024);
+
+/// Fills one slot out of 'stride'
+static void BM_SparseArrayFill(benchmark::State& state) {
+    const std::int64_t count = state.range(0);
+    const std::int64_t stride = state.range(1);
+    for(auto _ : state) {
+        SparseArray<std::uint64_t> array;
+        array.resize(count);
+        for(std::int64_t i = 0; i < count; i += stride) {
+            array[i] = i;
+        }
+        benchmark::DoNotOptimize(array.sizeNonEmpty());
+    }
+    state.SetItemsProcessed(state.iterations() * (count / stride));
+}
+BENCHMARK(BM_SparseArrayFill)->Args({ 16 * 1024, 1 })->Args({ 16 * 1024, 64 });
+
+static void BM_SparseArrayLookup(benchmark::State& state) {
+    const std::int64_t count = state.range(0);
+    const std::int64_t stride = state.range(1);
+    SparseArray<std::uint64_t> array;
+    array.resize(count);
+    for(std::int64_t i = 0; i < count; i += stride) {
+        array[i] = i;
+    }
+
+    for(auto _ : state) {
+        std::uint64_t sum = 0;
+        for(std::int64_t i = 0; i < count; i++) {
+            if(array.contains(i)) {
+                sum += array.at(i);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_SparseArrayLookup)->Args({ 16 * 1024, 1 })->Args({ 16 * 1024, 64 });
+
+static void BM_KDTreeBuild(benchmark::State& state) {
+    const std::vector<Point> points = makePoints(state.range(0));
+    for(auto _ : state) {
+        KDTree<Point> tree { Allocator::getDefault() };
+        tree.build(points);
+        benchmark::DoNotOptimize(tree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_KDTreeBuild)->Arg(1024)->Arg(16 * 1024)->Unit(benchmark::kMicrosecond);
+
+static void BM_KDTreeClosestNeighbor(benchmark::State& state) {
+    const std::vector<Point> points = makePoints(state.range(0));
+    const std::vector<Point> queries = makePoints(1024);
+    KDTree<Point> tree { Allocator::getDefault(), points };
+    for(auto _ : state) {
+        for(const Point& query : queries) {
+            benchmark::DoNotOptimize(tree.closestNeighbor(query));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_KDTreeClosestNeighbor)->Arg(1024)->Arg(16 * 1024);
+
+static void BM_KDTreeGetNeighbors(benchmark::State& state) {
+    const std::vector<Point> points = makePoints(state.range(0));
+    const std::vector<Point> queries = makePoints(1024);
+    KDTree<Point> tree { Allocator::getDefault(), points };
+    Vector<std::size_t> neighbors;
+    neighbors.setGrowthFactor(2.0f);
+    for(auto _ : state) {
+        for(const Point& query : queries) {
+            neighbors.clear();
+            tree.getNeighbors(neighbors, query, 10.0f);
+            benchmark::DoNotOptimize(neighbors.size());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_KDTreeGetNeighbors)->Arg(1024)->Arg(16 * 1024);
+
+/// Mostly reads of keys already present, like the caches of the engine (pipelines, textures, etc.)
+static void BM_ParallelMapGetOrCompute(benchmark::State& state) {
+    constexpr std::uint64_t KeyCount = 1024;
+    static ParallelMap<std::uint64_t, std::uint64_t> map;
+    if(state.thread_index() == 0) {
+        for(std::uint64_t key = 0; key < KeyCount; key++) {
+            map.getOrCompute(key, [key]() { return key; });
+        }
+    }
+
+    std::uint64_t key = state.thread_index();
+    for(auto _ : state) {
+        key = (key * 6364136223846793005ull + 1442695040888963407ull);
+        benchmark::DoNotOptimize(map.getOrCompute(key % KeyCount, [&]() { return key; }));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParallelMapGetOrCompute)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_ParallelMapFind(benchmark::State& state) {
+    constexpr std::uint64_t KeyCount = 1024;
+    ParallelMap<std::uint64_t, std::uint64_t> map;
+    for(std::uint64_t key = 0; key < KeyCount; key++) {
+        map.getOrCompute(key, [key]() { return key; });
+    }
+
+    std::uint64_t key = 0;
+    for(auto _ : state) {
+        key = (key + 7) % (KeyCount * 2); // half of the lookups miss
+        benchmark::DoNotOptimize(map.find(key));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParallelMapFind);
@@ -0,0 +1,92 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <core/expressions/Expressions.h>
+#include <core/expressions/ExpressionProgram.h>
+#include <random>
+#include <vector>
+
+using namespace Carrot;
+
+static std::shared_ptr<Expression> get(const std::string& name, std::uint32_t subIndex = 0) {
+    return std::make_shared<GetVariableExpression>(ExpressionTypes::Float, name, subIndex);
+}
+
+static std::shared_ptr<Expression> set(const std::string& name, std::shared_ptr<Expression> value, std::uint32_t subIndex = 0) {
+    return std::make_shared<SetVariableExpression>(name, value, subIndex);
+}
+
+static std::shared_ptr<Expression> constant(float value) {
+    return std::make_shared<ConstantExpression>(value);
+}
+
+/// Update graph of a typical particle blueprint: gravity, drag, wobble, size over life.
+/// Contains constant sub-graphs (gravity * drag factor), nodes shared between outputs (drag) and unused nodes, like graphs made in the particle editor
+static std::vector<std::shared_ptr<Expression>> makeParticleUpdate() {
+    auto dt = get("get_delta_time");
+    auto life = get("get_life");
+    auto gravity = std::make_shared<MultExpression>(constant(-9.8f), constant(0.5f));
+    auto drag = std::make_shared<SubExpression>(constant(1.0f), std::make_shared<MultExpression>(constant(0.1f), dt));
+
+    std::vector<std::shared_ptr<Expression>> expressions;
+    for(std::uint32_t axis = 0; axis < 3; axis++) {
+        std::shared_ptr<Expression> acceleration = axis == 2 ? std::static_pointer_cast<Expression>(gravity) : std::make_shared<MultExpression>(std::make_shared<SinExpression>(std::make_shared<MultExpression>(life, constant(3.0f + axis))), constant(0.2f));
+        auto velocity = std::make_shared<MultExpression>(std::make_shared<AddExpression>(get("get_velocity", axis), std::make_shared<MultExpression>(acceleration, dt)), drag);
+        expressions.push_back(set("set_velocity", velocity, axis));
+    }
+
+    auto unused = std::make_shared<CompoundExpression>(std::vector<std::shared_ptr<Expression>> { std::make_shared<CosExpression>(life) });
+    expressions.push_back(unused);
+
+    auto size = std::make_shared<MaxExpression>(std::make_shared<MultExpression>(get("get_size"), std::make_shared<SubExpression>(constant(1.0f), std::make_shared<MultExpression>(dt, constant(0.25f)))), constant(0.01f));
+    expressions.push_back(set("set_size", size));
+    return expressions;
+}
+
+static void runParticleUpdate(benchmark::State& state, const ExpressionCompileOptions& options) {
+    const std::size_t particleCount = static_cast<std::size_t>(state.range(0));
+    const ExpressionProgram program = ExpressionProgram::compile(makeParticleUpdate(), options);
+
+    std::mt19937 rng { 42 }; // fixed seed: results must be comparable between runs
+    std::uniform_real_distribution<float> distribution { 0.0f, 5.0f };
+    std::vector<std::vector<float>> arrays { program.getVariables().size() };
+    std::vector<float*> pointers;
+    for(std::size_t i = 0; i < arrays.size(); i++) {
+        const bool isDeltaTime = program.getVariables()[i].name == "get_delta_time";
+        arrays[i].resize(particleCount);
+        for(float& value : arrays[i]) {
+            value = isDeltaTime ? 1.0f / 60.0f : distribution(rng);
+        }
+        pointers.push_back(arrays[i].data());
+    }
+
+    for(auto _ : state) {
+        program.run(pointers, particleCount);
+        benchmark::ClobberMemory();
+    }
+    // single thread: items per second are particles per second per core
+    state.SetItemsProcessed(state.iterations() * particleCount);
+    state.counters["Instructions"] = static_cast<double>(program.getInstructions().size());
+    state.counters["Registers"] = static_cast<double>(program.getRegisterCount());
+}
+
+static void BM_ExpressionParticleUpdate(benchmark::State& state) {
+    runParticleUpdate(state, ExpressionCompileOptions {});
+}
+BENCHMARK(BM_ExpressionParticleUpdate)->Arg(1'000)->Arg(100'000)->Arg(1'000'000);
+
+static void BM_ExpressionParticleUpdateUnoptimized(benchmark::State& state) {
+    runParticleUpdate(state, ExpressionCompileOptions { .foldConstants = false, .eliminateDeadNodes = false, .reuseSharedNodes = false });
+}
+BENCHMARK(BM_ExpressionParticleUpdateUnoptimized)->Arg(1'000)->Arg(100'000)->Arg(1'000'000);
+
+static void BM_ExpressionCompile(benchmark::State& state) {
+    const auto expressions = makeParticleUpdate();
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(ExpressionProgram::compile(expressions));
+    }
+}
+BENCHMARK(BM_ExpressionCompile);
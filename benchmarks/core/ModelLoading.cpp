@@ -0,0 +1,164 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <core/io/MappedFile.h>
+#include <core/scene/BinaryModel.h>
+#include <core/scene/GLTFLoader.h>
+#include <core/utils/CarrotTinyGLTF.h>
+#include <models/GLTFWriter.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+using namespace Carrot::Render;
+
+/// Static scene made of 'primitiveCount' grids of 'gridSize'x'gridSize' vertices, with meshlets of 8x8 vertices
+static LoadedScene makeScene(std::size_t primitiveCount, std::uint32_t gridSize) {
+    constexpr std::uint32_t MeshletSize = 8;
+    LoadedScene scene;
+    scene.debugName = "benchmark";
+    scene.materials.emplace_back().name = "material";
+    scene.nodeHierarchy = std::make_unique<Skeleton>(glm::mat4{1.0f});
+    scene.nodeHierarchy->hierarchy.meshIndices = std::vector<std::size_t>{};
+
+    for(std::size_t p = 0; p < primitiveCount; p++) {
+        LoadedPrimitive& primitive = scene.primitives.emplace_back();
+        primitive.name = "grid";
+        primitive.materialIndex = 0;
+        primitive.hadNormals = primitive.hadTangents = primitive.hadTexCoords = true;
+        for(std::uint32_t y = 0; y < gridSize; y++) {
+            for(std::uint32_t x = 0; x < gridSize; x++) {
+                Carrot::Vertex& vertex = primitive.vertices.emplace_back();
+                vertex = {};
+                vertex.pos = glm::vec4 { x, y, p, 1.0f };
+                vertex.normal = glm::vec3 { 0, 0, 1 };
+                vertex.tangent = glm::vec4 { 1, 0, 0, 1 };
+                vertex.uv = glm::vec2 { x, y } / static_cast<float>(gridSize);
+            }
+        }
+        for(std::uint32_t y = 0; y + 1 < gridSize; y++) {
+            for(std::uint32_t x = 0; x + 1 < gridSize; x++) {
+                const std::uint32_t i = x + y * gridSize;
+                primitive.indices.insert(primitive.indices.end(), { i, i + 1, i + gridSize, i + gridSize, i + 1, i + gridSize + 1 });
+            }
+        }
+
+        // one meshlet per block of the grid
+        for(std::uint32_t blockY = 0; blockY + 1 < gridSize; blockY += MeshletSize - 1) {
+            for(std::uint32_t blockX = 0; blockX + 1 < gridSize; blockX += MeshletSize - 1) {
+                Meshlet& meshlet = primitive.meshlets.emplace_back();
+                meshlet.vertexOffset = primitive.meshletVertexIndices.size();
+                meshlet.indexOffset = primitive.meshletIndices.size();
+                const std::uint32_t width = std::min(MeshletSize, gridSize - blockX);
+                const std::uint32_t height = std::min(MeshletSize, gridSize - blockY);
+                for(std::uint32_t y = 0; y < height; y++) {
+                    for(std::uint32_t x = 0; x < width; x++) {
+                        primitive.meshletVertexIndices.push_back(blockX + x + (blockY + y) * gridSize);
+                    }
+                }
+                for(std::uint32_t y = 0; y + 1 < height; y++) {
+                    for(std::uint32_t x = 0; x + 1 < width; x++) {
+                        const std::uint32_t i = x + y * width;
+                        primitive.meshletIndices.insert(primitive.meshletIndices.end(), { i, i + 1, i + width, i + width, i + 1, i + width + 1 });
+                    }
+                }
+                meshlet.vertexCount = width * height;
+                meshlet.indexCount = primitive.meshletIndices.size() - meshlet.indexOffset;
+            }
+        }
+
+        primitive.minPos = glm::vec3 { 0, 0, p };
+        primitive.maxPos = glm::vec3 { gridSize - 1, gridSize - 1, p };
+        scene.nodeHierarchy->hierarchy.meshIndices->push_back(p);
+    }
+    return scene;
+}
+
+struct ModelFiles {
+    std::filesystem::path gltf;
+    std::filesystem::path binary;
+};
+
+/// Writes the same scene as glTF (like Fertilizer does by default) and as a binary model, once per grid size
+static const ModelFiles& getModelFiles(std::uint32_t gridSize) {
+    static std::unordered_map<std::uint32_t, ModelFiles> files;
+    auto it = files.find(gridSize);
+    if(it != files.end()) {
+        return it->second;
+    }
+
+    const std::filesystem::path folder = std::filesystem::temp_directory_path() / "carrot-model-loading-benchmark";
+    std::filesystem::create_directories(folder);
+    const std::string modelName = "grid" + std::to_string(gridSize);
+    ModelFiles& result = files[gridSize];
+    result.gltf = folder / (modelName + ".gltf");
+    result.binary = folder / (modelName + ".cmodel");
+
+    const LoadedScene scene = makeScene(16, gridSize);
+    tinygltf::Model gltfModel = Fertilizer::writeAsGLTF(modelName, scene);
+    tinygltf::TinyGLTF gltf;
+    gltf.WriteGltfSceneToFile(&gltfModel, result.gltf.string(), false, false, true/* pretty-print, like Fertilizer */, false);
+
+    const std::vector<std::uint8_t> bytes = BinaryModel::write(scene);
+    std::ofstream out { result.binary, std::ios::binary };
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return result;
+}
+
+/// Current path of Model::loadInner: parse the glTF file, read accessors into a LoadedScene, and gather static vertices and indices before the upload.
+/// Files are in the OS cache after the first iteration: this measures the CPU cost of loading, which is what the binary format removes
+static void BM_LoadModelGLTF(benchmark::State& state) {
+    const ModelFiles& files = getModelFiles(static_cast<std::uint32_t>(state.range(0)));
+    std::size_t bytesProcessed = 0;
+    for(auto _ : state) {
+        tinygltf::TinyGLTF parser;
+        tinygltf::Model model;
+        std::string errors;
+        std::string warnings;
+        if(!parser.LoadASCIIFromFile(&model, &errors, &warnings, files.gltf.string())) {
+            state.SkipWithError(errors.c_str());
+            return;
+        }
+
+        GLTFLoader loader;
+        LoadedScene scene = loader.load(model, {});
+
+        // what is given to the staging buffer
+        std::vector<Carrot::Vertex> vertices;
+        std::vector<std::uint32_t> indices;
+        for(const auto& primitive : scene.primitives) {
+            vertices.insert(vertices.end(), primitive.vertices.begin(), primitive.vertices.end());
+            indices.insert(indices.end(), primitive.indices.begin(), primitive.indices.end());
+        }
+        benchmark::DoNotOptimize(vertices.data());
+        benchmark::DoNotOptimize(indices.data());
+        bytesProcessed += vertices.size() * sizeof(Carrot::Vertex) + indices.size() * sizeof(std::uint32_t);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(bytesProcessed));
+}
+
+/// Binary path of Model::loadInner: map the file, and copy the vertex and index tables to the staging buffer (simulated by a preallocated buffer)
+static void BM_LoadModelBinary(benchmark::State& state) {
+    const ModelFiles& files = getModelFiles(static_cast<std::uint32_t>(state.range(0)));
+    std::vector<std::uint8_t> staging(std::filesystem::file_size(files.binary));
+    std::size_t bytesProcessed = 0;
+    for(auto _ : state) {
+        Carrot::IO::MappedFile file { files.binary };
+        BinaryModelView view { file.getData() };
+
+        const auto vertices = view.getVertices();
+        const auto indices = view.getIndices();
+        memcpy(staging.data(), indices.data(), indices.size_bytes());
+        memcpy(staging.data() + indices.size_bytes(), vertices.data(), vertices.size_bytes());
+        benchmark::DoNotOptimize(staging.data());
+        bytesProcessed += vertices.size_bytes() + indices.size_bytes();
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(bytesProcessed));
+}
+
+BENCHMARK(BM_LoadModelGLTF)->Arg(32)->Arg(128)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LoadModelBinary)->Arg(32)->Arg(128)->Unit(benchmark::kMillisecond);
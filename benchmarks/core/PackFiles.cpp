@@ -0,0 +1,198 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <core/io/BatchedReads.h>
+#include <core/io/PackFile.h>
+#include <core/io/Resource.h>
+#include <core/io/vfs/VirtualFileSystem.h>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+using namespace Carrot::IO;
+
+/// Assets written once for all benchmarks: the same files as loose files and inside packs (one per compression)
+struct AssetSet {
+    static constexpr std::size_t AssetCount = 4000;
+
+    std::filesystem::path directory;
+    std::filesystem::path looseRoot;
+    std::vector<std::string> assetPaths; // relative to the roots
+    std::vector<std::filesystem::path> loosePaths;
+    std::filesystem::path packPaths[3]; // indexed by Pack::Compression, empty if the codec is not supported
+    std::size_t totalSize = 0;
+
+    AssetSet() {
+        directory = std::filesystem::absolute(std::filesystem::temp_directory_path() / "carrot-pack-benchmark");
+        std::filesystem::remove_all(directory);
+        looseRoot = directory / "loose";
+
+        // sizes between 512B and 32kiB, contents are compressible like most assets are
+        std::mt19937 rng { 42 };
+        std::uniform_int_distribution<std::size_t> sizeDistribution { 512, 32 * 1024 };
+        std::uniform_int_distribution<int> byteDistribution { 0, 15 };
+        for(std::size_t i = 0; i < AssetCount; i++) {
+            const std::string& assetPath = assetPaths.emplace_back("assets/" + std::to_string(i % 16) + "/" + std::to_string(i) + ".bin");
+            const std::filesystem::path& loosePath = loosePaths.emplace_back(looseRoot / assetPath);
+            std::filesystem::create_directories(loosePath.parent_path());
+
+            std::vector<char> contents(sizeDistribution(rng));
+            for(char& c : contents) {
+                c = static_cast<char>(byteDistribution(rng));
+            }
+            totalSize += contents.size();
+            std::ofstream out { loosePath, std::ios::binary };
+            out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        }
+
+        for(const Pack::Compression compression : { Pack::Compression::None, Pack::Compression::LZ4, Pack::Compression::Zstd }) {
+            if(!Pack::isSupported(compression)) {
+                continue;
+            }
+            Pack::Writer writer;
+            writer.addDirectory(looseRoot, compression);
+            const std::vector<std::uint8_t> bytes = writer.write();
+
+            std::filesystem::path& packPath = packPaths[static_cast<std::size_t>(compression)];
+            packPath = directory / ("assets" + std::to_string(static_cast<std::uint32_t>(compression)) + ".cpak");
+            std::ofstream out { packPath, std::ios::binary };
+            out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        }
+    }
+
+    ~AssetSet() {
+        std::error_code ignored;
+        std::filesystem::remove_all(directory, ignored);
+    }
+};
+
+static const AssetSet& getAssets() {
+    static AssetSet assets;
+    return assets;
+}
+
+/// Removes the file from the page cache of the OS, so that the next read goes to the disk. Returns false if not supported
+static bool dropFromPageCache(const std::filesystem::path& path) {
+#ifdef _WIN32
+    return false; // requires admin rights on Windows
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0) {
+        return false;
+    }
+    fdatasync(fd); // dirty pages cannot be dropped
+    const bool dropped = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    close(fd);
+    return dropped;
+#endif
+}
+
+/// Drops all given files from the page cache if 'cold', skips the benchmark if that is not possible
+static bool prepareIteration(benchmark::State& state, bool cold, std::span<const std::filesystem::path> paths) {
+    if(!cold) {
+        return true;
+    }
+    state.PauseTiming();
+    bool dropped = true;
+    for(const auto& path : paths) {
+        dropped &= dropFromPageCache(path);
+    }
+    state.ResumeTiming();
+    if(!dropped) {
+        state.SkipWithError("Cannot drop files from the page cache on this platform");
+    }
+    return dropped;
+}
+
+static std::vector<VFS::Path> makeVFSPaths(std::string_view root) {
+    std::vector<VFS::Path> paths;
+    for(const auto& assetPath : getAssets().assetPaths) {
+        paths.emplace_back(root, NormalizedPath { assetPath });
+    }
+    return paths;
+}
+
+static void setCounters(benchmark::State& state) {
+    state.SetItemsProcessed(state.iterations() * AssetSet::AssetCount);
+    state.SetBytesProcessed(state.iterations() * getAssets().totalSize);
+}
+
+/// Loads each asset with a Resource, like the engine does. Range 0: 1 if the page cache is dropped before each iteration
+static void BM_LoadLooseFiles(benchmark::State& state) {
+    const AssetSet& assets = getAssets();
+    const bool cold = state.range(0) != 0;
+
+    const std::vector<VFS::Path> paths = makeVFSPaths("loose");
+    VFS vfs;
+    vfs.addRoot("loose", assets.looseRoot);
+    VirtualFileSystem* previousVFS = Resource::vfsToUse;
+    Resource::vfsToUse = &vfs;
+    for(auto _ : state) {
+        if(!prepareIteration(state, cold, assets.loosePaths)) {
+            break;
+        }
+        for(const auto& path : paths) {
+            const Resource resource { path };
+            auto contents = resource.readAll();
+            benchmark::DoNotOptimize(contents.get());
+        }
+    }
+    Resource::vfsToUse = previousVFS;
+    setCounters(state);
+}
+BENCHMARK(BM_LoadLooseFiles)->ArgName("cold")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/// Loads all assets with a single call to IO::readFiles (io_uring if available)
+static void BM_LoadLooseFilesBatched(benchmark::State& state) {
+    const AssetSet& assets = getAssets();
+    const bool cold = state.range(0) != 0;
+
+    for(auto _ : state) {
+        if(!prepareIteration(state, cold, assets.loosePaths)) {
+            break;
+        }
+        auto contents = readFiles(assets.loosePaths);
+        benchmark::DoNotOptimize(contents.data());
+    }
+    setCounters(state);
+    state.counters["io_uring"] = areBatchedReadsAccelerated() ? 1 : 0;
+}
+BENCHMARK(BM_LoadLooseFilesBatched)->ArgName("cold")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/// Mounts the pack then loads each asset with a Resource. Range 0: 1 if the page cache is dropped before each iteration, range 1: Pack::Compression
+static void BM_LoadPack(benchmark::State& state) {
+    const AssetSet& assets = getAssets();
+    const bool cold = state.range(0) != 0;
+    const std::filesystem::path& packPath = assets.packPaths[state.range(1)];
+    if(packPath.empty()) {
+        state.SkipWithError("Compression is not supported by this build");
+        return;
+    }
+
+    const std::vector<VFS::Path> paths = makeVFSPaths("pack");
+    VirtualFileSystem* previousVFS = Resource::vfsToUse;
+    for(auto _ : state) {
+        if(!prepareIteration(state, cold, std::span { &packPath, 1 })) {
+            break;
+        }
+        VFS vfs;
+        vfs.addPackRoot("pack", packPath);
+        Resource::vfsToUse = &vfs;
+        for(const auto& path : paths) {
+            const Resource resource { path };
+            auto contents = resource.readAll();
+            benchmark::DoNotOptimize(contents.get());
+        }
+        Resource::vfsToUse = previousVFS;
+    }
+    setCounters(state);
+}
+BENCHMARK(BM_LoadPack)->ArgNames({"cold", "compression"})->ArgsProduct({{0, 1}, {0, 1, 2}})->Unit(benchmark::kMillisecond)->UseRealTime();
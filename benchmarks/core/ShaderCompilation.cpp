@@ -0,0 +1,176 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <core/utils/stringmanip.h>
+
+// Compares a clean build of the engine shaders, with one shadercompiler process per shader (like the build did before
+//  'shadercompiler --batch') and with a single batch process. Both use the manifest written by compile_spirv_shaders,
+//  with the outputs redirected to a temporary folder to leave the shaders of the build untouched.
+
+#ifdef _WIN32
+static const char* NullOutput = "NUL";
+#else
+static const char* NullOutput = "/dev/null";
+#endif
+
+static std::string quote(const std::filesystem::path& path) {
+    return "\"" + path.string() + "\"";
+}
+
+static int runCommand(const std::string& command) {
+#ifdef _WIN32
+    // cmd.exe strips the first and last quotes of the command line
+    return std::system(("\"" + command + " > " + NullOutput + "\"").c_str());
+#else
+    return std::system((command + " > " + NullOutput).c_str());
+#endif
+}
+
+struct ShaderJob {
+    std::string stage;
+    std::filesystem::path basePath;
+    std::filesystem::path inputFile;
+    std::filesystem::path outputFile;
+    std::vector<std::string> defines;
+};
+
+/// Engine shaders listed in resources/shaders/engine.manifest, with outputs inside a temporary folder
+struct ShaderManifest {
+    std::filesystem::path outputFolder; // compiled shaders, removed before each build
+    std::filesystem::path manifestPath;
+    std::vector<ShaderJob> jobs;
+
+    ShaderManifest() {
+        const std::filesystem::path shadersFolder = std::filesystem::absolute("resources/shaders");
+        std::ifstream manifest { shadersFolder / "engine.manifest" };
+        if(!manifest) {
+            return;
+        }
+
+        const std::filesystem::path benchmarkFolder = std::filesystem::temp_directory_path() / "carrot-shader-compilation-benchmark";
+        outputFolder = benchmarkFolder / "shaders";
+        std::string line;
+        while(std::getline(manifest, line)) {
+            std::vector<std::string> parts = Carrot::splitString(line, "\t");
+            if(parts.size() != 4 && parts.size() != 5) {
+                continue;
+            }
+            ShaderJob& job = jobs.emplace_back();
+            job.stage = parts[0];
+            job.basePath = parts[1];
+            job.inputFile = parts[2];
+            job.outputFile = outputFolder / std::filesystem::path(parts[3]).lexically_relative(shadersFolder);
+            if(parts.size() == 5) {
+                job.defines = Carrot::splitString(parts[4], " ");
+            }
+        }
+
+        std::filesystem::create_directories(benchmarkFolder);
+        manifestPath = benchmarkFolder / "engine.manifest";
+        std::ofstream output { manifestPath };
+        for(const auto& job : jobs) {
+            output << job.stage << '\t' << job.basePath.string() << '\t' << job.inputFile.string() << '\t' << job.outputFile.string();
+            if(!job.defines.empty()) {
+                output << '\t';
+                for(const auto& define : job.defines) {
+                    output << define << ' ';
+                }
+            }
+            output << '\n';
+        }
+    }
+
+    /// Removes the compiled shaders, to measure a clean build
+    void clean() const {
+        std::filesystem::remove_all(outputFolder);
+    }
+};
+
+static const ShaderManifest& getManifest() {
+    static ShaderManifest manifest;
+    return manifest;
+}
+
+static std::size_t getThreadCount(benchmark::State& state) {
+    return state.range(0) > 0 ? static_cast<std::size_t>(state.range(0)) : std::max(1u, std::thread::hardware_concurrency());
+}
+
+static bool requireManifest(benchmark::State& state) {
+    if(getManifest().jobs.empty()) {
+        state.SkipWithError("No shader in resources/shaders/engine.manifest, run from the build folder");
+        return false;
+    }
+    return true;
+}
+
+/// One process per shader, 'threads' processes at once (like the build system does with one command per shader)
+static void BM_ShaderCompilationPerProcess(benchmark::State& state) {
+    if(!requireManifest(state)) {
+        return;
+    }
+    const ShaderManifest& manifest = getManifest();
+    const std::size_t threadCount = getThreadCount(state);
+    std::atomic<std::size_t> failures { 0 };
+    for(auto _ : state) {
+        state.PauseTiming();
+        manifest.clean();
+        state.ResumeTiming();
+
+        std::atomic<std::size_t> nextJob { 0 };
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i < threadCount; i++) {
+            threads.emplace_back([&]() {
+                for(std::size_t jobIndex = nextJob++; jobIndex < manifest.jobs.size(); jobIndex = nextJob++) {
+                    const ShaderJob& job = manifest.jobs[jobIndex];
+                    std::string command = Carrot::sprintf("%s %s %s %s %s", quote(CARROT_SHADERCOMPILER_PATH).c_str(),
+                                                          quote(job.basePath).c_str(), quote(job.inputFile).c_str(), quote(job.outputFile).c_str(),
+                                                          job.stage.c_str());
+                    for(const auto& define : job.defines) {
+                        command += " -D" + define;
+                    }
+                    if(runCommand(command) != 0) {
+                        failures++;
+                    }
+                }
+            });
+        }
+        for(auto& t : threads) {
+            t.join();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * manifest.jobs.size());
+    state.counters["Failures"] = static_cast<double>(failures.load());
+}
+BENCHMARK(BM_ShaderCompilationPerProcess)->ArgName("threads")->Arg(1)->Arg(0)->Iterations(1)->UseRealTime()->Unit(benchmark::kSecond);
+
+/// All shaders compiled by a single 'shadercompiler --batch' process
+static void BM_ShaderCompilationBatch(benchmark::State& state) {
+    if(!requireManifest(state)) {
+        return;
+    }
+    const ShaderManifest& manifest = getManifest();
+    const std::size_t threadCount = getThreadCount(state);
+    std::size_t failures = 0;
+    for(auto _ : state) {
+        state.PauseTiming();
+        manifest.clean();
+        state.ResumeTiming();
+
+        const std::string command = Carrot::sprintf("%s --batch %s --force --jobs %llu", quote(CARROT_SHADERCOMPILER_PATH).c_str(),
+                                                    quote(manifest.manifestPath).c_str(), threadCount);
+        if(runCommand(command) != 0) {
+            failures++;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * manifest.jobs.size());
+    state.counters["Failures"] = static_cast<double>(failures);
+}
+BENCHMARK(BM_ShaderCompilationBatch)->ArgName("threads")->Arg(1)->Arg(0)->Iterations(1)->UseRealTime()->Unit(benchmark::kSecond);
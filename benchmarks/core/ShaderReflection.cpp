@@ -0,0 +1,95 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <core/data/ShaderReflection.h>
+#include <filesystem>
+#include <fstream>
+
+using namespace ShaderCompiler;
+
+/// Code and baked reflection of all shaders compiled by the build, loaded once for all benchmarks
+struct CompiledShaders {
+    std::vector<std::vector<std::uint8_t>> codes;
+    std::vector<std::vector<std::uint8_t>> sidecars; // empty if the shader has no sidecar
+    std::size_t totalCodeSize = 0;
+
+    CompiledShaders() {
+        const std::filesystem::path folder = "resources/shaders";
+        if(!std::filesystem::exists(folder)) {
+            return;
+        }
+        for(const auto& entry : std::filesystem::recursive_directory_iterator(folder)) {
+            if(!entry.is_regular_file() || entry.path().extension() != ".spv") {
+                continue;
+            }
+            codes.push_back(readFile(entry.path()));
+            totalCodeSize += codes.back().size();
+
+            const std::filesystem::path sidecarPath = Reflection::getSidecarPath(entry.path());
+            sidecars.push_back(std::filesystem::exists(sidecarPath) ? readFile(sidecarPath) : std::vector<std::uint8_t>{});
+        }
+    }
+
+    static std::vector<std::uint8_t> readFile(const std::filesystem::path& path) {
+        std::ifstream file { path, std::ios::binary };
+        return std::vector<std::uint8_t> { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    }
+};
+
+static const CompiledShaders& getShaders() {
+    static CompiledShaders shaders;
+    return shaders;
+}
+
+static bool requireShaders(benchmark::State& state) {
+    if(getShaders().codes.empty()) {
+        state.SkipWithError("No compiled shader in resources/shaders, run from the build folder");
+        return false;
+    }
+    return true;
+}
+
+/// Reflection work done when loading every shader of the engine at startup, without sidecars (SPIRV-Cross parses each module)
+static void BM_ShaderReflectionRuntime(benchmark::State& state) {
+    if(!requireShaders(state)) {
+        return;
+    }
+    const CompiledShaders& shaders = getShaders();
+    for(auto _ : state) {
+        for(const auto& code : shaders.codes) {
+            Reflection reflection = Reflection::fromSPIRV(code);
+            benchmark::DoNotOptimize(reflection.resources.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * shaders.codes.size());
+    state.SetBytesProcessed(state.iterations() * shaders.totalCodeSize);
+}
+BENCHMARK(BM_ShaderReflectionRuntime)->Unit(benchmark::kMillisecond);
+
+/// Same as BM_ShaderReflectionRuntime, with the sidecars baked by shadercompiler (including the check that they match the code, like ShaderModule does)
+static void BM_ShaderReflectionBaked(benchmark::State& state) {
+    if(!requireShaders(state)) {
+        return;
+    }
+    const CompiledShaders& shaders = getShaders();
+    std::size_t missingSidecars = 0;
+    for(auto _ : state) {
+        missingSidecars = 0;
+        for(std::size_t i = 0; i < shaders.codes.size(); i++) {
+            if(shaders.sidecars[i].empty()) {
+                missingSidecars++;
+                continue;
+            }
+            Reflection reflection = Reflection::deserialise(shaders.sidecars[i]);
+            benchmark::DoNotOptimize(reflection.codeHash == Reflection::hashCode(shaders.codes[i]));
+            benchmark::DoNotOptimize(reflection.resources.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * shaders.codes.size());
+    state.SetBytesProcessed(state.iterations() * shaders.totalCodeSize);
+    state.counters["MissingSidecars"] = static_cast<double>(missingSidecars);
+}
+BENCHMARK(BM_ShaderReflectionBaked)->Unit(benchmark::kMillisecond);
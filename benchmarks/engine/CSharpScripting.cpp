@@ -0,0 +1,155 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <filesystem>
+#include <engine/Engine.h>
+#include <engine/ecs/World.h>
+#include <engine/ecs/components/TransformComponent.h>
+#include <engine/ecs/systems/CSharpLogicSystem.h>
+#include <engine/scripting/CSharpBindings.h>
+#include <core/Macros.h>
+#include <core/io/IO.h>
+#include <core/io/vfs/VirtualFileSystem.h>
+#include <core/scripting/csharp/CSClass.h>
+#include <core/scripting/csharp/CSMethod.h>
+#include <core/scripting/csharp/CSObject.h>
+#include <core/scripting/csharp/Engine.h>
+
+#include "../BenchmarkEngine.h"
+
+namespace fs = std::filesystem;
+using namespace Carrot::ECS;
+
+constexpr std::size_t ScriptedEntityCount = 10'000;
+
+/// Both systems move all entities along X: one through the LocalPosition property (boxed owner lookups on each access),
+/// the other by writing in place through TransformComponent.LocalTransform
+static const char* BenchmarkSystemsCode = R"c#(
+using Carrot;
+
+public class BenchmarkPropertySystem : LogicSystem {
+    public BenchmarkPropertySystem(ulong handle): base(handle) {
+        AddComponent<TransformComponent>();
+    }
+
+    public override void Tick(double deltaTime) {
+        ForEachEntity<TransformComponent>((entity, transform) => {
+            var position = transform.LocalPosition;
+            position.X += (float)deltaTime;
+            transform.LocalPosition = position;
+        });
+    }
+}
+
+public class BenchmarkInPlaceSystem : LogicSystem {
+    public BenchmarkInPlaceSystem(ulong handle): base(handle) {
+        AddComponent<TransformComponent>();
+    }
+
+    public override void Tick(double deltaTime) {
+        ForEachEntity<TransformComponent>((entity, transform) => {
+            ref TransformData t = ref transform.LocalTransform;
+            t.Position.X += (float)deltaTime;
+        });
+    }
+}
+)c#";
+
+/// Compiles and loads the benchmark systems, once. Returns false if the C# compiler is not available
+static bool loadBenchmarkSystems() {
+    static bool loaded = []() {
+        const fs::path tempDir = fs::temp_directory_path();
+        const fs::path sourceFile = tempDir / "CarrotBenchmarkSystems.cs";
+        const fs::path assemblyOutput = tempDir / "CarrotBenchmarkSystems.dll";
+        Carrot::IO::writeFile(sourceFile.string(), (void*)BenchmarkSystemsCode, std::strlen(BenchmarkSystemsCode));
+        CLEANUP(fs::remove(sourceFile));
+
+        std::vector<fs::path> sourceFiles = { sourceFile };
+        std::vector<fs::path> references = { GetVFS().resolve("engine://scripting/Carrot.dll") };
+        if(!GetCSharpScripting().compileFiles(assemblyOutput, sourceFiles, references)) {
+            return false;
+        }
+        CLEANUP(fs::remove(assemblyOutput));
+
+        auto contents = Carrot::IO::readFile(assemblyOutput.string());
+        return GetCSharpScripting().loadAssembly(Carrot::IO::Resource(std::move(contents))) != nullptr;
+    }();
+    return loaded;
+}
+
+/// Creates a world with 'ScriptedEntityCount' entities with a transform, and the given C# system
+static CSharpLogicSystem& generateScriptedWorld(World& world, const std::string& systemClass) {
+    auto system = std::make_unique<CSharpLogicSystem>(world, "", systemClass);
+    CSharpLogicSystem& result = *system;
+    world.addLogicSystem(std::move(system));
+    for(std::size_t i = 0; i < ScriptedEntityCount; i++) {
+        world.newEntity().addComponent<TransformComponent>();
+    }
+    world.tick(0.0); // adds the entities to the world and its systems
+    return result;
+}
+
+/// Previous path: Tick called through mono_runtime_invoke with a boxed argument, transforms accessed through properties
+static void BM_CSharpTickRuntimeInvoke(benchmark::State& state) {
+    if(!Carrot::Benchmarks::requireEngine(state)) {
+        return;
+    }
+    if(!loadBenchmarkSystems()) {
+        state.SkipWithError("Could not compile C# code, is MONO_SDK_PATH set?");
+        return;
+    }
+
+    World world;
+    CSharpLogicSystem& system = generateScriptedWorld(world, "BenchmarkPropertySystem");
+    Carrot::Scripting::CSMethod* tickMethod = GetCSharpScripting().findClass("", "BenchmarkPropertySystem")->findMethod("Tick", 1);
+    std::shared_ptr<Carrot::Scripting::CSObject> csSystem = system.getCSharpObject();
+    double dt = 1.0 / 60.0;
+    for(auto _ : state) {
+        void* args[1] { (void*)&dt };
+        tickMethod->invoke(*csSystem, args);
+    }
+    state.SetItemsProcessed(state.iterations() * ScriptedEntityCount);
+}
+BENCHMARK(BM_CSharpTickRuntimeInvoke)->Unit(benchmark::kMillisecond);
+
+/// Tick called through its unmanaged thunk (what CSharpLogicSystem::tick does), transforms accessed through properties
+static void BM_CSharpTickThunk(benchmark::State& state) {
+    if(!Carrot::Benchmarks::requireEngine(state)) {
+        return;
+    }
+    if(!loadBenchmarkSystems()) {
+        state.SkipWithError("Could not compile C# code, is MONO_SDK_PATH set?");
+        return;
+    }
+
+    World world;
+    CSharpLogicSystem& system = generateScriptedWorld(world, "BenchmarkPropertySystem");
+    for(auto _ : state) {
+        system.tick(1.0 / 60.0);
+    }
+    state.SetItemsProcessed(state.iterations() * ScriptedEntityCount);
+}
+BENCHMARK(BM_CSharpTickThunk)->Unit(benchmark::kMillisecond);
+
+/// Tick called through its unmanaged thunk, transforms read and written in place through TransformComponent.LocalTransform
+static void BM_CSharpTickThunkInPlaceTransforms(benchmark::State& state) {
+    if(!Carrot::Benchmarks::requireEngine(state)) {
+        return;
+    }
+    if(!loadBenchmarkSystems()) {
+        state.SkipWithError("Could not compile C# code, is MONO_SDK_PATH set?");
+        return;
+    }
+
+    World world;
+    CSharpLogicSystem& system = generateScriptedWorld(world, "BenchmarkInPlaceSystem");
+    for(auto _ : state) {
+        system.tick(1.0 / 60.0);
+    }
+    state.SetItemsProcessed(state.iterations() * ScriptedEntityCount);
+}
+BENCHMARK(BM_CSharpTickThunkInPlaceTransforms)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,96 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <engine/render/InstanceData.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <vector>
+
+using namespace Carrot;
+
+/// Buffers of the previous transforms, one per frame in flight
+constexpr std::size_t BufferCount = 2;
+
+/// range(0) = instance count, range(1) = percentage of instances moving each frame
+static bool isMoving(std::int64_t instanceIndex, std::int64_t movingPercentage) {
+    return instanceIndex % 100 < movingPercentage;
+}
+
+static glm::mat4 computeTransform(std::int64_t instanceIndex, std::int64_t frame, bool moving) {
+    const float offset = moving ? static_cast<float>(frame) * 0.1f : 0.0f;
+    return glm::translate(glm::mat4 { 1.0f }, glm::vec3 { static_cast<float>(instanceIndex), offset, 0.0f });
+}
+
+/// Previous approach: both transforms and the UUID are sent every frame, for every instance
+static void BM_InstanceDataFull(benchmark::State& state) {
+    const std::int64_t instanceCount = state.range(0);
+    const std::int64_t movingPercentage = state.range(1);
+    std::vector<InstanceData> instances(instanceCount);
+
+    std::int64_t frame = 1;
+    for(auto _ : state) {
+        for(std::int64_t i = 0; i < instanceCount; i++) {
+            const bool moving = isMoving(i, movingPercentage);
+            InstanceData& instance = instances[i];
+            instance.uuid = Carrot::UUID { 0, 0, 0, static_cast<std::uint32_t>(i) };
+            instance.transform = computeTransform(i, frame, moving);
+            instance.lastFrameTransform = computeTransform(i, frame - 1, moving);
+        }
+        benchmark::DoNotOptimize(instances.data());
+        benchmark::ClobberMemory();
+        frame++;
+    }
+    state.counters["UploadedBytesPerFrame"] = static_cast<double>(instances.size() * sizeof(InstanceData));
+}
+BENCHMARK(BM_InstanceDataFull)->Args({10000, 0})->Args({10000, 10})->Args({10000, 100});
+
+/// Compact instance data + picking stream, previous transforms are only uploaded when outdated
+static void BM_InstanceDataCompact(benchmark::State& state) {
+    const std::int64_t instanceCount = state.range(0);
+    const std::int64_t movingPercentage = state.range(1);
+    std::vector<CompactInstanceData> instances(instanceCount);
+    std::vector<PickingInstanceData> pickingData(instanceCount);
+
+    Render::TransformHistory history { BufferCount };
+    std::vector<Render::AffineTransform> previousTransforms[BufferCount];
+    std::vector<Render::TransformHistory::Slot> slots(instanceCount);
+    for(auto& slot : slots) {
+        slot = history.allocateSlot();
+    }
+    for(std::size_t bufferIndex = 0; bufferIndex < BufferCount; bufferIndex++) {
+        previousTransforms[bufferIndex].resize(history.getRequiredCapacity());
+        history.resetBuffer(bufferIndex, previousTransforms[bufferIndex].size());
+    }
+
+    // measure steady state: all buffers have already seen the instances once
+    std::int64_t frame = 1;
+    std::size_t uploadedPreviousTransforms = 0;
+    std::int64_t measuredFrames = 0;
+    for(auto _ : state) {
+        const std::size_t bufferIndex = frame % BufferCount;
+        for(std::int64_t i = 0; i < instanceCount; i++) {
+            const bool moving = isMoving(i, movingPercentage);
+            CompactInstanceData& instance = instances[i];
+            instance.transform = Render::AffineTransform::fromMatrix(computeTransform(i, frame, moving));
+            instance.previousTransformSlot = history.submit(bufferIndex, previousTransforms[bufferIndex], slots[i], computeTransform(i, frame - 1, moving))
+                                             ? slots[i] : Render::TransformHistory::InvalidSlot;
+            pickingData[i].uuid = Carrot::UUID { 0, 0, 0, static_cast<std::uint32_t>(i) };
+        }
+        benchmark::DoNotOptimize(instances.data());
+        benchmark::DoNotOptimize(pickingData.data());
+        benchmark::ClobberMemory();
+
+        const std::size_t written = history.resetWrittenBytes();
+        if(frame > static_cast<std::int64_t>(BufferCount)) {
+            uploadedPreviousTransforms += written;
+            measuredFrames++;
+        }
+        frame++;
+    }
+
+    const double previousTransformBytes = measuredFrames > 0 ? static_cast<double>(uploadedPreviousTransforms) / measuredFrames : 0.0;
+    state.counters["UploadedBytesPerFrame"] = static_cast<double>(instances.size() * (sizeof(CompactInstanceData) + sizeof(PickingInstanceData))) + previousTransformBytes;
+}
+BENCHMARK(BM_InstanceDataCompact)->Args({10000, 0})->Args({10000, 10})->Args({10000, 100});
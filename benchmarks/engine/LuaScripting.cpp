@@ -0,0 +1,141 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <filesystem>
+#include <engine/Engine.h>
+#include <engine/ecs/World.h>
+#include <engine/ecs/components/LuaScriptComponent.h>
+#include <engine/ecs/systems/LuaSystems.h>
+#include <engine/scripting/LuaScriptPool.h>
+#include <core/io/IO.h>
+#include <core/io/vfs/VirtualFileSystem.h>
+
+#include "../BenchmarkEngine.h"
+
+namespace fs = std::filesystem;
+using namespace Carrot::ECS;
+
+static const char* TickScriptCode = R"lua(
+function eachTick(entity, dt)
+    local v = glm.vec3(dt, 1, 0)
+    local length = glm.length(v)
+end
+)lua";
+
+static const char* StatelessTickScriptCode = R"lua(
+--!stateless
+
+function eachTick(entity, dt)
+    local v = glm.vec3(dt, 1, 0)
+    local length = glm.length(v)
+end
+)lua";
+
+static const Carrot::IO::VFS::Path TickScriptPath { "luabenchmarks://tick.lua" };
+static const Carrot::IO::VFS::Path StatelessTickScriptPath { "luabenchmarks://stateless_tick.lua" };
+
+/// Writes the benchmark scripts to a temporary folder, mounted as 'luabenchmarks://'
+static void prepareScripts() {
+    [[maybe_unused]] static bool prepared = []() {
+        const fs::path root = fs::temp_directory_path() / "CarrotLuaBenchmarks";
+        fs::create_directories(root);
+        Carrot::IO::writeFile((root / "tick.lua").string(), (void*)TickScriptCode, std::strlen(TickScriptCode));
+        Carrot::IO::writeFile((root / "stateless_tick.lua").string(), (void*)StatelessTickScriptCode, std::strlen(StatelessTickScriptCode));
+        GetVFS().addRoot("luabenchmarks", root);
+        return true;
+    }();
+}
+
+/// Creates a world with 'entityCount' entities running the given script
+static void generateScriptedWorld(World& world, std::size_t entityCount, const Carrot::IO::VFS::Path& scriptPath) {
+    world.addLogicSystem<LuaUpdateSystem>();
+    for(std::size_t i = 0; i < entityCount; i++) {
+        Entity entity = world.newEntity();
+        entity.addComponent<LuaScriptComponent>();
+        entity.getComponent<LuaScriptComponent>()->addScript(scriptPath);
+    }
+    world.tick(0.0); // adds the entities to the world and its systems, runs the first tick
+}
+
+/// Memory used by the VMs owned by the entities of 'world'
+static std::size_t getOwnedVMsMemory(World& world) {
+    std::size_t total = 0;
+    for(const auto& entity : world.queryEntities<LuaScriptComponent>()) {
+        for(const auto& script : static_cast<LuaScriptComponent*>(entity.components[0])->scripts) {
+            if(script.pScript) {
+                total += script.pScript->memory_used();
+            }
+        }
+    }
+    return total;
+}
+
+/// Previous behaviour: one VM per entity, entry point looked up by name on each call
+static void BM_LuaTickLookupByName(benchmark::State& state) {
+    if(!Carrot::Benchmarks::requireEngine(state)) {
+        return;
+    }
+    prepareScripts();
+
+    World world;
+    generateScriptedWorld(world, state.range(0), TickScriptPath);
+    std::vector<LuaScriptComponent*> components;
+    for(const auto& entity : world.queryEntities<LuaScriptComponent>()) {
+        components.push_back(static_cast<LuaScriptComponent*>(entity.components[0]));
+    }
+
+    const double dt = 1.0 / 60.0;
+    for(auto _ : state) {
+        for(LuaScriptComponent* pComponent : components) {
+            for(const auto& script : pComponent->scripts) {
+                sol::protected_function eachTick = (*script.pScript)["eachTick"];
+                eachTick(pComponent->getEntity(), dt);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["LuaMemoryMB"] = getOwnedVMsMemory(world) / 1024.0 / 1024.0;
+}
+
+/// One VM per entity, cached entry points, serial ticking
+static void BM_LuaTickOwnVMs(benchmark::State& state) {
+    if(!Carrot::Benchmarks::requireEngine(state)) {
+        return;
+    }
+    prepareScripts();
+
+    World world;
+    generateScriptedWorld(world, state.range(0), TickScriptPath);
+    for(auto _ : state) {
+        world.tick(1.0 / 60.0);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["LuaMemoryMB"] = getOwnedVMsMemory(world) / 1024.0 / 1024.0;
+}
+
+/// Stateless script: one VM per thread, cached entry points, parallel ticking
+static void BM_LuaTickSharedVMs(benchmark::State& state) {
+    if(!Carrot::Benchmarks::requireEngine(state)) {
+        return;
+    }
+    prepareScripts();
+    Carrot::Lua::ScriptPool::instance().clear();
+
+    World world;
+    generateScriptedWorld(world, state.range(0), StatelessTickScriptPath);
+    for(auto _ : state) {
+        world.tick(1.0 / 60.0);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["LuaMemoryMB"] = Carrot::Lua::ScriptPool::instance().getMemoryUsage() / 1024.0 / 1024.0;
+    state.counters["VMs"] = Carrot::Lua::ScriptPool::instance().getVMCount();
+}
+
+// a VM per entity at 50k entities takes several GB, only the shared VMs are measured at this size
+BENCHMARK(BM_LuaTickLookupByName)->Arg(1'000)->Arg(10'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LuaTickOwnVMs)->Arg(1'000)->Arg(10'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LuaTickSharedVMs)->Arg(1'000)->Arg(10'000)->Arg(50'000)->Unit(benchmark::kMillisecond);
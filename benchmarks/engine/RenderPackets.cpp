@@ -0,0 +1,95 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <engine/Engine.h>
+#include <engine/render/RenderPacket.h>
+#include <engine/render/RenderPacketContainer.h>
+#include <engine/render/VulkanRenderer.h>
+#include <array>
+#include <random>
+
+#include "../BenchmarkEngine.h"
+
+using namespace Carrot::Render;
+
+/// Fills 'out' with 'count' packets, spread over 'pipelineCount' different pipelines and a few passes
+static void makePackets(PacketContainer& container, std::vector<Packet>& out, std::size_t count, std::size_t pipelineCount) {
+    static const PassName passes[] = { PassEnum::OpaqueGBuffer, PassEnum::TransparentGBuffer, PassEnum::Unlit };
+
+    // packets are only binned and sorted: pipelines are never dereferenced, only used as keys
+    static std::vector<std::uint8_t> fakePipelines(1024);
+
+    std::mt19937 rng { 42 };
+    for(std::size_t i = 0; i < count; i++) {
+        const PassName pass = passes[rng() % std::size(passes)];
+        Packet& packet = container.make(pass, PacketType::DrawIndexedInstanced, &GetEngine().getMainViewport());
+        auto* pFakePipeline = reinterpret_cast<Carrot::Pipeline*>(&fakePipelines[rng() % std::min(pipelineCount, fakePipelines.size())]);
+        packet.pipeline = std::shared_ptr<Carrot::Pipeline>(std::shared_ptr<Carrot::Pipeline>{}, pFakePipeline); // non-owning
+        packet.transparentGBuffer.zOrder = static_cast<float>(rng() % 100);
+        auto& cmd = packet.commands.emplaceBack().drawIndexedInstanced;
+        cmd.indexCount = 36;
+        cmd.instanceCount = 1;
+        out.emplace_back(packet);
+    }
+}
+
+/// Creation of packets by game code, copied to the thread-local list like VulkanRenderer::render does
+static void BM_RenderPacketSubmit(benchmark::State& state) {
+    if(!Carrot::Benchmarks::requireEngine(state)) {
+        return;
+    }
+
+    PacketContainer container;
+    std::vector<Packet> packets;
+    for(auto _ : state) {
+        packets.clear();
+        container.beginFrame();
+        makePackets(container, packets, state.range(0), 64);
+        benchmark::DoNotOptimize(packets.data());
+    }
+    packets.clear();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["ArenaBytesPerFrame"] = static_cast<double>(container.getBytesUsed());
+}
+BENCHMARK(BM_RenderPacketSubmit)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+/// Merge + sort done on the render thread each frame (VulkanRenderer::startRecord)
+static void BM_RenderPacketMergeAndSort(benchmark::State& state) {
+    if(!Carrot::Benchmarks::requireEngine(state)) {
+        return;
+    }
+
+    constexpr std::size_t ThreadCount = 4;
+    const std::size_t packetCount = state.range(0);
+    const std::size_t pipelineCount = state.range(1);
+    std::array<PacketContainer, ThreadCount> containers;
+    std::array<std::vector<Packet>, ThreadCount> threadPackets;
+    std::vector<Packet> prepared;
+    for(auto _ : state) {
+        state.PauseTiming();
+        prepared.clear();
+        for(std::size_t threadIndex = 0; threadIndex < ThreadCount; threadIndex++) {
+            threadPackets[threadIndex].clear();
+            containers[threadIndex].beginFrame();
+            makePackets(containers[threadIndex], threadPackets[threadIndex], packetCount / ThreadCount, pipelineCount);
+        }
+        std::array<std::vector<Packet>*, ThreadCount> toMerge;
+        for(std::size_t threadIndex = 0; threadIndex < ThreadCount; threadIndex++) {
+            toMerge[threadIndex] = &threadPackets[threadIndex];
+        }
+        state.ResumeTiming();
+
+        Carrot::VulkanRenderer::mergeRenderPackets(toMerge, prepared);
+        Carrot::VulkanRenderer::sortRenderPackets(prepared);
+        benchmark::DoNotOptimize(prepared.data());
+    }
+    prepared.clear();
+    for(auto& packets : threadPackets) {
+        packets.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * packetCount);
+}
+BENCHMARK(BM_RenderPacketMergeAndSort)->Args({ 1000, 16 })->Args({ 10000, 16 })->Args({ 10000, 512 })->Unit(benchmark::kMicrosecond);
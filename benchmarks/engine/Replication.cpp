@@ -0,0 +1,102 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <engine/network/replication/Snapshots.h>
+#include <random>
+#include <vector>
+
+using namespace Carrot::Network::Replication;
+
+/// Transform-like component: position, rotation and scale
+static Schema makeTransformSchema() {
+    const auto position = Carrot::IO::Quantization::withPrecision(-1024.0f, 1024.0f, 0.01f);
+    const auto rotation = Carrot::IO::Quantization { .min = -1.0f, .max = 1.0f, .bits = 12 };
+    const auto scale = Carrot::IO::Quantization::withPrecision(0.0f, 16.0f, 0.01f);
+
+    ComponentSchema transform { .name = "Transform" };
+    for(const char* name : { "px", "py", "pz" }) {
+        transform.fields.push_back({ name, position });
+    }
+    for(const char* name : { "rx", "ry", "rz", "rw" }) {
+        transform.fields.push_back({ name, rotation });
+    }
+    for(const char* name : { "sx", "sy", "sz" }) {
+        transform.fields.push_back({ name, scale });
+    }
+
+    Schema schema;
+    schema.components.push_back(std::move(transform));
+    return schema;
+}
+
+/// Server tick for a 1k entities scene where 'state.range(1)' percent of entities move each tick, replicated to 'state.range(0)' clients
+/// with the default budget of WorldReplicator. Clients receive every snapshot and acknowledge them immediately.
+static void BM_ReplicationTick(benchmark::State& state) {
+    const std::size_t clientCount = state.range(0);
+    const std::size_t movingPercent = state.range(1);
+    constexpr std::size_t EntityCount = 1000;
+    constexpr std::size_t Budget = 1200;
+
+    const Schema schema = makeTransformSchema();
+    const auto& positionQuantization = schema.components[0].fields[0].quantization;
+    std::mt19937 rng { 42 };
+    std::uniform_real_distribution<float> position { -1000.0f, 1000.0f };
+
+    WorldState world;
+    for(NetID id = 0; id < EntityCount; id++) {
+        EntityState& entity = world[id];
+        entity.entityID = Carrot::UUID { 0, 0, 0, id };
+        entity.componentMask = 1;
+        entity.components.resize(1);
+        for(const auto& field : schema.components[0].fields) {
+            entity.components[0].push_back(field.quantization.quantize(position(rng) / 1000.0f));
+        }
+    }
+
+    std::vector<SnapshotWriter> writers;
+    std::vector<SnapshotReader> readers;
+    for(std::size_t i = 0; i < clientCount; i++) {
+        writers.emplace_back(schema).setBudget(Budget);
+        readers.emplace_back(schema);
+    }
+
+    std::vector<EntityChange> changes;
+    Tick tick = 0;
+    auto runTick = [&](std::size_t& bytes) {
+        for(std::size_t i = 0; i < EntityCount * movingPercent / 100; i++) {
+            world[rng() % EntityCount].components[0][rng() % 3] = positionQuantization.quantize(position(rng));
+        }
+        for(std::size_t client = 0; client < clientCount; client++) {
+            auto snapshot = writers[client].write(tick, world);
+            bytes += snapshot.size();
+            changes.clear();
+            if(auto ack = readers[client].read(snapshot, changes)) {
+                writers[client].acknowledge(ack.value());
+            }
+        }
+        tick++;
+    };
+
+    // send the initial state, which takes a few ticks because of the budget
+    std::size_t warmupBytes = 0;
+    for(int i = 0; i < 100; i++) {
+        runTick(warmupBytes);
+    }
+
+    std::size_t bytes = 0;
+    for(auto _ : state) {
+        runTick(bytes);
+    }
+    state.SetItemsProcessed(state.iterations() * EntityCount * clientCount);
+    state.counters["BytesPerClientPerTick"] = static_cast<double>(bytes) / static_cast<double>(state.iterations() * clientCount);
+    state.counters["EntitiesDeferred"] = static_cast<double>(writers[0].getLastStatistics().entitiesDeferred);
+}
+BENCHMARK(BM_ReplicationTick)
+    ->Args({ 1, 1 })
+    ->Args({ 1, 10 })
+    ->Args({ 1, 100 })
+    ->Args({ 8, 10 })
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,136 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <engine/Engine.h>
+#include <engine/ecs/World.h>
+#include <engine/ecs/components/ForceSinPosition.h>
+#include <engine/ecs/components/Kinematics.h>
+#include <engine/ecs/components/TransformComponent.h>
+#include <engine/scene/Scene.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "../BenchmarkEngine.h"
+
+using namespace Carrot::ECS;
+
+/// Fills 'scene' with 'entityCount' entities: all have a transform, half of them move, and one in ten has a component without binary representation
+static void generateScene(Carrot::Scene& scene, std::size_t entityCount) {
+    for(std::size_t i = 0; i < entityCount; i++) {
+        Entity entity = scene.world.newEntity("Entity").addComponent<TransformComponent>();
+        entity.getComponent<TransformComponent>()->localTransform.position = glm::vec3 { static_cast<float>(i), 0.0f, 0.0f };
+        if(i % 2 == 0) {
+            entity.addComponent<Kinematics>();
+            entity.getComponent<Kinematics>()->velocity = glm::vec3 { 0.0f, 1.0f, 0.0f };
+        }
+        if(i % 10 == 0) {
+            entity.addComponent<ForceSinPosition>();
+        }
+    }
+    scene.world.tick(0.0); // adds the entities to the world
+}
+
+/// Same output as what the editor writes to disk, without the indentation
+static std::string saveJSON(const Carrot::Scene& scene) {
+    rapidjson::Document document;
+    document.SetObject();
+    scene.serialise(document);
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer { buffer };
+    document.Accept(writer);
+    return std::string { buffer.GetString(), buffer.GetSize() };
+}
+
+static void BM_SceneSaveJSON(benchmark::State& state) {
+    if(!Carrot::Benchmarks::requireEngine(state)) {
+        return;
+    }
+
+    Carrot::Scene scene;
+    generateScene(scene, state.range(0));
+    std::size_t size = 0;
+    for(auto _ : state) {
+        const std::string json = saveJSON(scene);
+        size = json.size();
+        benchmark::DoNotOptimize(json.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["FileSize"] = static_cast<double>(size);
+}
+BENCHMARK(BM_SceneSaveJSON)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void BM_SceneSaveBinary(benchmark::State& state) {
+    if(!Carrot::Benchmarks::requireEngine(state)) {
+        return;
+    }
+
+    Carrot::Scene scene;
+    generateScene(scene, state.range(0));
+    std::size_t size = 0;
+    for(auto _ : state) {
+        const std::vector<std::uint8_t> binary = scene.serialiseBinary();
+        size = binary.size();
+        benchmark::DoNotOptimize(binary.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["FileSize"] = static_cast<double>(size);
+}
+BENCHMARK(BM_SceneSaveBinary)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+/// Parsing and deserialisation of a JSON scene, like SceneManager::changeScene. Destroying the loaded scene is not measured
+static void BM_SceneLoadJSON(benchmark::State& state) {
+    if(!Carrot::Benchmarks::requireEngine(state)) {
+        return;
+    }
+
+    std::string json;
+    {
+        Carrot::Scene scene;
+        generateScene(scene, state.range(0));
+        json = saveJSON(scene);
+    }
+    for(auto _ : state) {
+        auto pScene = std::make_unique<Carrot::Scene>();
+        rapidjson::Document document;
+        document.Parse(json.c_str(), json.size());
+        pScene->deserialise(document);
+        benchmark::DoNotOptimize(pScene.get());
+
+        state.PauseTiming();
+        pScene = nullptr;
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_SceneLoadJSON)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+/// Same as BM_SceneLoadJSON, from the binary scene format. Components are deserialised in parallel
+static void BM_SceneLoadBinary(benchmark::State& state) {
+    if(!Carrot::Benchmarks::requireEngine(state)) {
+        return;
+    }
+
+    std::vector<std::uint8_t> binary;
+    {
+        Carrot::Scene scene;
+        generateScene(scene, state.range(0));
+        binary = scene.serialiseBinary();
+    }
+    for(auto _ : state) {
+        auto pScene = std::make_unique<Carrot::Scene>();
+        pScene->deserialiseBinary(binary);
+        benchmark::DoNotOptimize(pScene.get());
+
+        state.PauseTiming();
+        pScene = nullptr;
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * binary.size());
+}
+BENCHMARK(BM_SceneLoadBinary)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
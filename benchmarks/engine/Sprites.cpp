@@ -0,0 +1,119 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <engine/Engine.h>
+#include <engine/assets/AssetServer.h>
+#include <engine/render/GBufferDrawData.h>
+#include <engine/render/RenderPacketContainer.h>
+#include <engine/render/Sprite.h>
+#include <engine/render/SpriteBatcher.h>
+#include <engine/task/TaskScheduler.h>
+#include <cmath>
+#include <vector>
+
+#include "../BenchmarkEngine.h"
+
+using namespace Carrot::Render;
+
+constexpr std::size_t SpriteCount = 100'000;
+
+/// All sprites are copies of the same sprite (sharing its material), placed on a grid
+static std::vector<Sprite> makeSprites() {
+    Sprite prototype { GetAssetServer().blockingLoadTexture("resources/textures/default.png") };
+    std::vector<Sprite> sprites(SpriteCount, prototype);
+    for(std::size_t i = 0; i < sprites.size(); i++) {
+        sprites[i].position = glm::vec3 { static_cast<float>(i % 316), static_cast<float>(i / 316), 0.0f };
+        sprites[i].color = glm::vec4 { 1.0f, 0.5f, 0.25f, 1.0f };
+    }
+    return sprites;
+}
+
+/// Every sprite moves every frame
+static void moveSprite(Sprite& sprite, std::size_t index, std::int64_t frame) {
+    sprite.parentTransform[3] = glm::vec4 { std::sin(frame * 0.01f + index), std::cos(frame * 0.01f + index), 0.0f, 1.0f };
+}
+
+/// Previous approach: each sprite creates its own packet, like Sprite::onFrame does (serial, like the previous SpriteRenderSystem::onFrame)
+static void BM_SpritesPacketPerSprite(benchmark::State& state) {
+    if(!Carrot::Benchmarks::requireEngine(state)) {
+        return;
+    }
+
+    std::vector<Sprite> sprites = makeSprites();
+    Carrot::Mesh& quad = Sprite::getSpriteMesh(GetEngine());
+    PacketContainer container;
+    std::vector<Packet> packets;
+    packets.reserve(sprites.size());
+    std::int64_t frame = 0;
+    for(auto _ : state) {
+        packets.clear();
+        container.beginFrame();
+        for(std::size_t i = 0; i < sprites.size(); i++) {
+            Sprite& sprite = sprites[i];
+            moveSprite(sprite, i, frame);
+
+            Carrot::InstanceData instanceData;
+            instanceData.transform = sprite.computeTransformMatrix();
+            instanceData.color = sprite.color;
+
+            Packet& packet = container.make(PassEnum::OpaqueGBuffer, PacketType::DrawIndexedInstanced, &GetEngine().getMainViewport());
+            packet.useMesh(quad);
+            packet.useInstance(instanceData);
+
+            Carrot::GBufferDrawData drawData;
+            drawData.materialIndex = 0;
+            packet.addPerDrawData(std::span{ &drawData, 1 });
+
+            Packet::PushConstant& region = packet.addPushConstant("region", vk::ShaderStageFlagBits::eVertex);
+            region.setData(sprite.getTextureRegion());
+            packets.emplace_back(packet);
+        }
+        benchmark::DoNotOptimize(packets.data());
+        frame++;
+    }
+    packets.clear();
+    state.SetItemsProcessed(state.iterations() * sprites.size());
+    state.counters["UploadedBytesPerFrame"] = static_cast<double>(sprites.size() * sizeof(Carrot::InstanceData));
+}
+BENCHMARK(BM_SpritesPacketPerSprite)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/// Batched: instances are written in parallel into a single buffer (like SpriteRenderSystem::onFrame), and a single packet is created
+static void BM_SpritesBatched(benchmark::State& state) {
+    if(!Carrot::Benchmarks::requireEngine(state)) {
+        return;
+    }
+
+    std::vector<Sprite> sprites = makeSprites();
+    if(!sprites[0].getAtlasPlacement().has_value()) {
+        state.SkipWithError("Sprite texture was not packed inside the sprite atlas");
+        return;
+    }
+
+    Carrot::Mesh& quad = Sprite::getSpriteMesh(GetEngine());
+    PacketContainer container;
+    SpriteBatcher batcher;
+    std::int64_t frame = 0;
+    for(auto _ : state) {
+        container.beginFrame();
+        batcher.begin(sprites.size());
+        GetTaskScheduler().parallelFor(sprites.size(), [&](std::size_t i) {
+            moveSprite(sprites[i], i, frame);
+            batcher.add(sprites[i]);
+        });
+
+        // what SpriteBatcher::submit does, without sending the packet to the renderer
+        Packet& packet = container.make(PassEnum::OpaqueGBuffer, PacketType::DrawIndexedInstanced, &GetEngine().getMainViewport());
+        packet.useMesh(quad);
+        packet.useInstances(batcher.getInstances());
+        packet.instanceCount = static_cast<std::uint32_t>(batcher.getSpriteCount());
+        packet.commands[0].drawIndexedInstanced.instanceCount = packet.instanceCount;
+        benchmark::DoNotOptimize(&packet);
+        frame++;
+    }
+    state.SetItemsProcessed(state.iterations() * sprites.size());
+    state.counters["UploadedBytesPerFrame"] = static_cast<double>(sprites.size() * sizeof(Carrot::SpriteInstanceData));
+}
+BENCHMARK(BM_SpritesBatched)->Unit(benchmark::kMillisecond)->UseRealTime();
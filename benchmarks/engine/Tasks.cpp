@@ -0,0 +1,80 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <engine/Engine.h>
+#include <engine/task/TaskScheduler.h>
+#include <cmath>
+#include <vector>
+
+#include "../BenchmarkEngine.h"
+
+/// Small amount of work per element, typical of per-entity or per-particle updates
+static void BM_ParallelFor(benchmark::State& state) {
+    if(!Carrot::Benchmarks::requireEngine(state)) {
+        return;
+    }
+
+    const std::size_t count = state.range(0);
+    const std::size_t granularity = state.range(1);
+    std::vector<float> values(count, 1.0f);
+    for(auto _ : state) {
+        GetTaskScheduler().parallelFor(count, [&](std::size_t i) {
+            values[i] = std::sqrt(values[i] * 1.0001f + 1.0f);
+        }, granularity);
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ParallelFor)
+    ->Args({ 1024, 0 }) // automatic granularity
+    ->Args({ 1024, 16 })
+    ->Args({ 1024, 256 })
+    ->Args({ 64 * 1024, 0 })
+    ->Args({ 64 * 1024, 256 })
+    ->Args({ 64 * 1024, 4096 })
+    ->UseRealTime();
+
+/// Cost of each element grows with its index: the last chunks are much more expensive than the first ones
+static void BM_ParallelForUneven(benchmark::State& state) {
+    if(!Carrot::Benchmarks::requireEngine(state)) {
+        return;
+    }
+
+    const std::size_t count = state.range(0);
+    const std::size_t granularity = state.range(1);
+    std::vector<float> values(count, 1.0f);
+    for(auto _ : state) {
+        GetTaskScheduler().parallelFor(count, [&](std::size_t i) {
+            float v = values[i];
+            const std::size_t iterations = 1 + (i * 64) / count;
+            for(std::size_t j = 0; j < iterations; j++) {
+                v = std::sqrt(v * 1.0001f + 1.0f);
+            }
+            values[i] = v;
+        }, granularity);
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ParallelForUneven)
+    ->Args({ 16 * 1024, 0 })
+    ->Args({ 16 * 1024, 256 })
+    ->Args({ 16 * 1024, 4096 })
+    ->UseRealTime();
+
+/// Reference for BM_ParallelFor
+static void BM_SequentialFor(benchmark::State& state) {
+    const std::size_t count = state.range(0);
+    std::vector<float> values(count, 1.0f);
+    for(auto _ : state) {
+        for(std::size_t i = 0; i < count; i++) {
+            values[i] = std::sqrt(values[i] * 1.0001f + 1.0f);
+        }
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_SequentialFor)->Arg(1024)->Arg(64 * 1024);
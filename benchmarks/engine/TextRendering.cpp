@@ -0,0 +1,108 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <engine/render/resources/GlyphAtlas.h>
+#include <engine/render/InstanceData.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace Carrot::Render;
+
+static std::vector<unsigned char> loadFontData() {
+    std::ifstream file { "resources/fonts/Roboto-Medium.ttf", std::ios::binary };
+    return std::vector<unsigned char> { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
+static std::u32string makeLabel(std::int64_t labelIndex, std::int64_t frame) {
+    std::string text = "Score: " + std::to_string(labelIndex * 31 + frame);
+    return std::u32string { text.begin(), text.end() };
+}
+
+/// Previous approach: rasterize the entire string into a brand new bitmap each time it changes (GPU texture creation & upload not included)
+static void BM_BakePerString(benchmark::State& state) {
+    std::vector<unsigned char> fontData = loadFontData();
+    stbtt_fontinfo fontInfo;
+    if(!stbtt_InitFont(&fontInfo, fontData.data(), 0)) {
+        state.SkipWithError("Could not load font");
+        return;
+    }
+    const std::int64_t labelCount = state.range(0);
+    const float scale = stbtt_ScaleForPixelHeight(&fontInfo, 64.0f);
+    int ascent;
+    stbtt_GetFontVMetrics(&fontInfo, &ascent, nullptr, nullptr);
+    const int baseline = static_cast<int>(ascent * scale);
+
+    std::int64_t frame = 0;
+    for(auto _ : state) {
+        for(std::int64_t labelIndex = 0; labelIndex < labelCount; labelIndex++) {
+            const std::u32string label = makeLabel(labelIndex, frame);
+            float width = 0.0f;
+            for(char32_t c : label) {
+                int advance, lsb;
+                stbtt_GetCodepointHMetrics(&fontInfo, c, &advance, &lsb);
+                width += advance * scale;
+            }
+            const int w = static_cast<int>(width) + 1;
+            const int h = static_cast<int>(64.0f * 1.5f);
+            std::vector<unsigned char> pixels(w * h);
+            float xpos = 0.0f;
+            for(char32_t c : label) {
+                int x0, y0, x1, y1;
+                stbtt_GetCodepointBitmapBox(&fontInfo, c, scale, scale, &x0, &y0, &x1, &y1);
+                const int x = std::max(0, static_cast<int>(xpos) + x0);
+                const int y = std::max(0, baseline + y0);
+                stbtt_MakeCodepointBitmap(&fontInfo, &pixels[y * w + x], std::min(x1 - x0, w - x), std::min(y1 - y0, h - y), w, scale, scale, c);
+                int advance, lsb;
+                stbtt_GetCodepointHMetrics(&fontInfo, c, &advance, &lsb);
+                xpos += advance * scale;
+            }
+            benchmark::DoNotOptimize(pixels.data());
+        }
+        frame++;
+    }
+    state.SetItemsProcessed(state.iterations() * labelCount);
+}
+BENCHMARK(BM_BakePerString)->Arg(1000)->Arg(5000)->Unit(benchmark::kMillisecond);
+
+/// Glyph atlas: each changing label is laid out again and written to the per-frame instance buffer (what TextRenderSystem does)
+static void BM_GlyphAtlasChangingLabels(benchmark::State& state) {
+    std::vector<unsigned char> fontData = loadFontData();
+    stbtt_fontinfo fontInfo;
+    if(!stbtt_InitFont(&fontInfo, fontData.data(), 0)) {
+        state.SkipWithError("Could not load font");
+        return;
+    }
+    const std::int64_t labelCount = state.range(0);
+    GlyphAtlas atlas { fontInfo };
+
+    std::vector<std::vector<GlyphQuad>> layouts;
+    layouts.resize(labelCount);
+    std::vector<Carrot::GlyphInstanceData> instanceBuffer;
+
+    std::int64_t frame = 0;
+    for(auto _ : state) {
+        instanceBuffer.clear();
+        for(std::int64_t labelIndex = 0; labelIndex < labelCount; labelIndex++) {
+            std::vector<GlyphQuad>& layout = layouts[labelIndex];
+            atlas.layout(makeLabel(labelIndex, frame), 64.0f, layout);
+
+            const glm::mat4 transform = glm::mat4 { 1.0f };
+            for(const GlyphQuad& quad : layout) {
+                Carrot::GlyphInstanceData& instance = instanceBuffer.emplace_back();
+                instance.transform = transform;
+                instance.glyphRect = quad.rect;
+                instance.texelRect = quad.texelRect;
+            }
+        }
+        benchmark::DoNotOptimize(instanceBuffer.data());
+        frame++;
+    }
+    state.SetItemsProcessed(state.iterations() * labelCount);
+    state.counters["InstanceBytesPerFrame"] = static_cast<double>(instanceBuffer.size() * sizeof(Carrot::GlyphInstanceData));
+    state.counters["AtlasHeight"] = static_cast<double>(atlas.getHeight());
+}
+BENCHMARK(BM_GlyphAtlasChangingLabels)->Arg(1000)->Arg(5000)->Unit(benchmark::kMillisecond);
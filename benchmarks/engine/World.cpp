@@ -0,0 +1,79 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <engine/Engine.h>
+#include <engine/ecs/World.h>
+#include <engine/ecs/components/Kinematics.h>
+#include <engine/ecs/components/TransformComponent.h>
+#include <engine/ecs/systems/SystemKinematics.h>
+
+#include "../BenchmarkEngine.h"
+
+using namespace Carrot::ECS;
+
+/// Fills 'world' with 'entityCount' entities: all have a transform, half of them move
+static void generateWorld(World& world, std::size_t entityCount) {
+    world.addLogicSystem<SystemKinematics>();
+    for(std::size_t i = 0; i < entityCount; i++) {
+        Entity entity = world.newEntity();
+        entity.addComponent<TransformComponent>();
+        entity.getComponent<TransformComponent>()->localTransform.position = glm::vec3 { static_cast<float>(i), 0.0f, 0.0f };
+        if(i % 2 == 0) {
+            entity.addComponent<Kinematics>();
+            entity.getComponent<Kinematics>()->velocity = glm::vec3 { 0.0f, 1.0f, 0.0f };
+        }
+    }
+    world.tick(0.0); // adds the entities to the world and its systems
+}
+
+static void BM_WorldQueryEntities(benchmark::State& state) {
+    if(!Carrot::Benchmarks::requireEngine(state)) {
+        return;
+    }
+
+    World world;
+    generateWorld(world, state.range(0));
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(world.queryEntities<TransformComponent, Kinematics>().data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_WorldQueryEntities)->Arg(1000)->Arg(10000);
+
+/// Query right after the world changed: cached query results are invalidated and must be recomputed
+static void BM_WorldQueryEntitiesAfterChange(benchmark::State& state) {
+    if(!Carrot::Benchmarks::requireEngine(state)) {
+        return;
+    }
+
+    World world;
+    generateWorld(world, state.range(0));
+    for(auto _ : state) {
+        state.PauseTiming();
+        world.newEntity().addComponent<TransformComponent>().addComponent<Kinematics>();
+        world.tick(0.0);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(world.queryEntities<TransformComponent, Kinematics>().data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_WorldQueryEntitiesAfterChange)->Arg(1000)->Arg(10000);
+
+/// Headless scene: ticks a generated world, without rendering it. Does not need an engine instance, so it also runs with --core-only
+static void BM_SceneTick(benchmark::State& state) {
+    const std::size_t entityCount = state.range(0);
+    World world;
+    generateWorld(world, entityCount);
+    for(auto _ : state) {
+        world.prePhysics();
+        world.postPhysics();
+        world.tick(1.0 / 60.0);
+    }
+    state.SetItemsProcessed(state.iterations() * entityCount);
+    state.counters["Entities"] = static_cast<double>(entityCount);
+}
+BENCHMARK(BM_SceneTick)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,59 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+#include <engine/Engine.h>
+#include <cstring>
+#include <memory>
+
+#include "BenchmarkEngine.h"
+
+static bool EngineAvailable = false;
+
+bool Carrot::Benchmarks::isEngineAvailable() {
+    return EngineAvailable;
+}
+
+void Carrot::Engine::initGame() {
+    // no game: benchmarks drive the engine systems themselves
+}
+
+/// Same arguments as any Google Benchmark executable, plus:
+///  --core-only: does not start the engine (no window, no GPU needed), benchmarks requiring it are skipped
+/// Use --benchmark_out=<file> --benchmark_out_format=json to save results, and compare two runs with tools/compare.py from Google Benchmark.
+int main(int argc, char** argv) {
+    bool coreOnly = false;
+    int remainingArgc = 0;
+    for(int i = 0; i < argc; i++) {
+        if(std::strcmp(argv[i], "--core-only") == 0) {
+            coreOnly = true;
+        } else {
+            argv[remainingArgc++] = argv[i];
+        }
+    }
+    argc = remainingArgc;
+
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    // the engine is started once for the entire run, the main loop is never started: engine benchmarks tick what they need themselves
+    std::unique_ptr<Carrot::Engine> pEngine;
+    if(!coreOnly) {
+        Carrot::Configuration config;
+        config.applicationName = "Carrot-Benchmarks";
+        config.raytracingSupport = Carrot::RaytracingSupport::NotSupported;
+        config.enableFileWatching = false;
+        pEngine = std::make_unique<Carrot::Engine>(config);
+        EngineAvailable = true;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    EngineAvailable = false;
+    pEngine = nullptr;
+    return 0;
+}
@@ -16,6 +16,16 @@ namespace Carrot {
         std::size_t size = 0;
     };
 
+    /**
+     * \brief Usage statistics of an allocator, see Allocator::getStats
+     */
+    struct AllocatorStats {
+        std::size_t allocationCount = 0; //< number of allocations made since the creation of the allocator
+        std::size_t deallocationCount = 0; //< number of deallocations made since the creation of the allocator
+        std::size_t bytesInUse = 0; //< bytes currently given to users (including rounding done by the allocator)
+        std::size_t bytesReserved = 0; //< bytes currently held by the allocator (from its backing allocator or the system)
+    };
+
     /**
      * Abstract base class for Carrot allocators. Provides an uniform interface for allocators
      * Allocators are not thread safe by default.
@@ -65,6 +75,16 @@ namespace Carrot {
             return this == &other;
         }
 
+        /**
+         * \brief Fills 'out' with the current usage statistics of this allocator, if supported.
+         * Allocators which are used from multiple threads may report slightly outdated values.
+         * \param out where to write the statistics
+         * \return true iif this allocator supports statistics. 'out' is left untouched otherwise
+         */
+        virtual bool getStats(AllocatorStats& out) const {
+            return false;
+        }
+
         virtual ~Allocator() = default;
 
     public:
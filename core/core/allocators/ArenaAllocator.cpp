@@ -0,0 +1,157 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "ArenaAllocator.h"
+
+#include <bit>
+#include <cstddef>
+#include <core/utils/Assert.h>
+
+namespace Carrot {
+    /// Alignment of chunks, allocations with a bigger alignment are padded inside the chunks
+    static constexpr std::size_t ChunkAlignment = alignof(std::max_align_t);
+
+    ArenaAllocator::ArenaAllocator(Allocator& backingAllocator, std::size_t chunkSize): backingAllocator(backingAllocator), chunkSize(chunkSize) {}
+
+    ArenaAllocator::~ArenaAllocator() {
+        runDestructors();
+        releaseChunks();
+    }
+
+    MemoryBlock ArenaAllocator::allocate(std::size_t size, std::size_t alignment) {
+        if(alignment < 1) {
+            alignment = 1;
+        }
+        verify(std::has_single_bit(alignment), "Alignment must be a power of two");
+
+        while(true) {
+            if(currentChunk < chunks.size()) {
+                const MemoryBlock& chunk = chunks[currentChunk];
+                const std::uintptr_t chunkStart = reinterpret_cast<std::uintptr_t>(chunk.ptr);
+                const std::uintptr_t alignedStart = (chunkStart + cursor + alignment - 1) & ~(alignment - 1);
+                if(alignedStart + size <= chunkStart + chunk.size) {
+                    cursor = alignedStart + size - chunkStart;
+                    allocationCount++;
+                    return MemoryBlock {
+                        .ptr = reinterpret_cast<void*>(alignedStart),
+                        .size = size,
+                    };
+                }
+
+                // does not fit, continue with the next chunk (the end of this one is lost until the next reset)
+                bytesUsedInPreviousChunks += cursor;
+                currentChunk++;
+                cursor = 0;
+                continue;
+            }
+
+            const std::size_t newChunkSize = std::max(chunkSize, size + alignment);
+            MemoryBlock chunk = backingAllocator.allocate(newChunkSize, ChunkAlignment);
+            if(chunk.ptr == nullptr) {
+                throw OutOfMemoryException{};
+            }
+            chunk.size = newChunkSize;
+            chunks.push_back(chunk);
+            bytesReserved += newChunkSize;
+        }
+    }
+
+    void ArenaAllocator::deallocate(const MemoryBlock& block) {
+        if(block.ptr == nullptr || currentChunk >= chunks.size()) {
+            return;
+        }
+
+        const std::uintptr_t chunkStart = reinterpret_cast<std::uintptr_t>(chunks[currentChunk].ptr);
+        const std::uintptr_t blockStart = reinterpret_cast<std::uintptr_t>(block.ptr);
+        if(blockStart >= chunkStart && blockStart + block.size == chunkStart + cursor) {
+            // latest allocation, roll back
+            cursor = blockStart - chunkStart;
+        }
+    }
+
+    MemoryBlock ArenaAllocator::reallocate(const MemoryBlock& block, const std::size_t size, std::size_t alignment) {
+        if(block.ptr != nullptr && currentChunk < chunks.size()) {
+            const MemoryBlock& chunk = chunks[currentChunk];
+            const std::uintptr_t chunkStart = reinterpret_cast<std::uintptr_t>(chunk.ptr);
+            const std::uintptr_t blockStart = reinterpret_cast<std::uintptr_t>(block.ptr);
+            const bool isLatestAllocation = blockStart >= chunkStart && blockStart + block.size == chunkStart + cursor;
+            const bool isAligned = (blockStart & (std::max(alignment, static_cast<std::size_t>(1)) - 1)) == 0;
+            if(isLatestAllocation && isAligned && blockStart + size <= chunkStart + chunk.size) {
+                cursor = blockStart + size - chunkStart;
+                return MemoryBlock {
+                    .ptr = block.ptr,
+                    .size = size,
+                };
+            }
+        }
+        return Allocator::reallocate(block, size, alignment);
+    }
+
+    bool ArenaAllocator::getStats(AllocatorStats& out) const {
+        out.allocationCount = allocationCount;
+        out.deallocationCount = 0;
+        out.bytesInUse = getBytesUsed();
+        out.bytesReserved = bytesReserved;
+        return true;
+    }
+
+    void ArenaAllocator::reset() {
+        runDestructors();
+        bytesUsedBeforeReset = getBytesUsed();
+
+        if(chunks.size() > 1) {
+            // merge all chunks into a single one, to avoid switching chunks next time
+            const std::size_t totalSize = bytesReserved;
+            releaseChunks();
+
+            MemoryBlock chunk = backingAllocator.allocate(totalSize, ChunkAlignment);
+            if(chunk.ptr == nullptr) {
+                throw OutOfMemoryException{};
+            }
+            chunk.size = totalSize;
+            chunks.push_back(chunk);
+            bytesReserved = totalSize;
+        }
+
+        currentChunk = 0;
+        cursor = 0;
+        bytesUsedInPreviousChunks = 0;
+    }
+
+    std::size_t ArenaAllocator::getBytesUsed() const {
+        return bytesUsedInPreviousChunks + cursor;
+    }
+
+    std::size_t ArenaAllocator::getBytesUsedBeforeReset() const {
+        return bytesUsedBeforeReset;
+    }
+
+    std::size_t ArenaAllocator::getBytesReserved() const {
+        return bytesReserved;
+    }
+
+    std::size_t ArenaAllocator::getChunkCount() const {
+        return chunks.size();
+    }
+
+    void ArenaAllocator::runDestructors() {
+        DestructorNode* pNode = pDestructors;
+        pDestructors = nullptr;
+        while(pNode != nullptr) {
+            pNode->destroy(pNode->pObject);
+            pNode = pNode->pNext;
+        }
+    }
+
+    void ArenaAllocator::releaseChunks() {
+        for(const MemoryBlock& chunk : chunks) {
+            backingAllocator.deallocate(chunk);
+        }
+        chunks.clear();
+        bytesReserved = 0;
+        currentChunk = 0;
+        cursor = 0;
+        bytesUsedInPreviousChunks = 0;
+    }
+}
@@ -0,0 +1,110 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <core/Allocator.h>
+
+namespace Carrot {
+    /**
+     * \brief Linear (bump) allocator meant for data which all dies at the same time, typically at the end of a frame.
+     * Allocating only moves a cursor forward, deallocating does nothing (except for the latest allocation, which can be rolled back or grown in place).
+     * Memory is given back to the arena all at once with 'reset'.
+     *
+     * Memory is requested from the backing allocator in chunks. When more than one chunk was needed since the last reset,
+     * 'reset' replaces all chunks by a single one big enough for everything: after a few frames, the arena stabilises on a single
+     * contiguous chunk and does not touch the backing allocator anymore.
+     *
+     * Not thread-safe: use one arena per thread.
+     */
+    class ArenaAllocator: public Allocator {
+    public:
+        /**
+         * \brief Creates a new ArenaAllocator with the given allocator as a backing allocator.
+         * \param backingAllocator allocator used for chunks
+         * \param chunkSize minimum size of chunks requested to the backing allocator
+         */
+        explicit ArenaAllocator(Allocator& backingAllocator = Allocator::getDefault(), std::size_t chunkSize = 64 * 1024);
+        ~ArenaAllocator();
+
+        ArenaAllocator(const ArenaAllocator&) = delete;
+        ArenaAllocator(ArenaAllocator&&) = delete;
+        ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+        ArenaAllocator& operator=(ArenaAllocator&&) = delete;
+
+        MemoryBlock allocate(std::size_t size, std::size_t alignment = 1) override;
+
+        /// Does nothing, unless 'block' is the latest allocation: in that case its memory is reused by the next allocation
+        void deallocate(const MemoryBlock& block) override;
+
+        /// Grows or shrinks the block in place if it is the latest allocation, and there is enough space left in the current chunk
+        MemoryBlock reallocate(const MemoryBlock& block, const std::size_t size, std::size_t alignment = 1) override;
+
+        bool getStats(AllocatorStats& out) const override;
+
+        /**
+         * \brief Constructs an object inside this arena. Its destructor (if not trivial) is called by the next call to 'reset', in reverse order of creation.
+         */
+        template<typename T, typename... TArgs>
+        T& make(TArgs&&... args);
+
+        /**
+         * \brief Destroys all objects created via 'make', and makes all memory of this arena available again.
+         * All pointers to memory allocated before this call become invalid.
+         */
+        void reset();
+
+        /// How many bytes have been allocated since the last reset, including alignment padding
+        std::size_t getBytesUsed() const;
+
+        /// Value of getBytesUsed() right before the last reset. For an arena reset each frame, this is the amount of memory used by the previous frame
+        std::size_t getBytesUsedBeforeReset() const;
+
+        /// How many bytes this arena currently holds from its backing allocator
+        std::size_t getBytesReserved() const;
+
+        std::size_t getChunkCount() const;
+
+    private:
+        struct DestructorNode {
+            void (*destroy)(void*) = nullptr;
+            void* pObject = nullptr;
+            DestructorNode* pNext = nullptr;
+        };
+
+        void runDestructors();
+        void releaseChunks();
+
+        Allocator& backingAllocator;
+        std::size_t chunkSize = 0;
+
+        std::vector<MemoryBlock> chunks;
+        std::size_t currentChunk = 0;
+        std::size_t cursor = 0; // cursor inside current chunk
+        std::size_t bytesUsedInPreviousChunks = 0;
+        std::size_t bytesUsedBeforeReset = 0;
+        std::size_t bytesReserved = 0;
+        std::size_t allocationCount = 0;
+
+        DestructorNode* pDestructors = nullptr;
+    };
+
+    template<typename T, typename... TArgs>
+    T& ArenaAllocator::make(TArgs&&... args) {
+        T* pObject = new (allocate(sizeof(T), alignof(T)).ptr) T(std::forward<TArgs>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            DestructorNode* pNode = new (allocate(sizeof(DestructorNode), alignof(DestructorNode)).ptr) DestructorNode;
+            pNode->destroy = [](void* p) {
+                static_cast<T*>(p)->~T();
+            };
+            pNode->pObject = pObject;
+            pNode->pNext = pDestructors;
+            pDestructors = pNode;
+        }
+        return *pObject;
+    }
+}
@@ -23,7 +23,8 @@ namespace Carrot {
 #ifdef WIN32
         void* ptr = _aligned_malloc(size, alignment);
 #else
-        void* ptr = std::aligned_alloc(size, alignment);
+        // aligned_alloc requires the size to be a multiple of the alignment
+        void* ptr = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
 #endif
         return {
             .ptr = ptr,
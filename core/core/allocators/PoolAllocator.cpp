@@ -0,0 +1,297 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "PoolAllocator.h"
+
+#include <bit>
+#include <mutex>
+#include <vector>
+#include <core/utils/Assert.h>
+
+namespace Carrot {
+    namespace {
+        /// Small integer identifying the current thread, used to index caches of PoolAllocators.
+        /// Indices are recycled when threads exit, so that the caches of dead threads are reused by new threads
+        struct ThreadSlot {
+            std::size_t index = PoolAllocator::MaxThreadCaches;
+
+            ThreadSlot() {
+                std::lock_guard l { getMutex() };
+                auto& freeSlots = getFreeSlots();
+                if(!freeSlots.empty()) {
+                    index = freeSlots.back();
+                    freeSlots.pop_back();
+                } else if(getNextSlot() < PoolAllocator::MaxThreadCaches) {
+                    index = getNextSlot()++;
+                }
+            }
+
+            ~ThreadSlot() {
+                if(index < PoolAllocator::MaxThreadCaches) {
+                    std::lock_guard l { getMutex() };
+                    getFreeSlots().push_back(index);
+                }
+            }
+
+            static std::mutex& getMutex() {
+                static std::mutex mutex;
+                return mutex;
+            }
+
+            static std::vector<std::size_t>& getFreeSlots() {
+                static std::vector<std::size_t> freeSlots;
+                return freeSlots;
+            }
+
+            static std::size_t& getNextSlot() {
+                static std::size_t nextSlot = 0;
+                return nextSlot;
+            }
+        };
+
+        thread_local ThreadSlot currentThreadSlot;
+
+        constexpr std::size_t SizeClassLookupGranularity = PoolAllocator::MinAlignment;
+
+        // size class index for each multiple of SizeClassLookupGranularity, up to MaxSmallSize
+        constexpr auto SizeClassLookup = []() {
+            std::array<std::uint8_t, PoolAllocator::MaxSmallSize / SizeClassLookupGranularity + 1> lookup{};
+            std::size_t sizeClass = 0;
+            for(std::size_t i = 0; i < lookup.size(); i++) {
+                while(PoolAllocator::SizeClasses[sizeClass] < i * SizeClassLookupGranularity) {
+                    sizeClass++;
+                }
+                lookup[i] = static_cast<std::uint8_t>(sizeClass);
+            }
+            return lookup;
+        }();
+
+        constexpr std::size_t alignUp(std::size_t value, std::size_t alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        /// Offset of the first block inside a slab. Power-of-two classes start at a multiple of their size to be aligned on it
+        constexpr std::size_t getFirstBlockOffset(std::size_t headerSize, std::size_t blockSize) {
+            return alignUp(headerSize, std::has_single_bit(blockSize) ? blockSize : PoolAllocator::MinAlignment);
+        }
+
+        void addRelaxed(std::atomic<std::size_t>& counter, std::size_t value) {
+            // only a single thread writes to the counter, no need for an atomic read-modify-write
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+    }
+
+    PoolAllocator::PoolAllocator(Allocator& backingAllocator): backingAllocator(backingAllocator) {
+        caches[MaxThreadCaches].store(new ThreadCache, std::memory_order_release);
+    }
+
+    PoolAllocator::~PoolAllocator() {
+        for(auto& atomicCache : caches) {
+            ThreadCache* pCache = atomicCache.load(std::memory_order_acquire);
+            if(pCache == nullptr) {
+                continue;
+            }
+
+            SlabHeader* pSlab = pCache->pSlabs;
+            while(pSlab != nullptr) {
+                SlabHeader* pNext = pSlab->pNextSlab;
+                backingAllocator.deallocate(MemoryBlock {
+                    .ptr = pSlab,
+                    .size = SlabSize,
+                });
+                pSlab = pNext;
+            }
+            delete pCache;
+        }
+    }
+
+    /*static*/ std::size_t PoolAllocator::getSizeClassIndex(std::size_t size) {
+        verify(size <= MaxSmallSize, "Size is too big for size classes");
+        return SizeClassLookup[(size + SizeClassLookupGranularity - 1) / SizeClassLookupGranularity];
+    }
+
+    MemoryBlock PoolAllocator::allocate(std::size_t size, std::size_t alignment) {
+        if(alignment < 1) {
+            alignment = 1;
+        }
+        verify(std::has_single_bit(alignment), "Alignment must be a power of two");
+
+        const std::size_t effectiveSize = std::max(size, alignment);
+        if(effectiveSize > MaxSmallSize) {
+            MemoryBlock block = backingAllocator.allocate(effectiveSize, std::max(alignment, MinAlignment));
+            if(block.ptr == nullptr) {
+                throw OutOfMemoryException{};
+            }
+            bigAllocationCount.fetch_add(1, std::memory_order_relaxed);
+            bigAllocationBytes.fetch_add(effectiveSize, std::memory_order_relaxed);
+            return MemoryBlock {
+                .ptr = block.ptr,
+                .size = effectiveSize,
+            };
+        }
+
+        // over-aligned allocations use power-of-two classes, whose blocks are aligned on their size
+        const std::size_t sizeClass = alignment <= MinAlignment
+            ? getSizeClassIndex(effectiveSize)
+            : getSizeClassIndex(std::bit_ceil(effectiveSize));
+
+        ThreadCache& cache = getCurrentThreadCache();
+        const bool isSharedCache = &cache == caches[MaxThreadCaches].load(std::memory_order_relaxed);
+        if(isSharedCache) {
+            sharedCacheLock.lock();
+        }
+
+        void* ptr = allocateFromCache(cache, sizeClass);
+        addRelaxed(cache.stats.allocationCount, 1);
+        addRelaxed(cache.stats.allocatedBytes, SizeClasses[sizeClass]);
+
+        if(isSharedCache) {
+            sharedCacheLock.unlock();
+        }
+        return MemoryBlock {
+            .ptr = ptr,
+            .size = SizeClasses[sizeClass],
+        };
+    }
+
+    void PoolAllocator::deallocate(const MemoryBlock& block) {
+        if(block.ptr == nullptr) {
+            return;
+        }
+
+        if(block.size > MaxSmallSize) {
+            bigDeallocationCount.fetch_add(1, std::memory_order_relaxed);
+            bigAllocationBytes.fetch_sub(block.size, std::memory_order_relaxed);
+            backingAllocator.deallocate(block);
+            return;
+        }
+
+        SlabHeader* pSlab = getSlab(block.ptr);
+        ThreadCache& cache = getCurrentThreadCache();
+        freeToCache(cache, *pSlab->pOwner, pSlab->sizeClass, block.ptr);
+    }
+
+    MemoryBlock PoolAllocator::reallocate(const MemoryBlock& block, const std::size_t size, std::size_t alignment) {
+        if(block.ptr != nullptr && block.size <= MaxSmallSize && size <= MaxSmallSize) {
+            const std::size_t usableSize = SizeClasses[getSlab(block.ptr)->sizeClass];
+            const bool isAligned = (reinterpret_cast<std::uintptr_t>(block.ptr) & (std::max(alignment, static_cast<std::size_t>(1)) - 1)) == 0;
+            if(size <= usableSize && isAligned) {
+                return MemoryBlock {
+                    .ptr = block.ptr,
+                    .size = usableSize,
+                };
+            }
+        }
+        return Allocator::reallocate(block, size, alignment);
+    }
+
+    bool PoolAllocator::getStats(AllocatorStats& out) const {
+        AllocatorStats result;
+        std::size_t allocatedBytes = 0;
+        std::size_t freedBytes = 0;
+        for(const auto& atomicCache : caches) {
+            const ThreadCache* pCache = atomicCache.load(std::memory_order_acquire);
+            if(pCache == nullptr) {
+                continue;
+            }
+            result.allocationCount += pCache->stats.allocationCount.load(std::memory_order_relaxed);
+            result.deallocationCount += pCache->stats.deallocationCount.load(std::memory_order_relaxed);
+            result.bytesReserved += pCache->stats.reservedBytes.load(std::memory_order_relaxed);
+            allocatedBytes += pCache->stats.allocatedBytes.load(std::memory_order_relaxed);
+            freedBytes += pCache->stats.freedBytes.load(std::memory_order_relaxed);
+        }
+
+        const std::size_t bigBytes = bigAllocationBytes.load(std::memory_order_relaxed);
+        result.allocationCount += bigAllocationCount.load(std::memory_order_relaxed);
+        result.deallocationCount += bigDeallocationCount.load(std::memory_order_relaxed);
+        // values of different threads are not read at the same time, avoid reporting garbage if a free is seen before its allocation
+        result.bytesInUse = (allocatedBytes > freedBytes ? allocatedBytes - freedBytes : 0) + bigBytes;
+        result.bytesReserved += bigBytes;
+        out = result;
+        return true;
+    }
+
+    PoolAllocator::ThreadCache& PoolAllocator::getCurrentThreadCache() {
+        const std::size_t slot = currentThreadSlot.index;
+        ThreadCache* pCache = caches[slot].load(std::memory_order_acquire);
+        if(pCache == nullptr) {
+            // only the thread owning the slot can reach this point for this slot
+            pCache = new ThreadCache;
+            caches[slot].store(pCache, std::memory_order_release);
+        }
+        return *pCache;
+    }
+
+    void* PoolAllocator::allocateFromCache(ThreadCache& cache, std::size_t sizeClass) {
+        SizeClassCache& classCache = cache.classes[sizeClass];
+        if(classCache.pLocalFree == nullptr) {
+            // reclaim blocks freed by other threads
+            classCache.pLocalFree = cache.remoteFrees[sizeClass].exchange(nullptr, std::memory_order_acquire);
+        }
+
+        if(FreeBlock* pBlock = classCache.pLocalFree) {
+            classCache.pLocalFree = pBlock->pNext;
+            return pBlock;
+        }
+
+        const std::size_t blockSize = SizeClasses[sizeClass];
+        if(classCache.pBumpCursor == nullptr || classCache.pBumpCursor + blockSize > classCache.pBumpEnd) {
+            allocateSlab(cache, sizeClass);
+        }
+        void* ptr = classCache.pBumpCursor;
+        classCache.pBumpCursor += blockSize;
+        return ptr;
+    }
+
+    void PoolAllocator::freeToCache(ThreadCache& currentCache, ThreadCache& owner, std::size_t sizeClass, void* ptr) {
+        FreeBlock* pBlock = new (ptr) FreeBlock;
+        const bool isSharedCache = &currentCache == caches[MaxThreadCaches].load(std::memory_order_relaxed);
+        if(isSharedCache) {
+            sharedCacheLock.lock();
+        }
+
+        addRelaxed(currentCache.stats.deallocationCount, 1);
+        addRelaxed(currentCache.stats.freedBytes, SizeClasses[sizeClass]);
+
+        if(&currentCache == &owner) {
+            SizeClassCache& classCache = owner.classes[sizeClass];
+            pBlock->pNext = classCache.pLocalFree;
+            classCache.pLocalFree = pBlock;
+        } else {
+            // push only: the owner takes the entire list at once, so there is no ABA problem here
+            std::atomic<FreeBlock*>& head = owner.remoteFrees[sizeClass];
+            pBlock->pNext = head.load(std::memory_order_relaxed);
+            while(!head.compare_exchange_weak(pBlock->pNext, pBlock, std::memory_order_release, std::memory_order_relaxed)) {}
+        }
+
+        if(isSharedCache) {
+            sharedCacheLock.unlock();
+        }
+    }
+
+    void PoolAllocator::allocateSlab(ThreadCache& cache, std::size_t sizeClass) {
+        MemoryBlock slabMemory = backingAllocator.allocate(SlabSize, SlabSize);
+        if(slabMemory.ptr == nullptr) {
+            throw OutOfMemoryException{};
+        }
+        verify((reinterpret_cast<std::uintptr_t>(slabMemory.ptr) & (SlabSize - 1)) == 0, "Backing allocator did not respect the slab alignment");
+
+        SlabHeader* pSlab = new (slabMemory.ptr) SlabHeader;
+        pSlab->pOwner = &cache;
+        pSlab->sizeClass = static_cast<std::uint32_t>(sizeClass);
+        pSlab->pNextSlab = cache.pSlabs;
+        cache.pSlabs = pSlab;
+        addRelaxed(cache.stats.reservedBytes, SlabSize);
+
+        // remaining space of the previous slab of this class (less than a block) is lost
+        std::uint8_t* pSlabStart = static_cast<std::uint8_t*>(slabMemory.ptr);
+        SizeClassCache& classCache = cache.classes[sizeClass];
+        classCache.pBumpCursor = pSlabStart + getFirstBlockOffset(sizeof(SlabHeader), SizeClasses[sizeClass]);
+        classCache.pBumpEnd = pSlabStart + SlabSize;
+    }
+
+    /*static*/ PoolAllocator::SlabHeader* PoolAllocator::getSlab(void* ptr) {
+        return reinterpret_cast<SlabHeader*>(reinterpret_cast<std::uintptr_t>(ptr) & ~(SlabSize - 1));
+    }
+}
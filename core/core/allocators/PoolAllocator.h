@@ -0,0 +1,138 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <core/Allocator.h>
+#include <core/allocators/MallocAllocator.h>
+#include <core/async/Locks.h>
+
+namespace Carrot {
+    /**
+     * \brief Thread-safe allocator for small objects, which serves allocations from pools of fixed-size blocks (size classes).
+     *
+     * Memory is requested from the backing allocator in slabs of SlabSize bytes, each slab containing blocks of a single size class.
+     * Each thread gets its own cache of slabs and free blocks: allocating and freeing memory from the thread which allocated it
+     * does not need any synchronisation.
+     * Freeing a block from another thread pushes it on a lock-free list of the owning cache, which the owner reclaims the next
+     * time it runs out of free blocks for this size class.
+     *
+     * Allocations bigger than MaxSmallSize (or with an alignment bigger than MaxSmallSize) are forwarded to the backing allocator.
+     * Blocks are rounded to their size class: the size of the returned MemoryBlock is the usable size of the block,
+     * and 'deallocate' must be called with the block returned by 'allocate' (or a block with the same pointer and a size which
+     * is not bigger than MaxSmallSize).
+     *
+     * Caches of threads which have exited are given to the next threads which use the allocator. Slabs are only returned
+     * to the backing allocator when this allocator is destroyed.
+     * The backing allocator must be thread-safe.
+     */
+    class PoolAllocator: public Allocator {
+    public:
+        /// Size (and alignment) of slabs requested to the backing allocator
+        static constexpr std::size_t SlabSize = 64 * 1024;
+
+        /// Minimum alignment of all blocks returned by this allocator
+        static constexpr std::size_t MinAlignment = 16;
+
+        /// Biggest size served by size classes, bigger allocations go directly to the backing allocator
+        static constexpr std::size_t MaxSmallSize = 2048;
+
+        /// Maximum number of threads which get their own cache. Additional threads share a single cache, protected by a lock
+        static constexpr std::size_t MaxThreadCaches = 128;
+
+        /// Sizes of blocks served by this allocator. Power-of-two classes are aligned on their size
+        static constexpr std::array<std::uint32_t, 24> SizeClasses {
+            16, 32, 48, 64, 80, 96, 112, 128,
+            160, 192, 224, 256,
+            320, 384, 448, 512,
+            640, 768, 896, 1024,
+            1280, 1536, 1792, 2048,
+        };
+        static constexpr std::size_t SizeClassCount = SizeClasses.size();
+
+        /**
+         * \brief Creates a new PoolAllocator with the given allocator as a backing allocator.
+         * \param backingAllocator allocator to use for slabs and big allocations. Must be thread-safe
+         */
+        explicit PoolAllocator(Allocator& backingAllocator = MallocAllocator::instance);
+
+        /// Frees all slabs. Any block still allocated from this allocator becomes invalid.
+        ~PoolAllocator();
+
+        PoolAllocator(const PoolAllocator&) = delete;
+        PoolAllocator(PoolAllocator&&) = delete;
+        PoolAllocator& operator=(const PoolAllocator&) = delete;
+        PoolAllocator& operator=(PoolAllocator&&) = delete;
+
+        MemoryBlock allocate(std::size_t size, std::size_t alignment = 1) override;
+
+        void deallocate(const MemoryBlock& block) override;
+
+        /// Reuses the same block if the new size fits inside its size class
+        MemoryBlock reallocate(const MemoryBlock& block, const std::size_t size, std::size_t alignment = 1) override;
+
+        bool getStats(AllocatorStats& out) const override;
+
+        /// Index of the smallest size class which can contain 'size' bytes. 'size' must not be bigger than MaxSmallSize
+        static std::size_t getSizeClassIndex(std::size_t size);
+
+    private:
+        struct FreeBlock {
+            FreeBlock* pNext = nullptr;
+        };
+
+        struct ThreadCache;
+
+        /// Placed at the start of each slab, slabs are aligned on SlabSize so the header of a block can be found by masking its address
+        struct SlabHeader {
+            ThreadCache* pOwner = nullptr;
+            SlabHeader* pNextSlab = nullptr;
+            std::uint32_t sizeClass = 0;
+        };
+
+        struct SizeClassCache {
+            FreeBlock* pLocalFree = nullptr;
+            std::uint8_t* pBumpCursor = nullptr; // carving point inside the latest slab of this class
+            std::uint8_t* pBumpEnd = nullptr;
+        };
+
+        // written only by the thread using the cache: relaxed loads and stores are enough, getStats may read slightly stale values
+        struct CacheStats {
+            std::atomic<std::size_t> allocationCount = 0;
+            std::atomic<std::size_t> deallocationCount = 0;
+            std::atomic<std::size_t> allocatedBytes = 0;
+            std::atomic<std::size_t> freedBytes = 0;
+            std::atomic<std::size_t> reservedBytes = 0;
+        };
+
+        struct alignas(64) ThreadCache {
+            std::array<SizeClassCache, SizeClassCount> classes;
+            SlabHeader* pSlabs = nullptr;
+            CacheStats stats;
+
+            // blocks freed by other threads, one lock-free stack per size class. Only the owner pops (by taking the entire list)
+            alignas(64) std::array<std::atomic<FreeBlock*>, SizeClassCount> remoteFrees{};
+        };
+
+        ThreadCache& getCurrentThreadCache();
+        void* allocateFromCache(ThreadCache& cache, std::size_t sizeClass);
+        void freeToCache(ThreadCache& currentCache, ThreadCache& owner, std::size_t sizeClass, void* ptr);
+        void allocateSlab(ThreadCache& cache, std::size_t sizeClass);
+
+        static SlabHeader* getSlab(void* ptr);
+
+    private:
+        Allocator& backingAllocator;
+
+        // index MaxThreadCaches is the shared cache used by threads which could not get their own
+        std::array<std::atomic<ThreadCache*>, MaxThreadCaches + 1> caches{};
+        Async::SpinLock sharedCacheLock;
+
+        std::atomic<std::size_t> bigAllocationCount = 0;
+        std::atomic<std::size_t> bigDeallocationCount = 0;
+        std::atomic<std::size_t> bigAllocationBytes = 0;
+    };
+}
@@ -0,0 +1,350 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "TLSFAllocator.h"
+
+#include <bit>
+#include <core/utils/Assert.h>
+
+namespace Carrot {
+    namespace {
+        constexpr std::size_t alignUp(std::size_t value, std::size_t alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    }
+
+    TLSFAllocator::TLSFAllocator(Allocator& backingAllocator, std::size_t poolSize): backingAllocator(backingAllocator), poolSize(poolSize) {}
+
+    TLSFAllocator::~TLSFAllocator() {
+        for(const MemoryBlock& pool : pools) {
+            backingAllocator.deallocate(pool);
+        }
+    }
+
+    MemoryBlock TLSFAllocator::allocate(std::size_t size, std::size_t alignment) {
+        if(alignment < 1) {
+            alignment = 1;
+        }
+        verify(std::has_single_bit(alignment), "Alignment must be a power of two");
+        verify(size < MaxAllocationSize / 2, "Allocation is too big");
+
+        const std::size_t adjustedSize = std::max(alignUp(size, MinAlignment), MinBlockSize);
+        // over-aligned allocations search for a block big enough to put a free block in front of the aligned address
+        const std::size_t searchSize = alignment <= MinAlignment
+            ? adjustedSize
+            : adjustedSize + alignment + HeaderSize + MinBlockSize;
+
+        Async::LockGuard g { lock };
+        BlockHeader* pBlock = findSuitableBlock(searchSize);
+        if(pBlock == nullptr) {
+            addPool(searchSize);
+            pBlock = findSuitableBlock(searchSize);
+            if(pBlock == nullptr) {
+                throw OutOfMemoryException{};
+            }
+        }
+        removeFreeBlock(pBlock);
+
+        if(alignment > MinAlignment) {
+            const std::uintptr_t payload = reinterpret_cast<std::uintptr_t>(getPayload(pBlock));
+            std::uintptr_t alignedPayload = alignUp(payload, alignment);
+            if(alignedPayload != payload && alignedPayload - payload < HeaderSize + MinBlockSize) {
+                // gap too small to hold a free block
+                alignedPayload = alignUp(payload + HeaderSize + MinBlockSize, alignment);
+            }
+
+            if(alignedPayload != payload) {
+                const std::size_t gap = alignedPayload - payload;
+                BlockHeader* pAlignedBlock = getHeader(reinterpret_cast<void*>(alignedPayload));
+                pAlignedBlock->pPreviousPhysical = pBlock;
+                pAlignedBlock->sizeAndFlags = pBlock->getSize() - gap;
+                getNextPhysical(pAlignedBlock)->pPreviousPhysical = pAlignedBlock;
+
+                // the previous physical block of a free block is never free, the front gap can be inserted as-is
+                pBlock->setSize(gap - HeaderSize);
+                insertFreeBlock(pBlock);
+                pBlock = pAlignedBlock;
+            }
+        }
+
+        pBlock->setFree(false);
+        trimBlock(pBlock, adjustedSize);
+
+        stats.allocationCount++;
+        stats.bytesInUse += pBlock->getSize();
+        peakBytesInUse = std::max(peakBytesInUse, stats.bytesInUse);
+        return MemoryBlock {
+            .ptr = getPayload(pBlock),
+            .size = pBlock->getSize(),
+        };
+    }
+
+    void TLSFAllocator::deallocate(const MemoryBlock& block) {
+        if(block.ptr == nullptr) {
+            return;
+        }
+
+        Async::LockGuard g { lock };
+        BlockHeader* pBlock = getHeader(block.ptr);
+        verify(!pBlock->isFree(), "Double free detected");
+        stats.deallocationCount++;
+        stats.bytesInUse -= pBlock->getSize();
+        releaseBlock(pBlock);
+    }
+
+    MemoryBlock TLSFAllocator::reallocate(const MemoryBlock& block, const std::size_t size, std::size_t alignment) {
+        if(block.ptr == nullptr) {
+            return allocate(size, alignment);
+        }
+
+        const bool isAligned = (reinterpret_cast<std::uintptr_t>(block.ptr) & (std::max(alignment, static_cast<std::size_t>(1)) - 1)) == 0;
+        if(isAligned) {
+            Async::LockGuard g { lock };
+            BlockHeader* pBlock = getHeader(block.ptr);
+            const std::size_t adjustedSize = std::max(alignUp(size, MinAlignment), MinBlockSize);
+            const std::size_t previousSize = pBlock->getSize();
+
+            BlockHeader* pNext = getNextPhysical(pBlock);
+            const bool canGrowInPlace = pNext->isFree() && previousSize + HeaderSize + pNext->getSize() >= adjustedSize;
+            if(adjustedSize <= previousSize || canGrowInPlace) {
+                if(adjustedSize > previousSize) {
+                    // absorb next block
+                    removeFreeBlock(pNext);
+                    pBlock->setSize(previousSize + HeaderSize + pNext->getSize());
+                    getNextPhysical(pBlock)->pPreviousPhysical = pBlock;
+                }
+                trimBlock(pBlock, adjustedSize);
+
+                stats.bytesInUse = stats.bytesInUse - previousSize + pBlock->getSize();
+                peakBytesInUse = std::max(peakBytesInUse, stats.bytesInUse);
+                return MemoryBlock {
+                    .ptr = block.ptr,
+                    .size = pBlock->getSize(),
+                };
+            }
+        }
+
+        return Allocator::reallocate(block, size, alignment);
+    }
+
+    bool TLSFAllocator::getStats(AllocatorStats& out) const {
+        Async::LockGuard g { lock };
+        out = stats;
+        return true;
+    }
+
+    std::size_t TLSFAllocator::getPoolCount() const {
+        Async::LockGuard g { lock };
+        return pools.size();
+    }
+
+    std::size_t TLSFAllocator::getPeakBytesInUse() const {
+        Async::LockGuard g { lock };
+        return peakBytesInUse;
+    }
+
+    bool TLSFAllocator::validate() const {
+        Async::LockGuard g { lock };
+        std::size_t freeBlockCount = 0;
+        for(const MemoryBlock& pool : pools) {
+            BlockHeader* pPrevious = nullptr;
+            BlockHeader* pBlock = static_cast<BlockHeader*>(pool.ptr);
+            while(pBlock->getSize() != 0) {
+                if(pBlock->pPreviousPhysical != pPrevious) {
+                    return false;
+                }
+                if(pBlock->isFree()) {
+                    if(pPrevious != nullptr && pPrevious->isFree()) {
+                        return false; // should have been merged
+                    }
+
+                    std::size_t fl, sl;
+                    mapping(pBlock->getSize(), fl, sl);
+                    bool found = false;
+                    for(BlockHeader* pFree = freeLists[fl][sl]; pFree != nullptr; pFree = pFree->pNextFree) {
+                        found |= pFree == pBlock;
+                    }
+                    if(!found) {
+                        return false;
+                    }
+                    freeBlockCount++;
+                }
+                pPrevious = pBlock;
+                pBlock = getNextPhysical(pBlock);
+            }
+
+            // sentinel must be at the very end of the pool
+            if(reinterpret_cast<std::uint8_t*>(pBlock) + HeaderSize != static_cast<std::uint8_t*>(pool.ptr) + pool.size) {
+                return false;
+            }
+            if(pBlock->pPreviousPhysical != pPrevious || pBlock->isFree()) {
+                return false;
+            }
+        }
+
+        std::size_t listedBlockCount = 0;
+        for(std::size_t fl = 0; fl < FirstLevelCount; fl++) {
+            for(std::size_t sl = 0; sl < SecondLevelCount; sl++) {
+                const bool hasBlocks = freeLists[fl][sl] != nullptr;
+                if(hasBlocks != ((secondLevelBitmaps[fl] & (1u << sl)) != 0)) {
+                    return false;
+                }
+                for(BlockHeader* pFree = freeLists[fl][sl]; pFree != nullptr; pFree = pFree->pNextFree) {
+                    listedBlockCount++;
+                }
+            }
+            if((secondLevelBitmaps[fl] != 0) != ((firstLevelBitmap & (1u << fl)) != 0)) {
+                return false;
+            }
+        }
+        return listedBlockCount == freeBlockCount;
+    }
+
+    /*static*/ std::uint8_t* TLSFAllocator::getPayload(BlockHeader* pBlock) {
+        return reinterpret_cast<std::uint8_t*>(pBlock) + HeaderSize;
+    }
+
+    /*static*/ TLSFAllocator::BlockHeader* TLSFAllocator::getHeader(void* pPayload) {
+        return reinterpret_cast<BlockHeader*>(static_cast<std::uint8_t*>(pPayload) - HeaderSize);
+    }
+
+    /*static*/ TLSFAllocator::BlockHeader* TLSFAllocator::getNextPhysical(BlockHeader* pBlock) {
+        return reinterpret_cast<BlockHeader*>(getPayload(pBlock) + pBlock->getSize());
+    }
+
+    /*static*/ void TLSFAllocator::mapping(std::size_t size, std::size_t& fl, std::size_t& sl) {
+        if(size < SmallBlockSize) {
+            fl = 0;
+            sl = size / (SmallBlockSize / SecondLevelCount);
+        } else {
+            const std::size_t mostSignificantBit = std::bit_width(size) - 1;
+            sl = (size >> (mostSignificantBit - SecondLevelCountLog2)) ^ SecondLevelCount;
+            fl = mostSignificantBit - (FirstLevelShift - 1);
+        }
+    }
+
+    /*static*/ std::size_t TLSFAllocator::roundUpToListSize(std::size_t size) {
+        if(size >= SmallBlockSize) {
+            const std::size_t round = (std::size_t{1} << (std::bit_width(size) - 1 - SecondLevelCountLog2)) - 1;
+            size += round;
+        }
+        return size;
+    }
+
+    /*static*/ void TLSFAllocator::mappingSearch(std::size_t size, std::size_t& fl, std::size_t& sl) {
+        // round up to the next list, so that any block of the found list is big enough
+        mapping(roundUpToListSize(size), fl, sl);
+    }
+
+    TLSFAllocator::BlockHeader* TLSFAllocator::findSuitableBlock(std::size_t size) {
+        std::size_t fl, sl;
+        mappingSearch(size, fl, sl);
+        if(fl >= FirstLevelCount) {
+            return nullptr;
+        }
+
+        std::uint32_t secondLevelMap = secondLevelBitmaps[fl] & (~0u << sl);
+        if(secondLevelMap == 0) {
+            const std::uint32_t firstLevelMap = fl + 1 < FirstLevelCount ? firstLevelBitmap & (~0u << (fl + 1)) : 0;
+            if(firstLevelMap == 0) {
+                return nullptr;
+            }
+            fl = std::countr_zero(firstLevelMap);
+            secondLevelMap = secondLevelBitmaps[fl];
+        }
+        sl = std::countr_zero(secondLevelMap);
+        return freeLists[fl][sl];
+    }
+
+    void TLSFAllocator::insertFreeBlock(BlockHeader* pBlock) {
+        std::size_t fl, sl;
+        mapping(pBlock->getSize(), fl, sl);
+
+        pBlock->setFree(true);
+        pBlock->pPreviousFree = nullptr;
+        pBlock->pNextFree = freeLists[fl][sl];
+        if(pBlock->pNextFree != nullptr) {
+            pBlock->pNextFree->pPreviousFree = pBlock;
+        }
+        freeLists[fl][sl] = pBlock;
+        firstLevelBitmap |= 1u << fl;
+        secondLevelBitmaps[fl] |= 1u << sl;
+    }
+
+    void TLSFAllocator::removeFreeBlock(BlockHeader* pBlock) {
+        std::size_t fl, sl;
+        mapping(pBlock->getSize(), fl, sl);
+
+        if(pBlock->pPreviousFree != nullptr) {
+            pBlock->pPreviousFree->pNextFree = pBlock->pNextFree;
+        } else {
+            freeLists[fl][sl] = pBlock->pNextFree;
+            if(freeLists[fl][sl] == nullptr) {
+                secondLevelBitmaps[fl] &= ~(1u << sl);
+                if(secondLevelBitmaps[fl] == 0) {
+                    firstLevelBitmap &= ~(1u << fl);
+                }
+            }
+        }
+        if(pBlock->pNextFree != nullptr) {
+            pBlock->pNextFree->pPreviousFree = pBlock->pPreviousFree;
+        }
+        pBlock->pNextFree = nullptr;
+        pBlock->pPreviousFree = nullptr;
+    }
+
+    void TLSFAllocator::releaseBlock(BlockHeader* pBlock) {
+        BlockHeader* pPrevious = pBlock->pPreviousPhysical;
+        if(pPrevious != nullptr && pPrevious->isFree()) {
+            removeFreeBlock(pPrevious);
+            pPrevious->setSize(pPrevious->getSize() + HeaderSize + pBlock->getSize());
+            getNextPhysical(pPrevious)->pPreviousPhysical = pPrevious;
+            pBlock = pPrevious;
+        }
+
+        BlockHeader* pNext = getNextPhysical(pBlock);
+        if(pNext->isFree()) {
+            removeFreeBlock(pNext);
+            pBlock->setSize(pBlock->getSize() + HeaderSize + pNext->getSize());
+            getNextPhysical(pBlock)->pPreviousPhysical = pBlock;
+        }
+
+        insertFreeBlock(pBlock);
+    }
+
+    void TLSFAllocator::trimBlock(BlockHeader* pBlock, std::size_t size) {
+        if(pBlock->getSize() < size + HeaderSize + MinBlockSize) {
+            return;
+        }
+
+        BlockHeader* pRemaining = reinterpret_cast<BlockHeader*>(getPayload(pBlock) + size);
+        pRemaining->pPreviousPhysical = pBlock;
+        pRemaining->sizeAndFlags = pBlock->getSize() - size - HeaderSize;
+        pBlock->setSize(size);
+        getNextPhysical(pRemaining)->pPreviousPhysical = pRemaining;
+        releaseBlock(pRemaining);
+    }
+
+    void TLSFAllocator::addPool(std::size_t minPayloadSize) {
+        // one block spanning the entire pool, followed by an used sentinel of size 0 which is never merged
+        // the block must be big enough to be found by mappingSearch
+        const std::size_t size = alignUp(std::max(poolSize, roundUpToListSize(minPayloadSize) + 2 * HeaderSize), MinAlignment);
+        MemoryBlock pool = backingAllocator.allocate(size, MinAlignment);
+        if(pool.ptr == nullptr) {
+            throw OutOfMemoryException{};
+        }
+        pool.size = size;
+        pools.push_back(pool);
+        stats.bytesReserved += size;
+
+        BlockHeader* pBlock = new (pool.ptr) BlockHeader;
+        pBlock->sizeAndFlags = size - 2 * HeaderSize;
+
+        BlockHeader* pSentinel = new (getNextPhysical(pBlock)) BlockHeader;
+        pSentinel->pPreviousPhysical = pBlock;
+        pSentinel->sizeAndFlags = 0;
+
+        insertFreeBlock(pBlock);
+    }
+}
@@ -0,0 +1,124 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <core/Allocator.h>
+#include <core/allocators/MallocAllocator.h>
+#include <core/async/Locks.h>
+
+namespace Carrot {
+    /**
+     * \brief General-purpose allocator based on Two-Level Segregated Fit (TLSF): allocations and deallocations are done in O(1),
+     * with low fragmentation. Free blocks are sorted in lists indexed by two levels of size ranges (power of two, then linear subdivisions),
+     * and bitmaps of non-empty lists are used to find a suitable block without any search.
+     *
+     * Memory is requested from the backing allocator in pools (of at least 'poolSize' bytes), which are only returned when the allocator
+     * is destroyed. Adjacent free blocks are merged when deallocating.
+     *
+     * Thread-safe: a single lock protects the allocator. For small objects used from a lot of threads, prefer PoolAllocator.
+     */
+    class TLSFAllocator: public Allocator {
+    public:
+        /// Minimum alignment of all blocks returned by this allocator
+        static constexpr std::size_t MinAlignment = 16;
+
+        /// Maximum size of a single allocation (exclusive)
+        static constexpr std::size_t MaxAllocationSize = std::size_t{1} << 40;
+
+        /**
+         * \brief Creates a new TLSFAllocator with the given allocator as a backing allocator.
+         * \param backingAllocator allocator to use for pools
+         * \param poolSize minimum size of pools requested to the backing allocator
+         */
+        explicit TLSFAllocator(Allocator& backingAllocator = MallocAllocator::instance, std::size_t poolSize = 1024 * 1024);
+        ~TLSFAllocator();
+
+        TLSFAllocator(const TLSFAllocator&) = delete;
+        TLSFAllocator(TLSFAllocator&&) = delete;
+        TLSFAllocator& operator=(const TLSFAllocator&) = delete;
+        TLSFAllocator& operator=(TLSFAllocator&&) = delete;
+
+        MemoryBlock allocate(std::size_t size, std::size_t alignment = 1) override;
+
+        void deallocate(const MemoryBlock& block) override;
+
+        /// Grows or shrinks the block in place when possible (enough space in the block, or a free block right after it)
+        MemoryBlock reallocate(const MemoryBlock& block, const std::size_t size, std::size_t alignment = 1) override;
+
+        bool getStats(AllocatorStats& out) const override;
+
+        std::size_t getPoolCount() const;
+
+        /// Size of the biggest peak of bytesInUse since the creation of this allocator
+        std::size_t getPeakBytesInUse() const;
+
+        /**
+         * \brief Checks the internal consistency of this allocator (physical links, free lists, merged free blocks). Slow, meant for tests and debugging
+         * \return true iif no inconsistency was found
+         */
+        bool validate() const;
+
+    private:
+        static constexpr std::size_t AlignmentLog2 = 4;
+        static constexpr std::size_t SecondLevelCountLog2 = 5;
+        static constexpr std::size_t SecondLevelCount = 1 << SecondLevelCountLog2;
+        static constexpr std::size_t FirstLevelShift = SecondLevelCountLog2 + AlignmentLog2;
+        static constexpr std::size_t SmallBlockSize = std::size_t{1} << FirstLevelShift;
+        static constexpr std::size_t FirstLevelCount = 40 - FirstLevelShift + 1;
+
+        struct BlockHeader {
+            BlockHeader* pPreviousPhysical = nullptr;
+            std::size_t sizeAndFlags = 0; // size of the payload, lowest bit set when the block is free
+            BlockHeader* pNextFree = nullptr;
+            BlockHeader* pPreviousFree = nullptr;
+
+            std::size_t getSize() const { return sizeAndFlags & ~FreeFlag; }
+            void setSize(std::size_t size) { sizeAndFlags = size | (sizeAndFlags & FreeFlag); }
+            bool isFree() const { return (sizeAndFlags & FreeFlag) != 0; }
+            void setFree(bool free) { sizeAndFlags = getSize() | (free ? FreeFlag : 0); }
+
+            static constexpr std::size_t FreeFlag = 1;
+        };
+        static constexpr std::size_t HeaderSize = sizeof(BlockHeader);
+        static constexpr std::size_t MinBlockSize = MinAlignment;
+        static_assert(HeaderSize % MinAlignment == 0);
+
+        static std::uint8_t* getPayload(BlockHeader* pBlock);
+        static BlockHeader* getHeader(void* pPayload);
+        static BlockHeader* getNextPhysical(BlockHeader* pBlock);
+
+        static void mapping(std::size_t size, std::size_t& fl, std::size_t& sl);
+        static std::size_t roundUpToListSize(std::size_t size);
+        static void mappingSearch(std::size_t size, std::size_t& fl, std::size_t& sl);
+
+        BlockHeader* findSuitableBlock(std::size_t size);
+        void insertFreeBlock(BlockHeader* pBlock);
+        void removeFreeBlock(BlockHeader* pBlock);
+
+        /// Marks the block as free, merges it with its free neighbours, and inserts the result in the free lists
+        void releaseBlock(BlockHeader* pBlock);
+
+        /// Splits the end of an used block if it is big enough to be a block on its own
+        void trimBlock(BlockHeader* pBlock, std::size_t size);
+
+        void addPool(std::size_t minPayloadSize);
+
+    private:
+        Allocator& backingAllocator;
+        std::size_t poolSize = 0;
+        mutable Async::SpinLock lock;
+
+        std::uint32_t firstLevelBitmap = 0;
+        std::array<std::uint32_t, FirstLevelCount> secondLevelBitmaps{};
+        std::array<std::array<BlockHeader*, SecondLevelCount>, FirstLevelCount> freeLists{};
+
+        std::vector<MemoryBlock> pools;
+
+        AllocatorStats stats;
+        std::size_t peakBytesInUse = 0;
+    };
+}
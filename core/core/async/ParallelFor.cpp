@@ -0,0 +1,117 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <core/async/Locks.h>
+#include <core/utils/Assert.h>
+
+namespace Carrot::Async {
+    // jobs which may have pending chunks, for threads waiting for a job to finish
+    static SpinLock activeJobsAccess;
+    static std::vector<std::weak_ptr<ParallelForJob>> activeJobs;
+
+    std::shared_ptr<ParallelForJob> ParallelForJob::create(std::size_t count, const std::function<void(std::size_t)>& forEach, std::size_t granularity, std::size_t participantCount) {
+        auto job = std::make_shared<ParallelForJob>(count, forEach, granularity, participantCount);
+        LockGuard l { activeJobsAccess };
+        std::erase_if(activeJobs, [](const std::weak_ptr<ParallelForJob>& j) { return j.expired(); });
+        activeJobs.emplace_back(job);
+        return job;
+    }
+
+    ParallelForJob::ParallelForJob(std::size_t count, const std::function<void(std::size_t)>& forEach, std::size_t granularity, std::size_t participantCount)
+        : count(count)
+        , pForEach(&forEach)
+        , automaticGranularity(granularity == 0)
+    {
+        verify(participantCount > 0, "At least the calling thread must participate");
+        if(automaticGranularity) {
+            // at least 4 chunks per participant, to balance uneven workloads
+            maxChunkSize = std::max<std::size_t>(1, count / (participantCount * 4));
+            chunkSize = 1; // first chunks are used to measure the cost of an index
+        } else {
+            maxChunkSize = granularity;
+            chunkSize = granularity;
+        }
+    }
+
+    bool ParallelForJob::runChunk() {
+        // register as in flight *before* claiming: once the cursor is past the end and inFlight is 0, no thread can touch pForEach anymore
+        inFlight.fetch_add(1);
+        const std::size_t size = chunkSize.load(std::memory_order_relaxed);
+        const std::size_t start = cursor.fetch_add(size);
+        if(start >= count) {
+            inFlight.fetch_sub(1);
+            return false;
+        }
+
+        const std::size_t end = std::min(count, start + size);
+        if(automaticGranularity) {
+            const auto chunkStart = std::chrono::steady_clock::now();
+            for(std::size_t i = start; i < end; i++) {
+                (*pForEach)(i);
+            }
+            const std::uint64_t elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - chunkStart).count();
+            const std::uint64_t costPerIndex = std::max<std::uint64_t>(1, elapsedNs / (end - start));
+            const std::size_t newSize = std::clamp<std::size_t>(TargetChunkDurationNs / costPerIndex, 1, maxChunkSize);
+            chunkSize.store(newSize, std::memory_order_relaxed);
+        } else {
+            for(std::size_t i = start; i < end; i++) {
+                (*pForEach)(i);
+            }
+        }
+
+        inFlight.fetch_sub(1);
+        return true;
+    }
+
+    void ParallelForJob::work() {
+        while(runChunk()) {}
+    }
+
+    void ParallelForJob::wait() {
+        work();
+        while(!isDone()) {
+            if(!helpActiveJob(this)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    bool ParallelForJob::hasPendingChunks() const {
+        return cursor.load() < count;
+    }
+
+    bool ParallelForJob::isDone() const {
+        return !hasPendingChunks() && inFlight.load() == 0;
+    }
+
+    std::size_t ParallelForJob::getChunkSize() const {
+        return chunkSize.load(std::memory_order_relaxed);
+    }
+
+    bool helpActiveJob(const ParallelForJob* except) {
+        std::shared_ptr<ParallelForJob> toHelp;
+        {
+            LockGuard l { activeJobsAccess };
+            for(const auto& weakJob : activeJobs) {
+                auto job = weakJob.lock();
+                if(job && job.get() != except && job->hasPendingChunks()) {
+                    toHelp = std::move(job);
+                    break;
+                }
+            }
+        }
+
+        if(!toHelp) {
+            return false;
+        }
+        toHelp->work();
+        return true;
+    }
+}
@@ -0,0 +1,71 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace Carrot::Async {
+    /**
+     * \brief Shared state of a parallel for loop, without fibers: participating threads claim chunks of indices until the range is exhausted.
+     * The thread which started the loop runs chunks too, and helps other active loops while waiting for the last chunks, instead of spinning.
+     * This makes nested parallel loops safe: a thread never waits for work which nobody started.
+     *
+     * When no granularity is given, the chunk size is chosen from the measured cost of previous chunks, so that each chunk takes
+     * about TargetChunkDuration. Chunks are also capped to leave a few chunks per participant, to balance uneven workloads.
+     */
+    class ParallelForJob {
+    public:
+        /// Duration a chunk should take when the granularity is automatic: long enough to amortize claiming a chunk, short enough to balance threads
+        static constexpr std::uint64_t TargetChunkDurationNs = 50'000;
+
+        /**
+         * \param count how many indices to run
+         * \param forEach what to execute for each index. Must outlive the job (wait() must be called before destroying it)
+         * \param granularity how many indices per chunk, 0 to pick it automatically
+         * \param participantCount how many threads are expected to work on this job, including the calling thread
+         */
+        static std::shared_ptr<ParallelForJob> create(std::size_t count, const std::function<void(std::size_t)>& forEach, std::size_t granularity, std::size_t participantCount);
+
+        ParallelForJob(std::size_t count, const std::function<void(std::size_t)>& forEach, std::size_t granularity, std::size_t participantCount);
+
+        /// Runs chunks until there are none left. Can be called from any thread, even after the job is done (does nothing in that case)
+        void work();
+
+        /// Runs chunks until there are none left, then waits for chunks still running on other threads.
+        /// While waiting, helps other active jobs (for instance jobs started by the chunks of this job).
+        void wait();
+
+        /// Are there chunks which no thread claimed yet?
+        bool hasPendingChunks() const;
+
+        /// All chunks were claimed and finished running
+        bool isDone() const;
+
+        /// Chunk size currently used by this job
+        std::size_t getChunkSize() const;
+
+    private:
+        /// Claims and runs a single chunk. Returns false if no chunk was left
+        bool runChunk();
+
+        std::size_t count = 0;
+        const std::function<void(std::size_t)>* pForEach = nullptr;
+        bool automaticGranularity = true;
+        std::size_t maxChunkSize = 1;
+
+        std::atomic<std::size_t> cursor { 0 }; //< next index to claim
+        std::atomic<std::size_t> chunkSize { 1 };
+        std::atomic<std::size_t> inFlight { 0 }; //< threads which are claiming or running a chunk
+    };
+
+    /**
+     * Helps a single active job (other than 'except') by running its pending chunks.
+     * Returns false if no job had pending chunks
+     */
+    bool helpActiveJob(const ParallelForJob* except = nullptr);
+}
@@ -88,7 +88,7 @@ namespace Carrot {
         };
 
         void buildInner(Node* pDestination, Carrot::Allocator& tempAllocator, std::span<const TElement> allElements, const Carrot::Vector<std::size_t>& subset, std::size_t depth, const glm::vec3& regionMin, const glm::vec3& regionMax);
-        Node* findClosest(const TElement& element) const;
+        const Node* findClosest(const TElement& element) const;
         void rangeSearchInner(Vector<std::size_t>& out, const Node* pRoot, const glm::vec3& min, const glm::vec3& max) const;
 
         Allocator& allocator;
@@ -40,7 +40,7 @@ namespace Carrot {
 
     KD_TREE_TEMPLATE
     std::int64_t KDTree<TElement>::closestNeighbor(const TElement& from, float maxDistance) const {
-        Node* closest = findClosest(from);
+        const Node* closest = findClosest(from);
         if(closest == nullptr) {
             return -1;
         }
@@ -154,13 +154,13 @@ namespace Carrot {
     }
 
     KD_TREE_TEMPLATE
-    typename KDTree<TElement>::Node* KDTree<TElement>::findClosest(const TElement& from) const {
+    const typename KDTree<TElement>::Node* KDTree<TElement>::findClosest(const TElement& from) const {
         if(empty()) {
             return nullptr;
         }
 
         // 1. find leaf with the closest element
-        Node* currentNode = &root;
+        const Node* currentNode = &root;
         std::size_t depth = 0;
 
         const float nodePositions[3] = {
@@ -178,7 +178,7 @@ namespace Carrot {
 
             const float split = currentNode->medianPoint[axisIndex];
             if(nodePositions[axisIndex] < split) {
-                Node* nextNode = currentNode->pLeft.get();
+                const Node* nextNode = currentNode->pLeft.get();
                 if(nextNode == nullptr) {
                     found = true;
                     break; // closest is 'currentNode'
@@ -186,7 +186,7 @@ namespace Carrot {
                     currentNode = nextNode;
                 }
             } else {
-                Node* nextNode = currentNode->pRight.get();
+                const Node* nextNode = currentNode->pRight.get();
                 if(nextNode == nullptr) {
                     found = true;
                     break; // closest is 'currentNode'
@@ -15,13 +15,10 @@ namespace ShaderCompiler {
             sourceFiles.emplace_back(std::move(path));
         }
         auto args = json["command_arguments"].GetArray();
-        verify(args.Size() == commandArguments.size(), "Wrong size for command_arguments");
-        commandArguments = {
-                args[0].GetString(),
-                args[1].GetString(),
-                args[2].GetString(),
-                args[3].GetString(),
-        };
+        verify(args.Size() >= 4, "Wrong size for command_arguments");
+        for(const auto& arg : args) {
+            commandArguments.emplace_back(arg.GetString());
+        }
     }
 
     void Metadata::writeJSON(rapidjson::Document& document) const {
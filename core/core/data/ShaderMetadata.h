@@ -5,7 +5,7 @@
 #pragma once
 
 #include <filesystem>
-#include <array>
+#include <vector>
 #include <string>
 #include <core/io/Resource.h>
 #include <core/utils/JSON.h>
@@ -13,7 +13,7 @@
 namespace ShaderCompiler {
     struct Metadata {
         std::vector<std::filesystem::path> sourceFiles; // all source files used to create this shader (original .glsl + included files)
-        std::array<std::string, 4> commandArguments; // command to launch to recompile this shader
+        std::vector<std::string> commandArguments; // command to launch to recompile this shader: base path, input, output, stage, then defines (-DNAME=VALUE)
 
         // Initializes an empty metadata struct
         explicit Metadata() = default;
@@ -0,0 +1,176 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "ShaderReflection.h"
+#include <core/io/Serialisation.h>
+#include <core/utils/stringmanip.h>
+#include <cstring>
+#include <limits>
+#include <spirv_cross.hpp>
+#include <stdexcept>
+
+namespace ShaderCompiler {
+    /// Adds the resources of the given type, in declaration order
+    static void reflectResources(const spirv_cross::Compiler& compiler, ResourceType type,
+                                 const spirv_cross::SmallVector<spirv_cross::Resource>& resources, std::vector<Reflection::Resource>& out) {
+        for(const auto& resource : resources) {
+            Reflection::Resource& reflected = out.emplace_back();
+            reflected.name = resource.name;
+            reflected.set = compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
+            reflected.binding = compiler.get_decoration(resource.id, spv::DecorationBinding);
+            reflected.type = type;
+
+            const auto& resourceType = compiler.get_type(resource.type_id);
+            if(!resourceType.array.empty()) {
+                if(resourceType.array_size_literal[0]) {
+                    reflected.count = resourceType.array[0];
+                } else {
+                    // size given by a specialization constant, which can be overriden when creating the pipeline
+                    const std::uint32_t constantID = resourceType.array[0];
+                    reflected.count = compiler.get_constant(constantID).scalar();
+                    reflected.countConstant = compiler.get_name(constantID);
+                }
+            }
+        }
+    }
+
+    Reflection Reflection::fromSPIRV(std::span<const std::uint8_t> code) {
+        if(code.size() % sizeof(std::uint32_t) != 0) {
+            throw std::runtime_error(Carrot::sprintf("Invalid SPIR-V: size (%llu) is not a multiple of 4", static_cast<unsigned long long>(code.size())));
+        }
+        std::vector<std::uint32_t> words;
+        words.resize(code.size() / sizeof(std::uint32_t));
+        std::memcpy(words.data(), code.data(), code.size());
+
+        const spirv_cross::Compiler compiler { std::move(words) };
+        const auto resources = compiler.get_shader_resources();
+
+        Reflection reflection;
+        reflection.codeHash = hashCode(code);
+
+        reflectResources(compiler, ResourceType::UniformBuffer, resources.uniform_buffers, reflection.resources);
+        reflectResources(compiler, ResourceType::Sampler, resources.separate_samplers, reflection.resources);
+        reflectResources(compiler, ResourceType::CombinedImageSampler, resources.sampled_images, reflection.resources);
+        reflectResources(compiler, ResourceType::SampledImage, resources.separate_images, reflection.resources);
+        reflectResources(compiler, ResourceType::InputAttachment, resources.subpass_inputs, reflection.resources);
+        reflectResources(compiler, ResourceType::StorageBuffer, resources.storage_buffers, reflection.resources);
+        reflectResources(compiler, ResourceType::StorageImage, resources.storage_images, reflection.resources);
+        reflectResources(compiler, ResourceType::AccelerationStructure, resources.acceleration_structures, reflection.resources);
+
+        if(!resources.push_constant_buffers.empty()) {
+            // only the range actually used by the shader is part of the layout
+            const auto& pushConstant = resources.push_constant_buffers[0];
+            PushConstantBlock& block = reflection.pushConstants.emplace();
+            block.name = pushConstant.name;
+            block.offset = std::numeric_limits<std::uint32_t>::max();
+            block.size = 0;
+            for(const auto& range : compiler.get_active_buffer_ranges(pushConstant.id)) {
+                block.offset = std::min(static_cast<std::uint32_t>(range.offset), block.offset);
+                block.size = std::max(static_cast<std::uint32_t>(range.offset + range.range), block.size);
+            }
+        }
+        return reflection;
+    }
+
+    /// Strings are length-prefixed: check the length before allocating, corrupted data could ask for gigabytes
+    static std::string readString(Carrot::IO::VectorReader& reader, std::size_t dataSize) {
+        std::uint32_t length = 0;
+        reader >> length;
+        if(length > dataSize) {
+            throw std::runtime_error(Carrot::sprintf("Invalid shader reflection: string length (%u) is larger than the file", length));
+        }
+        std::string str;
+        str.resize(length);
+        for(char& c : str) {
+            reader >> c;
+        }
+        return str;
+    }
+
+    Reflection Reflection::deserialise(std::span<const std::uint8_t> data) {
+        Carrot::IO::VectorReader reader { data };
+        std::uint32_t magic = 0;
+        std::uint32_t version = 0;
+        reader >> magic;
+        reader >> version;
+        if(magic != Magic) {
+            throw std::runtime_error("Invalid shader reflection: wrong magic");
+        }
+        if(version != Version) {
+            throw std::runtime_error(Carrot::sprintf("Invalid shader reflection: unsupported version %u (expected %u)", version, Version));
+        }
+
+        Reflection reflection;
+        reader >> reflection.codeHash;
+
+        std::uint32_t resourceCount = 0;
+        reader >> resourceCount;
+        if(resourceCount > data.size()) {
+            throw std::runtime_error(Carrot::sprintf("Invalid shader reflection: resource count (%u) is larger than the file", resourceCount));
+        }
+        reflection.resources.resize(resourceCount);
+        for(Resource& resource : reflection.resources) {
+            std::uint32_t type = 0;
+            resource.name = readString(reader, data.size());
+            reader >> resource.set;
+            reader >> resource.binding;
+            reader >> type;
+            reader >> resource.count;
+            resource.countConstant = readString(reader, data.size());
+
+            if(type > static_cast<std::uint32_t>(ResourceType::AccelerationStructure)) {
+                throw std::runtime_error(Carrot::sprintf("Invalid shader reflection: unknown resource type %u for '%s'", type, resource.name.c_str()));
+            }
+            resource.type = static_cast<ResourceType>(type);
+        }
+
+        bool hasPushConstants = false;
+        reader >> hasPushConstants;
+        if(hasPushConstants) {
+            PushConstantBlock& block = reflection.pushConstants.emplace();
+            block.name = readString(reader, data.size());
+            reader >> block.offset;
+            reader >> block.size;
+        }
+        return reflection;
+    }
+
+    std::vector<std::uint8_t> Reflection::serialise() const {
+        std::vector<std::uint8_t> out;
+        out << Magic;
+        out << Version;
+        out << codeHash;
+        out << static_cast<std::uint32_t>(resources.size());
+        for(const Resource& resource : resources) {
+            out << std::string_view { resource.name };
+            out << resource.set;
+            out << resource.binding;
+            out << static_cast<std::uint32_t>(resource.type);
+            out << resource.count;
+            out << std::string_view { resource.countConstant };
+        }
+        out << pushConstants.has_value();
+        if(pushConstants.has_value()) {
+            out << std::string_view { pushConstants->name };
+            out << pushConstants->offset;
+            out << pushConstants->size;
+        }
+        return out;
+    }
+
+    std::uint64_t Reflection::hashCode(std::span<const std::uint8_t> code) {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        for(const std::uint8_t b : code) {
+            hash ^= b;
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    std::filesystem::path Reflection::getSidecarPath(const std::filesystem::path& spirvPath) {
+        std::filesystem::path sidecarPath = spirvPath;
+        sidecarPath.replace_extension(".reflection");
+        return sidecarPath;
+    }
+}
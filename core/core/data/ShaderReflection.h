@@ -0,0 +1,75 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ShaderCompiler {
+    /// Kinds of descriptors a shader can declare, with the same meaning as the vk::DescriptorType of the same name.
+    /// Resources are listed in this order inside Reflection::resources
+    enum class ResourceType: std::uint32_t {
+        UniformBuffer,
+        Sampler,
+        CombinedImageSampler,
+        SampledImage,
+        InputAttachment,
+        StorageBuffer,
+        StorageImage,
+        AccelerationStructure,
+    };
+
+    /// Resources and push constants declared by a SPIR-V module.
+    /// shadercompiler bakes this next to each .spv (see getSidecarPath), so that the engine does not need to parse the SPIR-V with SPIRV-Cross
+    /// when creating pipelines. Runtime reflection (fromSPIRV) is only a fallback when the sidecar is missing or outdated.
+    struct Reflection {
+        static constexpr std::uint32_t Magic = 'C' | ('S' << 8) | ('R' << 16) | ('F' << 24);
+
+        /// Increment when the format of the sidecar changes
+        static constexpr std::uint32_t Version = 1;
+
+        struct Resource {
+            std::string name;
+            std::uint32_t set = 0;
+            std::uint32_t binding = 0;
+            ResourceType type = ResourceType::UniformBuffer;
+            std::uint32_t count = 1; // array size, or default value of 'countConstant'
+            std::string countConstant; // name of the specialization constant giving the array size, empty if the size is a literal
+
+            bool operator==(const Resource&) const = default;
+        };
+
+        struct PushConstantBlock {
+            std::string name;
+            std::uint32_t offset = 0; // start of the first member used by the shader
+            std::uint32_t size = 0; // end of the last member used by the shader
+
+            bool operator==(const PushConstantBlock&) const = default;
+        };
+
+        std::uint64_t codeHash = 0; // see 'hashCode', used to detect a sidecar which does not match its .spv anymore
+        std::vector<Resource> resources; // sorted by type, then in declaration order
+        std::optional<PushConstantBlock> pushConstants;
+
+        bool operator==(const Reflection&) const = default;
+
+        /// Reflects the given SPIR-V with SPIRV-Cross. Throws if the code cannot be parsed
+        static Reflection fromSPIRV(std::span<const std::uint8_t> code);
+
+        /// Reads the output of 'serialise'. Throws if 'data' is not a valid sidecar
+        static Reflection deserialise(std::span<const std::uint8_t> data);
+        std::vector<std::uint8_t> serialise() const;
+
+        /// Hash of SPIR-V code (64-bit FNV-1a)
+        static std::uint64_t hashCode(std::span<const std::uint8_t> code);
+
+        /// Path of the sidecar written next to the given .spv file
+        static std::filesystem::path getSidecarPath(const std::filesystem::path& spirvPath);
+    };
+}
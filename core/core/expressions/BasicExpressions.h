@@ -161,9 +161,10 @@ namespace Carrot {
     using MultExpression = BinaryOperationExpression<std::multiplies<float>>;
     using DivExpression = BinaryOperationExpression<std::divides<float>>;
 
+    /// Floored modulo, like GLSL mod (OpFMod): the result has the sign of y
     struct fmodstruct {
         float operator()(const float& x, const float& y) const {
-            return std::fmod(x, y);
+            return x - y * std::floor(x / y);
         }
     };
 
@@ -0,0 +1,416 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "ExpressionProgram.h"
+#include "ExpressionVisitor.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+#include <core/utils/Assert.h>
+
+namespace Carrot {
+    /// Scalar version of each operation, used for constant folding. Must match the SIMD versions of ExpressionProgram::run
+    static float evaluate(ExpressionOpCode op, float a, float b) {
+        switch(op) {
+            case ExpressionOpCode::Add: return a + b;
+            case ExpressionOpCode::Sub: return a - b;
+            case ExpressionOpCode::Mult: return a * b;
+            case ExpressionOpCode::Div: return a / b;
+            case ExpressionOpCode::Mod: return a - b * std::floor(a / b); // floored like GLSL mod (OpFMod), not std::fmod
+            case ExpressionOpCode::Min: return std::min(a, b);
+            case ExpressionOpCode::Max: return std::max(a, b);
+
+            case ExpressionOpCode::Less: return a < b ? 1.0f : 0.0f;
+            case ExpressionOpCode::LessOrEquals: return a <= b ? 1.0f : 0.0f;
+            case ExpressionOpCode::Greater: return a > b ? 1.0f : 0.0f;
+            case ExpressionOpCode::GreaterOrEquals: return a >= b ? 1.0f : 0.0f;
+            case ExpressionOpCode::Equals: return a == b ? 1.0f : 0.0f;
+            case ExpressionOpCode::NotEquals: return a != b ? 1.0f : 0.0f;
+
+            case ExpressionOpCode::Or: return std::max(a, b);
+            case ExpressionOpCode::And: return std::min(a, b);
+            case ExpressionOpCode::Xor: return a != b ? 1.0f : 0.0f;
+            case ExpressionOpCode::BoolNegate: return 1.0f - a;
+
+            case ExpressionOpCode::Sin: return std::sin(a);
+            case ExpressionOpCode::Cos: return std::cos(a);
+            case ExpressionOpCode::Tan: return std::tan(a);
+            case ExpressionOpCode::Exp: return std::exp(a);
+            case ExpressionOpCode::Abs: return std::abs(a);
+            case ExpressionOpCode::Sqrt: return std::sqrt(a);
+            case ExpressionOpCode::Log: return std::log(a);
+
+            default:
+                verify(false, "Cannot evaluate loads and stores");
+                return 0.0f;
+        }
+    }
+
+    /**
+     * Compiles expressions to an intermediate representation using one virtual register per value,
+     * then removes dead instructions and maps virtual registers to as few registers as possible.
+     */
+    class ExpressionCompiler: public IExpressionVisitor<std::uint32_t> {
+    public:
+        /// Returned by expressions without a value (void)
+        static constexpr std::uint32_t NoValue = std::numeric_limits<std::uint32_t>::max();
+
+        explicit ExpressionCompiler(const ExpressionCompileOptions& options): options(options) {}
+
+        /**
+         * Compiles the given expression, or reuses the register of a previous compilation of the same node (same pointer)
+         * if none of the variables it reads were written since: graphs made in the editor share node outputs between multiple inputs.
+         */
+        std::uint32_t compile(const std::shared_ptr<Expression>& expression) {
+            const bool cacheable = options.reuseSharedNodes && isPure(*expression);
+            if(cacheable) {
+                auto it = compiledNodes.find(expression.get());
+                if(it != compiledNodes.end() && isStillValid(it->second)) {
+                    readVariables.insert(readVariables.end(), it->second.readVariables.begin(), it->second.readVariables.end());
+                    return it->second.result;
+                }
+            }
+
+            const std::size_t firstRead = readVariables.size();
+            const std::uint64_t storesBefore = storeCount;
+            const std::uint32_t result = visit(expression);
+            if(cacheable && storeCount == storesBefore) {
+                CompiledNode& node = compiledNodes[expression.get()];
+                node.result = result;
+                node.readVariables.assign(readVariables.begin() + firstRead, readVariables.end());
+                std::sort(node.readVariables.begin(), node.readVariables.end());
+                node.readVariables.erase(std::unique(node.readVariables.begin(), node.readVariables.end()), node.readVariables.end());
+                node.storeCount = storeCount;
+            }
+            return result;
+        }
+
+        ExpressionProgram finish() {
+            if(options.eliminateDeadNodes) {
+                eliminateDeadInstructions();
+            }
+            return allocateRegisters();
+        }
+
+    public:
+        std::uint32_t visitConstant(ConstantExpression& expression) override {
+            const auto value = expression.getValue();
+            const ExpressionType type = expression.getType();
+            if(type == ExpressionTypes::Float) {
+                return makeConstant(value.asFloat);
+            }
+            if(type == ExpressionTypes::Int) {
+                return makeConstant(static_cast<float>(value.asInt));
+            }
+            if(type == ExpressionTypes::Bool) {
+                return makeConstant(value.asBool ? 1.0f : 0.0f);
+            }
+            throw std::runtime_error("Invalid constant type: " + type.name());
+        }
+
+        std::uint32_t visitGetVariable(GetVariableExpression& expression) override {
+            const std::size_t variableIndex = getVariableIndex(expression.getVariableName(), expression.getSubIndex());
+            variables[variableIndex].read = true;
+            readVariables.push_back(variableIndex);
+
+            // the variable is already inside a register if it was loaded or stored before
+            auto it = variableRegisters.find(variableIndex);
+            if(it != variableRegisters.end()) {
+                return it->second;
+            }
+
+            const std::uint32_t result = emit(ExpressionOpCode::LoadVariable, static_cast<std::uint32_t>(variableIndex), NoValue);
+            variableRegisters[variableIndex] = result;
+            return result;
+        }
+
+        std::uint32_t visitSetVariable(SetVariableExpression& expression) override {
+            const std::uint32_t value = compile(expression.getValue());
+            verify(value != NoValue, "Cannot store a void expression");
+
+            const std::size_t variableIndex = getVariableIndex(expression.getVariableName(), expression.getSubIndex());
+            variables[variableIndex].written = true;
+            ir.push_back(IRInstruction { .op = ExpressionOpCode::StoreVariable, .dst = NoValue, .a = static_cast<std::uint32_t>(variableIndex), .b = value });
+            variableRegisters[variableIndex] = value;
+            lastStores[variableIndex] = ++storeCount;
+            return NoValue;
+        }
+
+        std::uint32_t visitCompound(CompoundExpression& expression) override {
+            for(const auto& subExpression : expression.getSubExpressions()) {
+                if(subExpression) {
+                    compile(subExpression);
+                }
+            }
+            return NoValue;
+        }
+
+        std::uint32_t visitAdd(AddExpression& expression) override { return binary(ExpressionOpCode::Add, expression); }
+        std::uint32_t visitSub(SubExpression& expression) override { return binary(ExpressionOpCode::Sub, expression); }
+        std::uint32_t visitMult(MultExpression& expression) override { return binary(ExpressionOpCode::Mult, expression); }
+        std::uint32_t visitDiv(DivExpression& expression) override { return binary(ExpressionOpCode::Div, expression); }
+        std::uint32_t visitMod(ModExpression& expression) override { return binary(ExpressionOpCode::Mod, expression); }
+        std::uint32_t visitMin(MinExpression& expression) override { return binary(ExpressionOpCode::Min, expression); }
+        std::uint32_t visitMax(MaxExpression& expression) override { return binary(ExpressionOpCode::Max, expression); }
+
+        std::uint32_t visitLess(LessExpression& expression) override { return binary(ExpressionOpCode::Less, expression); }
+        std::uint32_t visitLessOrEquals(LessOrEqualsExpression& expression) override { return binary(ExpressionOpCode::LessOrEquals, expression); }
+        std::uint32_t visitGreater(GreaterExpression& expression) override { return binary(ExpressionOpCode::Greater, expression); }
+        std::uint32_t visitGreaterOrEquals(GreaterOrEqualsExpression& expression) override { return binary(ExpressionOpCode::GreaterOrEquals, expression); }
+        std::uint32_t visitEquals(EqualsExpression& expression) override { return binary(ExpressionOpCode::Equals, expression); }
+        std::uint32_t visitNotEquals(NotEqualsExpression& expression) override { return binary(ExpressionOpCode::NotEquals, expression); }
+
+        std::uint32_t visitOr(OrExpression& expression) override { return binary(ExpressionOpCode::Or, expression); }
+        std::uint32_t visitAnd(AndExpression& expression) override { return binary(ExpressionOpCode::And, expression); }
+        std::uint32_t visitXor(XorExpression& expression) override { return binary(ExpressionOpCode::Xor, expression); }
+        std::uint32_t visitBoolNegate(BoolNegateExpression& expression) override { return unary(ExpressionOpCode::BoolNegate, expression); }
+
+        std::uint32_t visitSin(SinExpression& expression) override { return unary(ExpressionOpCode::Sin, expression); }
+        std::uint32_t visitCos(CosExpression& expression) override { return unary(ExpressionOpCode::Cos, expression); }
+        std::uint32_t visitTan(TanExpression& expression) override { return unary(ExpressionOpCode::Tan, expression); }
+        std::uint32_t visitExp(ExpExpression& expression) override { return unary(ExpressionOpCode::Exp, expression); }
+        std::uint32_t visitAbs(AbsExpression& expression) override { return unary(ExpressionOpCode::Abs, expression); }
+        std::uint32_t visitSqrt(SqrtExpression& expression) override { return unary(ExpressionOpCode::Sqrt, expression); }
+        std::uint32_t visitLog(LogExpression& expression) override { return unary(ExpressionOpCode::Log, expression); }
+
+        std::uint32_t visitPlaceholder(PlaceholderExpression& expression) override {
+            throw std::runtime_error("Cannot accept placeholder expression!");
+        }
+
+        std::uint32_t visitPrefixed(PrefixedExpression& expression) override {
+            compile(expression.getPrefix());
+            return compile(expression.getExpression());
+        }
+
+        std::uint32_t visitOnce(OnceExpression& expression) override {
+            if(alreadyVisited.contains(expression.getUUID())) {
+                return NoValue;
+            }
+            alreadyVisited.insert(expression.getUUID());
+            return compile(expression.getExpressionToExecute());
+        }
+
+    private:
+        struct CompiledNode {
+            std::uint32_t result = NoValue;
+            std::vector<std::size_t> readVariables; //< variables read by the node and its operands
+            std::uint64_t storeCount = 0; //< value of 'storeCount' when the node was compiled
+        };
+
+        /// Nodes which only compute a value from their operands
+        static bool isPure(Expression& expression) {
+            return expression.getType() != ExpressionTypes::Void
+                && dynamic_cast<PrefixedExpression*>(&expression) == nullptr
+                && dynamic_cast<PlaceholderExpression*>(&expression) == nullptr;
+        }
+
+        bool isStillValid(const CompiledNode& node) const {
+            for(std::size_t variableIndex : node.readVariables) {
+                auto it = lastStores.find(variableIndex);
+                if(it != lastStores.end() && it->second > node.storeCount) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        struct IRInstruction {
+            ExpressionOpCode op;
+            std::uint32_t dst = NoValue; //< virtual register
+            std::uint32_t a = NoValue; //< virtual register, or variable index for loads and stores
+            std::uint32_t b = NoValue; //< virtual register
+        };
+
+        std::uint32_t newRegister(std::optional<float> constantValue = {}) {
+            const std::uint32_t index = static_cast<std::uint32_t>(registerConstants.size());
+            registerConstants.push_back(constantValue);
+            return index;
+        }
+
+        std::uint32_t makeConstant(float value) {
+            const std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+            auto it = constantRegisters.find(bits);
+            if(it != constantRegisters.end()) {
+                return it->second;
+            }
+            const std::uint32_t result = newRegister(value);
+            constantRegisters[bits] = result;
+            return result;
+        }
+
+        std::uint32_t emit(ExpressionOpCode op, std::uint32_t a, std::uint32_t b) {
+            const std::uint32_t result = newRegister();
+            ir.push_back(IRInstruction { .op = op, .dst = result, .a = a, .b = b });
+            return result;
+        }
+
+        template<typename BinaryExpression>
+        std::uint32_t binary(ExpressionOpCode op, BinaryExpression& expression) {
+            const std::uint32_t a = compile(expression.getOperand1());
+            const std::uint32_t b = compile(expression.getOperand2());
+            verify(a != NoValue && b != NoValue, "Operands cannot be void expressions");
+            if(options.foldConstants && registerConstants[a].has_value() && registerConstants[b].has_value()) {
+                return makeConstant(evaluate(op, registerConstants[a].value(), registerConstants[b].value()));
+            }
+            return emit(op, a, b);
+        }
+
+        template<typename UnaryExpression>
+        std::uint32_t unary(ExpressionOpCode op, UnaryExpression& expression) {
+            const std::uint32_t a = compile(expression.getOperand());
+            verify(a != NoValue, "Operand cannot be a void expression");
+            if(options.foldConstants && registerConstants[a].has_value()) {
+                return makeConstant(evaluate(op, registerConstants[a].value(), 0.0f));
+            }
+            return emit(op, a, a);
+        }
+
+        std::size_t getVariableIndex(const std::string& name, std::uint32_t subIndex) {
+            for(std::size_t i = 0; i < variables.size(); i++) {
+                if(variables[i].name == name && variables[i].subIndex == subIndex) {
+                    return i;
+                }
+            }
+            variables.push_back(ExpressionProgram::Variable { .name = name, .subIndex = subIndex });
+            return variables.size() - 1;
+        }
+
+        static bool isLoadOrStore(ExpressionOpCode op) {
+            return op == ExpressionOpCode::LoadVariable || op == ExpressionOpCode::StoreVariable;
+        }
+
+        /// Removes instructions whose result is never stored to a variable (directly or through other instructions)
+        void eliminateDeadInstructions() {
+            std::vector<bool> live(registerConstants.size(), false);
+            std::vector<IRInstruction> kept;
+            for(auto it = ir.rbegin(); it != ir.rend(); ++it) {
+                const IRInstruction& instruction = *it;
+                if(instruction.op == ExpressionOpCode::StoreVariable) {
+                    live[instruction.b] = true;
+                } else if(live[instruction.dst]) {
+                    if(instruction.op != ExpressionOpCode::LoadVariable) {
+                        live[instruction.a] = true;
+                        live[instruction.b] = true;
+                    }
+                } else {
+                    continue;
+                }
+                kept.push_back(instruction);
+            }
+            std::reverse(kept.begin(), kept.end());
+            ir = std::move(kept);
+        }
+
+        /// Maps virtual registers to actual registers: constants first, then other values share registers when their lifetimes do not overlap
+        ExpressionProgram allocateRegisters() {
+            constexpr std::uint32_t Unassigned = NoValue;
+            std::vector<std::uint32_t> physical(registerConstants.size(), Unassigned);
+            std::vector<std::size_t> lastUse(registerConstants.size(), 0);
+            std::vector<bool> used(registerConstants.size(), false);
+
+            auto markUse = [&](std::uint32_t reg, std::size_t instructionIndex) {
+                used[reg] = true;
+                lastUse[reg] = instructionIndex;
+            };
+            for(std::size_t i = 0; i < ir.size(); i++) {
+                const IRInstruction& instruction = ir[i];
+                if(instruction.op == ExpressionOpCode::StoreVariable) {
+                    markUse(instruction.b, i);
+                } else if(instruction.op != ExpressionOpCode::LoadVariable) {
+                    markUse(instruction.a, i);
+                    markUse(instruction.b, i);
+                }
+            }
+
+            ExpressionProgram program;
+            program.variables = std::move(variables);
+
+            for(std::uint32_t reg = 0; reg < registerConstants.size(); reg++) {
+                if(registerConstants[reg].has_value() && used[reg]) {
+                    physical[reg] = static_cast<std::uint32_t>(program.constants.size());
+                    program.constants.push_back(registerConstants[reg].value());
+                }
+            }
+
+            std::uint32_t registerCount = static_cast<std::uint32_t>(program.constants.size());
+            std::vector<std::uint32_t> freeRegisters;
+            auto release = [&](std::uint32_t reg, std::size_t instructionIndex) {
+                if(!registerConstants[reg].has_value() && lastUse[reg] == instructionIndex && physical[reg] != Unassigned) {
+                    if(std::find(freeRegisters.begin(), freeRegisters.end(), physical[reg]) == freeRegisters.end()) {
+                        freeRegisters.push_back(physical[reg]);
+                    }
+                }
+            };
+
+            program.instructions.reserve(ir.size());
+            for(std::size_t i = 0; i < ir.size(); i++) {
+                const IRInstruction& instruction = ir[i];
+                ExpressionInstruction& out = program.instructions.emplace_back(ExpressionInstruction { .op = instruction.op });
+
+                if(instruction.op == ExpressionOpCode::StoreVariable) {
+                    out.a = static_cast<std::uint16_t>(instruction.a);
+                    out.b = static_cast<std::uint16_t>(physical[instruction.b]);
+                    release(instruction.b, i);
+                    continue;
+                }
+
+                if(instruction.op == ExpressionOpCode::LoadVariable) {
+                    out.a = static_cast<std::uint16_t>(instruction.a);
+                } else {
+                    out.a = static_cast<std::uint16_t>(physical[instruction.a]);
+                    out.b = static_cast<std::uint16_t>(physical[instruction.b]);
+                    // operands whose last use is this instruction can be overwritten by its result: operations are done lane by lane
+                    release(instruction.a, i);
+                    release(instruction.b, i);
+                }
+
+                std::uint32_t dst;
+                if(!freeRegisters.empty()) {
+                    dst = freeRegisters.back();
+                    freeRegisters.pop_back();
+                } else {
+                    dst = registerCount++;
+                }
+                physical[instruction.dst] = dst;
+                out.dst = static_cast<std::uint16_t>(dst);
+
+                if(!used[instruction.dst]) { // dead value, only possible without dead node elimination
+                    freeRegisters.push_back(dst);
+                }
+            }
+
+            verify(registerCount <= std::numeric_limits<std::uint16_t>::max(), "Too many registers for a single expression program");
+            verify(program.variables.size() <= std::numeric_limits<std::uint16_t>::max(), "Too many variables for a single expression program");
+            program.registerCount = registerCount;
+            return program;
+        }
+
+        ExpressionCompileOptions options;
+        std::vector<IRInstruction> ir;
+        std::vector<std::optional<float>> registerConstants; //< for each virtual register, its value if known at compile time
+        std::unordered_map<std::uint32_t, std::uint32_t> constantRegisters; //< bits of a constant -> its virtual register
+        std::vector<ExpressionProgram::Variable> variables;
+        std::unordered_map<std::size_t, std::uint32_t> variableRegisters; //< variable index -> virtual register holding its current value
+        std::unordered_set<Carrot::UUID> alreadyVisited;
+
+        std::unordered_map<const Expression*, CompiledNode> compiledNodes;
+        std::vector<std::size_t> readVariables; //< variables read so far, in order: used to know which variables a node reads
+        std::unordered_map<std::size_t, std::uint64_t> lastStores; //< variable index -> value of 'storeCount' after its last store
+        std::uint64_t storeCount = 0;
+    };
+
+    ExpressionProgram ExpressionProgram::compile(const std::vector<std::shared_ptr<Expression>>& expressions, const ExpressionCompileOptions& options) {
+        ExpressionCompiler compiler { options };
+        for(const auto& expression : expressions) {
+            if(expression) {
+                compiler.compile(expression);
+            }
+        }
+        return compiler.finish();
+    }
+}
@@ -0,0 +1,342 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "ExpressionProgram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <core/utils/Assert.h>
+#include <glm/glm.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CARROT_EXPRESSIONS_SSE 1
+    #include <emmintrin.h>
+#endif
+
+namespace Carrot {
+namespace {
+    /// 4-wide float vector, backed by a SSE register when available. Comparisons return 1.0 or 0.0 per lane
+    struct Float4 {
+#ifdef CARROT_EXPRESSIONS_SSE
+        __m128 v;
+
+        static Float4 splat(float f) { return { _mm_set1_ps(f) }; }
+        static Float4 load(const float* p) { return { _mm_loadu_ps(p) }; }
+        void store(float* p) const { _mm_storeu_ps(p, v); }
+
+        Float4 operator+(const Float4& other) const { return { _mm_add_ps(v, other.v) }; }
+        Float4 operator-(const Float4& other) const { return { _mm_sub_ps(v, other.v) }; }
+        Float4 operator*(const Float4& other) const { return { _mm_mul_ps(v, other.v) }; }
+        Float4 operator/(const Float4& other) const { return { _mm_div_ps(v, other.v) }; }
+
+        static Float4 min(const Float4& a, const Float4& b) { return { _mm_min_ps(a.v, b.v) }; }
+        static Float4 max(const Float4& a, const Float4& b) { return { _mm_max_ps(a.v, b.v) }; }
+        static Float4 abs(const Float4& a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+        static Float4 sqrt(const Float4& a) { return { _mm_sqrt_ps(a.v) }; }
+
+        static Float4 less(const Float4& a, const Float4& b) { return toBool(_mm_cmplt_ps(a.v, b.v)); }
+        static Float4 lessOrEquals(const Float4& a, const Float4& b) { return toBool(_mm_cmple_ps(a.v, b.v)); }
+        static Float4 greater(const Float4& a, const Float4& b) { return toBool(_mm_cmpgt_ps(a.v, b.v)); }
+        static Float4 greaterOrEquals(const Float4& a, const Float4& b) { return toBool(_mm_cmpge_ps(a.v, b.v)); }
+        static Float4 equals(const Float4& a, const Float4& b) { return toBool(_mm_cmpeq_ps(a.v, b.v)); }
+        static Float4 notEquals(const Float4& a, const Float4& b) { return toBool(_mm_cmpneq_ps(a.v, b.v)); }
+
+    private:
+        static Float4 toBool(__m128 mask) { return { _mm_and_ps(mask, _mm_set1_ps(1.0f)) }; }
+#else
+        glm::vec4 v;
+
+        static Float4 splat(float f) { return { glm::vec4 { f } }; }
+        static Float4 load(const float* p) { return { glm::vec4 { p[0], p[1], p[2], p[3] } }; }
+        void store(float* p) const { p[0] = v.x; p[1] = v.y; p[2] = v.z; p[3] = v.w; }
+
+        Float4 operator+(const Float4& other) const { return { v + other.v }; }
+        Float4 operator-(const Float4& other) const { return { v - other.v }; }
+        Float4 operator*(const Float4& other) const { return { v * other.v }; }
+        Float4 operator/(const Float4& other) const { return { v / other.v }; }
+
+        static Float4 min(const Float4& a, const Float4& b) { return { glm::min(a.v, b.v) }; }
+        static Float4 max(const Float4& a, const Float4& b) { return { glm::max(a.v, b.v) }; }
+        static Float4 abs(const Float4& a) { return { glm::abs(a.v) }; }
+        static Float4 sqrt(const Float4& a) { return { glm::sqrt(a.v) }; }
+
+        static Float4 less(const Float4& a, const Float4& b) { return { glm::vec4(glm::lessThan(a.v, b.v)) }; }
+        static Float4 lessOrEquals(const Float4& a, const Float4& b) { return { glm::vec4(glm::lessThanEqual(a.v, b.v)) }; }
+        static Float4 greater(const Float4& a, const Float4& b) { return { glm::vec4(glm::greaterThan(a.v, b.v)) }; }
+        static Float4 greaterOrEquals(const Float4& a, const Float4& b) { return { glm::vec4(glm::greaterThanEqual(a.v, b.v)) }; }
+        static Float4 equals(const Float4& a, const Float4& b) { return { glm::vec4(glm::equal(a.v, b.v)) }; }
+        static Float4 notEquals(const Float4& a, const Float4& b) { return { glm::vec4(glm::notEqual(a.v, b.v)) }; }
+#endif
+    };
+
+    constexpr std::size_t Float4PerBlock = ExpressionProgram::LanesPerBlock / 4;
+    static_assert(ExpressionProgram::LanesPerBlock % 4 == 0);
+
+    /// Value of a register for all lanes of a block
+    struct RegisterBlock {
+        Float4 values[Float4PerBlock];
+    };
+}
+
+    template<typename Op>
+    static void unaryOp(RegisterBlock& dst, const RegisterBlock& a, Op op) {
+        for(std::size_t i = 0; i < Float4PerBlock; i++) {
+            dst.values[i] = op(a.values[i]);
+        }
+    }
+
+    template<typename Op>
+    static void binaryOp(RegisterBlock& dst, const RegisterBlock& a, const RegisterBlock& b, Op op) {
+        for(std::size_t i = 0; i < Float4PerBlock; i++) {
+            dst.values[i] = op(a.values[i], b.values[i]);
+        }
+    }
+
+    /// For operations without a SIMD version: applied lane by lane
+    template<typename Op>
+    static void perLaneOp(RegisterBlock& dst, const RegisterBlock& a, const RegisterBlock& b, Op op) {
+        alignas(16) float lanesA[ExpressionProgram::LanesPerBlock];
+        alignas(16) float lanesB[ExpressionProgram::LanesPerBlock];
+        for(std::size_t i = 0; i < Float4PerBlock; i++) {
+            a.values[i].store(&lanesA[i * 4]);
+            b.values[i].store(&lanesB[i * 4]);
+        }
+        for(std::size_t lane = 0; lane < ExpressionProgram::LanesPerBlock; lane++) {
+            lanesA[lane] = op(lanesA[lane], lanesB[lane]);
+        }
+        for(std::size_t i = 0; i < Float4PerBlock; i++) {
+            dst.values[i] = Float4::load(&lanesA[i * 4]);
+        }
+    }
+
+    template<typename Op>
+    static void perLaneOp(RegisterBlock& dst, const RegisterBlock& a, Op op) {
+        perLaneOp(dst, a, a, [&](float x, float) { return op(x); });
+    }
+
+    static void loadVariable(RegisterBlock& dst, const float* pValues, std::size_t laneCount) {
+        if(laneCount == ExpressionProgram::LanesPerBlock) {
+            for(std::size_t i = 0; i < Float4PerBlock; i++) {
+                dst.values[i] = Float4::load(pValues + i * 4);
+            }
+        } else {
+            // last block: unused lanes are zeroes
+            float lanes[ExpressionProgram::LanesPerBlock] = {};
+            std::memcpy(lanes, pValues, laneCount * sizeof(float));
+            for(std::size_t i = 0; i < Float4PerBlock; i++) {
+                dst.values[i] = Float4::load(&lanes[i * 4]);
+            }
+        }
+    }
+
+    static void storeVariable(float* pValues, const RegisterBlock& src, std::size_t laneCount) {
+        if(laneCount == ExpressionProgram::LanesPerBlock) {
+            for(std::size_t i = 0; i < Float4PerBlock; i++) {
+                src.values[i].store(pValues + i * 4);
+            }
+        } else {
+            float lanes[ExpressionProgram::LanesPerBlock];
+            for(std::size_t i = 0; i < Float4PerBlock; i++) {
+                src.values[i].store(&lanes[i * 4]);
+            }
+            std::memcpy(pValues, lanes, laneCount * sizeof(float));
+        }
+    }
+
+    void ExpressionProgram::run(std::span<float* const> variablePointers, std::size_t count) const {
+        verify(variablePointers.size() == variables.size(), "Must give one array per variable of the program");
+        if(count == 0) {
+            return;
+        }
+
+        std::vector<RegisterBlock> registers(registerCount);
+        for(std::size_t i = 0; i < constants.size(); i++) {
+            for(auto& value : registers[i].values) {
+                value = Float4::splat(constants[i]);
+            }
+        }
+
+        for(std::size_t start = 0; start < count; start += LanesPerBlock) {
+            const std::size_t laneCount = std::min(LanesPerBlock, count - start);
+            for(const ExpressionInstruction& instruction : instructions) {
+                // for loads and stores, 'a' is a variable index, not a register
+                if(instruction.op == ExpressionOpCode::LoadVariable) {
+                    loadVariable(registers[instruction.dst], variablePointers[instruction.a] + start, laneCount);
+                    continue;
+                }
+                if(instruction.op == ExpressionOpCode::StoreVariable) {
+                    storeVariable(variablePointers[instruction.a] + start, registers[instruction.b], laneCount);
+                    continue;
+                }
+
+                RegisterBlock& dst = registers[instruction.dst];
+                const RegisterBlock& a = registers[instruction.a];
+                const RegisterBlock& b = registers[instruction.b];
+                switch(instruction.op) {
+                    case ExpressionOpCode::Add:
+                        binaryOp(dst, a, b, [](const Float4& x, const Float4& y) { return x + y; });
+                        break;
+                    case ExpressionOpCode::Sub:
+                        binaryOp(dst, a, b, [](const Float4& x, const Float4& y) { return x - y; });
+                        break;
+                    case ExpressionOpCode::Mult:
+                        binaryOp(dst, a, b, [](const Float4& x, const Float4& y) { return x * y; });
+                        break;
+                    case ExpressionOpCode::Div:
+                        binaryOp(dst, a, b, [](const Float4& x, const Float4& y) { return x / y; });
+                        break;
+                    case ExpressionOpCode::Mod:
+                        // floored like GLSL mod (OpFMod) used by particle shaders, not truncated like std::fmod
+                        perLaneOp(dst, a, b, [](float x, float y) { return x - y * std::floor(x / y); });
+                        break;
+                    case ExpressionOpCode::Min:
+                        binaryOp(dst, a, b, Float4::min);
+                        break;
+                    case ExpressionOpCode::Max:
+                        binaryOp(dst, a, b, Float4::max);
+                        break;
+
+                    case ExpressionOpCode::Less:
+                        binaryOp(dst, a, b, Float4::less);
+                        break;
+                    case ExpressionOpCode::LessOrEquals:
+                        binaryOp(dst, a, b, Float4::lessOrEquals);
+                        break;
+                    case ExpressionOpCode::Greater:
+                        binaryOp(dst, a, b, Float4::greater);
+                        break;
+                    case ExpressionOpCode::GreaterOrEquals:
+                        binaryOp(dst, a, b, Float4::greaterOrEquals);
+                        break;
+                    case ExpressionOpCode::Equals:
+                        binaryOp(dst, a, b, Float4::equals);
+                        break;
+                    case ExpressionOpCode::NotEquals:
+                        binaryOp(dst, a, b, Float4::notEquals);
+                        break;
+
+                    // bools are 0.0 or 1.0
+                    case ExpressionOpCode::Or:
+                        binaryOp(dst, a, b, Float4::max);
+                        break;
+                    case ExpressionOpCode::And:
+                        binaryOp(dst, a, b, Float4::min);
+                        break;
+                    case ExpressionOpCode::Xor:
+                        binaryOp(dst, a, b, Float4::notEquals);
+                        break;
+                    case ExpressionOpCode::BoolNegate:
+                        unaryOp(dst, a, [](const Float4& x) { return Float4::splat(1.0f) - x; });
+                        break;
+
+                    case ExpressionOpCode::Sin:
+                        perLaneOp(dst, a, [](float x) { return std::sin(x); });
+                        break;
+                    case ExpressionOpCode::Cos:
+                        perLaneOp(dst, a, [](float x) { return std::cos(x); });
+                        break;
+                    case ExpressionOpCode::Tan:
+                        perLaneOp(dst, a, [](float x) { return std::tan(x); });
+                        break;
+                    case ExpressionOpCode::Exp:
+                        perLaneOp(dst, a, [](float x) { return std::exp(x); });
+                        break;
+                    case ExpressionOpCode::Abs:
+                        unaryOp(dst, a, Float4::abs);
+                        break;
+                    case ExpressionOpCode::Sqrt:
+                        unaryOp(dst, a, Float4::sqrt);
+                        break;
+                    case ExpressionOpCode::Log:
+                        perLaneOp(dst, a, [](float x) { return std::log(x); });
+                        break;
+
+                    default:
+                        verify(false, "Unhandled opcode");
+                        break;
+                }
+            }
+        }
+    }
+
+    const std::vector<ExpressionProgram::Variable>& ExpressionProgram::getVariables() const {
+        return variables;
+    }
+
+    std::optional<std::size_t> ExpressionProgram::findVariable(std::string_view name, std::uint32_t subIndex) const {
+        for(std::size_t i = 0; i < variables.size(); i++) {
+            if(variables[i].name == name && variables[i].subIndex == subIndex) {
+                return i;
+            }
+        }
+        return {};
+    }
+
+    const std::vector<ExpressionInstruction>& ExpressionProgram::getInstructions() const {
+        return instructions;
+    }
+
+    std::size_t ExpressionProgram::getRegisterCount() const {
+        return registerCount;
+    }
+
+    static const char* getOpCodeName(ExpressionOpCode op) {
+        switch(op) {
+            case ExpressionOpCode::LoadVariable: return "load";
+            case ExpressionOpCode::StoreVariable: return "store";
+            case ExpressionOpCode::Add: return "add";
+            case ExpressionOpCode::Sub: return "sub";
+            case ExpressionOpCode::Mult: return "mult";
+            case ExpressionOpCode::Div: return "div";
+            case ExpressionOpCode::Mod: return "mod";
+            case ExpressionOpCode::Min: return "min";
+            case ExpressionOpCode::Max: return "max";
+            case ExpressionOpCode::Less: return "less";
+            case ExpressionOpCode::LessOrEquals: return "lessOrEquals";
+            case ExpressionOpCode::Greater: return "greater";
+            case ExpressionOpCode::GreaterOrEquals: return "greaterOrEquals";
+            case ExpressionOpCode::Equals: return "equals";
+            case ExpressionOpCode::NotEquals: return "notEquals";
+            case ExpressionOpCode::Or: return "or";
+            case ExpressionOpCode::And: return "and";
+            case ExpressionOpCode::Xor: return "xor";
+            case ExpressionOpCode::BoolNegate: return "not";
+            case ExpressionOpCode::Sin: return "sin";
+            case ExpressionOpCode::Cos: return "cos";
+            case ExpressionOpCode::Tan: return "tan";
+            case ExpressionOpCode::Exp: return "exp";
+            case ExpressionOpCode::Abs: return "abs";
+            case ExpressionOpCode::Sqrt: return "sqrt";
+            case ExpressionOpCode::Log: return "log";
+        }
+        return "<unknown>";
+    }
+
+    std::string ExpressionProgram::disassemble() const {
+        std::string result;
+        for(std::size_t i = 0; i < constants.size(); i++) {
+            result += "r" + std::to_string(i) + " = " + std::to_string(constants[i]) + "\n";
+        }
+        for(const ExpressionInstruction& instruction : instructions) {
+            switch(instruction.op) {
+                case ExpressionOpCode::LoadVariable: {
+                    const Variable& variable = variables[instruction.a];
+                    result += "r" + std::to_string(instruction.dst) + " = load " + variable.name + "(" + std::to_string(variable.subIndex) + ")\n";
+                } break;
+
+                case ExpressionOpCode::StoreVariable: {
+                    const Variable& variable = variables[instruction.a];
+                    result += "store " + variable.name + "(" + std::to_string(variable.subIndex) + "), r" + std::to_string(instruction.b) + "\n";
+                } break;
+
+                default:
+                    result += "r" + std::to_string(instruction.dst) + " = " + getOpCodeName(instruction.op)
+                            + " r" + std::to_string(instruction.a) + ", r" + std::to_string(instruction.b) + "\n";
+                    break;
+            }
+        }
+        return result;
+    }
+}
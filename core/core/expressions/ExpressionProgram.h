@@ -0,0 +1,119 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+#include "Expression.h"
+
+namespace Carrot {
+    enum class ExpressionOpCode: std::uint8_t {
+        LoadVariable, //< dst = variables[a]
+        StoreVariable, //< variables[a] = registers[b]
+
+        Add,
+        Sub,
+        Mult,
+        Div,
+        Mod,
+        Min,
+        Max,
+
+        Less,
+        LessOrEquals,
+        Greater,
+        GreaterOrEquals,
+        Equals,
+        NotEquals,
+
+        Or,
+        And,
+        Xor,
+        BoolNegate,
+
+        Sin,
+        Cos,
+        Tan,
+        Exp,
+        Abs,
+        Sqrt,
+        Log,
+    };
+
+    struct ExpressionInstruction {
+        ExpressionOpCode op;
+        std::uint16_t dst = 0; //< register written by this instruction (unused for stores)
+        std::uint16_t a = 0; //< first operand: register, or variable index for loads and stores
+        std::uint16_t b = 0; //< second operand: register
+    };
+
+    struct ExpressionCompileOptions {
+        /// Operations whose operands are all constants are computed at compile time
+        bool foldConstants = true;
+
+        /// Operations whose result never reaches a variable are removed
+        bool eliminateDeadNodes = true;
+
+        /// Nodes used by multiple expressions (same Expression object) are computed once, as long as the variables they read do not change in between
+        bool reuseSharedNodes = true;
+    };
+
+    /**
+     * CPU backend of expressions: expression trees compiled to a register-based bytecode, executed over batches of elements (particles for instance).
+     * Each variable of the program (GetVariable/SetVariable, identified by name and sub index) is bound to an array of 'count' floats (SoA layout).
+     * Each instruction is executed for LanesPerBlock elements at once, with SSE when available, to amortize dispatch.
+     *
+     * All values are stored as floats: ints are converted to floats (like the particle shaders do with indices), bools are 0.0 or 1.0.
+     * Variables are read and written in the order of the expressions, for each element: a GetVariable after a SetVariable of the same variable sees the new value.
+     */
+    class ExpressionProgram {
+    public:
+        /// How many elements are processed by each instruction dispatch
+        static constexpr std::size_t LanesPerBlock = 16;
+
+        struct Variable {
+            std::string name;
+            std::uint32_t subIndex = 0;
+            bool read = false; //< is this variable read by the program?
+            bool written = false; //< is this variable written by the program?
+        };
+
+        /**
+         * Compiles the given expressions, executed in order.
+         * Throws if an expression cannot run on the CPU (placeholders).
+         */
+        static ExpressionProgram compile(const std::vector<std::shared_ptr<Expression>>& expressions, const ExpressionCompileOptions& options = {});
+
+        /// Variables used by this program, in the order expected by run()
+        const std::vector<Variable>& getVariables() const;
+
+        /// Index of the given variable inside getVariables(), if used by this program
+        std::optional<std::size_t> findVariable(std::string_view name, std::uint32_t subIndex = 0) const;
+
+        /**
+         * Runs the program for 'count' elements.
+         * \param variables one pointer per variable of getVariables(), each pointing to 'count' values. Written variables are modified in place
+         */
+        void run(std::span<float* const> variables, std::size_t count) const;
+
+        const std::vector<ExpressionInstruction>& getInstructions() const;
+        std::size_t getRegisterCount() const;
+
+        /// Human-readable version of the bytecode, for debugging
+        std::string disassemble() const;
+
+    private:
+        std::vector<ExpressionInstruction> instructions;
+        std::vector<float> constants; //< initial values of the first registers
+        std::size_t registerCount = 0;
+        std::vector<Variable> variables;
+
+        friend class ExpressionCompiler;
+    };
+}
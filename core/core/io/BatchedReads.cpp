@@ -0,0 +1,170 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "BatchedReads.h"
+#include <core/io/FileHandle.h>
+#include <algorithm>
+#include <optional>
+
+#ifndef CARROT_IO_URING
+#define CARROT_IO_URING 0
+#endif
+
+#if CARROT_IO_URING
+#include <liburing.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Carrot::IO {
+#if CARROT_IO_URING
+    /// Number of reads in flight at once, also the maximum number of files opened at once
+    constexpr unsigned RingSize = 64;
+
+    static bool canCreateRing() {
+        static const bool result = []() {
+            io_uring ring;
+            if(io_uring_queue_init(1, &ring, 0) < 0) {
+                return false;
+            }
+            io_uring_queue_exit(&ring);
+            return true;
+        }();
+        return result;
+    }
+
+    /// Reads files by batches of 'RingSize'. Returns false if the ring could not be created, in which case nothing was read
+    static bool readFilesWithRing(std::span<const std::filesystem::path> filepaths, std::vector<std::vector<std::uint8_t>>& results) {
+        io_uring ring;
+        if(io_uring_queue_init(RingSize, &ring, 0) < 0) {
+            return false;
+        }
+
+        // the kernel writes to the buffers of in-flight reads: errors are only reported once the entire batch is done
+        std::optional<std::filesystem::filesystem_error> error;
+        auto setError = [&](const char* what, const std::filesystem::path& path, int errorCode) {
+            if(!error.has_value()) {
+                error.emplace(what, path, std::error_code { errorCode, std::system_category() });
+            }
+        };
+
+        std::vector<int> fds;
+        fds.reserve(RingSize);
+        for(std::size_t batchStart = 0; batchStart < filepaths.size() && !error.has_value(); batchStart += RingSize) {
+            const std::size_t batchEnd = std::min(filepaths.size(), batchStart + RingSize);
+
+            fds.clear();
+            unsigned submittedCount = 0;
+            for(std::size_t i = batchStart; i < batchEnd; i++) {
+                const int fd = open(filepaths[i].c_str(), O_RDONLY | O_CLOEXEC);
+                fds.push_back(fd);
+                if(fd < 0) {
+                    setError("Could not open", filepaths[i], errno);
+                    continue;
+                }
+                struct stat fileStats{};
+                if(fstat(fd, &fileStats) != 0) {
+                    setError("Could not get size of", filepaths[i], errno);
+                    continue;
+                }
+                results[i].resize(static_cast<std::size_t>(fileStats.st_size));
+                if(results[i].empty()) {
+                    continue;
+                }
+
+                io_uring_sqe* sqe = io_uring_get_sqe(&ring);
+                io_uring_prep_read(sqe, fd, results[i].data(), static_cast<unsigned>(results[i].size()), 0);
+                sqe->user_data = i;
+                submittedCount++;
+            }
+
+            if(submittedCount > 0) {
+                const int submitResult = io_uring_submit_and_wait(&ring, submittedCount);
+                if(submitResult < 0) {
+                    setError("Could not submit reads for", filepaths[batchStart], -submitResult);
+                    submittedCount = 0; // nothing is in flight
+                }
+            }
+
+            for(unsigned completed = 0; completed < submittedCount; completed++) {
+                io_uring_cqe* cqe = nullptr;
+                int waitResult;
+                do {
+                    waitResult = io_uring_wait_cqe(&ring, &cqe);
+                } while(waitResult == -EINTR);
+                if(waitResult < 0) {
+                    // should not happen with reads that were accepted by the kernel. Nothing can be done safely with the buffers anymore
+                    io_uring_queue_exit(&ring);
+                    throw std::filesystem::filesystem_error("Could not wait for reads", std::error_code { -waitResult, std::system_category() });
+                }
+
+                const std::size_t index = static_cast<std::size_t>(cqe->user_data);
+                const int readResult = cqe->res;
+                io_uring_cqe_seen(&ring, cqe);
+
+                if(readResult < 0) {
+                    setError("Could not read", filepaths[index], -readResult);
+                    continue;
+                }
+
+                // short reads are possible (file truncated in the meantime, some file systems), finish synchronously
+                std::size_t readCount = static_cast<std::size_t>(readResult);
+                std::vector<std::uint8_t>& contents = results[index];
+                const int fd = fds[index - batchStart];
+                while(readCount < contents.size()) {
+                    const ssize_t result = pread(fd, contents.data() + readCount, contents.size() - readCount, static_cast<off_t>(readCount));
+                    if(result < 0 && errno == EINTR) {
+                        continue;
+                    }
+                    if(result <= 0) {
+                        setError("Could not read all bytes of", filepaths[index], result < 0 ? errno : EIO);
+                        break;
+                    }
+                    readCount += static_cast<std::size_t>(result);
+                }
+            }
+
+            for(const int fd : fds) {
+                if(fd >= 0) {
+                    close(fd);
+                }
+            }
+        }
+
+        io_uring_queue_exit(&ring);
+        if(error.has_value()) {
+            throw error.value();
+        }
+        return true;
+    }
+#endif
+
+    bool areBatchedReadsAccelerated() {
+#if CARROT_IO_URING
+        return canCreateRing();
+#else
+        return false;
+#endif
+    }
+
+    std::vector<std::vector<std::uint8_t>> readFiles(std::span<const std::filesystem::path> filepaths) {
+        std::vector<std::vector<std::uint8_t>> results(filepaths.size());
+#if CARROT_IO_URING
+        if(canCreateRing() && readFilesWithRing(filepaths, results)) {
+            return results;
+        }
+#endif
+
+        for(std::size_t i = 0; i < filepaths.size(); i++) {
+            FileHandle file { filepaths[i], OpenMode::Read };
+            results[i].resize(file.getSize());
+            if(!results[i].empty()) {
+                file.read(results[i].data(), results[i].size(), 0);
+            }
+        }
+        return results;
+    }
+}
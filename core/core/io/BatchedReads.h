@@ -0,0 +1,22 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace Carrot::IO {
+    /// Are reads of 'readFiles' submitted in batches? True if the engine was built with io_uring (Linux) and the kernel allows creating a ring
+    /// (it may be disabled inside containers)
+    bool areBatchedReadsAccelerated();
+
+    /// Reads the entire contents of each file of 'filepaths', in the same order. Throws if any file cannot be read.
+    /// With io_uring, files are opened, then all their reads are submitted with a single syscall and run in parallel inside the kernel,
+    /// which is much faster than reading files one after the other when they are not in the page cache.
+    /// Otherwise, files are read one after the other.
+    std::vector<std::vector<std::uint8_t>> readFiles(std::span<const std::filesystem::path> filepaths);
+}
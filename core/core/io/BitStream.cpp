@@ -0,0 +1,123 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "BitStream.h"
+#include <bit>
+#include <cmath>
+#include <algorithm>
+#include <core/utils/Assert.h>
+
+namespace Carrot::IO {
+    Quantization Quantization::withPrecision(float min, float max, float precision) {
+        verify(max > min, "Empty range");
+        verify(precision > 0.0f, "Precision must be positive");
+        const double steps = std::ceil(static_cast<double>(max - min) / precision);
+        std::uint8_t bits = 1;
+        while(bits < 31 && static_cast<double>((1ull << bits) - 1) < steps) {
+            bits++;
+        }
+        return Quantization { .min = min, .max = max, .bits = bits };
+    }
+
+    std::uint32_t Quantization::quantize(float value) const {
+        if(bits >= 32) {
+            return std::bit_cast<std::uint32_t>(value);
+        }
+        const std::uint32_t maxQuantized = (1u << bits) - 1;
+        const float normalized = std::clamp((value - min) / (max - min), 0.0f, 1.0f);
+        return static_cast<std::uint32_t>(std::lround(normalized * static_cast<float>(maxQuantized)));
+    }
+
+    float Quantization::dequantize(std::uint32_t quantized) const {
+        if(bits >= 32) {
+            return std::bit_cast<float>(quantized);
+        }
+        const std::uint32_t maxQuantized = (1u << bits) - 1;
+        return min + (max - min) * (static_cast<float>(quantized) / static_cast<float>(maxQuantized));
+    }
+
+    void BitWriter::write(std::uint32_t value, std::uint8_t count) {
+        verify(count <= 32, "Cannot write more than 32 bits at once");
+        if(count < 32) {
+            value &= (1u << count) - 1;
+        }
+
+        std::uint8_t remaining = count;
+        while(remaining > 0) {
+            const std::size_t bitInByte = bitCount % 8;
+            if(bitInByte == 0) {
+                bytes.push_back(0);
+            }
+            const std::uint8_t written = std::min<std::uint8_t>(remaining, 8 - bitInByte);
+            bytes.back() |= static_cast<std::uint8_t>((value & ((1u << written) - 1)) << bitInByte);
+            value >>= written;
+            remaining -= written;
+            bitCount += written;
+        }
+    }
+
+    void BitWriter::writeBool(bool value) {
+        write(value ? 1 : 0, 1);
+    }
+
+    void BitWriter::writeVarUInt(std::uint32_t value) {
+        do {
+            const std::uint32_t group = value & 0x7F;
+            value >>= 7;
+            write(group | (value != 0 ? 0x80 : 0), 8);
+        } while(value != 0);
+    }
+
+    void BitWriter::append(const BitWriter& other) {
+        std::size_t remaining = other.bitCount;
+        for(std::uint8_t byte : other.bytes) {
+            const std::uint8_t count = static_cast<std::uint8_t>(std::min<std::size_t>(remaining, 8));
+            write(byte, count);
+            remaining -= count;
+        }
+    }
+
+    BitReader::BitReader(std::span<const std::uint8_t> data): data(data) {}
+
+    std::uint32_t BitReader::read(std::uint8_t count) {
+        verify(count <= 32, "Cannot read more than 32 bits at once");
+        if(getRemainingBits() < count) {
+            overflowed = true;
+            position = data.size() * 8;
+            return 0;
+        }
+
+        std::uint32_t result = 0;
+        std::uint8_t readBits = 0;
+        while(readBits < count) {
+            const std::size_t bitInByte = position % 8;
+            const std::uint8_t toRead = std::min<std::uint8_t>(count - readBits, 8 - bitInByte);
+            const std::uint32_t bits = (data[position / 8] >> bitInByte) & ((1u << toRead) - 1);
+            result |= bits << readBits;
+            readBits += toRead;
+            position += toRead;
+        }
+        return result;
+    }
+
+    bool BitReader::readBool() {
+        return read(1) != 0;
+    }
+
+    std::uint32_t BitReader::readVarUInt() {
+        std::uint32_t result = 0;
+        for(std::uint8_t shift = 0; shift < 35; shift += 7) {
+            const std::uint32_t group = read(8);
+            result |= (group & 0x7F) << shift;
+            if((group & 0x80) == 0 || overflowed) {
+                break;
+            }
+        }
+        return result;
+    }
+
+    std::size_t BitReader::getRemainingBits() const {
+        return data.size() * 8 - position;
+    }
+}
@@ -0,0 +1,72 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Carrot::IO {
+    /**
+     * Maps floats inside [min; max] to integers of 'bits' bits (rounded to the nearest step, clamped).
+     * With bits == 32, values are stored as-is (bit representation of the float), min and max are ignored.
+     */
+    struct Quantization {
+        float min = 0.0f;
+        float max = 1.0f;
+        std::uint8_t bits = 32;
+
+        /// Quantization with steps of at most 'precision' inside [min; max]
+        static Quantization withPrecision(float min, float max, float precision);
+
+        std::uint32_t quantize(float value) const;
+        float dequantize(std::uint32_t quantized) const;
+
+        bool operator==(const Quantization&) const = default;
+    };
+
+    /// Writes values with an arbitrary count of bits, least significant bits first
+    class BitWriter {
+    public:
+        /// Writes the 'bitCount' lowest bits of 'value'. bitCount must be <= 32
+        void write(std::uint32_t value, std::uint8_t bitCount);
+        void writeBool(bool value);
+
+        /// Writes an unsigned integer with groups of 7 bits, small values take less space
+        void writeVarUInt(std::uint32_t value);
+
+        /// Appends everything written inside 'other'
+        void append(const BitWriter& other);
+
+        std::size_t getBitCount() const { return bitCount; }
+        std::size_t getByteCount() const { return (bitCount + 7) / 8; }
+
+        /// Written data, the last byte is padded with zeroes
+        const std::vector<std::uint8_t>& getBytes() const { return bytes; }
+
+    private:
+        std::vector<std::uint8_t> bytes;
+        std::size_t bitCount = 0;
+    };
+
+    /// Reads data written by BitWriter. Reading past the end returns zeroes and sets the overflow flag
+    class BitReader {
+    public:
+        explicit BitReader(std::span<const std::uint8_t> data);
+
+        std::uint32_t read(std::uint8_t bitCount);
+        bool readBool();
+        std::uint32_t readVarUInt();
+
+        /// Was there an attempt to read past the end of the data?
+        bool hasOverflowed() const { return overflowed; }
+        std::size_t getRemainingBits() const;
+
+    private:
+        std::span<const std::uint8_t> data;
+        std::size_t position = 0;
+        bool overflowed = false;
+    };
+}
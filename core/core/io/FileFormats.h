@@ -33,8 +33,9 @@ namespace Carrot::IO {
         OBJ,
         GLB,
         GLTF,
+        CMODEL, // Carrot binary models, see core/scene/BinaryModel.h
         ModelFirst = FBX,
-        ModelLast = GLTF,
+        ModelLast = CMODEL,
 
         LUA,
         ScriptFirst = LUA,
@@ -44,6 +45,8 @@ namespace Carrot::IO {
         TXT,
 
         CNAV, // Carrot navmeshes
+        CSCENE, // Carrot binary scenes, see engine/scene/BinaryScene.h
+        CPAK, // Carrot packs, see core/io/PackFile.h
 
         MP3,
         OGG,
@@ -99,6 +102,7 @@ namespace Carrot::IO {
         CHECK(OBJ);
         CHECK(GLB);
         CHECK(GLTF);
+        CHECK(CMODEL);
 
         CHECK(LUA);
 
@@ -106,6 +110,8 @@ namespace Carrot::IO {
         CHECK(TXT);
 
         CHECK(CNAV);
+        CHECK(CSCENE);
+        CHECK(CPAK);
 
         CHECK(MP3);
         CHECK(OGG);
@@ -12,6 +12,8 @@
 
 #ifdef _WIN32
 #include "windows/PlatformFileHandle.h"
+#else
+#include "posix/PlatformFileHandle.h"
 #endif
 
 
@@ -78,6 +80,7 @@ namespace Carrot::IO {
         PLATFORM_HANDLE->close();
         delete PLATFORM_HANDLE;
         handle = nullptr;
+        opened = false;
     }
 
     void FileHandle::seek(size_t position) {
@@ -0,0 +1,117 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "MappedFile.h"
+#include <core/utils/stringmanip.h>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Carrot::IO {
+    MappedFile::MappedFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+        fileHandle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if(fileHandle == INVALID_HANDLE_VALUE) {
+            fileHandle = nullptr;
+            throw std::runtime_error(Carrot::sprintf("Could not open %s, error is 0x%x", Carrot::toString(path.u8string()).c_str(), GetLastError()));
+        }
+
+        LARGE_INTEGER fileSize;
+        if(!GetFileSizeEx(fileHandle, &fileSize)) {
+            const DWORD error = GetLastError();
+            unmap();
+            throw std::runtime_error(Carrot::sprintf("Could not get size of %s, error is 0x%x", Carrot::toString(path.u8string()).c_str(), error));
+        }
+        size = static_cast<std::size_t>(fileSize.QuadPart);
+        if(size == 0) { // empty files cannot be mapped
+            return;
+        }
+
+        mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(mappingHandle == nullptr) {
+            const DWORD error = GetLastError();
+            unmap();
+            throw std::runtime_error(Carrot::sprintf("Could not map %s, error is 0x%x", Carrot::toString(path.u8string()).c_str(), error));
+        }
+
+        pData = static_cast<const std::uint8_t*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if(pData == nullptr) {
+            const DWORD error = GetLastError();
+            unmap();
+            throw std::runtime_error(Carrot::sprintf("Could not map %s, error is 0x%x", Carrot::toString(path.u8string()).c_str(), error));
+        }
+#else
+        const int fd = open(path.c_str(), O_RDONLY);
+        if(fd < 0) {
+            throw std::runtime_error(Carrot::sprintf("Could not open %s", path.c_str()));
+        }
+
+        struct stat fileStats{};
+        if(fstat(fd, &fileStats) != 0) {
+            close(fd);
+            throw std::runtime_error(Carrot::sprintf("Could not get size of %s", path.c_str()));
+        }
+        size = static_cast<std::size_t>(fileStats.st_size);
+        if(size == 0) { // empty files cannot be mapped
+            close(fd);
+            return;
+        }
+
+        void* pMapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // the mapping keeps a reference to the file
+        if(pMapped == MAP_FAILED) {
+            size = 0;
+            throw std::runtime_error(Carrot::sprintf("Could not map %s", path.c_str()));
+        }
+        pData = static_cast<const std::uint8_t*>(pMapped);
+#endif
+    }
+
+    MappedFile::MappedFile(MappedFile&& toMove) noexcept {
+        pData = std::exchange(toMove.pData, nullptr);
+        size = std::exchange(toMove.size, 0);
+#ifdef _WIN32
+        fileHandle = std::exchange(toMove.fileHandle, nullptr);
+        mappingHandle = std::exchange(toMove.mappingHandle, nullptr);
+#endif
+    }
+
+    MappedFile::~MappedFile() {
+        unmap();
+    }
+
+    std::span<const std::uint8_t> MappedFile::getData() const {
+        return std::span { pData, size };
+    }
+
+    void MappedFile::unmap() {
+#ifdef _WIN32
+        if(pData != nullptr) {
+            UnmapViewOfFile(pData);
+        }
+        if(mappingHandle != nullptr) {
+            CloseHandle(mappingHandle);
+        }
+        if(fileHandle != nullptr) {
+            CloseHandle(fileHandle);
+        }
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        if(pData != nullptr) {
+            munmap(const_cast<std::uint8_t*>(pData), size);
+        }
+#endif
+        pData = nullptr;
+        size = 0;
+    }
+}
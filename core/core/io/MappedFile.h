@@ -0,0 +1,38 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace Carrot::IO {
+    /// Read-only file mapped in memory. Pages are read by the OS on first access, so mapping a file is cheap and
+    /// reading it does not go through an intermediate buffer.
+    class MappedFile {
+    public:
+        /// Maps the entire file. Throws if the file cannot be opened
+        explicit MappedFile(const std::filesystem::path& path);
+        MappedFile(MappedFile&& toMove) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        ~MappedFile();
+
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /// Contents of the file, valid as long as this object is alive. Aligned on the page size of the OS
+        std::span<const std::uint8_t> getData() const;
+
+    private:
+        void unmap();
+
+        const std::uint8_t* pData = nullptr;
+        std::size_t size = 0;
+
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#endif
+    };
+}
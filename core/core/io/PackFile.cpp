@@ -0,0 +1,321 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "PackFile.h"
+
+#include <core/io/Path.h>
+#include <core/utils/Assert.h>
+#include <core/utils/stringmanip.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+#ifndef CARROT_PACK_LZ4
+#define CARROT_PACK_LZ4 0
+#endif
+#ifndef CARROT_PACK_ZSTD
+#define CARROT_PACK_ZSTD 0
+#endif
+
+#if CARROT_PACK_LZ4
+#include <lz4.h>
+#endif
+#if CARROT_PACK_ZSTD
+#include <zstd.h>
+#endif
+
+namespace Carrot::IO {
+    // stored as raw bytes
+    static_assert(std::is_trivially_copyable_v<Pack::Header>);
+    static_assert(std::is_trivially_copyable_v<Pack::Entry>);
+
+    namespace Pack {
+        std::uint64_t hashPath(std::string_view path) {
+            std::uint64_t hash = 0xcbf29ce484222325ull;
+            for(const char c : path) {
+                hash ^= static_cast<std::uint8_t>(c);
+                hash *= 0x100000001b3ull;
+            }
+            return hash;
+        }
+
+        bool isSupported(Compression compression) {
+            switch(compression) {
+                case Compression::None:
+                    return true;
+                case Compression::LZ4:
+                    return CARROT_PACK_LZ4 != 0;
+                case Compression::Zstd:
+                    return CARROT_PACK_ZSTD != 0;
+            }
+            return false;
+        }
+
+        /// Compresses 'data' with the given codec, returns an empty vector if compression is not worth it
+        static std::vector<std::uint8_t> compress(std::span<const std::uint8_t> data, Compression compression) {
+            std::vector<std::uint8_t> compressed;
+            switch(compression) {
+                case Compression::None:
+                    break;
+
+                case Compression::LZ4: {
+#if CARROT_PACK_LZ4
+                    if(data.size() > static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE)) {
+                        break;
+                    }
+                    compressed.resize(LZ4_compressBound(static_cast<int>(data.size())));
+                    const int compressedSize = LZ4_compress_default(reinterpret_cast<const char*>(data.data()), reinterpret_cast<char*>(compressed.data()),
+                                                                    static_cast<int>(data.size()), static_cast<int>(compressed.size()));
+                    compressed.resize(compressedSize > 0 ? compressedSize : 0);
+#endif
+                } break;
+
+                case Compression::Zstd: {
+#if CARROT_PACK_ZSTD
+                    compressed.resize(ZSTD_compressBound(data.size()));
+                    const std::size_t compressedSize = ZSTD_compress(compressed.data(), compressed.size(), data.data(), data.size(), ZSTD_CLEVEL_DEFAULT);
+                    compressed.resize(ZSTD_isError(compressedSize) ? 0 : compressedSize);
+#endif
+                } break;
+            }
+
+            if(compressed.size() >= data.size()) {
+                compressed.clear();
+            }
+            return compressed;
+        }
+
+        void Writer::add(std::string_view path, std::span<const std::uint8_t> data, Compression compression) {
+            if(!isSupported(compression)) {
+                throw std::runtime_error(Carrot::sprintf("Compression %u is not supported by this build", static_cast<std::uint32_t>(compression)));
+            }
+            const NormalizedPath normalizedPath { path };
+            if(normalizedPath.isAbsolute() || normalizedPath.isEmpty()) {
+                throw std::invalid_argument(Carrot::sprintf("Path inside pack must be relative: %s", std::string(path).c_str()));
+            }
+            verify(paths.insert(normalizedPath.asString()).second, Carrot::sprintf("File %s is already inside the pack", normalizedPath.c_str()));
+
+            PendingFile& file = files.emplace_back();
+            file.path = normalizedPath.asString();
+            file.size = data.size();
+            file.storedData = compress(data, compression);
+            if(file.storedData.empty()) {
+                file.compression = Compression::None;
+                file.storedData.assign(data.begin(), data.end());
+            } else {
+                file.compression = compression;
+            }
+        }
+
+        void Writer::addDirectory(const std::filesystem::path& directory, Compression compression) {
+            std::vector<std::filesystem::path> filepaths;
+            for(const auto& directoryEntry : std::filesystem::recursive_directory_iterator(directory)) {
+                if(directoryEntry.is_regular_file()) {
+                    filepaths.push_back(directoryEntry.path());
+                }
+            }
+            // keep the pack reproducible, directory iteration order is not specified
+            std::sort(filepaths.begin(), filepaths.end());
+
+            for(const auto& filepath : filepaths) {
+                std::ifstream file { filepath, std::ios::binary };
+                if(!file) {
+                    throw std::runtime_error(Carrot::sprintf("Could not open %s", Carrot::toString(filepath.u8string()).c_str()));
+                }
+                std::vector<std::uint8_t> contents(std::filesystem::file_size(filepath));
+                file.read(reinterpret_cast<char*>(contents.data()), static_cast<std::streamsize>(contents.size()));
+                add(Carrot::toString(std::filesystem::relative(filepath, directory).generic_u8string()), contents, compression);
+            }
+        }
+
+        std::vector<std::uint8_t> Writer::write() const {
+            auto align = [](std::uint64_t offset) {
+                if(offset % Alignment != 0) {
+                    offset += Alignment - offset % Alignment;
+                }
+                return offset;
+            };
+
+            std::vector<std::size_t> order(files.size());
+            std::vector<std::uint64_t> hashes(files.size());
+            for(std::size_t i = 0; i < files.size(); i++) {
+                order[i] = i;
+                hashes[i] = hashPath(files[i].path);
+            }
+            std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+                if(hashes[a] != hashes[b]) {
+                    return hashes[a] < hashes[b];
+                }
+                return files[a].path < files[b].path;
+            });
+
+            Header header;
+            std::vector<Entry> entries(files.size());
+            std::vector<char> strings;
+            for(std::size_t i = 0; i < order.size(); i++) {
+                const PendingFile& file = files[order[i]];
+                Entry& entry = entries[i];
+                entry.pathHash = hashes[order[i]];
+                entry.path = StringRef { .offset = static_cast<std::uint32_t>(strings.size()), .length = static_cast<std::uint32_t>(file.path.size()) };
+                entry.compression = file.compression;
+                entry.storedSize = file.storedData.size();
+                entry.size = file.size;
+                strings.insert(strings.end(), file.path.begin(), file.path.end());
+            }
+
+            // layout: header, index, strings, then contents. Offsets of contents are known once the index size is known
+            header.entries = Table { .offset = align(sizeof(Header)), .count = entries.size() };
+            header.strings = Table { .offset = align(header.entries.offset + entries.size() * sizeof(Entry)), .count = strings.size() };
+            std::uint64_t offset = align(header.strings.offset + strings.size());
+            for(std::size_t i = 0; i < order.size(); i++) {
+                entries[i].offset = offset;
+                offset = align(offset + entries[i].storedSize);
+            }
+
+            std::vector<std::uint8_t> bytes(offset);
+            memcpy(bytes.data(), &header, sizeof(Header));
+            if(!entries.empty()) {
+                memcpy(bytes.data() + header.entries.offset, entries.data(), entries.size() * sizeof(Entry));
+            }
+            if(!strings.empty()) {
+                memcpy(bytes.data() + header.strings.offset, strings.data(), strings.size());
+            }
+            for(std::size_t i = 0; i < order.size(); i++) {
+                const PendingFile& file = files[order[i]];
+                if(!file.storedData.empty()) {
+                    memcpy(bytes.data() + entries[i].offset, file.storedData.data(), file.storedData.size());
+                }
+            }
+            return bytes;
+        }
+    }
+
+    PackFile::PackFile(const std::filesystem::path& path): mapping(std::in_place, path) {
+        data = mapping->getData();
+        validate();
+    }
+
+    PackFile::PackFile(std::vector<std::uint8_t>&& bytes): ownedData(std::move(bytes)) {
+        data = ownedData;
+        validate();
+    }
+
+    void PackFile::validate() {
+        using namespace Pack;
+        if(data.size() < sizeof(Header) || reinterpret_cast<std::uintptr_t>(data.data()) % Alignment != 0) {
+            throw std::runtime_error("Not a pack: too small or misaligned");
+        }
+        pHeader = reinterpret_cast<const Header*>(data.data());
+        if(pHeader->magic != Magic) {
+            throw std::runtime_error("Not a pack: invalid magic");
+        }
+        if(pHeader->version != Version) {
+            throw std::runtime_error(Carrot::sprintf("Unsupported pack version %u (expected %u)", pHeader->version, Version));
+        }
+
+        // checks the structure of the file, so that spans returned by this object stay inside 'data'
+        const std::span<const Entry> entries = getEntries();
+        const std::uint64_t stringCount = getTable<char>(pHeader->strings).size();
+        for(std::size_t i = 0; i < entries.size(); i++) {
+            const Entry& entry = entries[i];
+            if(static_cast<std::uint64_t>(entry.path.offset) + entry.path.length > stringCount) {
+                throw std::runtime_error("Invalid pack: path is out of bounds");
+            }
+            if(entry.offset > data.size() || entry.storedSize > data.size() - entry.offset) {
+                throw std::runtime_error(Carrot::sprintf("Invalid pack: data of %s is out of bounds", std::string(getPath(entry)).c_str()));
+            }
+            if(entry.compression != Compression::None && entry.compression != Compression::LZ4 && entry.compression != Compression::Zstd) {
+                throw std::runtime_error("Invalid pack: unknown compression");
+            }
+            if(entry.compression == Compression::None && entry.storedSize != entry.size) {
+                throw std::runtime_error("Invalid pack: size of uncompressed entry does not match");
+            }
+            if(i > 0) {
+                const Entry& previous = entries[i - 1];
+                if(previous.pathHash > entry.pathHash || (previous.pathHash == entry.pathHash && getPath(previous) >= getPath(entry))) {
+                    throw std::runtime_error("Invalid pack: index is not sorted");
+                }
+            }
+        }
+    }
+
+    template<typename T>
+    std::span<const T> PackFile::getTable(const Pack::Table& table) const {
+        if(table.offset % alignof(T) != 0
+        || table.offset > data.size()
+        || table.count > (data.size() - table.offset) / sizeof(T)) {
+            throw std::runtime_error("Invalid pack: table is out of bounds");
+        }
+        return std::span<const T> { reinterpret_cast<const T*>(data.data() + table.offset), table.count };
+    }
+
+    const Pack::Entry* PackFile::find(std::string_view path) const {
+        const std::uint64_t hash = Pack::hashPath(path);
+        const std::span<const Pack::Entry> entries = getEntries();
+        auto it = std::lower_bound(entries.begin(), entries.end(), hash, [](const Pack::Entry& entry, std::uint64_t hash) {
+            return entry.pathHash < hash;
+        });
+        for(; it != entries.end() && it->pathHash == hash; ++it) {
+            if(getPath(*it) == path) {
+                return &(*it);
+            }
+        }
+        return nullptr;
+    }
+
+    std::span<const Pack::Entry> PackFile::getEntries() const {
+        return getTable<Pack::Entry>(pHeader->entries);
+    }
+
+    std::string_view PackFile::getPath(const Pack::Entry& entry) const {
+        const std::span<const char> strings = getTable<char>(pHeader->strings);
+        return std::string_view { strings.data() + entry.path.offset, entry.path.length };
+    }
+
+    std::span<const std::uint8_t> PackFile::getStoredData(const Pack::Entry& entry) const {
+        return data.subspan(entry.offset, entry.storedSize);
+    }
+
+    void PackFile::read(const Pack::Entry& entry, std::span<std::uint8_t> destination) const {
+        verify(destination.size() == entry.size, "Destination must have the size of the entry");
+        const std::span<const std::uint8_t> stored = getStoredData(entry);
+        switch(entry.compression) {
+            case Pack::Compression::None:
+                if(!stored.empty()) {
+                    memcpy(destination.data(), stored.data(), stored.size());
+                }
+                return;
+
+            case Pack::Compression::LZ4: {
+#if CARROT_PACK_LZ4
+                const int decompressedSize = LZ4_decompress_safe(reinterpret_cast<const char*>(stored.data()), reinterpret_cast<char*>(destination.data()),
+                                                                 static_cast<int>(stored.size()), static_cast<int>(destination.size()));
+                if(decompressedSize < 0 || static_cast<std::uint64_t>(decompressedSize) != entry.size) {
+                    throw std::runtime_error(Carrot::sprintf("Invalid pack: could not decompress %s", std::string(getPath(entry)).c_str()));
+                }
+                return;
+#endif
+            } break;
+
+            case Pack::Compression::Zstd: {
+#if CARROT_PACK_ZSTD
+                const std::size_t decompressedSize = ZSTD_decompress(destination.data(), destination.size(), stored.data(), stored.size());
+                if(ZSTD_isError(decompressedSize) || decompressedSize != entry.size) {
+                    throw std::runtime_error(Carrot::sprintf("Invalid pack: could not decompress %s", std::string(getPath(entry)).c_str()));
+                }
+                return;
+#endif
+            } break;
+        }
+        throw std::runtime_error(Carrot::sprintf("Compression %u of %s is not supported by this build", static_cast<std::uint32_t>(entry.compression), std::string(getPath(entry)).c_str()));
+    }
+
+    std::vector<std::uint8_t> PackFile::read(const Pack::Entry& entry) const {
+        std::vector<std::uint8_t> contents(entry.size);
+        read(entry, contents);
+        return contents;
+    }
+}
@@ -0,0 +1,143 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <core/io/MappedFile.h>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace Carrot::IO {
+    /// Archive of files (.cpak), meant for shipping: a single file to open and map instead of thousands of small files to stat and open.
+    /// Packs are mounted as VFS roots (see VirtualFileSystem::addPackRoot).
+    ///
+    /// Layout: a Header, an index of entries sorted by the hash of their path, a string table with the paths, and the contents of the files.
+    /// Tables and contents are aligned on 'Pack::Alignment' bytes, so that uncompressed files in a mapped pack can be used in place
+    /// by formats which expect aligned data (BinaryModelView for instance).
+    /// Offsets are relative to the start of the file. All values are little-endian, like every platform Carrot runs on.
+    namespace Pack {
+        constexpr std::uint32_t Magic = 'C' | ('P' << 8) | ('A' << 16) | ('K' << 24);
+
+        /// Increment when the layout of the file changes
+        constexpr std::uint32_t Version = 1;
+
+        constexpr std::uint64_t Alignment = 16;
+
+        /// Part of the file containing 'count' elements, starting at 'offset' (in bytes)
+        struct Table {
+            std::uint64_t offset = 0;
+            std::uint64_t count = 0;
+        };
+
+        /// String inside the string table, not null-terminated
+        struct StringRef {
+            std::uint32_t offset = 0;
+            std::uint32_t length = 0;
+        };
+
+        struct Header {
+            std::uint32_t magic = Magic;
+            std::uint32_t version = Version;
+
+            Table entries; // Pack::Entry, sorted by (pathHash, path)
+            Table strings; // char
+        };
+
+        /// Compression codecs are optional, and only available if the engine was built with them (see 'isSupported')
+        enum class Compression: std::uint32_t {
+            None,
+            LZ4, // fast decompression, for most assets
+            Zstd, // better ratio, for large assets which are rarely loaded
+        };
+
+        struct Entry {
+            std::uint64_t pathHash = 0; // see 'hashPath'
+            StringRef path; // normalized path, relative to the root of the pack
+            Compression compression = Compression::None;
+            std::uint32_t padding = 0;
+            std::uint64_t offset = 0; // where the stored data starts
+            std::uint64_t storedSize = 0; // size inside the pack, after compression
+            std::uint64_t size = 0; // size of the file, once decompressed
+        };
+
+        /// Hash used to sort and find entries (64-bit FNV-1a). 'path' must be normalized
+        std::uint64_t hashPath(std::string_view path);
+
+        /// Was the engine built with support for the given codec?
+        bool isSupported(Compression compression);
+
+        /// Builds a pack in memory
+        class Writer {
+        public:
+            /// Adds a file to the pack. 'path' is normalized and must be relative, and must not already be inside the pack.
+            /// If compressing does not make the file smaller, it is stored uncompressed.
+            /// Throws if the codec is not supported
+            void add(std::string_view path, std::span<const std::uint8_t> data, Compression compression = Compression::None);
+
+            /// Adds all regular files inside 'directory' (recursively), with paths relative to 'directory'
+            void addDirectory(const std::filesystem::path& directory, Compression compression = Compression::None);
+
+            /// Serializes the pack
+            std::vector<std::uint8_t> write() const;
+
+        private:
+            struct PendingFile {
+                std::string path;
+                Compression compression = Compression::None;
+                std::uint64_t size = 0;
+                std::vector<std::uint8_t> storedData;
+            };
+
+            std::vector<PendingFile> files;
+            std::unordered_set<std::string> paths;
+        };
+    }
+
+    /// Read-only pack, memory-mapped from disk (or kept in memory). Lookups are a binary search inside the index and do not touch the OS.
+    /// Reading files is thread-safe.
+    class PackFile {
+    public:
+        /// Maps the pack at 'path'. Throws if the file cannot be opened or is not a valid pack
+        explicit PackFile(const std::filesystem::path& path);
+
+        /// Pack stored in memory. Throws if 'data' is not a valid pack
+        explicit PackFile(std::vector<std::uint8_t>&& data);
+
+        PackFile(const PackFile&) = delete;
+        PackFile& operator=(const PackFile&) = delete;
+
+        /// Entry with the given path, nullptr if it is not inside the pack. 'path' must be normalized
+        const Pack::Entry* find(std::string_view path) const;
+
+        std::span<const Pack::Entry> getEntries() const;
+        std::string_view getPath(const Pack::Entry& entry) const;
+
+        /// Data of the entry, as stored in the pack. If the entry is not compressed, this is the content of the file and can be used in place
+        std::span<const std::uint8_t> getStoredData(const Pack::Entry& entry) const;
+
+        /// Decompresses (or copies) the entry to 'destination', which must be exactly 'entry.size' bytes long.
+        /// Throws if the codec is not supported or if the data is corrupted
+        void read(const Pack::Entry& entry, std::span<std::uint8_t> destination) const;
+        std::vector<std::uint8_t> read(const Pack::Entry& entry) const;
+
+    private:
+        /// Checks that 'data' is a valid pack, throws if it is not
+        void validate();
+
+        template<typename T>
+        std::span<const T> getTable(const Pack::Table& table) const;
+
+        std::optional<MappedFile> mapping;
+        std::vector<std::uint8_t> ownedData;
+
+        std::span<const std::uint8_t> data;
+        const Pack::Header* pHeader = nullptr;
+    };
+}
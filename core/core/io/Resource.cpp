@@ -4,6 +4,7 @@
 
 #include "Resource.h"
 #include <cstring>
+#include "core/io/PackFile.h"
 #include "core/utils/Assert.h"
 #include "core/utils/stringmanip.h"
 
@@ -20,6 +21,14 @@ namespace Carrot::IO {
     Resource::Resource(const VFS::Path& path): data(false) {
         std::filesystem::path fullPath;
         if(vfsToUse != nullptr) {
+            // files inside packs are read once, there is no file handle to keep around
+            if(auto packedFile = vfsToUse->findPacked(path)) {
+                data = Data(true);
+                data.raw = std::make_shared<std::vector<std::uint8_t>>(packedFile->pack->read(*packedFile->pEntry));
+                name("", path.toString());
+                packed = true;
+                return;
+            }
             fullPath = vfsToUse->resolve(path);
         } else {
             fullPath = path.toString();
@@ -64,11 +73,13 @@ namespace Carrot::IO {
     Resource::Resource(const Resource& toCopy): data(toCopy.data.isRawData) {
         data = toCopy.data;
         name(toCopy.filename, toCopy.debugName);
+        packed = toCopy.packed;
     }
 
     Resource::Resource(Resource&& toMove): data(std::move(toMove.data)) {
         filename = std::move(toMove.filename);
         debugName = std::move(toMove.debugName);
+        packed = toMove.packed;
     }
 
     void Resource::open() {
@@ -92,6 +103,7 @@ namespace Carrot::IO {
         data = std::move(toMove.data);
         filename = std::move(toMove.filename);
         debugName = std::move(toMove.debugName);
+        packed = toMove.packed;
         return *this;
     }
 
@@ -105,6 +117,7 @@ namespace Carrot::IO {
         data = toCopy.data;
         filename = toCopy.filename;
         debugName = toCopy.debugName;
+        packed = toCopy.packed;
         return *this;
     }
 
@@ -205,7 +218,7 @@ namespace Carrot::IO {
 
     Carrot::IO::Resource Resource::relative(const std::filesystem::path& path) const {
         // TODO: use IO::Path instead of fs::path
-        if(!isFile()) {
+        if(!isFile() && !packed) {
             return Resource{ VFS::Path(path.string()) };
         }
         if(path.is_absolute()) {
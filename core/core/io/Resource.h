@@ -25,6 +25,7 @@ namespace Carrot::IO {
 
         Resource(const char* path);
         Resource(const std::string& path);
+        /// If 'path' is inside a pack mounted in the VFS, the file is read from the pack and the resource is kept in memory
         Resource(const VFS::Path& path);
 
         /// Loads a resource with the given path, but read from 'filepathOverride'.
@@ -156,5 +157,6 @@ namespace Carrot::IO {
 
         std::string debugName;
         std::filesystem::path filename;
+        bool packed = false; // in-memory, but read from a pack: relative paths are resolved like for files
     };
 }
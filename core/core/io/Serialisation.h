@@ -41,9 +41,9 @@ namespace Carrot::IO {
         destination.push_back((v >> 16) & 0xFF);
         destination.push_back((v >> 24) & 0xFF);
         destination.push_back((v >> 32) & 0xFF);
+        destination.push_back((v >> 40) & 0xFF);
         destination.push_back((v >> 48) & 0xFF);
         destination.push_back((v >> 56) & 0xFF);
-        destination.push_back((v >> 60) & 0xFF);
     }
 
     inline void write(std::vector<std::uint8_t>& destination, float v) {
@@ -118,10 +118,11 @@ inline std::vector<std::uint8_t>& operator<<(std::vector<std::uint8_t>& out, con
 }
 
 namespace Carrot::IO {
-    /// Allows to read data written to a std::vector, with Carrot::IO::write methods. Little-endian is used for both
+    /// Allows to read data written to a std::vector, with Carrot::IO::write methods. Little-endian is used for both.
+    /// The read bytes are not copied and must outlive the reader
     class VectorReader {
     public:
-        explicit VectorReader(const std::vector<std::uint8_t>& vector): data(vector) {}
+        explicit VectorReader(std::span<const std::uint8_t> bytes): data(bytes) {}
         ~VectorReader() = default;
 
         VectorReader& operator>>(char& out);
@@ -207,7 +208,7 @@ namespace Carrot::IO {
     private:
         std::uint8_t next();
 
-        const std::vector<std::uint8_t>& data;
+        std::span<const std::uint8_t> data;
         std::size_t ptr = 0;
     };
 
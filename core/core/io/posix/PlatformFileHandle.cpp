@@ -0,0 +1,138 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "PlatformFileHandle.h"
+#include "core/utils/Assert.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Carrot::IO {
+    static std::error_code lastError() {
+        return std::error_code{ errno, std::system_category() };
+    }
+
+    PlatformFileHandle* PlatformFileHandle::open(const std::filesystem::path& path, OpenMode openMode) {
+        int flags = O_CLOEXEC;
+        switch(openMode) {
+            case OpenMode::Read:
+                flags |= O_RDONLY;
+                break;
+
+            case OpenMode::NewReadWrite:
+                flags |= O_RDWR | O_CREAT | O_EXCL;
+                break;
+
+            case OpenMode::AlreadyExistingReadWrite:
+            case OpenMode::Append:
+                flags |= O_RDWR;
+                break;
+
+            case OpenMode::Write:
+                flags |= O_WRONLY | O_TRUNC;
+                break;
+
+            case OpenMode::Invalid:
+            default:
+                verify(false, "Invalid parameter");
+                break;
+        }
+
+        int result;
+        do {
+            result = ::open(path.c_str(), flags, 0644);
+        } while(result < 0 && errno == EINTR);
+
+        if(result >= 0) {
+            PlatformFileHandle* fileHandle = new PlatformFileHandle;
+            fileHandle->fd = result;
+            return fileHandle;
+        } else {
+            throw std::filesystem::filesystem_error("Could not open", path, lastError());
+        }
+    }
+
+    void PlatformFileHandle::close() {
+        ::close(fd);
+        fd = -1;
+        cursor = 0;
+    }
+
+    void PlatformFileHandle::write(std::span<const std::uint8_t> data) {
+        verify(fd >= 0, "File is not open!");
+        std::size_t written = 0;
+        while(written < data.size()) {
+            const ssize_t result = ::pwrite(fd, data.data() + written, data.size() - written, static_cast<off_t>(cursor + written));
+            if(result < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                throw std::filesystem::filesystem_error("Could not write to file", lastError());
+            }
+            written += static_cast<std::size_t>(result);
+        }
+        cursor += written;
+    }
+
+    void PlatformFileHandle::seek(std::int64_t position, int seekDirection) {
+        verify(fd >= 0, "File is not open!");
+        std::int64_t base = 0;
+        switch(seekDirection) {
+            case SEEK_CUR:
+                base = static_cast<std::int64_t>(cursor);
+                break;
+            case SEEK_SET:
+                base = 0;
+                break;
+            case SEEK_END: {
+                struct stat fileStats{};
+                if(fstat(fd, &fileStats) != 0) {
+                    throw std::filesystem::filesystem_error("Could not seek", lastError());
+                }
+                base = static_cast<std::int64_t>(fileStats.st_size);
+            } break;
+            default:
+                verify(false, "Unsupported seek operation");
+                break;
+        }
+        if(base + position < 0) {
+            throw std::filesystem::filesystem_error("Could not seek", std::make_error_code(std::errc::invalid_argument));
+        }
+        cursor = static_cast<std::uint64_t>(base + position);
+    }
+
+    void PlatformFileHandle::read(std::span<std::uint8_t> data) const {
+        verify(fd >= 0, "File is not open!");
+        std::size_t readCount = 0;
+        while(readCount < data.size()) {
+            const ssize_t result = ::pread(fd, data.data() + readCount, data.size() - readCount, static_cast<off_t>(cursor + readCount));
+            if(result < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                throw std::filesystem::filesystem_error("Could not read", lastError());
+            }
+            if(result == 0) {
+                throw std::filesystem::filesystem_error("Could not read all bytes", std::make_error_code(std::errc::io_error));
+            }
+            readCount += static_cast<std::size_t>(result);
+        }
+        cursor += readCount;
+    }
+
+    std::uint64_t PlatformFileHandle::tell() const {
+        return cursor;
+    }
+
+    PlatformFileHandle::~PlatformFileHandle() {
+        if(fd >= 0) {
+            close();
+        }
+    }
+} // Carrot::IO
+
+#endif // !_WIN32
@@ -0,0 +1,40 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+#ifndef _WIN32
+#include <core/io/FileHandle.h>
+
+namespace Carrot::IO {
+
+    /**
+     * Platform file handle for Linux (and other POSIX systems)
+     * The cursor is kept inside this object and all accesses go through pread/pwrite: seeking and telling do not need a syscall,
+     * which matters because FileHandle seeks before and after each read.
+     */
+    class PlatformFileHandle {
+    public:
+        /**
+         * Responsibility of user code to delete pointer
+         */
+        static PlatformFileHandle* open(const std::filesystem::path& path, OpenMode openMode);
+        ~PlatformFileHandle();
+
+        void close();
+        void write(std::span<const std::uint8_t> data);
+        void seek(std::int64_t position, int seekDirection);
+
+        void read(std::span<std::uint8_t> data) const;
+        std::uint64_t tell() const;
+
+    private:
+        int fd = -1;
+
+        // mutable because reads are const but advance the cursor, like on Windows
+        mutable std::uint64_t cursor = 0;
+    };
+
+} // Carrot::IO
+
+#endif
@@ -6,19 +6,25 @@
 #include "core/exceptions/Exceptions.h"
 #include "core/utils/stringmanip.h"
 #include "core/io/Logging.hpp"
+#include "core/io/PackFile.h"
 #include <regex>
 
 namespace Carrot::IO {
 
     static const std::regex RootRegex("[a-z0-9_]*");
 
-    void VirtualFileSystem::addRoot(std::string_view identifier, const std::filesystem::path& root) {
+    void VirtualFileSystem::checkNewRoot(std::string_view identifier) const {
         if(identifier.empty()) {
             throw std::invalid_argument(std::string(identifier));
         }
         if(!std::regex_match(identifier.data(), identifier.data()+identifier.size(), RootRegex)) {
             throw std::invalid_argument(std::string(identifier));
         }
+        verify(packs.find(std::string(identifier)) == nullptr, "Root must not already exist");
+    }
+
+    void VirtualFileSystem::addRoot(std::string_view identifier, const std::filesystem::path& root) {
+        checkNewRoot(identifier);
         if(!root.is_absolute()) {
             throw std::invalid_argument(Carrot::sprintf("Root path must be absolute: %s", root.u8string().c_str()));
         }
@@ -35,20 +41,69 @@ namespace Carrot::IO {
         rootPath = root;
     }
 
+    void VirtualFileSystem::addPackRoot(std::string_view identifier, const std::filesystem::path& packPath) {
+        checkNewRoot(identifier);
+        addPackRoot(identifier, std::make_shared<const PackFile>(packPath));
+    }
+
+    void VirtualFileSystem::addPackRoot(std::string_view identifier, std::shared_ptr<const PackFile> pack) {
+        checkNewRoot(identifier);
+        verify(pack != nullptr, "Pack must not be null");
+        verify(roots.find(std::string(identifier)) == nullptr, "Root must not already exist");
+
+        Carrot::Log::debug("Added pack root %s with %llu files", std::string(identifier).c_str(), static_cast<unsigned long long>(pack->getEntries().size()));
+
+        bool newRoot = false;
+        auto& rootPack = packs.getOrCompute(std::string(identifier), [&]() -> std::shared_ptr<const PackFile> {
+            newRoot = true;
+            return {};
+        });
+        verify(newRoot, "Root must not already exist");
+
+        rootPack = std::move(pack);
+    }
+
     bool VirtualFileSystem::hasRoot(std::string_view identifier) const {
         auto snapshot = roots.snapshot();
         for(const auto& [rootID, _] : snapshot) {
             if(rootID == identifier)
                 return true;
         }
-        return false;
+        return packs.find(std::string(identifier)) != nullptr;
     }
 
     bool VirtualFileSystem::removeRoot(std::string_view identifier) {
-        return roots.remove(std::string(identifier));
+        const bool removedDirectory = roots.remove(std::string(identifier));
+        const bool removedPack = packs.remove(std::string(identifier));
+        return removedDirectory || removedPack;
+    }
+
+    std::optional<VirtualFileSystem::PackedFile> VirtualFileSystem::findPacked(const Path& path) const {
+        if(path.isGeneric()) {
+            // same precedence as 'complete': a loose file in a directory root overrides the packed one
+            const Path completed = complete(path);
+            if(completed.isGeneric()) {
+                return {};
+            }
+            return findPacked(completed);
+        }
+
+        const std::string& pathInPack = path.getPath().asString();
+        const std::shared_ptr<const PackFile>* pPack = packs.find(path.getRoot());
+        if(pPack == nullptr) {
+            return {};
+        }
+        const Pack::Entry* pEntry = (*pPack)->find(pathInPack);
+        if(pEntry == nullptr) {
+            return {};
+        }
+        return PackedFile { .pack = *pPack, .pEntry = pEntry };
     }
 
     std::filesystem::path VirtualFileSystem::resolve(const VirtualFileSystem::Path& path) const {
+        if(!path.isGeneric() && packs.find(path.getRoot()) != nullptr) {
+            verify(false, Carrot::sprintf("Root %s is a pack, its files have no physical path: %s", path.getRoot().c_str(), path.toString().c_str()));
+        }
         auto it = safeResolve(path);
         verify(it.has_value(), Carrot::sprintf("Invalid root: %s", path.getRoot().c_str()));
         return it.value();
@@ -65,6 +120,11 @@ namespace Carrot::IO {
                     return Path{rootID, path.getPath()};
                 }
             }
+            for(const auto& [rootID, pPack] : packs.snapshot()) {
+                if((*pPack)->find(normalizedVersion.asString()) != nullptr) {
+                    return Path{rootID, path.getPath()};
+                }
+            }
             return Path{};
         } else {
             return path;
@@ -85,6 +145,9 @@ namespace Carrot::IO {
     }
 
     bool VirtualFileSystem::exists(const VirtualFileSystem::Path& path) const {
+        if(findPacked(path).has_value()) {
+            return true;
+        }
         auto opt = safeResolve(path);
         if(!opt.has_value())
             return false;
@@ -98,6 +161,9 @@ namespace Carrot::IO {
         for(const auto& [rootID, _] : snapshot) {
             rootIDs.push_back(rootID);
         }
+        for(const auto& [rootID, _] : packs.snapshot()) {
+            rootIDs.push_back(rootID);
+        }
         return rootIDs;
     }
 
@@ -7,10 +7,17 @@
 #include <string>
 #include <filesystem>
 #include <map>
+#include <memory>
 #include "core/async/ParallelMap.hpp"
 #include "core/io/Path.h"
 
 namespace Carrot::IO {
+    class PackFile;
+
+    namespace Pack {
+        struct Entry;
+    }
+
     /// Access to the VFS is internally synchronized
     class VirtualFileSystem {
     public:
@@ -82,6 +89,7 @@ namespace Carrot::IO {
 
         /// Completes the path:
         ///  If 'path' is generic, find the root corresponding to that path, and returns it. If no such root exists, returns an empty path
+        ///   Directory roots are searched before pack roots
         ///  If 'path' is not generic, returns 'path' directly
         Path complete(const Path& path) const;
 
@@ -94,6 +102,17 @@ namespace Carrot::IO {
 
         bool exists(const Path& path) const;
 
+        /// File inside a pack mounted in this VFS
+        struct PackedFile {
+            std::shared_ptr<const PackFile> pack; // keeps the pack alive even if its root is removed
+            const Pack::Entry* pEntry = nullptr;
+        };
+
+        /// If 'path' is inside a pack root, returns the pack and the entry of the file. Generic paths are first completed (see 'complete'),
+        /// so a loose file inside a directory root takes precedence over the same file inside a pack.
+        /// Returns an empty optional if the file is not inside a pack
+        std::optional<PackedFile> findPacked(const Path& path) const;
+
         /**
          * Returns a copy of the current roots when called.
          */
@@ -104,13 +123,24 @@ namespace Carrot::IO {
         ///  Identifier must also not exist already
         void addRoot(std::string_view identifier, const std::filesystem::path& root);
 
+        /// Mounts the pack at 'packPath' (see PackFile) as a new root. Same rules as 'addRoot' for the identifier.
+        /// Files inside a pack root have no physical path: 'resolve' throws for them, use 'findPacked' (or Resource) to read them
+        void addPackRoot(std::string_view identifier, const std::filesystem::path& packPath);
+
+        /// Mounts an already opened pack as a new root
+        void addPackRoot(std::string_view identifier, std::shared_ptr<const PackFile> pack);
+
         bool hasRoot(std::string_view identifier) const;
 
         /// Attemps to remove a given root from the VFS. Returns true if a root with the given identifier was removed.
         bool removeRoot(std::string_view identifier);
 
     private:
+        /// Throws if 'identifier' is not a valid root identifier, or if a root with this identifier already exists
+        void checkNewRoot(std::string_view identifier) const;
+
         Async::ParallelMap<std::string, std::filesystem::path> roots;
+        Async::ParallelMap<std::string, std::shared_ptr<const PackFile>> packs;
     };
 
     using VFS = VirtualFileSystem;
@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <algorithm>
 #include <glm/glm.hpp>
+#include <vector>
 
 namespace Carrot {
     struct Keyframe {
@@ -0,0 +1,226 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "AnimationCompression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <core/utils/Assert.h>
+
+namespace Carrot {
+    static constexpr float QuantizationScale = 65535.0f;
+
+    BonePose BonePose::fromMatrix(const glm::mat4& transform) {
+        BonePose pose;
+        pose.translation = glm::vec3 { transform[3] };
+
+        const glm::vec3 columns[3] = { glm::vec3 { transform[0] }, glm::vec3 { transform[1] }, glm::vec3 { transform[2] } };
+        pose.scale = glm::vec3 { glm::length(columns[0]), glm::length(columns[1]), glm::length(columns[2]) };
+        if(glm::determinant(glm::mat3 { transform }) < 0.0f) { // mirrored, a rotation cannot represent it
+            pose.scale.x = -pose.scale.x;
+        }
+
+        glm::mat3 rotation { 1.0f };
+        for(int i = 0; i < 3; i++) {
+            if(pose.scale[i] != 0.0f) {
+                rotation[i] = columns[i] / pose.scale[i];
+            }
+        }
+        pose.rotation = glm::normalize(glm::quat_cast(rotation));
+        return pose;
+    }
+
+    glm::mat4 BonePose::toMatrix() const {
+        glm::mat4 result = glm::mat4_cast(rotation);
+        result[0] *= scale.x;
+        result[1] *= scale.y;
+        result[2] *= scale.z;
+        result[3] = glm::vec4 { translation, 1.0f };
+        return result;
+    }
+
+    static glm::vec4 interpolate(const glm::vec4& a, const glm::vec4& b, float t, bool isRotation) {
+        glm::vec4 result = glm::mix(a, b, t);
+        if(isRotation) {
+            const float length = glm::length(result);
+            if(length > 0.0f) {
+                result /= length;
+            }
+        }
+        return result;
+    }
+
+    static bool isWithinTolerance(const glm::vec4& a, const glm::vec4& b, float tolerance) {
+        const glm::vec4 difference = glm::abs(a - b);
+        return std::max(std::max(difference.x, difference.y), std::max(difference.z, difference.w)) <= tolerance;
+    }
+
+    /// Indices of the keyframes to keep, so that removed keyframes can be linearly interpolated from the kept ones within 'tolerance'.
+    /// Always keeps the first keyframe, and the last one unless all values are within 'tolerance' of the first one.
+    static std::vector<std::uint32_t> reduceKeys(std::span<const glm::vec4> values, std::span<const float> timestamps, bool isRotation, float tolerance) {
+        std::vector<std::uint32_t> kept;
+        kept.push_back(0);
+
+        const bool isConstant = std::all_of(values.begin(), values.end(), [&](const glm::vec4& v) {
+            return isWithinTolerance(v, values[0], tolerance);
+        });
+        if(isConstant) {
+            return kept;
+        }
+
+        auto segmentFits = [&](std::size_t start, std::size_t end) {
+            const float timeBetweenKeys = timestamps[end] - timestamps[start];
+            for(std::size_t i = start + 1; i < end; i++) {
+                const float t = timeBetweenKeys > 0.0f ? (timestamps[i] - timestamps[start]) / timeBetweenKeys : 0.0f;
+                if(!isWithinTolerance(interpolate(values[start], values[end], t, isRotation), values[i], tolerance)) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        // greedily extend each segment as far as possible
+        std::size_t start = 0;
+        while(start + 1 < values.size()) {
+            std::size_t end = start + 1;
+            while(end + 1 < values.size() && segmentFits(start, end + 1)) {
+                end++;
+            }
+            kept.push_back(static_cast<std::uint32_t>(end));
+            start = end;
+        }
+        return kept;
+    }
+
+    CompressedAnimation CompressedAnimation::compress(const Animation& animation, const AnimationCompressionSettings& settings) {
+        verify(animation.keyframes.size() <= static_cast<std::size_t>(std::numeric_limits<std::uint16_t>::max()) + 1, "Too many keyframes to compress animation");
+
+        CompressedAnimation result;
+        result.duration = animation.duration;
+        if(animation.keyframes.empty()) {
+            return result;
+        }
+
+        const std::size_t keyframeCount = animation.keyframes.size();
+        const std::size_t boneCount = animation.keyframes[0].boneTransforms.size();
+        result.keyframeTimestamps.reserve(keyframeCount);
+        for(const Keyframe& keyframe : animation.keyframes) {
+            verify(keyframe.boneTransforms.size() == boneCount, "All keyframes must have the same bone count");
+            result.keyframeTimestamps.push_back(keyframe.timestamp);
+        }
+
+        std::vector<glm::vec4> translations(keyframeCount);
+        std::vector<glm::vec4> rotations(keyframeCount);
+        std::vector<glm::vec4> scales(keyframeCount);
+        result.tracks.resize(boneCount);
+        for(std::size_t boneIndex = 0; boneIndex < boneCount; boneIndex++) {
+            for(std::size_t keyframeIndex = 0; keyframeIndex < keyframeCount; keyframeIndex++) {
+                const BonePose pose = BonePose::fromMatrix(animation.keyframes[keyframeIndex].boneTransforms[boneIndex]);
+                translations[keyframeIndex] = glm::vec4 { pose.translation, 0.0f };
+                scales[keyframeIndex] = glm::vec4 { pose.scale, 0.0f };
+
+                glm::vec4 rotation { pose.rotation.x, pose.rotation.y, pose.rotation.z, pose.rotation.w };
+                // q and -q are the same rotation: keep consecutive keys in the same hemisphere so that interpolation takes the shortest path
+                if(keyframeIndex > 0 && glm::dot(rotation, rotations[keyframeIndex - 1]) < 0.0f) {
+                    rotation = -rotation;
+                }
+                rotations[keyframeIndex] = rotation;
+            }
+
+            BoneTracks& boneTracks = result.tracks[boneIndex];
+            boneTracks.translation = result.addTrack(translations, false, settings.translationTolerance);
+            boneTracks.rotation = result.addTrack(rotations, true, settings.rotationTolerance);
+            boneTracks.scale = result.addTrack(scales, false, settings.scaleTolerance);
+        }
+
+        result.keys.shrink_to_fit();
+        result.keyframeIndices.shrink_to_fit();
+        return result;
+    }
+
+    CompressedAnimation::Track CompressedAnimation::addTrack(std::span<const glm::vec4> values, bool isRotation, float tolerance) {
+        glm::vec4 minValue = values[0];
+        glm::vec4 maxValue = values[0];
+        for(const glm::vec4& value : values) {
+            minValue = glm::min(minValue, value);
+            maxValue = glm::max(maxValue, value);
+        }
+
+        Track track;
+        track.min = minValue;
+        track.extent = maxValue - minValue;
+        track.firstKey = static_cast<std::uint32_t>(keys.size());
+
+        // quantization adds its own error on top of the error of removing keys
+        const glm::vec4 quantizationError = track.extent / QuantizationScale * 0.5f;
+        const float maxQuantizationError = std::max(std::max(quantizationError.x, quantizationError.y), std::max(quantizationError.z, quantizationError.w));
+        const std::vector<std::uint32_t> keptKeyframes = reduceKeys(values, keyframeTimestamps, isRotation, std::max(0.0f, tolerance - maxQuantizationError));
+
+        for(const std::uint32_t keyframeIndex : keptKeyframes) {
+            glm::vec4 normalized { 0.0f };
+            for(int i = 0; i < 4; i++) {
+                if(track.extent[i] > 0.0f) {
+                    normalized[i] = (values[keyframeIndex][i] - track.min[i]) / track.extent[i];
+                }
+            }
+            keys.emplace_back(glm::round(glm::clamp(normalized, 0.0f, 1.0f) * QuantizationScale));
+            keyframeIndices.push_back(static_cast<std::uint16_t>(keyframeIndex));
+        }
+        track.keyCount = static_cast<std::uint32_t>(keptKeyframes.size());
+        return track;
+    }
+
+    std::size_t CompressedAnimation::getUncompressedMemorySize(const Animation& animation) {
+        std::size_t size = sizeof(Animation) + animation.keyframes.capacity() * sizeof(Keyframe);
+        for(const Keyframe& keyframe : animation.keyframes) {
+            size += keyframe.boneTransforms.capacity() * sizeof(glm::mat4);
+        }
+        return size;
+    }
+
+    float CompressedAnimation::getDuration() const {
+        return duration;
+    }
+
+    std::size_t CompressedAnimation::getBoneCount() const {
+        return tracks.size();
+    }
+
+    std::size_t CompressedAnimation::getKeyCount() const {
+        return keys.size();
+    }
+
+    std::size_t CompressedAnimation::getMemorySize() const {
+        return sizeof(CompressedAnimation)
+            + keyframeTimestamps.capacity() * sizeof(float)
+            + tracks.capacity() * sizeof(BoneTracks)
+            + keys.capacity() * sizeof(glm::u16vec4)
+            + keyframeIndices.capacity() * sizeof(std::uint16_t);
+    }
+
+    std::span<const float> CompressedAnimation::getKeyframeTimestamps() const {
+        return keyframeTimestamps;
+    }
+
+    std::span<const CompressedAnimation::BoneTracks> CompressedAnimation::getTracks() const {
+        return tracks;
+    }
+
+    std::span<const glm::u16vec4> CompressedAnimation::getKeys() const {
+        return keys;
+    }
+
+    std::span<const std::uint16_t> CompressedAnimation::getKeyframeIndices() const {
+        return keyframeIndices;
+    }
+
+    std::uint32_t CompressedAnimation::findKeyframe(float time) const {
+        auto it = std::upper_bound(keyframeTimestamps.begin(), keyframeTimestamps.end(), time);
+        if(it == keyframeTimestamps.begin()) {
+            return 0;
+        }
+        return static_cast<std::uint32_t>(std::distance(keyframeTimestamps.begin(), it) - 1);
+    }
+}
@@ -0,0 +1,94 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <core/render/Animation.h>
+#include <glm/gtc/quaternion.hpp>
+#include <span>
+#include <vector>
+
+namespace Carrot {
+    /// Transform of a single bone, decomposed in translation, rotation and scale
+    struct BonePose {
+        glm::vec3 translation{0.0f};
+        glm::quat rotation = glm::identity<glm::quat>();
+        glm::vec3 scale{1.0f};
+
+        /// Decomposes an affine transform. Shear cannot be represented and is lost
+        static BonePose fromMatrix(const glm::mat4& transform);
+        glm::mat4 toMatrix() const;
+    };
+
+    struct AnimationCompressionSettings {
+        /// Maximum error allowed on translations, per axis, in model units
+        float translationTolerance = 0.0005f;
+
+        /// Maximum error allowed on rotations, per quaternion component
+        float rotationTolerance = 0.0005f;
+
+        /// Maximum error allowed on scales, per axis
+        float scaleTolerance = 0.0005f;
+    };
+
+    /**
+     * Compact version of Carrot::Animation, meant to be sampled on the CPU (see AnimationSampler.h).
+     *
+     * Each bone transform of the original animation is decomposed into translation, rotation and scale, and each of these gets its own track.
+     * Keys which can be linearly interpolated from their neighbours (within the tolerances given to 'compress') are removed, so constant tracks
+     * have a single key. Remaining keys are quantized to 16 bits per component, relative to the range of values of their track.
+     *
+     * Keys reference keyframes of the original animation by index, so tracks do not need to store timestamps.
+     */
+    class CompressedAnimation {
+    public:
+        /// Keys are stored as unorm16 inside [min; min+extent], per component. Translations and scales do not use w
+        struct Track {
+            glm::vec4 min{0.0f};
+            glm::vec4 extent{0.0f};
+            std::uint32_t firstKey = 0; //< index in 'keys' and 'keyframeIndices'
+            std::uint32_t keyCount = 0;
+        };
+
+        struct BoneTracks {
+            Track translation;
+            Track rotation;
+            Track scale;
+        };
+
+        /// Builds a compressed version of the given animation. All keyframes must have the same bone count.
+        static CompressedAnimation compress(const Animation& animation, const AnimationCompressionSettings& settings = {});
+
+        /// Memory used by a Carrot::Animation (keyframes and bone matrices)
+        static std::size_t getUncompressedMemorySize(const Animation& animation);
+
+    public:
+        float getDuration() const;
+        std::size_t getBoneCount() const;
+
+        /// How many keys remain after compression, for all tracks
+        std::size_t getKeyCount() const;
+
+        /// Memory used by this animation, including the object itself
+        std::size_t getMemorySize() const;
+
+        std::span<const float> getKeyframeTimestamps() const;
+        std::span<const BoneTracks> getTracks() const;
+        std::span<const glm::u16vec4> getKeys() const;
+        std::span<const std::uint16_t> getKeyframeIndices() const;
+
+        /// Index of the keyframe of the original animation right before 'time' (or at 'time'). 'time' is expected to be inside [0; duration]
+        std::uint32_t findKeyframe(float time) const;
+
+    private:
+        /// Reduces and quantizes the given values (one per keyframe), then adds the remaining keys to this animation
+        Track addTrack(std::span<const glm::vec4> values, bool isRotation, float tolerance);
+
+        float duration = 0.0f;
+        std::vector<float> keyframeTimestamps;
+        std::vector<BoneTracks> tracks;
+        std::vector<glm::u16vec4> keys;
+        std::vector<std::uint16_t> keyframeIndices; //< for each key, index of keyframe it corresponds to in the original animation
+    };
+}
@@ -0,0 +1,222 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "AnimationSampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <core/utils/Assert.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CARROT_ANIMATION_SSE 1
+    #include <emmintrin.h>
+#endif
+
+namespace Carrot::AnimationSampler {
+    /// 4-wide float vector, backed by a SSE register when available
+    struct Float4 {
+#ifdef CARROT_ANIMATION_SSE
+        __m128 v;
+
+        static Float4 zero() { return { _mm_setzero_ps() }; }
+        static Float4 splat(float f) { return { _mm_set1_ps(f) }; }
+        static Float4 load(const glm::vec4& value) { return { _mm_loadu_ps(&value.x) }; }
+
+        /// Loads the 4 components of a key, without normalizing them
+        static Float4 loadKey(const glm::u16vec4& key) {
+            const __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&key));
+            return { _mm_cvtepi32_ps(_mm_unpacklo_epi16(packed, _mm_setzero_si128())) };
+        }
+
+        void store(glm::vec4& out) const { _mm_storeu_ps(&out.x, v); }
+
+        Float4 operator+(const Float4& other) const { return { _mm_add_ps(v, other.v) }; }
+        Float4 operator-(const Float4& other) const { return { _mm_sub_ps(v, other.v) }; }
+        Float4 operator*(const Float4& other) const { return { _mm_mul_ps(v, other.v) }; }
+
+        float dot(const Float4& other) const {
+            const __m128 products = _mm_mul_ps(v, other.v);
+            const __m128 swapped = _mm_shuffle_ps(products, products, _MM_SHUFFLE(2, 3, 0, 1)); // y x w z
+            const __m128 pairSums = _mm_add_ps(products, swapped); // x+y x+y z+w z+w
+            return _mm_cvtss_f32(_mm_add_ss(pairSums, _mm_movehl_ps(swapped, pairSums)));
+        }
+#else
+        glm::vec4 v;
+
+        static Float4 zero() { return { glm::vec4 { 0.0f } }; }
+        static Float4 splat(float f) { return { glm::vec4 { f } }; }
+        static Float4 load(const glm::vec4& value) { return { value }; }
+        static Float4 loadKey(const glm::u16vec4& key) { return { glm::vec4 { key } }; }
+
+        void store(glm::vec4& out) const { out = v; }
+
+        Float4 operator+(const Float4& other) const { return { v + other.v }; }
+        Float4 operator-(const Float4& other) const { return { v - other.v }; }
+        Float4 operator*(const Float4& other) const { return { v * other.v }; }
+
+        float dot(const Float4& other) const { return glm::dot(v, other.v); }
+#endif
+    };
+
+    /// Layer after wrapping its time and normalizing its weight. Keeps pointers to the data of the animation to avoid fetching them for each track
+    struct PreparedLayer {
+        const glm::u16vec4* pKeys = nullptr;
+        const std::uint16_t* pKeyframeIndices = nullptr;
+        const float* pTimestamps = nullptr;
+        float time = 0.0f;
+        std::uint32_t keyframe = 0;
+        float weight = 0.0f;
+    };
+
+    static float wrapTime(double time, float duration) {
+        if(duration <= 0.0f) {
+            return 0.0f;
+        }
+        double wrapped = std::fmod(time, static_cast<double>(duration));
+        if(wrapped < 0.0) {
+            wrapped += duration;
+        }
+        return static_cast<float>(wrapped);
+    }
+
+    /// Decoded and interpolated value of the track at the time of the layer. Rotations are not normalized
+    static Float4 sampleTrack(const PreparedLayer& layer, const CompressedAnimation::Track& track) {
+        const glm::u16vec4* pKeys = layer.pKeys;
+        const Float4 scale = Float4::load(track.extent) * Float4::splat(1.0f / 65535.0f);
+        const Float4 min = Float4::load(track.min);
+
+        // last key at or before the current keyframe. The first key of a track is always at keyframe 0.
+        // Branchless binary search: tracks are short, and which half is taken is unpredictable
+        const std::uint16_t* pIndices = layer.pKeyframeIndices + track.firstKey;
+        const std::uint16_t* pPrevious = pIndices;
+        std::size_t remaining = track.keyCount;
+        while(remaining > 1) {
+            const std::size_t half = remaining / 2;
+            pPrevious = pPrevious[half] <= layer.keyframe ? pPrevious + half : pPrevious;
+            remaining -= half;
+        }
+
+        const std::size_t previousKey = track.firstKey + (pPrevious - pIndices);
+        if(previousKey + 1 == track.firstKey + track.keyCount) { // after the last key (includes constant tracks)
+            return min + Float4::loadKey(pKeys[previousKey]) * scale;
+        }
+
+        const std::size_t nextKey = previousKey + 1;
+        const float previousTime = layer.pTimestamps[pPrevious[0]];
+        const float timeBetweenKeys = layer.pTimestamps[pPrevious[1]] - previousTime;
+        const float alpha = timeBetweenKeys > 0.0f ? std::clamp((layer.time - previousTime) / timeBetweenKeys, 0.0f, 1.0f) : 0.0f;
+
+        // interpolation is linear, so keys can be interpolated before being dequantized
+        const Float4 previous = Float4::loadKey(pKeys[previousKey]);
+        const Float4 next = Float4::loadKey(pKeys[nextKey]);
+        return min + (previous + (next - previous) * Float4::splat(alpha)) * scale;
+    }
+
+    /// Accumulates the weighted translation, rotation and scale of each bone over all layers inside 'accumulators' (3 per bone)
+    static void accumulateLayers(std::span<const AnimationLayer> layers, std::span<glm::vec4> accumulators) {
+        float totalWeight = 0.0f;
+        for(const AnimationLayer& layer : layers) {
+            verify(layer.pAnimation != nullptr, "Layer without an animation");
+            totalWeight += std::max(0.0f, layer.weight);
+        }
+        verify(totalWeight > 0.0f, "Cannot blend layers which all have a weight of 0");
+
+        const std::size_t boneCount = accumulators.size() / 3;
+        bool firstLayer = true;
+        for(const AnimationLayer& layer : layers) {
+            if(layer.weight <= 0.0f) {
+                continue;
+            }
+            verify(layer.pAnimation->getBoneCount() == boneCount, "All blended animations must have the same bone count as the output");
+
+            PreparedLayer prepared {
+                .pKeys = layer.pAnimation->getKeys().data(),
+                .pKeyframeIndices = layer.pAnimation->getKeyframeIndices().data(),
+                .pTimestamps = layer.pAnimation->getKeyframeTimestamps().data(),
+                .time = wrapTime(layer.time, layer.pAnimation->getDuration()),
+                .weight = layer.weight / totalWeight,
+            };
+            prepared.keyframe = layer.pAnimation->findKeyframe(prepared.time);
+
+            const Float4 weight = Float4::splat(prepared.weight);
+            const Float4 negatedWeight = Float4::splat(-prepared.weight);
+            const std::span<const CompressedAnimation::BoneTracks> tracks = layer.pAnimation->getTracks();
+            for(std::size_t boneIndex = 0; boneIndex < boneCount; boneIndex++) {
+                const CompressedAnimation::BoneTracks& boneTracks = tracks[boneIndex];
+                glm::vec4* pAccumulators = &accumulators[boneIndex * 3];
+
+                const Float4 translation = sampleTrack(prepared, boneTracks.translation) * weight;
+                const Float4 rotation = sampleTrack(prepared, boneTracks.rotation);
+                const Float4 scale = sampleTrack(prepared, boneTracks.scale) * weight;
+                if(firstLayer) {
+                    translation.store(pAccumulators[0]);
+                    (rotation * weight).store(pAccumulators[1]);
+                    scale.store(pAccumulators[2]);
+                } else {
+                    const Float4 accumulatedRotation = Float4::load(pAccumulators[1]);
+                    // q and -q are the same rotation: blend along the shortest path
+                    const Float4& rotationWeight = rotation.dot(accumulatedRotation) < 0.0f ? negatedWeight : weight;
+
+                    (Float4::load(pAccumulators[0]) + translation).store(pAccumulators[0]);
+                    (accumulatedRotation + rotation * rotationWeight).store(pAccumulators[1]);
+                    (Float4::load(pAccumulators[2]) + scale).store(pAccumulators[2]);
+                }
+            }
+            firstLayer = false;
+        }
+    }
+
+    static glm::quat toNormalizedQuat(const glm::vec4& xyzw) {
+        const float length = glm::length(xyzw);
+        if(length <= 0.0f) {
+            return glm::identity<glm::quat>();
+        }
+        const glm::vec4 normalized = xyzw / length;
+        return glm::quat { normalized.w, normalized.x, normalized.y, normalized.z };
+    }
+
+    /// Reused between calls to avoid allocating for each sampled instance
+    static std::span<glm::vec4> getAccumulators(std::size_t boneCount) {
+        thread_local std::vector<glm::vec4> accumulators;
+        if(accumulators.size() < boneCount * 3) {
+            accumulators.resize(boneCount * 3);
+        }
+        return std::span { accumulators.data(), boneCount * 3 };
+    }
+
+    void sample(const CompressedAnimation& animation, double time, std::span<BonePose> out) {
+        const AnimationLayer layer {
+            .pAnimation = &animation,
+            .time = time,
+            .weight = 1.0f,
+        };
+        sampleBlended(std::span { &layer, 1 }, out);
+    }
+
+    void sampleBlended(std::span<const AnimationLayer> layers, std::span<BonePose> out) {
+        const std::span<glm::vec4> accumulators = getAccumulators(out.size());
+        accumulateLayers(layers, accumulators);
+        for(std::size_t boneIndex = 0; boneIndex < out.size(); boneIndex++) {
+            out[boneIndex].translation = glm::vec3 { accumulators[boneIndex * 3 + 0] };
+            out[boneIndex].rotation = toNormalizedQuat(accumulators[boneIndex * 3 + 1]);
+            out[boneIndex].scale = glm::vec3 { accumulators[boneIndex * 3 + 2] };
+        }
+    }
+
+    void computeSkinningPalette(std::span<const AnimationLayer> layers, std::span<glm::mat4> palette) {
+        const std::span<glm::vec4> accumulators = getAccumulators(palette.size());
+        accumulateLayers(layers, accumulators);
+        for(std::size_t boneIndex = 0; boneIndex < palette.size(); boneIndex++) {
+            const glm::vec4& translation = accumulators[boneIndex * 3 + 0];
+            const glm::mat3 rotation = glm::mat3_cast(toNormalizedQuat(accumulators[boneIndex * 3 + 1]));
+            const glm::vec4& scale = accumulators[boneIndex * 3 + 2];
+
+            glm::mat4& transform = palette[boneIndex];
+            transform[0] = glm::vec4 { rotation[0] * scale.x, 0.0f };
+            transform[1] = glm::vec4 { rotation[1] * scale.y, 0.0f };
+            transform[2] = glm::vec4 { rotation[2] * scale.z, 0.0f };
+            transform[3] = glm::vec4 { glm::vec3 { translation }, 1.0f };
+        }
+    }
+}
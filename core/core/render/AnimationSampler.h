@@ -0,0 +1,37 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <core/render/AnimationCompression.h>
+
+namespace Carrot {
+    /// One animation contributing to a blended pose
+    struct AnimationLayer {
+        const CompressedAnimation* pAnimation = nullptr;
+
+        /// Animations loop: time is wrapped to the duration of the animation, like the GPU skinning does
+        double time = 0.0;
+
+        /// Weights do not need to sum to 1, they are normalized when blending
+        float weight = 1.0f;
+    };
+
+    /**
+     * CPU sampling of compressed animations. Uses SSE when available: each translation, rotation and scale is decoded, interpolated and blended
+     * as a single 4-wide vector.
+     * Functions are thread-safe, and expected to be called in parallel for different instances (see AnimatedInstances::computeSkinningPalettes).
+     */
+    namespace AnimationSampler {
+        /// Samples a single animation. 'out' must have as many elements as the animation has bones
+        void sample(const CompressedAnimation& animation, double time, std::span<BonePose> out);
+
+        /// Blends the poses of all layers. Translations and scales are blended linearly, rotations are normalized after blending (nlerp).
+        /// All animations must have the same bone count, and 'out' must have as many elements
+        void sampleBlended(std::span<const AnimationLayer> layers, std::span<BonePose> out);
+
+        /// Same as sampleBlended, but writes the transform of each bone, ready to be used for skinning
+        void computeSkinningPalette(std::span<const AnimationLayer> layers, std::span<glm::mat4> palette);
+    }
+}
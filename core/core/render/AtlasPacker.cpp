@@ -0,0 +1,56 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "AtlasPacker.h"
+
+namespace Carrot::Render {
+    AtlasPacker::AtlasPacker(std::uint32_t width, std::uint32_t height, std::uint32_t padding): width(width), height(height), padding(padding) {}
+
+    std::optional<glm::uvec2> AtlasPacker::allocate(std::uint32_t w, std::uint32_t h) {
+        const std::uint32_t paddedWidth = w + padding * 2;
+        const std::uint32_t paddedHeight = h + padding * 2;
+        if(w == 0 || h == 0 || paddedWidth > width || paddedHeight > height) {
+            return {};
+        }
+
+        // best fit: the shelf with the smallest height that can contain the rectangle, without wasting too much space
+        Shelf* bestShelf = nullptr;
+        for(Shelf& shelf : shelves) {
+            if(shelf.height < paddedHeight || shelf.height > paddedHeight + paddedHeight / 2) {
+                continue;
+            }
+            if(shelf.cursorX + paddedWidth > width) {
+                continue;
+            }
+            if(bestShelf == nullptr || shelf.height < bestShelf->height) {
+                bestShelf = &shelf;
+            }
+        }
+
+        if(bestShelf == nullptr) {
+            if(nextShelfY + paddedHeight > height) {
+                return {};
+            }
+            bestShelf = &shelves.emplace_back(Shelf {
+                .y = nextShelfY,
+                .height = paddedHeight,
+                .cursorX = 0,
+            });
+            nextShelfY += paddedHeight;
+        }
+
+        const glm::uvec2 result { bestShelf->cursorX + padding, bestShelf->y + padding };
+        bestShelf->cursorX += paddedWidth;
+        allocationCount++;
+        usedArea += static_cast<std::uint64_t>(paddedWidth) * paddedHeight;
+        return result;
+    }
+
+    void AtlasPacker::clear() {
+        shelves.clear();
+        nextShelfY = 0;
+        allocationCount = 0;
+        usedArea = 0;
+    }
+}
@@ -0,0 +1,61 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Carrot::Render {
+    /**
+     * \brief Packs rectangles inside a fixed-size area, in rows ("shelves"), with the same strategy as GlyphAtlas.
+     * The area never grows: when allocate fails, users are expected to start a new page.
+     * Rectangles can never be freed individually, only the entire area can be cleared.
+     *
+     * Only computes placements, does not store any pixel. Not thread-safe.
+     */
+    class AtlasPacker {
+    public:
+        /**
+         * \param width width of the area
+         * \param height height of the area
+         * \param padding space kept free around each rectangle, to avoid bleeding when sampling with bilinear filtering
+         */
+        explicit AtlasPacker(std::uint32_t width, std::uint32_t height, std::uint32_t padding = 1);
+
+        /// Finds a free spot for a w*h rectangle. Returns the top-left corner of the spot (padding excluded), or nothing if there is not enough space left
+        std::optional<glm::uvec2> allocate(std::uint32_t w, std::uint32_t h);
+
+        /// Forgets all allocated rectangles
+        void clear();
+
+    public:
+        std::uint32_t getWidth() const { return width; }
+        std::uint32_t getHeight() const { return height; }
+        std::uint32_t getPadding() const { return padding; }
+
+        /// Number of rectangles allocated since the creation of this packer, or the last call to clear
+        std::size_t getAllocationCount() const { return allocationCount; }
+
+        /// Area covered by allocated rectangles, padding included
+        std::uint64_t getUsedArea() const { return usedArea; }
+
+    private:
+        struct Shelf {
+            std::uint32_t y = 0;
+            std::uint32_t height = 0;
+            std::uint32_t cursorX = 0;
+        };
+
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        std::uint32_t padding = 0;
+        std::vector<Shelf> shelves;
+        std::uint32_t nextShelfY = 0;
+        std::size_t allocationCount = 0;
+        std::uint64_t usedArea = 0;
+    };
+}
@@ -0,0 +1,274 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "TextureResidency.h"
+
+#include <core/utils/Assert.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Carrot::Render {
+    std::uint32_t computeRequiredMip(std::uint32_t textureWidth, std::uint32_t textureHeight, float screenSizeInPixels, std::uint32_t mipCount) {
+        verify(mipCount > 0, "Texture must have at least one mip");
+        const std::uint32_t coarsestMip = mipCount - 1;
+        if(screenSizeInPixels <= 0.0f) {
+            return coarsestMip;
+        }
+
+        // one texel per pixel is enough, finer mips would be minified anyway
+        const float texelsPerPixel = static_cast<float>(std::max(textureWidth, textureHeight)) / screenSizeInPixels;
+        if(texelsPerPixel <= 1.0f) {
+            return 0;
+        }
+        const float mip = std::floor(std::log2(texelsPerPixel));
+        if(mip >= static_cast<float>(coarsestMip)) {
+            return coarsestMip;
+        }
+        return static_cast<std::uint32_t>(mip);
+    }
+
+    std::uint32_t computeMipTail(std::uint32_t textureWidth, std::uint32_t textureHeight, std::uint32_t tailSize, std::uint32_t mipCount) {
+        verify(mipCount > 0, "Texture must have at least one mip");
+        std::uint32_t mip = 0;
+        while(mip < mipCount - 1 && std::max(textureWidth >> mip, textureHeight >> mip) > tailSize) {
+            mip++;
+        }
+        return mip;
+    }
+
+    std::uint64_t TextureResidency::Texture::bytesFrom(std::uint32_t mip) const {
+        std::uint64_t total = 0;
+        for(std::size_t i = mip; i < mipSizes.size(); i++) {
+            total += mipSizes[i];
+        }
+        return total;
+    }
+
+    std::uint64_t TextureResidency::Texture::residentBytes() const {
+        if(streaming) {
+            // both the old and new images can be in memory, count the larger one
+            return bytesFrom(std::min(residentMip, streamingTarget));
+        }
+        return bytesFrom(residentMip);
+    }
+
+    std::int64_t TextureResidency::priority(const Texture& texture, std::uint32_t mip) {
+        return static_cast<std::int64_t>(mip) - static_cast<std::int64_t>(texture.wantedMip) + 1;
+    }
+
+    TextureResidency::TextureID TextureResidency::registerTexture(std::span<const std::uint64_t> mipSizes, std::uint32_t tailMip) {
+        verify(!mipSizes.empty(), "Texture must have at least one mip");
+        verify(tailMip < mipSizes.size(), "Mip tail is outside of the mip chain");
+        Async::LockGuard l { access };
+        const TextureID id = nextID++;
+        Texture& texture = textures[id];
+        texture.mipSizes = { mipSizes.begin(), mipSizes.end() };
+        texture.tailMip = tailMip;
+        texture.residentMip = tailMip;
+        texture.wantedMip = tailMip;
+        texture.lastRequestFrame = currentFrame;
+        return id;
+    }
+
+    void TextureResidency::unregisterTexture(TextureID texture) {
+        Async::LockGuard l { access };
+        textures.erase(texture);
+    }
+
+    void TextureResidency::requestMip(TextureID id, std::uint32_t mip) {
+        Async::LockGuard l { access };
+        auto it = textures.find(id);
+        if(it == textures.end()) {
+            return;
+        }
+        it->second.requestedMipThisFrame = std::min(it->second.requestedMipThisFrame, mip);
+    }
+
+    void TextureResidency::nextFrame() {
+        Async::LockGuard l { access };
+        for(auto& [id, texture] : textures) {
+            if(texture.requestedMipThisFrame != std::numeric_limits<std::uint32_t>::max()) {
+                texture.wantedMip = std::min(texture.requestedMipThisFrame, texture.tailMip);
+                texture.lastRequestFrame = currentFrame;
+            } else if(currentFrame - texture.lastRequestFrame > RequestLifetime) {
+                texture.wantedMip = texture.tailMip;
+            }
+            texture.requestedMipThisFrame = std::numeric_limits<std::uint32_t>::max();
+        }
+        currentFrame++;
+    }
+
+    std::vector<TextureResidency::StreamingRequest> TextureResidency::plan(std::uint64_t budget, std::size_t maxRequests) {
+        Async::LockGuard l { access };
+        std::vector<StreamingRequest> requests;
+
+        // sorted to get the same plan for the same state, whatever the map order is
+        std::vector<std::pair<TextureID, Texture*>> sortedTextures;
+        sortedTextures.reserve(textures.size());
+        std::uint64_t committedBytes = 0;
+        for(auto& [id, texture] : textures) {
+            sortedTextures.emplace_back(id, &texture);
+            committedBytes += texture.residentBytes();
+        }
+        std::sort(sortedTextures.begin(), sortedTextures.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+
+        auto issue = [&](TextureID id, Texture& texture, std::uint32_t targetMip) {
+            texture.streaming = true;
+            texture.streamingTarget = targetMip;
+            requests.push_back(StreamingRequest { .texture = id, .targetMip = targetMip });
+        };
+
+        // 1. stream out mips that are not wanted anymore
+        for(auto& [id, pTexture] : sortedTextures) {
+            if(requests.size() >= maxRequests) {
+                return requests;
+            }
+            if(!pTexture->streaming && pTexture->residentMip < pTexture->wantedMip) {
+                issue(id, *pTexture, pTexture->wantedMip);
+            }
+        }
+
+        // least important resident mips first
+        std::vector<std::pair<TextureID, Texture*>> victims;
+        for(auto& [id, pTexture] : sortedTextures) {
+            if(!pTexture->streaming && pTexture->residentMip < pTexture->tailMip) {
+                victims.emplace_back(id, pTexture);
+            }
+        }
+        std::stable_sort(victims.begin(), victims.end(), [](const auto& a, const auto& b) {
+            return priority(*a.second, a.second->residentMip) < priority(*b.second, b.second->residentMip);
+        });
+        std::size_t nextVictim = 0;
+        std::uint64_t pendingFreedBytes = 0; // memory that will be freed once evictions are done
+
+        auto evictNext = [&](std::int64_t maxPriority) {
+            while(nextVictim < victims.size()) {
+                auto& [id, pVictim] = victims[nextVictim];
+                if(pVictim->streaming) {
+                    nextVictim++;
+                    continue;
+                }
+                if(priority(*pVictim, pVictim->residentMip) >= maxPriority) {
+                    return false;
+                }
+                pendingFreedBytes += pVictim->mipSizes[pVictim->residentMip];
+                issue(id, *pVictim, pVictim->residentMip + 1);
+                nextVictim++;
+                return true;
+            }
+            return false;
+        };
+
+        // 2. budget was lowered: evict until resident memory fits again
+        while(committedBytes - pendingFreedBytes > budget && requests.size() < maxRequests) {
+            if(!evictNext(std::numeric_limits<std::int64_t>::max())) {
+                break;
+            }
+        }
+
+        // 3. stream in the next mip of textures that need it, most visible deficit first
+        std::vector<std::pair<TextureID, Texture*>> candidates;
+        for(auto& [id, pTexture] : sortedTextures) {
+            if(!pTexture->streaming && pTexture->residentMip > pTexture->wantedMip) {
+                candidates.emplace_back(id, pTexture);
+            }
+        }
+        std::stable_sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+            return priority(*a.second, a.second->residentMip - 1) > priority(*b.second, b.second->residentMip - 1);
+        });
+
+        for(auto& [id, pTexture] : candidates) {
+            if(requests.size() >= maxRequests) {
+                break;
+            }
+            if(pTexture->streaming) { // chosen as a victim
+                continue;
+            }
+
+            const std::uint32_t nextMip = pTexture->residentMip - 1;
+            const std::uint64_t cost = pTexture->mipSizes[nextMip];
+            if(committedBytes + cost <= budget) {
+                committedBytes += cost;
+                issue(id, *pTexture, nextMip);
+                continue;
+            }
+
+            // make room for a future plan, the memory of evicted mips is only available once their streaming is done
+            const std::int64_t candidatePriority = priority(*pTexture, nextMip);
+            while(committedBytes + cost - pendingFreedBytes > budget && requests.size() < maxRequests) {
+                if(!evictNext(candidatePriority)) {
+                    break;
+                }
+            }
+        }
+
+        return requests;
+    }
+
+    void TextureResidency::onStreamingDone(const StreamingRequest& request) {
+        Async::LockGuard l { access };
+        auto it = textures.find(request.texture);
+        if(it == textures.end()) {
+            return;
+        }
+        verify(it->second.streaming, "Texture was not streaming");
+        it->second.residentMip = request.targetMip;
+        it->second.streaming = false;
+    }
+
+    void TextureResidency::onStreamingCancelled(const StreamingRequest& request) {
+        Async::LockGuard l { access };
+        auto it = textures.find(request.texture);
+        if(it == textures.end()) {
+            return;
+        }
+        it->second.streaming = false;
+    }
+
+    std::uint64_t TextureResidency::getResidentBytes() const {
+        Async::LockGuard l { access };
+        std::uint64_t total = 0;
+        for(const auto& [id, texture] : textures) {
+            total += texture.residentBytes();
+        }
+        return total;
+    }
+
+    std::uint64_t TextureResidency::getFullyResidentBytes() const {
+        Async::LockGuard l { access };
+        std::uint64_t total = 0;
+        for(const auto& [id, texture] : textures) {
+            total += texture.bytesFrom(0);
+        }
+        return total;
+    }
+
+    TextureResidency::TextureInfo TextureResidency::getTextureInfo(TextureID id) const {
+        Async::LockGuard l { access };
+        auto it = textures.find(id);
+        verify(it != textures.end(), "Unknown texture");
+        const Texture& texture = it->second;
+        return TextureInfo {
+            .mipCount = static_cast<std::uint32_t>(texture.mipSizes.size()),
+            .tailMip = texture.tailMip,
+            .residentMip = texture.residentMip,
+            .wantedMip = texture.wantedMip,
+            .streaming = texture.streaming,
+            .residentBytes = texture.residentBytes(),
+        };
+    }
+
+    std::vector<TextureResidency::TextureID> TextureResidency::getTextures() const {
+        Async::LockGuard l { access };
+        std::vector<TextureID> result;
+        result.reserve(textures.size());
+        for(const auto& [id, texture] : textures) {
+            result.push_back(id);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+}
@@ -0,0 +1,107 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <core/async/Locks.h>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace Carrot::Render {
+    /// Finest mip level worth sampling for a texture of 'textureWidth'x'textureHeight' texels, covering 'screenSizeInPixels' pixels
+    /// along its largest axis. Result is clamped to [0; mipCount-1]
+    std::uint32_t computeRequiredMip(std::uint32_t textureWidth, std::uint32_t textureHeight, float screenSizeInPixels, std::uint32_t mipCount);
+
+    /// Coarsest mip level whose size is larger than 'tailSize' on any axis, plus one: mips at this level or coarser are the mip tail,
+    /// which is always resident. Result is clamped to [0; mipCount-1]
+    std::uint32_t computeMipTail(std::uint32_t textureWidth, std::uint32_t textureHeight, std::uint32_t tailSize, std::uint32_t mipCount);
+
+    /// Decides which mips of streamed textures should be resident, based on what was requested during the last frames, and on a memory budget.
+    /// Mip 0 is the finest mip. A texture always has its mips [residentMip; mipCount-1] resident: streaming a mip in or out means changing residentMip.
+    /// This class does not load anything: it outputs requests that the caller executes, and the caller reports when they are done.
+    class TextureResidency {
+    public:
+        using TextureID = std::uint32_t;
+
+        /// Change of resident mips for a texture
+        struct StreamingRequest {
+            TextureID texture = 0;
+            std::uint32_t targetMip = 0; // new value for residentMip
+        };
+
+        struct TextureInfo {
+            std::uint32_t mipCount = 0;
+            std::uint32_t tailMip = 0;
+            std::uint32_t residentMip = 0;
+            std::uint32_t wantedMip = 0;
+            bool streaming = false; // a request was issued, but not completed yet
+            std::uint64_t residentBytes = 0;
+        };
+
+        /// How many frames a texture keeps its wanted mip without being requested again. Avoids streaming out textures which
+        /// are just out of view for a few frames
+        constexpr static std::uint64_t RequestLifetime = 60;
+
+        /// Registers a new texture, whose mip tail (mips [tailMip; mipCount-1]) is already resident.
+        /// 'mipSizes' is the memory size of each mip.
+        TextureID registerTexture(std::span<const std::uint64_t> mipSizes, std::uint32_t tailMip);
+        void unregisterTexture(TextureID texture);
+
+        /// The texture was drawn this frame, and needs at least 'mip'. Thread-safe
+        void requestMip(TextureID texture, std::uint32_t mip);
+
+        /// Updates wanted mips with requests of the frame that just ended, and starts a new frame
+        void nextFrame();
+
+        /// Computes which streaming requests should be executed to get closer to the wanted mips, while keeping resident memory below 'budget'.
+        /// Finer mips are streamed in one by one, so that coarse mips of all textures arrive first. If needed, mips that are less important
+        /// than the one being streamed in are streamed out to make room.
+        /// At most 'maxRequests' requests are returned, and textures inside the returned requests are marked as streaming.
+        std::vector<StreamingRequest> plan(std::uint64_t budget, std::size_t maxRequests);
+
+        /// A request returned by 'plan' was executed
+        void onStreamingDone(const StreamingRequest& request);
+
+        /// A request returned by 'plan' could not be executed (texture failed to load, etc.)
+        void onStreamingCancelled(const StreamingRequest& request);
+
+        /// Memory used by resident mips. Streaming textures count the larger of their old and new mip chains
+        std::uint64_t getResidentBytes() const;
+
+        /// Memory that all mips of all textures would use
+        std::uint64_t getFullyResidentBytes() const;
+
+        TextureInfo getTextureInfo(TextureID texture) const;
+        std::vector<TextureID> getTextures() const;
+
+    private:
+        struct Texture {
+            std::vector<std::uint64_t> mipSizes;
+            std::uint32_t tailMip = 0;
+            std::uint32_t residentMip = 0;
+            std::uint32_t wantedMip = 0;
+            std::uint32_t requestedMipThisFrame = std::numeric_limits<std::uint32_t>::max();
+            std::uint64_t lastRequestFrame = 0;
+            std::uint32_t streamingTarget = 0;
+            bool streaming = false;
+
+            /// memory used by mips [mip; mipCount-1]
+            std::uint64_t bytesFrom(std::uint32_t mip) const;
+
+            /// memory currently used by this texture
+            std::uint64_t residentBytes() const;
+        };
+
+        /// Importance of keeping 'mip' resident for 'texture': the coarser the mip compared to the wanted mip, the more visible its absence
+        static std::int64_t priority(const Texture& texture, std::uint32_t mip);
+
+        mutable Async::SpinLock access;
+        std::unordered_map<TextureID, Texture> textures;
+        TextureID nextID = 0;
+        std::uint64_t currentFrame = 0;
+    };
+}
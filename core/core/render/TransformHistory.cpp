@@ -0,0 +1,87 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "TransformHistory.h"
+
+#include <core/utils/Assert.h>
+#include <cstring>
+
+namespace Carrot::Render {
+    AffineTransform AffineTransform::fromMatrix(const glm::mat4& matrix) {
+        AffineTransform result;
+        for(int row = 0; row < 3; row++) {
+            result.rows[row] = glm::vec4 { matrix[0][row], matrix[1][row], matrix[2][row], matrix[3][row] };
+        }
+        return result;
+    }
+
+    glm::mat4 AffineTransform::toMatrix() const {
+        return glm::transpose(glm::mat4 { rows[0], rows[1], rows[2], glm::vec4 { 0, 0, 0, 1 } });
+    }
+
+    TransformHistory::TransformHistory(std::size_t bufferCount) {
+        setBufferCount(bufferCount);
+    }
+
+    TransformHistory::Slot TransformHistory::allocateSlot() {
+        Async::LockGuard l { slotsAccess };
+        if(!freeSlots.empty()) {
+            // the shadows still match what the buffers contain for this slot, nothing to reset
+            const Slot slot = freeSlots.back();
+            freeSlots.pop_back();
+            return slot;
+        }
+
+        verify(slotCount != InvalidSlot, "Too many slots");
+        return slotCount++;
+    }
+
+    void TransformHistory::freeSlot(Slot slot) {
+        Async::LockGuard l { slotsAccess };
+        verify(slot < slotCount, "Invalid slot");
+        freeSlots.push_back(slot);
+    }
+
+    std::size_t TransformHistory::getRequiredCapacity() const {
+        Async::LockGuard l { slotsAccess };
+        return slotCount;
+    }
+
+    void TransformHistory::setBufferCount(std::size_t bufferCount) {
+        shadows.clear();
+        shadows.resize(bufferCount);
+    }
+
+    void TransformHistory::resetBuffer(std::size_t bufferIndex, std::size_t capacity) {
+        verify(bufferIndex < shadows.size(), "Invalid buffer index");
+        BufferShadow& shadow = shadows[bufferIndex];
+        shadow.transforms.resize(capacity);
+        shadow.valid.clear();
+        shadow.valid.resize(capacity, 0);
+    }
+
+    bool TransformHistory::submit(std::size_t bufferIndex, std::span<AffineTransform> buffer, Slot slot, const glm::mat4& previousTransform) {
+        verify(bufferIndex < shadows.size(), "Invalid buffer index");
+        BufferShadow& shadow = shadows[bufferIndex];
+        if(slot >= shadow.transforms.size()) {
+            return false;
+        }
+        verify(buffer.size() >= shadow.transforms.size(), "Buffer is smaller than the capacity given to resetBuffer");
+
+        const AffineTransform transform = AffineTransform::fromMatrix(previousTransform);
+        if(shadow.valid[slot] && std::memcmp(&shadow.transforms[slot], &transform, sizeof(AffineTransform)) == 0) {
+            return true; // already up-to-date
+        }
+
+        buffer[slot] = transform;
+        shadow.transforms[slot] = transform;
+        shadow.valid[slot] = 1;
+        writtenBytes.fetch_add(sizeof(AffineTransform), std::memory_order_relaxed);
+        return true;
+    }
+
+    std::size_t TransformHistory::resetWrittenBytes() {
+        return writtenBytes.exchange(0);
+    }
+}
@@ -0,0 +1,77 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <core/async/Locks.h>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace Carrot::Render {
+    /// 3x4 affine transform: the first 3 rows of a mat4, the last row is implicitly (0,0,0,1).
+    /// Shaders read it as 3 vec4s.
+    struct AffineTransform {
+        glm::vec4 rows[3] { glm::vec4{1,0,0,0}, glm::vec4{0,1,0,0}, glm::vec4{0,0,1,0} };
+
+        static AffineTransform fromMatrix(const glm::mat4& matrix);
+        glm::mat4 toMatrix() const;
+
+        bool operator==(const AffineTransform& other) const = default;
+    };
+    static_assert(sizeof(AffineTransform) == 48, "Shaders expect affine transforms to be 3 vec4s");
+
+    /// Keeps track of the previous-frame transform of persistent instances, so that instance data does not need to contain it.
+    /// Each instance gets a slot, and shaders read the previous transform from a buffer indexed by this slot.
+    /// There is one such buffer per frame in flight, and a slot of a buffer is only written when its content is outdated:
+    /// a static instance does not upload anything once all buffers have seen its transform.
+    class TransformHistory {
+    public:
+        using Slot = std::uint32_t;
+        constexpr static Slot InvalidSlot = std::numeric_limits<Slot>::max();
+
+        explicit TransformHistory(std::size_t bufferCount);
+
+        /// Gets a slot for a new instance. Slots of freed instances are reused. Thread-safe
+        Slot allocateSlot();
+        void freeSlot(Slot slot);
+
+        /// Number of elements a buffer needs to be indexable by all slots allocated so far. Thread-safe
+        std::size_t getRequiredCapacity() const;
+
+        /// Changes the number of buffers, all buffers have a capacity of 0 until 'resetBuffer' is called
+        void setBufferCount(std::size_t bufferCount);
+
+        /// The buffer at 'bufferIndex' was (re)created with room for 'capacity' transforms. Its content is unknown and
+        /// everything will be written again. Must not be called while 'submit' is called for the same buffer.
+        void resetBuffer(std::size_t bufferIndex, std::size_t capacity);
+
+        /// Sets the transform that 'slot' had during the previous frame, and writes it inside 'buffer' if 'buffer' does not already contain it.
+        /// 'buffer' must be the buffer for 'bufferIndex'.
+        /// Returns false if the slot is outside of the buffer (ie the slot was allocated after the buffer was created):
+        /// nothing is written, and the caller should not reference the slot this frame.
+        /// Does not lock: can be called from multiple threads at once, as long as each thread uses different slots.
+        bool submit(std::size_t bufferIndex, std::span<AffineTransform> buffer, Slot slot, const glm::mat4& previousTransform);
+
+        /// Bytes written to buffers by 'submit' since the last call to this method
+        std::size_t resetWrittenBytes();
+
+    private:
+        /// CPU copy of a buffer, to know which slots are outdated without reading from GPU memory
+        struct BufferShadow {
+            std::vector<AffineTransform> transforms;
+            std::vector<std::uint8_t> valid; // 0 if the content of the buffer is unknown for this slot
+        };
+
+        mutable Async::SpinLock slotsAccess;
+        Slot slotCount = 0;
+        std::vector<Slot> freeSlots;
+
+        std::vector<BufferShadow> shadows;
+        std::atomic<std::size_t> writtenBytes{0};
+    };
+}
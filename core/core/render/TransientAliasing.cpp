@@ -0,0 +1,148 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "TransientAliasing.h"
+
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <core/utils/Assert.h>
+
+namespace Carrot::Render {
+    TransientGroup::TransientGroup(ReleaseCallback release): releaseCallback(std::move(release)) {}
+
+    TransientGroup::TransientGroup(TransientGroup&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    TransientGroup::~TransientGroup() {
+        release();
+    }
+
+    TransientGroup& TransientGroup::operator=(TransientGroup&& other) noexcept {
+        if(this == &other) {
+            return *this;
+        }
+        release();
+        id = other.id;
+        releaseCallback = std::move(other.releaseCallback);
+        other.releaseCallback = nullptr;
+        return *this;
+    }
+
+    const Carrot::UUID& TransientGroup::getID() const {
+        return id;
+    }
+
+    void TransientGroup::release() {
+        if(releaseCallback) {
+            ReleaseCallback callback = std::move(releaseCallback);
+            releaseCallback = nullptr;
+            callback(id);
+        }
+    }
+
+    static bool lifetimesOverlap(const TransientResource& a, const TransientResource& b) {
+        return a.firstPass <= b.lastPass && b.firstPass <= a.lastPass;
+    }
+
+    static bool rangesOverlap(std::uint64_t startA, std::uint64_t sizeA, std::uint64_t startB, std::uint64_t sizeB) {
+        return startA < startB + sizeB && startB < startA + sizeA;
+    }
+
+    static std::uint64_t alignUp(std::uint64_t value, std::uint64_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    TransientHeapLayout packTransientResources(std::span<const TransientResource> resources) {
+        TransientHeapLayout layout;
+        layout.placements.resize(resources.size());
+
+        for(const auto& resource : resources) {
+            verify(resource.firstPass <= resource.lastPass, "Resource dies before being created");
+            verify(resource.alignment > 0 && std::has_single_bit(resource.alignment), "Alignment must be a power of two");
+        }
+
+        // biggest resources first: smaller ones fill the holes left between them
+        std::vector<std::size_t> order(resources.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            return resources[a].size > resources[b].size;
+        });
+
+        // without aliasing: each resource placed after the previous one of the same memory type, with the same alignment rules as the packed heaps
+        std::vector<TransientHeap> unaliasedHeaps;
+        for(std::size_t index : order) {
+            const TransientResource& resource = resources[index];
+            auto heapIt = std::find_if(unaliasedHeaps.begin(), unaliasedHeaps.end(), [&](const TransientHeap& h) { return h.memoryType == resource.memoryType; });
+            if(heapIt == unaliasedHeaps.end()) {
+                heapIt = unaliasedHeaps.insert(heapIt, TransientHeap { .memoryType = resource.memoryType });
+            }
+            heapIt->size = alignUp(heapIt->size, resource.alignment) + resource.size;
+        }
+        for(const auto& heap : unaliasedHeaps) {
+            layout.unaliasedSize += heap.size;
+        }
+
+        std::vector<std::size_t> placed;
+        placed.reserve(resources.size());
+        for(std::size_t index : order) {
+            const TransientResource& resource = resources[index];
+            TransientPlacement& placement = layout.placements[index];
+
+            auto heapIt = std::find_if(layout.heaps.begin(), layout.heaps.end(), [&](const TransientHeap& h) { return h.memoryType == resource.memoryType; });
+            if(heapIt == layout.heaps.end()) {
+                heapIt = layout.heaps.insert(heapIt, TransientHeap { .memoryType = resource.memoryType });
+            }
+            placement.heapIndex = static_cast<std::uint32_t>(heapIt - layout.heaps.begin());
+
+            // resources alive at the same time, in the same heap, sorted by offset
+            std::vector<std::size_t> conflicts;
+            for(std::size_t other : placed) {
+                if(layout.placements[other].heapIndex == placement.heapIndex && lifetimesOverlap(resource, resources[other])) {
+                    conflicts.push_back(other);
+                }
+            }
+            std::sort(conflicts.begin(), conflicts.end(), [&](std::size_t a, std::size_t b) {
+                return layout.placements[a].offset < layout.placements[b].offset;
+            });
+
+            // first fit: try right after each conflicting resource
+            std::uint64_t offset = 0;
+            for(std::size_t other : conflicts) {
+                if(!rangesOverlap(offset, resource.size, layout.placements[other].offset, resources[other].size)) {
+                    if(offset + resource.size <= layout.placements[other].offset) {
+                        break; // fits in the hole before 'other'
+                    }
+                    continue; // 'other' is before the current candidate
+                }
+                offset = alignUp(layout.placements[other].offset + resources[other].size, resource.alignment);
+            }
+            placement.offset = offset;
+            heapIt->size = std::max(heapIt->size, offset + resource.size);
+
+            placed.push_back(index);
+        }
+
+        for(std::size_t index = 0; index < resources.size(); index++) {
+            const TransientResource& resource = resources[index];
+            TransientPlacement& placement = layout.placements[index];
+            for(std::size_t other = 0; other < resources.size(); other++) {
+                const TransientPlacement& otherPlacement = layout.placements[other];
+                if(other == index || otherPlacement.heapIndex != placement.heapIndex) {
+                    continue;
+                }
+                if(resources[other].lastPass < resource.firstPass
+                && rangesOverlap(placement.offset, resource.size, otherPlacement.offset, resources[other].size)) {
+                    placement.aliasedResources.push_back(other);
+                }
+            }
+        }
+
+        for(const auto& heap : layout.heaps) {
+            layout.aliasedSize += heap.size;
+        }
+        return layout;
+    }
+}
@@ -0,0 +1,85 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+#include <core/utils/UUID.h>
+
+namespace Carrot::Render {
+    /// Description of a resource which only needs to be alive between two passes of a render graph
+    struct TransientResource {
+        std::uint64_t size = 0; //< in bytes
+        std::uint64_t alignment = 1; //< must be a power of two
+        std::uint32_t memoryType = 0; //< resources can only share memory with resources of the same memory type
+
+        // Lifetime of the resource: indices of the first and last passes which use it (both inclusive)
+        std::uint32_t firstPass = 0;
+        std::uint32_t lastPass = 0;
+    };
+
+    /// Where a transient resource is placed inside the heaps computed by packTransientResources
+    struct TransientPlacement {
+        std::uint32_t heapIndex = 0;
+        std::uint64_t offset = 0;
+
+        /// Indices of resources which used (part of) the same memory before this resource. Non-empty means the first pass of this resource needs an aliasing barrier
+        std::vector<std::size_t> aliasedResources;
+    };
+
+    struct TransientHeap {
+        std::uint32_t memoryType = 0;
+        std::uint64_t size = 0;
+    };
+
+    struct TransientHeapLayout {
+        std::vector<TransientHeap> heaps;
+        std::vector<TransientPlacement> placements; //< same order as the input resources
+
+        std::uint64_t unaliasedSize = 0; //< how much memory would be needed if resources did not share memory (including alignment padding)
+        std::uint64_t aliasedSize = 0; //< sum of the size of all heaps
+
+        /// How many bytes are saved by aliasing
+        std::uint64_t getSavedBytes() const {
+            return unaliasedSize > aliasedSize ? unaliasedSize - aliasedSize : 0;
+        }
+    };
+
+    /// Ownership of a group of aliased resources: calls 'release' with the ID of the group when destroyed, so that the resources and their memory
+    /// do not outlive their owner (for instance, the render graph which created them). Move-only
+    class TransientGroup {
+    public:
+        using ReleaseCallback = std::function<void(const Carrot::UUID& groupID)>;
+
+        TransientGroup() = default;
+        explicit TransientGroup(ReleaseCallback release);
+        TransientGroup(const TransientGroup&) = delete;
+        TransientGroup(TransientGroup&& other) noexcept;
+        ~TransientGroup();
+
+        TransientGroup& operator=(const TransientGroup&) = delete;
+        TransientGroup& operator=(TransientGroup&& other) noexcept;
+
+        const Carrot::UUID& getID() const;
+
+        /// Releases the resources of the group now. Does nothing if they were already released
+        void release();
+
+    private:
+        Carrot::UUID id;
+        ReleaseCallback releaseCallback;
+    };
+
+    /**
+     * \brief Places transient resources inside as few bytes as possible: resources whose lifetimes do not overlap are allowed to use the same memory.
+     * One heap is created per memory type.
+     *
+     * Greedy packing: resources are placed from the biggest to the smallest, each one at the lowest offset which does not overlap
+     * (in memory) with an already placed resource which is alive at the same time.
+     */
+    TransientHeapLayout packTransientResources(std::span<const TransientResource> resources);
+}
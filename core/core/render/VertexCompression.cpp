@@ -0,0 +1,210 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "VertexCompression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/packing.hpp>
+#include <core/utils/Assert.h>
+
+namespace Carrot {
+    template<typename VertexType>
+    static QuantizationBounds computeBounds(std::span<const VertexType> vertices) {
+        if(vertices.empty()) {
+            return {};
+        }
+        glm::vec3 minPos { vertices[0].pos };
+        glm::vec3 maxPos { vertices[0].pos };
+        for(const auto& vertex : vertices) {
+            minPos = glm::min(minPos, glm::vec3 { vertex.pos });
+            maxPos = glm::max(maxPos, glm::vec3 { vertex.pos });
+        }
+        return QuantizationBounds { .min = minPos, .extent = maxPos - minPos };
+    }
+
+    QuantizationBounds QuantizationBounds::compute(std::span<const Vertex> vertices) {
+        return computeBounds(vertices);
+    }
+
+    QuantizationBounds QuantizationBounds::compute(std::span<const SkinnedVertex> vertices) {
+        return computeBounds(vertices);
+    }
+
+    namespace VertexCompression {
+        constexpr float Unorm16Max = 65535.0f;
+        constexpr float Snorm16Max = 32767.0f;
+        constexpr float Unorm8Max = 255.0f;
+
+        static std::uint16_t quantizeUnorm16(float value) {
+            return static_cast<std::uint16_t>(std::round(std::clamp(value, 0.0f, 1.0f) * Unorm16Max));
+        }
+
+        static std::uint8_t quantizeUnorm8(float value) {
+            return static_cast<std::uint8_t>(std::round(std::clamp(value, 0.0f, 1.0f) * Unorm8Max));
+        }
+
+        static float signNotZero(float v) {
+            return v >= 0.0f ? 1.0f : -1.0f;
+        }
+
+        glm::vec3 getMaxPositionError(const QuantizationBounds& bounds) {
+            return bounds.extent / Unorm16Max * 0.5f;
+        }
+
+        glm::i16vec2 encodeOctahedral(const glm::vec3& direction) {
+            const float l1Norm = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+            if(l1Norm <= 0.0f) {
+                return glm::i16vec2 { 0, static_cast<std::int16_t>(Snorm16Max) }; // arbitrary, decodes to +Z
+            }
+
+            glm::vec2 projected = glm::vec2 { direction.x, direction.y } / l1Norm;
+            if(direction.z < 0.0f) {
+                projected = glm::vec2 {
+                    (1.0f - std::abs(projected.y)) * signNotZero(projected.x),
+                    (1.0f - std::abs(projected.x)) * signNotZero(projected.y),
+                };
+            }
+
+            // rounding to the nearest value is not always the closest direction once decoded: try the 4 neighbours
+            const glm::vec3 normalizedDirection = glm::normalize(direction);
+            const glm::vec2 scaled = glm::clamp(projected, -1.0f, 1.0f) * Snorm16Max;
+            glm::i16vec2 best { 0 };
+            float bestDot = -2.0f;
+            for(int i = 0; i < 4; i++) {
+                const glm::i16vec2 candidate {
+                    static_cast<std::int16_t>((i & 1) ? std::ceil(scaled.x) : std::floor(scaled.x)),
+                    static_cast<std::int16_t>((i & 2) ? std::ceil(scaled.y) : std::floor(scaled.y)),
+                };
+                const float d = glm::dot(decodeOctahedral(candidate), normalizedDirection);
+                if(d > bestDot) {
+                    bestDot = d;
+                    best = candidate;
+                }
+            }
+            return best;
+        }
+
+        glm::vec3 decodeOctahedral(const glm::i16vec2& encoded) {
+            const glm::vec2 f = glm::max(glm::vec2 { encoded } / Snorm16Max, glm::vec2 { -1.0f });
+            glm::vec3 n { f.x, f.y, 1.0f - std::abs(f.x) - std::abs(f.y) };
+            const float t = std::max(-n.z, 0.0f);
+            n.x += n.x >= 0.0f ? -t : t;
+            n.y += n.y >= 0.0f ? -t : t;
+            return glm::normalize(n);
+        }
+
+        glm::u8vec4 encodeBoneWeights(const glm::vec4& weights) {
+            glm::u8vec4 encoded { 0 };
+            int sum = 0;
+            int heaviest = 0;
+            for(int i = 0; i < 4; i++) {
+                encoded[i] = quantizeUnorm8(weights[i]);
+                sum += encoded[i];
+                if(weights[i] > weights[heaviest]) {
+                    heaviest = i;
+                }
+            }
+            if(sum == 0) {
+                return encoded;
+            }
+
+            // give the rounding error to the most influential bone, that way weights still sum to 1
+            const int corrected = std::clamp(encoded[heaviest] + (static_cast<int>(Unorm8Max) - sum), 0, static_cast<int>(Unorm8Max));
+            encoded[heaviest] = static_cast<std::uint8_t>(corrected);
+            return encoded;
+        }
+
+        glm::vec4 decodeBoneWeights(const glm::u8vec4& encoded) {
+            return glm::vec4 { encoded } / Unorm8Max;
+        }
+
+        CompressedVertex compress(const Vertex& vertex, const QuantizationBounds& bounds) {
+            CompressedVertex result;
+            for(int axis = 0; axis < 3; axis++) {
+                const float normalized = bounds.extent[axis] > 0.0f ? (vertex.pos[axis] - bounds.min[axis]) / bounds.extent[axis] : 0.0f;
+                result.position[axis] = quantizeUnorm16(normalized);
+            }
+            result.bitangentSign = vertex.tangent.w < 0.0f ? 1 : 0;
+            result.normal = encodeOctahedral(vertex.normal);
+            result.tangent = encodeOctahedral(glm::vec3 { vertex.tangent });
+            result.uv = glm::u16vec2 { glm::packHalf1x16(vertex.uv.x), glm::packHalf1x16(vertex.uv.y) };
+            result.color = glm::u8vec4 { quantizeUnorm8(vertex.color.r), quantizeUnorm8(vertex.color.g), quantizeUnorm8(vertex.color.b), 255 };
+            return result;
+        }
+
+        Vertex decompress(const CompressedVertex& vertex, const QuantizationBounds& bounds) {
+            Vertex result;
+            result.pos = glm::vec4 { bounds.min + glm::vec3 { vertex.position } / Unorm16Max * bounds.extent, 1.0f };
+            result.color = glm::vec3 { vertex.color } / Unorm8Max;
+            result.normal = decodeOctahedral(vertex.normal);
+            result.tangent = glm::vec4 { decodeOctahedral(vertex.tangent), vertex.bitangentSign != 0 ? -1.0f : 1.0f };
+            result.uv = glm::vec2 { glm::unpackHalf1x16(vertex.uv.x), glm::unpackHalf1x16(vertex.uv.y) };
+            return result;
+        }
+
+        CompressedSkinnedVertex compress(const SkinnedVertex& vertex, const QuantizationBounds& bounds) {
+            CompressedSkinnedVertex result;
+            static_cast<CompressedVertex&>(result) = compress(static_cast<const Vertex&>(vertex), bounds);
+            result.boneWeights = encodeBoneWeights(vertex.boneWeights);
+            for(int i = 0; i < 4; i++) {
+                // unused slots have a weight of 0, the ID does not matter.
+                // Used slots keep the 8 bits of the ID: IDs above 127 are stored as negative values inside SkinnedVertex
+                result.boneIDs[i] = result.boneWeights[i] == 0 ? 0 : static_cast<std::uint8_t>(vertex.boneIDs[i]);
+            }
+            return result;
+        }
+
+        SkinnedVertex decompress(const CompressedSkinnedVertex& vertex, const QuantizationBounds& bounds) {
+            SkinnedVertex result;
+            static_cast<Vertex&>(result) = decompress(static_cast<const CompressedVertex&>(vertex), bounds);
+            result.boneWeights = decodeBoneWeights(vertex.boneWeights);
+            for(int i = 0; i < 4; i++) {
+                result.boneIDs[i] = vertex.boneWeights[i] == 0 ? -1 : static_cast<std::int8_t>(vertex.boneIDs[i]);
+            }
+            return result;
+        }
+
+        void compress(std::span<const Vertex> vertices, const QuantizationBounds& bounds, std::span<CompressedVertex> out) {
+            verify(out.size() >= vertices.size(), "Output is too small");
+            for(std::size_t i = 0; i < vertices.size(); i++) {
+                out[i] = compress(vertices[i], bounds);
+            }
+        }
+
+        void compress(std::span<const SkinnedVertex> vertices, const QuantizationBounds& bounds, std::span<CompressedSkinnedVertex> out) {
+            verify(out.size() >= vertices.size(), "Output is too small");
+            for(std::size_t i = 0; i < vertices.size(); i++) {
+                out[i] = compress(vertices[i], bounds);
+            }
+        }
+
+        void decompress(std::span<const CompressedVertex> vertices, const QuantizationBounds& bounds, std::span<Vertex> out) {
+            verify(out.size() >= vertices.size(), "Output is too small");
+            for(std::size_t i = 0; i < vertices.size(); i++) {
+                out[i] = decompress(vertices[i], bounds);
+            }
+        }
+
+        void decompress(std::span<const CompressedSkinnedVertex> vertices, const QuantizationBounds& bounds, std::span<SkinnedVertex> out) {
+            verify(out.size() >= vertices.size(), "Output is too small");
+            for(std::size_t i = 0; i < vertices.size(); i++) {
+                out[i] = decompress(vertices[i], bounds);
+            }
+        }
+
+        QuantizationBounds compressMeshlets(std::span<const Vertex> meshVertices, std::span<const Render::Meshlet> meshlets,
+                                            std::span<const std::uint32_t> meshletVertexIndices, std::span<CompressedVertex> out) {
+            const QuantizationBounds bounds = QuantizationBounds::compute(meshVertices);
+            std::size_t outIndex = 0;
+            for(const Render::Meshlet& meshlet : meshlets) {
+                verify(outIndex + meshlet.vertexCount <= out.size(), "Output is too small");
+                for(std::size_t i = 0; i < meshlet.vertexCount; i++) {
+                    out[outIndex++] = compress(meshVertices[meshletVertexIndices[meshlet.vertexOffset + i]], bounds);
+                }
+            }
+            return bounds;
+        }
+    }
+}
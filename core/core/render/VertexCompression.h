@@ -0,0 +1,99 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <core/render/Meshlet.h>
+#include <core/render/VertexTypes.h>
+#include <cstdint>
+#include <span>
+
+namespace Carrot {
+    /// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+    /// Keep in sync with shaders/includes/vertex-compression.glsl !!
+    /// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+    /// Box in which compressed positions are quantized. Usually the bounds of the mesh or of the cluster the vertices belong to
+    struct QuantizationBounds {
+        glm::vec3 min{0.0f};
+        glm::vec3 extent{0.0f}; //< max - min
+
+        /// Smallest bounds containing all the given vertices
+        static QuantizationBounds compute(std::span<const Vertex> vertices);
+        static QuantizationBounds compute(std::span<const SkinnedVertex> vertices);
+    };
+
+    /// Compact version of Vertex: 24 bytes instead of 80.
+    /// Read by shaders as 6 uints, so the order and size of each field matters!
+    struct CompressedVertex {
+        /// Position inside the quantization bounds, as unorm16
+        glm::u16vec3 position{0};
+
+        /// 0 if the bitangent sign (Vertex::tangent.w) is positive, 1 if negative
+        std::uint16_t bitangentSign = 0;
+
+        /// Octahedral encoding of the normal, as snorm16
+        glm::i16vec2 normal{0};
+
+        /// Octahedral encoding of the tangent (xyz only), as snorm16
+        glm::i16vec2 tangent{0};
+
+        /// Half-float UV coordinates
+        glm::u16vec2 uv{0};
+
+        /// RGB color + unused alpha, as unorm8
+        glm::u8vec4 color{255};
+    };
+    static_assert(sizeof(CompressedVertex) == 24, "Shaders expect compressed vertices to be 24 bytes long");
+
+    /// Compact version of SkinnedVertex: 32 bytes instead of 112
+    struct CompressedSkinnedVertex: public CompressedVertex {
+        glm::u8vec4 boneIDs{0};
+
+        /// unorm8, always sum to 255 if the vertex is influenced by at least one bone
+        glm::u8vec4 boneWeights{0};
+    };
+    static_assert(sizeof(CompressedSkinnedVertex) == 32, "Shaders expect compressed skinned vertices to be 32 bytes long");
+
+    namespace VertexCompression {
+        /// Largest bone ID a compressed skinned vertex can reference. SkinnedVertex stores IDs as 8-bit values too (written as unsigned bytes in glTF),
+        /// so the same limit applies to uncompressed vertices: tools must reject skeletons with more bones instead of letting IDs wrap.
+        constexpr int MaxBoneID = 255;
+
+        /// Maximum distance between an original position and its decompressed version, per axis, for the given bounds
+        glm::vec3 getMaxPositionError(const QuantizationBounds& bounds);
+
+        /// Octahedral encoding of an unit vector
+        glm::i16vec2 encodeOctahedral(const glm::vec3& direction);
+
+        /// Decodes a vector encoded with 'encodeOctahedral'. Result is normalized
+        glm::vec3 decodeOctahedral(const glm::i16vec2& encoded);
+
+        /// Quantizes bone weights to 8 bits. The weights are expected to be normalized. The quantized weights are adjusted so that
+        /// they still sum to 255 (ie 1.0) after quantization.
+        glm::u8vec4 encodeBoneWeights(const glm::vec4& weights);
+        glm::vec4 decodeBoneWeights(const glm::u8vec4& encoded);
+
+        CompressedVertex compress(const Vertex& vertex, const QuantizationBounds& bounds);
+        Vertex decompress(const CompressedVertex& vertex, const QuantizationBounds& bounds);
+
+        CompressedSkinnedVertex compress(const SkinnedVertex& vertex, const QuantizationBounds& bounds);
+        SkinnedVertex decompress(const CompressedSkinnedVertex& vertex, const QuantizationBounds& bounds);
+
+        /// Compresses all vertices, 'out' must be as large as 'vertices'
+        void compress(std::span<const Vertex> vertices, const QuantizationBounds& bounds, std::span<CompressedVertex> out);
+        void compress(std::span<const SkinnedVertex> vertices, const QuantizationBounds& bounds, std::span<CompressedSkinnedVertex> out);
+
+        /// Decompresses all vertices, 'out' must be as large as 'vertices'
+        void decompress(std::span<const CompressedVertex> vertices, const QuantizationBounds& bounds, std::span<Vertex> out);
+        void decompress(std::span<const CompressedSkinnedVertex> vertices, const QuantizationBounds& bounds, std::span<SkinnedVertex> out);
+
+        /// Compresses the vertices of each meshlet, one meshlet after the other inside 'out' (vertices used by several meshlets are duplicated).
+        /// 'out' must have room for the vertices of all meshlets.
+        /// Positions are quantized relative to the bounds of the entire mesh, which are returned: a vertex shared by neighbouring meshlets
+        /// must decode to the exact same position in each of them, otherwise cracks appear along their borders.
+        QuantizationBounds compressMeshlets(std::span<const Vertex> meshVertices, std::span<const Render::Meshlet> meshlets,
+                                            std::span<const std::uint32_t> meshletVertexIndices, std::span<CompressedVertex> out);
+    }
+}
@@ -0,0 +1,290 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "BinaryModel.h"
+
+#include <core/utils/Assert.h>
+#include <core/utils/stringmanip.h>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Carrot::Render {
+    // stored as raw bytes
+    static_assert(std::is_trivially_copyable_v<Carrot::Vertex>);
+    static_assert(std::is_trivially_copyable_v<Render::Meshlet>);
+    static_assert(std::is_trivially_copyable_v<BinaryModel::Header>);
+    static_assert(std::is_trivially_copyable_v<BinaryModel::Primitive>);
+    static_assert(std::is_trivially_copyable_v<BinaryModel::Instance>);
+    static_assert(std::is_trivially_copyable_v<BinaryModel::Material>);
+    static_assert(BinaryModel::TableAlignment % alignof(Carrot::Vertex) == 0);
+
+    namespace BinaryModel {
+        bool canWrite(const LoadedScene& scene) {
+            if(!scene.animationData.empty()) {
+                return false;
+            }
+            for(const auto& primitive : scene.primitives) {
+                if(primitive.isSkinned) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        class Writer {
+        public:
+            std::vector<std::uint8_t> bytes;
+
+            /// Appends 'elements' at the next aligned offset
+            template<typename T>
+            Table writeTable(std::span<const T> elements) {
+                const std::uint64_t offset = align();
+                bytes.resize(offset + elements.size_bytes());
+                if(!elements.empty()) {
+                    memcpy(bytes.data() + offset, elements.data(), elements.size_bytes());
+                }
+                return Table { .offset = offset, .count = elements.size() };
+            }
+
+            StringRef addString(std::string_view str) {
+                const StringRef ref { .offset = static_cast<std::uint32_t>(strings.size()), .length = static_cast<std::uint32_t>(str.size()) };
+                strings.insert(strings.end(), str.begin(), str.end());
+                return ref;
+            }
+
+            std::vector<char> strings;
+
+        private:
+            std::uint64_t align() {
+                std::uint64_t offset = bytes.size();
+                if(offset % TableAlignment != 0) {
+                    offset += TableAlignment - offset % TableAlignment;
+                }
+                return offset;
+            }
+        };
+
+        template<typename T>
+        static Range append(std::vector<T>& table, const std::vector<T>& elements) {
+            const Range range { .first = static_cast<std::uint32_t>(table.size()), .count = static_cast<std::uint32_t>(elements.size()) };
+            table.insert(table.end(), elements.begin(), elements.end());
+            return range;
+        }
+
+        std::vector<std::uint8_t> write(const LoadedScene& scene) {
+            verify(canWrite(scene), "Skinned meshes and animations are not supported by the binary model format");
+
+            Writer writer;
+            Header header;
+            header.debugName = writer.addString(scene.debugName);
+
+            std::vector<Carrot::Vertex> vertices;
+            std::vector<std::uint32_t> indices;
+            std::vector<Render::Meshlet> meshlets;
+            std::vector<std::uint32_t> meshletVertexIndices;
+            std::vector<std::uint32_t> meshletIndices;
+            std::vector<Primitive> primitives;
+            primitives.reserve(scene.primitives.size());
+            for(const auto& loadedPrimitive : scene.primitives) {
+                Primitive& primitive = primitives.emplace_back();
+                primitive.vertices = append(vertices, loadedPrimitive.vertices);
+                primitive.indices = append(indices, loadedPrimitive.indices);
+                primitive.meshlets = append(meshlets, loadedPrimitive.meshlets);
+                primitive.meshletVertexIndices = append(meshletVertexIndices, loadedPrimitive.meshletVertexIndices);
+                primitive.meshletIndices = append(meshletIndices, loadedPrimitive.meshletIndices);
+                primitive.minPos = loadedPrimitive.minPos;
+                primitive.maxPos = loadedPrimitive.maxPos;
+                primitive.materialIndex = static_cast<std::int32_t>(loadedPrimitive.materialIndex);
+                primitive.name = writer.addString(loadedPrimitive.name);
+            }
+
+            // same traversal as Model::loadInner
+            std::vector<Instance> instances;
+            std::function<void(const SkeletonTreeNode&, const glm::mat4&)> flattenNodes = [&](const SkeletonTreeNode& node, const glm::mat4& parentTransform) {
+                const glm::mat4 transform = parentTransform * node.bone.originalTransform;
+                if(node.meshIndices.has_value()) {
+                    for(const std::size_t meshIndex : node.meshIndices.value()) {
+                        instances.push_back(Instance { .transform = transform, .primitiveIndex = static_cast<std::uint32_t>(meshIndex) });
+                    }
+                }
+                for(const auto& child : node.getChildren()) {
+                    flattenNodes(child, transform);
+                }
+            };
+            if(scene.nodeHierarchy) {
+                flattenNodes(scene.nodeHierarchy->hierarchy, glm::mat4{1.0f});
+            }
+
+            std::vector<Material> materials;
+            materials.reserve(scene.materials.size());
+            for(const auto& loadedMaterial : scene.materials) {
+                auto pathString = [&](const IO::VFS::Path& path) {
+                    return path.isEmpty() ? StringRef{} : writer.addString(path.toString());
+                };
+
+                Material& material = materials.emplace_back();
+                material.baseColorFactor = loadedMaterial.baseColorFactor;
+                material.emissiveFactor = loadedMaterial.emissiveFactor;
+                material.metallicFactor = loadedMaterial.metallicFactor;
+                material.roughnessFactor = loadedMaterial.roughnessFactor;
+                material.blendMode = static_cast<std::uint32_t>(loadedMaterial.blendMode);
+                material.name = writer.addString(loadedMaterial.name);
+                material.albedo = pathString(loadedMaterial.albedo);
+                material.normalMap = pathString(loadedMaterial.normalMap);
+                material.metallicRoughness = pathString(loadedMaterial.metallicRoughness);
+                material.occlusion = pathString(loadedMaterial.occlusion);
+                material.emissive = pathString(loadedMaterial.emissive);
+            }
+
+            // header is written last, once offsets are known
+            writer.bytes.resize(sizeof(Header));
+            header.vertices = writer.writeTable(std::span<const Carrot::Vertex>{ vertices });
+            header.indices = writer.writeTable(std::span<const std::uint32_t>{ indices });
+            header.meshlets = writer.writeTable(std::span<const Render::Meshlet>{ meshlets });
+            header.meshletVertexIndices = writer.writeTable(std::span<const std::uint32_t>{ meshletVertexIndices });
+            header.meshletIndices = writer.writeTable(std::span<const std::uint32_t>{ meshletIndices });
+            header.primitives = writer.writeTable(std::span<const Primitive>{ primitives });
+            header.instances = writer.writeTable(std::span<const Instance>{ instances });
+            header.materials = writer.writeTable(std::span<const Material>{ materials });
+            header.strings = writer.writeTable(std::span<const char>{ writer.strings });
+            memcpy(writer.bytes.data(), &header, sizeof(Header));
+
+            return std::move(writer.bytes);
+        }
+    }
+
+    BinaryModelView::BinaryModelView(std::span<const std::uint8_t> data): data(data) {
+        using namespace BinaryModel;
+        if(data.size() < sizeof(Header) || reinterpret_cast<std::uintptr_t>(data.data()) % TableAlignment != 0) {
+            throw std::runtime_error("Not a binary model: too small or misaligned");
+        }
+        pHeader = reinterpret_cast<const Header*>(data.data());
+        if(pHeader->magic != Magic) {
+            throw std::runtime_error("Not a binary model: invalid magic");
+        }
+        if(pHeader->version != Version) {
+            throw std::runtime_error(Carrot::sprintf("Unsupported binary model version %u (expected %u)", pHeader->version, Version));
+        }
+        if(pHeader->vertexSize != sizeof(Carrot::Vertex) || pHeader->meshletSize != sizeof(Render::Meshlet)) {
+            throw std::runtime_error("Binary model was written with different vertex or meshlet layouts, it needs to be converted again");
+        }
+
+        // checks the structure of the file, so that spans returned by this view stay inside 'data'.
+        // Contents of index buffers are not checked: this is done when the model is converted
+        auto checkRange = [](const Range& range, std::size_t tableSize, const char* what) {
+            if(static_cast<std::uint64_t>(range.first) + range.count > tableSize) {
+                throw std::runtime_error(Carrot::sprintf("Invalid binary model: %s range is out of bounds", what));
+            }
+        };
+        auto checkString = [&](const StringRef& ref) {
+            if(static_cast<std::uint64_t>(ref.offset) + ref.length > pHeader->strings.count) {
+                throw std::runtime_error("Invalid binary model: string is out of bounds");
+            }
+        };
+
+        // validates all tables
+        const std::size_t vertexCount = getVertices().size();
+        const std::size_t indexCount = getIndices().size();
+        const std::size_t meshletCount = getTable<Render::Meshlet>(pHeader->meshlets).size();
+        const std::size_t meshletVertexIndexCount = getTable<std::uint32_t>(pHeader->meshletVertexIndices).size();
+        const std::size_t meshletIndexCount = getTable<std::uint32_t>(pHeader->meshletIndices).size();
+        getTable<char>(pHeader->strings);
+
+        checkString(pHeader->debugName);
+        for(const Primitive& primitive : getPrimitives()) {
+            checkRange(primitive.vertices, vertexCount, "vertex");
+            checkRange(primitive.indices, indexCount, "index");
+            checkRange(primitive.meshlets, meshletCount, "meshlet");
+            checkRange(primitive.meshletVertexIndices, meshletVertexIndexCount, "meshlet vertex index");
+            checkRange(primitive.meshletIndices, meshletIndexCount, "meshlet index");
+            checkString(primitive.name);
+            if(primitive.materialIndex < -1 || primitive.materialIndex >= static_cast<std::int64_t>(pHeader->materials.count)) {
+                throw std::runtime_error("Invalid binary model: material index is out of bounds");
+            }
+
+            for(const Render::Meshlet& meshlet : getMeshlets(primitive)) {
+                checkRange(Range { meshlet.vertexOffset, meshlet.vertexCount }, primitive.meshletVertexIndices.count, "meshlet vertex");
+                checkRange(Range { meshlet.indexOffset, meshlet.indexCount }, primitive.meshletIndices.count, "meshlet triangle");
+            }
+        }
+
+        for(const Instance& instance : getInstances()) {
+            if(instance.primitiveIndex >= pHeader->primitives.count) {
+                throw std::runtime_error("Invalid binary model: instance references a primitive which does not exist");
+            }
+        }
+
+        for(const Material& material : getMaterials()) {
+            for(const StringRef& ref : { material.name, material.albedo, material.normalMap, material.metallicRoughness, material.occlusion, material.emissive }) {
+                checkString(ref);
+            }
+        }
+    }
+
+    template<typename T>
+    std::span<const T> BinaryModelView::getTable(const BinaryModel::Table& table) const {
+        if(table.offset % alignof(T) != 0
+        || table.offset > data.size()
+        || table.count > (data.size() - table.offset) / sizeof(T)) {
+            throw std::runtime_error("Invalid binary model: table is out of bounds");
+        }
+        return std::span<const T> { reinterpret_cast<const T*>(data.data() + table.offset), table.count };
+    }
+
+    template<typename T>
+    std::span<const T> BinaryModelView::getRange(std::span<const T> table, const BinaryModel::Range& range) {
+        return table.subspan(range.first, range.count);
+    }
+
+    std::string_view BinaryModelView::getDebugName() const {
+        return getString(pHeader->debugName);
+    }
+
+    std::span<const Carrot::Vertex> BinaryModelView::getVertices() const {
+        return getTable<Carrot::Vertex>(pHeader->vertices);
+    }
+
+    std::span<const std::uint32_t> BinaryModelView::getIndices() const {
+        return getTable<std::uint32_t>(pHeader->indices);
+    }
+
+    std::span<const BinaryModel::Primitive> BinaryModelView::getPrimitives() const {
+        return getTable<BinaryModel::Primitive>(pHeader->primitives);
+    }
+
+    std::span<const BinaryModel::Instance> BinaryModelView::getInstances() const {
+        return getTable<BinaryModel::Instance>(pHeader->instances);
+    }
+
+    std::span<const BinaryModel::Material> BinaryModelView::getMaterials() const {
+        return getTable<BinaryModel::Material>(pHeader->materials);
+    }
+
+    std::span<const Carrot::Vertex> BinaryModelView::getVertices(const BinaryModel::Primitive& primitive) const {
+        return getRange(getVertices(), primitive.vertices);
+    }
+
+    std::span<const std::uint32_t> BinaryModelView::getIndices(const BinaryModel::Primitive& primitive) const {
+        return getRange(getIndices(), primitive.indices);
+    }
+
+    std::span<const Render::Meshlet> BinaryModelView::getMeshlets(const BinaryModel::Primitive& primitive) const {
+        return getRange(getTable<Render::Meshlet>(pHeader->meshlets), primitive.meshlets);
+    }
+
+    std::span<const std::uint32_t> BinaryModelView::getMeshletVertexIndices(const BinaryModel::Primitive& primitive) const {
+        return getRange(getTable<std::uint32_t>(pHeader->meshletVertexIndices), primitive.meshletVertexIndices);
+    }
+
+    std::span<const std::uint32_t> BinaryModelView::getMeshletIndices(const BinaryModel::Primitive& primitive) const {
+        return getRange(getTable<std::uint32_t>(pHeader->meshletIndices), primitive.meshletIndices);
+    }
+
+    std::string_view BinaryModelView::getString(const BinaryModel::StringRef& ref) const {
+        const std::span<const char> strings = getTable<char>(pHeader->strings);
+        return std::string_view { strings.data() + ref.offset, ref.length };
+    }
+}
@@ -0,0 +1,149 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <core/scene/LoadedScene.h>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace Carrot::Render {
+    /// Engine-native model format (.cmodel), written by Fertilizer.
+    /// Tables are stored exactly as the engine and the GPU consume them (Carrot::Vertex, 32-bit indices, Render::Meshlet),
+    /// so a file can be used in place once memory-mapped: loading does not parse or convert anything.
+    /// Only static geometry is supported: skinned meshes and animations still go through glTF.
+    ///
+    /// Layout: a Header, followed by tables aligned on 'BinaryModel::TableAlignment' bytes. Headers of tables give offsets relative to
+    /// the start of the file. All values are little-endian, like every platform Carrot runs on.
+    namespace BinaryModel {
+        constexpr std::uint32_t Magic = 'C' | ('M' << 8) | ('D' << 16) | ('L' << 24);
+
+        /// Increment when the layout of the file or of any stored type changes
+        constexpr std::uint32_t Version = 1;
+
+        constexpr std::uint64_t TableAlignment = 16;
+
+        /// Part of the file containing 'count' elements, starting at 'offset' (in bytes)
+        struct Table {
+            std::uint64_t offset = 0;
+            std::uint64_t count = 0;
+        };
+
+        /// Range of elements inside a table
+        struct Range {
+            std::uint32_t first = 0;
+            std::uint32_t count = 0;
+        };
+
+        /// String inside the string table, not null-terminated
+        struct StringRef {
+            std::uint32_t offset = 0;
+            std::uint32_t length = 0;
+        };
+
+        struct Header {
+            std::uint32_t magic = Magic;
+            std::uint32_t version = Version;
+
+            // sizes of the stored engine types, to detect files written by a build with a different layout
+            std::uint32_t vertexSize = sizeof(Carrot::Vertex);
+            std::uint32_t meshletSize = sizeof(Render::Meshlet);
+
+            StringRef debugName;
+
+            Table vertices; // Carrot::Vertex
+            Table indices; // std::uint32_t
+            Table meshlets; // Render::Meshlet
+            Table meshletVertexIndices; // std::uint32_t
+            Table meshletIndices; // std::uint32_t
+            Table primitives; // BinaryModel::Primitive
+            Table instances; // BinaryModel::Instance
+            Table materials; // BinaryModel::Material
+            Table strings; // char
+        };
+
+        /// Vertices and indices of a primitive are contiguous inside the vertex and index tables, and indices are relative to the first vertex of the primitive.
+        /// Meshlets and their indices are relative to the primitive too, like inside LoadedPrimitive.
+        struct Primitive {
+            Range vertices;
+            Range indices;
+            Range meshlets;
+            Range meshletVertexIndices;
+            Range meshletIndices;
+
+            glm::vec3 minPos{0.0f};
+            glm::vec3 maxPos{0.0f};
+            std::int32_t materialIndex = -1; // -1 if none
+            StringRef name;
+        };
+
+        /// A primitive placed inside the model, the node hierarchy is flattened when writing the file
+        struct Instance {
+            glm::mat4 transform{1.0f}; // relative to the root of the model
+            std::uint32_t primitiveIndex = 0;
+        };
+
+        struct Material {
+            glm::vec4 baseColorFactor{1.0f};
+            glm::vec3 emissiveFactor{1.0f};
+            float metallicFactor = 1.0f;
+            float roughnessFactor = 1.0f;
+            std::uint32_t blendMode = 0; // LoadedMaterial::BlendMode
+
+            StringRef name;
+
+            // texture paths, relative to the model file. Empty if none
+            StringRef albedo;
+            StringRef normalMap;
+            StringRef metallicRoughness;
+            StringRef occlusion;
+            StringRef emissive;
+        };
+
+        /// Can 'scene' be written with 'write'? False if it contains skinned meshes or animations
+        bool canWrite(const LoadedScene& scene);
+
+        /// Serializes 'scene' to the binary model format. Texture paths of materials are written as-is.
+        /// 'scene' must be writable (see 'canWrite')
+        std::vector<std::uint8_t> write(const LoadedScene& scene);
+    }
+
+    /// Read-only view over a model in the binary format. Does not copy anything: the returned spans point inside the viewed data,
+    /// which must outlive this view (typically a memory-mapped file)
+    class BinaryModelView {
+    public:
+        /// Checks that 'data' is a valid model, throws if it is not
+        explicit BinaryModelView(std::span<const std::uint8_t> data);
+
+        std::string_view getDebugName() const;
+
+        /// All vertices and indices of the model, as they should be uploaded to the GPU
+        std::span<const Carrot::Vertex> getVertices() const;
+        std::span<const std::uint32_t> getIndices() const;
+
+        std::span<const BinaryModel::Primitive> getPrimitives() const;
+        std::span<const BinaryModel::Instance> getInstances() const;
+        std::span<const BinaryModel::Material> getMaterials() const;
+
+        std::span<const Carrot::Vertex> getVertices(const BinaryModel::Primitive& primitive) const;
+        std::span<const std::uint32_t> getIndices(const BinaryModel::Primitive& primitive) const;
+        std::span<const Render::Meshlet> getMeshlets(const BinaryModel::Primitive& primitive) const;
+        std::span<const std::uint32_t> getMeshletVertexIndices(const BinaryModel::Primitive& primitive) const;
+        std::span<const std::uint32_t> getMeshletIndices(const BinaryModel::Primitive& primitive) const;
+
+        std::string_view getString(const BinaryModel::StringRef& ref) const;
+
+    private:
+        template<typename T>
+        std::span<const T> getTable(const BinaryModel::Table& table) const;
+
+        template<typename T>
+        static std::span<const T> getRange(std::span<const T> table, const BinaryModel::Range& range);
+
+        std::span<const std::uint8_t> data;
+        const BinaryModel::Header* pHeader = nullptr;
+    };
+}
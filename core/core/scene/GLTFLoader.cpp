@@ -6,6 +6,7 @@
 #include "core/io/Logging.hpp"
 #include <core/utils/Profiling.h>
 #include <core/utils/UserNotifications.h>
+#include <core/render/VertexCompression.h>
 #include <glm/gtx/quaternion.hpp>
 #include <set>
 
@@ -20,7 +21,8 @@ namespace Carrot::Render {
 
     constexpr const char* const SUPPORTED_EXTENSIONS[] = {
             KHR_TEXTURE_BASISU_EXTENSION_NAME,
-            GLTFLoader::CARROT_MESHLETS_EXTENSION_NAME
+            GLTFLoader::CARROT_MESHLETS_EXTENSION_NAME,
+            GLTFLoader::CARROT_COMPRESSED_VERTICES_EXTENSION_NAME,
     };
 
     struct PrimitiveInformation {
@@ -203,8 +205,52 @@ namespace Carrot::Render {
         return *((const T*)pSource);
     }
 
+    /**
+     * Loads vertices written by Fertilizer with --compress-vertices, see VertexCompression.h
+     */
+    static void loadCompressedVertices(LoadedPrimitive& loadedPrimitive, const tinygltf::Model& model, const tinygltf::Value& extension, PrimitiveInformation& info) {
+        ZoneScoped;
+        auto toVec3 = [](const tinygltf::Value& array) {
+            verify(array.IsArray() && array.ArrayLen() == 3, "Expected an array of 3 numbers");
+            return glm::vec3 { array.Get(0).GetNumberAsDouble(), array.Get(1).GetNumberAsDouble(), array.Get(2).GetNumberAsDouble() };
+        };
+
+        const QuantizationBounds bounds {
+            .min = toVec3(extension.Get("quantization_min")),
+            .extent = toVec3(extension.Get("quantization_extent")),
+        };
+        const bool isSkinned = extension.Get("skinned").Get<bool>();
+        const tinygltf::Accessor& accessor = model.accessors[extension.Get("vertices").GetNumberAsInt()];
+        const tinygltf::BufferView& bufferView = model.bufferViews[accessor.bufferView];
+        const std::uint8_t* pData = model.buffers[bufferView.buffer].data.data() + bufferView.byteOffset + accessor.byteOffset;
+
+        // Fertilizer always writes normals, tangents and UVs
+        info.hasNormals = true;
+        info.hasTangents = true;
+        info.hasTexCoords = true;
+        loadedPrimitive.isSkinned = isSkinned;
+        loadedPrimitive.minPos = bounds.min;
+        loadedPrimitive.maxPos = bounds.min + bounds.extent;
+
+        if(isSkinned) {
+            const std::span<const CompressedSkinnedVertex> compressed { reinterpret_cast<const CompressedSkinnedVertex*>(pData), accessor.count / sizeof(CompressedSkinnedVertex) };
+            loadedPrimitive.skinnedVertices.resize(compressed.size());
+            VertexCompression::decompress(compressed, bounds, loadedPrimitive.skinnedVertices);
+        } else {
+            const std::span<const CompressedVertex> compressed { reinterpret_cast<const CompressedVertex*>(pData), accessor.count / sizeof(CompressedVertex) };
+            loadedPrimitive.vertices.resize(compressed.size());
+            VertexCompression::decompress(compressed, bounds, loadedPrimitive.vertices);
+        }
+    }
+
     static void loadVertices(LoadedPrimitive& loadedPrimitive, const tinygltf::Model& model, const tinygltf::Primitive& primitive, PrimitiveInformation& info) {
         ZoneScoped;
+        auto compressedIter = primitive.extensions.find(GLTFLoader::CARROT_COMPRESSED_VERTICES_EXTENSION_NAME);
+        if(compressedIter != primitive.extensions.end()) {
+            loadCompressedVertices(loadedPrimitive, model, compressedIter->second, info);
+            return;
+        }
+
         std::vector<Vertex>& vertices = loadedPrimitive.vertices;
         std::vector<SkinnedVertex>& skinnedVertices = loadedPrimitive.skinnedVertices;
         const tinygltf::Accessor& positionsAccessor = model.accessors[primitive.attributes.at("POSITION")];
@@ -15,6 +15,7 @@ namespace Carrot::Render {
     class GLTFLoader {
     public:
         static constexpr const char* const CARROT_MESHLETS_EXTENSION_NAME = "CARROT_meshlets";
+        static constexpr const char* const CARROT_COMPRESSED_VERTICES_EXTENSION_NAME = "CARROT_compressed_vertices";
 
         LoadedScene load(const Carrot::IO::Resource& resource);
         LoadedScene load(const tinygltf::Model& model, const IO::VFS::Path& modelFilepath);
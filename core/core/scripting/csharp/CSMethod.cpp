@@ -35,4 +35,19 @@ namespace Carrot::Scripting {
         }
         return result;
     }
+
+    void* CSMethod::getUnmanagedThunk() {
+        if(unmanagedThunk == nullptr) {
+            unmanagedThunk = mono_method_get_unmanaged_thunk(method);
+            verify(unmanagedThunk, "Could not create unmanaged thunk");
+        }
+        return unmanagedThunk;
+    }
+
+    void CSMethod::checkThunkException(MonoException* exception) {
+        if(exception) {
+            mono_print_unhandled_exception((MonoObject*)exception);
+            verify(false, "C# exception");
+        }
+    }
 } // Carrot::Scripting
\ No newline at end of file
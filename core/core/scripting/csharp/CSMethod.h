@@ -7,6 +7,7 @@
 #include <core/scripting/csharp/forward.h>
 #include <mono/metadata/object-forward.h>
 #include <span>
+#include <type_traits>
 
 namespace Carrot::Scripting {
     class CSMethod {
@@ -23,9 +24,41 @@ namespace Carrot::Scripting {
          */
         CSObject staticInvoke(std::span<void*> args);
 
+        /**
+         * Calls this method through its unmanaged thunk: arguments are given as-is instead of going through mono_runtime_invoke and boxing.
+         * Value types must be blittable and are passed by value, reference types are passed as MonoObject*. For instance methods, the first argument is the instance.
+         * The thunk is created on first use and cached.
+         * Throws if the method throws a C# exception.
+         */
+        template<typename Return, typename... Args>
+        Return invokeThunk(Args... args);
+
+        /**
+         * Native function pointer calling this method, see mono_method_get_unmanaged_thunk. Created on first use, then cached
+         */
+        void* getUnmanagedThunk();
+
     private:
+        static void checkThunkException(MonoException* exception);
+
         MonoMethod* method = nullptr;
+        void* unmanagedThunk = nullptr;
 
         friend class CSClass;
     };
 } // Carrot::Scripting
+
+template<typename Return, typename... Args>
+Return Carrot::Scripting::CSMethod::invokeThunk(Args... args) {
+    using ThunkType = Return(*)(Args..., MonoException**);
+    ThunkType thunk = reinterpret_cast<ThunkType>(getUnmanagedThunk());
+    MonoException* exception = nullptr;
+    if constexpr (std::is_void_v<Return>) {
+        thunk(args..., &exception);
+        checkThunkException(exception);
+    } else {
+        Return result = thunk(args..., &exception);
+        checkThunkException(exception);
+        return result;
+    }
+}
@@ -0,0 +1,116 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "AccessGraph.h"
+
+#include <algorithm>
+#include <core/utils/Assert.h>
+
+namespace Carrot::Async {
+    bool ResourceAccess::conflictsWith(const ResourceAccess& other) const {
+        if(exclusive || other.exclusive) {
+            return true;
+        }
+        return (writes & (other.reads | other.writes)).any()
+            || (other.writes & reads).any();
+    }
+
+    AccessGraph::AccessGraph(std::span<const ResourceAccess> nodes) {
+        const std::size_t count = nodes.size();
+        dependencies.resize(count);
+        dependents.resize(count);
+        levels.resize(count);
+
+        // ancestors[i][j] is true if 'j' needs to finish before 'i' (directly or not)
+        std::vector<std::vector<bool>> ancestors(count, std::vector<bool>(count, false));
+        for(std::size_t node = 0; node < count; node++) {
+            std::vector<std::size_t> conflicts;
+            for(std::size_t earlier = 0; earlier < node; earlier++) {
+                if(nodes[node].conflictsWith(nodes[earlier])) {
+                    conflicts.push_back(earlier);
+                }
+            }
+
+            for(std::size_t conflict : conflicts) {
+                ancestors[node][conflict] = true;
+                for(std::size_t i = 0; i < conflict; i++) {
+                    if(ancestors[conflict][i]) {
+                        ancestors[node][i] = true;
+                    }
+                }
+            }
+
+            // only keep dependencies which are not already implied by another dependency
+            std::size_t level = 0;
+            for(std::size_t conflict : conflicts) {
+                const bool implied = std::any_of(conflicts.begin(), conflicts.end(), [&](std::size_t other) {
+                    return other != conflict && ancestors[other][conflict];
+                });
+                if(implied) {
+                    continue;
+                }
+                dependencies[node].push_back(conflict);
+                dependents[conflict].push_back(node);
+                level = std::max(level, levels[conflict] + 1);
+            }
+            levels[node] = level;
+            levelCount = std::max(levelCount, level + 1);
+        }
+    }
+
+    std::size_t AccessGraph::size() const {
+        return dependencies.size();
+    }
+
+    std::span<const std::size_t> AccessGraph::getDependencies(std::size_t node) const {
+        return dependencies[node];
+    }
+
+    std::span<const std::size_t> AccessGraph::getDependents(std::size_t node) const {
+        return dependents[node];
+    }
+
+    std::size_t AccessGraph::getLevel(std::size_t node) const {
+        return levels[node];
+    }
+
+    std::size_t AccessGraph::getLevelCount() const {
+        return levelCount;
+    }
+
+    std::vector<std::size_t> AccessGraph::computeCriticalPath(std::span<const double> durations) const {
+        verify(durations.size() == size(), "Need one duration per node");
+        if(size() == 0) {
+            return {};
+        }
+
+        // nodes are already in topological order: dependencies always come before their dependents
+        std::vector<double> finishTimes(size());
+        std::vector<std::size_t> previous(size(), size());
+        for(std::size_t node = 0; node < size(); node++) {
+            double startTime = 0.0;
+            for(std::size_t dependency : dependencies[node]) {
+                if(finishTimes[dependency] > startTime || previous[node] == size()) {
+                    startTime = finishTimes[dependency];
+                    previous[node] = dependency;
+                }
+            }
+            finishTimes[node] = startTime + durations[node];
+        }
+
+        // on ties, prefer later nodes: they end longer chains
+        std::size_t last = 0;
+        for(std::size_t node = 1; node < size(); node++) {
+            if(finishTimes[node] >= finishTimes[last]) {
+                last = node;
+            }
+        }
+        std::vector<std::size_t> path;
+        for(std::size_t node = last; node != size(); node = previous[node]) {
+            path.push_back(node);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+}
@@ -0,0 +1,68 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Carrot::Async {
+    /// Resources read and written by a node of an AccessGraph. Each bit represents a resource (for instance a component type)
+    struct ResourceAccess {
+        static constexpr std::size_t MaxResources = 64;
+
+        std::bitset<MaxResources> reads;
+        std::bitset<MaxResources> writes;
+
+        /// Conflicts with all other nodes, whatever they access. Used for nodes which did not declare what they access
+        bool exclusive = true;
+
+        /// Two nodes conflict if one of them is exclusive, or if one writes a resource accessed by the other
+        bool conflictsWith(const ResourceAccess& other) const;
+
+        bool operator==(const ResourceAccess& other) const = default;
+    };
+
+    /**
+     * \brief Dependency graph between nodes which must not run at the same time when their accesses conflict.
+     * Nodes are given in the order they would run sequentially: a node depends on the earlier nodes it conflicts with, so running
+     * the graph gives the same results as running the nodes one after the other.
+     *
+     * Only the direct dependencies are kept: if A -> B -> C, the dependency A -> C is implied and not stored.
+     */
+    class AccessGraph {
+    public:
+        AccessGraph() = default;
+        explicit AccessGraph(std::span<const ResourceAccess> nodes);
+
+        std::size_t size() const;
+
+        /// Nodes which must be finished before 'node' can start
+        std::span<const std::size_t> getDependencies(std::size_t node) const;
+
+        /// Nodes which wait for 'node'
+        std::span<const std::size_t> getDependents(std::size_t node) const;
+
+        /// Length of the longest dependency chain before this node. Nodes with the same level never conflict
+        std::size_t getLevel(std::size_t node) const;
+
+        /// How many levels this graph has, ie how many nodes in a row would run if there was an infinite amount of threads
+        std::size_t getLevelCount() const;
+
+        /**
+         * Computes the path of dependencies which takes the longest time to run: the graph cannot finish faster than the sum of its durations.
+         * \param durations how long each node takes to run
+         * \return indices of the nodes of the path, in execution order
+         */
+        std::vector<std::size_t> computeCriticalPath(std::span<const double> durations) const;
+
+    private:
+        std::vector<std::vector<std::size_t>> dependencies;
+        std::vector<std::vector<std::size_t>> dependents;
+        std::vector<std::size_t> levels;
+        std::size_t levelCount = 0;
+    };
+}
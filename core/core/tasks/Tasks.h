@@ -40,7 +40,7 @@ namespace Carrot::Async {
      * Waits until all tasks are done before returning
      * @param count how many tasks to execute
      * @param forEach what to execute for each task
-     * @param granularity how many tasks at once per thread
+     * @param granularity how many tasks at once per thread, 0 to choose automatically
      */
     inline void (*parallelFor)(std::size_t count, const std::function<void(std::size_t)>& forEach, std::size_t granularity) = nullptr;
 }
\ No newline at end of file
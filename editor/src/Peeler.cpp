@@ -975,9 +975,8 @@ namespace Peeler {
         isPaused = false;
         requestedSingleStep = false;
         hasDoneSingleStep = false;
-        savedScene.copyFrom(currentScene);
-
-        savedScene.unload();
+        // the scene is played in place: only serialise it, instead of duplicating every component (and its physics body)
+        savedScene = currentScene.serialiseBinary();
 
         currentScene.world.unfreezeLogic();
         currentScene.world.broadcastStartEvent();
@@ -1002,18 +1001,35 @@ namespace Peeler {
 
     void Application::performSimulationStop() {
         verify(stopSimulationRequested, "Don't call performSimulationStop directly!");
+        stopSimulationRequested = false;
+
+        // reload the edited scene from its snapshot (components are deserialised in parallel), next to the played one
+        Carrot::Scene restoredScene;
+        try {
+            restoredScene.deserialiseBinary(savedScene);
+        } catch (std::exception& e) {
+            // the snapshot is the only copy of the edited scene: keep it, and keep playing instead of losing it
+            Carrot::Log::error("Failed to restore scene after play mode, staying in play mode: %s", e.what());
+            return;
+        }
+        restoredScene.unload();
 
         isPlaying = false;
         isPaused = false;
         requestedSingleStep = false;
         hasDoneSingleStep = false;
         currentScene.world.broadcastStopEvent();
-        savedScene.load();
-        currentScene.copyFrom(savedScene);
+
+        // the played world is thrown away: give the components of the restored world to the current scene instead of copying them
+        currentScene.clear();
+        currentScene.moveContentFrom(restoredScene);
         savedScene.clear();
+
+        addEditingSystems();
+        currentScene.world.freezeLogic();
+        currentScene.load();
         GetPhysics().pause();
         GetEngine().ungrabCursor();
-        stopSimulationRequested = false;
     }
 
     void Application::popLayer() {
@@ -1281,6 +1297,33 @@ namespace Peeler {
         fclose(fp);
     }
 
+    /// Binary version of a scene, written next to its JSON file when saving. JSON stays the reference for source control,
+    /// the binary version is only used to open the scene faster
+    static Carrot::IO::VFS::Path getBinaryScenePath(const Carrot::IO::VFS::Path& scenePath) {
+        return scenePath.withExtension(".cscene");
+    }
+
+    /// Is the binary version of the scene more recent than its JSON file? If not, the JSON file was modified outside of the editor
+    static bool isBinarySceneUpToDate(const Carrot::IO::VFS::Path& scenePath) {
+        std::error_code error;
+        const std::filesystem::path binaryFile = GetVFS().resolve(getBinaryScenePath(scenePath));
+        if(!std::filesystem::exists(binaryFile, error)) {
+            return false;
+        }
+        return std::filesystem::last_write_time(binaryFile, error) >= std::filesystem::last_write_time(GetVFS().resolve(scenePath), error);
+    }
+
+    static void writeBinaryScene(const std::filesystem::path& targetFile, const Carrot::Scene& scene) {
+        const std::vector<std::uint8_t> bytes = scene.serialiseBinary();
+        FILE* fp = fopen(targetFile.string().c_str(), "wb");
+        if(!fp) {
+            Carrot::Log::warn("Could not write binary scene %s", targetFile.string().c_str());
+            return;
+        }
+        fwrite(bytes.data(), 1, bytes.size(), fp);
+        fclose(fp);
+    }
+
     void Application::addCurrentSceneToSceneList() {
         if(std::find(knownScenes.begin(), knownScenes.end(), scenePath) == knownScenes.end()) {
             knownScenes.push_back(scenePath);
@@ -1303,13 +1346,10 @@ namespace Peeler {
 
     void Application::openScene(const Carrot::IO::VFS::Path& path) {
         openUnsavedChangesPopup([this, path]() {
-            rapidjson::Document scene;
             scenePath = path;
             try {
-                Carrot::IO::Resource sceneData = scenePath;
-                scene.Parse(sceneData.readText());
                 currentScene.clear();
-                currentScene.deserialise(scene);
+                Carrot::SceneManager::readScene(isBinarySceneUpToDate(scenePath) ? getBinaryScenePath(scenePath) : scenePath, currentScene);
             } catch (std::exception& e) {
                 Carrot::Log::error("Failed to open scene: %s", e.what());
                 currentScene.clear();
@@ -1332,6 +1372,7 @@ namespace Peeler {
         currentScene.serialise(sceneData);
 
         writeJSON(GetVFS().resolve(scenePath), sceneData);
+        writeBinaryScene(GetVFS().resolve(getBinaryScenePath(scenePath)), currentScene);
 
         addCurrentSceneToSceneList();
     }
@@ -229,7 +229,7 @@ namespace Peeler {
         Carrot::Scene& currentScene;
 
     private:
-        Carrot::Scene savedScene;
+        std::vector<std::uint8_t> savedScene; // binary snapshot (see BinaryScene.h) of the edited scene, taken when entering play mode
 
     private: // inputs
         Carrot::IO::ActionSet editorActions { "editor_actions" };
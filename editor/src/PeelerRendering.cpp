@@ -23,6 +23,7 @@ namespace Peeler {
         engine.getVulkanDriver().getTextureRepository().getUsages(gameTexture.rootID) |= vk::ImageUsageFlagBits::eSampled;
         const auto& gbufferPass = graphBuilder.getPassData<PassData::GBuffer>("gbuffer").value();
         engine.getVulkanDriver().getTextureRepository().getUsages(gbufferPass.entityID.rootID) |= vk::ImageUsageFlagBits::eTransferSrc;
+        graphBuilder.markPersistent(gbufferPass.entityID); // sampled by the editor for entity picking
 
         gameTexture = addOutlinePass(graphBuilder, resolvePassResult);
 
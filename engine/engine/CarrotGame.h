@@ -27,6 +27,7 @@ namespace Carrot {
 
         [[deprecated]] virtual void onMouseMove(double dx, double dy) {};
 
+        /// Called from a worker thread: the gbuffer pass is recorded in parallel with the other passes of the render graph
         virtual void recordOpaqueGBufferPass(vk::RenderPass pass, Carrot::Render::Context renderContext, vk::CommandBuffer& commands) {};
         virtual void recordTransparentGBufferPass(vk::RenderPass pass, Carrot::Render::Context renderContext, vk::CommandBuffer& commands) {};
 
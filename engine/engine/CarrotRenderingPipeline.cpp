@@ -93,6 +93,16 @@ const Carrot::Render::FrameResource& Carrot::Engine::fillInDefaultPipeline(Carro
                                                                                vk::ImageLayout::eGeneral
                     );
                     GetVulkanDriver().getTextureRepository().getUsages(data.firstSpatialDenoiseColor.rootID) |= vk::ImageUsageFlagBits::eSampled;
+
+                    // read again by the next frame
+                    builder.markPersistent(data.firstSpatialDenoiseColor);
+                    builder.markPersistent(data.momentsHistoryHistoryLength);
+                    if(Carrot::GBuffer::getLayout() == Carrot::GBuffer::Layout::Packed) {
+                        // positions are reconstructed from depth
+                        builder.markPersistent(data.gBufferInput.depthStencil);
+                    } else {
+                        builder.markPersistent(data.gBufferInput.positions);
+                    }
                 },
                 [this](const Render::CompiledPass& pass, const Render::Context& frame, const Denoising& data, vk::CommandBuffer& buffer) {
                     ZoneScopedN("CPU RenderGraph temporal-denoise");
@@ -111,9 +121,21 @@ const Carrot::Render::FrameResource& Carrot::Engine::fillInDefaultPipeline(Carro
                     };
                     bindLastFrameTexture(data.firstSpatialDenoiseColor, 1, vk::ImageLayout::eGeneral);
 
-                    Render::Texture& viewPosTexture = pass.getGraph().getTexture(data.gBufferInput.positions, frame.swapchainIndex);
-                    renderer.bindTexture(*pipeline, frame, viewPosTexture, 0, 2, nullptr);
-                    bindLastFrameTexture(data.gBufferInput.positions, 3);
+                    if(Carrot::GBuffer::getLayout() == Carrot::GBuffer::Layout::Packed) {
+                        const vk::ImageLayout depthLayout = vk::ImageLayout::eDepthStencilReadOnlyOptimal;
+                        Render::Texture& depthTexture = pass.getGraph().getTexture(data.gBufferInput.depthStencil, frame.swapchainIndex);
+                        renderer.bindTexture(*pipeline, frame, depthTexture, 0, 2, nullptr, vk::ImageAspectFlagBits::eDepth, vk::ImageViewType::e2D, 0, depthLayout);
+                        if(frame.lastSwapchainIndex >= 0) {
+                            Render::Texture& lastDepthTexture = pass.getGraph().getTexture(data.gBufferInput.depthStencil, frame.lastSwapchainIndex);
+                            renderer.bindTexture(*pipeline, frame, lastDepthTexture, 0, 3, nullptr, vk::ImageAspectFlagBits::eDepth, vk::ImageViewType::e2D, 0, depthLayout);
+                        } else {
+                            bindLastFrameTexture(data.gBufferInput.depthStencil, 3); // no previous frame: binds a black texture
+                        }
+                    } else {
+                        Render::Texture& viewPosTexture = pass.getGraph().getTexture(data.gBufferInput.positions, frame.swapchainIndex);
+                        renderer.bindTexture(*pipeline, frame, viewPosTexture, 0, 2, nullptr);
+                        bindLastFrameTexture(data.gBufferInput.positions, 3);
+                    }
 
                     bindLastFrameTexture(data.momentsHistoryHistoryLength, 5, vk::ImageLayout::eGeneral);
 
@@ -56,5 +56,24 @@ namespace Carrot {
          */
         bool enableFileWatching = true;
 
+        /**
+         * Memory allowed for the mips of streamed textures (KTX2 textures with mips), in bytes.
+         * Can be changed at runtime from the texture streaming debug window
+         */
+        std::uint64_t textureStreamingBudget = 512ull * 1024 * 1024;
+
+        /**
+         * Use the packed GBuffer layout (see GBuffer::Layout): less memory and bandwidth, view positions are reconstructed from depth.
+         * Selects the variant of shaders compiled with GBUFFER_PACKED=1. Cannot be changed once the engine is created
+         */
+        bool packedGBuffer = false;
+
+        /**
+         * Compress the animations of models when loading them, and sample them on the CPU each frame (see AnimatedInstances::computeSkinningPalettes).
+         * The skinning shader then reads the sampled bone transforms, instead of keyframes baked inside GPU textures, which are not created.
+         * Uses less memory for long animations, at the cost of CPU time each frame. Cannot be changed once the engine is created
+         */
+        bool cpuAnimationSampling = false;
+
     };
 }
\ No newline at end of file
@@ -103,6 +103,9 @@ namespace Carrot {
 
         static Carrot::Engine& getInstance() { return *instance; }
 
+        /// Is there an engine instance? Not the case for headless tools and benchmarks which only use the ECS
+        static bool hasInstance() { return instance != nullptr; }
+
         /// Starts the engine. Will immediately load Vulkan resources
         explicit Engine(Configuration config = {});
 
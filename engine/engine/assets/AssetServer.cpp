@@ -5,8 +5,10 @@
 #include "AssetServer.h"
 #include <engine/console/Console.h>
 #include <engine/render/resources/Pipeline.h>
+#include <engine/render/TextureStreamer.h>
 #include <engine/utils/Profiling.h>
 #include <core/io/Logging.hpp>
+#include <core/io/FileFormats.h>
 #include <core/io/vfs/VirtualFileSystem.h>
 #include <engine/Engine.h>
 #include <core/io/FileSystemOS.h>
@@ -147,6 +149,10 @@ namespace Carrot {
                 from = "resources/textures/default.png";
             }
 
+            // KTX2 textures can contain mips: only their mip tail is loaded, finer mips are streamed in when needed
+            if(from.isFile() && IO::getFileFormat(Carrot::toString(from.getFilepath().u8string()).c_str()) == IO::FileFormat::KTX2) {
+                return GetRenderer().getTextureStreamer().loadTexture(from);
+            }
             return std::make_shared<Carrot::Render::Texture>(GetVulkanDriver(), std::move(from));
         });
     }
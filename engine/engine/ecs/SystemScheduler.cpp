@@ -0,0 +1,162 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "SystemScheduler.h"
+#include <engine/ecs/systems/System.h>
+#include <engine/task/TaskScheduler.h>
+#include <engine/utils/Macros.h>
+#include <engine/utils/Profiling.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <imgui.h>
+
+namespace Carrot::ECS {
+    SystemScheduler::SystemScheduler(std::string name): name(std::move(name)) {}
+
+    void SystemScheduler::updateGraph(std::span<System* const> newSystems) {
+        bool changed = newSystems.size() != systems.size();
+        for(std::size_t i = 0; !changed && i < newSystems.size(); i++) {
+            changed = newSystems[i] != systems[i] || newSystems[i]->getComponentAccess() != accesses[i];
+        }
+        if(!changed) {
+            return;
+        }
+
+        systems.assign(newSystems.begin(), newSystems.end());
+        accesses.clear();
+        accesses.reserve(systems.size());
+        for(const System* system : systems) {
+            accesses.push_back(system->getComponentAccess());
+        }
+        graph = Async::AccessGraph { accesses };
+        prerequisites.clear();
+        prerequisites.resize(systems.size());
+        durations.clear();
+        durations.resize(systems.size(), 0.0);
+    }
+
+    void SystemScheduler::run(std::span<System* const> toRun, const std::function<void(System&)>& action) {
+        ZoneScoped;
+        ZoneText(name.c_str(), name.size());
+        updateGraph(toRun);
+
+        const auto start = std::chrono::steady_clock::now();
+        auto runSystem = [&](std::size_t index) {
+            ZoneScopedN("System");
+            const char* systemName = systems[index]->getName();
+            ZoneText(systemName, std::strlen(systemName));
+
+            const auto systemStart = std::chrono::steady_clock::now();
+            action(*systems[index]);
+            durations[index] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - systemStart).count();
+
+            for(std::size_t dependent : graph.getDependents(index)) {
+                prerequisites[dependent].decrement();
+            }
+        };
+
+        if(graph.getLevelCount() == systems.size()) {
+            // nothing can run in parallel
+            for(std::size_t index = 0; index < systems.size(); index++) {
+                runSystem(index);
+            }
+        } else {
+            // the extra increment prevents tasks from starting before all tasks are scheduled
+            for(std::size_t index = 0; index < systems.size(); index++) {
+                prerequisites[index].increment(static_cast<std::uint32_t>(graph.getDependencies(index).size()) + 1);
+            }
+
+            Async::Counter parallelSystems;
+            for(std::size_t index = 0; index < systems.size(); index++) {
+                if(accesses[index].exclusive) {
+                    continue;
+                }
+                GetTaskScheduler().schedule(TaskDescription {
+                    .name = systems[index]->getName(),
+                    .task = [&runSystem, index](TaskHandle&) {
+                        runSystem(index);
+                    },
+                    .dependency = &prerequisites[index],
+                    .joiner = &parallelSystems,
+                }, TaskScheduler::FrameParallelWork);
+            }
+
+            for(auto& counter : prerequisites) {
+                counter.decrement();
+            }
+
+            // systems which did not allow parallel execution can rely on running on this thread (scripting, physics engine, etc.)
+            for(std::size_t index = 0; index < systems.size(); index++) {
+                if(!accesses[index].exclusive) {
+                    continue;
+                }
+                {
+                    ZoneScopedN("Wait for system dependencies");
+                    prerequisites[index].busyWait();
+                }
+                runSystem(index);
+            }
+
+            ZoneScopedN("Wait for parallel systems");
+            parallelSystems.busyWait();
+        }
+
+        totalDuration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void SystemScheduler::debugDraw() const {
+        if(!ImGui::CollapsingHeader(name.c_str())) {
+            return;
+        }
+
+        const std::vector<std::size_t> path = graph.computeCriticalPath(durations);
+        double sequentialDuration = 0.0;
+        for(double d : durations) {
+            sequentialDuration += d;
+        }
+        double criticalPathDuration = 0.0;
+        for(std::size_t index : path) {
+            criticalPathDuration += durations[index];
+        }
+        ImGui::Text("%llu systems, %llu levels", (unsigned long long)systems.size(), (unsigned long long)graph.getLevelCount());
+        ImGui::Text("Total: %.3f ms, sum of systems: %.3f ms, critical path: %.3f ms", totalDuration, sequentialDuration, criticalPathDuration);
+
+        if(ImGui::BeginTable("##schedule", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("System");
+            ImGui::TableSetupColumn("Level");
+            ImGui::TableSetupColumn("Thread");
+            ImGui::TableSetupColumn("Duration (ms)");
+            ImGui::TableSetupColumn("Waits for");
+            ImGui::TableHeadersRow();
+
+            for(std::size_t index = 0; index < systems.size(); index++) {
+                const bool onCriticalPath = std::find(path.begin(), path.end(), index) != path.end();
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                if(onCriticalPath) {
+                    ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), "%s", systems[index]->getName());
+                } else {
+                    ImGui::TextUnformatted(systems[index]->getName());
+                }
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", (unsigned long long)graph.getLevel(index));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(accesses[index].exclusive ? "Calling thread" : "Worker");
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", durations[index]);
+                ImGui::TableNextColumn();
+                std::string dependencies;
+                for(std::size_t dependency : graph.getDependencies(index)) {
+                    if(!dependencies.empty()) {
+                        dependencies += ", ";
+                    }
+                    dependencies += systems[dependency]->getName();
+                }
+                ImGui::TextUnformatted(dependencies.c_str());
+            }
+            ImGui::EndTable();
+        }
+    }
+}
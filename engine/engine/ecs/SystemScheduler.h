@@ -0,0 +1,46 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+#include <core/async/Counter.h>
+#include <core/tasks/AccessGraph.h>
+
+namespace Carrot::ECS {
+    class System;
+
+    /**
+     * Runs a list of systems in parallel when their component accesses do not conflict (see System::getComponentAccess).
+     * Systems which are not allowed to run in parallel are run on the calling thread.
+     * The result is the same as running the systems one after the other, in the order they are given.
+     */
+    class SystemScheduler {
+    public:
+        explicit SystemScheduler(std::string name);
+
+        /// Calls 'action' on each system, and waits for all systems before returning
+        void run(std::span<System* const> systems, const std::function<void(System&)>& action);
+
+        /// Shows the schedule of the last run: level of each system, how long it took and the critical path
+        void debugDraw() const;
+
+    private:
+        /// Rebuilds the dependency graph if systems changed since the last run
+        void updateGraph(std::span<System* const> systems);
+
+        std::string name;
+        std::vector<System*> systems;
+        std::vector<Async::ResourceAccess> accesses;
+        Async::AccessGraph graph;
+        std::vector<Async::Counter> prerequisites; // [systemIndex] systems which need to finish before this one can start
+
+        // stats of the last run
+        std::vector<double> durations; // [systemIndex] in milliseconds
+        double totalDuration = 0.0; // in milliseconds
+    };
+}
@@ -140,6 +140,11 @@ namespace Carrot::ECS {
     }
 
     World::World() {
+        if(!Carrot::Engine::hasInstance()) {
+            // headless world: no game assembly which could invalidate the queries
+            return;
+        }
+        csharpCallbacksRegistered = true;
         csharpLoadCallbackHandle = GetCSharpBindings().registerGameAssemblyLoadCallback([&]() {
             queries.clear();
         });
@@ -149,6 +154,9 @@ namespace Carrot::ECS {
     }
 
     World::~World() {
+        if(!csharpCallbacksRegistered) {
+            return;
+        }
         GetCSharpBindings().unregisterGameAssemblyLoadCallback(csharpLoadCallbackHandle);
         GetCSharpBindings().unregisterGameAssemblyUnloadCallback(csharpUnloadCallbackHandle);
     }
@@ -277,44 +285,40 @@ namespace Carrot::ECS {
         entitiesToRemove.clear();
         entitiesUpdated.clear();
 
-        if(!frozenLogic) {
-            for(const auto& logic : logicSystems) {
-                logic->tick(dt);
-            }
-        }
-
-        for(const auto& render : renderSystems) {
-            render->tick(dt);
-        }
+        tickScheduler.run(gatherSystems(!frozenLogic), [dt](System& system) {
+            system.tick(dt);
+        });
 
         worldData.update();
     }
 
     void World::prePhysics() {
-        if(!frozenLogic) {
-            for(const auto& logic : logicSystems) {
-                logic->prePhysics();
-            }
-        }
-
-        for(const auto& render : renderSystems) {
-            render->prePhysics();
-        }
+        prePhysicsScheduler.run(gatherSystems(!frozenLogic), [](System& system) {
+            system.prePhysics();
+        });
     }
 
     void World::postPhysics() {
-        if(!frozenLogic) {
+        postPhysicsScheduler.run(gatherSystems(!frozenLogic), [](System& system) {
+            system.postPhysics();
+        });
+    }
+
+    std::span<System* const> World::gatherSystems(bool includeLogic) {
+        scheduledSystems.clear();
+        if(includeLogic) {
             for(const auto& logic : logicSystems) {
-                logic->postPhysics();
+                scheduledSystems.push_back(logic.get());
             }
         }
-
         for(const auto& render : renderSystems) {
-            render->postPhysics();
+            scheduledSystems.push_back(render.get());
         }
+        return scheduledSystems;
     }
 
     static Carrot::RuntimeOption showWorldHierarchy("Debug/Show World hierarchy", false);
+    static Carrot::RuntimeOption showSystemSchedule("Debug/Show system schedule", false);
 
     void World::setupCamera(Carrot::Render::Context renderContext) {
         ZoneScoped;
@@ -334,21 +338,10 @@ namespace Carrot::ECS {
 
         updateEntityLists();
         {
-            ZoneScopedN("Logic");
-            for(const auto& logic : logicSystems) {
-                ZoneScopedN("LogicSystem");
-                ZoneText(typeid(*logic).name(), std::strlen(typeid(*logic).name()));
-                logic->onFrame(renderContext);
-            }
-        }
-
-        {
-            ZoneScopedN("Prepare render");
-            for(const auto& render : renderSystems) {
-                ZoneScopedN("RenderSystem");
-                ZoneText(typeid(*render).name(), std::strlen(typeid(*render).name()));
-                render->onFrame(renderContext);
-            }
+            ZoneScopedN("Logic & prepare render");
+            frameScheduler.run(gatherSystems(true), [&renderContext](System& system) {
+                system.onFrame(renderContext);
+            });
         }
 
         {
@@ -392,6 +385,16 @@ namespace Carrot::ECS {
                 }
                 ImGui::End();
             }
+
+            if(showSystemSchedule && renderContext.pViewport == &GetEngine().getMainViewport()) {
+                if(ImGui::Begin("System schedule", &showSystemSchedule.getValueRef())) {
+                    tickScheduler.debugDraw();
+                    prePhysicsScheduler.debugDraw();
+                    postPhysicsScheduler.debugDraw();
+                    frameScheduler.debugDraw();
+                }
+                ImGui::End();
+            }
         }
     }
 
@@ -732,6 +735,58 @@ namespace Carrot::ECS {
         return *this;
     }
 
+    void World::moveContentFrom(World& source) {
+        verify(&source != this, "Cannot move a world into itself");
+
+        queries.clear(); // make sure we don't reference entities that no longer exist
+        entitiesUpdated.clear();
+        entityParents = std::move(source.entityParents);
+        entityChildren = std::move(source.entityChildren);
+        entityNames = std::move(source.entityNames);
+        entityFlags = std::move(source.entityFlags);
+        entities = std::move(source.entities);
+        entitiesToAdd = std::move(source.entitiesToAdd);
+        entitiesToRemove = std::move(source.entitiesToRemove);
+        frozenLogic = source.frozenLogic;
+        entityComponents = std::move(source.entityComponents);
+
+        for(auto& [entityID, componentMap] : entityComponents) {
+            for(auto& [id, comp] : componentMap) {
+                comp->getEntity() = wrap(entityID);
+                comp->onWorldChanged();
+            }
+        }
+
+        // systems reference their world, so they cannot be moved
+        auto recreateSystems = [&](std::vector<std::unique_ptr<System>>& dest, std::vector<std::unique_ptr<System>>& src) {
+            dest.clear();
+            dest.resize(src.size());
+
+            for (std::size_t i = 0; i < src.size(); ++i) {
+                dest[i] = src[i]->duplicate(*this);
+                for(const auto& srcEntity : src[i]->entities) {
+                    dest[i]->entities.emplace_back(srcEntity.internalEntity, *this);
+                }
+                dest[i]->onEntitiesUpdated({});
+            }
+            src.clear();
+        };
+        recreateSystems(logicSystems, source.logicSystems);
+        recreateSystems(renderSystems, source.renderSystems);
+
+        // moved-from containers are in a valid but unspecified state
+        source.queries.clear();
+        source.entitiesUpdated.clear();
+        source.entityParents.clear();
+        source.entityChildren.clear();
+        source.entityNames.clear();
+        source.entityFlags.clear();
+        source.entities.clear();
+        source.entitiesToAdd.clear();
+        source.entitiesToRemove.clear();
+        source.entityComponents.clear();
+    }
+
     void World::reloadSystems() {
         for(auto& s : logicSystems) {
             s->reload();
@@ -12,6 +12,7 @@
 #include <engine/ecs/components/Component.h>
 #include <engine/ecs/systems/System.h>
 #include <engine/ecs/WorldData.h>
+#include <engine/ecs/SystemScheduler.h>
 #include <eventpp/callbacklist.h>
 
 #include "EntityTypes.h"
@@ -165,6 +166,13 @@ namespace Carrot::ECS {
     public:
         World& operator=(const World& toCopy);
 
+        /**
+         * Replaces the content of this world (entities, components and systems) with the content of 'source', which is left empty.
+         * Components are not duplicated but moved to this world, so this costs much less than a copy. Systems are recreated for this
+         * world, but not reloaded: call reloadSystems if needed.
+         */
+        void moveContentFrom(World& source);
+
     private:
         /// updates the systems entity list (based on entity signatures) called each tick and each frame
         /// (because components can be modified during a tick)
@@ -182,6 +190,9 @@ namespace Carrot::ECS {
          */
         void repairLinks(const Carrot::ECS::Entity& root, const std::unordered_map<Carrot::ECS::EntityID, Carrot::ECS::EntityID>& remap);
 
+        /// Fills 'scheduledSystems' with the logic systems (if requested) followed by the render systems, in the order they run sequentially
+        std::span<System* const> gatherSystems(bool includeLogic);
+
     private:
         WorldData worldData;
         std::vector<EntityID> entities;
@@ -198,11 +209,19 @@ namespace Carrot::ECS {
         std::vector<std::unique_ptr<System>> logicSystems;
         std::vector<std::unique_ptr<System>> renderSystems;
 
+        // systems which do not access the same components run in parallel
+        std::vector<System*> scheduledSystems;
+        SystemScheduler tickScheduler { "Tick" };
+        SystemScheduler prePhysicsScheduler { "Pre-physics" };
+        SystemScheduler postPhysicsScheduler { "Post-physics" };
+        SystemScheduler frameScheduler { "Frame" };
+
         bool frozenLogic = false;
 
         // used to invalidate structures that hold csharp components
         eventpp::CallbackList<void()>::Handle csharpLoadCallbackHandle;
         eventpp::CallbackList<void()>::Handle csharpUnloadCallbackHandle;
+        bool csharpCallbacksRegistered = false;
 
     private: // internal representation of hierarchy
         std::unordered_map<EntityID, EntityID> entityParents;
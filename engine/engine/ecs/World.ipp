@@ -1,6 +1,7 @@
 #include "World.h"
 #include <algorithm>
 #include <core/async/Counter.h>
+#include <core/tasks/Tasks.h>
 
 namespace Carrot::ECS {
     template<class Comp>
@@ -134,21 +135,13 @@ namespace Carrot::ECS {
     void SignedSystem<type, RequiredComponents...>::parallelForEachEntity(const std::function<void(Entity&, RequiredComponents&...)>& action) {
         if(entities.empty())
             return;
-        Async::Counter counter;
-        const std::size_t entityCount = entities.size();
-        const std::size_t stepSize = static_cast<std::size_t>(ceil((double)entityCount / concurrency()));
-        for(std::size_t index = 0; index < entityCount; index += stepSize) {
-            parallelSubmit([&, startIndex = index, endIndex = index + stepSize -1]() {
-                for(std::size_t localIndex = startIndex; localIndex <= endIndex && localIndex < entityCount; localIndex++) {
-                    auto& entity = entitiesWithComponents[localIndex];
-                    if (entity.entity) {
-                        // TODO: lift getComponentIndex out of loop
-                        action(entity.entity, (*((RequiredComponents*)entity.components[signature.getComponentIndex(RequiredComponents::getID())]))...);
-                    }
-                }
-            }, counter);
-        }
-
-        counter.busyWait();
+        // help-while-waiting: safe even if this system is itself running inside a task
+        Async::parallelFor(entitiesWithComponents.size(), [&](std::size_t localIndex) {
+            auto& entity = entitiesWithComponents[localIndex];
+            if (entity.entity) {
+                // TODO: lift getComponentIndex out of loop
+                action(entity.entity, (*((RequiredComponents*)entity.components[signature.getComponentIndex(RequiredComponents::getID())]))...);
+            }
+        }, 0);
     }
 }
\ No newline at end of file
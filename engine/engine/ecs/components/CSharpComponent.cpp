@@ -180,6 +180,14 @@ namespace Carrot::ECS {
         }
     }
 
+    void CSharpComponent::onWorldChanged() {
+        // the C# object references the previous world, recreate it with the current values of its properties
+        if(csComponent) {
+            serializedVersion = toJSON(serializedDoc);
+        }
+        refresh();
+    }
+
     void CSharpComponent::onAssemblyLoad() {
         refresh();
     }
@@ -25,6 +25,8 @@ namespace Carrot::ECS {
 
         virtual void repairLinks(const EntityRemappingFunction& remap) override;
 
+        virtual void onWorldChanged() override;
+
     public:
         /**
          * Returns the C# sharp of this component
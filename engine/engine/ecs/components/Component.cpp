@@ -18,6 +18,7 @@ namespace Carrot::ECS {
 
     void ComponentLibrary::remove(const Storage::ID& id) {
         storage.remove(id);
+        binaryCodecs.erase(id);
         // TODO: handle lua scripts?
     }
 
@@ -33,6 +34,18 @@ namespace Carrot::ECS {
         return storage.getAllIDs();
     }
 
+    bool ComponentLibrary::hasBinaryRepresentation(const Storage::ID& id) const {
+        return binaryCodecs.contains(id);
+    }
+
+    void ComponentLibrary::serialiseBinary(const Component& component, std::vector<std::uint8_t>& destination) const {
+        binaryCodecs.at(component.getName()).serialise(component, destination);
+    }
+
+    std::unique_ptr<Component> ComponentLibrary::deserialiseBinary(const Storage::ID& id, IO::VectorReader& reader, const Entity& entity) const {
+        return binaryCodecs.at(id).deserialise(reader, entity);
+    }
+
     void ComponentLibrary::registerBindings(sol::state& d, sol::usertype<Entity>& u) {
         for(const auto& f : usertypeDefinitionSuppliers) {
             f(d);
@@ -8,6 +8,7 @@
 #include <rapidjson/document.h>
 #include <utility>
 #include <core/utils/Library.hpp>
+#include <core/io/Serialisation.h>
 #include <sol/sol.hpp>
 
 namespace Carrot::Render {
@@ -41,6 +42,12 @@ namespace Carrot::ECS {
          */
         virtual void repairLinks(const EntityRemappingFunction& remap) {};
 
+        /**
+         * Called when this component is moved to another world without being duplicated (see World::moveContentFrom).
+         * getEntity() already references the new world when this is called.
+         */
+        virtual void onWorldChanged() {};
+
         virtual ~Component() = default;
 
         [[nodiscard]] virtual ComponentID getComponentTypeID() const = 0;
@@ -69,6 +76,13 @@ namespace Carrot::ECS {
         { T::registerUsertype(s) } -> std::convertible_to<void>;
     };
 
+    // Binary scene support (see engine/scene/BinaryScene.h). Components without a binary representation are stored as JSON
+    template<typename T>
+    concept BinarySerialisableComponent = requires(const T& component, std::vector<std::uint8_t>& destination)
+    {
+        { component.serialiseBinary(destination) } -> std::convertible_to<void>;
+    } && std::is_constructible_v<T, IO::VectorReader&, Entity>;
+
     class ComponentLibrary {
     private:
         using LuaBindingFunc = std::function<void(sol::state&, sol::usertype<Entity>&)>;
@@ -77,10 +91,22 @@ namespace Carrot::ECS {
     public:
         using ID = Storage::ID;
         using LuaUsertypeSupplier = std::function<void(sol::state&)>;
+        using BinarySerialiseFunction = std::function<void(const Component&, std::vector<std::uint8_t>&)>;
+        using BinaryDeserialiseFunction = std::function<std::unique_ptr<Component>(IO::VectorReader&, const Entity&)>;
 
         template<typename T> requires std::is_base_of_v<Component, T>
         void add() {
             storage.addUniquePtrBased<T>();
+            if constexpr(BinarySerialisableComponent<T>) {
+                binaryCodecs[T::getStringRepresentation()] = BinaryCodec {
+                    .serialise = [](const Component& component, std::vector<std::uint8_t>& destination) {
+                        static_cast<const T&>(component).serialiseBinary(destination);
+                    },
+                    .deserialise = [](IO::VectorReader& reader, const Entity& entity) -> std::unique_ptr<Component> {
+                        return std::make_unique<T>(reader, entity);
+                    },
+                };
+            }
             bindingFuncs.push_back([](sol::state& state, sol::usertype<Entity>& u) {
                 u.set(T::getStringRepresentation(), sol::property([](Entity& e) -> T* {
                     auto comp = e.getComponent<T>();
@@ -101,12 +127,27 @@ namespace Carrot::ECS {
         [[nodiscard]] std::unique_ptr<Component> create(const Storage::ID& id, const Entity& entity) const;
         [[nodiscard]] std::vector<std::string> getAllIDs() const;
 
+        /// Does the component with the given ID have a binary representation? If not, binary scenes store it as JSON
+        [[nodiscard]] bool hasBinaryRepresentation(const Storage::ID& id) const;
+
+        /// Appends the binary representation of 'component' to 'destination'. The component must have a binary representation
+        void serialiseBinary(const Component& component, std::vector<std::uint8_t>& destination) const;
+
+        /// Reads a component written by 'serialiseBinary'. Does not touch the world nor engine systems: can be called from any thread
+        [[nodiscard]] std::unique_ptr<Component> deserialiseBinary(const Storage::ID& id, IO::VectorReader& reader, const Entity& entity) const;
+
         void registerBindings(sol::state& d, sol::usertype<Entity>& uEntity);
 
         void remove(const Storage::ID& id);
 
     private:
+        struct BinaryCodec {
+            BinarySerialiseFunction serialise;
+            BinaryDeserialiseFunction deserialise;
+        };
+
         Storage storage;
+        std::unordered_map<Storage::ID, BinaryCodec> binaryCodecs;
         std::vector<LuaUsertypeSupplier> usertypeDefinitionSuppliers;
         std::vector<LuaBindingFunc> bindingFuncs;
     };
@@ -22,6 +22,10 @@ namespace Carrot::ECS {
             velocity = JSON::read<3, float>(json["velocity"]);
         };
 
+        explicit Kinematics(Carrot::IO::VectorReader& reader, Entity entity): Kinematics(std::move(entity)) {
+            reader >> velocity;
+        };
+
         rapidjson::Value toJSON(rapidjson::Document& doc) const override {
             rapidjson::Value obj(rapidjson::kObjectType);
 
@@ -30,6 +34,10 @@ namespace Carrot::ECS {
             return obj;
         }
 
+        void serialiseBinary(std::vector<std::uint8_t>& destination) const {
+            destination << velocity;
+        }
+
         const char *const getName() const override {
             return "Kinematics";
         }
@@ -10,14 +10,24 @@
 #include <engine/Engine.h>
 #include <engine/utils/Macros.h>
 #include <core/io/vfs/VirtualFileSystem.h>
+#include <engine/scripting/LuaScriptPool.h>
 
 namespace Carrot::ECS {
     LuaScriptComponent::LuaScriptComponent(const rapidjson::Value& json, Entity entity): LuaScriptComponent(entity) {
         for(const auto& element : json["scripts"].GetArray()) {
             const auto& scriptObject = element.GetObject();
-            IO::VFS::Path path = IO::VFS::Path(scriptObject["path"].GetString());
-            Carrot::IO::Resource resource = path;
-            scripts.emplace_back(path, std::make_unique<Lua::Script>(resource));
+            addScript(IO::VFS::Path(scriptObject["path"].GetString()));
+        }
+    }
+
+    void LuaScriptComponent::addScript(const IO::VFS::Path& path) {
+        ScriptInstance& instance = scripts.emplace_back();
+        instance.path = path;
+        instance.stateless = Lua::ScriptPool::instance().isStateless(path);
+        if(instance.stateless) {
+            hasStatelessScripts = true;
+        } else {
+            instance.pScript = std::make_unique<Lua::Script>(Carrot::IO::Resource(path));
         }
     }
 
@@ -25,9 +35,9 @@ namespace Carrot::ECS {
         rapidjson::Value data{rapidjson::kObjectType};
 
         rapidjson::Value paths{rapidjson::kArrayType};
-        for(const auto& [path, script] : scripts) {
+        for(const auto& script : scripts) {
             rapidjson::Value scriptObject{rapidjson::kObjectType};
-            scriptObject.AddMember("path", rapidjson::Value(path.toString().c_str(), doc.GetAllocator()), doc.GetAllocator());
+            scriptObject.AddMember("path", rapidjson::Value(script.path.toString().c_str(), doc.GetAllocator()), doc.GetAllocator());
             paths.PushBack(scriptObject, doc.GetAllocator());
         }
 
@@ -38,8 +48,8 @@ namespace Carrot::ECS {
 
     std::unique_ptr<Component> LuaScriptComponent::duplicate(const Entity& newOwner) const {
         std::unique_ptr<LuaScriptComponent> copy = std::make_unique<LuaScriptComponent>(newOwner);
-        for(const auto& [path, script] : scripts) {
-            copy->scripts.emplace_back(path, std::make_unique<Lua::Script>(Carrot::IO::Resource(path)));
+        for(const auto& script : scripts) {
+            copy->addScript(script.path);
         }
         return copy;
     }
@@ -9,9 +9,18 @@
 
 namespace Carrot::ECS {
     struct LuaScriptComponent: public IdentifiableComponent<LuaScriptComponent> {
-        using ScriptStorage = std::vector<std::pair<IO::VFS::Path, std::unique_ptr<Lua::Script>>>;
+        struct ScriptInstance {
+            IO::VFS::Path path;
+            std::unique_ptr<Lua::Script> pScript; // VM of this entity. nullptr for stateless scripts (run inside Lua::ScriptPool) and for invalid paths
+            bool stateless = false;
+        };
+        using ScriptStorage = std::vector<ScriptInstance>;
 
-        ScriptStorage scripts; // nullptrs are allowed (for invalid paths)
+        ScriptStorage scripts;
+
+        /// Adds the script at the given path. Scripts annotated with '--!stateless' are run inside the shared VMs of Lua::ScriptPool,
+        /// other scripts get their own VM
+        void addScript(const IO::VFS::Path& path);
 
         explicit LuaScriptComponent(Entity entity): IdentifiableComponent<LuaScriptComponent>(std::move(entity)) {}
 
@@ -26,6 +35,7 @@ namespace Carrot::ECS {
         std::unique_ptr<Component> duplicate(const Entity& newOwner) const override;
     private:
         bool firstTick = true;
+        bool hasStatelessScripts = false;
 
         friend class LuaRenderSystem;
         friend class LuaUpdateSystem;
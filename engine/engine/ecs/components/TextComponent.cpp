@@ -21,20 +21,15 @@ namespace Carrot::ECS {
         return text;
     }
 
-    void TextComponent::refreshRenderable() {
+    void TextComponent::refreshLayout() {
         if(needsRefresh) {
-            if(text.empty()) {
-                this->renderableText = std::move(Render::RenderableText{});
-            } else {
-                this->renderableText = font->bake(Carrot::toU32String(text));
-            }
+            metrics = font->layout(Carrot::toU32String(text), glyphs);
             needsRefresh = false;
         }
     }
 
     void TextComponent::setText(std::string_view text) {
-        previousText = this->text;
-        needsRefresh |= previousText != text;
+        needsRefresh |= this->text != text;
         this->text = text;
     }
 }
\ No newline at end of file
@@ -9,7 +9,7 @@
 #include "engine/render/VulkanRenderer.h"
 
 namespace Carrot::ECS {
-    /// Not meant for quickly changing text
+    /// Text rendered with the glyph atlas of its font: changing the text only requires a new layout, no GPU resource is created
     class TextComponent : public IdentifiableComponent<TextComponent> {
     public:
         explicit TextComponent(Entity entity, const std::filesystem::path& fontFile = "resources/fonts/Roboto-Medium.ttf"): IdentifiableComponent<TextComponent>(std::move(entity)), fontPath(fontFile), font(GetRenderer().getOrCreateFront(fontFile.string())) {};
@@ -34,15 +34,15 @@ namespace Carrot::ECS {
         }
 
     private:
-        void refreshRenderable();
+        void refreshLayout();
 
     private:
         bool needsRefresh = false;
         std::string text;
-        std::string previousText;
         std::filesystem::path fontPath;
         std::shared_ptr<Carrot::Render::Font> font;
-        Carrot::Render::RenderableText renderableText;
+        std::vector<Carrot::Render::GlyphQuad> glyphs;
+        Carrot::Render::TextMetrics metrics;
 
         friend class TextRenderSystem;
     };
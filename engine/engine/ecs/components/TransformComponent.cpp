@@ -22,10 +22,18 @@ namespace Carrot::ECS {
         localTransform.loadJSON(json);
     };
 
+    TransformComponent::TransformComponent(Carrot::IO::VectorReader& reader, Entity entity): TransformComponent(std::move(entity)) {
+        reader >> localTransform.position >> localTransform.rotation >> localTransform.scale;
+    }
+
     rapidjson::Value TransformComponent::toJSON(rapidjson::Document& doc) const {
         return localTransform.toJSON(doc.GetAllocator());
     }
 
+    void TransformComponent::serialiseBinary(std::vector<std::uint8_t>& destination) const {
+        destination << localTransform.position << localTransform.rotation << localTransform.scale;
+    }
+
     void TransformComponent::setGlobalTransform(const Carrot::Math::Transform& newTransform) {
         auto parent = getEntity().getParent();
         if(parent) {
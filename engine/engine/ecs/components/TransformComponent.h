@@ -21,8 +21,12 @@ namespace Carrot::ECS {
 
         explicit TransformComponent(const rapidjson::Value& json, Entity entity);
 
+        explicit TransformComponent(Carrot::IO::VectorReader& reader, Entity entity);
+
         rapidjson::Value toJSON(rapidjson::Document& doc) const override;
 
+        void serialiseBinary(std::vector<std::uint8_t>& destination) const;
+
         [[nodiscard]] glm::mat4 toTransformMatrix() const;
 
         const char *const getName() const override {
@@ -11,7 +11,10 @@
 namespace Carrot::ECS {
     class BillboardSystem: public RenderSystem<TransformComponent, Carrot::ECS::BillboardComponent>, public Identifiable<BillboardSystem> {
     public:
-        explicit BillboardSystem(World& world): RenderSystem<TransformComponent, BillboardComponent>(world) {}
+        explicit BillboardSystem(World& world): RenderSystem<TransformComponent, BillboardComponent>(world) {
+            declareReadOnly<BillboardComponent>();
+            allowParallelExecution();
+        }
         explicit BillboardSystem(const rapidjson::Value& json, World& world): BillboardSystem(world) {}
 
         void onFrame(Carrot::Render::Context renderContext) override;
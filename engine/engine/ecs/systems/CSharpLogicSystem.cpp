@@ -96,8 +96,8 @@ namespace Carrot::ECS {
             return;
         }
         if(*csSystem) {
-            void* args[1] { (void*)&dt };
-            csTickMethod->invoke(*csSystem, args);
+            // called every tick: avoid boxing 'dt' and going through mono_runtime_invoke
+            csTickMethod->invokeThunk<void, MonoObject*, double>((MonoObject*)*csSystem, dt);
         }
     }
 
@@ -146,6 +146,10 @@ namespace Carrot::ECS {
         return csEntities.get();
     }
 
+    std::shared_ptr<Scripting::CSObject> CSharpLogicSystem::getCSharpObject() const {
+        return csSystem;
+    }
+
     void CSharpLogicSystem::onAssemblyLoad() {
         init(true);
     }
@@ -35,6 +35,9 @@ namespace Carrot::ECS {
     public:
         Scripting::CSArray* getEntityList();
 
+        /// C# instance of the system, null if the class was not found in loaded assemblies
+        std::shared_ptr<Scripting::CSObject> getCSharpObject() const;
+
     private:
         /**
          * Loads the system from C# assemblies (engine + game)
@@ -4,6 +4,7 @@
 
 #include "LuaSystems.h"
 #include <core/io/Logging.hpp>
+#include <engine/scripting/LuaScriptPool.h>
 
 namespace Carrot::ECS {
     template<typename... Args>
@@ -17,34 +18,74 @@ namespace Carrot::ECS {
         }
     }
 
+    /// Entry points of the given script: from its own VM, or from the shared VM of the calling thread for stateless scripts
+    static const Lua::EntryPoints* getEntryPoints(const LuaScriptComponent::ScriptInstance& script) {
+        if(script.stateless) {
+            return Lua::ScriptPool::instance().getEntryPoints(script.path);
+        }
+        if(script.pScript) {
+            return &script.pScript->getEntryPoints();
+        }
+        return nullptr;
+    }
+
     void LuaUpdateSystem::tick(double dt) {
+        // no script is running yet: safe to destroy the shared VMs if a stateless script was modified
+        Lua::ScriptPool::instance().reloadModifiedScripts();
+
+        bool anyStateless = false;
+
+        // 'start' and scripts with their own VM: on this thread, in order
         forEachEntity([&](Entity& entity, LuaScriptComponent& component) {
             if(component.firstTick) {
-                for(const auto& [p, pScript] : component.scripts) {
-                    if(pScript) {
-                        runFunction(p, (*pScript)["start"], entity);
+                for(const auto& script : component.scripts) {
+                    if(const Lua::EntryPoints* pEntryPoints = getEntryPoints(script)) {
+                        runFunction(script.path, pEntryPoints->start, entity);
                     }
                 }
 
                 component.firstTick = false;
             }
 
-            for(const auto& [p, pScript] : component.scripts) {
-                if(pScript) {
-                    runFunction(p, (*pScript)["eachTick"], entity, dt);
+            for(const auto& script : component.scripts) {
+                if(script.pScript) {
+                    runFunction(script.path, script.pScript->getEntryPoints().eachTick, entity, dt);
+                }
+            }
+            anyStateless |= component.hasStatelessScripts;
+        });
+
+        if(!anyStateless) {
+            return;
+        }
+
+        // stateless scripts: entities are independent, each thread uses its own VM
+        parallelForEachEntity([&](Entity& entity, LuaScriptComponent& component) {
+            if(!component.hasStatelessScripts) {
+                return;
+            }
+            for(const auto& script : component.scripts) {
+                if(script.stateless) {
+                    if(const Lua::EntryPoints* pEntryPoints = Lua::ScriptPool::instance().getEntryPoints(script.path)) {
+                        runFunction(script.path, pEntryPoints->eachTick, entity, dt);
+                    }
                 }
             }
         });
     }
 
+    void LuaUpdateSystem::unload() {
+        Lua::ScriptPool::instance().clear();
+    }
+
     void LuaUpdateSystem::broadcastStartEvent() {
     }
 
     void LuaUpdateSystem::broadcastStopEvent() {
         forEachEntity([&](Entity& entity, LuaScriptComponent& component) {
-            for(const auto& [p, pScript] : component.scripts) {
-                if(pScript) {
-                    runFunction(p, (*pScript)["stop"], entity);
+            for(const auto& script : component.scripts) {
+                if(const Lua::EntryPoints* pEntryPoints = getEntryPoints(script)) {
+                    runFunction(script.path, pEntryPoints->stop, entity);
                 }
             }
         });
@@ -52,9 +93,9 @@ namespace Carrot::ECS {
 
     void LuaRenderSystem::onFrame(Carrot::Render::Context renderContext) {
         forEachEntity([&](Entity& entity, LuaScriptComponent& component) {
-            for(const auto& [p, pScript] : component.scripts) {
-                if(pScript) {
-                    runFunction(p, (*pScript)["eachFrame"], entity, renderContext);
+            for(const auto& script : component.scripts) {
+                if(const Lua::EntryPoints* pEntryPoints = getEntryPoints(script)) {
+                    runFunction(script.path, pEntryPoints->eachFrame, entity, renderContext);
                 }
             }
         });
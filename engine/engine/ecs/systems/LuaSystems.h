@@ -14,6 +14,9 @@ namespace Carrot::ECS {
 
         void tick(double dt) override;
 
+        /// Destroys the shared VMs of stateless scripts (Lua::ScriptPool), they are reloaded when the next scene runs them
+        void unload() override;
+
         std::unique_ptr<System> duplicate(World& newOwner) const override {
             return std::make_unique<LuaUpdateSystem>(newOwner);
         }
@@ -5,6 +5,7 @@
 #include "SpriteRenderSystem.h"
 #include <engine/vulkan/CustomTracyVulkan.h>
 #include <engine/render/GBufferDrawData.h>
+#include <engine/utils/Profiling.h>
 
 namespace Carrot::ECS {
     void SpriteRenderSystem::transparentGBufferRender(const vk::RenderPass& renderPass, Carrot::Render::Context renderContext, vk::CommandBuffer& commands) {
@@ -20,21 +21,22 @@ namespace Carrot::ECS {
     }
 
     void SpriteRenderSystem::onFrame(Carrot::Render::Context renderContext) {
-        forEachEntity([&](Entity& entity, TransformComponent& transform, SpriteComponent& spriteComp) {
+        ZoneScoped;
+        batcher.begin(entitiesWithComponents.size());
+        parallelForEachEntity([&](Entity& entity, TransformComponent& transform, SpriteComponent& spriteComp) {
             if(!entity.isVisible()) {
                 return;
             }
 
             if(spriteComp.sprite) {
-                updateSprite(renderContext, transform, *spriteComp.sprite);
+                Carrot::Render::Sprite& sprite = *spriteComp.sprite;
+                sprite.parentTransform = transform.toTransformMatrix();
+                if(!batcher.add(sprite, entity.getID())) {
+                    sprite.onFrame(renderContext);
+                }
             }
         });
-    }
-
-    void SpriteRenderSystem::updateSprite(Carrot::Render::Context renderContext, const TransformComponent& transform, Carrot::Render::Sprite& sprite) {
-        ZoneScoped;
-        sprite.parentTransform = transform.toTransformMatrix();
-        sprite.onFrame(renderContext);
+        batcher.submit(renderContext);
     }
 
     void SpriteRenderSystem::tick(double dt) {
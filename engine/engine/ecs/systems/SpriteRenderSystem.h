@@ -7,6 +7,7 @@
 #include <engine/ecs/systems/System.h>
 #include <engine/ecs/components/TransformComponent.h>
 #include <engine/ecs/components/SpriteComponent.h>
+#include <engine/render/SpriteBatcher.h>
 
 namespace Carrot::ECS {
     class SpriteRenderSystem: public RenderSystem<TransformComponent, Carrot::ECS::SpriteComponent>, public Identifiable<SpriteRenderSystem> {
@@ -34,7 +35,9 @@ namespace Carrot::ECS {
 
     private:
         void setupEntityData(const Entity& entity, const Carrot::Render::Sprite& sprite, const Carrot::Render::Context& renderContext, vk::CommandBuffer& commands);
-        void updateSprite(Carrot::Render::Context renderContext, const TransformComponent& transform, Carrot::Render::Sprite& sprite);
+
+        /// Sprites whose texture is inside the sprite atlas are drawn together, others are drawn one by one
+        Carrot::Render::SpriteBatcher batcher;
     };
 }
 
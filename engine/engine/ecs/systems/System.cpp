@@ -17,6 +17,14 @@ namespace Carrot::ECS {
         return entities;
     }
 
+    const Async::ResourceAccess& System::getComponentAccess() const {
+        return componentAccess;
+    }
+
+    void System::allowParallelExecution() {
+        componentAccess.exclusive = false;
+    }
+
     void System::onEntitiesAdded(const std::vector<EntityID>& added) {
         bool changed = false;
         for(const auto& e : added) {
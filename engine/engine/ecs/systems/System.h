@@ -8,6 +8,7 @@
 #include "engine/render/RenderContext.h"
 #include <engine/render/RenderPass.h>
 #include <core/utils/Library.hpp>
+#include <core/tasks/AccessGraph.h>
 
 namespace Carrot::Async {
     class Counter;
@@ -30,6 +31,10 @@ namespace Carrot::ECS {
         [[nodiscard]] const Signature& getSignature() const;
         std::span<const Entity> getEntities() const;
 
+        /// Components read and written by this system. World uses them to run systems which do not access the same components at the same time.
+        /// Exclusive by default: systems which do not call allowParallelExecution are run on the calling thread, one after the other.
+        [[nodiscard]] const Async::ResourceAccess& getComponentAccess() const;
+
         virtual void onFrame(Carrot::Render::Context renderContext) = 0;
         virtual void setupCamera(Carrot::Render::Context renderContext) {};
         virtual void tick(double dt) {};
@@ -89,9 +94,27 @@ namespace Carrot::ECS {
         void parallelSubmit(const std::function<void()>& action, Async::Counter& counter);
         static std::size_t concurrency(); // avoids to include TaskScheduler
 
+    protected: // access declaration, to call from constructors
+        /// Components of the signature of this system which are only read. Components of the signature are considered written by default
+        template<typename... Components>
+        void declareReadOnly();
+
+        /// Components read by this system outside of its signature (for instance through other entities, like parents)
+        template<typename... Components>
+        void declareReads();
+
+        /// Components written by this system outside of its signature
+        template<typename... Components>
+        void declareWrites();
+
+        /// Allows World to run this system on a worker thread, at the same time as other systems which do not conflict with it.
+        /// Only call this if the system accesses nothing else than its declared components and thread-safe parts of the engine (render packets, etc.)
+        void allowParallelExecution();
+
     protected:
         World& world;
         Signature signature;
+        Async::ResourceAccess componentAccess;
         std::vector<Entity> entities;
         std::vector<EntityWithComponents> entitiesWithComponents;
 
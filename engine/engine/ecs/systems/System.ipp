@@ -6,9 +6,28 @@
 #include "engine/ecs/World.h"
 
 namespace Carrot::ECS {
+    static_assert(MAX_COMPONENTS <= Async::ResourceAccess::MaxResources, "Each component type needs its own bit in ResourceAccess");
+
+    template<typename... Components>
+    void System::declareReadOnly() {
+        ((componentAccess.writes.reset(Signature::getIndex(Components::getID())),
+          componentAccess.reads.set(Signature::getIndex(Components::getID()))), ...);
+    }
+
+    template<typename... Components>
+    void System::declareReads() {
+        (componentAccess.reads.set(Signature::getIndex(Components::getID())), ...);
+    }
+
+    template<typename... Components>
+    void System::declareWrites() {
+        (componentAccess.writes.set(Signature::getIndex(Components::getID())), ...);
+    }
+
     template<SystemType type, typename... RequiredComponents>
     SignedSystem<type, RequiredComponents...>::SignedSystem(World& world): System(world) {
         signature.addComponents<RequiredComponents...>();
+        declareWrites<RequiredComponents...>();
     }
 
 }
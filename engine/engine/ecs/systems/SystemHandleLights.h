@@ -11,7 +11,10 @@
 namespace Carrot::ECS {
     class SystemHandleLights: public RenderSystem<TransformComponent, LightComponent>, public Identifiable<SystemHandleLights> {
     public:
-        explicit SystemHandleLights(World& world): RenderSystem<TransformComponent, LightComponent>(world) {}
+        explicit SystemHandleLights(World& world): RenderSystem<TransformComponent, LightComponent>(world) {
+            declareReadOnly<TransformComponent>();
+            allowParallelExecution();
+        }
         explicit SystemHandleLights(const rapidjson::Value& json, World& world): SystemHandleLights(world) {}
 
         void onFrame(Carrot::Render::Context) override;
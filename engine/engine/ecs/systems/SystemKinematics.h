@@ -11,7 +11,10 @@
 namespace Carrot::ECS {
     class SystemKinematics: public LogicSystem<TransformComponent, Kinematics>, public Identifiable<SystemKinematics> {
     public:
-        explicit SystemKinematics(World& world): LogicSystem<TransformComponent, Kinematics>(world) {}
+        explicit SystemKinematics(World& world): LogicSystem<TransformComponent, Kinematics>(world) {
+            declareReadOnly<Kinematics>();
+            allowParallelExecution();
+        }
         explicit SystemKinematics(const rapidjson::Value& json, World& world): SystemKinematics(world) {}
 
         void tick(double dt) override;
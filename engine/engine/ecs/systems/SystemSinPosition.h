@@ -11,7 +11,10 @@
 namespace Carrot::ECS {
     class SystemSinPosition: public LogicSystem<TransformComponent, ForceSinPosition>, public Identifiable<SystemSinPosition> {
     public:
-        explicit SystemSinPosition(World& world): LogicSystem<TransformComponent, ForceSinPosition>(world) {}
+        explicit SystemSinPosition(World& world): LogicSystem<TransformComponent, ForceSinPosition>(world) {
+            declareReadOnly<ForceSinPosition>();
+            allowParallelExecution();
+        }
         explicit SystemSinPosition(const rapidjson::Value& json, World& world): SystemSinPosition(world) {}
 
         void tick(double dt) override;
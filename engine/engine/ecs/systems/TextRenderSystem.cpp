@@ -14,10 +14,10 @@ namespace Carrot::ECS {
                 return;
             }
 
-            textComponent.refreshRenderable();
-            textComponent.renderableText.getTransform() = transform.toTransformMatrix();
-            textComponent.renderableText.render(renderContext);
+            textComponent.refreshLayout();
+            batcher.add(*textComponent.font, textComponent.glyphs, transform.toTransformMatrix(), glm::vec4{1.0f}, entity.getID());
         });
+        batcher.submit(renderContext);
     }
 
     std::unique_ptr<System> TextRenderSystem::duplicate(World& newOwner) const {
@@ -7,6 +7,7 @@
 #include <engine/ecs/systems/System.h>
 #include <engine/ecs/components/TransformComponent.h>
 #include <engine/ecs/components/TextComponent.h>
+#include <engine/render/TextBatcher.h>
 
 namespace Carrot::ECS {
     class TextRenderSystem: public RenderSystem<TransformComponent, Carrot::ECS::TextComponent>, public Identifiable<TextRenderSystem> {
@@ -26,6 +27,9 @@ namespace Carrot::ECS {
         virtual const char* getName() const override {
             return getStringRepresentation();
         }
+
+    private:
+        Render::TextBatcher batcher;
     };
 }
 
@@ -0,0 +1,15 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "ReplicationPackets.h"
+
+namespace Carrot::Network {
+    Protocol& ReplicationPackets::addServerBoundPackets(Protocol& protocol) {
+        return protocol.with<ReplicationPackets::PacketIDs::AcknowledgeSnapshotID, ReplicationPackets::AcknowledgeSnapshot>();
+    }
+
+    Protocol& ReplicationPackets::addClientBoundPackets(Protocol& protocol) {
+        return protocol.with<ReplicationPackets::PacketIDs::SnapshotID, ReplicationPackets::Snapshot>();
+    }
+}
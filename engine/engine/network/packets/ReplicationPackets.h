@@ -0,0 +1,63 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <engine/network/Packet.hpp>
+#include <engine/network/replication/Snapshots.h>
+
+namespace Carrot::Network {
+    /// Packets used by WorldReplicator and WorldReplica. Games add them to their play protocol with addServerBoundPackets and addClientBoundPackets
+    struct ReplicationPackets {
+        enum PacketIDs: PacketID {
+            // far from the IDs games use for their own packets
+            FirstID = 0x7E000000,
+
+            // Server-bound
+            AcknowledgeSnapshotID = FirstID,
+
+            // Client-bound
+            SnapshotID,
+        };
+
+        static Protocol& addServerBoundPackets(Protocol& protocol);
+        static Protocol& addClientBoundPackets(Protocol& protocol);
+
+        class AcknowledgeSnapshot: public Packet {
+        public:
+            Replication::Tick tick = 0;
+
+            explicit AcknowledgeSnapshot(): Packet(ReplicationPackets::PacketIDs::AcknowledgeSnapshotID) {}
+            explicit AcknowledgeSnapshot(Replication::Tick tick): Packet(ReplicationPackets::PacketIDs::AcknowledgeSnapshotID), tick(tick) {}
+
+        protected:
+            void writeAdditional(std::vector<std::uint8_t>& data) const override {
+                data << tick;
+            }
+
+            void readAdditional(const std::vector<std::uint8_t>& data) override {
+                IO::VectorReader r{data};
+                r >> tick;
+            }
+        };
+
+        /// Snapshot written by Replication::SnapshotWriter, already packed: stored as-is
+        class Snapshot: public Packet {
+        public:
+            std::vector<std::uint8_t> snapshot;
+
+            explicit Snapshot(): Packet(ReplicationPackets::PacketIDs::SnapshotID) {}
+            explicit Snapshot(std::vector<std::uint8_t>&& snapshot): Packet(ReplicationPackets::PacketIDs::SnapshotID), snapshot(std::move(snapshot)) {}
+
+        protected:
+            void writeAdditional(std::vector<std::uint8_t>& data) const override {
+                data.insert(data.end(), snapshot.begin(), snapshot.end());
+            }
+
+            void readAdditional(const std::vector<std::uint8_t>& data) override {
+                snapshot = data;
+            }
+        };
+    };
+}
@@ -0,0 +1,462 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "Snapshots.h"
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <stdexcept>
+#include <core/utils/Assert.h>
+
+namespace Carrot::Network::Replication {
+    /// Snapshots which are never acknowledged are forgotten after this count, their contents will be sent again anyway
+    static constexpr std::size_t MaxInFlightSnapshots = 64;
+
+    /// Schema hash + tick + record count (as a varuint)
+    static constexpr std::size_t MaxHeaderBits = 16 + 32 + 5 * 8;
+
+    static void writeMask(IO::BitWriter& output, std::uint64_t mask, std::size_t componentCount) {
+        for(std::size_t offset = 0; offset < componentCount; offset += 32) {
+            const std::uint8_t count = static_cast<std::uint8_t>(std::min<std::size_t>(32, componentCount - offset));
+            output.write(static_cast<std::uint32_t>(mask >> offset), count);
+        }
+    }
+
+    static std::uint64_t readMask(IO::BitReader& input, std::size_t componentCount) {
+        std::uint64_t mask = 0;
+        for(std::size_t offset = 0; offset < componentCount; offset += 32) {
+            const std::uint8_t count = static_cast<std::uint8_t>(std::min<std::size_t>(32, componentCount - offset));
+            mask |= static_cast<std::uint64_t>(input.read(count)) << offset;
+        }
+        return mask;
+    }
+
+    std::uint16_t Schema::computeHash() const {
+        // FNV-1a
+        std::uint32_t hash = 2166136261u;
+        auto add = [&](std::uint32_t value) {
+            for(std::size_t i = 0; i < sizeof(value); i++) {
+                hash ^= (value >> (i * 8)) & 0xFF;
+                hash *= 16777619u;
+            }
+        };
+        auto addString = [&](const std::string& str) {
+            for(char c : str) {
+                add(static_cast<std::uint8_t>(c));
+            }
+            add(static_cast<std::uint32_t>(str.size()));
+        };
+
+        add(static_cast<std::uint32_t>(components.size()));
+        for(const auto& component : components) {
+            addString(component.name);
+            add(static_cast<std::uint32_t>(component.fields.size()));
+            for(const auto& field : component.fields) {
+                addString(field.name);
+                add(std::bit_cast<std::uint32_t>(field.quantization.min));
+                add(std::bit_cast<std::uint32_t>(field.quantization.max));
+                add(field.quantization.bits);
+            }
+        }
+        return static_cast<std::uint16_t>((hash >> 16) ^ (hash & 0xFFFF));
+    }
+
+    SnapshotWriter::SnapshotWriter(const Schema& schema): schema(schema), schemaHash(schema.computeHash()) {
+        verify(schema.components.size() <= Schema::MaxComponents, "Too many replicated components");
+    }
+
+    void SnapshotWriter::setBudget(std::size_t bytesPerSnapshot) {
+        budget = bytesPerSnapshot;
+    }
+
+    std::size_t SnapshotWriter::getBudget() const {
+        return budget;
+    }
+
+    const SnapshotStatistics& SnapshotWriter::getLastStatistics() const {
+        return lastStatistics;
+    }
+
+    std::size_t SnapshotWriter::getInFlightCount() const {
+        return inFlight.size();
+    }
+
+    bool SnapshotWriter::writeRecord(NetID id, const EntityState* pState, EntityBaseline& baseline, IO::BitWriter& output, SentRecord& record) const {
+        record.id = id;
+        output.writeVarUInt(id);
+        output.writeBool(pState == nullptr);
+        if(pState == nullptr) {
+            record.destroyed = true;
+            return true;
+        }
+
+        bool hasChanges = false;
+        const bool created = !baseline.known;
+        output.writeBool(created);
+        if(created) {
+            for(std::uint8_t i = 0; i < 4; i++) {
+                output.write(pState->entityID.data(i), 32);
+            }
+            record.created = true;
+            hasChanges = true;
+        }
+
+        const std::size_t componentCount = schema.components.size();
+        const bool maskChanged = !baseline.maskSynced || baseline.componentMask != pState->componentMask;
+        output.writeBool(maskChanged);
+        if(maskChanged) {
+            writeMask(output, pState->componentMask, componentCount);
+            record.maskSent = true;
+            record.componentMask = pState->componentMask;
+            hasChanges = true;
+        }
+
+        baseline.fields.resize(componentCount);
+        for(std::size_t componentIndex = 0; componentIndex < componentCount; componentIndex++) {
+            auto& fieldBaselines = baseline.fields[componentIndex];
+            if(!pState->hasComponent(componentIndex)) {
+                // the client drops the values of removed components: send everything again if the component comes back
+                fieldBaselines.clear();
+                continue;
+            }
+
+            const auto& fields = schema.components[componentIndex].fields;
+            const auto& values = pState->components[componentIndex];
+            verify(values.size() == fields.size(), "Component values do not match schema");
+            fieldBaselines.resize(fields.size());
+
+            bool componentChanged = false;
+            for(std::size_t fieldIndex = 0; fieldIndex < fields.size(); fieldIndex++) {
+                const auto& fieldBaseline = fieldBaselines[fieldIndex];
+                if(!fieldBaseline.synced || fieldBaseline.value != values[fieldIndex]) {
+                    componentChanged = true;
+                    break;
+                }
+            }
+
+            output.writeBool(componentChanged);
+            if(!componentChanged) {
+                continue;
+            }
+            hasChanges = true;
+            for(std::size_t fieldIndex = 0; fieldIndex < fields.size(); fieldIndex++) {
+                const auto& fieldBaseline = fieldBaselines[fieldIndex];
+                const bool fieldChanged = !fieldBaseline.synced || fieldBaseline.value != values[fieldIndex];
+                output.writeBool(fieldChanged);
+                if(fieldChanged) {
+                    output.write(values[fieldIndex], fields[fieldIndex].quantization.bits);
+                    record.fields.push_back(SentField {
+                        .component = static_cast<std::uint16_t>(componentIndex),
+                        .field = static_cast<std::uint16_t>(fieldIndex),
+                        .value = values[fieldIndex],
+                    });
+                }
+            }
+        }
+        return hasChanges;
+    }
+
+    void SnapshotWriter::markSent(Tick tick, EntityBaseline& baseline, const SentRecord& record) {
+        baseline.sent = true;
+        baseline.priority = 0.0f;
+        if(record.destroyed) {
+            baseline.destroyLastSent = tick;
+            return;
+        }
+        if(record.maskSent) {
+            baseline.maskLastSent = tick;
+            baseline.maskSynced = false;
+        }
+        for(const auto& field : record.fields) {
+            auto& fieldBaseline = baseline.fields[field.component][field.field];
+            fieldBaseline.lastSent = tick;
+            fieldBaseline.synced = false;
+        }
+    }
+
+    std::vector<std::uint8_t> SnapshotWriter::write(Tick tick, const WorldState& state, const RelevanceFunction& relevance) {
+        struct Candidate {
+            EntityBaseline* pBaseline = nullptr;
+            float priority = 0.0f;
+            IO::BitWriter bits;
+            SentRecord record;
+        };
+
+        lastStatistics = {};
+        std::vector<Candidate> candidates;
+        candidates.reserve(state.size());
+
+        for(const auto& [id, entityState] : state) {
+            auto& baseline = baselines[id];
+            Candidate candidate;
+            if(!writeRecord(id, &entityState, baseline, candidate.bits, candidate.record)) {
+                continue;
+            }
+            baseline.priority += relevance ? relevance(id, entityState) : 1.0f;
+            candidate.pBaseline = &baseline;
+            candidate.priority = baseline.priority;
+            candidates.push_back(std::move(candidate));
+        }
+
+        for(auto it = baselines.begin(); it != baselines.end();) {
+            if(state.contains(it->first)) {
+                ++it;
+                continue;
+            }
+            if(!it->second.sent) {
+                it = baselines.erase(it);
+                continue;
+            }
+
+            // destroyed entity the client may know about: always sent first, until acknowledged
+            Candidate candidate;
+            writeRecord(it->first, nullptr, it->second, candidate.bits, candidate.record);
+            candidate.pBaseline = &it->second;
+            candidate.priority = std::numeric_limits<float>::max();
+            candidates.push_back(std::move(candidate));
+            ++it;
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            if(a.priority != b.priority) {
+                return a.priority > b.priority;
+            }
+            return a.record.id < b.record.id;
+        });
+
+        SentSnapshot sent;
+        sent.tick = tick;
+        IO::BitWriter body;
+        for(auto& candidate : candidates) {
+            if(budget != 0 && MaxHeaderBits + body.getBitCount() + candidate.bits.getBitCount() > budget * 8) {
+                // smaller records may still fit
+                lastStatistics.entitiesDeferred++;
+                continue;
+            }
+            body.append(candidate.bits);
+            markSent(tick, *candidate.pBaseline, candidate.record);
+            sent.records.push_back(std::move(candidate.record));
+        }
+
+        IO::BitWriter output;
+        output.write(schemaHash, 16);
+        output.write(tick, 32);
+        output.writeVarUInt(static_cast<std::uint32_t>(sent.records.size()));
+        output.append(body);
+
+        lastStatistics.entitiesWritten = sent.records.size();
+        lastStatistics.bytes = output.getByteCount();
+
+        if(!sent.records.empty()) {
+            inFlight.push_back(std::move(sent));
+            if(inFlight.size() > MaxInFlightSnapshots) {
+                inFlight.pop_front();
+            }
+        }
+        return output.getBytes();
+    }
+
+    void SnapshotWriter::acknowledge(Tick tick) {
+        if(lastAcknowledged.has_value() && tick <= lastAcknowledged.value()) {
+            return;
+        }
+        // older snapshots were either lost or superseded by this one: their contents are sent again if needed
+        while(!inFlight.empty() && inFlight.front().tick < tick) {
+            inFlight.pop_front();
+        }
+        if(inFlight.empty() || inFlight.front().tick != tick) {
+            return;
+        }
+        lastAcknowledged = tick;
+
+        for(const auto& record : inFlight.front().records) {
+            auto it = baselines.find(record.id);
+            if(it == baselines.end()) {
+                continue;
+            }
+            auto& baseline = it->second;
+            if(record.destroyed) {
+                if(baseline.destroyLastSent == tick) {
+                    baselines.erase(it);
+                }
+                continue;
+            }
+
+            if(record.created) {
+                baseline.known = true;
+            }
+            if(record.maskSent && baseline.maskLastSent == tick) {
+                baseline.componentMask = record.componentMask;
+                baseline.maskSynced = true;
+            }
+            for(const auto& field : record.fields) {
+                // values of components removed since are forgotten
+                if(field.component >= baseline.fields.size() || field.field >= baseline.fields[field.component].size()) {
+                    continue;
+                }
+                auto& fieldBaseline = baseline.fields[field.component][field.field];
+                // only the most recent value sent is known to be on the client
+                if(fieldBaseline.lastSent == tick) {
+                    fieldBaseline.value = field.value;
+                    fieldBaseline.synced = true;
+                }
+            }
+        }
+        inFlight.pop_front();
+    }
+
+    SnapshotReader::SnapshotReader(const Schema& schema): schema(schema), schemaHash(schema.computeHash()) {
+        verify(schema.components.size() <= Schema::MaxComponents, "Too many replicated components");
+    }
+
+    const WorldState& SnapshotReader::getState() const {
+        return state;
+    }
+
+    std::optional<Tick> SnapshotReader::read(std::span<const std::uint8_t> snapshot, std::vector<EntityChange>& changes) {
+        struct ReadField {
+            std::uint16_t component = 0;
+            std::uint16_t field = 0;
+            std::uint32_t value = 0;
+        };
+        struct ReadRecord {
+            NetID id = 0;
+            bool destroyed = false;
+            bool created = false;
+            Carrot::UUID entityID = Carrot::UUID::null();
+            bool maskSent = false;
+            std::uint64_t componentMask = 0;
+            std::vector<ReadField> fields;
+        };
+
+        IO::BitReader input { snapshot };
+        const std::uint16_t hash = static_cast<std::uint16_t>(input.read(16));
+        const Tick tick = input.read(32);
+        if(input.hasOverflowed()) {
+            throw std::runtime_error("Truncated snapshot header");
+        }
+        if(hash != schemaHash) {
+            throw std::runtime_error("Snapshot was written with a different replication schema");
+        }
+        if(lastTick.has_value() && tick <= lastTick.value()) {
+            return {};
+        }
+
+        const std::size_t componentCount = schema.components.size();
+        const std::uint64_t validMask = componentCount == 64 ? ~0ull : (1ull << componentCount) - 1;
+
+        // read everything before applying anything, to keep the state intact if the snapshot is malformed
+        const std::uint32_t recordCount = input.readVarUInt();
+        std::vector<ReadRecord> records;
+        records.reserve(std::min<std::size_t>(recordCount, input.getRemainingBits()));
+        for(std::uint32_t recordIndex = 0; recordIndex < recordCount && !input.hasOverflowed(); recordIndex++) {
+            ReadRecord& record = records.emplace_back();
+            record.id = input.readVarUInt();
+            record.destroyed = input.readBool();
+            if(record.destroyed) {
+                continue;
+            }
+
+            record.created = input.readBool();
+            if(record.created) {
+                std::uint32_t data[4];
+                for(auto& d : data) {
+                    d = input.read(32);
+                }
+                record.entityID = Carrot::UUID { data[0], data[1], data[2], data[3] };
+            }
+
+            auto existing = state.find(record.id);
+            if(!record.created && existing == state.end()) {
+                throw std::runtime_error("Snapshot updates an unknown entity: " + std::to_string(record.id));
+            }
+
+            record.maskSent = input.readBool();
+            if(record.maskSent) {
+                record.componentMask = readMask(input, componentCount);
+            } else {
+                record.componentMask = existing != state.end() ? existing->second.componentMask : 0;
+            }
+            if((record.componentMask & ~validMask) != 0) {
+                throw std::runtime_error("Invalid component mask inside snapshot");
+            }
+
+            for(std::size_t componentIndex = 0; componentIndex < componentCount; componentIndex++) {
+                if((record.componentMask & (1ull << componentIndex)) == 0) {
+                    continue;
+                }
+                if(!input.readBool()) {
+                    continue;
+                }
+                const auto& fields = schema.components[componentIndex].fields;
+                for(std::size_t fieldIndex = 0; fieldIndex < fields.size(); fieldIndex++) {
+                    if(input.readBool()) {
+                        record.fields.push_back(ReadField {
+                            .component = static_cast<std::uint16_t>(componentIndex),
+                            .field = static_cast<std::uint16_t>(fieldIndex),
+                            .value = input.read(fields[fieldIndex].quantization.bits),
+                        });
+                    }
+                }
+            }
+        }
+        if(input.hasOverflowed()) {
+            throw std::runtime_error("Truncated snapshot");
+        }
+
+        for(auto& record : records) {
+            if(record.destroyed) {
+                auto it = state.find(record.id);
+                if(it != state.end()) {
+                    changes.push_back(EntityChange {
+                        .id = record.id,
+                        .type = EntityChange::Type::Destroyed,
+                        .entityID = it->second.entityID,
+                        .removedComponents = it->second.componentMask,
+                    });
+                    state.erase(it);
+                }
+                continue;
+            }
+
+            auto [it, inserted] = state.try_emplace(record.id);
+            EntityState& entity = it->second;
+            EntityChange change {
+                .id = record.id,
+                .type = inserted ? EntityChange::Type::Created : EntityChange::Type::Updated,
+            };
+            if(inserted) {
+                entity.entityID = record.entityID;
+                entity.components.resize(componentCount);
+            }
+            change.entityID = entity.entityID;
+
+            if(record.maskSent) {
+                change.addedComponents = record.componentMask & ~entity.componentMask;
+                change.removedComponents = entity.componentMask & ~record.componentMask;
+                for(std::size_t componentIndex = 0; componentIndex < componentCount; componentIndex++) {
+                    const std::uint64_t bit = 1ull << componentIndex;
+                    if(change.removedComponents & bit) {
+                        entity.components[componentIndex].clear();
+                    } else if(change.addedComponents & bit) {
+                        entity.components[componentIndex].assign(schema.components[componentIndex].fields.size(), 0);
+                    }
+                }
+                entity.componentMask = record.componentMask;
+            }
+
+            for(const auto& field : record.fields) {
+                entity.components[field.component][field.field] = field.value;
+                change.changedComponents |= 1ull << field.component;
+            }
+
+            if(inserted || change.addedComponents != 0 || change.removedComponents != 0 || change.changedComponents != 0) {
+                changes.push_back(change);
+            }
+        }
+
+        lastTick = tick;
+        return tick;
+    }
+}
@@ -0,0 +1,183 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <core/io/BitStream.h>
+#include <core/utils/UUID.h>
+
+/**
+ * Delta-compressed snapshots of replicated state, independent of the ECS (see WorldReplication.h for the ECS side).
+ *
+ * The server keeps, for each client, the state the client acknowledged (its baseline). Each tick, only the fields which differ from
+ * the baseline are sent, quantized and bit-packed. Fields stay in every snapshot until a snapshot containing them is acknowledged,
+ * so lost snapshots do not need to be detected, and clients can ignore snapshots older than the last one they applied.
+ */
+namespace Carrot::Network::Replication {
+    /// Identifier of a replicated entity inside snapshots, smaller than its UUID
+    using NetID = std::uint32_t;
+    using Tick = std::uint32_t;
+
+    struct FieldSchema {
+        std::string name;
+        IO::Quantization quantization;
+    };
+
+    struct ComponentSchema {
+        std::string name;
+        std::vector<FieldSchema> fields;
+    };
+
+    /// Replicated components, in the same order on the server and on clients
+    struct Schema {
+        static constexpr std::size_t MaxComponents = 64;
+
+        std::vector<ComponentSchema> components;
+
+        /// Hash of names, field counts and quantization, sent with each snapshot to detect mismatched schemas
+        std::uint16_t computeHash() const;
+    };
+
+    /// Replicated state of an entity: quantized values of each replicated component it has
+    struct EntityState {
+        Carrot::UUID entityID = Carrot::UUID::null();
+        std::uint64_t componentMask = 0; //< bit i is set if the entity has the i-th component of the schema
+        std::vector<std::vector<std::uint32_t>> components; //< one entry per component of the schema, values of its fields (empty if absent)
+
+        bool hasComponent(std::size_t index) const { return (componentMask & (1ull << index)) != 0; }
+    };
+
+    /// Replicated entities. Entities removed from the state are sent as destroyed, while an entity without any replicated
+    /// component is kept with an empty mask (clients only remove its components)
+    using WorldState = std::unordered_map<NetID, EntityState>;
+
+    struct SnapshotStatistics {
+        std::size_t bytes = 0;
+        std::size_t entitiesWritten = 0;
+        std::size_t entitiesDeferred = 0; //< entities with changes which did not fit inside the budget
+    };
+
+    /// Server side: writes snapshots for a single client, as deltas against the state acknowledged by this client
+    class SnapshotWriter {
+    public:
+        /// How relevant an entity is for the client. Entities with changes accumulate their relevance each tick until they are sent:
+        /// more relevant entities are sent first, less relevant ones are sent less often when the budget is tight.
+        using RelevanceFunction = std::function<float(NetID, const EntityState&)>;
+
+        explicit SnapshotWriter(const Schema& schema);
+
+        /// Max size of a snapshot, in bytes. 0 means no limit
+        void setBudget(std::size_t bytesPerSnapshot);
+        std::size_t getBudget() const;
+
+        /// Writes the differences between 'state' and the state acknowledged by the client
+        std::vector<std::uint8_t> write(Tick tick, const WorldState& state, const RelevanceFunction& relevance = {});
+
+        /// The client applied the snapshot of the given tick: what it contained becomes the new baseline
+        void acknowledge(Tick tick);
+
+        const SnapshotStatistics& getLastStatistics() const;
+
+        /// Count of snapshots sent but not acknowledged yet
+        std::size_t getInFlightCount() const;
+
+    private:
+        /// Last value of a field the client is known to have, and whether a more recent value is still in flight
+        struct FieldBaseline {
+            std::uint32_t value = 0;
+            Tick lastSent = 0;
+            bool synced = false; //< the last value sent was acknowledged (if false, the field is sent again)
+        };
+
+        struct EntityBaseline {
+            bool known = false; //< the client acknowledged the creation of this entity
+            bool sent = false; //< at least one record of this entity was sent, the client may know about it
+            std::uint64_t componentMask = 0;
+            Tick maskLastSent = 0;
+            bool maskSynced = false;
+            Tick destroyLastSent = 0;
+            std::vector<std::vector<FieldBaseline>> fields; //< one entry per component of the schema
+            float priority = 0.0f;
+        };
+
+        struct SentField {
+            std::uint16_t component = 0;
+            std::uint16_t field = 0;
+            std::uint32_t value = 0;
+        };
+
+        struct SentRecord {
+            NetID id = 0;
+            bool destroyed = false;
+            bool created = false;
+            bool maskSent = false;
+            std::uint64_t componentMask = 0;
+            std::vector<SentField> fields;
+        };
+
+        struct SentSnapshot {
+            Tick tick = 0;
+            std::vector<SentRecord> records;
+        };
+
+        /// Writes the record of an entity if it differs from what the client is known to have. Returns false if there is nothing to send
+        bool writeRecord(NetID id, const EntityState* pState, EntityBaseline& baseline, IO::BitWriter& output, SentRecord& record) const;
+
+        /// Remembers that the record was sent at 'tick', its contents will be sent again until this tick is acknowledged
+        void markSent(Tick tick, EntityBaseline& baseline, const SentRecord& record);
+
+        const Schema& schema;
+        std::uint16_t schemaHash = 0;
+        std::size_t budget = 0;
+        std::unordered_map<NetID, EntityBaseline> baselines;
+        std::deque<SentSnapshot> inFlight;
+        std::optional<Tick> lastAcknowledged;
+        SnapshotStatistics lastStatistics;
+    };
+
+    /// What changed for an entity after reading a snapshot
+    struct EntityChange {
+        enum class Type {
+            Created,
+            Updated,
+            Destroyed,
+        };
+
+        NetID id = 0;
+        Type type = Type::Updated;
+        Carrot::UUID entityID = Carrot::UUID::null();
+        std::uint64_t addedComponents = 0;
+        std::uint64_t removedComponents = 0;
+        std::uint64_t changedComponents = 0; //< components with at least one new field value (includes added components)
+    };
+
+    /// Client side: applies snapshots to a copy of the replicated state
+    class SnapshotReader {
+    public:
+        explicit SnapshotReader(const Schema& schema);
+
+        /**
+         * Reads a snapshot and applies it to getState().
+         * \return the tick of the snapshot, which should be acknowledged, or nothing if the snapshot was older than the last one applied
+         * Throws if the snapshot is malformed or was written with a different schema
+         */
+        std::optional<Tick> read(std::span<const std::uint8_t> snapshot, std::vector<EntityChange>& changes);
+
+        const WorldState& getState() const;
+
+    private:
+        const Schema& schema;
+        std::uint16_t schemaHash = 0;
+        WorldState state;
+        std::optional<Tick> lastTick;
+    };
+}
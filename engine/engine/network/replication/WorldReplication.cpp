@@ -0,0 +1,246 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "WorldReplication.h"
+#include <unordered_set>
+#include <engine/network/client/Client.h>
+#include <engine/network/server/Server.h>
+#include <engine/network/packets/ReplicationPackets.h>
+
+namespace Carrot::Network::Replication {
+    ReplicationRegistry& getReplicationRegistry() {
+        static ReplicationRegistry registry;
+        return registry;
+    }
+
+    const Schema& ReplicationRegistry::getSchema() const {
+        return schema;
+    }
+
+    std::optional<std::size_t> ReplicationRegistry::getIndex(ComponentID componentID) const {
+        for(std::size_t i = 0; i < entries.size(); i++) {
+            if(entries[i].componentID == componentID) {
+                return i;
+            }
+        }
+        return {};
+    }
+
+    // WorldReplicator
+
+    WorldReplicator::WorldReplicator(ECS::World& world, const ReplicationRegistry& registry): world(world), registry(registry) {}
+
+    void WorldReplicator::addClient(const Carrot::UUID& client, std::size_t bytesPerTick) {
+        std::lock_guard l { writersAccess };
+        auto& pWriter = writers[client];
+        pWriter = std::make_unique<SnapshotWriter>(registry.getSchema());
+        pWriter->setBudget(bytesPerTick);
+    }
+
+    void WorldReplicator::removeClient(const Carrot::UUID& client) {
+        std::lock_guard l { writersAccess };
+        writers.erase(client);
+    }
+
+    void WorldReplicator::setBudget(const Carrot::UUID& client, std::size_t bytesPerTick) {
+        std::lock_guard l { writersAccess };
+        auto it = writers.find(client);
+        verify(it != writers.end(), "Unknown client");
+        it->second->setBudget(bytesPerTick);
+    }
+
+    void WorldReplicator::setRelevanceFunction(RelevanceFunction function) {
+        relevance = std::move(function);
+    }
+
+    Tick WorldReplicator::getCurrentTick() const {
+        return currentTick;
+    }
+
+    const SnapshotStatistics& WorldReplicator::getStatistics(const Carrot::UUID& client) const {
+        std::lock_guard l { writersAccess };
+        auto it = writers.find(client);
+        verify(it != writers.end(), "Unknown client");
+        return it->second->getLastStatistics();
+    }
+
+    void WorldReplicator::captureWorld() {
+        const Schema& schema = registry.getSchema();
+        std::unordered_set<NetID> captured;
+        captured.reserve(state.size());
+
+        for(const auto& entity : world.getAllEntities()) {
+            std::uint64_t mask = 0;
+            for(std::size_t componentIndex = 0; componentIndex < registry.entries.size(); componentIndex++) {
+                if(world.getComponent(entity.getID(), registry.entries[componentIndex].componentID).hasValue()) {
+                    mask |= 1ull << componentIndex;
+                }
+            }
+            if(mask == 0 && !netIDs.contains(entity.getID())) {
+                // no replicated component, and never replicated: clients do not know about this entity.
+                // Entities which lost all their replicated components stay replicated (with an empty mask) until they are removed
+                // from the world, so clients keep them, with their local components.
+                continue;
+            }
+
+            auto [netIDLocation, newEntity] = netIDs.try_emplace(entity.getID(), nextNetID);
+            if(newEntity) {
+                entityIDs[nextNetID] = entity.getID();
+                nextNetID++;
+            }
+            const NetID netID = netIDLocation->second;
+            captured.insert(netID);
+
+            EntityState& entityState = state[netID];
+            entityState.entityID = entity.getID();
+            entityState.componentMask = mask;
+            entityState.components.resize(schema.components.size());
+            for(std::size_t componentIndex = 0; componentIndex < registry.entries.size(); componentIndex++) {
+                auto& values = entityState.components[componentIndex];
+                if(!entityState.hasComponent(componentIndex)) {
+                    values.clear();
+                    continue;
+                }
+
+                const auto& entry = registry.entries[componentIndex];
+                const auto& fields = schema.components[componentIndex].fields;
+                const ECS::Component& component = *world.getComponent(entity.getID(), entry.componentID).asPtr();
+                values.resize(fields.size());
+                for(std::size_t fieldIndex = 0; fieldIndex < fields.size(); fieldIndex++) {
+                    values[fieldIndex] = fields[fieldIndex].quantization.quantize(entry.fields[fieldIndex].get(component));
+                }
+            }
+        }
+
+        // entities removed from the world: sent as destroyed to clients
+        for(auto it = state.begin(); it != state.end();) {
+            if(captured.contains(it->first)) {
+                ++it;
+                continue;
+            }
+            netIDs.erase(it->second.entityID);
+            entityIDs.erase(it->first);
+            it = state.erase(it);
+        }
+    }
+
+    void WorldReplicator::tick(const SendFunction& send) {
+        captureWorld();
+
+        std::vector<std::pair<Carrot::UUID, std::vector<std::uint8_t>>> snapshots;
+        {
+            std::lock_guard l { writersAccess };
+            snapshots.reserve(writers.size());
+            for(auto& [clientID, pWriter] : writers) {
+                SnapshotWriter::RelevanceFunction entityRelevance;
+                if(relevance) {
+                    entityRelevance = [&](NetID netID, const EntityState&) {
+                        return relevance(clientID, world.wrap(entityIDs.at(netID)));
+                    };
+                }
+                std::vector<std::uint8_t> snapshot = pWriter->write(currentTick, state, entityRelevance);
+                if(pWriter->getLastStatistics().entitiesWritten > 0) {
+                    snapshots.emplace_back(clientID, std::move(snapshot));
+                }
+            }
+        }
+        currentTick++;
+
+        // outside of the lock: sending may lead to acknowledgements
+        for(auto& [clientID, snapshot] : snapshots) {
+            send(clientID, std::move(snapshot));
+        }
+    }
+
+    void WorldReplicator::tick(Server& server) {
+        tick([&](const Carrot::UUID& client, std::vector<std::uint8_t>&& snapshot) {
+            server.sendMessage(client, std::make_shared<ReplicationPackets::Snapshot>(std::move(snapshot)));
+        });
+    }
+
+    void WorldReplicator::acknowledge(const Carrot::UUID& client, Tick tick) {
+        std::lock_guard l { writersAccess };
+        auto it = writers.find(client);
+        if(it != writers.end()) {
+            it->second->acknowledge(tick);
+        }
+    }
+
+    bool WorldReplicator::handlePacket(const Carrot::UUID& client, const Packet::Ptr& packet) {
+        if(packet->getPacketID() != ReplicationPackets::PacketIDs::AcknowledgeSnapshotID) {
+            return false;
+        }
+        acknowledge(client, static_cast<const ReplicationPackets::AcknowledgeSnapshot&>(*packet).tick);
+        return true;
+    }
+
+    // WorldReplica
+
+    WorldReplica::WorldReplica(ECS::World& world, const ReplicationRegistry& registry): world(world), registry(registry), reader(registry.getSchema()) {}
+
+    const WorldState& WorldReplica::getState() const {
+        return reader.getState();
+    }
+
+    std::optional<Tick> WorldReplica::apply(std::span<const std::uint8_t> snapshot) {
+        changes.clear();
+        const std::optional<Tick> tick = reader.read(snapshot, changes);
+        if(!tick.has_value()) {
+            return {};
+        }
+
+        const Schema& schema = registry.getSchema();
+        for(const auto& change : changes) {
+            if(change.type == EntityChange::Type::Destroyed) {
+                if(world.exists(change.entityID)) {
+                    world.removeEntity(world.wrap(change.entityID));
+                }
+                continue;
+            }
+
+            if(change.type == EntityChange::Type::Created && !world.exists(change.entityID)) {
+                world.newEntityWithID(change.entityID, "<replicated>");
+            }
+
+            ECS::Entity entity = world.wrap(change.entityID);
+            const EntityState& entityState = reader.getState().at(change.id);
+            for(std::size_t componentIndex = 0; componentIndex < registry.entries.size(); componentIndex++) {
+                const std::uint64_t bit = 1ull << componentIndex;
+                const auto& entry = registry.entries[componentIndex];
+                if(change.removedComponents & bit) {
+                    entity.removeComponent(entry.componentID);
+                    continue;
+                }
+                if((change.addedComponents & bit) && !entity.getComponent(entry.componentID).hasValue()) {
+                    entry.addToEntity(entity);
+                }
+                if((change.changedComponents & bit) == 0) {
+                    continue;
+                }
+
+                auto component = entity.getComponent(entry.componentID);
+                if(!component.hasValue()) {
+                    continue;
+                }
+                const auto& fields = schema.components[componentIndex].fields;
+                const auto& values = entityState.components[componentIndex];
+                for(std::size_t fieldIndex = 0; fieldIndex < fields.size(); fieldIndex++) {
+                    entry.fields[fieldIndex].set(*component.asPtr(), fields[fieldIndex].quantization.dequantize(values[fieldIndex]));
+                }
+            }
+        }
+        return tick;
+    }
+
+    bool WorldReplica::handlePacket(const Packet::Ptr& packet, Client& client) {
+        if(packet->getPacketID() != ReplicationPackets::PacketIDs::SnapshotID) {
+            return false;
+        }
+        const auto& snapshotPacket = static_cast<const ReplicationPackets::Snapshot&>(*packet);
+        if(auto tick = apply(snapshotPacket.snapshot)) {
+            client.queueMessage(std::make_shared<ReplicationPackets::AcknowledgeSnapshot>(tick.value()));
+        }
+        return true;
+    }
+}
@@ -0,0 +1,153 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include <engine/ecs/World.h>
+#include <engine/network/Packet.hpp>
+#include <engine/network/replication/Snapshots.h>
+
+namespace Carrot::Network {
+    class Server;
+    class Client;
+}
+
+namespace Carrot::Network::Replication {
+    /// Components replicated to clients. Components opt in by being added, with the list of their replicated fields.
+    /// The server and the clients must add the same components, in the same order.
+    class ReplicationRegistry {
+    public:
+        using Getter = std::function<float(const ECS::Component&)>;
+        using Setter = std::function<void(ECS::Component&, float)>;
+
+        template<typename Comp> requires std::is_base_of_v<ECS::Component, Comp>
+        class Builder {
+        public:
+            /// Adds a replicated field, read with 'getter' on the server and written with 'setter' on clients
+            Builder& field(std::string name, const IO::Quantization& quantization, std::function<float(const Comp&)> getter, std::function<void(Comp&, float)> setter);
+
+            /// Adds each coordinate of a glm vector or quaternion as a field
+            template<typename Vector>
+            Builder& vector(const std::string& name, const IO::Quantization& quantization, std::function<Vector(const Comp&)> getter, std::function<void(Comp&, const Vector&)> setter);
+
+        private:
+            explicit Builder(ReplicationRegistry& registry, std::size_t index): registry(registry), index(index) {}
+
+            ReplicationRegistry& registry;
+            std::size_t index = 0;
+
+            friend class ReplicationRegistry;
+        };
+
+        /// Makes 'Comp' replicated. Use the returned builder to describe its fields
+        template<typename Comp> requires std::is_base_of_v<ECS::Component, Comp>
+        Builder<Comp> add();
+
+        const Schema& getSchema() const;
+
+        /// Index of the component inside the schema, if it is replicated
+        std::optional<std::size_t> getIndex(ComponentID componentID) const;
+
+    private:
+        struct FieldAccess {
+            Getter get;
+            Setter set;
+        };
+
+        struct Entry {
+            ComponentID componentID;
+            std::function<void(ECS::Entity&)> addToEntity;
+            std::vector<FieldAccess> fields;
+        };
+
+        Schema schema;
+        std::vector<Entry> entries;
+
+        friend class WorldReplicator;
+        friend class WorldReplica;
+    };
+
+    /// Components replicated by default by WorldReplicator and WorldReplica
+    ReplicationRegistry& getReplicationRegistry();
+
+    /// Server side: sends the replicated components of a world to clients
+    class WorldReplicator {
+    public:
+        /// Bandwidth budget of each client, unless changed with setBudget. A bit less than a usual MTU
+        static constexpr std::size_t DefaultBytesPerTick = 1200;
+
+        using SendFunction = std::function<void(const Carrot::UUID& client, std::vector<std::uint8_t>&& snapshot)>;
+
+        /// How relevant an entity is for a client. The default relevance is 1 for all entities
+        using RelevanceFunction = std::function<float(const Carrot::UUID& client, const ECS::Entity& entity)>;
+
+        explicit WorldReplicator(ECS::World& world, const ReplicationRegistry& registry = getReplicationRegistry());
+
+        void addClient(const Carrot::UUID& client, std::size_t bytesPerTick = DefaultBytesPerTick);
+        void removeClient(const Carrot::UUID& client);
+        void setBudget(const Carrot::UUID& client, std::size_t bytesPerTick);
+        void setRelevanceFunction(RelevanceFunction function);
+
+        /// Captures the replicated components of the world, and writes a snapshot for each client
+        void tick(const SendFunction& send);
+
+        /// Same as tick(SendFunction), sends the snapshots to clients connected to 'server'. Clients must be added with addClient first
+        void tick(Server& server);
+
+        /// The client acknowledged a snapshot
+        void acknowledge(const Carrot::UUID& client, Tick tick);
+
+        /// Acknowledges snapshots if 'packet' is a ReplicationPackets::AcknowledgeSnapshot. Returns true if the packet was handled
+        bool handlePacket(const Carrot::UUID& client, const Packet::Ptr& packet);
+
+        /// Statistics of the last snapshot written for the given client
+        const SnapshotStatistics& getStatistics(const Carrot::UUID& client) const;
+
+        Tick getCurrentTick() const;
+
+    private:
+        void captureWorld();
+
+        ECS::World& world;
+        const ReplicationRegistry& registry;
+        RelevanceFunction relevance;
+        Tick currentTick = 0;
+        NetID nextNetID = 0;
+
+        std::unordered_map<ECS::EntityID, NetID> netIDs;
+        std::unordered_map<NetID, ECS::EntityID> entityIDs;
+        WorldState state;
+        mutable std::mutex writersAccess; //< acknowledgements usually come from the network thread
+        std::unordered_map<Carrot::UUID, std::unique_ptr<SnapshotWriter>> writers;
+    };
+
+    /// Client side: applies snapshots received from a WorldReplicator to a world. Must be used on the thread which ticks the world
+    class WorldReplica {
+    public:
+        explicit WorldReplica(ECS::World& world, const ReplicationRegistry& registry = getReplicationRegistry());
+
+        /// Creates, modifies and removes entities and components based on the snapshot.
+        /// \return the tick to acknowledge to the server, or nothing if the snapshot was outdated
+        std::optional<Tick> apply(std::span<const std::uint8_t> snapshot);
+
+        /// Applies the snapshot if 'packet' is a ReplicationPackets::Snapshot, and acknowledges it via 'client'. Returns true if the packet was handled
+        bool handlePacket(const Packet::Ptr& packet, Client& client);
+
+        const WorldState& getState() const;
+
+    private:
+        ECS::World& world;
+        const ReplicationRegistry& registry;
+        SnapshotReader reader;
+        std::vector<EntityChange> changes;
+    };
+}
+
+#include "WorldReplication.ipp"
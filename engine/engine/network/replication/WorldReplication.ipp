@@ -0,0 +1,53 @@
+#include "WorldReplication.h"
+
+namespace Carrot::Network::Replication {
+    template<typename Comp> requires std::is_base_of_v<ECS::Component, Comp>
+    ReplicationRegistry::Builder<Comp>& ReplicationRegistry::Builder<Comp>::field(std::string name, const IO::Quantization& quantization, std::function<float(const Comp&)> getter, std::function<void(Comp&, float)> setter) {
+        registry.schema.components[index].fields.push_back(FieldSchema {
+            .name = std::move(name),
+            .quantization = quantization,
+        });
+        registry.entries[index].fields.push_back(FieldAccess {
+            .get = [getter](const ECS::Component& component) {
+                return getter(static_cast<const Comp&>(component));
+            },
+            .set = [setter](ECS::Component& component, float value) {
+                setter(static_cast<Comp&>(component), value);
+            },
+        });
+        return *this;
+    }
+
+    template<typename Comp> requires std::is_base_of_v<ECS::Component, Comp>
+    template<typename Vector>
+    ReplicationRegistry::Builder<Comp>& ReplicationRegistry::Builder<Comp>::vector(const std::string& name, const IO::Quantization& quantization, std::function<Vector(const Comp&)> getter, std::function<void(Comp&, const Vector&)> setter) {
+        for(glm::length_t i = 0; i < Vector::length(); i++) {
+            field(name + "[" + std::to_string(i) + "]", quantization,
+                  [getter, i](const Comp& component) {
+                      return static_cast<float>(getter(component)[i]);
+                  },
+                  [getter, setter, i](Comp& component, float value) {
+                      Vector v = getter(component);
+                      v[i] = value;
+                      setter(component, v);
+                  });
+        }
+        return *this;
+    }
+
+    template<typename Comp> requires std::is_base_of_v<ECS::Component, Comp>
+    ReplicationRegistry::Builder<Comp> ReplicationRegistry::add() {
+        verify(!getIndex(Comp::getID()).has_value(), "Component is already replicated");
+        verify(entries.size() < Schema::MaxComponents, "Too many replicated components");
+        schema.components.push_back(ComponentSchema {
+            .name = Comp::getStringRepresentation(),
+        });
+        entries.push_back(Entry {
+            .componentID = Comp::getID(),
+            .addToEntity = [](ECS::Entity& entity) {
+                entity.addComponent<Comp>();
+            },
+        });
+        return Builder<Comp>(*this, entries.size() - 1);
+    }
+}
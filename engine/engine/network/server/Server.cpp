@@ -95,6 +95,16 @@ namespace Carrot::Network {
         }
     }
 
+    bool Server::sendMessage(const Carrot::UUID& clientID, Packet::Ptr&& message) {
+        for(const auto& client : clients) {
+            if(client->uuid == clientID) {
+                sendUDP(*client, message);
+                return true;
+            }
+        }
+        return false;
+    }
+
     void Server::sendTCP(Server::ConnectedClient& client, const Packet::Ptr& data) {
         Asio::asyncWriteToSocket(data, client.tcpSocket);
     }
@@ -48,6 +48,9 @@ namespace Carrot::Network {
         void broadcastEvent(Packet::Ptr&& event);
         void broadcastMessage(Packet::Ptr&& message);
 
+        /// Sends a message (UDP) to a single client. Returns false if no such client is connected
+        bool sendMessage(const Carrot::UUID& client, Packet::Ptr&& message);
+
     public:
         void setPacketConsumer(IPacketConsumer* packetConsumer) {
             this->packetConsumer = packetConsumer;
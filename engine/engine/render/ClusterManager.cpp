@@ -81,7 +81,7 @@ namespace Carrot::Render {
         std::vector<Carrot::Vertex> vertices;
         std::vector<std::uint32_t> indices;
         for(std::size_t i = 0; i < desc.meshlets.size(); i++) {
-            Meshlet& meshlet = desc.meshlets[i];
+            const Meshlet& meshlet = desc.meshlets[i];
             Cluster& cluster = gpuClusters[i + firstClusterIndex];
 
             cluster.transform = desc.transform;
@@ -108,8 +108,27 @@ namespace Carrot::Render {
             }
         }
 
-        BufferAllocation vertexData = GetResourceAllocator().allocateDeviceBuffer(sizeof(Carrot::Vertex) * vertices.size(), vk::BufferUsageFlagBits::eStorageBuffer);
-        vertexData.view.stageUpload(std::span<const Carrot::Vertex>{vertices});
+        std::size_t vertexSize = sizeof(Carrot::Vertex);
+        BufferAllocation vertexData;
+        if(desc.compressVertices) {
+            // quantize positions relative to the entire mesh, like Fertilizer does: vertices shared by neighbouring clusters must decode to the same position
+            std::vector<Carrot::CompressedVertex> compressedVertices;
+            compressedVertices.resize(vertices.size());
+            const QuantizationBounds bounds = VertexCompression::compressMeshlets(desc.originalVertices, desc.meshlets, desc.meshletVertexIndices, compressedVertices);
+            for(std::size_t i = 0; i < desc.meshlets.size(); i++) {
+                Cluster& cluster = gpuClusters[i + firstClusterIndex];
+                cluster.quantizationMin = bounds.min;
+                cluster.quantizationExtent = bounds.extent;
+                cluster.vertexFormat = ClusterVertexFormat::Compressed;
+            }
+
+            vertexSize = sizeof(Carrot::CompressedVertex);
+            vertexData = GetResourceAllocator().allocateDeviceBuffer(vertexSize * compressedVertices.size(), vk::BufferUsageFlagBits::eStorageBuffer);
+            vertexData.view.stageUpload(std::span<const Carrot::CompressedVertex>{compressedVertices});
+        } else {
+            vertexData = GetResourceAllocator().allocateDeviceBuffer(vertexSize * vertices.size(), vk::BufferUsageFlagBits::eStorageBuffer);
+            vertexData.view.stageUpload(std::span<const Carrot::Vertex>{vertices});
+        }
         BufferAllocation indexData = GetResourceAllocator().allocateDeviceBuffer(sizeof(std::uint32_t) * indices.size(), vk::BufferUsageFlagBits::eStorageBuffer);
         indexData.view.stageUpload(std::span<const std::uint32_t>{indices});
 
@@ -121,7 +140,7 @@ namespace Carrot::Render {
             cluster.indexBufferAddress = indexData.view.getDeviceAddress() + indexOffset;
 
             const auto& meshlet = desc.meshlets[i];
-            vertexOffset += sizeof(Carrot::Vertex) * meshlet.vertexCount;
+            vertexOffset += vertexSize * meshlet.vertexCount;
             indexOffset += sizeof(std::uint32_t) * meshlet.indexCount;
         }
 
@@ -386,7 +405,7 @@ namespace Carrot::Render {
             pushConstant.setData(std::move(data));
         }
 
-        Render::PacketCommand& drawCommand = packet.commands.emplace_back();
+        Render::PacketCommand& drawCommand = packet.commands.emplaceBack();
         const int groupSize = 32;
         drawCommand.drawMeshTasks.groupCountX = activeInstances.size() / groupSize;
         drawCommand.drawMeshTasks.groupCountY = 1;
@@ -8,6 +8,7 @@
 #include <core/utils/WeakPool.hpp>
 #include <engine/render/InstanceData.h>
 #include <core/render/Meshlet.h>
+#include <core/render/VertexCompression.h>
 #include <engine/render/resources/Vertex.h>
 #include <engine/render/resources/BufferAllocation.h>
 #include <engine/render/resources/PerFrame.h>
@@ -30,6 +31,12 @@ namespace Carrot::Render {
     class ClusterManager;
     class Viewport;
 
+    /// How vertices of a cluster are stored, keep in sync with clusters.glsl
+    enum class ClusterVertexFormat: std::uint32_t {
+        Full = 0, //< Carrot::Vertex
+        Compressed = 1, //< Carrot::CompressedVertex, positions quantized inside the bounds of the whole mesh (Cluster::quantizationMin/Extent)
+    };
+
     /**
      * Sent as-is to the GPU
      */
@@ -44,6 +51,11 @@ namespace Carrot::Render {
         Math::Sphere parentBoundingSphere{}; // xyz + radius
         float error = 0.0f;
         float parentError = std::numeric_limits<float>::infinity();
+
+        // Bounds used to quantize the positions of compressed vertices, same for all clusters of a mesh
+        glm::vec3 quantizationMin{ 0.0f };
+        glm::vec3 quantizationExtent{ 0.0f };
+        ClusterVertexFormat vertexFormat = ClusterVertexFormat::Full;
     };
 
     /**
@@ -107,18 +119,21 @@ namespace Carrot::Render {
 
     struct ClustersDescription {
         /// Meshlets of the mesh, must be valid for the entire duration of the 'addGeometry' call
-        std::span<Render::Meshlet> meshlets;
+        std::span<const Render::Meshlet> meshlets;
 
         /// Original vertices of the mesh, must be valid for the entire duration of the 'addGeometry' call
-        std::span<Carrot::Vertex> originalVertices;
+        std::span<const Carrot::Vertex> originalVertices;
 
         /// Indices of vertices inside 'originalVertices', used by meshlets to know which vertices they use
-        std::span<std::uint32_t> meshletVertexIndices;
+        std::span<const std::uint32_t> meshletVertexIndices;
 
         /// Indices of vertices inside 'meshletVertexIndices', used by meshlets to describe their triangles
-        std::span<std::uint32_t> meshletIndices;
+        std::span<const std::uint32_t> meshletIndices;
 
         glm::mat4 transform{1.0f};
+
+        /// Store vertices in the compact CompressedVertex format (24 bytes instead of 80), with positions quantized relative to the bounds of the mesh
+        bool compressVertices = true;
     };
 
     struct ClustersInstanceDescription {
@@ -5,6 +5,7 @@
 #include "ComputePipeline.h"
 #include "engine/render/resources/ResourceAllocator.h"
 #include "engine/utils/Macros.h"
+#include <core/utils/Assert.h>
 
 Carrot::ComputePipelineBuilder::ComputePipelineBuilder(Carrot::Engine& engine): engine(engine) {
 
@@ -32,13 +33,14 @@ std::unique_ptr<Carrot::ComputePipeline> Carrot::ComputePipelineBuilder::build()
     for(const auto& [setAndBindingIndex, b] : bindings) {
         bindingsPerSet[setAndBindingIndex.setID].push_back(b);
     }
-    return std::make_unique<ComputePipeline>(engine, shaderResource, specializationConstants, bindingsPerSet);
+    return std::make_unique<ComputePipeline>(engine, shaderResource, specializationConstants, bindingsPerSet, pushConstantBytes);
 }
 
 Carrot::ComputePipeline::ComputePipeline(Carrot::Engine& engine, const IO::Resource shaderResource,
                                          const std::unordered_map<std::uint32_t, SpecializationConstant>& specializationConstants,
-                                         const std::map<uint32_t, std::vector<ComputeBinding>>& bindings):
-        engine(engine), dispatchBuffer(engine.getResourceAllocator().allocateBuffer(sizeof(vk::DispatchIndirectCommand),
+                                         const std::map<uint32_t, std::vector<ComputeBinding>>& bindings,
+                                         std::uint32_t pushConstantSize):
+        engine(engine), pushConstantSize(pushConstantSize), dispatchBuffer(engine.getResourceAllocator().allocateBuffer(sizeof(vk::DispatchIndirectCommand),
                                                                                     vk::BufferUsageFlagBits::eIndirectBuffer,
                                                                                     vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)) {
     auto& computeCommandPool = engine.getComputeCommandPool();
@@ -193,11 +195,16 @@ Carrot::ComputePipeline::ComputePipeline(Carrot::Engine& engine, const IO::Resou
         setLayouts.push_back(*layout);
     }
 
+    vk::PushConstantRange pushConstantRange {
+            .stageFlags = vk::ShaderStageFlagBits::eCompute,
+            .offset = 0,
+            .size = pushConstantSize,
+    };
     computePipelineLayout = engine.getLogicalDevice().createPipelineLayoutUnique(vk::PipelineLayoutCreateInfo {
             .setLayoutCount = static_cast<uint32_t>(setLayouts.size()),
             .pSetLayouts = setLayouts.data(),
-            .pushConstantRangeCount = 0,
-            .pPushConstantRanges = nullptr,
+            .pushConstantRangeCount = pushConstantSize != 0 ? 1u : 0u,
+            .pPushConstantRanges = pushConstantSize != 0 ? &pushConstantRange : nullptr,
     }, engine.getAllocator());
 
     computePipeline = engine.getLogicalDevice().createComputePipelineUnique(nullptr, vk::ComputePipelineCreateInfo {
@@ -241,6 +248,17 @@ void Carrot::ComputePipeline::dispatchInline(uint32_t groupCountX, uint32_t grou
     commandBuffer.dispatchIndirect(dispatchBuffer.getVulkanBuffer(), dispatchBuffer.getStart());
 }
 
+void Carrot::ComputePipeline::dispatchIndirectInline(const vk::Buffer& arguments, vk::DeviceSize offset, vk::CommandBuffer& commandBuffer, std::span<const std::uint8_t> pushConstants) const {
+    verify(pushConstants.size() == pushConstantSize, "Push constants do not match the size declared when building this pipeline");
+
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *computePipeline);
+    commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *computePipelineLayout, 0, descriptorSetsFlat, dynamicOffsets);
+    if(!pushConstants.empty()) {
+        commandBuffer.pushConstants(*computePipelineLayout, vk::ShaderStageFlagBits::eCompute, 0, static_cast<std::uint32_t>(pushConstants.size()), pushConstants.data());
+    }
+    commandBuffer.dispatchIndirect(arguments, offset);
+}
+
 void Carrot::ComputePipeline::dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ, vk::Semaphore* signal) const {
     dispatchSizes->x = groupCountX;
     dispatchSizes->y = groupCountY;
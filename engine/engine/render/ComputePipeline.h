@@ -6,6 +6,7 @@
 
 #include "engine/Engine.h"
 #include "engine/render/resources/BufferView.h"
+#include <span>
 #include <string>
 #include <utility>
 #include "core/io/Resource.h"
@@ -47,9 +48,13 @@ namespace Carrot {
 
     class ComputePipeline: public SwapchainAware {
     public:
-        explicit ComputePipeline(Carrot::Engine& engine, const IO::Resource shaderResource, const std::unordered_map<std::uint32_t, SpecializationConstant>& specializationConstants, const std::map<std::uint32_t, std::vector<ComputeBinding>>& bindings);
+        explicit ComputePipeline(Carrot::Engine& engine, const IO::Resource shaderResource, const std::unordered_map<std::uint32_t, SpecializationConstant>& specializationConstants, const std::map<std::uint32_t, std::vector<ComputeBinding>>& bindings, std::uint32_t pushConstantSize = 0);
 
         void dispatchInline(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ, vk::CommandBuffer& cmds) const;
+
+        //! Records a dispatch whose group counts are read from a vk::DispatchIndirectCommand at 'offset' inside 'arguments', which can be written by previous GPU work.
+        //! 'pushConstants' must be the size given to ComputePipelineBuilder::pushConstantSize (or empty if none)
+        void dispatchIndirectInline(const vk::Buffer& arguments, vk::DeviceSize offset, vk::CommandBuffer& cmds, std::span<const std::uint8_t> pushConstants = {}) const;
         //! Launches the compute pipeline with the given group size. A signal semaphore can optionally be added, and will be signaled once processing is finished
         void dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ, vk::Semaphore* signal = nullptr) const;
 
@@ -69,6 +74,7 @@ namespace Carrot {
         std::map<std::uint32_t, vk::UniqueDescriptorSetLayout> descriptorLayouts{};
         std::map<std::uint32_t, vk::DescriptorSet> descriptorSets{};
         vk::UniquePipelineLayout computePipelineLayout{};
+        std::uint32_t pushConstantSize = 0;
         vk::UniquePipeline computePipeline{};
         vk::UniqueFence finishedFence{};
 
@@ -86,6 +92,7 @@ namespace Carrot {
         ComputePipelineBuilder& shader(IO::Resource shader) { shaderResource = std::move(shader); return *this; };
         ComputePipelineBuilder& bufferBinding(vk::DescriptorType type, uint32_t setID, uint32_t bindingID, const vk::DescriptorBufferInfo& info, uint32_t count = 1);
         ComputePipelineBuilder& specializationUInt32(std::uint32_t constantID, std::uint32_t value);
+        ComputePipelineBuilder& pushConstantSize(std::uint32_t size) { pushConstantBytes = size; return *this; };
 
         std::unique_ptr<ComputePipeline> build();
 
@@ -94,6 +101,7 @@ namespace Carrot {
         IO::Resource shaderResource;
         std::unordered_map<SetAndBindingKey, ComputeBinding> bindings;
         std::unordered_map<std::uint32_t, SpecializationConstant> specializationConstants;
+        std::uint32_t pushConstantBytes = 0;
     };
 
 }
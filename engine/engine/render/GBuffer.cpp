@@ -5,9 +5,84 @@
 #include "GBuffer.h"
 #include "engine/render/raytracing/ASBuilder.h"
 #include "engine/render/Skybox.hpp"
+#include <core/io/Logging.hpp>
+#include <span>
+
+namespace {
+    struct GBufferTarget {
+        Carrot::Render::FrameResource Carrot::Render::PassData::GBuffer::* resource;
+        const char* name;
+        vk::Format format;
+        std::uint32_t bytesPerPixel;
+    };
+
+    using GBufferData = Carrot::Render::PassData::GBuffer;
+
+    // In the order of the outputs of includes/gbuffer_output.glsl
+    constexpr GBufferTarget StandardTargets[] = {
+            { &GBufferData::albedo, "Albedo", vk::Format::eR8G8B8A8Unorm, 4 },
+            { &GBufferData::positions, "View Positions", vk::Format::eR32G32B32A32Sfloat, 16 },
+            { &GBufferData::viewSpaceNormalTangents, "View space normals tangents", vk::Format::eR32G32B32A32Sfloat, 16 },
+            { &GBufferData::flags, "Flags", vk::Format::eR32Uint, 4 },
+            { &GBufferData::entityID, "EntityID", vk::Format::eR32G32B32A32Uint, 16 },
+            { &GBufferData::metallicRoughnessVelocityXY, "MetallicnessRoughness+VelocityXY", vk::Format::eR32G32B32A32Sfloat, 16 },
+            { &GBufferData::emissiveVelocityZ, "Emissive + Velocity Z", vk::Format::eR32G32B32A32Sfloat, 16 },
+    };
+
+    // Positions are reconstructed from depth, see includes/gbuffer_packing.glsl for the encoding
+    constexpr GBufferTarget PackedTargets[] = {
+            { &GBufferData::albedo, "Albedo", vk::Format::eR8G8B8A8Unorm, 4 },
+            { &GBufferData::viewSpaceNormalTangents, "View space normals tangents (octahedral)", vk::Format::eR32G32Uint, 8 },
+            { &GBufferData::flags, "Flags + MetallicnessRoughness", vk::Format::eR32Uint, 4 },
+            { &GBufferData::entityID, "EntityID", vk::Format::eR32G32B32A32Uint, 16 },
+            { &GBufferData::metallicRoughnessVelocityXY, "Velocity", vk::Format::eR16G16B16A16Sfloat, 8 },
+            { &GBufferData::emissiveVelocityZ, "Emissive", vk::Format::eB10G11R11UfloatPack32, 4 },
+    };
+
+    std::span<const GBufferTarget> getTargets(Carrot::GBuffer::Layout layout) {
+        if(layout == Carrot::GBuffer::Layout::Packed) {
+            return PackedTargets;
+        }
+        return StandardTargets;
+    }
+}
 
 Carrot::GBuffer::GBuffer(Carrot::VulkanRenderer& renderer, Carrot::RayTracer& raytracer): renderer(renderer), raytracer(raytracer) {
+    Carrot::Log::info("GBuffer layout is %s: %u bytes per pixel + depth (standard layout: %u, packed layout: %u)",
+                      getLayout() == Layout::Packed ? "packed" : "standard",
+                      getColorBytesPerPixel(getLayout()),
+                      getColorBytesPerPixel(Layout::Standard),
+                      getColorBytesPerPixel(Layout::Packed));
+}
+
+Carrot::GBuffer::Layout Carrot::GBuffer::getLayout() {
+    return GetEngine().getConfiguration().packedGBuffer ? Layout::Packed : Layout::Standard;
+}
+
+std::string Carrot::GBuffer::getShaderVariant(const std::string& shaderPath) {
+    constexpr std::string_view ShadersFolder = "resources/shaders/";
+    if(getLayout() != Layout::Packed || !shaderPath.starts_with(ShadersFolder)) {
+        return shaderPath;
+    }
 
+    // same file name: the stage of a shader is deduced from its extension
+    std::string variantPath = Carrot::sprintf("%spacked-gbuffer/%s", ShadersFolder.data(), shaderPath.c_str() + ShadersFolder.size());
+    if(!GetVFS().exists(IO::VFS::Path(variantPath))) {
+        return shaderPath; // does not depend on the GBuffer layout
+    }
+    return variantPath;
+}
+
+std::uint32_t Carrot::GBuffer::getColorTargetCount(Layout layout) {
+    return static_cast<std::uint32_t>(getTargets(layout).size());
+}
+
+std::uint32_t Carrot::GBuffer::getColorBytesPerPixel(Layout layout) {
+    std::uint32_t total = 0;
+    for(const GBufferTarget& target : getTargets(layout)) {
+        total += target.bytesPerPixel;
+    }
+    return total;
 }
 
 void Carrot::GBuffer::onSwapchainImageCountChange(size_t newCount) {
@@ -20,66 +95,25 @@ void Carrot::GBuffer::onSwapchainSizeChange(Window& window, int newWidth, int ne
 
 Carrot::Render::Pass<Carrot::Render::PassData::GBuffer>& Carrot::GBuffer::addGBufferPass(Carrot::Render::GraphBuilder& graph, std::function<void(const Carrot::Render::CompiledPass& pass, const Carrot::Render::Context&, vk::CommandBuffer&)> opaqueCallback, const Render::TextureSize& framebufferSize) {
     using namespace Carrot::Render;
-    vk::ClearValue clearColor = vk::ClearColorValue(std::array{0.0f,0.0f,0.0f,0.0f});
-    vk::ClearValue positionClear = vk::ClearColorValue(std::array{0.0f,0.0f,0.0f,0.0f});
+    vk::ClearValue clearColor = vk::ClearColorValue(std::array{0.0f,0.0f,0.0f,0.0f}); // all zeroes, also valid for integer targets
     vk::ClearValue clearDepth = vk::ClearDepthStencilValue{
             .depth = 1.0f,
             .stencil = 0
     };
-    vk::ClearValue clearIntProperties = vk::ClearColorValue();
-    vk::ClearValue clearEntityID = vk::ClearColorValue(std::array<std::uint32_t,4>{0,0,0,0});
     auto& opaquePass = graph.addPass<Carrot::Render::PassData::GBuffer>("gbuffer",
            [&](GraphBuilder& graph, Pass<Carrot::Render::PassData::GBuffer>& pass, Carrot::Render::PassData::GBuffer& data)
            {
-
-                data.albedo = graph.createRenderTarget("Albedo",
-                                                       vk::Format::eR8G8B8A8Unorm,
-                                                       framebufferSize,
-                                                       vk::AttachmentLoadOp::eClear,
-                                                       clearColor,
-                                                       vk::ImageLayout::eColorAttachmentOptimal);
-
-                data.positions = graph.createRenderTarget("View Positions",
-                                                          vk::Format::eR32G32B32A32Sfloat,
-                                                          framebufferSize,
-                                                          vk::AttachmentLoadOp::eClear,
-                                                          positionClear,
-                                                          vk::ImageLayout::eColorAttachmentOptimal);
-
-                data.viewSpaceNormalTangents = graph.createRenderTarget("View space normals tangents",
-                                                        vk::Format::eR32G32B32A32Sfloat,
-                                                        framebufferSize,
-                                                        vk::AttachmentLoadOp::eClear,
-                                                        positionClear,
-                                                        vk::ImageLayout::eColorAttachmentOptimal);
-
-                data.flags = graph.createRenderTarget("Flags",
-                                                      vk::Format::eR32Uint,
-                                                      framebufferSize,
-                                                      vk::AttachmentLoadOp::eClear,
-                                                      clearIntProperties,
-                                                      vk::ImageLayout::eColorAttachmentOptimal);
-
-                data.entityID = graph.createRenderTarget("EntityID",
-                                                         vk::Format::eR32G32B32A32Uint,
-                                                        framebufferSize,
-                                                        vk::AttachmentLoadOp::eClear,
-                                                        clearEntityID,
-                                                        vk::ImageLayout::eColorAttachmentOptimal);
-
-               data.metallicRoughnessVelocityXY = graph.createRenderTarget("MetallicnessRoughness+VelocityXY",
-                                                                           vk::Format::eR32G32B32A32Sfloat,
-                                                                           framebufferSize,
-                                                                           vk::AttachmentLoadOp::eClear,
-                                                                           clearColor,
-                                                                           vk::ImageLayout::eColorAttachmentOptimal);
-
-               data.emissiveVelocityZ = graph.createRenderTarget("Emissive + Velocity Z",
-                                                                 vk::Format::eR32G32B32A32Sfloat,
-                                                                 framebufferSize,
-                                                                 vk::AttachmentLoadOp::eClear,
-                                                                 clearColor,
-                                                                 vk::ImageLayout::eColorAttachmentOptimal);
+                // only draws render packets (and what the game records): independent from the other passes
+                pass.recordInParallel = true;
+
+                for(const GBufferTarget& target : getTargets(getLayout())) {
+                    data.*target.resource = graph.createRenderTarget(target.name,
+                                                                     target.format,
+                                                                     framebufferSize,
+                                                                     vk::AttachmentLoadOp::eClear,
+                                                                     clearColor,
+                                                                     vk::ImageLayout::eColorAttachmentOptimal);
+                }
 
                data.depthStencil = graph.createRenderTarget("Depth Stencil",
                                                             renderer.getVulkanDriver().getDepthFormat(),
@@ -180,13 +214,9 @@ Carrot::Render::Pass<Carrot::Render::PassData::Lighting>& Carrot::GBuffer::addLi
 }
 
 void Carrot::Render::PassData::GBuffer::readFrom(Render::GraphBuilder& graph, const GBuffer& other, vk::ImageLayout wantedLayout) {
-    albedo = graph.read(other.albedo, wantedLayout);
-    positions = graph.read(other.positions, wantedLayout);
-    viewSpaceNormalTangents = graph.read(other.viewSpaceNormalTangents, wantedLayout);
-    flags = graph.read(other.flags, wantedLayout);
-    entityID = graph.read(other.entityID, wantedLayout);
-    metallicRoughnessVelocityXY = graph.read(other.metallicRoughnessVelocityXY, wantedLayout);
-    emissiveVelocityZ = graph.read(other.emissiveVelocityZ, wantedLayout);
+    for(const GBufferTarget& target : getTargets(Carrot::GBuffer::getLayout())) {
+        this->*target.resource = graph.read(other.*target.resource, wantedLayout);
+    }
     depthStencil = graph.read(other.depthStencil, vk::ImageLayout::eDepthStencilReadOnlyOptimal, vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil);
 
     // TODO: fix (double read in two != passes result in no 'previousLayout' change
@@ -195,13 +225,9 @@ void Carrot::Render::PassData::GBuffer::readFrom(Render::GraphBuilder& graph, co
 }
 
 void Carrot::Render::PassData::GBuffer::writeTo(Render::GraphBuilder& graph, const GBuffer& other) {
-    albedo = graph.write(other.albedo, vk::AttachmentLoadOp::eLoad, vk::ImageLayout::eColorAttachmentOptimal);
-    positions = graph.write(other.positions, vk::AttachmentLoadOp::eLoad, vk::ImageLayout::eColorAttachmentOptimal);
-    viewSpaceNormalTangents = graph.write(other.viewSpaceNormalTangents, vk::AttachmentLoadOp::eLoad, vk::ImageLayout::eColorAttachmentOptimal);
-    flags = graph.write(other.flags, vk::AttachmentLoadOp::eLoad, vk::ImageLayout::eColorAttachmentOptimal);
-    entityID = graph.write(other.entityID, vk::AttachmentLoadOp::eLoad, vk::ImageLayout::eColorAttachmentOptimal);
-    metallicRoughnessVelocityXY = graph.write(other.metallicRoughnessVelocityXY, vk::AttachmentLoadOp::eLoad, vk::ImageLayout::eColorAttachmentOptimal);
-    emissiveVelocityZ = graph.write(other.emissiveVelocityZ, vk::AttachmentLoadOp::eLoad, vk::ImageLayout::eColorAttachmentOptimal);
+    for(const GBufferTarget& target : getTargets(Carrot::GBuffer::getLayout())) {
+        this->*target.resource = graph.write(other.*target.resource, vk::AttachmentLoadOp::eLoad, vk::ImageLayout::eColorAttachmentOptimal);
+    }
     depthStencil = graph.write(other.depthStencil, vk::AttachmentLoadOp::eLoad, vk::ImageLayout::eDepthStencilAttachmentOptimal);
 
     // TODO: fix (double read in two != passes result in no 'previousLayout' change
@@ -212,7 +238,9 @@ void Carrot::Render::PassData::GBuffer::writeTo(Render::GraphBuilder& graph, con
 void Carrot::Render::PassData::GBuffer::bindInputs(Carrot::Pipeline& pipeline, const Render::Context& frame, const Render::Graph& renderGraph, std::uint32_t setID, vk::ImageLayout expectedLayout) const {
     auto& renderer = GetRenderer();
     renderer.bindTexture(pipeline, frame, renderGraph.getTexture(albedo, frame.swapchainIndex), setID, 0, nullptr, vk::ImageAspectFlagBits::eColor, vk::ImageViewType::e2D, 0, expectedLayout);
-    renderer.bindTexture(pipeline, frame, renderGraph.getTexture(positions, frame.swapchainIndex), setID, 1, nullptr, vk::ImageAspectFlagBits::eColor, vk::ImageViewType::e2D, 0, expectedLayout);
+    if(Carrot::GBuffer::getLayout() == Carrot::GBuffer::Layout::Standard) {
+        renderer.bindTexture(pipeline, frame, renderGraph.getTexture(positions, frame.swapchainIndex), setID, 1, nullptr, vk::ImageAspectFlagBits::eColor, vk::ImageViewType::e2D, 0, expectedLayout);
+    }
     renderer.bindTexture(pipeline, frame, renderGraph.getTexture(viewSpaceNormalTangents, frame.swapchainIndex), setID, 2, nullptr, vk::ImageAspectFlagBits::eColor, vk::ImageViewType::e2D, 0, expectedLayout);
     renderer.bindTexture(pipeline, frame, renderGraph.getTexture(flags, frame.swapchainIndex), setID, 3, renderer.getVulkanDriver().getNearestSampler(), vk::ImageAspectFlagBits::eColor, vk::ImageViewType::e2D, 0, expectedLayout);
     renderer.bindTexture(pipeline, frame, renderGraph.getTexture(entityID, frame.swapchainIndex), setID, 4, nullptr, vk::ImageAspectFlagBits::eColor, vk::ImageViewType::e2D, 0, expectedLayout);
@@ -225,7 +253,10 @@ void Carrot::Render::PassData::GBuffer::bindInputs(Carrot::Pipeline& pipeline, c
     } else if(expectedLayout == vk::ImageLayout::eColorAttachmentOptimal) {
         depthLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
     }
-    // 7 unused
+    if(Carrot::GBuffer::getLayout() == Carrot::GBuffer::Layout::Packed) {
+        // camera, to reconstruct positions from depth
+        renderer.bindUniformBuffer(pipeline, frame, frame.pViewport->getCameraUniformBuffer(frame), setID, 7);
+    }
     renderer.bindTexture(pipeline, frame, renderGraph.getTexture(depthStencil, frame.swapchainIndex), setID, 8, nullptr, vk::ImageAspectFlagBits::eDepth, vk::ImageViewType::e2D, 0, depthLayout);
 
     Render::Texture::Ref skyboxCubeMap = GetEngine().getSkyboxCubeMap();
@@ -14,8 +14,27 @@
 namespace Carrot {
     class GBuffer: public SwapchainAware {
     public:
+        /// Render targets created by addGBufferPass. Selected with Configuration::packedGBuffer, shaders use GBUFFER_PACKED (see includes/gbuffer_packing.glsl)
+        enum class Layout {
+            Standard, // full float view positions and normals+tangents
+            Packed, // positions reconstructed from depth, octahedral normals+tangents, metallic+roughness inside flags, R11G11B10 emissive
+        };
+
         explicit GBuffer(Carrot::VulkanRenderer& renderer, Carrot::RayTracer& raytracer);
 
+        /// Layout used by the engine, from Configuration::packedGBuffer
+        static Layout getLayout();
+
+        /// Shaders which depend on the layout are also compiled for the packed layout, inside resources/shaders/packed-gbuffer/.
+        /// Returns the path of that variant if the packed layout is used and the variant exists, 'shaderPath' otherwise
+        static std::string getShaderVariant(const std::string& shaderPath);
+
+        /// Number of color attachments written by pipelines of type 'gbuffer'
+        static std::uint32_t getColorTargetCount(Layout layout);
+
+        /// Size of the color targets for a single pixel. Depth is not included, it is the same for all layouts
+        static std::uint32_t getColorBytesPerPixel(Layout layout);
+
         void onSwapchainImageCountChange(size_t newCount) override;
 
         void onSwapchainSizeChange(Window& window, int newWidth, int newHeight) override;
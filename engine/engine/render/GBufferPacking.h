@@ -0,0 +1,30 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+
+/// CPU version of the packing functions of the packed GBuffer layout.
+/// The functions are the ones from the shader include, which is compiled as C++ here: both versions cannot get out of sync.
+namespace Carrot::Render::GBufferPacking {
+    using namespace glm;
+    using uint = std::uint32_t;
+
+#define GBUFFER_PACKING_FUNCTION inline
+#include "../../resources/shaders/includes/gbuffer_packing.glsl"
+#undef GBUFFER_PACKING_FUNCTION
+
+    /// Emissive colors are written to a B10G11R11 unsigned float target, which is packed by the GPU when writing.
+    /// This does the same packing, for reference: negative values are clamped to 0
+    inline uint packEmissive(vec3 emissive) {
+        return packF2x11_1x10(max(emissive, vec3(0.0f)));
+    }
+
+    inline vec3 unpackEmissive(uint packed) {
+        return unpackF2x11_1x10(packed);
+    }
+}
@@ -263,7 +263,7 @@ namespace Carrot::Render {
         }
 
         int drawIndex = 0;
-        auto& drawCommand = packet.commands.emplace_back().drawIndexedInstanced;
+        auto& drawCommand = packet.commands.emplaceBack().drawIndexedInstanced;
         for (int n = 0; n < pDrawData->CmdListsCount; n++) {
             const ImDrawList* cmd_list = pDrawData->CmdLists[n];
             std::size_t commandListVertexOffset = vertexStarts[n];
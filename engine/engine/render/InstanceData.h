@@ -5,6 +5,7 @@
 #pragma once
 #include <glm/glm.hpp>
 #include <core/utils/UUID.h>
+#include <core/render/TransformHistory.h>
 
 namespace Carrot {
     struct InstanceData {
@@ -14,6 +15,23 @@ namespace Carrot {
         glm::mat4 lastFrameTransform{0.0f};
     };
 
+    /// Smaller alternative to InstanceData (68 bytes instead of 160), used by the "VertexWithCompactInstanceData" vertex format.
+    /// The transform of the previous frame is read from Render::InstanceTransformHistory, and the UUID is inside a separate
+    /// PickingInstanceData stream.
+    struct CompactInstanceData {
+        glm::vec4 color{1.0f};
+        Render::AffineTransform transform;
+
+        /// Slot of this instance inside Render::InstanceTransformHistory, InvalidSlot to reuse 'transform' as the previous transform
+        std::uint32_t previousTransformSlot = Render::TransformHistory::InvalidSlot;
+    };
+    static_assert(sizeof(CompactInstanceData) == 68);
+
+    /// Per-instance data only used to write the entity ID inside the GBuffer (for picking)
+    struct PickingInstanceData {
+        Carrot::UUID uuid = Carrot::UUID::null();
+    };
+
     struct AnimatedInstanceData {
         alignas(16) glm::vec4 color{1.0f};
         alignas(16) Carrot::UUID uuid = Carrot::UUID::null();
@@ -22,5 +40,23 @@ namespace Carrot {
         alignas(16) uint32_t animationIndex = 0;
         double animationTime = 0.0;
     };
+
+    /// One glyph of a batched text, see Render::TextBatcher
+    struct GlyphInstanceData {
+        alignas(16) glm::vec4 color{1.0f};
+        alignas(16) Carrot::UUID uuid = Carrot::UUID::null();
+        alignas(16) glm::mat4 transform{1.0f};
+        glm::vec4 glyphRect{0.0f}; // xy = min, zw = max, in text space
+        glm::vec4 texelRect{0.0f}; // xy = top-left, zw = bottom-right, in atlas texels
+    };
+
+    /// One sprite drawn by Render::SpriteBatcher (84 bytes instead of 160 for InstanceData)
+    struct SpriteInstanceData {
+        Render::AffineTransform transform;
+        glm::vec4 uvRect{0.0f, 0.0f, 1.0f, 1.0f}; // xy = min, zw = max, in UV of the atlas page
+        Carrot::UUID uuid = Carrot::UUID::null();
+        glm::u8vec4 color{255}; // read as unorm: colors are clamped to [0; 1]
+    };
+    static_assert(sizeof(SpriteInstanceData) == 84);
 }
 
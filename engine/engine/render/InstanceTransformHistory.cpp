@@ -0,0 +1,93 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "InstanceTransformHistory.h"
+
+#include <bit>
+#include <core/utils/stringmanip.h>
+#include <engine/Engine.h>
+#include <engine/render/resources/ResourceAllocator.h>
+#include <engine/render/VulkanRenderer.h>
+#include <engine/utils/Profiling.h>
+
+namespace Carrot::Render {
+    /// Avoids recreating the buffers each time a few entities are spawned
+    constexpr std::size_t MinimumCapacity = 256;
+
+    InstanceTransformHistory::InstanceTransformHistory(std::size_t swapchainImageCount): history(swapchainImageCount) {
+        onSwapchainImageCountChange(swapchainImageCount);
+    }
+
+    InstanceTransformHistory::Slot InstanceTransformHistory::allocateSlot() {
+        return history.allocateSlot();
+    }
+
+    void InstanceTransformHistory::freeSlot(Slot slot) {
+        history.freeSlot(slot);
+    }
+
+    void InstanceTransformHistory::beginFrame(const Render::Context& renderContext) {
+        ZoneScoped;
+        uploadedBytesLastFrame = history.resetWrittenBytes();
+        TracyPlot("Previous instance transforms upload", static_cast<std::int64_t>(uploadedBytesLastFrame));
+        TracyPlotConfig("Previous instance transforms upload", tracy::PlotFormatType::Memory, false, false, 0);
+
+        BufferAllocation& buffer = buffers[renderContext.swapchainIndex];
+        const std::size_t requiredCapacity = std::max(history.getRequiredCapacity(), MinimumCapacity);
+        if(buffer.view.getSize() >= requiredCapacity * sizeof(AffineTransform)) {
+            return;
+        }
+
+        // the GPU is done with the previous buffer of this swapchain image, it can be replaced directly
+        const std::size_t newCapacity = std::bit_ceil(requiredCapacity);
+        buffer = GetResourceAllocator().allocateStagingBuffer(newCapacity * sizeof(AffineTransform), alignof(AffineTransform));
+        buffer.name(Carrot::sprintf("Previous instance transforms (%llu)", (std::uint64_t)renderContext.swapchainIndex));
+        mappedBuffers[renderContext.swapchainIndex] = std::span { buffer.view.map<AffineTransform>(), newCapacity }; // mapped here to avoid mapping from multiple threads in 'submit'
+        history.resetBuffer(renderContext.swapchainIndex, newCapacity);
+    }
+
+    std::uint32_t InstanceTransformHistory::submit(const Render::Context& renderContext, Slot slot, const glm::mat4& previousTransform) {
+        if(!history.submit(renderContext.swapchainIndex, mappedBuffers[renderContext.swapchainIndex], slot, previousTransform)) {
+            // slot was allocated during this frame, buffer will be large enough next frame
+            return TransformHistory::InvalidSlot;
+        }
+        return slot;
+    }
+
+    const Carrot::BufferView& InstanceTransformHistory::getBuffer(const Render::Context& renderContext) const {
+        return buffers[renderContext.swapchainIndex].view;
+    }
+
+    std::size_t InstanceTransformHistory::getUploadedBytesLastFrame() const {
+        return uploadedBytesLastFrame;
+    }
+
+    void InstanceTransformHistory::onSwapchainImageCountChange(std::size_t newCount) {
+        buffers.clear();
+        buffers.resize(newCount);
+        mappedBuffers.clear();
+        mappedBuffers.resize(newCount);
+        history.setBufferCount(newCount);
+    }
+
+    InstanceTransformSlots::~InstanceTransformSlots() {
+        InstanceTransformHistory& transformHistory = GetRenderer().getInstanceTransformHistory();
+        for(const auto& slot : slots) {
+            if(slot != TransformHistory::InvalidSlot) {
+                transformHistory.freeSlot(slot);
+            }
+        }
+    }
+
+    InstanceTransformHistory::Slot InstanceTransformSlots::getOrAllocate(std::size_t meshIndex) {
+        if(slots.size() <= meshIndex) {
+            slots.resize(meshIndex + 1, TransformHistory::InvalidSlot);
+        }
+        auto& slot = slots[meshIndex];
+        if(slot == TransformHistory::InvalidSlot) {
+            slot = GetRenderer().getInstanceTransformHistory().allocateSlot();
+        }
+        return slot;
+    }
+}
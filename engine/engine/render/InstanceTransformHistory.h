@@ -0,0 +1,60 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <core/render/TransformHistory.h>
+#include <engine/render/resources/BufferAllocation.h>
+#include <engine/render/resources/PerFrame.h>
+#include <engine/render/RenderContext.h>
+#include <engine/vulkan/SwapchainAware.h>
+
+namespace Carrot::Render {
+    /// GPU side of TransformHistory: one host-visible buffer per swapchain image, containing the transform that each slot had
+    /// during the previous frame. Read by pipelines using the VertexWithCompactInstanceData vertex format.
+    class InstanceTransformHistory: public SwapchainAware {
+    public:
+        using Slot = TransformHistory::Slot;
+
+        explicit InstanceTransformHistory(std::size_t swapchainImageCount);
+
+        Slot allocateSlot();
+        void freeSlot(Slot slot);
+
+        /// Grows the buffer of this frame if new slots were allocated. Must be called before any call to 'submit' for this frame.
+        void beginFrame(const Render::Context& renderContext);
+
+        /// Uploads the previous transform of 'slot' if the buffer of this frame does not already contain it.
+        /// Returns the value to store inside CompactInstanceData::previousTransformSlot. Thread-safe.
+        std::uint32_t submit(const Render::Context& renderContext, Slot slot, const glm::mat4& previousTransform);
+
+        /// Buffer to bind to pipelines using the VertexWithCompactInstanceData vertex format
+        const Carrot::BufferView& getBuffer(const Render::Context& renderContext) const;
+
+        /// Bytes written to the buffers during the last frame
+        std::size_t getUploadedBytesLastFrame() const;
+
+    public:
+        void onSwapchainImageCountChange(std::size_t newCount) override;
+
+    private:
+        TransformHistory history;
+        PerFrame<BufferAllocation> buffers;
+        PerFrame<std::span<AffineTransform>> mappedBuffers;
+        std::size_t uploadedBytesLastFrame = 0;
+    };
+
+    /// Slots used by the meshes of a single entity. Slots are freed when this object is destroyed.
+    struct InstanceTransformSlots {
+        std::vector<InstanceTransformHistory::Slot> slots;
+
+        InstanceTransformSlots() = default;
+        InstanceTransformSlots(const InstanceTransformSlots&) = delete;
+        InstanceTransformSlots& operator=(const InstanceTransformSlots&) = delete;
+        ~InstanceTransformSlots();
+
+        /// Gets the slot for the given mesh, allocates it if necessary
+        InstanceTransformHistory::Slot getOrAllocate(std::size_t meshIndex);
+    };
+}
@@ -11,6 +11,8 @@
 #include <engine/utils/conversions.h>
 #include <core/io/Logging.hpp>
 #include <core/utils/UserNotifications.h>
+#include <core/io/FileFormats.h>
+#include <core/scene/BinaryModel.h>
 #include <core/scene/LoadedScene.h>
 #include <engine/render/GBufferDrawData.h>
 #include <engine/render/RenderPacket.h>
@@ -25,6 +27,36 @@
 #include <engine/render/ClusterManager.h>
 #include <engine/task/TaskScheduler.h>
 
+/// Converts the materials of a binary model to the format used by SceneLoader. Texture paths are relative to the model, like in glTF files
+static std::vector<Carrot::Render::LoadedMaterial> loadBinaryModelMaterials(const Carrot::Render::BinaryModelView& binaryModel, const Carrot::IO::Resource& file) {
+    const Carrot::IO::VFS::Path modelPath { file.getName() };
+    auto texturePath = [&](const Carrot::Render::BinaryModel::StringRef& ref) -> Carrot::IO::VFS::Path {
+        const std::string_view path = binaryModel.getString(ref);
+        if(path.empty()) {
+            return {};
+        }
+        return modelPath.relative(Carrot::IO::Path(path));
+    };
+
+    std::vector<Carrot::Render::LoadedMaterial> materials;
+    materials.reserve(binaryModel.getMaterials().size());
+    for(const Carrot::Render::BinaryModel::Material& material : binaryModel.getMaterials()) {
+        auto& loadedMaterial = materials.emplace_back();
+        loadedMaterial.name = binaryModel.getString(material.name);
+        loadedMaterial.blendMode = static_cast<Carrot::Render::LoadedMaterial::BlendMode>(material.blendMode);
+        loadedMaterial.baseColorFactor = material.baseColorFactor;
+        loadedMaterial.emissiveFactor = material.emissiveFactor;
+        loadedMaterial.metallicFactor = material.metallicFactor;
+        loadedMaterial.roughnessFactor = material.roughnessFactor;
+        loadedMaterial.albedo = texturePath(material.albedo);
+        loadedMaterial.normalMap = texturePath(material.normalMap);
+        loadedMaterial.metallicRoughness = texturePath(material.metallicRoughness);
+        loadedMaterial.occlusion = texturePath(material.occlusion);
+        loadedMaterial.emissive = texturePath(material.emissive);
+    }
+    return materials;
+}
+
 Carrot::Model::Model(Carrot::Engine& engine, const Carrot::IO::Resource& file): engine(engine), resource(file) {}
 
 std::shared_ptr<Carrot::Model> Carrot::Model::load(TaskHandle& task, Carrot::Engine& engine, const Carrot::IO::Resource& file) {
@@ -45,8 +77,18 @@ void Carrot::Model::loadInner(TaskHandle& task, Carrot::Engine& engine, const Ca
 
     Carrot::Log::info("Loading model %s", file.getName().c_str());
 
-    Render::SceneLoader sceneLoader;
-    Render::LoadedScene scene = std::move(sceneLoader.load(file));
+    // binary models are used in place: only materials are converted to a LoadedScene
+    std::optional<Render::BinaryModelView> binaryModel;
+    Render::LoadedScene scene;
+    if(IO::getFileFormat(file.getName().c_str()) == IO::FileFormat::CMODEL) {
+        binaryModelFile = std::make_unique<IO::MappedFile>(file.getFilepath());
+        binaryModel.emplace(binaryModelFile->getData());
+        scene.debugName = file.getName();
+        scene.materials = loadBinaryModelMaterials(*binaryModel, file);
+    } else {
+        Render::SceneLoader sceneLoader;
+        scene = std::move(sceneLoader.load(file));
+    }
 
     // TODO: make different pipelines based on loaded materials
     opaqueMeshesPipeline = engine.getRenderer().getOrCreatePipeline("gBuffer");
@@ -117,95 +159,134 @@ void Carrot::Model::loadInner(TaskHandle& task, Carrot::Engine& engine, const Ca
         materials.push_back(handle);
     }
 
-    staticMeshInfo.resize(scene.primitives.size());
-
-    std::size_t primitiveIndex = 0;
+    auto addStaticMesh = [&](std::size_t meshIndex, const glm::mat4& transform, std::int64_t materialIndex, const Math::Sphere& sphere, std::string_view primitiveName) {
+        const auto& material = materialIndex < 0 ? GetRenderer().getWhiteMaterial() : *materials[materialIndex];
 
-    std::size_t opaqueMeshIndex = 0;
-    std::size_t transparentMeshIndex = 0;
-    for(const auto& primitive : scene.primitives) {
-        if(primitive.isSkinned) {
-            primitiveIndex++;
-            continue;
-        }
+        StaticMeshInfo& meshInfo = staticMeshInfo[meshIndex];
+        std::shared_ptr<Mesh> mesh = std::make_shared<LightMesh>(std::move(staticMeshData->getSubMesh(meshInfo.startVertex, meshInfo.vertexCount, meshInfo.startIndex, meshInfo.indexCount)));
 
-        const std::size_t oldVertexCount = staticVertices.size();
-        const std::size_t oldIndexCount = staticIndices.size();
-        staticVertices.resize(oldVertexCount + primitive.vertices.size());
-        staticIndices.resize(oldIndexCount + primitive.indices.size());
+        const bool isMaterialTransparent = material.isTransparent;
+        auto& drawCommands = isMaterialTransparent ? staticTransparentDrawCommands : staticOpaqueDrawCommands;
+        auto& drawDataList = isMaterialTransparent ? staticTransparentDrawData : staticOpaqueDrawData;
+        auto& instanceDataList = isMaterialTransparent ? staticTransparentInstanceData : staticOpaqueInstanceData;
 
-        memcpy(&staticVertices[oldVertexCount], primitive.vertices.data(), primitive.vertices.size() * sizeof(Carrot::Vertex));
-        memcpy(&staticIndices[oldIndexCount], primitive.indices.data(), primitive.indices.size() * sizeof(std::uint32_t));
+        staticMeshes[material.getSlot()].emplace_back(mesh, transform, sphere, drawCommands.size(), meshIndex);
 
-        auto& info = staticMeshInfo[primitiveIndex];
-        info.meshletVertexIndices = primitive.meshletVertexIndices;
-        info.meshletIndices = primitive.meshletIndices;
-        info.meshlets = primitive.meshlets;
-        info.startVertex = oldVertexCount;
-        info.startIndex = oldIndexCount;
-        info.vertexCount = primitive.vertices.size();
-        info.indexCount = primitive.indices.size();
+        auto& cmd = drawCommands.emplace_back();
+        cmd.instanceCount = 1;
+        cmd.indexCount = meshInfo.indexCount;
+        cmd.firstInstance = drawCommands.size()-1; // increment just before
+        cmd.vertexOffset = meshInfo.startVertex;
+        cmd.firstIndex = meshInfo.startIndex;
 
-        primitiveIndex++;
-    }
+        auto& drawData = drawDataList.emplace_back();
+        drawData.materialIndex = material.getSlot();
 
-    if(!staticVertices.empty()) {
-        verify(!staticIndices.empty(), "Non-indexed meshes not supported");
-        staticMeshData = std::make_unique<SingleMesh>(staticVertices, staticIndices);
-    }
-
-    std::function<void(const Carrot::Render::SkeletonTreeNode&, glm::mat4)> recursivelyLoadNodes = [&](const Carrot::Render::SkeletonTreeNode& node, const glm::mat4& nodeTransform) {
-        glm::mat4 transform = nodeTransform * node.bone.originalTransform;
-        if(node.meshIndices.has_value()) {
-            for(const std::size_t meshIndex : node.meshIndices.value()) {
-                auto& primitive = scene.primitives[meshIndex];
-                std::shared_ptr<Mesh> mesh;
-
-                const auto& material = primitive.materialIndex < 0 ? GetRenderer().getWhiteMaterial() : *materials[primitive.materialIndex];
-
-                Math::Sphere sphere;
-                sphere.loadFromAABB(primitive.minPos, primitive.maxPos);
-
-                // TODO: load all skinned primitive data into same buffer?
-                if(primitive.isSkinned) {
-                    mesh = std::make_shared<SingleMesh>(primitive.skinnedVertices, primitive.indices);
-                    skinnedMeshes[material.getSlot()].emplace_back(mesh, transform, sphere, -1, -1);
-                } else {
-                    StaticMeshInfo& meshInfo = staticMeshInfo[meshIndex];
-                    mesh = std::make_shared<LightMesh>(std::move(staticMeshData->getSubMesh(meshInfo.startVertex, meshInfo.vertexCount, meshInfo.startIndex, meshInfo.indexCount)));
+        auto& instanceData = instanceDataList.emplace_back();
+        mesh->name(scene.debugName + " (" + std::string { primitiveName } + ")");
+    };
 
-                    const bool isMaterialTransparent = material.isTransparent;
-                    auto& drawCommands = isMaterialTransparent ? staticTransparentDrawCommands : staticOpaqueDrawCommands;
-                    auto& drawDataList = isMaterialTransparent ? staticTransparentDrawData : staticOpaqueDrawData;
-                    auto& instanceDataList = isMaterialTransparent ? staticTransparentInstanceData : staticOpaqueInstanceData;
+    if(binaryModel) {
+        // vertices and indices are already laid out as the GPU expects them: copied straight from the mapped file to the staging buffer
+        const std::span<const Render::BinaryModel::Primitive> primitives = binaryModel->getPrimitives();
+        staticMeshInfo.resize(primitives.size());
+        for(std::size_t primitiveIndex = 0; primitiveIndex < primitives.size(); primitiveIndex++) {
+            const Render::BinaryModel::Primitive& primitive = primitives[primitiveIndex];
+            auto& info = staticMeshInfo[primitiveIndex];
+            info.meshletVertexIndices = binaryModel->getMeshletVertexIndices(primitive);
+            info.meshletIndices = binaryModel->getMeshletIndices(primitive);
+            info.meshlets = binaryModel->getMeshlets(primitive);
+            info.startVertex = primitive.vertices.first;
+            info.startIndex = primitive.indices.first;
+            info.vertexCount = primitive.vertices.count;
+            info.indexCount = primitive.indices.count;
+        }
 
-                    staticMeshes[material.getSlot()].emplace_back(mesh, transform, sphere, drawCommands.size(), meshIndex);
+        staticVertices = binaryModel->getVertices();
+        if(!staticVertices.empty()) {
+            verify(!binaryModel->getIndices().empty(), "Non-indexed meshes not supported");
+            staticMeshData = std::make_unique<SingleMesh>(staticVertices, binaryModel->getIndices());
+        }
 
+        for(const Render::BinaryModel::Instance& instance : binaryModel->getInstances()) {
+            const Render::BinaryModel::Primitive& primitive = primitives[instance.primitiveIndex];
+            Math::Sphere sphere;
+            sphere.loadFromAABB(primitive.minPos, primitive.maxPos);
+            addStaticMesh(instance.primitiveIndex, instance.transform, primitive.materialIndex, sphere, binaryModel->getString(primitive.name));
+        }
+    } else {
+        staticMeshInfo.resize(scene.primitives.size());
+        loadedMeshletData.resize(scene.primitives.size());
+
+        std::vector<std::uint32_t> staticIndices;
+        std::size_t primitiveIndex = 0;
+        for(auto& primitive : scene.primitives) {
+            if(primitive.isSkinned) {
+                primitiveIndex++;
+                continue;
+            }
 
+            const std::size_t oldVertexCount = loadedStaticVertices.size();
+            const std::size_t oldIndexCount = staticIndices.size();
+            loadedStaticVertices.resize(oldVertexCount + primitive.vertices.size());
+            staticIndices.resize(oldIndexCount + primitive.indices.size());
+
+            memcpy(&loadedStaticVertices[oldVertexCount], primitive.vertices.data(), primitive.vertices.size() * sizeof(Carrot::Vertex));
+            memcpy(&staticIndices[oldIndexCount], primitive.indices.data(), primitive.indices.size() * sizeof(std::uint32_t));
+
+            // scene is discarded at the end of loading, keep its meshlets instead of copying them
+            auto& meshletData = loadedMeshletData[primitiveIndex];
+            meshletData.meshletVertexIndices = std::move(primitive.meshletVertexIndices);
+            meshletData.meshletIndices = std::move(primitive.meshletIndices);
+            meshletData.meshlets = std::move(primitive.meshlets);
+
+            auto& info = staticMeshInfo[primitiveIndex];
+            info.meshletVertexIndices = meshletData.meshletVertexIndices;
+            info.meshletIndices = meshletData.meshletIndices;
+            info.meshlets = meshletData.meshlets;
+            info.startVertex = oldVertexCount;
+            info.startIndex = oldIndexCount;
+            info.vertexCount = primitive.vertices.size();
+            info.indexCount = primitive.indices.size();
 
-                    auto& cmd = drawCommands.emplace_back();
-                    cmd.instanceCount = 1;
-                    cmd.indexCount = meshInfo.indexCount;
-                    cmd.firstInstance = drawCommands.size()-1; // increment just before
-                    cmd.vertexOffset = meshInfo.startVertex;
-                    cmd.firstIndex = meshInfo.startIndex;
+            primitiveIndex++;
+        }
 
-                    auto& drawData = drawDataList.emplace_back();
-                    drawData.materialIndex = material.getSlot();
+        staticVertices = loadedStaticVertices;
+        if(!staticVertices.empty()) {
+            verify(!staticIndices.empty(), "Non-indexed meshes not supported");
+            staticMeshData = std::make_unique<SingleMesh>(loadedStaticVertices, staticIndices);
+        }
 
-                    auto& instanceData = instanceDataList.emplace_back();
+        std::function<void(const Carrot::Render::SkeletonTreeNode&, glm::mat4)> recursivelyLoadNodes = [&](const Carrot::Render::SkeletonTreeNode& node, const glm::mat4& nodeTransform) {
+            glm::mat4 transform = nodeTransform * node.bone.originalTransform;
+            if(node.meshIndices.has_value()) {
+                for(const std::size_t meshIndex : node.meshIndices.value()) {
+                    auto& primitive = scene.primitives[meshIndex];
+
+                    Math::Sphere sphere;
+                    sphere.loadFromAABB(primitive.minPos, primitive.maxPos);
+
+                    // TODO: load all skinned primitive data into same buffer?
+                    if(primitive.isSkinned) {
+                        const auto& material = primitive.materialIndex < 0 ? GetRenderer().getWhiteMaterial() : *materials[primitive.materialIndex];
+                        std::shared_ptr<Mesh> mesh = std::make_shared<SingleMesh>(primitive.skinnedVertices, primitive.indices);
+                        skinnedMeshes[material.getSlot()].emplace_back(mesh, transform, sphere, -1, -1);
+                        mesh->name(scene.debugName + " (" + primitive.name + ")");
+                    } else {
+                        addStaticMesh(meshIndex, transform, primitive.materialIndex, sphere, primitive.name);
+                    }
                 }
-                mesh->name(scene.debugName + " (" + primitive.name + ")");
             }
-        }
 
-        for(const auto& child : node.getChildren()) {
-            recursivelyLoadNodes(child, transform);
-        }
-    };
+            for(const auto& child : node.getChildren()) {
+                recursivelyLoadNodes(child, transform);
+            }
+        };
 
-    if(scene.nodeHierarchy) {
-        recursivelyLoadNodes(scene.nodeHierarchy->hierarchy, glm::mat4{1.0f});
+        if(scene.nodeHierarchy) {
+            recursivelyLoadNodes(scene.nodeHierarchy->hierarchy, glm::mat4{1.0f});
+        }
     }
 
     // upload staging buffer to GPU buffer
@@ -236,86 +317,94 @@ void Carrot::Model::loadInner(TaskHandle& task, Carrot::Engine& engine, const Ca
         animationData->setDebugNames(Carrot::sprintf("Carrot::Animation %s", debugName.c_str()));
         animationData->stageUploadWithOffsets(make_pair(0ull, std::span(gpuAnimationData)));
 
-        animationBoneTransformData.resize(allAnimations.size());
-        for (std::size_t i = 0; i < allAnimations.size(); ++i) {
-            const Animation& animation = allAnimations[i];
-            animationBoneTransformData[i] = std::move(generateBoneTransformsStorageImage(animation));
-        }
+        if(engine.getConfiguration().cpuAnimationSampling) {
+            // AnimatedInstances samples the compressed animations on the CPU: keyframes are not baked for the GPU
+            compressedAnimations.reserve(allAnimations.size());
+            for(const Animation& animation : allAnimations) {
+                compressedAnimations.emplace_back(CompressedAnimation::compress(animation));
+            }
+        } else {
+            animationBoneTransformData.resize(allAnimations.size());
+            for (std::size_t i = 0; i < allAnimations.size(); ++i) {
+                const Animation& animation = allAnimations[i];
+                animationBoneTransformData[i] = std::move(generateBoneTransformsStorageImage(animation));
+            }
 
-        std::uint32_t animationCount = scene.animationData.size();
-        // create descriptor set for animation buffer, and bone transform data
-        std::array bindings = {
-                vk::DescriptorSetLayoutBinding {
-                    .binding = 0,
-                    .descriptorType = vk::DescriptorType::eStorageBuffer,
-                    .descriptorCount = 1,
-                    .stageFlags = vk::ShaderStageFlagBits::eCompute,
-                },
-                vk::DescriptorSetLayoutBinding {
-                    .binding = 1,
-                    .descriptorType = vk::DescriptorType::eStorageImage,
-                    .descriptorCount = animationCount,
-                    .stageFlags = vk::ShaderStageFlagBits::eCompute,
-                }
-        };
-        animationSetLayout = engine.getLogicalDevice().createDescriptorSetLayoutUnique(vk::DescriptorSetLayoutCreateInfo{
-                .bindingCount = bindings.size(),
-                .pBindings = bindings.data(),
-        }, engine.getAllocator());
-
-        std::array sizes = {
-                vk::DescriptorPoolSize {
-                        .type = vk::DescriptorType::eStorageBuffer,
+            std::uint32_t animationCount = scene.animationData.size();
+            // create descriptor set for animation buffer, and bone transform data
+            std::array bindings = {
+                    vk::DescriptorSetLayoutBinding {
+                        .binding = 0,
+                        .descriptorType = vk::DescriptorType::eStorageBuffer,
+                        .descriptorCount = 1,
+                        .stageFlags = vk::ShaderStageFlagBits::eCompute,
+                    },
+                    vk::DescriptorSetLayoutBinding {
+                        .binding = 1,
+                        .descriptorType = vk::DescriptorType::eStorageImage,
                         .descriptorCount = animationCount,
-                },
-                vk::DescriptorPoolSize {
-                        .type = vk::DescriptorType::eStorageImage,
-                        .descriptorCount = animationCount,
-                }
-        };
-        animationSetPool = engine.getLogicalDevice().createDescriptorPoolUnique(vk::DescriptorPoolCreateInfo {
-                .maxSets = 1,
-                .poolSizeCount = sizes.size(),
-                .pPoolSizes = sizes.data(),
-        }, engine.getAllocator());
-
-        std::vector<vk::DescriptorSetLayout> layouts = {engine.getSwapchainImageCount(), *animationSetLayout};
-        animationDescriptorSets = engine.getLogicalDevice().allocateDescriptorSets(vk::DescriptorSetAllocateInfo {
-                .descriptorPool = *animationSetPool,
-                .descriptorSetCount = 1,
-                .pSetLayouts = layouts.data(),
-        });
-
-        vk::DescriptorBufferInfo bufferInfo {
-                .buffer = animationData->getVulkanBuffer(),
-                .offset = 0,
-                .range = animationData->getSize(),
-        };
-        std::vector<vk::DescriptorImageInfo> imageInfoList {animationCount};
-        std::vector<vk::WriteDescriptorSet> writes{1 + animationCount};
-
-        auto& animationBufferWrite = writes[0];
-        animationBufferWrite.descriptorCount = 1;
-        animationBufferWrite.descriptorType = vk::DescriptorType::eStorageBuffer;
-        animationBufferWrite.dstSet = animationDescriptorSets[0];
-        animationBufferWrite.dstBinding = 0;
-        animationBufferWrite.pBufferInfo = &bufferInfo;
-
-        for(std::size_t imageIndex = 0; imageIndex < animationCount; imageIndex++) {
-            auto& imageInfo = imageInfoList[imageIndex];
-            imageInfo.imageView = animationBoneTransformData[imageIndex]->getView();
-            imageInfo.imageLayout = vk::ImageLayout::eGeneral;
-
-            auto& write = writes[1 + imageIndex];
-            write.descriptorCount = 1;
-            write.descriptorType = vk::DescriptorType::eStorageImage;
-            write.dstSet = animationDescriptorSets[0];
-            write.dstBinding = 1;
-            write.dstArrayElement = imageIndex;
-            write.pImageInfo = &imageInfo;
-        }
+                        .stageFlags = vk::ShaderStageFlagBits::eCompute,
+                    }
+            };
+            animationSetLayout = engine.getLogicalDevice().createDescriptorSetLayoutUnique(vk::DescriptorSetLayoutCreateInfo{
+                    .bindingCount = bindings.size(),
+                    .pBindings = bindings.data(),
+            }, engine.getAllocator());
+
+            std::array sizes = {
+                    vk::DescriptorPoolSize {
+                            .type = vk::DescriptorType::eStorageBuffer,
+                            .descriptorCount = animationCount,
+                    },
+                    vk::DescriptorPoolSize {
+                            .type = vk::DescriptorType::eStorageImage,
+                            .descriptorCount = animationCount,
+                    }
+            };
+            animationSetPool = engine.getLogicalDevice().createDescriptorPoolUnique(vk::DescriptorPoolCreateInfo {
+                    .maxSets = 1,
+                    .poolSizeCount = sizes.size(),
+                    .pPoolSizes = sizes.data(),
+            }, engine.getAllocator());
+
+            std::vector<vk::DescriptorSetLayout> layouts = {engine.getSwapchainImageCount(), *animationSetLayout};
+            animationDescriptorSets = engine.getLogicalDevice().allocateDescriptorSets(vk::DescriptorSetAllocateInfo {
+                    .descriptorPool = *animationSetPool,
+                    .descriptorSetCount = 1,
+                    .pSetLayouts = layouts.data(),
+            });
+
+            vk::DescriptorBufferInfo bufferInfo {
+                    .buffer = animationData->getVulkanBuffer(),
+                    .offset = 0,
+                    .range = animationData->getSize(),
+            };
+            std::vector<vk::DescriptorImageInfo> imageInfoList {animationCount};
+            std::vector<vk::WriteDescriptorSet> writes{1 + animationCount};
+
+            auto& animationBufferWrite = writes[0];
+            animationBufferWrite.descriptorCount = 1;
+            animationBufferWrite.descriptorType = vk::DescriptorType::eStorageBuffer;
+            animationBufferWrite.dstSet = animationDescriptorSets[0];
+            animationBufferWrite.dstBinding = 0;
+            animationBufferWrite.pBufferInfo = &bufferInfo;
+
+            for(std::size_t imageIndex = 0; imageIndex < animationCount; imageIndex++) {
+                auto& imageInfo = imageInfoList[imageIndex];
+                imageInfo.imageView = animationBoneTransformData[imageIndex]->getView();
+                imageInfo.imageLayout = vk::ImageLayout::eGeneral;
+
+                auto& write = writes[1 + imageIndex];
+                write.descriptorCount = 1;
+                write.descriptorType = vk::DescriptorType::eStorageImage;
+                write.dstSet = animationDescriptorSets[0];
+                write.dstBinding = 1;
+                write.dstArrayElement = imageIndex;
+                write.pImageInfo = &imageInfo;
+            }
 
-        engine.getLogicalDevice().updateDescriptorSets(writes, {});
+            engine.getLogicalDevice().updateDescriptorSets(writes, {});
+        }
     }
 
     if(GetCapabilities().supportsRaytracing) {
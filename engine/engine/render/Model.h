@@ -11,6 +11,7 @@
 #include "engine/render/resources/VertexFormat.h"
 #include <core/render/Skeleton.h>
 #include <core/render/Animation.h>
+#include <core/render/AnimationCompression.h>
 #include <core/math/Sphere.h>
 #include "engine/render/MaterialSystem.h"
 #include "engine/render/PassEnum.h"
@@ -19,6 +20,7 @@
 #include "engine/render/GBufferDrawData.h"
 #include "engine/render/resources/Pipeline.h"
 #include "core/render/Meshlet.h"
+#include <core/io/MappedFile.h>
 #include "IDTypes.h"
 
 namespace Carrot {
@@ -48,9 +50,10 @@ namespace Carrot {
         using Ref = std::shared_ptr<Model>;
 
         struct StaticMeshInfo {
-            std::vector<Render::Meshlet> meshlets;
-            std::vector<std::uint32_t> meshletVertexIndices;
-            std::vector<std::uint32_t> meshletIndices;
+            // point inside 'loadedMeshletData', or inside the mapped file for binary models
+            std::span<const Render::Meshlet> meshlets;
+            std::span<const std::uint32_t> meshletVertexIndices;
+            std::span<const std::uint32_t> meshletIndices;
             std::size_t startVertex = 0;
             std::size_t vertexCount = 0;
             std::size_t startIndex = 0;
@@ -98,8 +101,14 @@ namespace Carrot {
          */
         const AnimationMetadata* getAnimationMetadata(const std::string& animationName) const;
         const std::map<std::string, AnimationMetadata>& getAnimationMetadata() const;
+
+        /// Keyframes baked for GPU skinning. Not available when Configuration::cpuAnimationSampling is enabled
         vk::DescriptorSet getAnimationDataDescriptorSet() const;
 
+        /// Compressed versions of the animations of this model, indexed by AnimationMetadata::index. Used for CPU sampling, see AnimationSampler.h
+        /// Empty unless Configuration::cpuAnimationSampling is enabled, in which case keyframes are not baked for the GPU
+        std::span<const CompressedAnimation> getCompressedAnimations() const;
+
     public:
         void renderStatic(Render::ModelRendererStorage& rendererStorage, const Render::Context& renderContext, const InstanceData& instanceData = {}, Render::PassName renderPass = Render::PassEnum::OpaqueGBuffer);
         void renderSkinned(const Render::Context& renderContext, const AnimatedInstanceData& instanceData = {}, Render::PassName renderPass = Render::PassEnum::OpaqueGBuffer);
@@ -130,8 +139,21 @@ namespace Carrot {
         std::unordered_map<std::uint32_t, std::vector<MeshAndTransform>> skinnedMeshes{};
         std::vector<std::shared_ptr<Render::MaterialHandle>> materials{};
 
-        std::vector<Carrot::Vertex> staticVertices;
-        std::vector<std::uint32_t> staticIndices;
+        struct MeshletData {
+            std::vector<Render::Meshlet> meshlets;
+            std::vector<std::uint32_t> meshletVertexIndices;
+            std::vector<std::uint32_t> meshletIndices;
+        };
+
+        /// Vertices of all static meshes, kept on the CPU to build clusters. Points inside 'loadedStaticVertices', or inside 'binaryModelFile'
+        std::span<const Carrot::Vertex> staticVertices;
+
+        // storage for models loaded through SceneLoader
+        std::vector<Carrot::Vertex> loadedStaticVertices;
+        std::vector<MeshletData> loadedMeshletData;
+
+        /// Binary models (.cmodel) are used in place, the file stays mapped as long as this model is alive
+        std::unique_ptr<IO::MappedFile> binaryModelFile;
 
         std::vector<StaticMeshInfo> staticMeshInfo;
         std::unique_ptr<Carrot::SingleMesh> staticMeshData;
@@ -157,6 +179,7 @@ namespace Carrot {
 
         std::map<std::string, AnimationMetadata> animationMapping{};
         std::vector<std::unique_ptr<Carrot::Render::Texture>> animationBoneTransformData;
+        std::vector<CompressedAnimation> compressedAnimations;
         std::unique_ptr<Buffer> animationData = nullptr;
         vk::UniqueDescriptorSetLayout animationSetLayout{};
         vk::UniqueDescriptorPool animationSetPool{};
@@ -9,6 +9,8 @@
 #include <engine/render/resources/SingleMesh.h>
 #include <engine/render/Model.h>
 #include <engine/render/ClusterManager.h>
+#include <engine/render/InstanceTransformHistory.h>
+#include <engine/render/TextureStreamer.h>
 #include <engine/render/VulkanRenderer.h>
 #include <engine/utils/Profiling.h>
 #include <core/utils/JSON.h>
@@ -136,8 +138,8 @@ namespace Carrot::Render {
     }
 
     ModelRenderer::ModelRenderer(Model& model): model(model) {
-        opaqueMeshesPipeline = GetRenderer().getOrCreatePipeline("gBuffer");
-        transparentMeshesPipeline = GetRenderer().getOrCreatePipeline("gBuffer-transparent");
+        opaqueMeshesPipeline = GetRenderer().getOrCreatePipeline("gBuffer-compact");
+        transparentMeshesPipeline = GetRenderer().getOrCreatePipeline("gBuffer-transparent-compact");
 
         recreateStructures();
     }
@@ -345,13 +347,27 @@ namespace Carrot::Render {
             Render::Packet& renderPacket = GetRenderer().makeRenderPacket(renderPass, Render::PacketType::DrawIndexedInstanced, renderContext);
             renderPacket.pipeline = bucket.pipeline;
 
-            renderPacket.commands = bucket.drawCommands;
+            renderPacket.commands = std::span<const Render::PacketCommand>{ bucket.drawCommands };
 
             renderPacket.vertexBuffer = model.getStaticMeshData().getVertexBuffer();
             renderPacket.indexBuffer = model.getStaticMeshData().getIndexBuffer();
 
             renderPacket.addPerDrawData(std::span(bucket.drawData));
-            std::vector<InstanceData> instancesData = bucket.instanceData; // copied because modified below
+
+            // compact pipelines read the previous transform from the InstanceTransformHistory, and the UUID from a separate stream
+            const bool compactInstances = bucket.pipeline->getVertexFormat() == VertexFormat::VertexWithCompactInstanceData;
+            std::vector<InstanceData> instancesData;
+            std::vector<CompactInstanceData> compactInstancesData;
+            std::vector<PickingInstanceData> pickingData;
+            if(compactInstances) {
+                compactInstancesData.resize(bucket.meshes.size());
+                pickingData.resize(bucket.meshes.size(), PickingInstanceData { .uuid = instanceData.uuid });
+                if(!storage.transformSlots) {
+                    storage.transformSlots = std::make_shared<InstanceTransformSlots>();
+                }
+            } else {
+                instancesData = bucket.instanceData; // copied because modified below
+            }
 
             for (const auto& meshInfo: bucket.meshes) {
                 auto& mesh = meshInfo.meshAndTransform.mesh;
@@ -360,14 +376,11 @@ namespace Carrot::Render {
                 auto& meshIndex = meshInfo.meshAndTransform.meshIndex;
                 ZoneScopedN("mesh use");
 
-                InstanceData* pInstanceData = &instancesData[meshIndex];
                 vk::DrawIndexedIndirectCommand* pDrawCommand = &renderPacket.commands[meshIndex].drawIndexedInstanced;
-                *pInstanceData = instanceData;
-
-                pInstanceData->transform = instanceData.transform * transform;
+                const glm::mat4 meshTransform = instanceData.transform * transform;
 
                 Math::Sphere s = sphere;
-                s.transform(pInstanceData->transform);
+                s.transform(meshTransform);
 
                 bool frustumCheck = renderContext.getCamera().isInFrustum(s);
                 if(DisableFrustumCheck) {
@@ -379,6 +392,10 @@ namespace Carrot::Render {
                     continue;
                 }
 
+                if(meshInfo.materialTextures) {
+                    renderContext.renderer.getTextureStreamer().requestMaterial(renderContext, *meshInfo.materialTextures, s);
+                }
+
                 if(DrawBoundingSpheres) {
                     if(&model != renderContext.renderer.getUnitSphere().get()) {
                         glm::mat4 sphereTransform = glm::translate(glm::mat4{1.0f}, s.center) * glm::scale(glm::mat4{1.0f}, glm::vec3{s.radius*2 /*unit sphere model has a radius of 0.5*/});
@@ -386,10 +403,32 @@ namespace Carrot::Render {
                     }
                 }
 
-                pInstanceData->lastFrameTransform = instanceData.lastFrameTransform * transform;
+                const glm::mat4 lastFrameMeshTransform = instanceData.lastFrameTransform * transform;
+                if(compactInstances) {
+                    const InstanceTransformHistory::Slot slot = storage.transformSlots->getOrAllocate(meshInfo.meshAndTransform.staticMeshIndex);
+                    compactInstancesData[meshIndex] = CompactInstanceData {
+                        .color = instanceData.color,
+                        .transform = AffineTransform::fromMatrix(meshTransform),
+                        .previousTransformSlot = renderContext.renderer.getInstanceTransformHistory().submit(renderContext, slot, lastFrameMeshTransform),
+                    };
+                } else {
+                    InstanceData* pInstanceData = &instancesData[meshIndex];
+                    *pInstanceData = instanceData;
+                    pInstanceData->transform = meshTransform;
+                    pInstanceData->lastFrameTransform = lastFrameMeshTransform;
+                }
             }
 
-            renderPacket.useInstances(std::span(instancesData));
+            if(compactInstances) {
+                renderPacket.useInstances(std::span(compactInstancesData));
+                renderPacket.usePickingData(std::span(pickingData));
+
+                // by convention, previous transforms are inside the last set of compact pipelines
+                const std::uint32_t previousTransformsSetID = bucket.pipeline->getDescription().setCount - 1;
+                renderContext.renderer.bindBuffer(*bucket.pipeline, renderContext, renderContext.renderer.getInstanceTransformHistory().getBuffer(renderContext), previousTransformsSetID, 0);
+            } else {
+                renderPacket.useInstances(std::span(instancesData));
+            }
 
             renderContext.renderer.render(renderPacket);
         }
@@ -21,6 +21,7 @@ namespace Carrot {
 
 namespace Carrot::Render {
     struct ClusterModel;
+    struct InstanceTransformSlots;
 
     struct MaterialOverride {
         std::size_t meshIndex = 0;
@@ -94,6 +95,7 @@ namespace Carrot::Render {
 
     struct ModelRendererStorage {
         std::unordered_map<Viewport*, std::shared_ptr<ClusterModel>> clusterModelsPerViewport;
+        std::shared_ptr<InstanceTransformSlots> transformSlots; // slots inside InstanceTransformHistory, allocated on first render
         const ModelRenderer* pCreator = nullptr;
 
         ModelRendererStorage clone() const;
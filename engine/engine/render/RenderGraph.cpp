@@ -144,9 +144,70 @@ namespace Carrot::Render {
         return r;
     }
 
+    void GraphBuilder::markPersistent(const FrameResource& resource) {
+        persistentResources.insert(resource.rootID);
+    }
+
+    std::vector<TransientTexture> GraphBuilder::computeTransientTextures() const {
+        struct Lifetime {
+            const FrameResource* pResource = nullptr; // set if created by this graph
+            std::uint32_t firstPass = 0;
+            std::uint32_t lastUse = 0;
+            std::optional<std::uint32_t> lastRead;
+        };
+        std::unordered_map<Carrot::UUID, Lifetime> lifetimes;
+
+        std::uint32_t passIndex = 0;
+        for(const auto& [name, pass] : passes) {
+            for(const auto& output : pass->outputs) {
+                Lifetime& lifetime = lifetimes[output.resource.rootID];
+                if(output.isCreatedInThisPass) {
+                    lifetime.pResource = &output.resource;
+                    lifetime.firstPass = passIndex;
+                }
+                lifetime.lastUse = passIndex;
+            }
+            for(const auto& input : pass->inputs) {
+                Lifetime& lifetime = lifetimes[input.resource.rootID];
+                lifetime.lastUse = passIndex;
+                lifetime.lastRead = passIndex;
+            }
+            passIndex++;
+        }
+
+        const std::uint32_t lastPass = passIndex - 1;
+        std::vector<TransientTexture> result;
+        for(const auto& [rootID, lifetime] : lifetimes) {
+            if(lifetime.pResource == nullptr || lifetime.pResource->imageOrigin != ImageOrigin::Created) {
+                continue;
+            }
+            if(persistentResources.contains(rootID)) {
+                continue;
+            }
+
+            // content written after the last read, or still there after the last pass, is probably used outside of this graph
+            if(!lifetime.lastRead.has_value() || lifetime.lastRead.value() != lifetime.lastUse || lifetime.lastUse >= lastPass) {
+                continue;
+            }
+
+            result.emplace_back(TransientTexture {
+                .resource = *lifetime.pResource,
+                .firstPass = lifetime.firstPass,
+                .lastPass = lifetime.lastUse,
+            });
+        }
+        return result;
+    }
+
     std::unique_ptr<Graph> GraphBuilder::compile() {
         auto result = std::make_unique<Graph>(GetVulkanDriver());
 
+        // transient textures are created before the passes, so that passes find them instead of creating their own
+        result->transientTextures = computeTransientTextures();
+        result->needsAliasingBarrier.resize(passes.size());
+        result->parallelRecordings.resize(passes.size());
+        result->createTransientTextures(window.getFramebufferExtent());
+
         for(const auto& [name, pass] : passes) {
             result->passes.emplace_back(name, std::move(pass->compile(GetVulkanDriver(), window, *result)));
         }
@@ -160,11 +221,24 @@ namespace Carrot::Render {
         return result;
     }
 
-    Graph::Graph(VulkanDriver& driver): driver(driver) {
+    Graph::Graph(VulkanDriver& driver): driver(driver), transientGroup([&driver](const Carrot::UUID& groupID) {
+        driver.getTextureRepository().removeAliasedTextures(groupID);
+    }) {
         ed::Config config;
         nodesContext = ed::CreateEditor(&config);
     }
 
+    void Graph::createTransientTextures(const vk::Extent2D& viewportSize) {
+        transientLayout = driver.getTextureRepository().createAliasedTextures(transientGroup.getID(), transientTextures, viewportSize);
+
+        std::fill(needsAliasingBarrier.begin(), needsAliasingBarrier.end(), false);
+        for(std::size_t i = 0; i < transientTextures.size(); i++) {
+            if(!transientLayout.placements[i].aliasedResources.empty()) {
+                needsAliasingBarrier[transientTextures[i].firstPass] = true;
+            }
+        }
+    }
+
     static std::uint32_t uniqueID = 1;
     static std::unordered_map<std::uint32_t, ed::NodeId> nodes;
 
@@ -327,6 +401,13 @@ namespace Carrot::Render {
                 if(ImGui::RadioButton(id.c_str(), graphToDebug == this)) {
                     graphToDebug = this;
                 }
+                constexpr double MiB = 1024.0 * 1024.0;
+                ImGui::Text("%llu transient textures: %.2f MiB instead of %.2f MiB, %.2f MiB saved per swapchain image (%.2f MiB in total)",
+                            transientTextures.size(),
+                            transientLayout.aliasedSize / MiB,
+                            transientLayout.unaliasedSize / MiB,
+                            transientLayout.getSavedBytes() / MiB,
+                            transientLayout.getSavedBytes() * driver.getSwapchainImageCount() / MiB);
 
                 if(graphToDebug == this) {
                     /*nodes.clear();
@@ -386,8 +467,39 @@ namespace Carrot::Render {
     void Graph::execute(const Render::Context& data, vk::CommandBuffer& cmds) {
         ZoneScoped;
 
+        // passes which opted in with recordInParallel (for now, only the gbuffer pass) are recorded on worker threads, at the same
+        //  time as each other and as the passes this thread records. Renderer state touched while recording is locked: descriptor
+        //  bindings and per-draw data (VulkanRenderer), the single-frame GPU allocator, pipelines (Pipeline) and image views (Texture)
+        for(std::size_t passIndex = 0; passIndex < sortedPasses.size(); passIndex++) {
+            CompiledPass* pass = sortedPasses[passIndex];
+            if(!pass->isRecordedInParallel()) {
+                continue;
+            }
+            GetTaskScheduler().schedule(TaskDescription {
+                .name = "Record render graph pass",
+                .task = [pass, pContext = &data](TaskHandle&) {
+                    pass->recordSecondaryCommands(*pContext);
+                },
+                .joiner = &parallelRecordings[passIndex],
+            }, TaskScheduler::FrameParallelWork);
+        }
+
         std::string id = "";
+        std::size_t passIndex = 0;
         for(auto* pass : sortedPasses) {
+            if(pass->isRecordedInParallel()) {
+                ZoneScopedN("Wait for parallel pass recording");
+                parallelRecordings[passIndex].busyWait();
+            }
+            if(needsAliasingBarrier[passIndex++]) {
+                // memory of a transient texture of this pass was used by other textures earlier in the frame
+                vk::MemoryBarrier aliasingBarrier {
+                    .srcAccessMask = vk::AccessFlagBits::eMemoryWrite,
+                    .dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite,
+                };
+                cmds.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eAllCommands, static_cast<vk::DependencyFlags>(0), aliasingBarrier, {}, {});
+            }
+
 #ifdef TRACY_ENABLE
             std::string passName = "Execute pass ";
             GetVulkanDriver().setFormattedMarker(cmds, "Pass %s", pass->getName().data());
@@ -424,6 +536,11 @@ namespace Carrot::Render {
     }
 
     void Graph::onSwapchainSizeChange(Window& window, int newWidth, int newHeight) {
+        // passes will use the new transient textures when recreating their framebuffers
+        createTransientTextures(vk::Extent2D {
+            .width = static_cast<std::uint32_t>(newWidth),
+            .height = static_cast<std::uint32_t>(newHeight),
+        });
         for(auto& [n, pass] : passes) {
             pass->onSwapchainSizeChange(window, newWidth, newHeight);
         }
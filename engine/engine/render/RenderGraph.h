@@ -9,6 +9,8 @@
 #include <list>
 #include "core/utils/UUID.h"
 #include "RenderPassData.h"
+#include "TextureRepository.h"
+#include <core/async/Counter.h>
 
 namespace Carrot {
     class Window;
@@ -57,11 +59,24 @@ namespace Carrot::Render {
     private:
         void drawPassNodes(const Render::Context& context, Render::CompiledPass* pass, std::uint32_t passIndex);
 
+        /// (Re)creates the textures of transient resources, sharing memory between the ones with non-overlapping lifetimes
+        void createTransientTextures(const vk::Extent2D& viewportSize);
+
         Carrot::VulkanDriver& driver;
+        // transient textures and their memory are released with the graph, after the passes (declared before them)
+        TransientGroup transientGroup;
         std::list<std::pair<std::string, std::unique_ptr<Render::CompiledPass>>> passes;
         std::vector<Render::CompiledPass*> sortedPasses;
         std::list<std::pair<std::string, std::any>> passesData;
 
+        // memory aliasing
+        std::vector<TransientTexture> transientTextures;
+        TransientHeapLayout transientLayout;
+        std::vector<bool> needsAliasingBarrier; // [passIndex] true if a transient texture reuses memory of another texture in this pass
+
+        // parallel recording
+        std::vector<Async::Counter> parallelRecordings; // [passIndex] signaled once the pass is recorded, only used for passes recorded in parallel
+
         // for imgui debug
         void* nodesContext = nullptr;
         const FrameResource* hoveredResource = nullptr;
@@ -112,6 +127,13 @@ namespace Carrot::Render {
         FrameResource& createStorageTarget(std::string name, vk::Format format, TextureSize size, vk::ImageLayout layout = vk::ImageLayout::eColorAttachmentOptimal);
         void present(FrameResource& toPresent);
 
+        /**
+         * Prevents the memory of this resource from being reused by other resources of this graph.
+         * Required for resources which are read outside of the graph, or read by the next frames (temporal effects).
+         * Resources still used by the last pass of the graph, or never read by another pass of the graph, are always kept.
+         */
+        void markPersistent(const FrameResource& resource);
+
         template<typename Type>
         std::optional<Type> getPassData(std::string_view passName) const {
             for(const auto& [name, passData] : passesData) {
@@ -122,10 +144,14 @@ namespace Carrot::Render {
         }
 
     private:
+        /// Lifetime analysis: which textures are only needed between two passes of this graph?
+        std::vector<TransientTexture> computeTransientTextures() const;
+
         Window& window;
         FrameResource swapchainImage;
         std::list<FrameResource> resources;
         std::set<Carrot::UUID> toPresent;
+        std::set<Carrot::UUID> persistentResources;
         std::list<std::pair<std::string, std::shared_ptr<Render::PassBase>>> passes;
         std::list<std::pair<std::string, std::any>> passesData;
         Render::PassBase* currentPass = nullptr;
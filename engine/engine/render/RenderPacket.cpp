@@ -19,20 +19,23 @@ namespace Carrot::Render {
     , source(sourceLocation)
     , pass(pass)
     , packetType(packetType)
+    , commands(container.getAllocator())
     {
+        commands.setGrowthFactor(2.0f);
         viewport = &GetEngine().getMainViewport();
     };
 
-    Packet::Packet(const Packet& toCopy): container(toCopy.container) {
+    Packet::Packet(const Packet& toCopy): container(toCopy.container), commands(toCopy.container.getAllocator()) {
         *this = toCopy;
     }
 
-    Packet::Packet(Packet&& toMove): container(toMove.container) {
+    Packet::Packet(Packet&& toMove): container(toMove.container), commands(toMove.container.getAllocator()) {
         *this = std::move(toMove);
     }
 
     Packet::~Packet() {
         container.deallocateGeneric(std::move(instancingDataBuffer));
+        container.deallocateGeneric(std::move(pickingDataBuffer));
         container.deallocateGeneric(std::move(perDrawData));
     }
 
@@ -40,7 +43,7 @@ namespace Carrot::Render {
         vertexBuffer = mesh.getVertexBuffer();
         indexBuffer = mesh.getIndexBuffer();
 
-        auto& cmd = commands.empty() ? commands.emplace_back().drawIndexedInstanced : commands[0].drawIndexedInstanced;
+        auto& cmd = commands.empty() ? commands.emplaceBack().drawIndexedInstanced : commands[0].drawIndexedInstanced;
         cmd.indexCount = mesh.getIndexCount();
         cmd.instanceCount = 1;
     }
@@ -210,8 +213,17 @@ namespace Carrot::Render {
             instanceBuffer.directUpload(instancingDataBuffer.data(), instancingDataBuffer.size());
         }
 
+        Carrot::BufferView pickingBuffer;
+        if(!pickingDataBuffer.empty()) {
+            ZoneScopedN("Upload picking buffer");
+            pickingBuffer = renderer.getInstanceBuffer(pickingDataBuffer.size());
+            pickingBuffer.directUpload(pickingDataBuffer.data(), pickingDataBuffer.size());
+        }
+
         if(vertexBuffer) {
-            if(instanceBuffer) {
+            if(instanceBuffer && pickingBuffer) {
+                cmds.bindVertexBuffers(0, { vertexBuffer.getVulkanBuffer(), instanceBuffer.getVulkanBuffer(), pickingBuffer.getVulkanBuffer() }, { vertexBuffer.getStart(), instanceBuffer.getStart(), pickingBuffer.getStart() });
+            } else if(instanceBuffer) {
                 cmds.bindVertexBuffers(0, { vertexBuffer.getVulkanBuffer(), instanceBuffer.getVulkanBuffer() }, { vertexBuffer.getStart(), instanceBuffer.getStart() });
             } else {
                 cmds.bindVertexBuffers(0, { vertexBuffer.getVulkanBuffer() }, { vertexBuffer.getStart() });
@@ -338,6 +350,7 @@ namespace Carrot::Render {
 
         source = std::move(toMove.source);
         instancingDataBuffer = std::move(toMove.instancingDataBuffer);
+        pickingDataBuffer = std::move(toMove.pickingDataBuffer);
         pushConstantCount = std::exchange(toMove.pushConstantCount, 0);
         for(std::size_t i = 0; i < pushConstantCount; i++) {
             pushConstants[i] = std::exchange(toMove.pushConstants[i], nullptr);
@@ -368,6 +381,7 @@ namespace Carrot::Render {
         source = toCopy.source;
 
         instancingDataBuffer = toCopy.instancingDataBuffer;
+        pickingDataBuffer = toCopy.pickingDataBuffer;
         // deep copies
         pushConstantCount = toCopy.pushConstantCount;
         for(std::size_t pushConstantIndex = 0; pushConstantIndex < pushConstantCount; pushConstantIndex++) {
@@ -10,6 +10,7 @@
 #include <list>
 #include <span>
 #include <core/Allocator.h>
+#include <core/containers/Vector.hpp>
 
 #include "resources/Buffer.h"
 #include "resources/BufferView.h"
@@ -97,7 +98,7 @@ namespace Carrot::Render {
         std::uint32_t instanceCount = 1; // Total number of instances for this packet, used to offset firstInstance when merging packets
 
         PacketType packetType = PacketType::Unknown;
-        std::vector<PacketCommand> commands;
+        Carrot::Vector<PacketCommand> commands; // allocated from the PacketContainer of this packet, only valid for the current frame
 
         TransparentPassData transparentGBuffer;
 
@@ -130,6 +131,14 @@ namespace Carrot::Render {
             useInstances(std::span<T>{&instance, 1});
         }
 
+        /// Per-instance data bound to vertex binding 2, for vertex formats which keep picking data in a separate stream
+        /// (eg VertexWithCompactInstanceData)
+        template<typename T>
+        void usePickingData(const std::span<T>& instance) {
+            pickingDataBuffer = allocateGeneric(instance.size_bytes());
+            std::memcpy(pickingDataBuffer.data(), instance.data(), instance.size_bytes());
+        }
+
         void addPerDrawData(const std::span<const GBufferDrawData>& data);
         void clearPerDrawData();
 
@@ -153,6 +162,7 @@ namespace Carrot::Render {
         PacketContainer& container;
         std::source_location source;
         std::span<std::uint8_t> instancingDataBuffer;
+        std::span<std::uint8_t> pickingDataBuffer;
         std::span<std::uint8_t> perDrawData;
         std::size_t pushConstantCount = 0;
         PushConstant* pushConstants[MAX_PUSH_CONSTANTS];
@@ -10,46 +10,28 @@ namespace Carrot::Render {
 
     void PacketContainer::beginFrame() {
         ZoneScoped;
-        renderPackets.beginFrame();
-        pushConstants.beginFrame();
-
-        {
-            Async::LockGuard l{genericDataAccess};
-            if (!genericDynamicStorage.empty()) {
-                std::size_t additionalSize = 0;
-                for (const auto& v: genericDynamicStorage) {
-                    additionalSize += v.size();
-                }
-                genericStaticStorage.resize(genericStaticStorage.size() + additionalSize);
-                genericDynamicStorage.clear();
-            }
-            genericCursor = 0;
-        }
+        Async::LockGuard l { arenaAccess };
+        arena.reset();
     }
 
     /// Makes a new RenderPacket. The returned reference is valid only for the current frame
     Packet& PacketContainer::make(Carrot::Render::PassName pass, const Render::PacketType& packetType, Carrot::Render::Viewport* viewport, std::source_location location) {
         ZoneScoped;
-        auto& r = renderPackets.allocate(*this, pass, packetType, location);
+        Async::LockGuard l { arenaAccess };
+        auto& r = arena.make<Packet>(*this, pass, packetType, location);
         r.viewport = viewport;
         return r;
     }
 
     Packet::PushConstant& PacketContainer::makePushConstant() {
-        return pushConstants.allocate(*this);
+        Async::LockGuard l { arenaAccess };
+        return arena.make<Packet::PushConstant>(*this);
     }
 
     std::span<std::uint8_t> PacketContainer::allocateGeneric(std::size_t size) {
-        Async::LockGuard l { genericDataAccess };
-        if(genericCursor + size <= genericStaticStorage.size()) {
-            std::uint8_t* ptr = genericStaticStorage.data() + genericCursor;
-            genericCursor += size;
-            return { ptr, size };
-        }
-        genericDynamicStorage.emplace_back();
-        auto& v = genericDynamicStorage.back();
-        v.resize(size);
-        return { v.data(), v.size() };
+        Async::LockGuard l { arenaAccess };
+        MemoryBlock block = arena.allocate(size, alignof(std::max_align_t));
+        return { static_cast<std::uint8_t*>(block.ptr), size };
     }
 
     std::span<std::uint8_t> PacketContainer::copyGeneric(const std::span<std::uint8_t>& toCopy) {
@@ -59,6 +41,35 @@ namespace Carrot::Render {
     }
 
     void PacketContainer::deallocateGeneric(std::span<std::uint8_t>&& toDestroy) {
-        // no op
+        // no op, freed at the beginning of the next frame
+    }
+
+    Allocator& PacketContainer::getAllocator() {
+        return lockedArena;
+    }
+
+    std::size_t PacketContainer::getBytesUsed() {
+        Async::LockGuard l { arenaAccess };
+        return arena.getBytesUsed();
+    }
+
+    std::size_t PacketContainer::getBytesUsedLastFrame() {
+        Async::LockGuard l { arenaAccess };
+        return arena.getBytesUsedBeforeReset();
+    }
+
+    MemoryBlock PacketContainer::LockedArena::allocate(std::size_t size, std::size_t alignment) {
+        Async::LockGuard l { container.arenaAccess };
+        return container.arena.allocate(size, alignment);
+    }
+
+    void PacketContainer::LockedArena::deallocate(const MemoryBlock& block) {
+        Async::LockGuard l { container.arenaAccess };
+        container.arena.deallocate(block);
+    }
+
+    MemoryBlock PacketContainer::LockedArena::reallocate(const MemoryBlock& block, const std::size_t size, std::size_t alignment) {
+        Async::LockGuard l { container.arenaAccess };
+        return container.arena.reallocate(block, size, alignment);
     }
-}
\ No newline at end of file
+}
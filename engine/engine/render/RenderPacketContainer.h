@@ -5,90 +5,21 @@
 #pragma once
 
 #include "RenderPacket.h"
+#include <core/allocators/ArenaAllocator.h>
 #include <core/async/Locks.h>
 
 namespace Carrot::Render {
     /// Container responsible for RenderPacket-related allocations
-    ///  This also means that push constant, and instance storage are handled by this container.
-    ///  The strategy is to hold two structures:
-    ///     - a contiguous one: its size will grow each frame if the amount of memory used in the previous frame was higher than the amount used before
-    ///     - a linked-list-like one: its role is to allow for allocations to continue even if the entire contiguous storage has been used
+    ///  This also means that push constant, instance storage and per-draw data are handled by this container.
+    ///  Everything lives inside a single linear arena, which is reset at the beginning of the frame this container is used for:
+    ///  after a few frames, the arena fits the entire frame in a single contiguous block of memory and allocations are only a pointer bump.
     ///  Designed to be thread-safe (but blocking!)
     class PacketContainer {
-    private:
-        template<typename StoredType>
-        class Storage {
-        public:
-            explicit Storage() {}
-
-            ~Storage() {
-                deleteStorage();
-            }
-
-            /// Completely reset the storage as if it was brand new (ie 0 elements)
-            void reset() {
-                Async::LockGuard l { lock };
-                clearStorage();
-                deleteStorage();
-                dynamicStorage.resize(0);
-            }
-
-            /// Signals the start of a new frame. The storage is resized and its capacity is increased if necessary
-            void beginFrame() {
-                Async::LockGuard l { lock };
-                clearStorage();
-                if(!dynamicStorage.empty()) {
-                    std::size_t previousSize = staticStorageSize;
-                    deleteStorage();
-                    staticStorage = static_cast<StoredType*>(malloc((previousSize + dynamicStorage.size()) * sizeof(StoredType)));
-                    verify(staticStorage != nullptr, "allocation error!");
-                    staticStorageSize = previousSize + dynamicStorage.size();
-                }
-
-                dynamicStorage.clear();
-            }
-
-            /// Allocates a 'StoredType' from this container. The reference is valid until the next call to 'beginFrame'
-            template<typename... Args>
-            StoredType& allocate(Args&&... args) {
-                Async::LockGuard l { lock };
-                if(cursor < staticStorageSize) {
-                    auto ptr = new(&staticStorage[cursor++]) StoredType(std::forward<Args>(args)...);
-                    return *ptr;
-                }
-                return dynamicStorage.emplace_back(std::forward<Args>(args)...);
-            }
-        private:
-            void clearStorage() {
-                if(staticStorage != nullptr) {
-                    for (std::size_t i = 0; i < cursor; i++) {
-                        staticStorage[i].~StoredType();
-                    }
-                }
-                cursor = 0;
-            }
-
-            void deleteStorage() {
-                if(staticStorage != nullptr) {
-                    free(staticStorage);
-                    staticStorage = nullptr;
-                    staticStorageSize = 0;
-                }
-            }
-
-        private:
-            Async::SpinLock lock;
-            std::size_t cursor = 0;
-            StoredType* staticStorage = nullptr;
-            std::size_t staticStorageSize = 0;
-            std::list<StoredType> dynamicStorage;
-        };
-
     public:
         explicit PacketContainer();
 
     public:
-        /// Signals the start of a new frame. The storage is resized and its capacity is increased if necessary
+        /// Signals the start of a new frame. All packets and data allocated from this container during the previous use are destroyed.
         void beginFrame();
 
         /// Makes a new RenderPacket. The returned reference is valid only for the current frame
@@ -100,13 +31,32 @@ namespace Carrot::Render {
         std::span<std::uint8_t> copyGeneric(const std::span<std::uint8_t>& toCopy);
         void deallocateGeneric(std::span<std::uint8_t>&& toDestroy);
 
+        /// Allocator which can be used for containers which only live for the current frame (for instance, Carrot::Vector)
+        Allocator& getAllocator();
+
+        /// How many bytes have been allocated from this container since the beginning of the frame
+        std::size_t getBytesUsed();
+
+        /// How many bytes were allocated from this container during its previous use (ie before the latest call to beginFrame)
+        std::size_t getBytesUsedLastFrame();
+
     private:
-        Storage<Render::Packet> renderPackets;
-        Storage<Render::Packet::PushConstant> pushConstants;
+        /// Locks the arena of the container for each operation
+        class LockedArena: public Allocator {
+        public:
+            explicit LockedArena(PacketContainer& container): container(container) {}
+
+            MemoryBlock allocate(std::size_t size, std::size_t alignment = 1) override;
+            void deallocate(const MemoryBlock& block) override;
+            MemoryBlock reallocate(const MemoryBlock& block, const std::size_t size, std::size_t alignment = 1) override;
+
+        private:
+            PacketContainer& container;
+        };
 
-        Async::SpinLock genericDataAccess;
-        std::size_t genericCursor = 0;
-        std::vector<std::uint8_t> genericStaticStorage;
-        std::list<std::vector<std::uint8_t>> genericDynamicStorage;
+        // reentrant: destroying packets at the beginning of the frame deallocates their data from the same arena
+        Async::ReentrantSpinLock arenaAccess;
+        ArenaAllocator arena;
+        LockedArena lockedArena { *this };
     };
 }
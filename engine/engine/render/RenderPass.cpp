@@ -24,6 +24,7 @@ Carrot::Render::CompiledPass::CompiledPass(
         InitCallback initCallback,
         SwapchainRecreationCallback swapchainCallback,
         bool prerecordable,
+        bool recordInParallel,
         const Carrot::UUID& passID
         ):
         graph(graph),
@@ -36,15 +37,20 @@ Carrot::Render::CompiledPass::CompiledPass(
         swapchainRecreationCallback(std::move(swapchainCallback)),
         name(std::move(name)),
         prerecordable(prerecordable),
+        recordInParallel(recordInParallel),
         passID(passID)
         {
             rasterized = true;
             this->viewportSize = viewportSize;
             createFramebuffers();
+            verify(!(prerecordable && recordInParallel), "A pass cannot be both pre-recorded and recorded in parallel");
             if(prerecordable) {
                 createCommandPool();
                 needsRecord.resize(GetEngine().getSwapchainImageCount());
             }
+            if(recordInParallel) {
+                createCommandPool();
+            }
         }
 
 Carrot::Render::CompiledPass::CompiledPass(
@@ -56,6 +62,7 @@ Carrot::Render::CompiledPass::CompiledPass(
         InitCallback initCallback,
         SwapchainRecreationCallback swapchainCallback,
         bool prerecordable,
+        bool recordInParallel,
         const Carrot::UUID& passID
         ):
         graph(graph),
@@ -67,15 +74,20 @@ Carrot::Render::CompiledPass::CompiledPass(
         swapchainRecreationCallback(std::move(swapchainCallback)),
         name(std::move(name)),
         prerecordable(prerecordable),
+        recordInParallel(recordInParallel),
         passID(passID)
         {
             rasterized = false;
             this->viewportSize = viewportSize;
             createFramebuffers();
+            verify(!(prerecordable && recordInParallel), "A pass cannot be both pre-recorded and recorded in parallel");
             if(prerecordable) {
                 createCommandPool();
                 needsRecord.resize(GetEngine().getSwapchainImageCount());
             }
+            if(recordInParallel) {
+                createCommandPool();
+            }
         }
 
 void Carrot::Render::CompiledPass::performTransitions(const Render::Context& renderContext, vk::CommandBuffer& cmds) {
@@ -99,6 +111,7 @@ void Carrot::Render::CompiledPass::execute(const Render::Context& renderContext,
     {
         ZoneScopedN("Render pass recording");
 
+        const bool usesSecondaryCommandBuffers = prerecordable || recordInParallel;
         if(rasterized) {
             cmds.beginRenderPass(vk::RenderPassBeginInfo {
                     .renderPass = *renderPass,
@@ -109,8 +122,8 @@ void Carrot::Render::CompiledPass::execute(const Render::Context& renderContext,
                     },
                     .clearValueCount = static_cast<uint32_t>(clearValues.size()),
                     .pClearValues = clearValues.data(),
-            }, prerecordable ? vk::SubpassContents::eSecondaryCommandBuffers : vk::SubpassContents::eInline);
-            if(!prerecordable) {
+            }, usesSecondaryCommandBuffers ? vk::SubpassContents::eSecondaryCommandBuffers : vk::SubpassContents::eInline);
+            if(!usesSecondaryCommandBuffers) {
                 getVulkanDriver().updateViewportAndScissor(cmds, renderSize);
             }
         }
@@ -125,6 +138,9 @@ void Carrot::Render::CompiledPass::execute(const Render::Context& renderContext,
                 needsRecord[renderContext.swapchainIndex] = false;
             }
 
+            cmds.executeCommands(commandBuffers[renderContext.swapchainIndex]);
+        } else if(recordInParallel) {
+            // already recorded by recordSecondaryCommands, the graph waited for it before calling execute
             cmds.executeCommands(commandBuffers[renderContext.swapchainIndex]);
         } else {
             renderingCode(*this, renderContext, cmds);
@@ -136,6 +152,44 @@ void Carrot::Render::CompiledPass::execute(const Render::Context& renderContext,
     }
 }
 
+void Carrot::Render::CompiledPass::recordSecondaryCommands(const Render::Context& renderContext) {
+    ZoneScopedN("Record pass on worker");
+    ZoneText(name.c_str(), name.size());
+    verify(recordInParallel, "Pass is not recorded in parallel");
+
+    if(commandBuffers.empty()) {
+        commandBuffers = getVulkanDriver().getLogicalDevice().allocateCommandBuffers(vk::CommandBufferAllocateInfo {
+                .commandPool = *commandPool,
+                .level = vk::CommandBufferLevel::eSecondary,
+                .commandBufferCount = static_cast<std::uint32_t>(getVulkanDriver().getSwapchainImageCount()),
+        });
+    }
+
+    auto& cmds = commandBuffers[renderContext.swapchainIndex];
+    cmds.reset();
+
+    // non-rasterized passes still need an inheritance info, but it is ignored outside of render passes
+    vk::CommandBufferInheritanceInfo inheritanceInfo {};
+    vk::CommandBufferUsageFlags usage = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+    if(rasterized) {
+        inheritanceInfo.renderPass = *renderPass;
+        inheritanceInfo.subpass = 0; // TODO: modify if subpasses become supported
+        inheritanceInfo.framebuffer = *framebuffers[renderContext.swapchainIndex];
+        usage |= vk::CommandBufferUsageFlagBits::eRenderPassContinue;
+    }
+    cmds.begin(vk::CommandBufferBeginInfo {
+            .flags = usage,
+            .pInheritanceInfo = &inheritanceInfo,
+    });
+
+    if(rasterized) {
+        getVulkanDriver().updateViewportAndScissor(cmds, renderSize);
+    }
+
+    renderingCode(*this, renderContext, cmds);
+    cmds.end();
+}
+
 void Carrot::Render::CompiledPass::refresh() {
     std::fill(needsRecord.begin(), needsRecord.end(), true);
 }
@@ -324,7 +378,7 @@ std::unique_ptr<Carrot::Render::CompiledPass> Carrot::Render::PassBase::compile(
             return framebuffers;
         };
         result = std::make_unique<CompiledPass>(graph, name, viewportSize, std::move(renderPass), clearValues,
-                                         generateCallback(), std::move(prePassTransitions), init, generateSwapchainCallback(), prerecordable, passID);
+                                         generateCallback(), std::move(prePassTransitions), init, generateSwapchainCallback(), prerecordable, recordInParallel, passID);
     } else {
         auto init = [outputs = outputs](CompiledPass& pass, const vk::Extent2D& viewportSize, vk::Extent2D& renderSize) {
             for (int i = 0; i < pass.getVulkanDriver().getSwapchainImageCount(); ++i) {
@@ -338,7 +392,7 @@ std::unique_ptr<Carrot::Render::CompiledPass> Carrot::Render::PassBase::compile(
             renderSize.height = 0;
             return std::vector<vk::UniqueFramebuffer>{}; // no framebuffers for non-rasterized passes
         };
-        result = make_unique<CompiledPass>(graph, name, viewportSize, generateCallback(), std::move(prePassTransitions), init, generateSwapchainCallback(), prerecordable, passID);
+        result = make_unique<CompiledPass>(graph, name, viewportSize, generateCallback(), std::move(prePassTransitions), init, generateSwapchainCallback(), prerecordable, recordInParallel, passID);
     }
     result->setInputsOutputsForDebug(inputs, outputs);
     postCompile(*result);
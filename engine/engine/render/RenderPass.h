@@ -65,6 +65,7 @@ namespace Carrot::Render {
                 InitCallback initCallback,
                 SwapchainRecreationCallback swapchainCallback,
                 bool prerecordable,
+                bool recordInParallel,
                 const Carrot::UUID& passID
         );
 
@@ -78,12 +79,19 @@ namespace Carrot::Render {
                 InitCallback initCallback,
                 SwapchainRecreationCallback swapchainCallback,
                 bool prerecordable,
+                bool recordInParallel,
                 const Carrot::UUID& passID
         );
 
     public:
         void execute(const Render::Context& data, vk::CommandBuffer& cmds);
 
+        /// Records the commands of this pass inside its own secondary command buffer, for passes recorded in parallel.
+        /// Can be called from any thread, 'execute' will then stitch the recorded commands inside the main command buffer
+        void recordSecondaryCommands(const Render::Context& renderContext);
+
+        bool isRecordedInParallel() const { return recordInParallel; }
+
         const vk::RenderPass& getRenderPass() const {
             assert(rasterized); // Only rasterized passes have a render pass
             return *renderPass;
@@ -122,6 +130,7 @@ namespace Carrot::Render {
         Graph& graph;
         bool rasterized = true;
         bool prerecordable = false;
+        bool recordInParallel = false;
         std::vector<bool> needsRecord; // do pre-recorded buffers need to be re-recorded?
         std::vector<vk::UniqueFramebuffer> framebuffers;
         vk::UniqueRenderPass renderPass;
@@ -141,7 +150,8 @@ namespace Carrot::Render {
         std::vector<FrameResource> outputs;
         std::vector<FrameResource> inouts; // inputs used as read-write
 
-    private: // Pre-recording
+    private: // Pre-recording & parallel recording
+        // each pass has its own pool: a pass is recorded by a single task at once, so the pool is never used by two threads at the same time
         vk::UniqueCommandPool commandPool;
         std::vector<vk::CommandBuffer> commandBuffers;
     };
@@ -156,6 +166,10 @@ namespace Carrot::Render {
         bool rasterized = true;
         bool prerecordable = false;
 
+        /// Record this pass on a worker thread, at the same time as the other passes of the graph.
+        /// The rendering callback must then only use thread-safe parts of the renderer, and must not depend on work done by the callbacks of other passes
+        bool recordInParallel = false;
+
         explicit PassBase(VulkanDriver& driver, std::string name): driver(driver), name(std::move(name)) {}
 
         virtual ~PassBase() = default;
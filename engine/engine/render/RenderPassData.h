@@ -119,14 +119,15 @@ namespace Carrot::Render {
             FrameResource output;
         };
 
+        /// Contents of targets depend on Carrot::GBuffer::getLayout(), comments describe the packed layout when it differs
         struct GBuffer {
             FrameResource albedo;
-            FrameResource positions;
-            FrameResource viewSpaceNormalTangents;
-            FrameResource flags;
+            FrameResource positions; // packed: not created, reconstructed from depth
+            FrameResource viewSpaceNormalTangents; // packed: octahedral normal and tangent
+            FrameResource flags; // packed: flags + metallicness + roughness
             FrameResource entityID;
-            FrameResource metallicRoughnessVelocityXY;
-            FrameResource emissiveVelocityZ;
+            FrameResource metallicRoughnessVelocityXY; // packed: velocity XYZ
+            FrameResource emissiveVelocityZ; // packed: R11G11B10 emissive
             FrameResource depthStencil;
 
             void readFrom(Render::GraphBuilder& graph, const GBuffer& other, vk::ImageLayout wantedLayout);
@@ -3,6 +3,7 @@
 //
 
 #include "Sprite.h"
+#include <mutex>
 #include <utility>
 #include <engine/render/resources/Vertex.h>
 #include "engine/render/resources/ResourceAllocator.h"
@@ -14,6 +15,7 @@
 namespace Carrot::Render {
 
     std::unique_ptr<Carrot::Mesh> Sprite::spriteMesh = nullptr;
+    static std::mutex spriteMeshAccess;
 
     Sprite::Sprite() {
         renderingPipeline = GetRenderer().getOrCreatePipeline("gBufferSprite");
@@ -60,6 +62,7 @@ namespace Carrot::Render {
     }
 
     Carrot::Mesh& Sprite::getSpriteMesh(Carrot::Engine& engine) {
+        std::lock_guard l { spriteMeshAccess }; // sprites can be rendered from multiple threads
         if(!spriteMesh) {
             spriteMesh = make_unique<Carrot::SingleMesh>(
                                                    std::vector<Carrot::SimpleVertexWithInstanceData>{
@@ -81,6 +84,7 @@ namespace Carrot::Render {
     }
 
     void Sprite::cleanup() {
+        std::lock_guard l { spriteMeshAccess };
         spriteMesh.reset();
     }
 
@@ -99,5 +103,6 @@ namespace Carrot::Render {
         verify(this->texture != nullptr, "Cannot create sprite with no texture");
         material = GetRenderer().getMaterialSystem().createMaterialHandle();
         material->albedo = GetRenderer().getMaterialSystem().createTextureHandle(texture);
+        atlasPlacement = GetRenderer().getSpriteAtlas().getOrPack(texture);
     }
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "engine/render/resources/Texture.h"
 #include "core/math/Rect2D.hpp"
 #include "engine/render/InstanceData.h"
+#include "engine/render/SpriteAtlas.h"
 #include <glm/ext/quaternion_common.hpp>
 #include <glm/detail/type_quat.hpp>
 #include "engine/render/VulkanRenderer.h"
@@ -55,22 +56,29 @@ namespace Carrot::Render {
         const Math::Rect2Df& getTextureRegion() const { return textureRegion; }
         Pipeline& getRenderingPipeline() const { return *renderingPipeline; }
 
+        /// Where the texture of this sprite is inside the sprite atlas of the renderer. Empty if the texture could not be packed,
+        /// in which case this sprite cannot be batched (see SpriteBatcher)
+        const std::optional<SpriteAtlas::Placement>& getAtlasPlacement() const { return atlasPlacement; }
+
     public:
         void setTexture(Texture::Ref texture);
 
     public:
         static void cleanup();
 
+        /// Quad used to draw sprites, centered on the origin. Thread-safe
+        static Carrot::Mesh& getSpriteMesh(Carrot::Engine& engine);
+
         static void registerUsertype(sol::state& destination);
 
     private:
         Carrot::Render::Texture::Ref texture;
         Carrot::Math::Rect2Df textureRegion;
         std::shared_ptr<Carrot::Render::MaterialHandle> material;
+        std::optional<SpriteAtlas::Placement> atlasPlacement;
 
         std::shared_ptr<Carrot::Pipeline> renderingPipeline;
 
         static std::unique_ptr<Carrot::Mesh> spriteMesh;
-        static Carrot::Mesh& getSpriteMesh(Carrot::Engine& engine);
     };
 }
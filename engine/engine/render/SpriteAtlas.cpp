@@ -0,0 +1,143 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "SpriteAtlas.h"
+#include <algorithm>
+#include <cstring>
+#include <stb_image.h>
+#include <core/io/Logging.hpp>
+#include <core/utils/Assert.h>
+#include <engine/render/MaterialSystem.h>
+#include <engine/render/VulkanRenderer.h>
+#include <engine/utils/Profiling.h>
+
+namespace Carrot::Render {
+
+    glm::vec4 SpriteAtlas::Placement::remap(const Math::Rect2Df& region) const {
+        const glm::vec2 min = uvMin + glm::vec2 { region.getMinX(), region.getMinY() } * uvSize;
+        const glm::vec2 max = uvMin + glm::vec2 { region.getMaxX(), region.getMaxY() } * uvSize;
+        return glm::vec4 { min, max };
+    }
+
+    SpriteAtlas::SpriteAtlas(VulkanRenderer& renderer): renderer(renderer) {}
+
+    SpriteAtlas::~SpriteAtlas() = default;
+
+    std::optional<SpriteAtlas::Placement> SpriteAtlas::getOrPack(const Texture::Ref& texture) {
+        verify(texture != nullptr, "Cannot pack a null texture");
+        std::lock_guard l { access };
+        auto it = entries.find(texture.get());
+        if(it != entries.end() && !it->second.texture.expired()) {
+            return it->second.placement;
+        }
+
+        // textures which cannot be packed are remembered too, to avoid reading their file again
+        Entry& entry = entries[texture.get()];
+        entry.texture = texture;
+        entry.placement = pack(*texture);
+        return entry.placement;
+    }
+
+    std::optional<SpriteAtlas::Placement> SpriteAtlas::pack(const Texture& texture) {
+        ZoneScoped;
+        const Carrot::IO::Resource& resource = texture.getOriginatingResource();
+        if(resource.getSize() == 0) {
+            return {}; // not loaded from a file
+        }
+
+        const std::unique_ptr<std::uint8_t[]> fileContents = resource.readAll();
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        if(!stbi_info_from_memory(fileContents.get(), static_cast<int>(resource.getSize()), &width, &height, &channels)) {
+            return {}; // format not supported by stb_image (KTX2, EXR, ...)
+        }
+        if(width <= 0 || height <= 0 || static_cast<std::uint32_t>(width) > MaxPackedSize || static_cast<std::uint32_t>(height) > MaxPackedSize) {
+            return {};
+        }
+
+        // find a spot before decoding the image: decoding is the most expensive part
+        std::optional<glm::uvec2> spot;
+        std::uint32_t pageIndex = 0;
+        for(; pageIndex < pages.size(); pageIndex++) {
+            spot = pages[pageIndex]->packer.allocate(width, height);
+            if(spot.has_value()) {
+                break;
+            }
+        }
+        if(!spot.has_value()) {
+            auto& newPage = pages.emplace_back(std::make_unique<Page>());
+            newPage->pixels.resize(static_cast<std::size_t>(PageSize) * PageSize * 4);
+            spot = newPage->packer.allocate(width, height);
+            pageIndex = static_cast<std::uint32_t>(pages.size() - 1);
+            verify(spot.has_value(), "Texture fits in a page but could not be packed into an empty one?");
+        }
+
+        stbi_uc* pixels = stbi_load_from_memory(fileContents.get(), static_cast<int>(resource.getSize()), &width, &height, &channels, STBI_rgb_alpha);
+        if(!pixels) {
+            Carrot::Log::error("Failed to decode %s for sprite atlas, sprites using it will not be batched", resource.getName().c_str());
+            return {}; // the allocated spot is lost, this is not expected to happen often
+        }
+
+        // copy the texture and extend its borders into the padding, so that bilinear filtering on the edges does not sample other textures
+        Page& page = *pages[pageIndex];
+        const std::int64_t paddedSize = static_cast<std::int64_t>(Padding);
+        for(std::int64_t y = -paddedSize; y < height + paddedSize; y++) {
+            const std::int64_t sourceY = std::clamp<std::int64_t>(y, 0, height - 1);
+            for(std::int64_t x = -paddedSize; x < width + paddedSize; x++) {
+                const std::int64_t sourceX = std::clamp<std::int64_t>(x, 0, width - 1);
+                const std::size_t destinationIndex = ((spot->y + y) * PageSize + (spot->x + x)) * 4;
+                std::memcpy(&page.pixels[destinationIndex], &pixels[(sourceY * width + sourceX) * 4], 4);
+            }
+        }
+        stbi_image_free(pixels);
+        page.dirty = true;
+
+        return Placement {
+            .page = pageIndex,
+            .uvMin = glm::vec2 { *spot } / static_cast<float>(PageSize),
+            .uvSize = glm::vec2 { width, height } / static_cast<float>(PageSize),
+        };
+    }
+
+    void SpriteAtlas::updatePages() {
+        std::lock_guard l { access };
+        for(auto& pPage : pages) {
+            Page& page = *pPage;
+            if(!page.dirty) {
+                continue;
+            }
+            ZoneScopedN("Upload sprite atlas page");
+
+            // a new texture is created instead of updating the existing one: the current one may still be used by frames in flight
+            auto texture = std::make_shared<Carrot::Render::Texture>(renderer.getVulkanDriver(),
+                                                                     vk::Extent3D { PageSize, PageSize, 1 },
+                                                                     vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst,
+                                                                     vk::Format::eR8G8B8A8Unorm);
+            texture->getImage().stageUpload(page.pixels);
+            texture->name("Sprite atlas page");
+
+            if(!page.material) {
+                page.texture = renderer.getMaterialSystem().createTextureHandle(texture);
+                page.material = renderer.getMaterialSystem().createMaterialHandle();
+                page.material->albedo = page.texture;
+            } else {
+                page.texture->texture = texture;
+            }
+            page.dirty = false;
+        }
+    }
+
+    const MaterialHandle& SpriteAtlas::getPageMaterial(std::uint32_t page) const {
+        std::lock_guard l { access };
+        verify(page < pages.size(), "Invalid page index");
+        verify(pages[page]->material, "Page was never uploaded, call updatePages first");
+        return *pages[page]->material;
+    }
+
+    std::size_t SpriteAtlas::getPageCount() const {
+        std::lock_guard l { access };
+        return pages.size();
+    }
+}
@@ -0,0 +1,94 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include <core/math/Rect2D.hpp>
+#include <core/render/AtlasPacker.h>
+#include <engine/render/resources/Texture.h>
+
+namespace Carrot {
+    class VulkanRenderer;
+}
+
+namespace Carrot::Render {
+    class MaterialHandle;
+    class TextureHandle;
+
+    /**
+     * \brief Shared atlas pages for sprite textures, so that sprites using different textures can be drawn with a single draw.
+     * Textures are packed the first time they are used by a sprite (see Sprite::setTexture), and never removed: pages are meant
+     * for the small, long-lived textures of 2D games.
+     *
+     * Pixels are read again from the file the texture was loaded from: textures which do not come from an image file supported
+     * by stb_image (render targets, KTX2, EXR), or which are too big, are not packed and sprites using them are drawn on their own.
+     *
+     * Each page keeps a copy of its pixels on the CPU and is uploaded again entirely when textures are added to it, like the
+     * glyph atlas of fonts. Packing is expected to happen while loading, not every frame.
+     *
+     * getOrPack is thread-safe, updatePages must be called from the thread which renders the sprites.
+     */
+    class SpriteAtlas {
+    public:
+        /// Width and height of each page
+        static constexpr std::uint32_t PageSize = 2048;
+
+        /// Textures bigger than this (on any axis) are never packed, they would waste most of a page
+        static constexpr std::uint32_t MaxPackedSize = 512;
+
+        /// Texels around each packed texture, filled with the borders of the texture to avoid bleeding
+        static constexpr std::uint32_t Padding = 1;
+
+        /// Where a texture is inside the atlas
+        struct Placement {
+            std::uint32_t page = 0;
+            glm::vec2 uvMin{0.0f};
+            glm::vec2 uvSize{1.0f};
+
+            /// Converts a region in UV of the original texture (eg from a TextureAtlas) to UV of the page: xy = min, zw = max
+            glm::vec4 remap(const Math::Rect2Df& region) const;
+        };
+
+        explicit SpriteAtlas(VulkanRenderer& renderer);
+        ~SpriteAtlas();
+
+        /// Returns where 'texture' is inside the atlas, packing it if this is the first time. Returns nothing if the texture cannot be packed
+        std::optional<Placement> getOrPack(const Texture::Ref& texture);
+
+        /// Uploads the pages which changed since the last call
+        void updatePages();
+
+        /// Material to use to draw the sprites of the given page. Only valid after a call to updatePages
+        const MaterialHandle& getPageMaterial(std::uint32_t page) const;
+
+        std::size_t getPageCount() const;
+
+    private:
+        struct Page {
+            AtlasPacker packer { PageSize, PageSize, Padding };
+            std::vector<std::uint8_t> pixels; // RGBA8
+            bool dirty = true;
+            std::shared_ptr<TextureHandle> texture;
+            std::shared_ptr<MaterialHandle> material;
+        };
+
+        struct Entry {
+            std::weak_ptr<Texture> texture; // textures can be destroyed, and their address reused by a new texture
+            std::optional<Placement> placement;
+        };
+
+        std::optional<Placement> pack(const Texture& texture);
+
+        VulkanRenderer& renderer;
+        mutable std::mutex access;
+        std::vector<std::unique_ptr<Page>> pages;
+        std::unordered_map<const Texture*, Entry> entries;
+    };
+}
@@ -0,0 +1,117 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "SpriteBatcher.h"
+#include <algorithm>
+#include <engine/Engine.h>
+#include <engine/render/GBufferDrawData.h>
+#include <engine/render/Sprite.h>
+#include <engine/render/SpriteAtlas.h>
+#include <engine/render/VulkanRenderer.h>
+#include <engine/utils/Profiling.h>
+
+namespace Carrot::Render {
+
+    void SpriteBatcher::begin(std::size_t maxSpriteCount) {
+        if(instances.size() < maxSpriteCount) {
+            instances.resize(maxSpriteCount);
+            instancePages.resize(maxSpriteCount);
+        }
+        spriteCount.store(0, std::memory_order_relaxed);
+    }
+
+    bool SpriteBatcher::add(const Sprite& sprite, const Carrot::UUID& uuid) {
+        const std::optional<SpriteAtlas::Placement>& placement = sprite.getAtlasPlacement();
+        if(!placement.has_value()) {
+            return false;
+        }
+
+        // regions going outside of the texture expect the texture to repeat, which does not work once inside an atlas page
+        const Math::Rect2Df& region = sprite.getTextureRegion();
+        constexpr float Epsilon = 1e-4f;
+        if(region.getMinX() < -Epsilon || region.getMinY() < -Epsilon || region.getMaxX() > 1.0f + Epsilon || region.getMaxY() > 1.0f + Epsilon) {
+            return false;
+        }
+
+        const std::size_t index = spriteCount.fetch_add(1, std::memory_order_relaxed);
+        verify(index < instances.size(), "Too many sprites added to batcher, make sure begin is called with the correct count");
+
+        SpriteInstanceData& instance = instances[index];
+        instance.transform = AffineTransform::fromMatrix(sprite.computeTransformMatrix());
+        instance.uvRect = placement->remap(region);
+        instance.uuid = uuid;
+        instance.color = glm::u8vec4 { glm::clamp(sprite.color, 0.0f, 1.0f) * 255.0f + 0.5f };
+        instancePages[index] = placement->page;
+        return true;
+    }
+
+    void SpriteBatcher::submit(const Render::Context& renderContext, Render::PassName pass) {
+        ZoneScoped;
+        const std::size_t count = getSpriteCount();
+        if(count == 0) {
+            return;
+        }
+
+        SpriteAtlas& atlas = renderContext.renderer.getSpriteAtlas();
+        atlas.updatePages();
+
+        // draws are done page by page: instances are grouped by page, with a counting sort if necessary
+        const std::size_t pageCount = atlas.getPageCount();
+        pageOffsets.assign(pageCount + 1, 0);
+        for(std::size_t i = 0; i < count; i++) {
+            pageOffsets[instancePages[i] + 1]++;
+        }
+
+        std::span<const SpriteInstanceData> sorted { instances.data(), count };
+        const bool singlePage = std::any_of(pageOffsets.begin(), pageOffsets.end(), [&](std::size_t instancesInPage) { return instancesInPage == count; });
+        for(std::size_t page = 0; page < pageCount; page++) {
+            pageOffsets[page + 1] += pageOffsets[page];
+        }
+        if(!singlePage) {
+            ZoneScopedN("Sort by page");
+            sortedInstances.resize(count);
+            std::vector<std::size_t> cursors { pageOffsets.begin(), pageOffsets.end() - 1 };
+            for(std::size_t i = 0; i < count; i++) {
+                sortedInstances[cursors[instancePages[i]]++] = instances[i];
+            }
+            sorted = sortedInstances;
+        }
+
+        Carrot::Mesh& quad = Sprite::getSpriteMesh(GetEngine());
+        auto& renderPacket = renderContext.renderer.makeRenderPacket(pass, Render::PacketType::DrawIndexedInstanced, renderContext);
+        renderPacket.pipeline = renderContext.renderer.getOrCreatePipeline("sprite-batched");
+        renderPacket.useMesh(quad);
+        renderPacket.useInstances(sorted);
+        renderPacket.instanceCount = static_cast<std::uint32_t>(count);
+        renderPacket.commands.clear();
+
+        for(std::uint32_t page = 0; page < pageCount; page++) {
+            const std::size_t first = pageOffsets[page];
+            const std::size_t pageInstanceCount = pageOffsets[page + 1] - first;
+            if(pageInstanceCount == 0) {
+                continue;
+            }
+
+            auto& cmd = renderPacket.commands.emplaceBack().drawIndexedInstanced;
+            cmd.indexCount = quad.getIndexCount();
+            cmd.instanceCount = static_cast<std::uint32_t>(pageInstanceCount);
+            cmd.firstInstance = static_cast<std::uint32_t>(first);
+
+            // one per draw, indexed by gl_DrawID
+            Carrot::GBufferDrawData data;
+            data.materialIndex = atlas.getPageMaterial(page).getSlot();
+            renderPacket.addPerDrawData({&data, 1});
+        }
+
+        renderContext.renderer.render(renderPacket);
+    }
+
+    std::size_t SpriteBatcher::getSpriteCount() const {
+        return std::min(spriteCount.load(std::memory_order_relaxed), instances.size());
+    }
+
+    std::span<const SpriteInstanceData> SpriteBatcher::getInstances() const {
+        return { instances.data(), getSpriteCount() };
+    }
+}
@@ -0,0 +1,54 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <span>
+#include <vector>
+#include <core/utils/UUID.h>
+#include <engine/render/InstanceData.h>
+#include <engine/render/PassEnum.h>
+
+namespace Carrot::Render {
+    class Sprite;
+    struct Context;
+
+    /**
+     * \brief Draws all sprites added during a frame with a single render packet, using the shared pages of SpriteAtlas.
+     * Sprites write their instance data into a single buffer, which can be filled by multiple threads at once
+     * (see SpriteRenderSystem::onFrame). The packet contains one draw per atlas page in use, recorded as a single indirect draw.
+     *
+     * Usage, each frame: begin, add (thread-safe), submit.
+     * Order of sprites inside a page is not guaranteed to be the same between frames.
+     */
+    class SpriteBatcher {
+    public:
+        /// Prepares storage for up to 'maxSpriteCount' sprites. Storage is reused between frames
+        void begin(std::size_t maxSpriteCount);
+
+        /// Adds a sprite to the current frame. Can be called concurrently from multiple threads between begin and submit.
+        /// Returns false if the sprite cannot be batched (texture not packed inside the atlas, or texture region outside of the texture),
+        /// it must then be rendered on its own, via Sprite::onFrame
+        bool add(const Sprite& sprite, const Carrot::UUID& uuid = Carrot::UUID::null());
+
+        /// Creates the render packet for all sprites added since the last call to begin
+        void submit(const Render::Context& renderContext, Render::PassName pass = Render::PassEnum::OpaqueGBuffer);
+
+        /// Number of sprites added since the last call to begin
+        std::size_t getSpriteCount() const;
+
+        /// Instance data of the sprites added since the last call to begin, in the order they were added
+        std::span<const SpriteInstanceData> getInstances() const;
+
+    private:
+        std::vector<SpriteInstanceData> instances;
+        std::vector<std::uint32_t> instancePages; // atlas page of each instance
+        std::atomic<std::size_t> spriteCount { 0 };
+
+        // reused between frames, only used if sprites use more than one atlas page
+        std::vector<SpriteInstanceData> sortedInstances;
+        std::vector<std::size_t> pageOffsets;
+    };
+}
@@ -0,0 +1,79 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "TextBatcher.h"
+#include <engine/Engine.h>
+#include <engine/render/GBufferDrawData.h>
+#include <engine/render/VulkanRenderer.h>
+#include <engine/render/resources/Font.h>
+#include <engine/utils/Profiling.h>
+
+namespace Carrot::Render {
+
+    void TextBatcher::add(Font& font, std::span<const GlyphQuad> glyphs, const glm::mat4& transform, const glm::vec4& color, const Carrot::UUID& uuid) {
+        if(glyphs.empty()) {
+            return;
+        }
+
+        // very few different fonts are expected to be used at once, a linear search is enough
+        Batch* batch = nullptr;
+        for(Batch& b : batches) {
+            if(b.font == &font) {
+                batch = &b;
+                break;
+            }
+        }
+        if(batch == nullptr) {
+            batch = &batches.emplace_back();
+            batch->font = &font;
+        }
+
+        const std::size_t start = batch->instances.size();
+        batch->instances.resize(start + glyphs.size());
+        for(std::size_t i = 0; i < glyphs.size(); i++) {
+            GlyphInstanceData& instance = batch->instances[start + i];
+            instance.color = color;
+            instance.uuid = uuid;
+            instance.transform = transform;
+            instance.glyphRect = glyphs[i].rect;
+            instance.texelRect = glyphs[i].texelRect;
+        }
+    }
+
+    void TextBatcher::submit(const Render::Context& renderContext, Render::PassName pass) {
+        ZoneScoped;
+        for(Batch& batch : batches) {
+            if(batch.instances.empty()) {
+                continue;
+            }
+
+            Font& font = *batch.font;
+            font.updateAtlasTexture();
+
+            auto& renderPacket = renderContext.renderer.makeRenderPacket(pass, Render::PacketType::DrawIndexedInstanced, renderContext);
+            renderPacket.pipeline = renderContext.renderer.getOrCreatePipeline(font.getBatchedPipelineName());
+            renderPacket.useMesh(font.getGlyphQuad());
+            renderPacket.useInstances(std::span<const GlyphInstanceData>{ batch.instances });
+            renderPacket.instanceCount = static_cast<std::uint32_t>(batch.instances.size());
+            renderPacket.commands[0].drawIndexedInstanced.instanceCount = renderPacket.instanceCount;
+
+            Carrot::GBufferDrawData data;
+            data.materialIndex = font.getAtlasMaterial().getSlot();
+            renderPacket.addPerDrawData({&data, 1});
+
+            renderContext.renderer.render(renderPacket);
+
+            // keep capacity for next frame
+            batch.instances.clear();
+        }
+    }
+
+    std::size_t TextBatcher::getGlyphCount() const {
+        std::size_t count = 0;
+        for(const Batch& batch : batches) {
+            count += batch.instances.size();
+        }
+        return count;
+    }
+}
@@ -0,0 +1,45 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+#include <core/utils/UUID.h>
+#include <engine/render/InstanceData.h>
+#include <engine/render/PassEnum.h>
+#include <engine/render/resources/GlyphAtlas.h>
+
+namespace Carrot::Render {
+    class Font;
+    struct Context;
+
+    /**
+     * \brief Accumulates the glyphs of many texts during a frame, and renders them with a single instanced draw per font.
+     * Texts are expected to be laid out via Font::layout, which only needs to be done again when the text changes:
+     * changing a text only changes the content of the per-frame instance buffer, no GPU resource is created.
+     *
+     * Storage is reused between frames. Not thread-safe.
+     */
+    class TextBatcher {
+    public:
+        /// Adds the glyphs of a text to the batch of its font, for the current frame
+        void add(Font& font, std::span<const GlyphQuad> glyphs, const glm::mat4& transform, const glm::vec4& color = glm::vec4{1.0f}, const Carrot::UUID& uuid = Carrot::UUID::null());
+
+        /// Creates the render packets for all texts added since the last call, and starts a new batch
+        void submit(const Render::Context& renderContext, Render::PassName pass = Render::PassEnum::OpaqueGBuffer);
+
+        /// Number of glyphs added since the last call to submit
+        std::size_t getGlyphCount() const;
+
+    private:
+        struct Batch {
+            Font* font = nullptr;
+            std::vector<GlyphInstanceData> instances;
+        };
+
+        std::vector<Batch> batches;
+    };
+}
@@ -6,6 +6,8 @@
 #include "core/utils/Assert.h"
 #include "engine/utils/Macros.h"
 #include "engine/task/TaskScheduler.h"
+#include "engine/utils/Profiling.h"
+#include "core/utils/stringmanip.h"
 
 #include "engine/vr/Session.h"
 
@@ -44,7 +46,6 @@ namespace Carrot::Render {
     }
 
     Texture& TextureRepository::create(const FrameResource& resource, size_t frameIndex, vk::ImageUsageFlags textureUsages, const vk::Extent2D& viewportSize) {
-        // TODO: aliasing
         if(textures.empty()) {
             textures.resize(driver.getSwapchainImageCount());
         }
@@ -56,20 +57,7 @@ namespace Carrot::Render {
 
         auto it = textures[frameIndex].find(resource.rootID);
         if(it == textures[frameIndex].end()) {
-            vk::Extent3D size;
-            switch(resource.size.type) {
-                case TextureSize::Type::SwapchainProportional: {
-                    size.width = static_cast<std::uint32_t>(resource.size.width * viewportSize.width);
-                    size.height = static_cast<std::uint32_t>(resource.size.height * viewportSize.height);
-                    size.depth = static_cast<std::uint32_t>(resource.size.depth * 1);
-                } break;
-
-                case TextureSize::Type::Fixed: {
-                    size.width = static_cast<std::uint32_t>(resource.size.width);
-                    size.height = static_cast<std::uint32_t>(resource.size.height);
-                    size.depth = static_cast<std::uint32_t>(resource.size.depth);
-                } break;
-            }
+            vk::Extent3D size = computeTextureSize(resource, viewportSize);
             auto format = resource.format;
 
             verify(resource.imageOrigin == Render::ImageOrigin::Created, "Must be an explicitely created texture");
@@ -87,6 +75,108 @@ namespace Carrot::Render {
         return get(resource, frameIndex);
     }
 
+    vk::Extent3D TextureRepository::computeTextureSize(const FrameResource& resource, const vk::Extent2D& viewportSize) const {
+        vk::Extent3D size;
+        switch(resource.size.type) {
+            case TextureSize::Type::SwapchainProportional: {
+                size.width = static_cast<std::uint32_t>(resource.size.width * viewportSize.width);
+                size.height = static_cast<std::uint32_t>(resource.size.height * viewportSize.height);
+                size.depth = static_cast<std::uint32_t>(resource.size.depth * 1);
+            } break;
+
+            case TextureSize::Type::Fixed: {
+                size.width = static_cast<std::uint32_t>(resource.size.width);
+                size.height = static_cast<std::uint32_t>(resource.size.height);
+                size.depth = static_cast<std::uint32_t>(resource.size.depth);
+            } break;
+        }
+        return size;
+    }
+
+    TransientHeapLayout TextureRepository::createAliasedTextures(const Carrot::UUID& groupID, std::span<const TransientTexture> transientTextures, const vk::Extent2D& viewportSize) {
+        ZoneScoped;
+        if(textures.empty()) {
+            textures.resize(driver.getSwapchainImageCount());
+        }
+        removeAliasedTextures(groupID);
+
+        std::vector<vk::Extent3D> sizes;
+        std::vector<TransientResource> packingInput;
+        sizes.reserve(transientTextures.size());
+        packingInput.reserve(transientTextures.size());
+        for(const auto& transientTexture : transientTextures) {
+            const FrameResource& resource = transientTexture.resource;
+            verify(resource.imageOrigin == Render::ImageOrigin::Created, "Must be an explicitely created texture");
+            verify(textures[0].find(resource.rootID) == textures[0].end(), "Texture already exists");
+
+            const vk::Extent3D& size = sizes.emplace_back(computeTextureSize(resource, viewportSize));
+            vk::MemoryRequirements requirements = Image::getMemoryRequirements(driver, size, getUsages(resource.rootID), resource.format);
+            packingInput.emplace_back(TransientResource {
+                .size = requirements.size,
+                .alignment = requirements.alignment,
+                .memoryType = driver.findMemoryType(requirements.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal),
+                .firstPass = transientTexture.firstPass,
+                .lastPass = transientTexture.lastPass,
+            });
+        }
+
+        TransientHeapLayout layout = packTransientResources(packingInput);
+        AliasingGroup& group = aliasingGroups[groupID];
+        for(std::size_t frameIndex = 0; frameIndex < textures.size(); frameIndex++) {
+            std::vector<std::shared_ptr<Carrot::DeviceMemory>> frameHeaps;
+            frameHeaps.reserve(layout.heaps.size());
+            for(const auto& heap : layout.heaps) {
+                auto& memory = frameHeaps.emplace_back(std::make_shared<Carrot::DeviceMemory>(vk::MemoryAllocateInfo {
+                    .allocationSize = heap.size,
+                    .memoryTypeIndex = heap.memoryType,
+                }));
+                memory->name(Carrot::sprintf("RenderGraph transient heap %llu (swapchain image %llu)", frameHeaps.size() - 1, frameIndex));
+            }
+
+            for(std::size_t i = 0; i < transientTextures.size(); i++) {
+                const FrameResource& resource = transientTextures[i].resource;
+                const TransientPlacement& placement = layout.placements[i];
+                Texture::Ref texture = std::make_shared<Texture>(std::make_unique<Carrot::Image>(driver,
+                                                                                                 sizes[i],
+                                                                                                 getUsages(resource.rootID),
+                                                                                                 resource.format,
+                                                                                                 frameHeaps[placement.heapIndex],
+                                                                                                 placement.offset));
+                texture->assumeLayout(vk::ImageLayout::eUndefined);
+                texture->name(resource.name + " (RenderGraph, aliased)");
+                textures[frameIndex][resource.rootID] = std::move(texture);
+            }
+
+            group.heaps.insert(group.heaps.end(), frameHeaps.begin(), frameHeaps.end());
+        }
+
+        for(const auto& transientTexture : transientTextures) {
+            group.textureIDs.push_back(transientTexture.resource.rootID);
+            aliasedTextures.insert(transientTexture.resource.rootID);
+        }
+        return layout;
+    }
+
+    void TextureRepository::removeAliasedTextures(const Carrot::UUID& groupID) {
+        auto it = aliasingGroups.find(groupID);
+        if(it == aliasingGroups.end()) {
+            return;
+        }
+
+        for(const auto& textureID : it->second.textureIDs) {
+            for(auto& repo : textures) {
+                repo.erase(textureID);
+            }
+            aliasedTextures.erase(textureID);
+        }
+        for(auto& heap : it->second.heaps) {
+            if(heap.use_count() == 1) { // no texture still references this heap
+                driver.deferDestroy("-transient-heap", std::move(*heap));
+            }
+        }
+        aliasingGroups.erase(it);
+    }
+
     vk::ImageUsageFlags& TextureRepository::getUsages(const UUID& id) {
         return usages[id];
     }
@@ -107,7 +197,7 @@ namespace Carrot::Render {
     void TextureRepository::removeBelongingTo(const Carrot::UUID& id) {
         std::vector<Carrot::UUID> affectedTextures;
         for(const auto& [textureID, ownerID] : textureOwners) {
-            if(ownerID == id) {
+            if(ownerID == id && !aliasedTextures.contains(textureID)) {
                 affectedTextures.push_back(textureID);
             }
         }
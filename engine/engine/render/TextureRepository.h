@@ -3,10 +3,13 @@
 //
 
 #pragma once
+#include <span>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include "engine/render/resources/Texture.h"
 #include "engine/render/RenderPassData.h"
+#include "core/render/TransientAliasing.h"
 #include "core/utils/UUID.h"
 
 namespace Carrot::VR {
@@ -14,6 +17,13 @@ namespace Carrot::VR {
 }
 
 namespace Carrot::Render {
+    /// Render graph texture which is only used between two passes of its graph, and can share its memory with other transient textures
+    struct TransientTexture {
+        FrameResource resource;
+        std::uint32_t firstPass = 0; //< index of the first pass using this texture
+        std::uint32_t lastPass = 0; //< index of the last pass using this texture
+    };
+
     class TextureRepository {
     public:
         TextureRepository(VulkanDriver& driver): driver(driver) {}
@@ -31,9 +41,21 @@ namespace Carrot::Render {
         Carrot::UUID getCreatorID(const Carrot::UUID& id) const;
 
     public:
-        /// Removes all textures which belong to this render pass ID.
+        /// Removes all textures which belong to this render pass ID. Aliased textures are left untouched, see createAliasedTextures
         void removeBelongingTo(const Carrot::UUID& id);
 
+    public: // memory aliasing
+        /**
+         * Creates the textures of the given transient resources, for each swapchain image. Textures whose lifetimes do not overlap share the same memory.
+         * Memory is never shared between swapchain images: multiple frames can be in flight at once.
+         * Calling this method again with the same groupID replaces the textures and memory of the previous call (used when the swapchain is resized).
+         * @return how textures are packed in memory, for a single swapchain image
+         */
+        TransientHeapLayout createAliasedTextures(const Carrot::UUID& groupID, std::span<const TransientTexture> transientTextures, const vk::Extent2D& viewportSize);
+
+        /// Removes the textures created by createAliasedTextures with the given group ID, and frees their memory once the GPU no longer uses it.
+        void removeAliasedTextures(const Carrot::UUID& groupID);
+
     public:
         void setXRSession(VR::Session* session);
 
@@ -41,11 +63,21 @@ namespace Carrot::Render {
         /// Sets which render pass is the creator of the texture with the given ID
         void setCreatorID(const Carrot::UUID& resourceID, const Carrot::UUID& creatorID);
 
+        vk::Extent3D computeTextureSize(const FrameResource& resource, const vk::Extent2D& viewportSize) const;
+
+    private:
+        struct AliasingGroup {
+            std::vector<Carrot::UUID> textureIDs;
+            std::vector<std::shared_ptr<Carrot::DeviceMemory>> heaps; // for all swapchain images
+        };
+
     private:
         VulkanDriver& driver;
         std::vector<std::unordered_map<Carrot::UUID, Carrot::Render::Texture::Ref>> textures;
         std::unordered_map<Carrot::UUID, Carrot::UUID> textureOwners;
         std::unordered_map<Carrot::UUID, vk::ImageUsageFlags> usages;
+        std::unordered_map<Carrot::UUID, AliasingGroup> aliasingGroups;
+        std::unordered_set<Carrot::UUID> aliasedTextures;
 
         VR::Session* vrSession = nullptr;
 
@@ -0,0 +1,246 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "TextureStreamer.h"
+
+#include <core/io/IO.h>
+#include <core/io/Logging.hpp>
+#include <core/utils/stringmanip.h>
+#include <engine/console/RuntimeOption.hpp>
+#include <engine/Engine.h>
+#include <engine/render/MaterialSystem.h>
+#include <engine/render/Viewport.h>
+#include <engine/task/TaskScheduler.h>
+#include <engine/utils/Profiling.h>
+#include <imgui.h>
+
+namespace Carrot::Render {
+    static Carrot::RuntimeOption ShowDebug("Engine/Texture Streaming", false);
+
+    TextureStreamer::TextureStreamer(std::uint64_t budget): budget(budget) {}
+
+    TextureStreamer::~TextureStreamer() {
+        // tasks reference this object
+        runningTasks.sleepWait();
+    }
+
+    Texture::Ref TextureStreamer::loadTexture(const Carrot::IO::Resource& resource) {
+        ZoneScoped;
+        Image::KTX2MipChain mipChain;
+        std::unique_ptr<Carrot::Image> image = Image::fromKTX2(GetVulkanDriver(), resource, 0, MipTailSize, &mipChain);
+        const std::uint32_t tailMip = mipChain.mipCount - image->getMipLevels();
+        auto texture = std::make_shared<Texture>(std::move(image), resource);
+        if(tailMip == 0) {
+            // texture is small enough to always be fully resident
+            return texture;
+        }
+
+        const TextureResidency::TextureID id = residency.registerTexture(mipChain.mipSizes, tailMip);
+        Async::LockGuard l { texturesAccess };
+        textures[id] = StreamedTexture {
+            .texture = texture,
+            .resource = resource,
+            .baseExtent = mipChain.baseExtent,
+            .mipCount = mipChain.mipCount,
+        };
+        textureIDs[texture.get()] = id;
+        return texture;
+    }
+
+    void TextureStreamer::requestScreenSize(const Texture& texture, float screenSizeInPixels) {
+        TextureResidency::TextureID id;
+        vk::Extent3D baseExtent;
+        std::uint32_t mipCount;
+        {
+            Async::LockGuard l { texturesAccess };
+            auto it = textureIDs.find(&texture);
+            if(it == textureIDs.end()) {
+                return;
+            }
+            id = it->second;
+            const StreamedTexture& streamedTexture = textures.at(id);
+            baseExtent = streamedTexture.baseExtent;
+            mipCount = streamedTexture.mipCount;
+        }
+        residency.requestMip(id, computeRequiredMip(baseExtent.width, baseExtent.height, screenSizeInPixels, mipCount));
+    }
+
+    void TextureStreamer::requestMaterial(const Render::Context& renderContext, const MaterialHandle& material, const Math::Sphere& worldBounds) {
+        if(renderContext.pViewport == nullptr) {
+            return;
+        }
+
+        // diameter of the bounds on screen
+        const Carrot::Camera& camera = renderContext.getCamera();
+        const glm::vec3 viewSpaceCenter = camera.getCurrentFrameViewMatrix() * glm::vec4 { worldBounds.center, 1.0f };
+        const float distance = std::max(glm::length(viewSpaceCenter) - worldBounds.radius, 0.001f);
+        const float screenSize = worldBounds.radius * camera.getCurrentFrameProjectionMatrix()[1][1] / distance * static_cast<float>(renderContext.pViewport->getHeight());
+
+        for(const auto& pTextureHandle : { material.albedo, material.normalMap, material.metallicRoughness, material.emissive }) {
+            if(pTextureHandle && pTextureHandle->texture) {
+                requestScreenSize(*pTextureHandle->texture, screenSize);
+            }
+        }
+    }
+
+    void TextureStreamer::beginFrame(const Render::Context& renderContext) {
+        ZoneScoped;
+        residency.nextFrame();
+
+        // forget textures that are no longer used
+        {
+            Async::LockGuard l { texturesAccess };
+            for(auto it = textures.begin(); it != textures.end();) {
+                if(it->second.texture.expired()) {
+                    residency.unregisterTexture(it->first);
+                    std::erase_if(textureIDs, [&](const auto& pair) { return pair.second == it->first; });
+                    it = textures.erase(it);
+                } else {
+                    it++;
+                }
+            }
+        }
+
+        if(streamsInFlight < MaxConcurrentStreams) {
+            for(const auto& request : residency.plan(budget, MaxConcurrentStreams - streamsInFlight)) {
+                startStreaming(request);
+            }
+        }
+
+        TracyPlot("Streamed textures memory", static_cast<std::int64_t>(residency.getResidentBytes()));
+        TracyPlotConfig("Streamed textures memory", tracy::PlotFormatType::Memory, false, true, 0);
+
+        if(ShowDebug) {
+            drawDebug();
+        }
+    }
+
+    void TextureStreamer::startStreaming(const TextureResidency::StreamingRequest& request) {
+        Carrot::IO::Resource resource;
+        {
+            Async::LockGuard l { texturesAccess };
+            resource = textures.at(request.texture).resource;
+        }
+
+        streamsInFlight++;
+        GetTaskScheduler().schedule(TaskDescription {
+            .name = Carrot::sprintf("Stream %s from mip %u", resource.getName().c_str(), request.targetMip),
+            .task = [this, request, resource](TaskHandle&) {
+                FinishedStream result { .request = request };
+                try {
+                    result.image = Image::fromKTX2(GetVulkanDriver(), resource, request.targetMip);
+                } catch(std::exception& e) {
+                    Carrot::Log::error("Could not stream texture %s: %s", resource.getName().c_str(), e.what());
+                }
+
+                Async::LockGuard l { finishedAccess };
+                finishedStreams.emplace_back(std::move(result));
+            },
+            .joiner = &runningTasks,
+        }, TaskScheduler::AssetLoading);
+    }
+
+    void TextureStreamer::applyFinishedStreams() {
+        ZoneScoped;
+        std::vector<FinishedStream> streams;
+        {
+            Async::LockGuard l { finishedAccess };
+            streams = std::move(finishedStreams);
+            finishedStreams.clear();
+        }
+
+        for(auto& stream : streams) {
+            streamsInFlight--;
+
+            Texture::Ref texture;
+            {
+                Async::LockGuard l { texturesAccess };
+                auto it = textures.find(stream.request.texture);
+                if(it != textures.end()) {
+                    texture = it->second.texture.lock();
+                }
+            }
+
+            if(!texture || !stream.image) {
+                residency.onStreamingCancelled(stream.request);
+                continue;
+            }
+
+            texture->replaceImage(std::move(stream.image));
+            residency.onStreamingDone(stream.request);
+        }
+    }
+
+    std::uint64_t TextureStreamer::getResidentBytes() const {
+        return residency.getResidentBytes();
+    }
+
+    void TextureStreamer::drawDebug() {
+        bool isOpen = true;
+        if(ImGui::Begin("Texture streaming", &isOpen)) {
+            const std::uint64_t residentBytes = residency.getResidentBytes();
+            const std::uint64_t fullyResidentBytes = residency.getFullyResidentBytes();
+
+            int budgetMB = static_cast<int>(budget / (1024 * 1024));
+            if(ImGui::DragInt("Budget (MB)", &budgetMB, 1.0f, 1, 64 * 1024)) {
+                budget = static_cast<std::uint64_t>(std::max(budgetMB, 1)) * 1024 * 1024;
+            }
+
+            const std::string residentText = Carrot::sprintf("%s / %s", Carrot::IO::getHumanReadableFileSize(residentBytes).c_str(), Carrot::IO::getHumanReadableFileSize(budget).c_str());
+            ImGui::ProgressBar(budget > 0 ? static_cast<float>(residentBytes) / static_cast<float>(budget) : 1.0f, ImVec2(-FLT_MIN, 0), residentText.c_str());
+            ImGui::Text("Memory if all mips were resident: %s", Carrot::IO::getHumanReadableFileSize(fullyResidentBytes).c_str());
+            ImGui::Text("Textures loading: %llu", static_cast<std::uint64_t>(streamsInFlight));
+
+            if(ImGui::BeginTable("Streamed textures", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY)) {
+                ImGui::TableSetupColumn("Texture");
+                ImGui::TableSetupColumn("Resident");
+                ImGui::TableSetupColumn("Wanted");
+                ImGui::TableSetupColumn("Mip tail");
+                ImGui::TableSetupColumn("Memory");
+                ImGui::TableSetupColumn("State");
+                ImGui::TableHeadersRow();
+
+                auto mipText = [](const StreamedTexture& texture, std::uint32_t mip) {
+                    return Carrot::sprintf("%u (%ux%u)", mip, std::max(1u, texture.baseExtent.width >> mip), std::max(1u, texture.baseExtent.height >> mip));
+                };
+
+                Async::LockGuard l { texturesAccess };
+                for(const TextureResidency::TextureID id : residency.getTextures()) {
+                    auto it = textures.find(id);
+                    if(it == textures.end()) {
+                        continue;
+                    }
+                    const StreamedTexture& texture = it->second;
+                    const TextureResidency::TextureInfo info = residency.getTextureInfo(id);
+
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(texture.resource.getName().c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(mipText(texture, info.residentMip).c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(mipText(texture, info.wantedMip).c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(mipText(texture, info.tailMip).c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(Carrot::IO::getHumanReadableFileSize(info.residentBytes).c_str());
+                    ImGui::TableNextColumn();
+                    if(info.streaming) {
+                        ImGui::TextUnformatted("Streaming");
+                    } else if(info.residentMip > info.wantedMip) {
+                        ImGui::TextUnformatted("Missing mips");
+                    } else {
+                        ImGui::TextUnformatted("Resident");
+                    }
+                }
+                ImGui::EndTable();
+            }
+        }
+        ImGui::End();
+
+        if(!isOpen) {
+            ShowDebug.setValue(false);
+        }
+    }
+}
@@ -0,0 +1,87 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <core/async/Counter.h>
+#include <core/async/Locks.h>
+#include <core/io/Resource.h>
+#include <core/math/Sphere.h>
+#include <core/render/TextureResidency.h>
+#include <engine/render/resources/Texture.h>
+#include <engine/render/RenderContext.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Carrot::Render {
+    class MaterialHandle;
+
+    /// Streams mips of KTX2 textures in and out, based on how large they are on screen, while keeping their memory under a budget.
+    /// Streamed textures start with only their mip tail resident, finer mips are loaded asynchronously once the texture is drawn
+    /// large enough to need them. Changing the resident mips recreates the image of the texture, which is swapped while the render
+    /// thread is idle: users of the texture only see a different image view.
+    class TextureStreamer {
+    public:
+        /// Mips at most this large (in texels) are always resident
+        constexpr static std::uint32_t MipTailSize = 64;
+
+        /// Maximum count of textures loading at once
+        constexpr static std::size_t MaxConcurrentStreams = 4;
+
+        explicit TextureStreamer(std::uint64_t budget);
+        ~TextureStreamer();
+
+        /// Loads the mip tail of a KTX2 texture. Other mips will be streamed in when needed
+        Texture::Ref loadTexture(const Carrot::IO::Resource& resource);
+
+        /// 'texture' is drawn this frame, and covers 'screenSizeInPixels' pixels along its largest axis.
+        /// Does nothing if the texture is not streamed. Thread-safe
+        void requestScreenSize(const Texture& texture, float screenSizeInPixels);
+
+        /// The textures of 'material' are drawn this frame, on an object bounded by 'worldBounds'. Assumes that the UVs of the object
+        /// cover each texture once. Thread-safe
+        void requestMaterial(const Render::Context& renderContext, const MaterialHandle& material, const Math::Sphere& worldBounds);
+
+        /// Takes into account requests of the previous frame and starts new streaming tasks. Call on the main thread
+        void beginFrame(const Render::Context& renderContext);
+
+        /// Replaces the images of textures whose streaming finished. Must be called while no other thread is using textures
+        void applyFinishedStreams();
+
+    public:
+        std::uint64_t getBudget() const { return budget; }
+        void setBudget(std::uint64_t newBudget) { budget = newBudget; }
+
+        std::uint64_t getResidentBytes() const;
+
+    private:
+        struct StreamedTexture {
+            std::weak_ptr<Texture> texture;
+            Carrot::IO::Resource resource;
+            vk::Extent3D baseExtent{};
+            std::uint32_t mipCount = 0;
+        };
+
+        struct FinishedStream {
+            TextureResidency::StreamingRequest request;
+            std::unique_ptr<Carrot::Image> image; // null if the texture could not be loaded
+        };
+
+        void startStreaming(const TextureResidency::StreamingRequest& request);
+        void drawDebug();
+
+        TextureResidency residency;
+        std::uint64_t budget = 0;
+
+        mutable Async::SpinLock texturesAccess;
+        std::unordered_map<TextureResidency::TextureID, StreamedTexture> textures;
+        std::unordered_map<const Texture*, TextureResidency::TextureID> textureIDs;
+
+        Async::SpinLock finishedAccess;
+        std::vector<FinishedStream> finishedStreams;
+        std::size_t streamsInFlight = 0; // only modified on the main thread
+        Async::Counter runningTasks;
+    };
+}
@@ -6,6 +6,9 @@
 #include "GBuffer.h"
 #include "engine/render/VisibilityBuffer.h"
 #include "engine/render/ClusterManager.h"
+#include "engine/render/InstanceTransformHistory.h"
+#include "engine/render/SpriteAtlas.h"
+#include "engine/render/TextureStreamer.h"
 #include "engine/render/raytracing/ASBuilder.h"
 #include "engine/render/raytracing/RayTracer.h"
 #include "engine/console/RuntimeOption.hpp"
@@ -98,6 +101,8 @@ Carrot::VulkanRenderer::VulkanRenderer(VulkanDriver& driver, Configuration confi
     createUIResources();
     createGBuffer();
     createDefaultResources();
+    textureStreamer = std::make_unique<Render::TextureStreamer>(config.textureStreamingBudget);
+    spriteAtlas = std::make_unique<Render::SpriteAtlas>(*this);
 
     initImGui();
 
@@ -190,6 +195,7 @@ void Carrot::VulkanRenderer::createGBuffer() {
     gBuffer = std::make_unique<GBuffer>(*this, *raytracer);
     visibilityBuffer = std::make_unique<Render::VisibilityBuffer>(*this);
     clusterManager = std::make_unique<Render::ClusterManager>(*this);
+    instanceTransformHistory = std::make_unique<Render::InstanceTransformHistory>(getSwapchainImageCount());
 }
 
 void Carrot::VulkanRenderer::createRayTracer() {
@@ -262,6 +268,7 @@ void Carrot::VulkanRenderer::onSwapchainImageCountChange(std::size_t newCount) {
     materialSystem.onSwapchainImageCountChange(newCount);
 
     lighting.onSwapchainImageCountChange(newCount);
+    instanceTransformHistory->onSwapchainImageCountChange(newCount);
     forwardRenderingFrameInfo.clear();
     forwardRenderingFrameInfo.resize(getSwapchainImageCount());
     for (std::size_t j = 0; j < getSwapchainImageCount(); ++j) {
@@ -336,6 +343,7 @@ void Carrot::VulkanRenderer::afterFrameCommand(const CommandBufferConsumer& comm
 }
 
 void Carrot::VulkanRenderer::bindSampler(Carrot::Pipeline& pipeline, const Carrot::Render::Context& frame, const vk::Sampler& samplerToBind, std::uint32_t setID, std::uint32_t bindingID) {
+    Async::LockGuard l { descriptorBindingsAccess };
     if(boundSamplers[{pipeline, frame.swapchainIndex, setID, bindingID}] == samplerToBind) {
         return;
     }
@@ -363,6 +371,7 @@ void Carrot::VulkanRenderer::bindTexture(Carrot::Pipeline& pipeline, const Carro
 
 void Carrot::VulkanRenderer::bindAccelerationStructure(Carrot::Pipeline& pipeline, const Carrot::Render::Context& frame, Carrot::AccelerationStructure& as, std::uint32_t setID, std::uint32_t bindingID) {
     ZoneScoped;
+    Async::LockGuard l { descriptorBindingsAccess };
     if(boundAS[{pipeline, frame.swapchainIndex, setID, bindingID}] == as.getVulkanAS()) {
         return;
     }
@@ -394,6 +403,7 @@ void Carrot::VulkanRenderer::bindAccelerationStructure(Carrot::Pipeline& pipelin
 
 void Carrot::VulkanRenderer::bindUniformBuffer(Pipeline& pipeline, const Render::Context& frame, const BufferView& view, std::uint32_t setID, std::uint32_t bindingID) {
     ZoneScoped;
+    Async::LockGuard l { descriptorBindingsAccess };
     if(boundBuffers[{pipeline, frame.swapchainIndex, setID, bindingID}] == view.asBufferInfo()) {
         return;
     }
@@ -419,6 +429,7 @@ void Carrot::VulkanRenderer::bindUniformBuffer(Pipeline& pipeline, const Render:
 
 void Carrot::VulkanRenderer::bindBuffer(Pipeline& pipeline, const Render::Context& frame, const BufferView& view, std::uint32_t setID, std::uint32_t bindingID) {
     ZoneScoped;
+    Async::LockGuard l { descriptorBindingsAccess };
     if(boundBuffers[{pipeline, frame.swapchainIndex, setID, bindingID}] == view.asBufferInfo()) {
         return;
     }
@@ -451,6 +462,7 @@ void Carrot::VulkanRenderer::bindStorageImage(Carrot::Pipeline& pipeline, const
                                          std::uint32_t arrayIndex,
                                          vk::ImageLayout textureLayout) {
     ZoneScoped;
+    Async::LockGuard l { descriptorBindingsAccess };
     if(boundStorageImages[{pipeline, frame.swapchainIndex, setID, bindingID, textureLayout}] == textureToBind.getVulkanImage()) {
         return;
     }
@@ -491,6 +503,7 @@ void Carrot::VulkanRenderer::bindTexture(Carrot::Pipeline& pipeline, const Carro
                                          vk::ImageLayout textureLayout) {
     // TODO: maybe interesting to batch these writes right before starting the rendering
     ZoneScoped;
+    Async::LockGuard l { descriptorBindingsAccess };
     if(boundTextures[{pipeline, frame.swapchainIndex, setID, bindingID, textureLayout}] == textureToBind.getVulkanImage()) {
         return;
     }
@@ -530,6 +543,7 @@ void Carrot::VulkanRenderer::unbindSampler(Carrot::Pipeline& pipeline, const Car
 
 void Carrot::VulkanRenderer::unbindTexture(Pipeline& pipeline, const Render::Context& frame, std::uint32_t setID, std::uint32_t bindingID, std::uint32_t arrayIndex) {
     ZoneScoped;
+    Async::LockGuard l { descriptorBindingsAccess };
     BindingKey k { pipeline, frame.swapchainIndex, setID, bindingID };
     std::erase_if(boundTextures, [&](const auto& pair) {
         return pair.first == k; // leave out layout by design
@@ -560,6 +574,7 @@ void Carrot::VulkanRenderer::unbindTexture(Pipeline& pipeline, const Render::Con
 
 void Carrot::VulkanRenderer::unbindStorageImage(Pipeline& pipeline, const Render::Context& frame, std::uint32_t setID, std::uint32_t bindingID, std::uint32_t arrayIndex) {
     ZoneScoped;
+    Async::LockGuard l { descriptorBindingsAccess };
     BindingKey k { pipeline, frame.swapchainIndex, setID, bindingID };
     std::erase_if(boundStorageImages, [&](const auto& pair) {
         return pair.first == k; // leave out layout by design
@@ -590,6 +605,7 @@ void Carrot::VulkanRenderer::unbindStorageImage(Pipeline& pipeline, const Render
 
 void Carrot::VulkanRenderer::unbindAccelerationStructure(Pipeline& pipeline, const Render::Context& frame, std::uint32_t setID, std::uint32_t bindingID) {
     ZoneScoped;
+    Async::LockGuard l { descriptorBindingsAccess };
     BindingKey k { pipeline, frame.swapchainIndex, setID, bindingID };
     std::erase_if(boundAS, [&](const auto& pair) {
         return pair.first == k; // leave out layout by design
@@ -622,6 +638,7 @@ void Carrot::VulkanRenderer::unbindAccelerationStructure(Pipeline& pipeline, con
 
 void Carrot::VulkanRenderer::unbindBuffer(Pipeline& pipeline, const Render::Context& frame, std::uint32_t setID, std::uint32_t bindingID) {
     ZoneScoped;
+    Async::LockGuard l { descriptorBindingsAccess };
     BindingKey k { pipeline, frame.swapchainIndex, setID, bindingID };
     std::erase_if(boundBuffers, [&](const auto& pair) {
         return pair.first == k;
@@ -653,6 +670,7 @@ void Carrot::VulkanRenderer::unbindBuffer(Pipeline& pipeline, const Render::Cont
 
 void Carrot::VulkanRenderer::unbindUniformBuffer(Pipeline& pipeline, const Render::Context& frame, std::uint32_t setID, std::uint32_t bindingID) {
     ZoneScoped;
+    Async::LockGuard l { descriptorBindingsAccess };
     BindingKey k { pipeline, frame.swapchainIndex, setID, bindingID };
     std::erase_if(boundBuffers, [&](const auto& pair) {
         return pair.first == k;
@@ -740,6 +758,8 @@ void Carrot::VulkanRenderer::beginFrame(const Carrot::Render::Context& renderCon
     }
 
     clusterManager->beginFrame(renderContext);
+    instanceTransformHistory->beginFrame(renderContext);
+    textureStreamer->beginFrame(renderContext);
 
     // TODO: implement via asset reload system
     // reloaded shaders -> pipeline recreation -> need to rebind descriptor
@@ -755,12 +775,14 @@ void Carrot::VulkanRenderer::beginFrame(const Carrot::Render::Context& renderCon
 
     const std::size_t currentIndex = getCurrentBufferPointerForMain();
     Async::Counter prepareThreadRenderPackets;
-    for (auto& pair : perThreadPacketStorage.snapshot()) {
+    auto packetStorageSnapshot = perThreadPacketStorage.snapshot();
+    for (auto& pair : packetStorageSnapshot) {
+        Render::PacketContainer* pContainer = &(*(*pair.second))[currentIndex];
         TaskDescription task {
             .name = "Reset thread local render packet storage",
-            .task = [pair, currentIndex](TaskHandle&) {
-                auto& ppArray = pair.second;
-                (*(*ppArray))[currentIndex].beginFrame();
+            // a single pointer fits inside the inline storage of std::function: no allocation for this task
+            .task = [pContainer](TaskHandle&) {
+                pContainer->beginFrame();
             },
             .joiner = &prepareThreadRenderPackets,
         };
@@ -769,6 +791,13 @@ void Carrot::VulkanRenderer::beginFrame(const Carrot::Render::Context& renderCon
     singleFrameAllocator.newFrame(renderContext.swapchainIndex);
 
     prepareThreadRenderPackets.busyWait();
+
+    frameArenaBytesUsed = 0;
+    for (auto& pair : packetStorageSnapshot) {
+        frameArenaBytesUsed += (*(*pair.second))[currentIndex].getBytesUsedLastFrame();
+    }
+    TracyPlot("Render packet arenas", static_cast<std::int64_t>(frameArenaBytesUsed));
+    TracyPlotConfig("Render packet arenas", tracy::PlotFormatType::Memory, false, false, 0);
     if(glfwGetKey(GetEngine().getMainWindow().getGLFWPointer(), GLFW_KEY_F9) == GLFW_PRESS) {
         driver.breakOnNextVulkanError();
     }
@@ -846,6 +875,9 @@ void Carrot::VulkanRenderer::startRecord(std::uint8_t frameIndex, const Carrot::
     waitForRenderToComplete();
     recordingFrameIndex = frameIndex;
 
+    // render thread is idle, textures can change their images
+    textureStreamer->applyFinishedStreams();
+
     // swap double-buffered data
     {
         recordingRenderContext.copyFrom(renderContext);
@@ -871,37 +903,26 @@ void Carrot::VulkanRenderer::startRecord(std::uint8_t frameIndex, const Carrot::
         }
     }
 
-    static robin_hood::unordered_flat_map<PacketKey, std::vector<Carrot::Render::Packet>> packetBins;
     auto snapshot = threadRenderPackets.snapshot();
 
-    auto placeInBin = [&](Carrot::Render::Packet&& toPlace) -> void {
-        auto key = makeKey(toPlace);
-        auto& bin = packetBins[key];
-
-        for(auto& packet : bin) {
-            // TODO: force merge(std::move(toPlace)) ?
-            if(packet.merge(toPlace)) {
-                return;
-            }
+    const std::size_t currentIndex = getCurrentBufferPointerForRender();
+    std::vector<std::vector<Carrot::Render::Packet>*> toMerge;
+    toMerge.reserve(snapshot.size());
+    for(const auto& [threadID, packets] : snapshot) {
+        if(debugRender) {
+            std::size_t packetCount = packets->unsorted.size();
+            ImGui::Text("%llu packets from thread", packetCount);
+            totalPacketCount += packetCount;
         }
+        toMerge.push_back(&packets->unsorted[currentIndex]);
+    }
 
-        // was not merged, brand new packet
-        bin.emplace_back(std::move(toPlace));
-    };
+    std::size_t previousCapacity = preparedRenderPackets.capacity();
+    preparedRenderPackets.clear();
+    preparedRenderPackets.reserve(previousCapacity);
+    mergeRenderPackets(toMerge, preparedRenderPackets);
 
-    const std::size_t currentIndex = getCurrentBufferPointerForRender();
     for(const auto& [threadID, packets] : snapshot) {
-        {
-            ZoneScopedN("Move thread local packets to global bins");
-            if(debugRender) {
-                std::size_t packetCount = packets->unsorted.size();
-                ImGui::Text("%llu packets from thread", packetCount);
-                totalPacketCount += packetCount;
-            }
-            for(auto& p : packets->unsorted[currentIndex]) {
-                placeInBin(std::move(p));
-            }
-        }
         TaskDescription task {
                 .name = "Cleanup thread local render packets",
                 .task = [pPackets = packets, currentIndex](TaskHandle&) {
@@ -920,22 +941,9 @@ void Carrot::VulkanRenderer::startRecord(std::uint8_t frameIndex, const Carrot::
         GetTaskScheduler().schedule(std::move(task), TaskScheduler::FrameParallelWork);
     }
 
-    std::size_t previousCapacity = preparedRenderPackets.capacity();
-    preparedRenderPackets.clear();
-    preparedRenderPackets.reserve(previousCapacity);
-
-    for(auto& [key, bin] : packetBins) {
-        for(auto& packetOfBin : bin) {
-            preparedRenderPackets.emplace_back(std::move(packetOfBin));
-        }
-        bin.clear();
-    }
-    packetBins.clear();
-
     sortRenderPackets(preparedRenderPackets);
 
     if(debugRender) {
-        ImGui::Text("Render packet bin count: %llu", packetBins.size());
         ImGui::Text("Total render packets count: %llu", totalPacketCount);
         ImGui::Text("Merged render packets count: %llu", preparedRenderPackets.size());
         float ratio = static_cast<float>(preparedRenderPackets.size()) / static_cast<float>(totalPacketCount);
@@ -945,6 +953,8 @@ void Carrot::VulkanRenderer::startRecord(std::uint8_t frameIndex, const Carrot::
         ImGui::Text("Draw call reduction: %0.1f%%", (1.0f - ratio)*100);
         ImGui::Text("Instance buffer size this frame: %s", Carrot::IO::getHumanReadableFileSize(singleFrameAllocator.getAllocatedSizeThisFrame()).c_str());
         ImGui::Text("Instance buffer size total: %s", Carrot::IO::getHumanReadableFileSize(singleFrameAllocator.getAllocatedSizeAllFrames()).c_str());
+        ImGui::Text("Render packet arenas size per frame: %s", Carrot::IO::getHumanReadableFileSize(frameArenaBytesUsed).c_str());
+        ImGui::Text("Previous instance transforms uploaded last frame: %s", Carrot::IO::getHumanReadableFileSize(instanceTransformHistory->getUploadedBytesLastFrame()).c_str());
     }
 
     if(DebugRenderPacket) {
@@ -1554,6 +1564,43 @@ std::span<const Carrot::Render::Packet> Carrot::VulkanRenderer::getRenderPackets
     return std::span<const Render::Packet> { &preparedRenderPackets[startIndex], static_cast<std::size_t>(endIndexInclusive - startIndex + 1) };
 }
 
+void Carrot::VulkanRenderer::mergeRenderPackets(std::span<std::vector<Carrot::Render::Packet>*> toMerge, std::vector<Carrot::Render::Packet>& out) {
+    ZoneScoped;
+    static robin_hood::unordered_flat_map<PacketKey, std::vector<Carrot::Render::Packet>> packetBins;
+
+    auto placeInBin = [&](Carrot::Render::Packet&& toPlace) -> void {
+        auto key = makeKey(toPlace);
+        auto& bin = packetBins[key];
+
+        for(auto& packet : bin) {
+            // TODO: force merge(std::move(toPlace)) ?
+            if(packet.merge(toPlace)) {
+                return;
+            }
+        }
+
+        // was not merged, brand new packet
+        bin.emplace_back(std::move(toPlace));
+    };
+
+    {
+        ZoneScopedN("Move thread local packets to global bins");
+        for(std::vector<Carrot::Render::Packet>* pPackets : toMerge) {
+            for(auto& p : *pPackets) {
+                placeInBin(std::move(p));
+            }
+        }
+    }
+
+    for(auto& [key, bin] : packetBins) {
+        for(auto& packetOfBin : bin) {
+            out.emplace_back(std::move(packetOfBin));
+        }
+        bin.clear();
+    }
+    packetBins.clear();
+}
+
 void Carrot::VulkanRenderer::sortRenderPackets(std::vector<Carrot::Render::Packet>& inputPackets) {
     ZoneScoped;
     // sort by viewport, pass, then pipeline, then mesh
@@ -1651,6 +1698,7 @@ void Carrot::VulkanRenderer::renderWireframeModel(const Carrot::Model& model, co
 
 std::uint32_t Carrot::VulkanRenderer::uploadPerDrawData(const std::span<GBufferDrawData>& drawData) {
     ASSERT_RENDER_THREAD();
+    Async::LockGuard l { perDrawDataAccess };
     const std::size_t alignedElementSize = Math::alignUp(sizeof(std::uint32_t), driver.getPhysicalDeviceLimits().minUniformBufferOffsetAlignment);
 
     std::size_t offset = renderData.perDrawOffsets.size() * alignedElementSize;
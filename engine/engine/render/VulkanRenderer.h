@@ -96,6 +96,9 @@ namespace Carrot {
     namespace Render {
         class Font;
         class ClusterManager;
+        class InstanceTransformHistory;
+        class SpriteAtlas;
+        class TextureStreamer;
         class VisibilityBuffer;
     }
 
@@ -151,6 +154,9 @@ namespace Carrot {
         GBuffer& getGBuffer() { return *gBuffer; };
         Render::VisibilityBuffer& getVisibilityBuffer() { return *visibilityBuffer; };
         Render::ClusterManager& getMeshletManager() { return *clusterManager; };
+        Render::InstanceTransformHistory& getInstanceTransformHistory() { return *instanceTransformHistory; };
+        Render::TextureStreamer& getTextureStreamer() { return *textureStreamer; };
+        Render::SpriteAtlas& getSpriteAtlas() { return *spriteAtlas; };
 
         vk::Device& getLogicalDevice() { return driver.getLogicalDevice(); };
 
@@ -290,6 +296,14 @@ namespace Carrot {
             return renderDebugType;
         }
 
+    public: // packet preparation, exposed for benchmarks
+        /// Moves all packets of 'toMerge' into 'out', merging compatible packets together.
+        /// No other thread may access 'toMerge' or 'out' during the call.
+        static void mergeRenderPackets(std::span<std::vector<Carrot::Render::Packet>*> toMerge, std::vector<Carrot::Render::Packet>& out);
+
+        /// Sorts packets by viewport, pass, then pipeline, then mesh
+        static void sortRenderPackets(std::vector<Carrot::Render::Packet>& packets);
+
     public:
         static void registerUsertype(sol::state& destination);
 
@@ -345,6 +359,7 @@ namespace Carrot {
             std::vector<GBufferDrawData> perDrawData;
             std::vector<std::uint32_t> perDrawOffsets;
         } renderData;
+        Async::SpinLock perDrawDataAccess; // protects the per-draw data of the current frame (see uploadPerDrawData)
 
         std::unique_ptr<ASBuilder> asBuilder = nullptr;
 
@@ -357,6 +372,9 @@ namespace Carrot {
         std::unique_ptr<GBuffer> gBuffer = nullptr;
         std::unique_ptr<Render::VisibilityBuffer> visibilityBuffer = nullptr;
         std::unique_ptr<Render::ClusterManager> clusterManager = nullptr;
+        std::unique_ptr<Render::InstanceTransformHistory> instanceTransformHistory = nullptr;
+        std::unique_ptr<Render::TextureStreamer> textureStreamer = nullptr;
+        std::unique_ptr<Render::SpriteAtlas> spriteAtlas = nullptr;
         Render::PerFrame<std::unique_ptr<Carrot::Buffer>> forwardRenderingFrameInfo;
 
         std::list<CommandBufferConsumer> beforeFrameCommands;
@@ -372,6 +390,7 @@ namespace Carrot {
         std::unordered_map<BindingKey, vk::AccelerationStructureKHR> boundAS;
         std::unordered_map<BindingKey, vk::Sampler> boundSamplers;
         std::unordered_map<BindingKey, vk::DescriptorBufferInfo> boundBuffers;
+        Async::SpinLock descriptorBindingsAccess; // protects the bound* maps above and the descriptor writes made by bind*/unbind*
 
         Async::SpinLock threadRegistrationLock;
 
@@ -381,6 +400,9 @@ namespace Carrot {
         // render thread only
         std::vector<Render::Packet> preparedRenderPackets;
 
+        // bytes used by the packet containers of all threads, for a single frame
+        std::size_t frameArenaBytesUsed = 0;
+
         std::shared_ptr<Carrot::Model> unitSphereModel;
         std::shared_ptr<Carrot::Model> unitCubeModel;
         std::shared_ptr<Carrot::Model> unitCapsuleModel;
@@ -425,7 +447,6 @@ namespace Carrot {
 
     private:
         std::span<const Render::Packet> getRenderPackets(Carrot::Render::Viewport* viewport, Carrot::Render::PassName pass) const;
-        void sortRenderPackets(std::vector<Carrot::Render::Packet>& packets);
 
         // debug
         void renderModel(const Carrot::Model& model, const Carrot::Render::Context& renderContext, const glm::mat4& transform, const glm::vec4& color, const Carrot::UUID& objectID = Carrot::UUID::null());
@@ -5,6 +5,7 @@
 #include "AnimatedInstances.h"
 
 #include <utility>
+#include <core/render/AnimationSampler.h>
 #include <engine/console/RuntimeOption.hpp>
 #include "engine/render/resources/Buffer.h"
 #include "engine/render/Model.h"
@@ -126,6 +127,22 @@ Carrot::AnimatedInstances::AnimatedInstances(Carrot::Engine& engine, std::shared
 void Carrot::AnimatedInstances::createSkinningComputePipeline() {
     auto& computeCommandPool = engine.getComputeCommandPool();
 
+    cpuAnimationSampling = engine.getConfiguration().cpuAnimationSampling;
+    if(cpuAnimationSampling) {
+        const std::span<const CompressedAnimation> animations = model->getCompressedAnimations();
+        paletteBoneCount = animations.empty() ? 1 : std::max<std::size_t>(1, animations[0].getBoneCount());
+        for(std::size_t i = 0; i < engine.getSwapchainImageCount(); i++) {
+            auto& paletteBuffer = skinningPaletteBuffers.emplace_back(std::make_unique<Buffer>(engine.getVulkanDriver(),
+                                                                                                 sizeof(glm::mat4) * paletteBoneCount * maxInstanceCount,
+                                                                                                 vk::BufferUsageFlagBits::eStorageBuffer,
+                                                                                                 vk::MemoryPropertyFlagBits::eHostCoherent | vk::MemoryPropertyFlagBits::eHostVisible));
+            paletteBuffer->name(Carrot::sprintf("skinning palettes %s", model->debugName.c_str()));
+            glm::mat4* pPalettes = paletteBuffer->map<glm::mat4>();
+            std::fill_n(pPalettes, paletteBoneCount * maxInstanceCount, glm::mat4{1.0f});
+            skinningPalettes.push_back(pPalettes);
+        }
+    }
+
     // command buffers which will be sent to the compute queue to compute skinning
     skinningCommandBuffers = engine.getLogicalDevice().allocateCommandBuffers(vk::CommandBufferAllocateInfo {
             .commandPool = computeCommandPool,
@@ -146,17 +163,25 @@ void Carrot::AnimatedInstances::createSkinningComputePipeline() {
                     .offset = 1*sizeof(uint32_t),
                     .size = sizeof(uint32_t),
             },
+
+            // only used by the variant sampling animations on the CPU
+            {
+                    .constantID = 2,
+                    .offset = 2*sizeof(uint32_t),
+                    .size = sizeof(uint32_t),
+            },
     };
 
     std::uint32_t specData[] = {
             static_cast<uint32_t>(vertexCountPerInstance),
             static_cast<uint32_t>(maxInstanceCount),
+            static_cast<uint32_t>(paletteBoneCount),
     };
     vk::SpecializationInfo specialization {
-            .mapEntryCount = 2,
+            .mapEntryCount = 3,
             .pMapEntries = specEntries,
 
-            .dataSize = 2*sizeof(uint32_t),
+            .dataSize = 3*sizeof(uint32_t),
             .pData = specData,
     };
 
@@ -211,16 +236,31 @@ void Carrot::AnimatedInstances::createSkinningComputePipeline() {
             .pBindings = bindings,
     });
 
-    computeSetLayout1 = engine.getLogicalDevice().createDescriptorSetLayoutUnique(vk::DescriptorSetLayoutCreateInfo {
-            .bindingCount = animationBindings.size(),
-            .pBindings = animationBindings.data(),
-    });
+    // skinning palettes, when animations are sampled on the CPU
+    vk::DescriptorSetLayoutBinding paletteBinding {
+            .binding = 0,
+            .descriptorType = vk::DescriptorType::eStorageBuffer,
+            .descriptorCount = 1,
+            .stageFlags = vk::ShaderStageFlagBits::eCompute,
+    };
+
+    if(cpuAnimationSampling) {
+        computeSetLayout1 = engine.getLogicalDevice().createDescriptorSetLayoutUnique(vk::DescriptorSetLayoutCreateInfo {
+                .bindingCount = 1,
+                .pBindings = &paletteBinding,
+        });
+    } else {
+        computeSetLayout1 = engine.getLogicalDevice().createDescriptorSetLayoutUnique(vk::DescriptorSetLayoutCreateInfo {
+                .bindingCount = animationBindings.size(),
+                .pBindings = animationBindings.data(),
+        });
+    }
 
     std::vector<vk::DescriptorPoolSize> poolSizes{};
-    // set0
+    // set0 (+ set1 with the palettes)
     poolSizes.push_back(vk::DescriptorPoolSize {
             .type = vk::DescriptorType::eStorageBuffer,
-            .descriptorCount = static_cast<uint32_t>(set0Size * engine.getSwapchainImageCount()),
+            .descriptorCount = static_cast<uint32_t>(set0Size * engine.getSwapchainImageCount() + (cpuAnimationSampling ? 1 : 0)),
     });
 
     for(size_t i = 0; i < engine.getSwapchainImageCount(); i++) {
@@ -236,6 +276,14 @@ void Carrot::AnimatedInstances::createSkinningComputePipeline() {
                 .pSetLayouts = &(*computeSetLayout0)
         })[0]);
 
+        if(cpuAnimationSampling) {
+            computeDescriptorSet1.push_back(engine.getLogicalDevice().allocateDescriptorSets(vk::DescriptorSetAllocateInfo {
+                    .descriptorPool = *pool,
+                    .descriptorSetCount = 1,
+                    .pSetLayouts = &(*computeSetLayout1)
+            })[0]);
+        }
+
         computeDescriptorPools.emplace_back(std::move(pool));
     }
 
@@ -292,10 +340,30 @@ void Carrot::AnimatedInstances::createSkinningComputePipeline() {
 
         assert(writes.size() == set0Size);
 
+        vk::DescriptorBufferInfo paletteBufferInfo;
+        if(cpuAnimationSampling) {
+            paletteBufferInfo = vk::DescriptorBufferInfo {
+                    .buffer = skinningPaletteBuffers[i]->getVulkanBuffer(),
+                    .offset = 0,
+                    .range = skinningPaletteBuffers[i]->getSize(),
+            };
+
+            // set1, binding0, palettes of this frame
+            writes.push_back(vk::WriteDescriptorSet {
+                    .dstSet = computeDescriptorSet1[i],
+                    .dstBinding = 0,
+                    .descriptorCount = 1,
+                    .descriptorType = DT::eStorageBuffer,
+                    .pBufferInfo = &paletteBufferInfo,
+            });
+        }
+
         engine.getLogicalDevice().updateDescriptorSets(writes, {});
     }
 
-    auto computeStage = ShaderModule(engine.getVulkanDriver(), "resources/shaders/compute/animation-skinning.compute.glsl.spv");
+    const char* computeShader = cpuAnimationSampling ? "resources/shaders/cpu-animation-sampling/compute/animation-skinning.compute.glsl.spv"
+                                                     : "resources/shaders/compute/animation-skinning.compute.glsl.spv";
+    auto computeStage = ShaderModule(engine.getVulkanDriver(), computeShader);
 
     // create the pipeline
     vk::DescriptorSetLayout setLayouts[] = {
@@ -322,7 +390,8 @@ void Carrot::AnimatedInstances::createSkinningComputePipeline() {
         {
             // TODO: tracy zone
             commands.bindPipeline(vk::PipelineBindPoint::eCompute, *computePipeline);
-            commands.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *computePipelineLayout, 0, {computeDescriptorSet0[i], model->getAnimationDataDescriptorSet()}, {});
+            const vk::DescriptorSet animationSet = cpuAnimationSampling ? computeDescriptorSet1[i] : model->getAnimationDataDescriptorSet();
+            commands.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *computePipelineLayout, 0, {computeDescriptorSet0[i], animationSet}, {});
             commands.dispatch(vertexGroups, instanceGroups, 1);
         }
         commands.end();
@@ -347,6 +416,11 @@ vk::Semaphore& Carrot::AnimatedInstances::onFrame(std::size_t frameIndex) {
         }
     }
 
+    if(cpuAnimationSampling) {
+        // read by the skinning command buffer of this frame
+        computeSkinningPalettes(currentInstanceCount, std::span { skinningPalettes[frameIndex], paletteBoneCount * maxInstanceCount });
+    }
+
     // submit skinning command buffer
     // start skinning as soon as possible, even if that means we will have a frame of delay (render before update)
     GetVulkanDriver().submitCompute(vk::SubmitInfo {
@@ -368,6 +442,28 @@ void Carrot::AnimatedInstances::recordGBufferPass(vk::RenderPass pass, Carrot::R
     TODO;
 }
 
+std::size_t Carrot::AnimatedInstances::computeSkinningPalettes(std::size_t instanceCount, std::span<glm::mat4> palettes) {
+    verify(instanceCount <= maxInstanceCount, "instanceCount > maxInstanceCount !");
+    const std::span<const CompressedAnimation> animations = model->getCompressedAnimations();
+    if(animations.empty()) {
+        verify(model->getAnimationMetadata().empty(), "Animations are not compressed, CPU sampling requires Configuration::cpuAnimationSampling");
+        return 0;
+    }
+
+    const std::size_t boneCount = animations[0].getBoneCount();
+    verify(palettes.size() >= instanceCount * boneCount, "Not enough space for the palettes of all instances");
+    GetTaskScheduler().parallelFor(instanceCount, [&](std::size_t instanceIndex) {
+        const AnimatedInstanceData& instance = animatedInstances[instanceIndex];
+        verify(instance.animationIndex < animations.size(), "Invalid animation index");
+        const AnimationLayer layer {
+            .pAnimation = &animations[instance.animationIndex],
+            .time = instance.animationTime,
+        };
+        AnimationSampler::computeSkinningPalette(std::span { &layer, 1 }, palettes.subspan(instanceIndex * boneCount, boneCount));
+    });
+    return boneCount;
+}
+
 void Carrot::AnimatedInstances::render(const Carrot::Render::Context& renderContext, Carrot::Render::PassName renderPass) {
     render(renderContext, renderPass, maxInstanceCount);
 }
@@ -40,6 +40,14 @@ namespace Carrot {
 
         vk::Semaphore& getSkinningSemaphore(std::size_t frameIndex) { return *skinningSemaphores[frameIndex]; };
 
+        /**
+         * Samples the animation of the first 'instanceCount' instances on the CPU, in parallel, from the compressed animations of the model.
+         * 'palettes' receives the bone transforms of each instance one after the other (bone count matrices per instance).
+         * Requires Configuration::cpuAnimationSampling, in which case onFrame calls it to fill the palettes read by the skinning shader.
+         * Returns the bone count (0 if the model has no animation)
+         */
+        std::size_t computeSkinningPalettes(std::size_t instanceCount, std::span<glm::mat4> palettes);
+
         void render(const Carrot::Render::Context& renderContext, Carrot::Render::PassName renderPass);
         void render(const Carrot::Render::Context& renderContext, Carrot::Render::PassName renderPass, std::size_t instanceCount);
 
@@ -78,6 +86,12 @@ namespace Carrot {
         std::vector<vk::CommandBuffer> skinningCommandBuffers{};
         std::vector<vk::UniqueSemaphore> skinningSemaphores{};
 
+        // Configuration::cpuAnimationSampling: bone transforms are sampled on the CPU each frame, instead of by the skinning shader
+        bool cpuAnimationSampling = false;
+        std::size_t paletteBoneCount = 1; // bone transforms per instance inside the palettes
+        std::vector<std::unique_ptr<Buffer>> skinningPaletteBuffers{}; // one per swapchain image, read by the skinning shader of the same frame
+        std::vector<glm::mat4*> skinningPalettes{}; // mapped memory of skinningPaletteBuffers
+
         void createSkinningComputePipeline();
     };
 }
@@ -3,9 +3,6 @@
 //
 
 #include "Particles.h"
-#include "core/utils/RNG.h"
-
-#include "core/math/Constants.h"
 
 Carrot::ParticleEmitter::ParticleEmitter(Carrot::ParticleSystem& system): system(system) {
 
@@ -17,27 +14,10 @@ void Carrot::ParticleEmitter::tick(double deltaTime) {
     uint64_t toSpawn = ceil(rateError-remaining);
     rateError = remaining;
 
-    for (int i = 0; i < toSpawn; ++i) {
-        auto* particle = system.getFreeParticle();
-        if(!particle)
-            break;
-        assert(particle->life < 0.0f);
-        particle->id = spawnedParticles;
-        bool b = Carrot::RNG::randomFloat() > 0.5f;
-        if(b) {
-            particle->life = Math::Pi*2.0f * 10.0f;
-        } else {
-            particle->life = Math::Pi*1.0f * 10.0f;
-        }
-        particle->size = 1.0f;
-        particle->position = position;
-        particle->velocity = {
-                Carrot::RNG::randomFloat(-0.5f, 0.5f),
-                Carrot::RNG::randomFloat(-0.5f, 0.5f),
-                Carrot::RNG::randomFloat(1.0f, 2.5f),
-        };
-
-        spawnedParticles++;
+    if(toSpawn > 0) {
+        // particles are initialized on the GPU, see Particles::spawnParticle
+        system.requestEmission(position, static_cast<std::uint32_t>(toSpawn), spawnedParticles);
+        spawnedParticles += static_cast<std::uint32_t>(toSpawn);
     }
     time += deltaTime;
 }
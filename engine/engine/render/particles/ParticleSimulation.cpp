@@ -0,0 +1,137 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "ParticleSimulation.h"
+#include <algorithm>
+#include <cstddef>
+#include <bit>
+#include <vector>
+#include <core/math/Constants.h>
+#include <core/utils/Assert.h>
+
+namespace Carrot::Particles {
+    static_assert(sizeof(SimulationState) == 19 * sizeof(std::uint32_t), "Must match ParticleSimulationState inside particle-simulation.glsl");
+    static_assert(offsetof(SimulationState, aliveCount) == offsetof(ParticleStatistics, totalCount), "Blueprint update shaders read the alive count at the same offset");
+    static_assert(sizeof(EmissionRequest) == 6 * sizeof(std::uint32_t), "Must match EmissionRequest inside particle-simulation.glsl");
+
+    std::uint32_t nextPowerOfTwo(std::uint32_t value) {
+        if(value == 0) {
+            return 0;
+        }
+        return std::bit_ceil(value);
+    }
+
+    std::uint32_t hash(std::uint32_t value) {
+        const std::uint32_t state = value * 747796405u + 2891336453u;
+        const std::uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+        return (word >> 22u) ^ word;
+    }
+
+    float randomFloat(std::uint32_t id, std::uint32_t stream) {
+        // 24 bits: exactly representable as a float, on both CPU and GPU
+        return static_cast<float>(hash(hash(id) ^ stream) >> 8u) / 16777216.0f;
+    }
+
+    Particle spawnParticle(const EmissionRequest& request, std::uint32_t indexInRequest) {
+        const std::uint32_t id = request.firstID + indexInRequest;
+
+        Particle particle;
+        particle.id = id;
+        particle.life = randomFloat(id, 0) > 0.5f ? Math::Pi * 2.0f * 10.0f : Math::Pi * 1.0f * 10.0f;
+        particle.size = 1.0f;
+        particle.position = glm::vec3 { request.positionX, request.positionY, request.positionZ };
+        particle.velocity = glm::vec3 {
+            randomFloat(id, 1) - 0.5f,
+            randomFloat(id, 2) - 0.5f,
+            1.0f + randomFloat(id, 3) * 1.5f,
+        };
+        return particle;
+    }
+
+    std::uint32_t emit(std::span<Particle> pool, std::uint32_t aliveCount, std::span<const EmissionRequest> requests) {
+        const std::uint32_t capacity = static_cast<std::uint32_t>(pool.size());
+        std::uint32_t requestedCount = 0;
+        for(const auto& request : requests) {
+            for(std::uint32_t i = 0; i < request.count; i++) {
+                const std::uint32_t slot = aliveCount + request.firstParticle + i;
+                if(slot < capacity) {
+                    pool[slot] = spawnParticle(request, i);
+                }
+            }
+            requestedCount = std::max(requestedCount, request.firstParticle + request.count);
+        }
+        return std::min(aliveCount + requestedCount, capacity);
+    }
+
+    std::uint32_t compact(std::span<const Particle> particles, std::span<Particle> output) {
+        verify(output.size() >= particles.size(), "Output is too small");
+        std::uint32_t count = 0;
+        for(const auto& particle : particles) {
+            if(particle.life >= 0.0f) {
+                output[count++] = particle;
+            }
+        }
+        return count;
+    }
+
+    std::uint32_t computeSortKey(const Particle& particle, const glm::vec3& cameraPosition) {
+        const glm::vec3 toParticle = particle.position - cameraPosition;
+        // positive floats have the same order as their bit representation: invert it to put far particles first
+        return ~std::bit_cast<std::uint32_t>(glm::dot(toParticle, toParticle));
+    }
+
+    void bitonicSort(std::span<SortEntry> entries, std::uint32_t count, std::uint32_t capacity) {
+        const std::uint32_t sortCount = nextPowerOfTwo(count);
+        verify(entries.size() >= sortCount, "Not enough room for padding");
+
+        // same passes as ParticleSystem::recordTick, each loop iteration over 'thread' is an invocation of particles-sort.compute.glsl
+        for(std::uint32_t blockSize = 2; blockSize <= nextPowerOfTwo(capacity); blockSize *= 2) {
+            for(std::uint32_t distance = blockSize / 2; distance > 0; distance /= 2) {
+                if(blockSize > sortCount) {
+                    continue;
+                }
+                for(std::uint32_t thread = 0; thread < sortCount / 2; thread++) {
+                    const std::uint32_t low = (thread / distance) * distance * 2 + (thread % distance);
+                    const std::uint32_t high = low + distance;
+
+                    SortEntry a = entries[low];
+                    SortEntry b = entries[high];
+                    if(blockSize == 2) { // first pass: entries after the alive particles are not initialized yet
+                        if(low >= count) {
+                            a = SortPadding;
+                        }
+                        if(high >= count) {
+                            b = SortPadding;
+                        }
+                    }
+
+                    const bool ascending = (low & blockSize) == 0;
+                    if((a > b) == ascending) {
+                        std::swap(a, b);
+                    }
+                    entries[low] = a;
+                    entries[high] = b;
+                }
+            }
+        }
+    }
+
+    std::uint32_t compactAndSort(std::span<Particle> pool, std::uint32_t aliveCount, const glm::vec3& cameraPosition) {
+        std::vector<Particle> scratch;
+        scratch.resize(aliveCount);
+        const std::uint32_t compactedCount = compact(pool.subspan(0, aliveCount), scratch);
+
+        std::vector<SortEntry> entries;
+        entries.resize(nextPowerOfTwo(compactedCount));
+        for(std::uint32_t i = 0; i < compactedCount; i++) {
+            entries[i] = SortEntry { .key = computeSortKey(scratch[i], cameraPosition), .index = i };
+        }
+        bitonicSort(entries, compactedCount, static_cast<std::uint32_t>(pool.size()));
+
+        for(std::uint32_t i = 0; i < compactedCount; i++) {
+            pool[i] = scratch[entries[i].index];
+        }
+        return compactedCount;
+    }
+}
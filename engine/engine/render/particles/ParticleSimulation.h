@@ -0,0 +1,142 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <glm/glm.hpp>
+
+namespace Carrot {
+    struct Particle {
+        alignas(16) glm::vec3 position{0.0f};
+        float life = -1.0f;
+
+        alignas(16) glm::vec3 velocity{0.0f};
+        float size = 1.0f;
+
+        alignas(16) std::uint32_t id = 0;
+    };
+
+    struct ParticleStatistics {
+        float deltaTime;
+        uint32_t totalCount;
+    };
+}
+
+/**
+ * Data shared between the CPU and the GPU particle simulation (mirrors of resources/shaders/includes/particle-simulation.glsl),
+ * and CPU reference implementation of the engine-side steps of the simulation: emission, compaction of dead particles and sorting.
+ *
+ * Each tick, ParticleSystem records the following passes, without reading anything back:
+ *  1. emit: requested particles are appended after the alive ones
+ *  2. prepare (update): alive count and indirect dispatch size of the update are computed
+ *  3. update: the shader of the blueprint, dispatched indirectly
+ *  4. compact: alive particles are appended to a scratch buffer, with their sort key
+ *  5. prepare (sort): alive count, indirect dispatch size of the sort and of the gather, indirect draw arguments
+ *  6. sort: bitonic sort of the keys, one dispatch per (blockSize, compareDistance) pair
+ *  7. gather: particles are copied back from the scratch buffer, in sorted order (back to front)
+ */
+namespace Carrot::Particles {
+    /// Work group size of update, compact and gather passes. Same as the update shaders generated by the particle editor
+    constexpr std::uint32_t UpdateGroupSize = 1024;
+    constexpr std::uint32_t EmitGroupSize = 64;
+    constexpr std::uint32_t SortGroupSize = 256;
+
+    struct DispatchArguments { // same layout as vk::DispatchIndirectCommand
+        std::uint32_t x = 0;
+        std::uint32_t y = 1;
+        std::uint32_t z = 1;
+    };
+
+    struct DrawArguments { // same layout as vk::DrawIndirectCommand
+        std::uint32_t vertexCount = 0;
+        std::uint32_t instanceCount = 1;
+        std::uint32_t firstVertex = 0;
+        std::uint32_t firstInstance = 0;
+    };
+
+    /// Request to spawn 'count' particles at the position of an emitter, made by ParticleEmitter::tick
+    struct EmissionRequest {
+        float positionX = 0.0f;
+        float positionY = 0.0f;
+        float positionZ = 0.0f;
+        std::uint32_t count = 0;
+        std::uint32_t firstParticle = 0; //< index of the first particle of this request, among all particles requested during this tick
+        std::uint32_t firstID = 0; //< id of the first particle spawned by this request
+    };
+
+    /// GPU-side state of a particle system. Starts with the members of ParticleStatistics, because blueprint update shaders read it as their statistics buffer
+    struct SimulationState {
+        float deltaTime = 0.0f;
+        std::uint32_t aliveCount = 0; //< ParticleStatistics::totalCount
+
+        // written by the CPU each tick
+        std::uint32_t requestedCount = 0; //< total count of particles requested by emitters during this tick
+        std::uint32_t emissionRequestCount = 0;
+        float cameraX = 0.0f;
+        float cameraY = 0.0f;
+        float cameraZ = 0.0f;
+
+        // written by the GPU
+        std::uint32_t compactedCount = 0; //< alive particles after the update, incremented by the compact pass
+        std::uint32_t sortCount = 0; //< aliveCount rounded up to a power of 2
+        DispatchArguments updateDispatch; //< for update, compact and gather passes
+        DispatchArguments sortDispatch;
+        DrawArguments draw;
+    };
+
+    /// Entry of the sort: particles are sorted by increasing key, then by index inside the scratch buffer
+    struct SortEntry {
+        std::uint32_t key = 0;
+        std::uint32_t index = 0;
+
+        bool operator>(const SortEntry& other) const {
+            return key > other.key || (key == other.key && index > other.index);
+        }
+    };
+
+    /// Key used for padding, after all real particles
+    constexpr SortEntry SortPadding { 0xFFFFFFFFu, 0xFFFFFFFFu };
+
+    /// Smallest power of 2 >= value (0 stays 0)
+    std::uint32_t nextPowerOfTwo(std::uint32_t value);
+
+    /// Hash used to generate random values on the GPU, from the id of a particle (PCG hash)
+    std::uint32_t hash(std::uint32_t value);
+
+    /// Random value in [0; 1[, deterministic for a given (id, stream) pair
+    float randomFloat(std::uint32_t id, std::uint32_t stream);
+
+    /// Initial state of the 'indexInRequest'-th particle spawned by the given request
+    Particle spawnParticle(const EmissionRequest& request, std::uint32_t indexInRequest);
+
+    /**
+     * Reference for the emit pass: appends the requested particles after the 'aliveCount' first particles of 'pool',
+     * as long as there is room left.
+     * \return the new alive count
+     */
+    std::uint32_t emit(std::span<Particle> pool, std::uint32_t aliveCount, std::span<const EmissionRequest> requests);
+
+    /**
+     * Reference for the compact pass: copies the particles of 'particles' which are still alive (life >= 0) to 'output'.
+     * The GPU version does not keep the order of particles, sorting restores a deterministic order.
+     * \return count of alive particles
+     */
+    std::uint32_t compact(std::span<const Particle> particles, std::span<Particle> output);
+
+    /// Sort key of a particle: farther particles have smaller keys, to render back to front
+    std::uint32_t computeSortKey(const Particle& particle, const glm::vec3& cameraPosition);
+
+    /**
+     * Reference for the sort passes: same bitonic network as the GPU, applied to the 'count' first entries of 'entries'.
+     * 'entries' must hold nextPowerOfTwo(count) entries, entries after 'count' are overwritten with padding.
+     * \param capacity max count of entries, decides which passes are recorded (the passes for bigger blocks than needed do nothing)
+     */
+    void bitonicSort(std::span<SortEntry> entries, std::uint32_t count, std::uint32_t capacity);
+
+    /// Reference for compact + sort + gather: keeps alive particles of the 'aliveCount' first ones, sorted from back to front
+    /// \return new alive count
+    std::uint32_t compactAndSort(std::span<Particle> pool, std::uint32_t aliveCount, const glm::vec3& cameraPosition);
+}
@@ -3,7 +3,6 @@
 //
 
 #include "Particles.h"
-#include <core/utils/RNG.h>
 #include <engine/vulkan/SwapchainAware.h>
 #include "imgui.h"
 #include "engine/render/resources/Buffer.h"
@@ -11,9 +10,28 @@
 #include "engine/render/resources/BufferView.h"
 #include "core/io/Resource.h"
 #include "core/io/Logging.hpp"
+#include "core/utils/Assert.h"
+#include "engine/utils/Macros.h"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <optional>
 
 #define DEBUG_PARTICLES 1
 
+static_assert(sizeof(Carrot::Particles::DispatchArguments) == sizeof(vk::DispatchIndirectCommand));
+static_assert(sizeof(Carrot::Particles::DrawArguments) == sizeof(vk::DrawIndirectCommand));
+
+static constexpr std::uint32_t MaxParticleCountConstantID = 0;
+static constexpr std::uint32_t PrepareStageConstantID = 1;
+
+static constexpr std::uint32_t StateBinding = 0;
+static constexpr std::uint32_t ParticlesBinding = 1;
+static constexpr std::uint32_t ScratchParticlesBinding = 2;
+static constexpr std::uint32_t SortEntriesBinding = 3;
+static constexpr std::uint32_t EmissionRequestsBinding = 4;
+
 Carrot::ParticleSystem::ParticleSystem(Carrot::Engine& engine, Carrot::ParticleBlueprint& blueprint, std::uint64_t maxParticleCount):
         engine(engine), blueprint(blueprint), maxParticleCount(maxParticleCount),
         particleBuffer(engine.getResourceAllocator().allocateBuffer(
@@ -21,123 +39,310 @@ Carrot::ParticleSystem::ParticleSystem(Carrot::Engine& engine, Carrot::ParticleB
             vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eTransferSrc,
             vk::MemoryPropertyFlagBits::eDeviceLocal
         )),
-        statisticsBuffer(engine.getResourceAllocator().allocateBuffer(
-                sizeof(ParticleStatistics),
-                vk::BufferUsageFlagBits::eStorageBuffer,
-                vk::MemoryPropertyFlagBits::eHostCoherent | vk::MemoryPropertyFlagBits::eHostVisible
+        scratchParticleBuffer(engine.getResourceAllocator().allocateBuffer(
+            sizeof(Particle) * maxParticleCount,
+            vk::BufferUsageFlagBits::eStorageBuffer,
+            vk::MemoryPropertyFlagBits::eDeviceLocal
+        )),
+        sortEntriesBuffer(engine.getResourceAllocator().allocateBuffer(
+            sizeof(Particles::SortEntry) * Particles::nextPowerOfTwo(static_cast<std::uint32_t>(maxParticleCount)),
+            vk::BufferUsageFlagBits::eStorageBuffer,
+            vk::MemoryPropertyFlagBits::eDeviceLocal
+        )),
+        stateBuffer(engine.getResourceAllocator().allocateBuffer(
+            sizeof(Particles::SimulationState),
+            vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer | vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eTransferSrc,
+            vk::MemoryPropertyFlagBits::eDeviceLocal
         )) {
-
-    particlePool.resize(maxParticleCount);
+    verify(maxParticleCount > 0 && maxParticleCount <= std::numeric_limits<std::int32_t>::max(), "Invalid particle count");
 
     renderingPipeline = blueprint.buildRenderingPipeline(engine);
+
+    // the state starts with the same members as ParticleStatistics
+    updateParticlesCompute = blueprint.buildComputePipeline(engine, particleBuffer.asBufferInfo(), stateBuffer.asBufferInfo());
+
+    auto buildPass = [&](const char* shader, std::optional<std::uint32_t> prepareStage = {}) {
+        ComputePipelineBuilder builder(engine);
+        builder.shader(shader);
+        builder.specializationUInt32(MaxParticleCountConstantID, static_cast<std::uint32_t>(maxParticleCount));
+        if(prepareStage.has_value()) {
+            builder.specializationUInt32(PrepareStageConstantID, prepareStage.value());
+        }
+        builder.bufferBinding(vk::DescriptorType::eStorageBuffer, 0, StateBinding, stateBuffer.asBufferInfo());
+        builder.bufferBinding(vk::DescriptorType::eStorageBuffer, 0, ParticlesBinding, particleBuffer.asBufferInfo());
+        builder.bufferBinding(vk::DescriptorType::eStorageBuffer, 0, ScratchParticlesBinding, scratchParticleBuffer.asBufferInfo());
+        builder.bufferBinding(vk::DescriptorType::eStorageBuffer, 0, SortEntriesBinding, sortEntriesBuffer.asBufferInfo());
+        return builder;
+    };
+    prepareUpdateCompute = buildPass("resources/shaders/compute/particles-prepare.compute.glsl.spv", 0).build();
+    prepareSortCompute = buildPass("resources/shaders/compute/particles-prepare.compute.glsl.spv", 1).build();
+    compactCompute = buildPass("resources/shaders/compute/particles-compact.compute.glsl.spv").build();
+    sortCompute = buildPass("resources/shaders/compute/particles-sort.compute.glsl.spv").pushConstantSize(2 * sizeof(std::uint32_t)).build();
+    gatherCompute = buildPass("resources/shaders/compute/particles-gather.compute.glsl.spv").build();
+
+    reserveEmissionRequests(4);
+
+    // no particle, and an empty draw until the first tick
+    const Particles::SimulationState initialState{};
+    stateBuffer.stageUpload(&initialState, sizeof(initialState));
+
+    tickCommands = engine.getLogicalDevice().allocateCommandBuffers(vk::CommandBufferAllocateInfo {
+            .commandPool = engine.getComputeCommandPool(),
+            .level = vk::CommandBufferLevel::ePrimary,
+            .commandBufferCount = 1,
+    })[0];
+    tickFence = engine.getLogicalDevice().createFenceUnique(vk::FenceCreateInfo {
+            .flags = vk::FenceCreateFlagBits::eSignaled
+    });
+
     onSwapchainImageCountChange(engine.getSwapchainImageCount());
+}
 
-    updateParticlesCompute = blueprint.buildComputePipeline(engine, particleBuffer.asBufferInfo(), statisticsBuffer.asBufferInfo());
+Carrot::ParticleSystem::~ParticleSystem() {
+    waitForPreviousTick();
+    // copies of frames in flight may still be executing
+    for(const vk::CommandBuffer& cmds : frameCopyCommands) {
+        GetVulkanDriver().deferCommandBufferDestruction(engine.getComputeCommandPool(), cmds);
+    }
+    GetVulkanDriver().deferCommandBufferDestruction(engine.getComputeCommandPool(), tickCommands);
+}
 
-    statistics = statisticsBuffer.map<ParticleStatistics>();
+void Carrot::ParticleSystem::reserveEmissionRequests(std::size_t capacity) {
+    if(capacity <= emissionRequestCapacity) {
+        return;
+    }
+    waitForPreviousTick(); // the previous tick may still be reading the requests
+
+    emissionRequestCapacity = capacity;
+    emissionRequestBuffer = engine.getResourceAllocator().allocateBuffer(
+            sizeof(Particles::EmissionRequest) * emissionRequestCapacity,
+            vk::BufferUsageFlagBits::eStorageBuffer,
+            vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+    );
+    mappedEmissionRequests = emissionRequestBuffer.map<Particles::EmissionRequest>();
+
+    ComputePipelineBuilder builder(engine);
+    builder.shader("resources/shaders/compute/particles-emit.compute.glsl.spv");
+    builder.specializationUInt32(MaxParticleCountConstantID, static_cast<std::uint32_t>(maxParticleCount));
+    builder.bufferBinding(vk::DescriptorType::eStorageBuffer, 0, StateBinding, stateBuffer.asBufferInfo());
+    builder.bufferBinding(vk::DescriptorType::eStorageBuffer, 0, ParticlesBinding, particleBuffer.asBufferInfo());
+    builder.bufferBinding(vk::DescriptorType::eStorageBuffer, 0, EmissionRequestsBinding, emissionRequestBuffer.asBufferInfo());
+    emitCompute = builder.build();
 }
 
 void Carrot::ParticleSystem::onFrame(const Carrot::Render::Context& renderContext) {
 #if DEBUG_PARTICLES
     if(ImGui::Begin("Debug ParticleSystem")) {
-        ImGui::Text("Alive particle count: %lli", usedParticleCount);
-        ImGui::Text("Alive particle count last frame: %lli", oldParticleCount);
-        ImGui::Text("Particles spawned this frame: %lli", usedParticleCount-oldParticleCount);
+        ImGui::Text("Particle capacity: %llu", maxParticleCount);
+        ImGui::Text("Particles requested last tick: %u", particlesRequestedLastTick);
     }
     ImGui::End();
 #endif
 
     renderingPipeline->checkForReloadableShaders();
 
-    if(gotUpdated) {
-        engine.addFrameTask([this, renderContext]() {
-            if(usedParticleCount <= 0)
-                return;
-            pullDataFromGPU();
-
-            auto& camera = renderContext.pViewport->getCamera();
-
-            ZoneScopedN("Sort particles");
-            // sort by distance to camera
-            std::sort(&particlePool[0], &particlePool[usedParticleCount], [&](const Particle& a, const Particle& b) {
-                auto toA = a.position - camera.getPosition();
-                auto toB = b.position - camera.getPosition();
+    // used by the next tick to sort particles
+    cameraPosition = renderContext.pViewport->getCamera().getPosition();
 
-                return glm::dot(toA, toA) > glm::dot(toB, toB);
-            });
-            pushDataToGPU();
-        });
-
-        gotUpdated = false;
-    }
-}
-
-void Carrot::ParticleSystem::pullDataFromGPU() {
-    ZoneScoped;
-    updateParticlesCompute->waitForCompletion();
-    if(usedParticleCount > 0) {
-        particleBuffer.getBuffer().copyTo(std::span<std::uint8_t>{reinterpret_cast<std::uint8_t*>(particlePool.data()), usedParticleCount*sizeof(Particle)}, particleBuffer.getStart());
+    // once per frame, even with multiple viewports: the semaphore must be waited exactly once per signal
+    if(lastCopiedFrame == renderContext.frameCount) {
+        return;
     }
+    lastCopiedFrame = renderContext.frameCount;
+
+    // submitted after the previous ticks on the same queue, the copy starts with a barrier waiting for them
+    const std::size_t frameIndex = renderContext.swapchainIndex;
+    GetVulkanDriver().submitCompute(vk::SubmitInfo {
+            .waitSemaphoreCount = 0,
+            .pWaitSemaphores = nullptr,
+            .pWaitDstStageMask = nullptr,
+            .commandBufferCount = 1,
+            .pCommandBuffers = &frameCopyCommands[frameIndex],
+            .signalSemaphoreCount = 1,
+            .pSignalSemaphores = &(*frameCopySemaphores[frameIndex]),
+    });
+    engine.addWaitSemaphoreBeforeRendering(vk::PipelineStageFlagBits::eDrawIndirect | vk::PipelineStageFlagBits::eVertexShader, *frameCopySemaphores[frameIndex]);
 }
 
-void Carrot::ParticleSystem::pushDataToGPU() {
-    ZoneScoped;
-    if(usedParticleCount > 0) {
-        particleBuffer.getBuffer().stageUploadWithOffset(particleBuffer.getStart(), particlePool.data(), sizeof(Particle)*usedParticleCount);
-        updateParticlesCompute->dispatch(ceil(1024.0f / usedParticleCount),1,1);
+void Carrot::ParticleSystem::waitForPreviousTick() {
+    if(tickFence) {
+        DISCARD(engine.getLogicalDevice().waitForFences(*tickFence, true, UINT64_MAX));
     }
 }
 
 void Carrot::ParticleSystem::tick(double deltaTime) {
-    pullDataFromGPU();
-
+    ZoneScoped;
     for(auto& emitter : emitters) {
         emitter->tick(deltaTime);
     }
-    initNewParticles();
-    updateParticles(deltaTime);
 
-    pushDataToGPU();
+    // the GPU only works on particles from the previous tick, nothing is copied back
+    waitForPreviousTick();
 
-    gotUpdated = true;
-}
+    verify(pendingEmissions.size() <= emissionRequestCapacity, "Emission requests must fit inside the request buffer");
+    std::memcpy(mappedEmissionRequests, pendingEmissions.data(), pendingEmissions.size() * sizeof(Particles::EmissionRequest));
+
+    tickCommands.reset();
+    tickCommands.begin(vk::CommandBufferBeginInfo {
+        .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit,
+    });
+    recordTick(tickCommands, deltaTime);
+    tickCommands.end();
+
+    engine.getLogicalDevice().resetFences(*tickFence);
+    GetVulkanDriver().submitCompute(vk::SubmitInfo {
+            .commandBufferCount = 1,
+            .pCommandBuffers = &tickCommands,
+    }, *tickFence);
 
-void Carrot::ParticleSystem::initNewParticles() {
-    // TODO: compute shader
-/*    for (size_t particleIndex = oldParticleCount; particleIndex < usedParticleCount; ++particleIndex) {
-        // TODO: proper init?
-    }*/
-    oldParticleCount = usedParticleCount;
+    particlesRequestedLastTick = pendingParticleCount;
+    pendingEmissions.clear();
+    pendingParticleCount = 0;
 }
 
-void Carrot::ParticleSystem::updateParticles(double deltaTime) {
-    ZoneScoped;
-    // remove dead particles
-    auto end = std::remove_if(&particlePool[0], &particlePool[usedParticleCount], [](const auto& p) { return p.life < 0.0f; });
-    auto count = std::distance(&particlePool[0], end);
-    usedParticleCount = count;
-    oldParticleCount = count;
+void Carrot::ParticleSystem::recordTick(vk::CommandBuffer& cmds, double deltaTime) {
+    const vk::Buffer& state = stateBuffer.getVulkanBuffer();
+    const vk::DeviceSize stateStart = stateBuffer.getStart();
+    const vk::DeviceSize updateArguments = stateStart + offsetof(Particles::SimulationState, updateDispatch);
+    const vk::DeviceSize sortArguments = stateStart + offsetof(Particles::SimulationState, sortDispatch);
+
+    auto barrier = [&](vk::PipelineStageFlags2KHR srcStage, vk::AccessFlags2KHR srcAccess) {
+        vk::MemoryBarrier2KHR memoryBarrier {
+                .srcStageMask = srcStage,
+                .srcAccessMask = srcAccess,
+                .dstStageMask = vk::PipelineStageFlagBits2KHR::eComputeShader | vk::PipelineStageFlagBits2KHR::eDrawIndirect,
+                .dstAccessMask = vk::AccessFlagBits2KHR::eShaderRead | vk::AccessFlagBits2KHR::eShaderWrite | vk::AccessFlagBits2KHR::eIndirectCommandRead,
+        };
+        vk::DependencyInfoKHR dependencyInfo {
+                .memoryBarrierCount = 1,
+                .pMemoryBarriers = &memoryBarrier,
+        };
+        cmds.pipelineBarrier2KHR(dependencyInfo);
+    };
+    auto computeBarrier = [&]() {
+        barrier(vk::PipelineStageFlagBits2KHR::eComputeShader, vk::AccessFlagBits2KHR::eShaderWrite);
+    };
+
+    // previous tick, and copies for frames in flight which may still be reading the particles and the state
+    {
+        vk::MemoryBarrier2KHR memoryBarrier {
+                .srcStageMask = vk::PipelineStageFlagBits2KHR::eComputeShader | vk::PipelineStageFlagBits2KHR::eTransfer,
+                .srcAccessMask = vk::AccessFlagBits2KHR::eShaderWrite | vk::AccessFlagBits2KHR::eTransferWrite,
+                .dstStageMask = vk::PipelineStageFlagBits2KHR::eComputeShader | vk::PipelineStageFlagBits2KHR::eTransfer,
+                .dstAccessMask = vk::AccessFlagBits2KHR::eShaderRead | vk::AccessFlagBits2KHR::eShaderWrite | vk::AccessFlagBits2KHR::eTransferWrite,
+        };
+        cmds.pipelineBarrier2KHR(vk::DependencyInfoKHR {
+                .memoryBarrierCount = 1,
+                .pMemoryBarriers = &memoryBarrier,
+        });
+    }
 
-    statistics->totalCount = usedParticleCount;
-    statistics->deltaTime = deltaTime;
+    // per-tick parameters
+    const float dt = static_cast<float>(deltaTime);
+    cmds.updateBuffer(state, stateStart + offsetof(Particles::SimulationState, deltaTime), sizeof(dt), &dt);
+    const std::array<std::uint32_t, 5> parameters {
+        pendingParticleCount,
+        static_cast<std::uint32_t>(pendingEmissions.size()),
+        std::bit_cast<std::uint32_t>(cameraPosition.x),
+        std::bit_cast<std::uint32_t>(cameraPosition.y),
+        std::bit_cast<std::uint32_t>(cameraPosition.z),
+    };
+    static_assert(offsetof(Particles::SimulationState, cameraZ) - offsetof(Particles::SimulationState, requestedCount) == 4 * sizeof(std::uint32_t));
+    cmds.updateBuffer(state, stateStart + offsetof(Particles::SimulationState, requestedCount), sizeof(parameters), parameters.data());
+    barrier(vk::PipelineStageFlagBits2KHR::eTransfer, vk::AccessFlagBits2KHR::eTransferWrite);
+
+    // 1. emit: the only dispatch sized by the CPU, because the CPU knows how many particles were requested
+    if(pendingParticleCount > 0) {
+        emitCompute->dispatchInline((pendingParticleCount + Particles::EmitGroupSize - 1) / Particles::EmitGroupSize, 1, 1, cmds);
+        computeBarrier();
+    }
+
+    // 2. alive count and update size
+    prepareUpdateCompute->dispatchInline(1, 1, 1, cmds);
+    computeBarrier();
+
+    // 3. blueprint-specific update
+    updateParticlesCompute->dispatchIndirectInline(state, updateArguments, cmds);
+    computeBarrier();
+
+    // 4. remove dead particles, compute sort keys
+    compactCompute->dispatchIndirectInline(state, updateArguments, cmds);
+    computeBarrier();
+
+    // 5. alive count, sort size and draw arguments
+    prepareSortCompute->dispatchInline(1, 1, 1, cmds);
+    computeBarrier();
+
+    // 6. bitonic sort. The passes for all sizes up to the capacity are recorded, passes for blocks bigger than the alive count return immediately
+    const std::uint32_t sortCapacity = Particles::nextPowerOfTwo(static_cast<std::uint32_t>(maxParticleCount));
+    for(std::uint32_t blockSize = 2; blockSize <= sortCapacity; blockSize *= 2) {
+        for(std::uint32_t distance = blockSize / 2; distance > 0; distance /= 2) {
+            const std::array<std::uint32_t, 2> sortStep { blockSize, distance };
+            sortCompute->dispatchIndirectInline(state, sortArguments, cmds, std::span<const std::uint8_t>{ reinterpret_cast<const std::uint8_t*>(sortStep.data()), sizeof(sortStep) });
+            computeBarrier();
+        }
+    }
+
+    // 7. copy back in sorted order, ready to be drawn
+    gatherCompute->dispatchIndirectInline(state, updateArguments, cmds);
+    computeBarrier();
+}
+
+void Carrot::ParticleSystem::recordFrameCopy(vk::CommandBuffer& cmds, std::size_t frameIndex) {
+    // writes of the ticks submitted before this copy
+    vk::MemoryBarrier2KHR memoryBarrier {
+            .srcStageMask = vk::PipelineStageFlagBits2KHR::eComputeShader | vk::PipelineStageFlagBits2KHR::eTransfer,
+            .srcAccessMask = vk::AccessFlagBits2KHR::eShaderWrite | vk::AccessFlagBits2KHR::eTransferWrite,
+            .dstStageMask = vk::PipelineStageFlagBits2KHR::eTransfer,
+            .dstAccessMask = vk::AccessFlagBits2KHR::eTransferRead,
+    };
+    cmds.pipelineBarrier2KHR(vk::DependencyInfoKHR {
+            .memoryBarrierCount = 1,
+            .pMemoryBarriers = &memoryBarrier,
+    });
+
+    // the whole buffer: the alive count is only known by the GPU
+    cmds.copyBuffer(particleBuffer.getVulkanBuffer(), renderParticleBuffers[frameIndex].getVulkanBuffer(), vk::BufferCopy {
+            .srcOffset = particleBuffer.getStart(),
+            .dstOffset = renderParticleBuffers[frameIndex].getStart(),
+            .size = particleBuffer.getSize(),
+    });
+    cmds.copyBuffer(stateBuffer.getVulkanBuffer(), renderStateBuffers[frameIndex].getVulkanBuffer(), vk::BufferCopy {
+            .srcOffset = stateBuffer.getStart(),
+            .dstOffset = renderStateBuffers[frameIndex].getStart(),
+            .size = stateBuffer.getSize(),
+    });
 }
 
 std::shared_ptr<Carrot::ParticleEmitter> Carrot::ParticleSystem::createEmitter() {
     emitters.emplace_back(std::make_shared<ParticleEmitter>(*this));
+    // at most one request per emitter and per tick
+    if(emitters.size() > emissionRequestCapacity) {
+        reserveEmissionRequests(emissionRequestCapacity * 2);
+    }
     return emitters[emitters.size()-1];
 }
 
-Carrot::Particle* Carrot::ParticleSystem::getFreeParticle() {
-    if(usedParticleCount >= maxParticleCount)
-        return nullptr;
-    auto* particle = &particlePool[usedParticleCount++];
-    *particle = {};
-    return particle;
+void Carrot::ParticleSystem::requestEmission(const glm::vec3& position, std::uint32_t count, std::uint32_t firstID) {
+    if(pendingEmissions.size() >= emissionRequestCapacity) {
+        reserveEmissionRequests(emissionRequestCapacity * 2);
+    }
+    pendingEmissions.emplace_back(Particles::EmissionRequest {
+        .positionX = position.x,
+        .positionY = position.y,
+        .positionZ = position.z,
+        .count = count,
+        .firstParticle = pendingParticleCount,
+        .firstID = firstID,
+    });
+    pendingParticleCount += count;
 }
 
 void Carrot::ParticleSystem::render(vk::RenderPass pass, const Carrot::Render::Context& renderContext, vk::CommandBuffer& commands) const {
     renderingPipeline->bind(pass, renderContext, commands);
-    commands.draw(6 * usedParticleCount, 1, 0, 0);
+    // vertex count is written by the last tick, and copied for this frame by onFrame
+    const Carrot::BufferView& state = renderStateBuffers[renderContext.swapchainIndex];
+    commands.drawIndirect(state.getVulkanBuffer(), state.getStart() + offsetof(Particles::SimulationState, draw), 1, sizeof(vk::DrawIndirectCommand));
 }
 
 void Carrot::ParticleSystem::renderOpaqueGBuffer(vk::RenderPass pass, const Carrot::Render::Context& renderContext, vk::CommandBuffer& commands) const {
@@ -159,14 +364,46 @@ bool Carrot::ParticleSystem::isOpaque() const {
 }
 
 void Carrot::ParticleSystem::onSwapchainImageCountChange(std::size_t newCount) {
+    waitForPreviousTick();
+    for(const vk::CommandBuffer& cmds : frameCopyCommands) {
+        GetVulkanDriver().deferCommandBufferDestruction(engine.getComputeCommandPool(), cmds);
+    }
+
+    renderParticleBuffers.resize(newCount);
+    renderStateBuffers.resize(newCount);
+    frameCopySemaphores.resize(newCount);
+    frameCopyCommands = engine.getLogicalDevice().allocateCommandBuffers(vk::CommandBufferAllocateInfo {
+            .commandPool = engine.getComputeCommandPool(),
+            .level = vk::CommandBufferLevel::ePrimary,
+            .commandBufferCount = static_cast<std::uint32_t>(newCount),
+    });
+    for(std::size_t i = 0; i < newCount; i++) {
+        renderParticleBuffers[i] = engine.getResourceAllocator().allocateBuffer(
+                particleBuffer.getSize(),
+                vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst,
+                vk::MemoryPropertyFlagBits::eDeviceLocal
+        );
+        renderStateBuffers[i] = engine.getResourceAllocator().allocateBuffer(
+                stateBuffer.getSize(),
+                vk::BufferUsageFlagBits::eIndirectBuffer | vk::BufferUsageFlagBits::eTransferDst,
+                vk::MemoryPropertyFlagBits::eDeviceLocal
+        );
+        frameCopySemaphores[i] = engine.getLogicalDevice().createSemaphoreUnique({});
+
+        // always the same copy, recorded once
+        frameCopyCommands[i].begin(vk::CommandBufferBeginInfo {});
+        recordFrameCopy(frameCopyCommands[i], i);
+        frameCopyCommands[i].end();
+    }
+
     renderingPipeline->onSwapchainImageCountChange(newCount);
-    for (int i = 0; i < engine.getSwapchainImageCount(); ++i) {
+    for (int i = 0; i < newCount; ++i) {
         auto set = renderingPipeline->getDescriptorSets(GetEngine().newRenderContext(i, GetEngine().getMainViewport()), 0)[i];
 
         vk::DescriptorBufferInfo bufferInfo {
-            .buffer = particleBuffer.getVulkanBuffer(),
-            .offset = particleBuffer.getStart(),
-            .range = particleBuffer.getSize(),
+            .buffer = renderParticleBuffers[i].getVulkanBuffer(),
+            .offset = renderParticleBuffers[i].getStart(),
+            .range = renderParticleBuffers[i].getSize(),
         };
         vk::WriteDescriptorSet write = {
                 .dstSet = set,
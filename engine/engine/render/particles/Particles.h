@@ -9,33 +9,16 @@
 #include <vector>
 #include <memory>
 #include <engine/render/resources/BufferView.h>
+#include <engine/render/resources/PerFrame.h>
 #include <engine/render/ComputePipeline.h>
 #include "ParticleBlueprint.h"
+#include "ParticleSimulation.h"
 #include "engine/render/BasicRenderable.h"
 
 namespace Carrot {
     class ParticleSystem;
     class ParticleEmitter;
     class ParticleBlueprint;
-    struct Particle;
-
-    struct Particle {
-        alignas(16) glm::vec3 position{0.0f};
-        float life = -1.0f;
-
-        alignas(16) glm::vec3 velocity{0.0f};
-        float size = 1.0f;
-
-        alignas(16) std::uint32_t id = 0;
-
-        static std::vector<vk::VertexInputAttributeDescription> getAttributeDescriptions();
-        static std::vector<vk::VertexInputBindingDescription> getBindingDescription();
-    };
-
-    struct ParticleStatistics {
-        float deltaTime;
-        uint32_t totalCount;
-    };
 
     class ParticleEmitter {
     private:
@@ -44,7 +27,7 @@ namespace Carrot {
         float rate = 1.0f; //! Particles per second
 
         float rateError = 0.0f;
-        std::uint64_t spawnedParticles = 0;
+        std::uint32_t spawnedParticles = 0;
         float time = 0.0f;
 
     public:
@@ -69,15 +52,21 @@ namespace Carrot {
         void tick(double deltaTime);
     };
 
+    /// Particles simulated entirely on the GPU: emission, update, removal of dead particles and sorting by distance to the camera
+    /// are compute passes with indirect dispatches, and rendering uses an indirect draw. Particle data is never read back by the CPU.
+    /// See ParticleSimulation.h for the details of each pass, and the CPU reference implementation.
+    /// Each frame draws its own copy of the particles, made on the compute queue after the ticks submitted before the frame,
+    /// and waited by the graphics queue with a semaphore.
     class ParticleSystem: public SwapchainAware, public Render::BasicRenderable {
     public:
         explicit ParticleSystem(Carrot::Engine& engine, ParticleBlueprint& blueprint, std::uint64_t maxParticleCount);
+        ~ParticleSystem();
 
         std::shared_ptr<ParticleEmitter> createEmitter();
 
-        /// Gets a free particle inside the particle pool. Do not keep this pointer. Returns nullptr if none is available
+        /// Requests 'count' new particles at the given position, spawned by the GPU during the next tick (if there is room left), with ids starting at 'firstID'.
         /// Not thread-safe
-        Particle* getFreeParticle();
+        void requestEmission(const glm::vec3& position, std::uint32_t count, std::uint32_t firstID);
 
         Pipeline& getRenderingPipeline();
         ComputePipeline& getComputePipeline();
@@ -97,33 +86,63 @@ namespace Carrot {
 
     private:
         void render(vk::RenderPass pass, const Carrot::Render::Context& renderContext, vk::CommandBuffer& commands) const;
-        void pullDataFromGPU();
-        void pushDataToGPU();
+
+        /// Waits for the GPU to finish the previous tick (no data is transferred)
+        void waitForPreviousTick();
+
+        /// Records all the passes of a simulation tick, see ParticleSimulation.h
+        void recordTick(vk::CommandBuffer& cmds, double deltaTime);
+
+        /// Records the copy of the particles and simulation state to the buffers drawn by the frame 'frameIndex'
+        void recordFrameCopy(vk::CommandBuffer& cmds, std::size_t frameIndex);
+
+        /// (Re)creates the buffer of emission requests and the pipeline reading it, to fit 'capacity' requests per tick
+        void reserveEmissionRequests(std::size_t capacity);
 
     private:
         ParticleBlueprint& blueprint;
         Carrot::Engine& engine;
 
-        /// All particles will be kept inside this buffer, sorted by lifetime each frame
-        ///  oldParticleCount will keep the number of particles active last frame, while
-        ///  usedParticleCount will keep the number of all active particles.
-        ///  Before a call to initNewParticles, usedParticleCount-oldParticleCount represent the newly created particle during the frame
+        /// All alive particles are kept at the start of this buffer, sorted from back to front after each tick
         Carrot::BufferView particleBuffer;
-        std::vector<Particle> particlePool;
-        std::size_t oldParticleCount = 0;
-        std::size_t usedParticleCount = 0;
+        /// Alive particles are copied here by the compaction, before being copied back in sorted order
+        Carrot::BufferView scratchParticleBuffer;
+        Carrot::BufferView sortEntriesBuffer;
+        /// Particles::SimulationState: counters, indirect arguments and per-tick parameters
+        Carrot::BufferView stateBuffer;
+
+        /// Particles::EmissionRequest, written each tick by the CPU
+        Carrot::BufferView emissionRequestBuffer;
+        Particles::EmissionRequest* mappedEmissionRequests = nullptr;
+        std::size_t emissionRequestCapacity = 0;
+        std::vector<Particles::EmissionRequest> pendingEmissions;
+        std::uint32_t pendingParticleCount = 0;
 
         std::vector<std::shared_ptr<ParticleEmitter>> emitters;
         std::uint64_t maxParticleCount;
 
         std::shared_ptr<Pipeline> renderingPipeline = nullptr;
         std::shared_ptr<ComputePipeline> updateParticlesCompute = nullptr;
-
-        Carrot::BufferView statisticsBuffer;
-        ParticleStatistics* statistics = nullptr;
-        std::atomic<bool> gotUpdated = false;
-
-        void initNewParticles();
-        void updateParticles(double deltaTime);
+        std::unique_ptr<ComputePipeline> emitCompute = nullptr;
+        std::unique_ptr<ComputePipeline> prepareUpdateCompute = nullptr;
+        std::unique_ptr<ComputePipeline> compactCompute = nullptr;
+        std::unique_ptr<ComputePipeline> prepareSortCompute = nullptr;
+        std::unique_ptr<ComputePipeline> sortCompute = nullptr;
+        std::unique_ptr<ComputePipeline> gatherCompute = nullptr;
+
+        vk::CommandBuffer tickCommands{};
+        vk::UniqueFence tickFence{};
+
+        /// Particles and simulation state drawn by each frame in flight, copied from particleBuffer and stateBuffer when the frame starts.
+        /// Ticks can then write to the simulation buffers while previous frames still draw their copy
+        Render::PerFrame<Carrot::BufferView> renderParticleBuffers;
+        Render::PerFrame<Carrot::BufferView> renderStateBuffers;
+        Render::PerFrame<vk::CommandBuffer> frameCopyCommands;
+        /// Signaled by the copy of each frame, waited by the graphics queue before drawing
+        Render::PerFrame<vk::UniqueSemaphore> frameCopySemaphores;
+        std::size_t lastCopiedFrame = -1;
+        std::uint32_t particlesRequestedLastTick = 0;
+
+        glm::vec3 cameraPosition{0.0f};
     };
 }
@@ -9,7 +9,6 @@
 #include <engine/Engine.h>
 #include <engine/render/InstanceData.h>
 #include <engine/render/resources/ResourceAllocator.h>
-#include <stb_image_write.h>
 #include <engine/render/resources/Mesh.h>
 #include <glm/matrix.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -18,7 +17,8 @@ namespace Carrot::Render {
 
     Font::Font(VulkanRenderer& renderer,
                const Carrot::IO::Resource& ttfFile,
-               const std::vector<std::uint64_t>& renderableCodepoints
+               const std::vector<std::uint64_t>& renderableCodepoints,
+               GlyphAtlas::Mode atlasMode
                ):
                renderer(renderer)
     {
@@ -28,6 +28,13 @@ namespace Carrot::Render {
             msg += ttfFile.getName();
             throw std::runtime_error(msg);
         }
+
+        // SDF glyphs can be rasterized smaller, they scale up nicely
+        const float atlasPixelSize = atlasMode == GlyphAtlas::Mode::SDF ? 32.0f : 64.0f;
+        atlas = std::make_unique<GlyphAtlas>(fontInfo, atlasPixelSize, atlasMode);
+        for(const std::uint64_t codepoint : renderableCodepoints) {
+            atlas->getGlyph(static_cast<char32_t>(codepoint));
+        }
     }
 
     RenderableText Font::bake(std::u32string_view text, float pixelSize) {
@@ -80,7 +87,6 @@ namespace Carrot::Render {
             xpos += advance * scale;
         }
         bitmap->getImage().stageUpload({pixels.data(), pixels.size()});
-        stbi_write_png("test-font.png", w, h, 1, pixels.data(), w);
 
         auto material = GetRenderer().getMaterialSystem().createMaterialHandle();
         auto textureHandle = GetRenderer().getMaterialSystem().createTextureHandle(bitmap);
@@ -119,6 +125,70 @@ namespace Carrot::Render {
         TODO
     }
 
+    TextMetrics Font::layout(std::u32string_view text, std::vector<GlyphQuad>& out, float pixelSize) {
+        const glm::vec2 size = atlas->layout(text, pixelSize, out);
+        return TextMetrics {
+            .width = size.x,
+            .height = size.y,
+            .baseline = atlas->getAscent() * pixelSize / atlas->getPixelSize(),
+            .basePixelSize = pixelSize,
+        };
+    }
+
+    void Font::updateAtlasTexture() {
+        if(atlasMaterial && uploadedAtlasVersion == atlas->getVersion()) {
+            return;
+        }
+        ZoneScoped;
+
+        // a new texture is created instead of updating the existing one: the current one may still be used by frames in flight
+        // (images are destroyed with a delay, see Carrot::Image::~Image)
+        auto texture = std::make_shared<Carrot::Render::Texture>(renderer.getVulkanDriver(),
+                                                                 vk::Extent3D { atlas->getWidth(), atlas->getHeight(), 1 },
+                                                                 vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst,
+                                                                 vk::Format::eR8Unorm);
+        std::span<const std::uint8_t> pixels = atlas->getPixels();
+        texture->getImage().stageUpload({ const_cast<std::uint8_t*>(pixels.data()), pixels.size() });
+        texture->name("Glyph atlas");
+
+        if(!atlasMaterial) {
+            atlasTexture = renderer.getMaterialSystem().createTextureHandle(texture);
+            atlasMaterial = renderer.getMaterialSystem().createMaterialHandle();
+            atlasMaterial->albedo = atlasTexture;
+        } else {
+            atlasTexture->texture = texture;
+        }
+        uploadedAtlasVersion = atlas->getVersion();
+    }
+
+    GlyphAtlas& Font::getAtlas() {
+        return *atlas;
+    }
+
+    const Carrot::Render::MaterialHandle& Font::getAtlasMaterial() const {
+        verify(atlasMaterial, "Atlas was never uploaded, call updateAtlasTexture first");
+        return *atlasMaterial;
+    }
+
+    Carrot::Mesh& Font::getGlyphQuad() {
+        if(!glyphQuad) {
+            glyphQuad = std::make_unique<Carrot::SingleMesh>(
+                    std::vector<Carrot::SimpleVertexWithInstanceData>{
+                            {{0, 0, 0}},
+                            {{0, 1, 0}},
+                            {{1, 1, 0}},
+                            {{1, 0, 0}},
+                    },
+                    std::vector<std::uint32_t>{ 2,1,0, 3,2,0 }
+            );
+        }
+        return *glyphQuad;
+    }
+
+    const char* Font::getBatchedPipelineName() const {
+        return atlas->getMode() == GlyphAtlas::Mode::SDF ? "text-rendering-batched-sdf" : "text-rendering-batched";
+    }
+
     void RenderableText::render(Carrot::Render::Context renderContext) {
         if(!mesh)
             return;
@@ -12,6 +12,7 @@
 #include <engine/render/resources/BufferView.h>
 #include "engine/render/InstanceData.h"
 #include "engine/render/MaterialSystem.h"
+#include "engine/render/resources/GlyphAtlas.h"
 
 namespace Carrot::Render {
     class MaterialHandle;
@@ -65,12 +66,30 @@ namespace Carrot::Render {
         static constexpr std::uint32_t MaxInstances = 256;
 
         // TODO: Support font fallback
-        explicit Font(Carrot::VulkanRenderer& renderer, const Carrot::IO::Resource& ttfFile, const std::vector<std::uint64_t>& renderableCodepoints = getAsciiCodepoints());
+        explicit Font(Carrot::VulkanRenderer& renderer, const Carrot::IO::Resource& ttfFile, const std::vector<std::uint64_t>& renderableCodepoints = getAsciiCodepoints(), GlyphAtlas::Mode atlasMode = GlyphAtlas::Mode::Coverage);
 
     public:
+        /// Rasterizes the entire string inside a dedicated texture. Creates GPU resources on each call: prefer layout + TextBatcher for text that changes
         RenderableText bake(std::u32string_view text, float pixelSize = 64.0f);
         void immediateRender(std::u32string_view text, glm::mat4 transform);
 
+    public: // glyph atlas
+        /// Lays out the given text with the glyphs of the shared atlas of this font. Does not allocate GPU resources.
+        /// Glyphs which were never used before are rasterized inside the atlas, and will be uploaded with the next call to updateAtlasTexture
+        TextMetrics layout(std::u32string_view text, std::vector<GlyphQuad>& out, float pixelSize = 64.0f);
+
+        /// Uploads the atlas to the GPU if it changed since the last call. Must be called from the main thread
+        void updateAtlasTexture();
+
+        GlyphAtlas& getAtlas();
+        const Carrot::Render::MaterialHandle& getAtlasMaterial() const;
+
+        /// Quad with coordinates from (0,0) to (1,1), used for instanced rendering of glyphs
+        Carrot::Mesh& getGlyphQuad();
+
+        /// Name of the pipeline to use to render glyphs from the atlas of this font
+        const char* getBatchedPipelineName() const;
+
     public:
         static std::vector<std::uint64_t>& getAsciiCodepoints();
 
@@ -78,6 +97,12 @@ namespace Carrot::Render {
         std::unique_ptr<std::uint8_t[]> data = nullptr; // must be kept alive for stb_truetype to work
         Carrot::VulkanRenderer& renderer;
         stbtt_fontinfo fontInfo;
+
+        std::unique_ptr<GlyphAtlas> atlas;
+        std::uint64_t uploadedAtlasVersion = 0;
+        std::shared_ptr<Carrot::Render::TextureHandle> atlasTexture;
+        std::shared_ptr<Carrot::Render::MaterialHandle> atlasMaterial;
+        std::unique_ptr<Carrot::Mesh> glyphQuad;
     };
 
 }
@@ -0,0 +1,211 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "GlyphAtlas.h"
+#include <core/utils/Assert.h>
+#include <core/utils/Profiling.h>
+#include <cmath>
+#include <cstring>
+
+namespace Carrot::Render {
+
+    GlyphAtlas::GlyphAtlas(const stbtt_fontinfo& fontInfo, float pixelSize, Mode mode, std::uint32_t width, std::uint32_t initialHeight)
+    : fontInfo(fontInfo)
+    , pixelSize(pixelSize)
+    , mode(mode)
+    , width(width)
+    , height(initialHeight)
+    {
+        verify(width > 0 && initialHeight > 0, "Atlas cannot be empty");
+        scale = stbtt_ScaleForPixelHeight(&fontInfo, pixelSize);
+
+        int fontAscent, fontDescent, lineGap;
+        stbtt_GetFontVMetrics(&fontInfo, &fontAscent, &fontDescent, &lineGap);
+        ascent = fontAscent * scale;
+        lineHeight = (fontAscent - fontDescent + lineGap) * scale;
+
+        pixels.resize(static_cast<std::size_t>(width) * height);
+    }
+
+    const GlyphInfo& GlyphAtlas::getGlyph(char32_t codepoint) {
+        if(codepoint < AsciiCount) {
+            if(!asciiPresent[codepoint]) {
+                asciiGlyphs[codepoint] = rasterize(codepoint);
+                asciiPresent[codepoint] = true;
+                glyphCount++;
+            }
+            return asciiGlyphs[codepoint];
+        }
+
+        auto it = otherGlyphs.find(codepoint);
+        if(it == otherGlyphs.end()) {
+            it = otherGlyphs.emplace(codepoint, rasterize(codepoint)).first;
+            glyphCount++;
+        }
+        return it->second;
+    }
+
+    void GlyphAtlas::preload(std::u32string_view codepoints) {
+        for(char32_t c : codepoints) {
+            getGlyph(c);
+        }
+    }
+
+    float GlyphAtlas::getKerning(const GlyphInfo& left, const GlyphInfo& right) const {
+        return stbtt_GetGlyphKernAdvance(&fontInfo, left.glyphIndex, right.glyphIndex) * scale;
+    }
+
+    glm::vec2 GlyphAtlas::layout(std::u32string_view text, float requestedPixelSize, std::vector<GlyphQuad>& out) {
+        out.clear();
+        if(text.empty()) {
+            return glm::vec2{0.0f};
+        }
+
+        const float sizeRatio = requestedPixelSize / pixelSize;
+
+        // first pass in atlas space, Y down, origin at top-left of the text
+        float penX = 0.0f;
+        float baseline = ascent;
+        float maxWidth = 0.0f;
+        std::size_t lineCount = 1;
+        const GlyphInfo* previous = nullptr;
+        for(char32_t c : text) {
+            if(c == U'\n') {
+                maxWidth = std::max(maxWidth, penX);
+                penX = 0.0f;
+                baseline += lineHeight;
+                lineCount++;
+                previous = nullptr;
+                continue;
+            }
+
+            const GlyphInfo& glyph = getGlyph(c);
+            if(previous) {
+                penX += getKerning(*previous, glyph);
+            }
+
+            if(!glyph.isEmpty()) {
+                const glm::vec2 size = glyph.texelMax - glyph.texelMin;
+                const glm::vec2 topLeft { penX + glyph.bearing.x, baseline + glyph.bearing.y };
+                out.emplace_back(GlyphQuad {
+                    .rect = glm::vec4 { topLeft, topLeft + size },
+                    .texelRect = glm::vec4 { glyph.texelMin, glyph.texelMax },
+                });
+            }
+
+            penX += glyph.advance;
+            previous = &glyph;
+        }
+        maxWidth = std::max(maxWidth, penX);
+        const float textHeight = lineCount * lineHeight;
+
+        // second pass: center around origin, flip Y, and scale to requested size
+        const glm::vec2 halfSize { maxWidth / 2.0f, textHeight / 2.0f };
+        for(GlyphQuad& quad : out) {
+            const float left = quad.rect.x - halfSize.x;
+            const float right = quad.rect.z - halfSize.x;
+            const float top = halfSize.y - quad.rect.y;
+            const float bottom = halfSize.y - quad.rect.w;
+            quad.rect = glm::vec4 { left, bottom, right, top } * sizeRatio;
+        }
+        return glm::vec2 { maxWidth, textHeight } * sizeRatio;
+    }
+
+    GlyphInfo GlyphAtlas::rasterize(char32_t codepoint) {
+        ZoneScoped;
+        GlyphInfo info;
+        info.glyphIndex = stbtt_FindGlyphIndex(&fontInfo, static_cast<int>(codepoint));
+
+        int advance, lsb;
+        stbtt_GetGlyphHMetrics(&fontInfo, info.glyphIndex, &advance, &lsb);
+        info.advance = advance * scale;
+
+        if(stbtt_IsGlyphEmpty(&fontInfo, info.glyphIndex)) {
+            return info;
+        }
+
+        switch(mode) {
+            case Mode::Coverage: {
+                int x0, y0, x1, y1;
+                stbtt_GetGlyphBitmapBox(&fontInfo, info.glyphIndex, scale, scale, &x0, &y0, &x1, &y1);
+                const std::uint32_t w = static_cast<std::uint32_t>(x1 - x0);
+                const std::uint32_t h = static_cast<std::uint32_t>(y1 - y0);
+                if(w == 0 || h == 0) {
+                    return info;
+                }
+
+                const glm::uvec2 spot = allocate(w + 2 * Padding, h + 2 * Padding) + glm::uvec2{ Padding };
+                stbtt_MakeGlyphBitmap(&fontInfo, &pixels[spot.y * width + spot.x], static_cast<int>(w), static_cast<int>(h), static_cast<int>(width), scale, scale, info.glyphIndex);
+
+                info.texelMin = glm::vec2 { spot };
+                info.texelMax = info.texelMin + glm::vec2 { w, h };
+                info.bearing = glm::vec2 { x0, y0 };
+            } break;
+
+            case Mode::SDF: {
+                int w, h, xoff, yoff;
+                const float pixelDistanceScale = static_cast<float>(SDFOnEdgeValue) / SDFPadding;
+                unsigned char* sdf = stbtt_GetGlyphSDF(&fontInfo, scale, info.glyphIndex, SDFPadding, SDFOnEdgeValue, pixelDistanceScale, &w, &h, &xoff, &yoff);
+                if(sdf == nullptr) {
+                    return info;
+                }
+
+                const glm::uvec2 spot = allocate(w + 2 * Padding, h + 2 * Padding) + glm::uvec2{ Padding };
+                for(int y = 0; y < h; y++) {
+                    std::memcpy(&pixels[(spot.y + y) * width + spot.x], &sdf[y * w], w);
+                }
+                stbtt_FreeSDF(sdf, nullptr);
+
+                info.texelMin = glm::vec2 { spot };
+                info.texelMax = info.texelMin + glm::vec2 { w, h };
+                info.bearing = glm::vec2 { xoff, yoff };
+            } break;
+        }
+
+        version++;
+        return info;
+    }
+
+    glm::uvec2 GlyphAtlas::allocate(std::uint32_t w, std::uint32_t h) {
+        verify(w <= width, "Glyph is wider than the atlas, use a smaller pixel size or a wider atlas");
+
+        // best fit: the shelf with the smallest height that can contain the glyph, without wasting too much space
+        Shelf* bestShelf = nullptr;
+        for(Shelf& shelf : shelves) {
+            if(shelf.height < h || shelf.height > h + h / 2) {
+                continue;
+            }
+            if(shelf.cursorX + w > width) {
+                continue;
+            }
+            if(bestShelf == nullptr || shelf.height < bestShelf->height) {
+                bestShelf = &shelf;
+            }
+        }
+
+        if(bestShelf == nullptr) {
+            while(nextShelfY + h > height) {
+                grow();
+            }
+            bestShelf = &shelves.emplace_back(Shelf {
+                .y = nextShelfY,
+                .height = h,
+                .cursorX = 0,
+            });
+            nextShelfY += h;
+        }
+
+        const glm::uvec2 result { bestShelf->cursorX, bestShelf->y };
+        bestShelf->cursorX += w;
+        return result;
+    }
+
+    void GlyphAtlas::grow() {
+        verify(height * 2 <= MaxHeight, "Glyph atlas is too big, too many different glyphs are used with this font!");
+        // rows are stored contiguously with a constant width: growing does not move existing glyphs
+        height *= 2;
+        pixels.resize(static_cast<std::size_t>(width) * height);
+        version++;
+    }
+}
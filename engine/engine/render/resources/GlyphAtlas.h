@@ -0,0 +1,144 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include <stb_truetype.h>
+
+namespace Carrot::Render {
+    /// Location and metrics of a single glyph inside a GlyphAtlas.
+    /// All values are expressed in pixels of the atlas (ie at the atlas pixel size)
+    struct GlyphInfo {
+        glm::vec2 texelMin{0.0f}; //< top-left corner of the glyph inside the atlas
+        glm::vec2 texelMax{0.0f}; //< bottom-right corner of the glyph inside the atlas
+        glm::vec2 bearing{0.0f}; //< offset from the pen position to the top-left corner of the glyph bitmap (Y down)
+        float advance = 0.0f; //< how much to move the pen after this glyph
+        int glyphIndex = 0; //< index of glyph inside font, used for kerning
+
+        bool isEmpty() const { return texelMax.x <= texelMin.x || texelMax.y <= texelMin.y; }
+    };
+
+    /// A single quad of a laid out text. Positions are in text space (pixels, Y up, origin at the center of the text),
+    /// texture coordinates are in texels of the atlas: they stay valid even if the atlas grows.
+    struct GlyphQuad {
+        glm::vec4 rect{0.0f}; //< xy = min corner, zw = max corner
+        glm::vec4 texelRect{0.0f}; //< xy = top-left texel, zw = bottom-right texel
+    };
+
+    /**
+     * \brief CPU-side atlas of rasterized glyphs of a single font. Glyphs are rasterized the first time they are requested,
+     * and packed in rows ("shelves") of the atlas. When the atlas is full, its height is doubled and the existing
+     * content is kept as-is: texel coordinates of already packed glyphs never change.
+     *
+     * Glyphs can be rasterized either as coverage (regular antialiased bitmap) or as signed distance fields. SDF glyphs
+     * can be scaled up much more before looking blurry, at the cost of a slightly more expensive fragment shader.
+     *
+     * This class does not touch the GPU, see Font for the upload of the atlas.
+     * Not thread-safe.
+     */
+    class GlyphAtlas {
+    public:
+        enum class Mode {
+            Coverage,
+            SDF,
+        };
+
+        /// Padding (in texels) added around each glyph to avoid bleeding when sampling with bilinear filtering
+        static constexpr std::uint32_t Padding = 1;
+
+        /// Padding (in texels) used around glyphs when generating distance fields
+        static constexpr int SDFPadding = 6;
+
+        /// Value of distance fields on the outline of glyphs
+        static constexpr std::uint8_t SDFOnEdgeValue = 128;
+
+        /// Maximum height of the atlas, growing further is considered an error
+        static constexpr std::uint32_t MaxHeight = 8192;
+
+        /**
+         * \param fontInfo font to rasterize glyphs from. Must outlive this atlas
+         * \param pixelSize size at which glyphs are rasterized. Text can be laid out at any size afterwards
+         * \param mode rasterization mode, see Mode
+         * \param width width of the atlas, never changes
+         * \param initialHeight initial height of the atlas, doubles each time the atlas is full
+         */
+        explicit GlyphAtlas(const stbtt_fontinfo& fontInfo, float pixelSize = 64.0f, Mode mode = Mode::Coverage, std::uint32_t width = 512, std::uint32_t initialHeight = 256);
+
+        /// Returns the glyph information for the given codepoint, rasterizing it if this is the first time it is requested
+        const GlyphInfo& getGlyph(char32_t codepoint);
+
+        /// Rasterizes all given codepoints in advance. Useful to avoid uploading the atlas during gameplay
+        void preload(std::u32string_view codepoints);
+
+        /// Returns the kerning to apply between the two given glyphs, in pixels of the atlas
+        float getKerning(const GlyphInfo& left, const GlyphInfo& right) const;
+
+        /**
+         * \brief Lays out the given text and writes one quad per visible glyph into 'out' (which is cleared first).
+         * Supports '\n' for new lines. Quads are centered around the origin of the text space.
+         * \param text text to layout
+         * \param pixelSize requested size of the text, quads are scaled relative to the atlas pixel size
+         * \param out where to write the quads. Capacity is reused
+         * \return size of the text, in text space
+         */
+        glm::vec2 layout(std::u32string_view text, float pixelSize, std::vector<GlyphQuad>& out);
+
+    public:
+        float getPixelSize() const { return pixelSize; }
+        float getScale() const { return scale; }
+        float getAscent() const { return ascent; }
+        float getLineHeight() const { return lineHeight; }
+        Mode getMode() const { return mode; }
+
+        std::uint32_t getWidth() const { return width; }
+        std::uint32_t getHeight() const { return height; }
+        std::span<const std::uint8_t> getPixels() const { return pixels; }
+        std::size_t getGlyphCount() const { return glyphCount; }
+
+        /// Incremented each time the pixels of the atlas change (new glyph or growth)
+        std::uint64_t getVersion() const { return version; }
+
+    private:
+        GlyphInfo rasterize(char32_t codepoint);
+
+        /// Finds a free spot of the given size in the atlas, growing it if necessary. Returns top-left corner of spot
+        glm::uvec2 allocate(std::uint32_t w, std::uint32_t h);
+        void grow();
+
+    private:
+        const stbtt_fontinfo& fontInfo;
+        float pixelSize = 0.0f;
+        Mode mode = Mode::Coverage;
+        float scale = 1.0f;
+        float ascent = 0.0f;
+        float lineHeight = 0.0f;
+
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        std::vector<std::uint8_t> pixels;
+        std::uint64_t version = 0;
+
+        struct Shelf {
+            std::uint32_t y = 0;
+            std::uint32_t height = 0;
+            std::uint32_t cursorX = 0;
+        };
+        std::vector<Shelf> shelves;
+        std::uint32_t nextShelfY = 0;
+
+        // fast path for the most common characters
+        static constexpr std::size_t AsciiCount = 128;
+        std::array<GlyphInfo, AsciiCount> asciiGlyphs;
+        std::array<bool, AsciiCount> asciiPresent{};
+        std::unordered_map<char32_t, GlyphInfo> otherGlyphs;
+        std::size_t glyphCount = 0;
+    };
+}
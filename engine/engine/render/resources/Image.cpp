@@ -17,19 +17,20 @@
 #include "engine/task/TaskScheduler.h"
 #include "engine/Engine.h"
 #include "engine/render/resources/ResourceAllocator.h"
+#include <core/Macros.h>
 
 /*static*/ Carrot::Async::SpinLock Carrot::Image::AliveImagesAccess{};
 /*static*/ std::unordered_set<const Carrot::Image*> Carrot::Image::AliveImages{};
 
 Carrot::Image::Image(Carrot::VulkanDriver& driver, vk::Extent3D extent, vk::ImageUsageFlags usage, vk::Format format,
-                     std::set<std::uint32_t> families, vk::ImageCreateFlags flags, vk::ImageType imageType, std::uint32_t layerCount):
-        Carrot::DebugNameable(), driver(driver), size(extent), layerCount(layerCount), usage(usage), format(format), imageData(true) {
+                     std::set<std::uint32_t> families, vk::ImageCreateFlags flags, vk::ImageType imageType, std::uint32_t layerCount, std::uint32_t mipLevels):
+        Carrot::DebugNameable(), driver(driver), size(extent), layerCount(layerCount), mipLevels(mipLevels), usage(usage), format(format), imageData(true) {
     vk::ImageCreateInfo createInfo{
         .flags = flags,
         .imageType = imageType,
         .format = format,
         .extent = extent,
-        .mipLevels = 1,
+        .mipLevels = mipLevels,
         .arrayLayers = layerCount,
         .samples = vk::SampleCountFlagBits::e1,
         .usage = usage,
@@ -68,6 +69,40 @@ Carrot::Image::Image(Carrot::VulkanDriver& driver, vk::Extent3D extent, vk::Imag
     AliveImages.insert(this);
 }
 
+static vk::ImageCreateInfo makeGraphicsOnlyCreateInfo(vk::Extent3D extent, vk::ImageUsageFlags usage, vk::Format format) {
+    return vk::ImageCreateInfo {
+        .imageType = vk::ImageType::e2D,
+        .format = format,
+        .extent = extent,
+        .mipLevels = 1,
+        .arrayLayers = 1,
+        .samples = vk::SampleCountFlagBits::e1,
+        .usage = usage,
+        .sharingMode = vk::SharingMode::eExclusive,
+        .initialLayout = vk::ImageLayout::eUndefined,
+    };
+}
+
+Carrot::Image::Image(Carrot::VulkanDriver& driver, vk::Extent3D extent, vk::ImageUsageFlags usage, vk::Format format,
+                     std::shared_ptr<Carrot::DeviceMemory> memory, vk::DeviceSize offset):
+        Carrot::DebugNameable(), driver(driver), size(extent), layerCount(1), usage(usage), format(format), imageData(true) {
+    imageData.asOwned.vkImage = driver.getLogicalDevice().createImageUnique(makeGraphicsOnlyCreateInfo(extent, usage, format), driver.getAllocationCallbacks());
+
+    vk::MemoryRequirements requirements = driver.getLogicalDevice().getImageMemoryRequirements(getVulkanImage());
+    verify(offset % requirements.alignment == 0, "Misaligned aliased image");
+    verify(offset + requirements.size <= memory->getSize(), "Aliased image does not fit inside its memory");
+    driver.getLogicalDevice().bindImageMemory(getVulkanImage(), memory->getVulkanMemory(), offset);
+    imageData.asOwned.aliasedMemory = std::move(memory);
+
+    Async::LockGuard g { AliveImagesAccess };
+    AliveImages.insert(this);
+}
+
+vk::MemoryRequirements Carrot::Image::getMemoryRequirements(Carrot::VulkanDriver& driver, vk::Extent3D extent, vk::ImageUsageFlags usage, vk::Format format) {
+    vk::UniqueImage image = driver.getLogicalDevice().createImageUnique(makeGraphicsOnlyCreateInfo(extent, usage, format), driver.getAllocationCallbacks());
+    return driver.getLogicalDevice().getImageMemoryRequirements(*image);
+}
+
 Carrot::Image::Image(Carrot::VulkanDriver& driver, vk::Image toView, vk::Extent3D extent, vk::Format format, std::uint32_t layerCount)
 : driver(driver), imageData(false), format(format), layerCount(layerCount), size(extent) {
     imageData.asView.vkImage = toView;
@@ -76,6 +111,10 @@ Carrot::Image::Image(Carrot::VulkanDriver& driver, vk::Image toView, vk::Extent3
 Carrot::Image::~Image() noexcept {
     if(imageData.ownsImage) {
         GetVulkanDriver().deferDestroy("-memory", std::move(imageData.asOwned.memory));
+        if(imageData.asOwned.aliasedMemory != nullptr && imageData.asOwned.aliasedMemory.use_count() == 1) {
+            // last user of the shared memory, GPU might still be using it
+            GetVulkanDriver().deferDestroy("-aliased-memory", std::move(*imageData.asOwned.aliasedMemory));
+        }
         GetVulkanDriver().deferDestroy("-image", std::move(imageData.asOwned.vkImage));
 
         Async::LockGuard g { AliveImagesAccess };
@@ -87,6 +126,10 @@ bool Carrot::Image::isOwned() const {
     return imageData.ownsImage;
 }
 
+bool Carrot::Image::isAliased() const {
+    return imageData.ownsImage && imageData.asOwned.aliasedMemory != nullptr;
+}
+
 const vk::Image& Carrot::Image::getVulkanImage() const {
     if(imageData.ownsImage) {
         return *imageData.asOwned.vkImage;
@@ -133,6 +176,148 @@ void Carrot::Image::stageUpload(std::span<uint8_t> data, uint32_t layer, uint32_
     transitionLayout(vk::Format::eR8G8B8A8Unorm, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal);
 }
 
+void Carrot::Image::stageMipsUpload(std::span<const std::span<const std::uint8_t>> mipData) {
+    verify(usage & vk::ImageUsageFlagBits::eTransferDst, "Cannot transfer to this image!");
+    verify(mipData.size() == mipLevels, "Data must be provided for all mips");
+    verify(layerCount == 1, "Only single layer images are supported");
+
+    vk::DeviceSize totalSize = 0;
+    for(const auto& mip : mipData) {
+        totalSize += mip.size();
+    }
+    auto stagingBuffer = Carrot::Buffer(driver,
+                                        totalSize,
+                                        vk::BufferUsageFlagBits::eTransferSrc,
+                                        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+                                        {driver.getQueueFamilies().transferFamily.value()});
+
+    stagingBuffer.setDebugNames("Image mips upload staging");
+
+    std::vector<vk::BufferImageCopy> regions;
+    regions.reserve(mipData.size());
+    vk::DeviceSize offset = 0;
+    for(std::uint32_t mip = 0; mip < mipData.size(); mip++) {
+        stagingBuffer.directUpload(mipData[mip].data(), mipData[mip].size(), offset);
+        regions.push_back(vk::BufferImageCopy {
+                .bufferOffset = offset,
+                .bufferRowLength = 0,
+                .bufferImageHeight = 0,
+                .imageSubresource = {
+                        .aspectMask = vk::ImageAspectFlagBits::eColor,
+                        .mipLevel = mip,
+                        .baseArrayLayer = 0,
+                        .layerCount = 1,
+                },
+                .imageExtent = {
+                        .width = std::max(1u, size.width >> mip),
+                        .height = std::max(1u, size.height >> mip),
+                        .depth = std::max(1u, size.depth >> mip),
+                },
+        });
+        offset += mipData[mip].size();
+    }
+
+    transitionLayout(format, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal);
+    driver.performSingleTimeTransferCommands([&](vk::CommandBuffer &commands) {
+        commands.copyBufferToImage(stagingBuffer.getVulkanBuffer(), getVulkanImage(),
+                                   vk::ImageLayout::eTransferDstOptimal, regions);
+    });
+    transitionLayout(format, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal);
+}
+
+std::unique_ptr<Carrot::Image> Carrot::Image::fromKTX2(Carrot::VulkanDriver& device, const Carrot::IO::Resource& resource, std::uint32_t firstMip, std::uint32_t maxSize, KTX2MipChain* outMipChain) {
+    ktxTexture2* texture;
+    KTX_error_code result;
+
+    std::unique_ptr<std::uint8_t[]> ktxData = resource.readAll();
+    std::size_t ktxDataSize = resource.getSize();
+
+    result = ktxTexture2_CreateFromMemory(ktxData.get(), ktxDataSize,
+                                          KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT,
+                                          &texture);
+
+    if(result != ktx_error_code_e::KTX_SUCCESS) {
+        throw std::runtime_error("Could not read KTX2 file: "+resource.getName() + " error is " +
+                                 ktxErrorString(result));
+    }
+    CLEANUP(ktxTexture_Destroy(ktxTexture(texture)));
+
+    vk::Format vkFormat = static_cast<vk::Format>(texture->vkFormat);
+
+    if (ktxTexture2_NeedsTranscoding(texture)) {
+        ktx_texture_transcode_fmt_e tf;
+
+        const vk::PhysicalDeviceFeatures& deviceFeatures = GetVulkanDriver().getPhysicalDeviceFeatures();
+        if (deviceFeatures.textureCompressionETC2) {
+            tf = KTX_TTF_ETC2_RGBA;
+            vkFormat = vk::Format::eEtc2R8G8B8A8UnormBlock;
+        } else if (deviceFeatures.textureCompressionBC) {
+            tf = KTX_TTF_BC3_RGBA;
+            vkFormat = vk::Format::eBc3UnormBlock;
+        } else {
+            throw std::runtime_error("Vulkan implementation does not support any available transcode target.");
+        }
+
+        result = ktxTexture2_TranscodeBasis(texture, tf, 0);
+        if(result != ktx_error_code_e::KTX_SUCCESS) {
+            throw std::runtime_error("Could not transcode KTX2 file: "+resource.getName() + " error is " +
+                                     ktxErrorString(result));
+        }
+    }
+
+    const std::uint32_t mipCount = std::max(1u, texture->numLevels);
+    firstMip = std::min(firstMip, mipCount - 1);
+    if(maxSize != 0) {
+        while(firstMip < mipCount - 1 && std::max(texture->baseWidth >> firstMip, texture->baseHeight >> firstMip) > maxSize) {
+            firstMip++;
+        }
+    }
+
+    if(outMipChain) {
+        outMipChain->baseExtent = vk::Extent3D {
+                .width = texture->baseWidth,
+                .height = texture->baseHeight,
+                .depth = texture->baseDepth,
+        };
+        outMipChain->mipCount = mipCount;
+        outMipChain->mipSizes.resize(mipCount);
+        for(std::uint32_t mip = 0; mip < mipCount; mip++) {
+            outMipChain->mipSizes[mip] = ktxTexture_GetImageSize(ktxTexture(texture), mip);
+        }
+    }
+
+    std::vector<std::span<const std::uint8_t>> mipData;
+    mipData.reserve(mipCount - firstMip);
+    for(std::uint32_t mip = firstMip; mip < mipCount; mip++) {
+        ktx_size_t offset;
+        result = ktxTexture_GetImageOffset(ktxTexture(texture), mip, 0, 0, &offset);
+        if(result != ktx_error_code_e::KTX_SUCCESS) {
+            throw std::runtime_error(resource.getName() + ", ktxTexture_GetImageOffset error is " +
+                                     ktxErrorString(result));
+        }
+        const std::uint8_t* pixelData = ktxTexture_GetData(ktxTexture(texture)) + offset;
+        mipData.emplace_back(pixelData, ktxTexture_GetImageSize(ktxTexture(texture), mip));
+    }
+
+    auto image = std::make_unique<Carrot::Image>(device,
+                                                 vk::Extent3D {
+                                                         .width = std::max(1u, texture->baseWidth >> firstMip),
+                                                         .height = std::max(1u, texture->baseHeight >> firstMip),
+                                                         .depth = std::max(1u, texture->baseDepth >> firstMip),
+                                                 },
+                                                 vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled/*TODO: customizable*/,
+                                                 vkFormat,
+                                                 std::set<std::uint32_t>{},
+                                                 static_cast<vk::ImageCreateFlags>(0),
+                                                 vk::ImageType::e2D,
+                                                 1,
+                                                 static_cast<std::uint32_t>(mipData.size()));
+
+    image->stageMipsUpload(mipData);
+    image->name(resource.getName());
+    return image;
+}
+
 std::unique_ptr<Carrot::Image> Carrot::Image::fromFile(Carrot::VulkanDriver& device, const Carrot::IO::Resource resource) {
     int width;
     int height;
@@ -216,70 +401,7 @@ std::unique_ptr<Carrot::Image> Carrot::Image::fromFile(Carrot::VulkanDriver& dev
 
             return std::move(image);
         } else if(format == IO::FileFormat::KTX2) {
-            ktxTexture2* texture;
-            KTX_error_code result;
-            {
-                std::unique_ptr<std::uint8_t[]> ktxData = resource.readAll();
-                std::size_t ktxDataSize = resource.getSize();
-
-                result = ktxTexture2_CreateFromMemory(ktxData.get(), ktxDataSize,
-                                                     KTX_TEXTURE_CREATE_NO_FLAGS,
-                                                     &texture);
-
-                if(result != ktx_error_code_e::KTX_SUCCESS) {
-                    throw std::runtime_error("Could not read KTX2 file: "+resource.getName() + " error is " +
-                                                     ktxErrorString(result));
-                }
-
-                vk::Format vkFormat = static_cast<vk::Format>(texture->vkFormat);
-
-                if (ktxTexture2_NeedsTranscoding(texture)) {
-                    ktx_texture_transcode_fmt_e tf;
-
-                    const vk::PhysicalDeviceFeatures& deviceFeatures = GetVulkanDriver().getPhysicalDeviceFeatures();
-                    if (deviceFeatures.textureCompressionETC2) {
-                        tf = KTX_TTF_ETC2_RGBA;
-                        vkFormat = vk::Format::eEtc2R8G8B8A8UnormBlock;
-                    } else if (deviceFeatures.textureCompressionBC) {
-                        tf = KTX_TTF_BC3_RGBA;
-                        vkFormat = vk::Format::eBc3UnormBlock;
-                    } else {
-                        throw std::runtime_error("Vulkan implementation does not support any available transcode target.");
-                    }
-
-                    result = ktxTexture2_TranscodeBasis(texture, tf, 0);
-                    if(result != ktx_error_code_e::KTX_SUCCESS) {
-                        throw std::runtime_error("Could not transcode KTX2 file: "+resource.getName() + " error is " +
-                                                 ktxErrorString(result));
-                    }
-                }
-
-                // TODO: Carrot only supports mip0 for now
-                ktx_size_t offset;
-                result = ktxTexture_GetImageOffset(ktxTexture(texture), 0, 0, 0, &offset);
-                if(result != ktx_error_code_e::KTX_SUCCESS) {
-                    throw std::runtime_error(resource.getName() + ", ktxTexture_GetImageOffset error is " +
-                                             ktxErrorString(result));
-                }
-
-                std::uint8_t* pixelData = ktxTexture_GetData(ktxTexture(texture)) + offset;
-
-                auto image = std::make_unique<Carrot::Image>(device,
-                                                             vk::Extent3D {
-                                                                     .width = texture->baseWidth,
-                                                                     .height = texture->baseHeight,
-                                                                     .depth = texture->baseDepth,
-                                                             },
-                                                             vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled/*TODO: customizable*/,
-                                                             vkFormat);
-
-                image->stageUpload(std::span<std::uint8_t>{pixelData, static_cast<std::size_t>(texture->dataSize) });
-                image->name(resource.getName());
-
-                ktxTexture_Destroy(ktxTexture(texture));
-
-                return image;
-            }
+            return fromKTX2(device, resource);
         } else {
             return loadThroughStbi();
         }
@@ -310,7 +432,7 @@ void Carrot::Image::transition(vk::Image image, vk::CommandBuffer& commands, vk:
             .subresourceRange = {
                     .aspectMask = aspect,
                     .baseMipLevel = 0,
-                    .levelCount = 1,
+                    .levelCount = VK_REMAINING_MIP_LEVELS,
                     .baseArrayLayer = 0,
                     .layerCount = static_cast<uint32_t>(layerCount),
             }
@@ -445,7 +567,7 @@ vk::UniqueImageView Carrot::Image::createImageView(vk::Format imageFormat, vk::I
 
 void Carrot::Image::setDebugNames(const std::string& name) {
     nameSingle(name, getVulkanImage());
-    if(imageData.ownsImage) {
+    if(imageData.ownsImage && !isAliased()) {
         imageData.asOwned.memory.name(name);
         nameSingle(name + " Memory", getVkMemory());
     }
@@ -537,11 +659,13 @@ vk::Format Carrot::Image::getFormat() const {
 }
 
 vk::DeviceMemory Carrot::Image::getVkMemory() const {
-    verify(imageData.ownsImage, "Cannot access memory of not-owned image.")
-    return imageData.asOwned.memory.getVulkanMemory();
+    return getMemory().getVulkanMemory();
 }
 
 const Carrot::DeviceMemory& Carrot::Image::getMemory() const {
     verify(imageData.ownsImage, "Cannot access memory of not-owned image.")
+    if(imageData.asOwned.aliasedMemory != nullptr) {
+        return *imageData.asOwned.aliasedMemory;
+    }
     return imageData.asOwned.memory;
 }
@@ -11,6 +11,7 @@
 #include <set>
 #include <functional>
 #include <unordered_set>
+#include <vector>
 #include <engine/render/Skybox.hpp>
 #include <core/io/Resource.h>
 #include <core/async/Locks.h>
@@ -29,6 +30,7 @@ namespace Carrot {
                 struct {
                     vk::UniqueImage vkImage = {};
                     Carrot::DeviceMemory memory = {};
+                    std::shared_ptr<Carrot::DeviceMemory> aliasedMemory = nullptr; // not null if memory is shared with other images
                 } asOwned;
 
                 struct {
@@ -47,6 +49,7 @@ namespace Carrot {
             ~ImageData() {
                 if(ownsImage) {
                     asOwned.memory = {};
+                    asOwned.aliasedMemory = nullptr;
                     asOwned.vkImage.reset();
                 }
             }
@@ -54,6 +57,7 @@ namespace Carrot {
         } imageData;
 
         std::uint32_t layerCount = 1;
+        std::uint32_t mipLevels = 1;
         vk::Format format = vk::Format::eUndefined;
         vk::ImageUsageFlags usage = static_cast<vk::ImageUsageFlags>(0);
 
@@ -70,7 +74,17 @@ namespace Carrot {
                        std::set<uint32_t> families = {},
                        vk::ImageCreateFlags flags = static_cast<vk::ImageCreateFlags>(0),
                        vk::ImageType type = vk::ImageType::e2D,
-                       std::uint32_t layerCount = 1);
+                       std::uint32_t layerCount = 1,
+                       std::uint32_t mipLevels = 1);
+
+        /// Creates a new empty image with the given parameters, bound at 'offset' inside 'memory' instead of allocating its own memory.
+        /// Used for memory aliasing of render graph transient images
+        explicit Image(Carrot::VulkanDriver& driver,
+                       vk::Extent3D extent,
+                       vk::ImageUsageFlags usage,
+                       vk::Format format,
+                       std::shared_ptr<Carrot::DeviceMemory> memory,
+                       vk::DeviceSize offset);
 
         explicit Image(Carrot::VulkanDriver& driver, vk::Image toView,
                        vk::Extent3D extent,
@@ -90,14 +104,24 @@ namespace Carrot {
         /// Only valid for owned images (ie created by the engine, not swapchain / external libs)
         const Carrot::DeviceMemory& getMemory() const;
 
+        /// Returns true iif this image is owned, but its memory belongs to someone else (see aliasing constructor)
+        bool isAliased() const;
+
+        /// Memory requirements of an image created with the given parameters (on the graphics queue only), without creating it
+        static vk::MemoryRequirements getMemoryRequirements(Carrot::VulkanDriver& driver, vk::Extent3D extent, vk::ImageUsageFlags usage, vk::Format format);
+
         const vk::Extent3D& getSize() const;
         vk::Format getFormat() const;
         std::uint32_t getLayerCount() const { return layerCount; }
+        std::uint32_t getMipLevels() const { return mipLevels; }
         VulkanDriver& getDriver() const { return driver; }
 
         /// Stage a upload to this image, and wait for the upload to finish.
         void stageUpload(std::span<std::uint8_t> data, std::uint32_t layer = 0, std::uint32_t layerCount = 1);
 
+        /// Stage a upload of all mips of this image (mipData[0] is mip 0), and wait for the upload to finish. Only for single layer images
+        void stageMipsUpload(std::span<const std::span<const std::uint8_t>> mipData);
+
         /// Transition the layout of this image from one layout to another
         void transitionLayout(vk::Format format, vk::ImageLayout oldLayout, vk::ImageLayout newLayout);
 
@@ -112,6 +136,19 @@ namespace Carrot {
         /// Create and fill an Image from a given image file
         static std::unique_ptr<Image> fromFile(Carrot::VulkanDriver& device, const Carrot::IO::Resource resource);
 
+        /// Mip chain of a KTX2 file, as it is stored in GPU memory
+        struct KTX2MipChain {
+            vk::Extent3D baseExtent{};
+            std::uint32_t mipCount = 0;
+            std::vector<std::uint64_t> mipSizes; // in bytes, after transcoding
+        };
+
+        /// Create and fill an Image with mips [firstMip; mipCount-1] of a KTX2 file. Mip 'firstMip' becomes mip 0 of the image.
+        /// 'firstMip' is clamped to the mip count of the file.
+        /// If 'maxSize' is not 0, mips larger than 'maxSize' on any axis are not loaded, even if they are after 'firstMip'.
+        /// Fills 'outMipChain' with the mip chain of the whole file if not null.
+        static std::unique_ptr<Image> fromKTX2(Carrot::VulkanDriver& device, const Carrot::IO::Resource& resource, std::uint32_t firstMip = 0, std::uint32_t maxSize = 0, KTX2MipChain* outMipChain = nullptr);
+
         static std::unique_ptr<Image> cubemapFromFiles(Carrot::VulkanDriver& device, std::function<std::string(Skybox::Direction)> textureSupplier);
 
     protected:
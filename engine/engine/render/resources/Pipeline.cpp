@@ -8,6 +8,7 @@
 #include "engine/render/resources/Buffer.h"
 #include <rapidjson/document.h>
 #include "core/io/IO.h"
+#include "engine/render/GBuffer.h"
 #include "engine/render/GBufferDrawData.h"
 #include "Vertex.h"
 #include "engine/render/MaterialSystem.h"
@@ -79,7 +80,10 @@ Carrot::Pipeline::Pipeline(Carrot::VulkanDriver& driver, const PipelineDescripti
 
 void Carrot::Pipeline::reloadShaders() {
     WaitDeviceIdle();
-    vkPipelines.clear(); // flush existing pipelines
+    {
+        Async::LockGuard l { vkPipelinesAccess };
+        vkPipelines.clear(); // flush existing pipelines
+    }
     stages->reload();
 
     std::vector<vk::DescriptorSetLayout> layouts{};
@@ -255,12 +259,14 @@ void Carrot::Pipeline::createGraphicsTemplate() {
         };
 
         if(description.type == PipelineType::Particles || description.type == PipelineType::GBuffer) {
-            // R32G32B32 position
-            graphicsPipelineTemplate.colorBlendAttachments.push_back(vk::PipelineColorBlendAttachmentState {
-                    .blendEnable = false,
+            // R32G32B32 position (reconstructed from depth with the packed layout)
+            if(Carrot::GBuffer::getLayout() == Carrot::GBuffer::Layout::Standard) {
+                graphicsPipelineTemplate.colorBlendAttachments.push_back(vk::PipelineColorBlendAttachmentState {
+                        .blendEnable = false,
 
-                    .colorWriteMask = vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA,
-            });
+                        .colorWriteMask = vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA,
+                });
+            }
             // R32G32B32 normals+tangents
             graphicsPipelineTemplate.colorBlendAttachments.push_back(vk::PipelineColorBlendAttachmentState {
                     .blendEnable = false,
@@ -313,7 +319,7 @@ void Carrot::Pipeline::createGraphicsTemplate() {
         }
     } else {
         graphicsPipelineTemplate.colorBlendAttachments = {
-                static_cast<std::size_t>(description.type == PipelineType::Particles || description.type == PipelineType::GBuffer ? 7 : 1),
+                static_cast<std::size_t>(description.type == PipelineType::Particles || description.type == PipelineType::GBuffer ? Carrot::GBuffer::getColorTargetCount(Carrot::GBuffer::getLayout()) : 1),
                 vk::PipelineColorBlendAttachmentState {
                         .blendEnable = false,
 
@@ -407,6 +413,7 @@ const vk::PushConstantRange& Carrot::Pipeline::getPushConstant(std::string_view
 }
 
 vk::Pipeline& Carrot::Pipeline::getOrCreatePipelineForRenderPass(vk::RenderPass pass) const {
+    Async::LockGuard l { vkPipelinesAccess };
     auto it = vkPipelines.find(pass);
     if(it == vkPipelines.end()) {
         if(description.type == PipelineType::Compute) {
@@ -694,6 +701,7 @@ void Carrot::Pipeline::onSwapchainSizeChange(Window& window, int newWidth, int n
 }
 
 void Carrot::Pipeline::setDebugNames(const std::string& name) {
+    Async::LockGuard l { vkPipelinesAccess };
     for(auto& [_, pPipeline] : vkPipelines) {
         DebugNameable::nameSingle(name, *pPipeline);
     }
@@ -713,14 +721,15 @@ Carrot::PipelineDescription::PipelineDescription(const Carrot::IO::Resource json
     if(json.HasMember("subpassIndex")) {
         subpassIndex = json["subpassIndex"].GetUint64();
     }
+    // shaders reading or writing the GBuffer have a variant for each GBuffer layout
     if(json.HasMember("vertexShader")) {
-        vertexShader = json["vertexShader"].GetString();
+        vertexShader = Carrot::GBuffer::getShaderVariant(json["vertexShader"].GetString());
     }
     if(json.HasMember("fragmentShader")) {
-        fragmentShader = json["fragmentShader"].GetString();
+        fragmentShader = Carrot::GBuffer::getShaderVariant(json["fragmentShader"].GetString());
     }
     if(json.HasMember("computeShader")) {
-        computeShader = json["computeShader"].GetString();
+        computeShader = Carrot::GBuffer::getShaderVariant(json["computeShader"].GetString());
     }
     if(json.HasMember("taskShader")) {
         taskShader = json["taskShader"].GetString();
@@ -10,6 +10,7 @@
 #include "VertexFormat.h"
 #include "engine/render/shaders/ShaderSource.h"
 #include <core/utils/Lookup.hpp>
+#include <core/async/Locks.h>
 
 namespace Carrot {
     class Material;
@@ -190,6 +191,7 @@ namespace Carrot {
 
         PipelineDescription description;
         mutable std::unordered_map<vk::RenderPass, vk::UniquePipeline> vkPipelines{};
+        mutable Async::SpinLock vkPipelinesAccess; // protects vkPipelines, pipelines are created on first use with a given render pass
 
         mutable std::unordered_map<std::string, vk::PushConstantRange> pushConstantMap{};
     };
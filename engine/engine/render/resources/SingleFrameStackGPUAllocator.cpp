@@ -28,11 +28,15 @@ namespace Carrot {
     }
 
     Carrot::BufferView SingleFrameStackGPUAllocator::RingBuffer::allocateAligned(std::size_t index, vk::DeviceSize size, vk::DeviceSize align) {
-        vk::DeviceSize location = Carrot::Math::alignUp(stackPointers[index], align);
+        vk::DeviceSize location;
+        {
+            Async::LockGuard l { stackPointersAccess };
+            location = Carrot::Math::alignUp(stackPointers[index], align);
 
-        verify(location+size <= bufferSize, "Out of memory");
+            verify(location+size <= bufferSize, "Out of memory");
 
-        stackPointers[index] = location + size;
+            stackPointers[index] = location + size;
+        }
         return Carrot::BufferView(nullptr, *stacks[index], location, size);
     }
 
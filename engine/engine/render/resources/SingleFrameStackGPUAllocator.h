@@ -4,6 +4,7 @@
 
 #pragma once
 #include <memory>
+#include <core/async/Locks.h>
 #include <engine/vulkan/SwapchainAware.h>
 #include <engine/render/resources/BufferView.h>
 
@@ -33,6 +34,7 @@ namespace Carrot {
 
             std::vector<std::unique_ptr<Carrot::Buffer>> stacks;
             std::vector<vk::DeviceSize> stackPointers;
+            Async::SpinLock stackPointersAccess; // protects stackPointers, bumped by each allocation
         };
 
     public:
@@ -13,6 +13,10 @@ namespace Carrot {
     public:
         template<typename VertexType>
         explicit SingleMesh(const std::vector<VertexType>& vertices, const std::vector<uint32_t>& indices);
+
+        /// Vertices and indices are only read during the construction, they can point to a memory-mapped file for instance
+        template<typename VertexType>
+        explicit SingleMesh(std::span<const VertexType> vertices, std::span<const std::uint32_t> indices);
         ~SingleMesh();
 
         Carrot::Buffer& getBackingBuffer();
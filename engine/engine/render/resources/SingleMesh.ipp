@@ -2,7 +2,10 @@
 #include "SingleMesh.h"
 
 template<typename VertexType>
-Carrot::SingleMesh::SingleMesh(const std::vector<VertexType>& vertices, const std::vector<std::uint32_t>& indices): Carrot::Mesh::Mesh() {
+Carrot::SingleMesh::SingleMesh(const std::vector<VertexType>& vertices, const std::vector<std::uint32_t>& indices): SingleMesh(std::span<const VertexType>(vertices), std::span<const std::uint32_t>(indices)) {}
+
+template<typename VertexType>
+Carrot::SingleMesh::SingleMesh(std::span<const VertexType> vertices, std::span<const std::uint32_t> indices): Carrot::Mesh::Mesh() {
     sizeofVertex = sizeof(VertexType);
     const auto& queueFamilies = GetVulkanDriver().getQueueFamilies();
     // create and allocate underlying buffer
@@ -26,5 +29,5 @@ Carrot::SingleMesh::SingleMesh(const std::vector<VertexType>& vertices, const st
                                                             families);
 
     // upload vertices
-    vertexAndIndexBuffer->stageUploadWithOffsets(std::make_pair(vertexStartOffset, std::span(vertices)), std::make_pair(static_cast<uint64_t>(0), std::span(indices)));
+    vertexAndIndexBuffer->stageUploadWithOffsets(std::make_pair(vertexStartOffset, vertices), std::make_pair(static_cast<uint64_t>(0), indices));
 }
\ No newline at end of file
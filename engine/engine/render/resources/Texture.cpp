@@ -47,6 +47,10 @@ namespace Carrot::Render {
         currentLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
     }
 
+    Texture::Texture(std::unique_ptr<Carrot::Image>&& image, const Resource& originatingResource): Texture(std::move(image)) {
+        resource = originatingResource;
+    }
+
     Texture::~Texture() {
         for(auto& [k, imageView] : views) {
             GetVulkanDriver().deferDestroy("-imageview", std::move(imageView));
@@ -82,6 +86,19 @@ namespace Carrot::Render {
         currentLayout = newLayout;
     }
 
+    void Texture::replaceImage(std::unique_ptr<Carrot::Image>&& newImage) {
+        verify(newImage, "Cannot replace with an empty image");
+        Async::LockGuard l { viewsAccess };
+        for(auto& [k, imageView] : views) {
+            GetVulkanDriver().deferDestroy("-imageview", std::move(imageView));
+        }
+        views.clear();
+
+        image = std::move(newImage); // old image is destroyed once the GPU no longer uses it
+        imageFormat = image->getFormat();
+        currentLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+    }
+
     const vk::Image& Texture::getVulkanImage() const {
         return getImage().getVulkanImage();
     }
@@ -103,6 +120,7 @@ namespace Carrot::Render {
     }
 
     const vk::ImageView& Texture::getView(vk::Format format, vk::ImageAspectFlags aspect, vk::ImageViewType viewType) const {
+        Async::LockGuard l { viewsAccess };
         auto& view = views[{format, aspect}];
 
         if(!view) {
@@ -130,7 +148,7 @@ namespace Carrot::Render {
         vk::ImageSubresourceRange wholeTexture {
                 .aspectMask = aspect,
                 .baseMipLevel = 0,
-                .levelCount = 1,
+                .levelCount = VK_REMAINING_MIP_LEVELS,
                 .baseArrayLayer = 0,
                 .layerCount = image->getLayerCount(),
         };
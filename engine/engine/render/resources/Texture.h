@@ -9,6 +9,7 @@
 #include "Image.h"
 #include "core/io/Resource.h"
 #include "core/io/FileFormats.h"
+#include <core/async/Locks.h>
 #include <glm/glm.hpp>
 
 namespace sol {
@@ -59,6 +60,9 @@ namespace Carrot::Render {
         /// Create a texture from a Carrot::Image unique_ptr. Owns the image
         explicit Texture(std::unique_ptr<Carrot::Image>&& image);
 
+        /// Create a texture from a Carrot::Image unique_ptr, loaded from 'originatingResource'. Owns the image
+        explicit Texture(std::unique_ptr<Carrot::Image>&& image, const Resource& originatingResource);
+
         ~Texture();
 
     public:
@@ -82,6 +86,12 @@ namespace Carrot::Render {
         /// Changes the internal tracked layout. Can be used if layout changes without a call to "transitionNow" or "transitionInline"
         void assumeLayout(vk::ImageLayout newLayout);
 
+        /// Replaces the image of this texture, for instance when texture streaming changes which mips are resident.
+        /// The new image must be ready for shader reads. Existing views are destroyed once the GPU no longer uses them,
+        /// users of this texture will see the new image the next time they call getView.
+        /// Must not be called while other threads use this texture
+        void replaceImage(std::unique_ptr<Carrot::Image>&& newImage);
+
     public:
         void clear(vk::CommandBuffer& cmds, vk::ClearValue clearValue = vk::ClearColorValue(std::array{0.0f,0.0f,0.0f,0.0f}), vk::ImageAspectFlags aspect = vk::ImageAspectFlagBits::eColor);
 
@@ -115,6 +125,7 @@ namespace Carrot::Render {
         Carrot::VulkanDriver& driver;
         std::unique_ptr<Carrot::Image> image = nullptr;
         mutable std::unordered_map<FormatAspectPair, vk::UniqueImageView, HashFormatAspectPair> views{};
+        mutable Async::SpinLock viewsAccess; // protects 'views', image views are created on first use with a given format and aspect
         vk::ImageLayout currentLayout = vk::ImageLayout::eUndefined;
         vk::Format imageFormat = vk::Format::eUndefined;
         Carrot::IO::Resource resource; // resource from which this texture comes. Used for serialisation
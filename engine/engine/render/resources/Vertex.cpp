@@ -93,6 +93,62 @@ std::vector<vk::VertexInputBindingDescription> Carrot::getVertexBindingDescripti
     };
 }
 
+std::vector<vk::VertexInputAttributeDescription> Carrot::getVertexWithCompactInstanceDataAttributeDescriptions() {
+    std::vector<vk::VertexInputAttributeDescription> descriptions = getVertexAttributeDescriptions();
+    descriptions.resize(11); // same per-vertex attributes
+
+    descriptions[5] = {
+            .location = 5,
+            .binding = 1,
+            .format = vk::Format::eR32G32B32A32Sfloat,
+            .offset = static_cast<uint32_t>(offsetof(CompactInstanceData, color)),
+    };
+
+    for (int i = 0; i < 3; ++i) {
+        descriptions[6+i] = {
+                .location = static_cast<uint32_t>(6+i),
+                .binding = 1,
+                .format = vk::Format::eR32G32B32A32Sfloat,
+                .offset = static_cast<uint32_t>(offsetof(CompactInstanceData, transform)+sizeof(glm::vec4)*i),
+        };
+    }
+
+    descriptions[9] = {
+            .location = 9,
+            .binding = 1,
+            .format = vk::Format::eR32Uint,
+            .offset = static_cast<uint32_t>(offsetof(CompactInstanceData, previousTransformSlot)),
+    };
+
+    descriptions[10] = {
+            .location = 10,
+            .binding = 2,
+            .format = vk::Format::eR32G32B32A32Uint,
+            .offset = static_cast<uint32_t>(offsetof(PickingInstanceData, uuid)),
+    };
+
+    return descriptions;
+}
+
+std::vector<vk::VertexInputBindingDescription> Carrot::getVertexWithCompactInstanceDataBindingDescription() {
+    return {vk::VertexInputBindingDescription {
+                    .binding = 0,
+                    .stride = sizeof(Vertex),
+                    .inputRate = vk::VertexInputRate::eVertex,
+            },
+            vk::VertexInputBindingDescription {
+                    .binding = 1,
+                    .stride = sizeof(CompactInstanceData),
+                    .inputRate = vk::VertexInputRate::eInstance,
+            },
+            vk::VertexInputBindingDescription {
+                    .binding = 2,
+                    .stride = sizeof(PickingInstanceData),
+                    .inputRate = vk::VertexInputRate::eInstance,
+            },
+    };
+}
+
 std::vector<vk::VertexInputAttributeDescription> Carrot::getComputeSkinnedVertexAttributeDescriptions() {
     std::vector<vk::VertexInputAttributeDescription> descriptions{14};
 
@@ -484,4 +540,126 @@ std::vector<vk::VertexInputBindingDescription> Carrot::getInstanceDataOnlyBindin
                     .inputRate = vk::VertexInputRate::eInstance,
             },
     };
-}
\ No newline at end of file
+}
+std::vector<vk::VertexInputAttributeDescription> Carrot::getGlyphInstanceAttributeDescriptions() {
+    std::vector<vk::VertexInputAttributeDescription> descriptions{9};
+
+    descriptions[0] = {
+            .location = 0,
+            .binding = 0,
+            .format = vk::Format::eR32G32B32Sfloat,
+            .offset = static_cast<uint32_t>(offsetof(SimpleVertexWithInstanceData, pos)),
+    };
+
+    descriptions[1] = {
+            .location = 1,
+            .binding = 1,
+            .format = vk::Format::eR32G32B32A32Sfloat,
+            .offset = static_cast<uint32_t>(offsetof(GlyphInstanceData, color)),
+    };
+
+    descriptions[2] = {
+            .location = 2,
+            .binding = 1,
+            .format = vk::Format::eR32G32B32A32Uint,
+            .offset = static_cast<uint32_t>(offsetof(GlyphInstanceData, uuid)),
+    };
+
+    for (int i = 0; i < 4; ++i) {
+        descriptions[3+i] = {
+                .location = static_cast<uint32_t>(3+i),
+                .binding = 1,
+                .format = vk::Format::eR32G32B32A32Sfloat,
+                .offset = static_cast<uint32_t>(offsetof(GlyphInstanceData, transform)+sizeof(glm::vec4)*i),
+        };
+    }
+
+    descriptions[7] = {
+            .location = 7,
+            .binding = 1,
+            .format = vk::Format::eR32G32B32A32Sfloat,
+            .offset = static_cast<uint32_t>(offsetof(GlyphInstanceData, glyphRect)),
+    };
+
+    descriptions[8] = {
+            .location = 8,
+            .binding = 1,
+            .format = vk::Format::eR32G32B32A32Sfloat,
+            .offset = static_cast<uint32_t>(offsetof(GlyphInstanceData, texelRect)),
+    };
+
+    return descriptions;
+}
+
+std::vector<vk::VertexInputBindingDescription> Carrot::getGlyphInstanceBindingDescription() {
+    return {
+            vk::VertexInputBindingDescription {
+                    .binding = 0,
+                    .stride = sizeof(SimpleVertexWithInstanceData),
+                    .inputRate = vk::VertexInputRate::eVertex,
+            },
+            vk::VertexInputBindingDescription {
+                    .binding = 1,
+                    .stride = sizeof(GlyphInstanceData),
+                    .inputRate = vk::VertexInputRate::eInstance,
+            },
+    };
+}
+
+std::vector<vk::VertexInputAttributeDescription> Carrot::getSpriteInstanceAttributeDescriptions() {
+    std::vector<vk::VertexInputAttributeDescription> descriptions{7};
+
+    descriptions[0] = {
+            .location = 0,
+            .binding = 0,
+            .format = vk::Format::eR32G32B32Sfloat,
+            .offset = static_cast<uint32_t>(offsetof(SimpleVertexWithInstanceData, pos)),
+    };
+
+    descriptions[1] = {
+            .location = 1,
+            .binding = 1,
+            .format = vk::Format::eR8G8B8A8Unorm,
+            .offset = static_cast<uint32_t>(offsetof(SpriteInstanceData, color)),
+    };
+
+    descriptions[2] = {
+            .location = 2,
+            .binding = 1,
+            .format = vk::Format::eR32G32B32A32Uint,
+            .offset = static_cast<uint32_t>(offsetof(SpriteInstanceData, uuid)),
+    };
+
+    for (int i = 0; i < 3; ++i) {
+        descriptions[3+i] = {
+                .location = static_cast<uint32_t>(3+i),
+                .binding = 1,
+                .format = vk::Format::eR32G32B32A32Sfloat,
+                .offset = static_cast<uint32_t>(offsetof(SpriteInstanceData, transform)+sizeof(glm::vec4)*i),
+        };
+    }
+
+    descriptions[6] = {
+            .location = 6,
+            .binding = 1,
+            .format = vk::Format::eR32G32B32A32Sfloat,
+            .offset = static_cast<uint32_t>(offsetof(SpriteInstanceData, uvRect)),
+    };
+
+    return descriptions;
+}
+
+std::vector<vk::VertexInputBindingDescription> Carrot::getSpriteInstanceBindingDescription() {
+    return {
+            vk::VertexInputBindingDescription {
+                    .binding = 0,
+                    .stride = sizeof(SimpleVertexWithInstanceData),
+                    .inputRate = vk::VertexInputRate::eVertex,
+            },
+            vk::VertexInputBindingDescription {
+                    .binding = 1,
+                    .stride = sizeof(SpriteInstanceData),
+                    .inputRate = vk::VertexInputRate::eInstance,
+            },
+    };
+}
@@ -10,6 +10,9 @@ namespace Carrot {
     std::vector<vk::VertexInputAttributeDescription> getVertexAttributeDescriptions();
     std::vector<vk::VertexInputBindingDescription> getVertexBindingDescription();
 
+    std::vector<vk::VertexInputAttributeDescription> getVertexWithCompactInstanceDataAttributeDescriptions();
+    std::vector<vk::VertexInputBindingDescription> getVertexWithCompactInstanceDataBindingDescription();
+
     std::vector<vk::VertexInputAttributeDescription> getComputeSkinnedVertexAttributeDescriptions();
     std::vector<vk::VertexInputBindingDescription> getComputeSkinnedVertexBindingDescription();
 
@@ -33,4 +36,10 @@ namespace Carrot {
 
     std::vector<vk::VertexInputAttributeDescription> getInstanceDataOnlyAttributeDescriptions();
     std::vector<vk::VertexInputBindingDescription> getInstanceDataOnlyBindingDescription();
+
+    std::vector<vk::VertexInputAttributeDescription> getGlyphInstanceAttributeDescriptions();
+    std::vector<vk::VertexInputBindingDescription> getGlyphInstanceBindingDescription();
+
+    std::vector<vk::VertexInputAttributeDescription> getSpriteInstanceAttributeDescriptions();
+    std::vector<vk::VertexInputBindingDescription> getSpriteInstanceBindingDescription();
 }
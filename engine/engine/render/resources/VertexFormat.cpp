@@ -9,6 +9,8 @@
 Carrot::VertexFormat Carrot::getVertexFormat(const std::string& name) {
     if(name == "Vertex") {
         return VertexFormat::Vertex;
+    } else if(name == "VertexWithCompactInstanceData") {
+        return VertexFormat::VertexWithCompactInstanceData;
     } else if(name == "SkinnedVertex") {
         return VertexFormat::SkinnedVertex;
     } else if(name == "ComputeSkinnedVertex") {
@@ -25,6 +27,10 @@ Carrot::VertexFormat Carrot::getVertexFormat(const std::string& name) {
         return VertexFormat::ImGuiVertex;
     } else if(name == "InstanceDataOnly") {
         return VertexFormat::InstanceDataOnly;
+    } else if(name == "GlyphInstance") {
+        return VertexFormat::GlyphInstance;
+    } else if(name == "SpriteInstance") {
+        return VertexFormat::SpriteInstance;
     }
     return Carrot::VertexFormat::Invalid;
 }
@@ -33,6 +39,8 @@ std::vector<vk::VertexInputBindingDescription> Carrot::getBindingDescriptions(Ca
     switch(vertexFormat) {
         case VertexFormat::Vertex:
             return Carrot::getVertexBindingDescription();
+        case VertexFormat::VertexWithCompactInstanceData:
+            return Carrot::getVertexWithCompactInstanceDataBindingDescription();
         case VertexFormat::SkinnedVertex:
             return Carrot::getSkinnedVertexBindingDescription();
 
@@ -57,6 +65,12 @@ std::vector<vk::VertexInputBindingDescription> Carrot::getBindingDescriptions(Ca
         case VertexFormat::InstanceDataOnly:
             return Carrot::getInstanceDataOnlyBindingDescription();
 
+        case VertexFormat::GlyphInstance:
+            return Carrot::getGlyphInstanceBindingDescription();
+
+        case VertexFormat::SpriteInstance:
+            return Carrot::getSpriteInstanceBindingDescription();
+
         default:
             throw std::runtime_error("Invalid vertex format!");
     }
@@ -67,6 +81,9 @@ std::vector<vk::VertexInputAttributeDescription> Carrot::getAttributeDescription
         case VertexFormat::Vertex:
             return Carrot::getVertexAttributeDescriptions();
 
+        case VertexFormat::VertexWithCompactInstanceData:
+            return Carrot::getVertexWithCompactInstanceDataAttributeDescriptions();
+
         case VertexFormat::SkinnedVertex:
             return Carrot::getSkinnedVertexAttributeDescriptions();
 
@@ -91,6 +108,12 @@ std::vector<vk::VertexInputAttributeDescription> Carrot::getAttributeDescription
         case VertexFormat::InstanceDataOnly:
             return Carrot::getInstanceDataOnlyAttributeDescriptions();
 
+        case VertexFormat::GlyphInstance:
+            return Carrot::getGlyphInstanceAttributeDescriptions();
+
+        case VertexFormat::SpriteInstance:
+            return Carrot::getSpriteInstanceAttributeDescriptions();
+
         default:
             throw std::runtime_error("Invalid vertex format!");
     }
@@ -9,6 +9,7 @@
 namespace Carrot {
     enum class VertexFormat {
         Vertex,
+        VertexWithCompactInstanceData,
         SkinnedVertex,
         ScreenSpace,
         ComputeSkinnedVertex,
@@ -17,6 +18,8 @@ namespace Carrot {
         Particle,
         ImGuiVertex,
         InstanceDataOnly,
+        GlyphInstance,
+        SpriteInstance,
         Invalid
     };
 
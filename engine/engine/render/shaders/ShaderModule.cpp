@@ -2,15 +2,13 @@
 // Created by jglrxavpok on 30/11/2020.
 //
 
-#include <spirv_cross.hpp>
-#include <spirv_glsl.hpp>
-#include <spirv_reflect.hpp>
 #include "ShaderModule.h"
 #include "core/io/IO.h"
 #include <iostream>
 #include "engine/render/NamedBinding.h"
 #include "engine/utils/Macros.h"
 #include "core/io/Logging.hpp"
+#include "core/utils/stringmanip.h"
 
 static Carrot::Log::Category category { "Shader" };
 
@@ -19,18 +17,29 @@ Carrot::ShaderModule::ShaderModule(Carrot::VulkanDriver& driver, const Render::S
     reload();
 }
 
+/// Reflection baked by shadercompiler next to the shader, if it exists and matches the code. Otherwise, reflects the code with SPIRV-Cross
+static ShaderCompiler::Reflection loadReflection(const Carrot::Render::ShaderSource& source, std::span<const std::uint8_t> code) {
+    const std::vector<std::uint8_t> sidecar = source.getReflectionData();
+    if(!sidecar.empty()) {
+        try {
+            ShaderCompiler::Reflection reflection = ShaderCompiler::Reflection::deserialise(sidecar);
+            if(reflection.codeHash == ShaderCompiler::Reflection::hashCode(code)) {
+                return reflection;
+            }
+            Carrot::Log::warn(category, "Reflection of shader %s is outdated, falling back to runtime reflection", source.getName().c_str());
+        } catch(const std::runtime_error& e) {
+            Carrot::Log::warn(category, "Invalid reflection for shader %s, falling back to runtime reflection: %s", source.getName().c_str(), e.what());
+        }
+    }
+    return ShaderCompiler::Reflection::fromSPIRV(code);
+}
+
 void Carrot::ShaderModule::reload() {
     Carrot::Log::info(category, "Loading shader %s", source.getName().c_str());
     auto code = source.getCode();
     auto& device = driver.getLogicalDevice();
 
-    std::vector<std::uint32_t> asWords;
-    asWords.resize(code.size() / sizeof(std::uint32_t));
-    std::memcpy(asWords.data(), code.data(), code.size());
-    spirv_cross::Parser parser(std::move(asWords));
-    parser.parse();
-
-    compiler = std::make_unique<spirv_cross::CompilerReflection>(std::move(parser.get_parsed_ir()));
+    reflection = loadReflection(source, code);
 
     vkModule = device.createShaderModuleUnique(vk::ShaderModuleCreateInfo{
             .codeSize = static_cast<uint32_t>(code.size()),
@@ -49,61 +58,44 @@ vk::PipelineShaderStageCreateInfo Carrot::ShaderModule::createPipelineShaderStag
     };
 }
 
-void Carrot::ShaderModule::addBindingsSet(vk::ShaderStageFlagBits stage, std::uint32_t setID, std::vector<NamedBinding>& bindings, const std::map<std::string, std::uint32_t>& constants) {
-    const auto resources = compiler->get_shader_resources();
-
-    // buffers
-    createBindingsSet(stage, setID, bindings, vk::DescriptorType::eUniformBuffer, resources.uniform_buffers, constants);
-
-    // samplers
-    createBindingsSet(stage, setID, bindings, vk::DescriptorType::eSampler, resources.separate_samplers, constants);
-
-    // sampled images
-    createBindingsSet(stage, setID, bindings, vk::DescriptorType::eCombinedImageSampler, resources.sampled_images, constants);
-    createBindingsSet(stage, setID, bindings, vk::DescriptorType::eSampledImage, resources.separate_images, constants);
-
-
-    createBindingsSet(stage, setID, bindings, vk::DescriptorType::eInputAttachment, resources.subpass_inputs, constants);
-
-
-    createBindingsSet(stage, setID, bindings, vk::DescriptorType::eStorageBuffer, resources.storage_buffers, constants);
-    createBindingsSet(stage, setID, bindings, vk::DescriptorType::eStorageImage, resources.storage_images, constants);
-
-    createBindingsSet(stage, setID, bindings, vk::DescriptorType::eAccelerationStructureKHR, resources.acceleration_structures, constants);
-    //createBindingsSet0(stage, bindings, vk::DescriptorType::eAccelerationStructureNV, resources.acceleration_structures, constants);
+static vk::DescriptorType toVulkan(ShaderCompiler::ResourceType type) {
+    switch(type) {
+        case ShaderCompiler::ResourceType::UniformBuffer:
+            return vk::DescriptorType::eUniformBuffer;
+        case ShaderCompiler::ResourceType::Sampler:
+            return vk::DescriptorType::eSampler;
+        case ShaderCompiler::ResourceType::CombinedImageSampler:
+            return vk::DescriptorType::eCombinedImageSampler;
+        case ShaderCompiler::ResourceType::SampledImage:
+            return vk::DescriptorType::eSampledImage;
+        case ShaderCompiler::ResourceType::InputAttachment:
+            return vk::DescriptorType::eInputAttachment;
+        case ShaderCompiler::ResourceType::StorageBuffer:
+            return vk::DescriptorType::eStorageBuffer;
+        case ShaderCompiler::ResourceType::StorageImage:
+            return vk::DescriptorType::eStorageImage;
+        case ShaderCompiler::ResourceType::AccelerationStructure:
+            return vk::DescriptorType::eAccelerationStructureKHR;
 
-    // TODO: other types
+        default:
+            verify(false, Carrot::sprintf("Unsupported shader resource type: %u", static_cast<std::uint32_t>(type)));
+            return vk::DescriptorType::eUniformBuffer;
+    }
 }
 
-void Carrot::ShaderModule::createBindingsSet(vk::ShaderStageFlagBits stage,
-                                             std::uint32_t setID,
-                                             std::vector<NamedBinding>& bindings,
-                                             vk::DescriptorType type,
-                                             const spirv_cross::SmallVector<spirv_cross::Resource>& resources,
-                                             const std::map<std::string, std::uint32_t>& constants) {
-    for(const auto& resource : resources) {
-        const auto bindingID = compiler->get_decoration(resource.id, spv::DecorationBinding);
-        const auto& resourceType = compiler->get_type(resource.type_id);
-        const auto setIndex = compiler->get_decoration(resource.id, spv::DecorationDescriptorSet);
-        if(setIndex != setID) {
+void Carrot::ShaderModule::addBindingsSet(vk::ShaderStageFlagBits stage, std::uint32_t setID, std::vector<NamedBinding>& bindings, const std::map<std::string, std::uint32_t>& constants) {
+    for(const auto& resource : reflection.resources) {
+        if(resource.set != setID) {
             continue;
         }
-        uint32_t count = 1;
-        if(!resourceType.array.empty()) {
-            bool isLiteralLength = resourceType.array_size_literal[0];
-            if(isLiteralLength) {
-                count = resourceType.array[0];
-            } else {
-                // resolve specialization constant value
-                uint32_t varId = resourceType.array[0];
-                const auto& constant = compiler->get_constant(varId);
-                const std::string& constantName = compiler->get_name(varId);
-                auto it = constants.find(constantName);
-                if(it != constants.end()) {
-                    count = it->second;
-                } else {
-                    count = constant.scalar(); // default value
-                }
+        const auto bindingID = resource.binding;
+        const vk::DescriptorType type = toVulkan(resource.type);
+        uint32_t count = resource.count;
+        if(!resource.countConstant.empty()) {
+            // resolve specialization constant value
+            auto it = constants.find(resource.countConstant);
+            if(it != constants.end()) {
+                count = it->second;
             }
         }
         NamedBinding bindingToAdd = {vk::DescriptorSetLayoutBinding {
@@ -132,48 +124,12 @@ void Carrot::ShaderModule::createBindingsSet(vk::ShaderStageFlagBits stage,
     }
 }
 
-static std::uint64_t computeTypeSize(const spirv_cross::Compiler& compiler, const spirv_cross::SPIRType& type) {
-    switch(type.basetype) {
-        case spirv_cross::SPIRType::Struct: {
-            std::uint32_t size = 0;
-            for(const auto& t : type.member_types) {
-                auto& memberType = compiler.get_type(t);
-                size += computeTypeSize(compiler, memberType);
-            }
-            return size;
-        }
-
-        case spirv_cross::SPIRType::Float:
-        case spirv_cross::SPIRType::UInt:
-        case spirv_cross::SPIRType::Int:
-            return 4 * type.vecsize;
-
-        case spirv_cross::SPIRType::UInt64:
-        case spirv_cross::SPIRType::Int64:
-        case spirv_cross::SPIRType::Double:
-            return 8 * type.vecsize;
-
-        default:
-            TODO
-    }
-}
-
 void Carrot::ShaderModule::addPushConstants(vk::ShaderStageFlagBits stage, std::unordered_map<std::string, vk::PushConstantRange>& pushConstants) const {
-    const auto resources = compiler->get_shader_resources();
-
-    if(resources.push_constant_buffers.size() == 0)
+    if(!reflection.pushConstants.has_value())
         return;
-    std::uint32_t offset = std::numeric_limits<std::uint32_t>::max();
-    std::uint32_t size = 0;
-    const auto& pushConstant = resources.push_constant_buffers[0];
-    const auto& ranges = compiler->get_active_buffer_ranges(pushConstant.id);
-    std::string name = pushConstant.name;
-    const auto& resourceType = compiler->get_type(pushConstant.type_id);
-
-    for(const auto& r : ranges) {
-        offset = std::min(static_cast<std::uint32_t>(r.offset), offset);
-        size = std::max(static_cast<std::uint32_t>(r.offset+r.range), size);
-    }
+    const std::string& name = reflection.pushConstants->name;
+    const std::uint32_t offset = reflection.pushConstants->offset;
+    const std::uint32_t size = reflection.pushConstants->size;
 
     if(pushConstants.contains(name)) {
         auto& existingRange = pushConstants.at(name);
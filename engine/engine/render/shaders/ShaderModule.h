@@ -4,14 +4,13 @@
 
 #pragma once
 
-#include <spirv_cross.hpp>
-#include <spirv_parser.hpp>
 #include <string>
 #include "engine/vulkan/VulkanDriver.h"
 #include <map>
 #include <engine/render/shaders/Specialization.h>
 #include <engine/render/NamedBinding.h>
 #include <core/io/Resource.h>
+#include <core/data/ShaderReflection.h>
 #include "engine/render/shaders/ShaderSource.h"
 #include <span>
 
@@ -41,19 +40,10 @@ namespace Carrot {
         Carrot::VulkanDriver& driver;
         vk::UniqueShaderModule vkModule{};
         std::string entryPoint = "main";
-        spirv_cross::ParsedIR parsedCode{};
-        std::unique_ptr<spirv_cross::Compiler> compiler = nullptr;
+        ShaderCompiler::Reflection reflection; // baked by shadercompiler if available, reflected at runtime otherwise
         std::map<std::uint32_t, Binding> bindingMap{};
         Render::ShaderSource source;
 
-        void
-        createBindingsSet(vk::ShaderStageFlagBits stage,
-                          std::uint32_t setID,
-                          std::vector<NamedBinding>& bindings,
-                          vk::DescriptorType type,
-                          const spirv_cross::SmallVector<spirv_cross::Resource>& resources,
-                          const std::map<std::string, uint32_t>& constants);
-
         void reload();
 
         friend class ShaderStages;
@@ -4,6 +4,7 @@
 
 #include "ShaderSource.h"
 #include "core/data/ShaderMetadata.h"
+#include "core/data/ShaderReflection.h"
 #include "engine/utils/Macros.h"
 #include "core/io/IO.h"
 #include "core/io/Logging.hpp"
@@ -92,6 +93,23 @@ namespace Carrot::Render {
         }
     }
 
+    std::vector<std::uint8_t> ShaderSource::getReflectionData() const {
+        if(!fromFile) {
+            return {};
+        }
+        const std::filesystem::path sidecarPath = ShaderCompiler::Reflection::getSidecarPath(filepath);
+        try {
+            Carrot::IO::Resource resource(sidecarPath.string());
+            std::vector<std::uint8_t> data;
+            data.resize(resource.getSize());
+            resource.readAll(data.data());
+            return data;
+        } catch(const std::filesystem::filesystem_error&) {
+            // shader compiled before sidecars existed
+            return {};
+        }
+    }
+
     std::string ShaderSource::getName() const {
         if(!fromFile) {
             return "<<from memory>>";
@@ -19,6 +19,10 @@ namespace Carrot::Render {
         ShaderSource(const ShaderSource& toCopy);
 
         std::vector<std::uint8_t> getCode() const;
+
+        /// Contents of the reflection sidecar baked by shadercompiler next to the shader (see ShaderCompiler::Reflection).
+        /// Empty if there is none, which is always the case for shaders from memory
+        std::vector<std::uint8_t> getReflectionData() const;
         std::string getName() const;
 
         ShaderSource& operator=(const ShaderSource& toCopy) = default;
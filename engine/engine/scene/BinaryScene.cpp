@@ -0,0 +1,372 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "BinaryScene.h"
+
+#include <core/utils/Assert.h>
+#include <core/utils/stringmanip.h>
+#include <core/io/Serialisation.h>
+#include <engine/Engine.h>
+#include <engine/ecs/World.h>
+#include <engine/scene/Scene.h>
+#include <engine/task/TaskScheduler.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
+namespace Carrot {
+    // stored as raw bytes
+    static_assert(std::is_trivially_copyable_v<BinaryScene::Header>);
+    static_assert(std::is_trivially_copyable_v<BinaryScene::Entity>);
+    static_assert(std::is_trivially_copyable_v<BinaryScene::Column>);
+    static_assert(std::is_trivially_copyable_v<BinaryScene::Cell>);
+
+    namespace BinaryScene {
+        /// How many components are deserialised by a single task when loading
+        constexpr std::size_t CellsPerTask = 512;
+
+        class Writer {
+        public:
+            std::vector<std::uint8_t> bytes;
+
+            /// Appends 'elements' at the next aligned offset
+            template<typename T>
+            Table writeTable(std::span<const T> elements) {
+                const std::uint64_t offset = align();
+                bytes.resize(offset + elements.size_bytes());
+                if(!elements.empty()) {
+                    memcpy(bytes.data() + offset, elements.data(), elements.size_bytes());
+                }
+                return Table { .offset = offset, .count = elements.size() };
+            }
+
+            StringRef addString(std::string_view str) {
+                const StringRef ref { .offset = static_cast<std::uint32_t>(strings.size()), .length = static_cast<std::uint32_t>(str.size()) };
+                strings.insert(strings.end(), str.begin(), str.end());
+                return ref;
+            }
+
+            std::vector<char> strings;
+
+        private:
+            std::uint64_t align() {
+                std::uint64_t offset = bytes.size();
+                if(offset % TableAlignment != 0) {
+                    offset += TableAlignment - offset % TableAlignment;
+                }
+                return offset;
+            }
+        };
+
+        static void writeUUID(const Carrot::UUID& uuid, std::uint32_t (&destination)[4]) {
+            destination[0] = uuid.data0();
+            destination[1] = uuid.data1();
+            destination[2] = uuid.data2();
+            destination[3] = uuid.data3();
+        }
+
+        static Carrot::UUID readUUID(const std::uint32_t (&source)[4]) {
+            return Carrot::UUID { source[0], source[1], source[2], source[3] };
+        }
+
+        std::vector<std::uint8_t> write(const ECS::World& world, std::string_view settings) {
+            auto& componentLib = ECS::getComponentLibrary();
+
+            /// Column being written, cell offsets are relative to 'data' until all columns are concatenated
+            struct ColumnData {
+                std::string componentName;
+                Encoding encoding = Encoding::Binary;
+                std::vector<Cell> cells;
+                std::vector<std::uint8_t> data;
+            };
+
+            Writer writer;
+            Header header;
+            header.settings = writer.addString(settings);
+
+            const auto allEntities = world.getAllEntities();
+            std::vector<Entity> entities;
+            entities.reserve(allEntities.size());
+            std::vector<ColumnData> columnData;
+            std::unordered_map<std::string, std::size_t> columnIndices;
+
+            // components without binary representation are written as JSON
+            rapidjson::Document componentDocument;
+            rapidjson::StringBuffer jsonBuffer;
+            rapidjson::Writer<rapidjson::StringBuffer> jsonWriter { jsonBuffer };
+
+            for(const auto& entity : allEntities) {
+                const std::uint32_t entityIndex = static_cast<std::uint32_t>(entities.size());
+                Entity& entityRecord = entities.emplace_back();
+                writeUUID(entity.getID(), entityRecord.id);
+                if(auto parent = entity.getParent()) {
+                    entityRecord.hasParent = 1;
+                    writeUUID(parent->getID(), entityRecord.parent);
+                }
+                entityRecord.name = writer.addString(entity.getName());
+                entityRecord.flags = static_cast<std::uint64_t>(entity.getFlags());
+
+                for(const auto& comp : world.getAllComponents(entity)) {
+                    const std::string componentName = comp->getName();
+                    auto [indexLocation, newColumn] = columnIndices.try_emplace(componentName, columnData.size());
+                    if(newColumn) {
+                        ColumnData& newData = columnData.emplace_back();
+                        newData.componentName = componentName;
+                        newData.encoding = componentLib.hasBinaryRepresentation(componentName) ? Encoding::Binary : Encoding::JSON;
+                    }
+
+                    ColumnData& column = columnData[indexLocation->second];
+                    const std::size_t start = column.data.size();
+                    if(column.encoding == Encoding::Binary) {
+                        componentLib.serialiseBinary(*comp, column.data);
+                    } else {
+                        jsonBuffer.Clear();
+                        jsonWriter.Reset(jsonBuffer);
+                        {
+                            const rapidjson::Value json = comp->toJSON(componentDocument);
+                            json.Accept(jsonWriter);
+                        }
+                        componentDocument.GetAllocator().Clear();
+                        column.data.insert(column.data.end(), jsonBuffer.GetString(), jsonBuffer.GetString() + jsonBuffer.GetSize());
+                    }
+                    column.cells.push_back(Cell {
+                        .entityIndex = entityIndex,
+                        .size = static_cast<std::uint32_t>(column.data.size() - start),
+                        .offset = start,
+                    });
+                }
+            }
+
+            std::vector<Column> columns;
+            std::vector<Cell> cells;
+            std::vector<std::uint8_t> cellData;
+            columns.reserve(columnData.size());
+            for(const auto& column : columnData) {
+                columns.push_back(Column {
+                    .componentName = writer.addString(column.componentName),
+                    .encoding = column.encoding,
+                    .firstCell = cells.size(),
+                    .cellCount = column.cells.size(),
+                });
+                const std::uint64_t dataOffset = cellData.size();
+                for(Cell cell : column.cells) {
+                    cell.offset += dataOffset;
+                    cells.push_back(cell);
+                }
+                cellData.insert(cellData.end(), column.data.begin(), column.data.end());
+            }
+
+            // header is written last, once offsets are known
+            writer.bytes.resize(sizeof(Header));
+            header.entities = writer.writeTable(std::span<const Entity>{ entities });
+            header.columns = writer.writeTable(std::span<const Column>{ columns });
+            header.cells = writer.writeTable(std::span<const Cell>{ cells });
+            header.cellData = writer.writeTable(std::span<const std::uint8_t>{ cellData });
+            header.strings = writer.writeTable(std::span<const char>{ writer.strings });
+            memcpy(writer.bytes.data(), &header, sizeof(Header));
+
+            return std::move(writer.bytes);
+        }
+
+        void loadEntities(const BinarySceneView& scene, ECS::World& world) {
+            auto& componentLib = ECS::getComponentLibrary();
+
+            const std::span<const Entity> entityRecords = scene.getEntities();
+            std::vector<ECS::Entity> entities;
+            entities.reserve(entityRecords.size());
+            for(const Entity& record : entityRecords) {
+                ECS::Entity& entity = entities.emplace_back(world.newEntityWithID(readUUID(record.id), scene.getString(record.name)));
+                const auto flags = static_cast<ECS::EntityFlags>(record.flags);
+                if(flags != ECS::EntityFlags::None) {
+                    entity.setFlags(flags);
+                }
+            }
+            for(std::size_t i = 0; i < entityRecords.size(); i++) {
+                if(entityRecords[i].hasParent) {
+                    entities[i].setParent(world.wrap(readUUID(entityRecords[i].parent)));
+                }
+            }
+
+            // split columns in tasks, each one deserialising a range of cells
+            struct Task {
+                std::size_t columnIndex = 0;
+                std::size_t firstCell = 0;
+                std::size_t cellCount = 0;
+            };
+
+            const std::span<const Column> columns = scene.getColumns();
+            std::vector<std::string> componentNames;
+            std::vector<std::vector<std::unique_ptr<ECS::Component>>> binaryComponents(columns.size());
+            std::vector<std::vector<rapidjson::Document>> jsonComponents(columns.size());
+            std::vector<Task> tasks;
+            componentNames.reserve(columns.size());
+            for(std::size_t columnIndex = 0; columnIndex < columns.size(); columnIndex++) {
+                const Column& column = columns[columnIndex];
+                const std::string& componentName = componentNames.emplace_back(scene.getString(column.componentName));
+                if(column.encoding == Encoding::Binary) {
+                    if(!componentLib.hasBinaryRepresentation(componentName)) {
+                        throw std::runtime_error(Carrot::sprintf("Component '%s' has no binary representation", componentName.c_str()));
+                    }
+                    binaryComponents[columnIndex].resize(column.cellCount);
+                } else {
+                    jsonComponents[columnIndex].resize(column.cellCount);
+                }
+
+                for(std::size_t firstCell = 0; firstCell < column.cellCount; firstCell += CellsPerTask) {
+                    tasks.push_back(Task {
+                        .columnIndex = columnIndex,
+                        .firstCell = firstCell,
+                        .cellCount = std::min(CellsPerTask, column.cellCount - firstCell),
+                    });
+                }
+            }
+
+            // exceptions must not escape tasks, they are rethrown once all tasks are done
+            std::vector<std::exception_ptr> errors(tasks.size());
+            GetTaskScheduler().parallelFor(tasks.size(), [&](std::size_t taskIndex) {
+                const Task& task = tasks[taskIndex];
+                const Column& column = columns[task.columnIndex];
+                const std::span<const Cell> cells = scene.getCells(column).subspan(task.firstCell, task.cellCount);
+                try {
+                    for(std::size_t i = 0; i < cells.size(); i++) {
+                        const std::span<const std::uint8_t> cellData = scene.getCellData(cells[i]);
+                        if(column.encoding == Encoding::Binary) {
+                            IO::VectorReader reader { cellData };
+                            binaryComponents[task.columnIndex][task.firstCell + i] = componentLib.deserialiseBinary(componentNames[task.columnIndex], reader, entities[cells[i].entityIndex]);
+                        } else {
+                            rapidjson::Document& json = jsonComponents[task.columnIndex][task.firstCell + i];
+                            json.Parse(reinterpret_cast<const char*>(cellData.data()), cellData.size());
+                            if(json.HasParseError()) {
+                                throw std::runtime_error(Carrot::sprintf("Invalid JSON for component '%s'", componentNames[task.columnIndex].c_str()));
+                            }
+                        }
+                    }
+                } catch(...) {
+                    errors[taskIndex] = std::current_exception();
+                }
+            }, 1);
+            for(const auto& error : errors) {
+                if(error) {
+                    std::rethrow_exception(error);
+                }
+            }
+
+            // adding to the world is not thread-safe
+            for(std::size_t columnIndex = 0; columnIndex < columns.size(); columnIndex++) {
+                const Column& column = columns[columnIndex];
+                const std::span<const Cell> cells = scene.getCells(column);
+                for(std::size_t i = 0; i < cells.size(); i++) {
+                    ECS::Entity& entity = entities[cells[i].entityIndex];
+                    if(column.encoding == Encoding::Binary) {
+                        entity.addComponent(std::move(binaryComponents[columnIndex][i]));
+                    } else {
+                        entity.addComponent(componentLib.deserialise(componentNames[columnIndex], jsonComponents[columnIndex][i], entity));
+                    }
+                }
+            }
+        }
+
+        std::vector<std::uint8_t> convertFromJSON(const rapidjson::Value& json) {
+            Scene scene;
+            scene.deserialise(json);
+            return scene.serialiseBinary();
+        }
+
+        void convertToJSON(std::span<const std::uint8_t> binary, rapidjson::Document& destination) {
+            Scene scene;
+            scene.deserialiseBinary(binary);
+            destination.SetObject();
+            scene.serialise(destination);
+        }
+    }
+
+    BinarySceneView::BinarySceneView(std::span<const std::uint8_t> data): data(data) {
+        using namespace BinaryScene;
+        if(data.size() < sizeof(Header) || reinterpret_cast<std::uintptr_t>(data.data()) % TableAlignment != 0) {
+            throw std::runtime_error("Not a binary scene: too small or misaligned");
+        }
+        pHeader = reinterpret_cast<const Header*>(data.data());
+        if(pHeader->magic != Magic) {
+            throw std::runtime_error("Not a binary scene: invalid magic");
+        }
+        if(pHeader->version != Version) {
+            throw std::runtime_error(Carrot::sprintf("Unsupported binary scene version %u (expected %u)", pHeader->version, Version));
+        }
+
+        // checks the structure of the file, so that spans returned by this view stay inside 'data'.
+        // Contents of cells are checked when they are deserialised
+        auto checkString = [&](const StringRef& ref) {
+            if(static_cast<std::uint64_t>(ref.offset) + ref.length > pHeader->strings.count) {
+                throw std::runtime_error("Invalid binary scene: string is out of bounds");
+            }
+        };
+
+        // validates all tables
+        const std::size_t entityCount = getEntities().size();
+        const std::size_t cellCount = getTable<Cell>(pHeader->cells).size();
+        const std::size_t cellDataSize = getTable<std::uint8_t>(pHeader->cellData).size();
+        getTable<char>(pHeader->strings);
+
+        checkString(pHeader->settings);
+        for(const Entity& entity : getEntities()) {
+            checkString(entity.name);
+        }
+        for(const Column& column : getColumns()) {
+            checkString(column.componentName);
+            if(column.encoding != Encoding::Binary && column.encoding != Encoding::JSON) {
+                throw std::runtime_error("Invalid binary scene: unknown column encoding");
+            }
+            if(column.firstCell > cellCount || column.cellCount > cellCount - column.firstCell) {
+                throw std::runtime_error("Invalid binary scene: column cells are out of bounds");
+            }
+        }
+        for(const Cell& cell : getTable<Cell>(pHeader->cells)) {
+            if(cell.entityIndex >= entityCount) {
+                throw std::runtime_error("Invalid binary scene: component references an entity which does not exist");
+            }
+            if(cell.offset > cellDataSize || cell.size > cellDataSize - cell.offset) {
+                throw std::runtime_error("Invalid binary scene: component data is out of bounds");
+            }
+        }
+    }
+
+    template<typename T>
+    std::span<const T> BinarySceneView::getTable(const BinaryScene::Table& table) const {
+        if(table.offset % alignof(T) != 0
+        || table.offset > data.size()
+        || table.count > (data.size() - table.offset) / sizeof(T)) {
+            throw std::runtime_error("Invalid binary scene: table is out of bounds");
+        }
+        return std::span<const T> { reinterpret_cast<const T*>(data.data() + table.offset), table.count };
+    }
+
+    std::string_view BinarySceneView::getSettings() const {
+        return getString(pHeader->settings);
+    }
+
+    std::span<const BinaryScene::Entity> BinarySceneView::getEntities() const {
+        return getTable<BinaryScene::Entity>(pHeader->entities);
+    }
+
+    std::span<const BinaryScene::Column> BinarySceneView::getColumns() const {
+        return getTable<BinaryScene::Column>(pHeader->columns);
+    }
+
+    std::span<const BinaryScene::Cell> BinarySceneView::getCells(const BinaryScene::Column& column) const {
+        return getTable<BinaryScene::Cell>(pHeader->cells).subspan(column.firstCell, column.cellCount);
+    }
+
+    std::span<const std::uint8_t> BinarySceneView::getCellData(const BinaryScene::Cell& cell) const {
+        return getTable<std::uint8_t>(pHeader->cellData).subspan(cell.offset, cell.size);
+    }
+
+    std::string_view BinarySceneView::getString(const BinaryScene::StringRef& ref) const {
+        const std::span<const char> strings = getTable<char>(pHeader->strings);
+        return std::string_view { strings.data() + ref.offset, ref.length };
+    }
+}
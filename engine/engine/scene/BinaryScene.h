@@ -0,0 +1,132 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+#include <rapidjson/document.h>
+
+namespace Carrot::ECS {
+    class World;
+}
+
+namespace Carrot {
+    class BinarySceneView;
+
+    /// Binary scene format (.cscene), meant for shipping and fast loading. JSON stays the format used for source control,
+    /// scenes are converted with 'convertFromJSON' and 'convertToJSON'.
+    ///
+    /// Components are stored in columns, one per component type, so that each column can be deserialised independently
+    /// (and in parallel) of the others. Components with a binary representation (see ECS::BinarySerialisableComponent) are
+    /// stored in that representation, other components are stored as compact JSON.
+    /// Scene settings (world data, lighting, skybox, systems) are small and are stored as a single JSON string.
+    ///
+    /// Layout: a Header, followed by tables aligned on 'BinaryScene::TableAlignment' bytes. Headers of tables give offsets relative to
+    /// the start of the file. All values are little-endian, like every platform Carrot runs on.
+    namespace BinaryScene {
+        constexpr std::uint32_t Magic = 'C' | ('S' << 8) | ('C' << 16) | ('N' << 24);
+
+        /// Increment when the layout of the file, or the binary representation of any component, changes
+        constexpr std::uint32_t Version = 1;
+
+        constexpr std::uint64_t TableAlignment = 16;
+
+        /// Part of the file containing 'count' elements, starting at 'offset' (in bytes)
+        struct Table {
+            std::uint64_t offset = 0;
+            std::uint64_t count = 0;
+        };
+
+        /// String inside the string table, not null-terminated
+        struct StringRef {
+            std::uint32_t offset = 0;
+            std::uint32_t length = 0;
+        };
+
+        struct Header {
+            std::uint32_t magic = Magic;
+            std::uint32_t version = Version;
+
+            StringRef settings; // JSON object, same members as a JSON scene, except 'entities'
+
+            Table entities; // BinaryScene::Entity
+            Table columns; // BinaryScene::Column
+            Table cells; // BinaryScene::Cell, cells of a column are contiguous
+            Table cellData; // std::uint8_t
+            Table strings; // char
+        };
+
+        struct Entity {
+            std::uint32_t id[4]{}; // UUID::data0..data3
+            std::uint32_t parent[4]{}; // only valid if 'hasParent' is not 0
+            StringRef name;
+            std::uint32_t hasParent = 0;
+            std::uint32_t padding = 0;
+            std::uint64_t flags = 0; // ECS::EntityFlags
+        };
+
+        enum class Encoding: std::uint32_t {
+            Binary, // written by ComponentLibrary::serialiseBinary
+            JSON, // written by Component::toJSON
+        };
+
+        /// All components of a given type
+        struct Column {
+            StringRef componentName; // ID inside the component library
+            Encoding encoding = Encoding::Binary;
+            std::uint32_t padding = 0;
+            std::uint64_t firstCell = 0;
+            std::uint64_t cellCount = 0;
+        };
+
+        /// A single component
+        struct Cell {
+            std::uint32_t entityIndex = 0; // index inside the entity table
+            std::uint32_t size = 0;
+            std::uint64_t offset = 0; // inside the cell data table
+        };
+
+        /// Serializes the entities of 'world' to the binary scene format. 'settings' is stored as-is
+        std::vector<std::uint8_t> write(const ECS::World& world, std::string_view settings);
+
+        /// Creates the entities stored in 'scene' inside 'world'.
+        /// Columns are split in tasks and deserialised in parallel on the TaskScheduler. Components stored as JSON are parsed in parallel too,
+        /// but are constructed on the calling thread, because their constructors may use engine systems (renderer, physics, assets).
+        /// Throws if a component is unknown or if its data is invalid
+        void loadEntities(const BinarySceneView& scene, ECS::World& world);
+
+        /// Converts a JSON scene (as written by Scene::serialise) to the binary format
+        std::vector<std::uint8_t> convertFromJSON(const rapidjson::Value& json);
+
+        /// Converts a binary scene to JSON (as written by Scene::serialise), for example to get it back in source control
+        void convertToJSON(std::span<const std::uint8_t> binary, rapidjson::Document& destination);
+    }
+
+    /// Read-only view over a scene in the binary format. Does not copy anything: the returned spans point inside the viewed data,
+    /// which must outlive this view
+    class BinarySceneView {
+    public:
+        /// Checks that 'data' is a valid scene, throws if it is not
+        explicit BinarySceneView(std::span<const std::uint8_t> data);
+
+        std::string_view getSettings() const;
+
+        std::span<const BinaryScene::Entity> getEntities() const;
+        std::span<const BinaryScene::Column> getColumns() const;
+        std::span<const BinaryScene::Cell> getCells(const BinaryScene::Column& column) const;
+        std::span<const std::uint8_t> getCellData(const BinaryScene::Cell& cell) const;
+
+        std::string_view getString(const BinaryScene::StringRef& ref) const;
+
+    private:
+        template<typename T>
+        std::span<const T> getTable(const BinaryScene::Table& table) const;
+
+        std::span<const std::uint8_t> data;
+        const BinaryScene::Header* pHeader = nullptr;
+    };
+}
@@ -9,6 +9,9 @@
 #include "engine/utils/Macros.h"
 #include "engine/Engine.h"
 #include "engine/render/VulkanRenderer.h"
+#include "engine/scene/BinaryScene.h"
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 
 namespace Carrot {
     Scene::~Scene() {
@@ -75,6 +78,10 @@ namespace Carrot {
 
         dest.AddMember("entities", entitiesMap, dest.GetAllocator());
 
+        serialiseSettings(dest);
+    }
+
+    void Scene::serialiseSettings(rapidjson::Document& dest) const {
         rapidjson::Value lightingObj(rapidjson::kObjectType);
         {
             lightingObj.AddMember("ambient", Carrot::JSON::write(lighting.ambient, dest), dest.GetAllocator());
@@ -107,14 +114,10 @@ namespace Carrot {
         assert(src.IsObject());
 
         // load first, that way entities can refer to shared data
-        if(src.HasMember("world_data")) {
-            ECS::WorldData& worldData = world.getWorldData();
-            worldData.loadFromJSON(src["world_data"]);
-        }
+        deserialiseWorldData(src);
 
         const auto entityMap = src["entities"].GetObject();
         auto& componentLib = Carrot::ECS::getComponentLibrary();
-        auto& systemLib = Carrot::ECS::getSystemLibrary();
         for(const auto& [key, entityData] : entityMap) {
             Carrot::UUID uuid { key.GetString() };
             auto data = entityData.GetObject();
@@ -140,6 +143,45 @@ namespace Carrot {
             }
         }
 
+        deserialiseSettings(src);
+    }
+
+    void Scene::deserialiseBinary(std::span<const std::uint8_t> src) {
+        const BinarySceneView view { src };
+        rapidjson::Document settings;
+        const std::string_view settingsJSON = view.getSettings();
+        settings.Parse(settingsJSON.data(), settingsJSON.size());
+        if(settings.HasParseError() || !settings.IsObject()) {
+            throw std::runtime_error("Invalid binary scene: settings are not a JSON object");
+        }
+
+        // load first, that way entities can refer to shared data
+        deserialiseWorldData(settings);
+        BinaryScene::loadEntities(view, world);
+        deserialiseSettings(settings);
+    }
+
+    std::vector<std::uint8_t> Scene::serialiseBinary() const {
+        rapidjson::Document settings;
+        settings.SetObject();
+        settings.AddMember("world_data", world.getWorldData().toJSON(settings.GetAllocator()), settings.GetAllocator());
+        serialiseSettings(settings);
+
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer { buffer };
+        settings.Accept(writer);
+        return BinaryScene::write(world, std::string_view { buffer.GetString(), buffer.GetSize() });
+    }
+
+    void Scene::deserialiseWorldData(const rapidjson::Value& src) {
+        if(src.HasMember("world_data")) {
+            ECS::WorldData& worldData = world.getWorldData();
+            worldData.loadFromJSON(src["world_data"]);
+        }
+    }
+
+    void Scene::deserialiseSettings(const rapidjson::Value& src) {
+        auto& systemLib = Carrot::ECS::getSystemLibrary();
         if(src.HasMember("lighting")) {
             lighting.ambient = Carrot::JSON::read<3, float>(src["lighting"]["ambient"]);
             lighting.raytracedShadows = src["lighting"]["raytracedShadows"].GetBool();
@@ -201,4 +243,10 @@ namespace Carrot {
         lighting = toCopy.lighting;
         skybox = toCopy.skybox;
     }
+
+    void Scene::moveContentFrom(Scene& source) {
+        world.moveContentFrom(source.world);
+        lighting = source.lighting;
+        skybox = source.skybox;
+    }
 }
\ No newline at end of file
@@ -43,6 +43,12 @@ namespace Carrot {
         void deserialise(const rapidjson::Value& src);
         void serialise(rapidjson::Document& dest) const;
 
+        /// Same as deserialise, from the binary scene format (see BinaryScene.h). Components are deserialised in parallel
+        void deserialiseBinary(std::span<const std::uint8_t> src);
+
+        /// Same as serialise, to the binary scene format (see BinaryScene.h)
+        std::vector<std::uint8_t> serialiseBinary() const;
+
     public:
         /// Unload the systems of this scene, freeing engine resources (eg lights, rigidbodies)
         void unload();
@@ -71,7 +77,19 @@ namespace Carrot {
         void copyFrom(const Scene& toCopy);
         Scene& operator=(const Scene& toCopy) = delete;
 
+        /**
+         * Moves settings and world from 'source', without duplicating its components. 'source' is left empty.
+         * Does NOT move viewport bindings, and does not load this scene.
+         */
+        void moveContentFrom(Scene& source);
+
     private:
+        /// Lighting, skybox and systems. World data is handled separately, because it must be loaded before entities
+        void serialiseSettings(rapidjson::Document& dest) const;
+        void deserialiseSettings(const rapidjson::Value& src);
+
+        void deserialiseWorldData(const rapidjson::Value& src);
+
         std::vector<Carrot::Render::Viewport*> viewports;
     };
 }
@@ -5,6 +5,7 @@
 #include <core/io/Logging.hpp>
 #include "SceneManager.h"
 
+#include <core/io/FileFormats.h>
 #include <core/scripting/csharp/Engine.h>
 #include <engine/scripting/CSharpBindings.h>
 #include <engine/scripting/CSharpReflectionHelper.h>
@@ -21,12 +22,8 @@ namespace Carrot {
 
     Scene& SceneManager::loadScene(const Carrot::IO::VFS::Path& path) {
         auto& scene = scenes.emplace_back();
-        rapidjson::Document sceneDoc;
         try {
-            Carrot::IO::Resource sceneData = path;
-            sceneDoc.Parse(sceneData.readText());
-
-            scene.deserialise(sceneDoc);
+            readScene(path, scene);
         } catch (std::exception& e) {
             Carrot::Log::error("Failed to open scene: %s", e.what());
             scene.clear();
@@ -35,12 +32,8 @@ namespace Carrot {
     }
 
     Scene& SceneManager::loadSceneAdditive(const Carrot::IO::VFS::Path& path, Scene& addTo) {
-        rapidjson::Document sceneDoc;
         try {
-            Carrot::IO::Resource sceneData = path;
-            sceneDoc.Parse(sceneData.readText());
-
-            addTo.deserialise(sceneDoc);
+            readScene(path, addTo);
         } catch (std::exception& e) {
             Carrot::Log::error("Failed to open scene: %s", e.what());
         }
@@ -48,14 +41,10 @@ namespace Carrot {
     }
 
     Scene& SceneManager::changeScene(const Carrot::IO::VFS::Path& scenePath) {
-        rapidjson::Document sceneDoc;
         Scene& mainScene = getMainScene();
         try {
-            Carrot::IO::Resource sceneData = scenePath;
-            sceneDoc.Parse(sceneData.readText());
-
             mainScene.clear();
-            mainScene.deserialise(sceneDoc);
+            readScene(scenePath, mainScene);
         } catch (std::exception& e) {
             Carrot::Log::error("Failed to open scene: %s", e.what());
             mainScene.clear();
@@ -63,6 +52,20 @@ namespace Carrot {
         return mainScene;
     }
 
+    void SceneManager::readScene(const Carrot::IO::VFS::Path& path, Scene& into) {
+        Carrot::IO::Resource sceneData = path;
+        if(Carrot::IO::getFileFormat(path.toString().c_str()) == Carrot::IO::FileFormat::CSCENE) {
+            std::vector<std::uint8_t> bytes;
+            bytes.resize(sceneData.getSize());
+            sceneData.read(bytes);
+            into.deserialiseBinary(bytes);
+        } else {
+            rapidjson::Document sceneDoc;
+            sceneDoc.Parse(sceneData.readText());
+            into.deserialise(sceneDoc);
+        }
+    }
+
     void SceneManager::deleteScene(Scene&& scene) {
         for(auto it = scenes.begin(); it != scenes.end(); it++) {
             if(&(it.operator*()) == &scene) {
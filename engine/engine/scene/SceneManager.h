@@ -36,6 +36,12 @@ namespace Carrot {
          */
         Scene& changeScene(const Carrot::IO::VFS::Path& scenePath);
 
+        /**
+         * Reads the scene at the given path into 'into', without clearing it first.
+         * Binary scenes (.cscene) are detected by their extension, other files are read as JSON. Throws on failure
+         */
+        static void readScene(const Carrot::IO::VFS::Path& path, Scene& into);
+
         /**
          * Deletes the given scene from memory.
          * This call MUST be the last access to 'scene', because the SceneManager WILL delete the instance
@@ -87,6 +87,8 @@ namespace Carrot::Scripting {
         mono_add_internal_call("Carrot.System::_Query", _QueryECS);
         mono_add_internal_call("Carrot.System::FindEntityByName", FindEntityByName);
         mono_add_internal_call("Carrot.Entity::GetComponent", GetComponent);
+        mono_add_internal_call("Carrot.Entity::_GetComponentID", GetComponentID);
+        mono_add_internal_call("Carrot.Entity::_HasComponent", _HasComponent);
         mono_add_internal_call("Carrot.Entity::GetName", GetName);
         mono_add_internal_call("Carrot.Entity::Remove", Remove);
         mono_add_internal_call("Carrot.Entity::GetChildren", nullptr); // TODO
@@ -106,6 +108,7 @@ namespace Carrot::Scripting {
         mono_add_internal_call("Carrot.TransformComponent::_GetEulerAngles", _GetEulerAngles);
         mono_add_internal_call("Carrot.TransformComponent::_SetEulerAngles", _SetEulerAngles);
         mono_add_internal_call("Carrot.TransformComponent::_GetWorldPosition", _GetWorldPosition);
+        mono_add_internal_call("Carrot.TransformComponent::_GetLocalTransformPointer", _GetLocalTransformPointer);
 
         mono_add_internal_call("Carrot.CharacterComponent::Teleport", TeleportCharacter);
         mono_add_internal_call("Carrot.CharacterComponent::_GetVelocity", _GetCharacterVelocity);
@@ -121,6 +124,8 @@ namespace Carrot::Scripting {
         mono_add_internal_call("Carrot.RigidBodyComponent::GetCollider", GetRigidBodyCollider);
         mono_add_internal_call("Carrot.RigidBodyComponent::_GetVelocity", _GetRigidBodyVelocity);
         mono_add_internal_call("Carrot.RigidBodyComponent::_SetVelocity", _SetRigidBodyVelocity);
+        mono_add_internal_call("Carrot.RigidBodyComponent::_GetState", _GetRigidBodyState);
+        mono_add_internal_call("Carrot.RigidBodyComponent::_SetState", _SetRigidBodyState);
 
         mono_add_internal_call("Carrot.RigidBodyComponent::Raycast", RaycastRigidbody);
         mono_add_internal_call("Carrot.CharacterComponent::Raycast", RaycastCharacter);
@@ -680,6 +685,20 @@ namespace Carrot::Scripting {
         return (MonoObject*)(*obj); // assumes the GC won't trigger before it is used
     }
 
+    bool CSharpBindings::_HasComponent(ECS::EntityID entityID, std::uint64_t worldPointer, ComponentID componentID) {
+        ECS::World* pWorld = reinterpret_cast<ECS::World*>(worldPointer);
+        return pWorld->wrap(entityID).getComponent(componentID).hasValue();
+    }
+
+    void* CSharpBindings::_GetLocalTransformPointer(ECS::EntityID entityID, std::uint64_t worldPointer) {
+        ECS::World* pWorld = reinterpret_cast<ECS::World*>(worldPointer);
+        auto transform = pWorld->wrap(entityID).getComponent<ECS::TransformComponent>();
+        if(!transform.hasValue()) {
+            return nullptr;
+        }
+        return &transform->localTransform;
+    }
+
     glm::vec3 CSharpBindings::_GetLocalPosition(MonoObject* transformComp) {
         auto ownerEntity = instance().ComponentOwnerField->get(Scripting::CSObject(transformComp));
         ECS::Entity entity = convertToEntity(ownerEntity);
@@ -800,6 +819,20 @@ namespace Carrot::Scripting {
         entity.getComponent<ECS::RigidBodyComponent>()->rigidbody.setVelocity(value);
     }
 
+    void CSharpBindings::_GetRigidBodyState(ECS::EntityID entityID, std::uint64_t worldPointer, RigidBodyState* pOutState) {
+        ECS::World* pWorld = reinterpret_cast<ECS::World*>(worldPointer);
+        const Physics::RigidBody& rigidbody = pWorld->wrap(entityID).getComponent<ECS::RigidBodyComponent>()->rigidbody;
+        pOutState->worldTransform = rigidbody.getTransform();
+        pOutState->velocity = rigidbody.getVelocity();
+    }
+
+    void CSharpBindings::_SetRigidBodyState(ECS::EntityID entityID, std::uint64_t worldPointer, const RigidBodyState* pState) {
+        ECS::World* pWorld = reinterpret_cast<ECS::World*>(worldPointer);
+        Physics::RigidBody& rigidbody = pWorld->wrap(entityID).getComponent<ECS::RigidBodyComponent>()->rigidbody;
+        rigidbody.setTransform(pState->worldTransform);
+        rigidbody.setVelocity(pState->velocity);
+    }
+
     std::uint64_t CSharpBindings::GetRigidBodyColliderCount(MonoObject* comp) {
         auto ownerEntity = instance().ComponentOwnerField->get(Scripting::CSObject(comp));
         ECS::Entity entity = convertToEntity(ownerEntity);
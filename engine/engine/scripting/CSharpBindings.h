@@ -18,6 +18,7 @@
 #include <engine/scripting/ComponentProperty.h>
 #include <engine/scripting/CSharpReflectionHelper.h>
 #include <engine/scripting/CarrotCSObject.h>
+#include <engine/math/Transform.h>
 
 namespace Carrot::Scripting {
     /// Interface to use Carrot.dll and game dlls made in C#
@@ -166,6 +167,7 @@ namespace Carrot::Scripting {
         static std::shared_ptr<Scripting::CSObject> entityToCSObject(ECS::Entity& e);
 
         static MonoObject* GetComponent(MonoObject* entityMonoObj, MonoString* namespaceStr, MonoString* classStr);
+        static bool _HasComponent(ECS::EntityID entityID, std::uint64_t worldPointer, ComponentID componentID);
 
         static MonoString* GetName(MonoObject* entityMonoObj);
 
@@ -203,6 +205,16 @@ namespace Carrot::Scripting {
         static void _ActivateActionSet(MonoObject* setObj);
 
     public: // hardcoded component interfaces
+        /// Same layout as Carrot.RigidBodyState in C#
+        struct RigidBodyState {
+            Carrot::Math::Transform worldTransform;
+            glm::vec3 velocity;
+        };
+        static_assert(sizeof(Carrot::Math::Transform) == 10 * sizeof(float), "Must match Carrot.TransformData in C#");
+        static_assert(sizeof(RigidBodyState) == 13 * sizeof(float), "Must match Carrot.RigidBodyState in C#");
+
+        /// Fast path: pointer to the local transform of the entity, which C# reads and writes in place (nullptr if no transform)
+        static void* _GetLocalTransformPointer(ECS::EntityID entityID, std::uint64_t worldPointer);
         static glm::vec3 _GetLocalPosition(MonoObject* transformComp);
         static void _SetLocalPosition(MonoObject* transformComp, glm::vec3 value);
         static glm::vec3 _GetLocalScale(MonoObject* transformComp);
@@ -226,6 +238,8 @@ namespace Carrot::Scripting {
 
         static glm::vec3 _GetRigidBodyVelocity(MonoObject* comp);
         static void _SetRigidBodyVelocity(MonoObject* comp, glm::vec3 value);
+        static void _GetRigidBodyState(ECS::EntityID entityID, std::uint64_t worldPointer, RigidBodyState* pOutState);
+        static void _SetRigidBodyState(ECS::EntityID entityID, std::uint64_t worldPointer, const RigidBodyState* pState);
 
         static std::uint64_t GetRigidBodyColliderCount(MonoObject* comp);
         static MonoObject* GetRigidBodyCollider(MonoObject* comp, std::uint64_t index);
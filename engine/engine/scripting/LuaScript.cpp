@@ -26,11 +26,24 @@ namespace Carrot::Lua {
         return std::move(result);
     }
 
-    Script::Script(const Carrot::IO::Resource& resource) {
+    void initState(sol::state& state) {
         // open some common libraries
-        open_libraries(sol::lib::base, sol::lib::package, sol::lib::math, sol::lib::string);
+        state.open_libraries(sol::lib::base, sol::lib::package, sol::lib::math, sol::lib::string);
+
+        registerAllUsertypes(state);
+    }
+
+    sol::protected_function_result loadInto(sol::state& state, sol::environment& environment, const Carrot::IO::Resource& resource) {
+        if(resource.isFile()) {
+            std::filesystem::path p = GetVFS().resolve(IO::VFS::Path(resource.getName()));
+            return state.safe_script_file(p.string(), environment, printOnLoadError);
+        } else {
+            return state.safe_script(resource.readText(), environment, printOnLoadError);
+        }
+    }
 
-        registerAllUsertypes(*this);
+    Script::Script(const Carrot::IO::Resource& resource) {
+        initState(*this);
 
         if(resource.isFile()) {
             std::filesystem::path p = GetVFS().resolve(IO::VFS::Path(resource.getName()));
@@ -38,9 +51,14 @@ namespace Carrot::Lua {
         } else {
             safe_script(resource.readText(), printOnLoadError);
         }
+        entryPoints = EntryPoints(globals());
     }
 
     Script::Script(const std::string& text): Script::Script(Carrot::IO::Resource::inMemory(text)) {}
 
     Script::Script(const char* text): Script::Script(std::string(text)) {}
+
+    const EntryPoints& Script::getEntryPoints() const {
+        return entryPoints;
+    }
 }
\ No newline at end of file
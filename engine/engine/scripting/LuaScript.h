@@ -8,6 +8,32 @@
 #include <core/io/Resource.h>
 
 namespace Carrot::Lua {
+    /// Opens the libraries and registers the usertypes available to all scripts
+    void initState(sol::state& state);
+
+    /// Runs the given script inside 'environment'. Load errors are logged
+    sol::protected_function_result loadInto(sol::state& state, sol::environment& environment, const Carrot::IO::Resource& script);
+
+    /// Functions called by the engine on scripts attached to entities.
+    /// Looked up once after loading the script, instead of by name on each call: redefining them afterwards has no effect
+    struct EntryPoints {
+        sol::protected_function start;
+        sol::protected_function eachTick;
+        sol::protected_function eachFrame;
+        sol::protected_function stop;
+
+        EntryPoints() = default;
+
+        /// Looks up the entry points inside the given table (globals of a script, or its environment)
+        template<typename Table>
+        explicit EntryPoints(const Table& scriptTable)
+            : start(scriptTable["start"])
+            , eachTick(scriptTable["eachTick"])
+            , eachFrame(scriptTable["eachFrame"])
+            , stop(scriptTable["stop"])
+        {}
+    };
+
     class Script: public sol::state {
     public:
         /// Creates a script object from a resource (file or in-memory)
@@ -34,5 +60,11 @@ namespace Carrot::Lua {
                 throw std::runtime_error("Lua error: " + what);
             }
         }
+
+        /// Entry points of this script, looked up once after loading
+        const EntryPoints& getEntryPoints() const;
+
+    private:
+        EntryPoints entryPoints; // declared after the sol::state base: released before the VM is closed
     };
 }
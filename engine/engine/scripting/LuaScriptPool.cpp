@@ -0,0 +1,157 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include "LuaScriptPool.h"
+#include <core/io/Logging.hpp>
+#include <engine/Engine.h>
+#include <engine/utils/Macros.h>
+
+namespace Carrot::Lua {
+    ScriptPool& ScriptPool::instance() {
+        static ScriptPool pool;
+        return pool;
+    }
+
+    /// Is there a '--!stateless' line inside the comments at the top of the given script?
+    static bool hasStatelessAnnotation(const std::string& code) {
+        std::size_t lineStart = 0;
+        while(lineStart < code.size()) {
+            std::size_t lineEnd = code.find('\n', lineStart);
+            if(lineEnd == std::string::npos) {
+                lineEnd = code.size();
+            }
+
+            std::string_view line { code.data() + lineStart, lineEnd - lineStart };
+            const std::size_t first = line.find_first_not_of(" \t\r");
+            const std::size_t last = line.find_last_not_of(" \t\r");
+            if(first != std::string_view::npos) {
+                line = line.substr(first, last - first + 1);
+                if(line == "--!stateless") {
+                    return true;
+                }
+                if(!line.starts_with("--")) {
+                    return false; // first line of code: annotations must come before
+                }
+            }
+            lineStart = lineEnd + 1;
+        }
+        return false;
+    }
+
+    ScriptPool::VM::VM() {
+        initState(state);
+    }
+
+    ScriptPool::VM& ScriptPool::getThreadVM() {
+        struct ThreadCache {
+            VM* pVM = nullptr;
+            std::uint64_t generation = 0;
+        };
+        thread_local ThreadCache cache;
+
+        const std::uint64_t currentGeneration = generation.load(std::memory_order_acquire);
+        if(cache.pVM == nullptr || cache.generation != currentGeneration) {
+            auto pNewVM = std::make_unique<VM>(); // created outside of the lock, registering all usertypes takes a while
+            Async::LockGuard l { vmsAccess };
+            cache.pVM = vms.emplace_back(std::move(pNewVM)).get();
+            cache.generation = currentGeneration;
+        }
+        return *cache.pVM;
+    }
+
+    const ScriptPool::LoadedScript& ScriptPool::getScript(const IO::VFS::Path& scriptPath) {
+        VM& vm = getThreadVM();
+        auto it = vm.scripts.find(scriptPath);
+        if(it != vm.scripts.end()) {
+            return it->second;
+        }
+
+        // only the calling thread uses this VM: no lock needed
+        LoadedScript& script = vm.scripts[scriptPath];
+        script.environment = sol::environment(vm.state, sol::create, vm.state.globals());
+        try {
+            auto result = loadInto(vm.state, script.environment, Carrot::IO::Resource(scriptPath));
+            script.valid = result.valid();
+        } catch(std::exception& e) {
+            Carrot::Log::error("[%s] %s", scriptPath.toString().c_str(), e.what());
+            script.valid = false;
+        }
+
+        if(script.valid) {
+            script.entryPoints = EntryPoints(script.environment);
+        } else {
+            Carrot::Log::error("[%s] Could not load script inside shared Lua VM", scriptPath.toString().c_str());
+        }
+        return script;
+    }
+
+    const EntryPoints* ScriptPool::getEntryPoints(const IO::VFS::Path& scriptPath) {
+        const LoadedScript& script = getScript(scriptPath);
+        return script.valid ? &script.entryPoints : nullptr;
+    }
+
+    bool ScriptPool::isStateless(const IO::VFS::Path& scriptPath) {
+        {
+            Async::LockGuard l { statelessAccess };
+            auto it = statelessScripts.find(scriptPath);
+            if(it != statelessScripts.end()) {
+                return it->second;
+            }
+        }
+
+        bool stateless = false;
+        try {
+            stateless = hasStatelessAnnotation(Carrot::IO::Resource(scriptPath).readText());
+        } catch(std::exception& e) {
+            Carrot::Log::error("[%s] %s", scriptPath.toString().c_str(), e.what());
+        }
+
+        std::shared_ptr<IO::FileWatcher> watcher;
+        if(stateless && !GetVFS().findPacked(scriptPath).has_value()) {
+            if(auto physicalPath = GetVFS().safeResolve(scriptPath)) {
+                watcher = GetEngine().createFileWatcher([this](const std::filesystem::path& p) {
+                    Carrot::Log::info("Detected modification of stateless script %s, reloading shared Lua VMs", p.u8string().c_str());
+                    scriptsModified = true;
+                }, { *physicalPath });
+            }
+        }
+
+        Async::LockGuard l { statelessAccess };
+        statelessScripts[scriptPath] = stateless;
+        if(watcher) {
+            watchers.try_emplace(scriptPath, std::move(watcher));
+        }
+        return stateless;
+    }
+
+    void ScriptPool::reloadModifiedScripts() {
+        if(scriptsModified.exchange(false)) {
+            clear();
+        }
+    }
+
+    std::size_t ScriptPool::getVMCount() const {
+        Async::LockGuard l { vmsAccess };
+        return vms.size();
+    }
+
+    std::size_t ScriptPool::getMemoryUsage() const {
+        Async::LockGuard l { vmsAccess };
+        std::size_t total = 0;
+        for(const auto& pVM : vms) {
+            total += pVM->state.memory_used();
+        }
+        return total;
+    }
+
+    void ScriptPool::clear() {
+        {
+            Async::LockGuard l { vmsAccess };
+            vms.clear();
+            generation.fetch_add(1, std::memory_order_release);
+        }
+        Async::LockGuard l { statelessAccess };
+        statelessScripts.clear(); // annotations are read again, but entities keep the mode they were created with
+    }
+}
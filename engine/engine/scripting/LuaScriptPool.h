@@ -0,0 +1,80 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <core/async/Locks.h>
+#include <core/io/FileWatcher.h>
+#include <core/io/vfs/VirtualFileSystem.h>
+#include "LuaScript.h"
+
+namespace Carrot::Lua {
+    /**
+     * Lua VMs shared by all entities: one VM per thread which runs scripts, created on first use.
+     * Each script is loaded once per VM, inside its own environment table, and its entry points are looked up once.
+     *
+     * Only scripts which declare themselves as stateless are run from this pool, with a '--!stateless' line inside the comments
+     * at the top of the script: their environment is shared by all entities, and an entity can be ticked by a different thread
+     * (so a different VM) on each tick. Such scripts must keep their state inside components, not inside globals.
+     * Other scripts keep a VM per entity (Lua::Script).
+     */
+    class ScriptPool {
+    public:
+        static ScriptPool& instance();
+
+        /// Entry points of the given script, inside the VM of the calling thread. Loads the script inside this VM if needed.
+        /// Returns nullptr if the script could not be loaded. The returned pointer stays valid until clear()
+        const EntryPoints* getEntryPoints(const IO::VFS::Path& scriptPath);
+
+        /// Does the given script start with a '--!stateless' annotation? Only reads the source of the script, it is not run.
+        /// Stateless scripts are watched for modifications, see reloadModifiedScripts
+        bool isStateless(const IO::VFS::Path& scriptPath);
+
+        /// Calls clear() if a stateless script has been modified since it was loaded. Must not be called while scripts are running
+        void reloadModifiedScripts();
+
+        /// Number of VMs created so far (one per thread which ran a script)
+        std::size_t getVMCount() const;
+
+        /// Memory used by all VMs, in bytes. Must not be called while scripts are running
+        std::size_t getMemoryUsage() const;
+
+        /// Destroys all VMs, scripts will be reloaded on next use. Must not be called while scripts are running
+        void clear();
+
+    private:
+        struct LoadedScript {
+            sol::environment environment;
+            EntryPoints entryPoints;
+            bool valid = false;
+        };
+
+        struct VM {
+            sol::state state;
+            std::unordered_map<IO::VFS::Path, LoadedScript> scripts; // declared after 'state': references are released before the VM is closed
+
+            VM();
+        };
+
+        ScriptPool() = default;
+
+        /// VM of the calling thread, created if needed
+        VM& getThreadVM();
+
+        const LoadedScript& getScript(const IO::VFS::Path& scriptPath);
+
+        mutable Async::SpinLock vmsAccess;
+        std::vector<std::unique_ptr<VM>> vms;
+        std::atomic<std::uint64_t> generation { 0 }; // incremented by clear(), to invalidate the VM pointers cached by threads
+
+        mutable Async::SpinLock statelessAccess;
+        std::unordered_map<IO::VFS::Path, bool> statelessScripts;
+        std::unordered_map<IO::VFS::Path, std::shared_ptr<IO::FileWatcher>> watchers; // kept by clear(), to detect later modifications
+        std::atomic<bool> scriptsModified { false };
+    };
+}
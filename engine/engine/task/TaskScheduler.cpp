@@ -5,6 +5,7 @@
 #include "TaskScheduler.h"
 #include "engine/utils/Profiling.h"
 #include <core/async/OSThreads.h>
+#include <core/async/ParallelFor.h>
 #include "engine/utils/Macros.h"
 #include "engine/Engine.h"
 #include "engine/render/VulkanRenderer.h"
@@ -226,37 +227,33 @@ namespace Carrot {
     }
 
     void TaskScheduler::parallelFor(std::size_t count, const std::function<void(std::size_t)>& forEach, std::size_t granularity) {
+        ZoneScoped;
         if(count == 0) {
             return;
         }
 
-        verify(granularity > 0, "Cannot have a granularity of 0");
-
-        auto run = [&](std::size_t startIndex) {
-            for(std::size_t i = startIndex; i < startIndex + granularity && i < count; i++) {
+        const std::size_t workerCount = frameParallelWorkParallelismAmount();
+        if(count == 1 || workerCount == 0) {
+            for(std::size_t i = 0; i < count; i++) {
                 forEach(i);
             }
-        };
-
-        std::size_t parallelJobs = count / granularity; // truncate on purpose, the calling thread will participate
-        if(parallelJobs > 0) {
-            Async::Counter sync;
-            for(std::size_t jobIndex = 0; jobIndex < parallelJobs; jobIndex++) {
-                schedule(TaskDescription {
-                        .name = "Parallel ForEach",
-                        .task = [&, jobIndex](Carrot::TaskHandle&) {
-                            std::size_t startIndex = jobIndex * granularity;
-                            run(startIndex);
-                        },
-                        .joiner = &sync,
-                }, FrameParallelWork);
-            }
+            return;
+        }
 
-            run(parallelJobs * granularity);
-            sync.busyWait(); // TODO: potential deadlock if done on thread already running tasks
-        } else {
-            run(0);
+        // no task per chunk: a few helpers claim chunks until none are left. The calling thread participates and, instead of
+        // waiting for helpers to start, runs the remaining chunks itself. Helpers which start after the job is done do nothing.
+        auto job = Async::ParallelForJob::create(count, forEach, granularity, workerCount + 1);
+        const std::size_t helperCount = granularity == 0 ? std::min(workerCount, count - 1) : std::min(workerCount, (count - 1) / granularity);
+        for(std::size_t helperIndex = 0; helperIndex < helperCount; helperIndex++) {
+            schedule(TaskDescription {
+                    .name = "Parallel ForEach",
+                    .task = [job](Carrot::TaskHandle&) {
+                        job->work();
+                    },
+            }, FrameParallelWork);
         }
+
+        job->wait();
     }
 
     void TaskScheduler::schedule(TaskDescription&& description, const Async::TaskLane& lane) {
@@ -275,10 +272,10 @@ namespace Carrot {
         auto pNewTask = getOrReuseTaskData();
         pNewTask->wantedLane = lane;
         pNewTask->currentLane = lane;
-        pNewTask->name = description.name;
+        pNewTask->name = std::move(description.name);
         pNewTask->dependency = description.dependency;
         pNewTask->joiner = description.joiner;
-        pNewTask->task = description.task;
+        pNewTask->task = std::move(description.task);
 
         {
             auto fiberProc = [pTaskKeepAlive = pNewTask, pTaskScheduler = this](Cider::FiberHandle& fiber) mutable {
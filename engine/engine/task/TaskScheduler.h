@@ -101,13 +101,13 @@ namespace Carrot {
     public:
         /**
          * Executes 'count' tasks in parallel, executing 'forEach' for each task.
-         * The calling thread will also participate.
+         * The calling thread will also participate, and runs pending tasks instead of spinning while waiting: safe to call from a task.
          * Waits until all tasks are done before returning
          * @param count how many tasks to execute
          * @param forEach what to execute for each task
-         * @param granularity how many tasks at once per thread
+         * @param granularity how many tasks at once per thread, 0 to choose automatically from the measured cost of tasks
          */
-        void parallelFor(std::size_t count, const std::function<void(std::size_t)>& forEach, std::size_t granularity);
+        void parallelFor(std::size_t count, const std::function<void(std::size_t)>& forEach, std::size_t granularity = 0);
 
     public: // scheduling
         /// Schedule a task for execution. The task will be executed as soon as possible on the given lane.
@@ -219,6 +219,7 @@ Carrot::VulkanDriver::VulkanDriver(Carrot::Window& window, Configuration config,
                                                                           .addressModeW = vk::SamplerAddressMode::eRepeat,
                                                                           .anisotropyEnable = true,
                                                                           .maxAnisotropy = 16.0f,
+                                                                          .maxLod = VK_LOD_CLAMP_NONE, // streamed textures have mips
                                                                           .unnormalizedCoordinates = false,
                                                                   }, getAllocationCallbacks());
 
@@ -231,6 +232,7 @@ Carrot::VulkanDriver::VulkanDriver(Carrot::Window& window, Configuration config,
                                                                          .addressModeW = vk::SamplerAddressMode::eRepeat,
                                                                          .anisotropyEnable = true,
                                                                          .maxAnisotropy = 16.0f,
+                                                                         .maxLod = VK_LOD_CLAMP_NONE,
                                                                          .unnormalizedCoordinates = false,
                                                                  }, getAllocationCallbacks());
 
@@ -725,7 +727,7 @@ vk::UniqueImageView Carrot::VulkanDriver::createImageView(const vk::Image& image
                                                             .subresourceRange = {
                                                                     .aspectMask = aspectMask,
                                                                     .baseMipLevel = 0,
-                                                                    .levelCount = 1,
+                                                                    .levelCount = VK_REMAINING_MIP_LEVELS,
                                                                     .baseArrayLayer = 0,
                                                                     .layerCount = layerCount,
                                                             },
@@ -1093,7 +1095,7 @@ void Carrot::VulkanDriver::startFrame(const Carrot::Render::Context& renderConte
                 std::uint64_t totalSize = 0;
                 std::uint64_t totalFilteredSize = 0;
                 for(const Carrot::Image* pImage : Carrot::Image::AliveImages) {
-                    if(pImage->isOwned()) {
+                    if(pImage->isOwned() && !pImage->isAliased()) { // aliased memory is shared with other images
                         totalSize += pImage->getMemory().getSize();
                     }
 
@@ -1102,7 +1104,7 @@ void Carrot::VulkanDriver::startFrame(const Carrot::Render::Context& renderConte
                         continue;
                     }
 
-                    if(pImage->isOwned()) {
+                    if(pImage->isOwned() && !pImage->isAliased()) {
                         totalFilteredSize += pImage->getMemory().getSize();
                     }
                     sortedImages.emplaceBack(pImage);
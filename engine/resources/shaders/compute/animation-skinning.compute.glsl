@@ -3,6 +3,14 @@
 #extension GL_EXT_scalar_block_layout : enable
 #extension GL_EXT_nonuniform_qualifier : enable
 
+// 0 = bone transforms are interpolated from the keyframes baked by Model
+// 1 = bone transforms are sampled on the CPU from compressed animations, see AnimatedInstances::computeSkinningPalettes
+// The build compiles both variants (CPU_ANIMATION_SAMPLING=1 for the variant inside cpu-animation-sampling/), the engine selects one with
+//  Configuration::cpuAnimationSampling
+#ifndef CPU_ANIMATION_SAMPLING
+#define CPU_ANIMATION_SAMPLING 0
+#endif
+
 // vertex
 layout (local_size_x = 128) in;
 // instance
@@ -10,6 +18,7 @@ layout (local_size_y = 8) in;
 
 layout(constant_id = 0) const uint VERTEX_COUNT = 1;
 layout(constant_id = 1) const uint INSTANCE_COUNT = 1;
+layout(constant_id = 2) const uint BONE_COUNT = 1;
 
 const uint MAX_KEYFRAMES = 140;
 const uint MAX_BONES = 40;
@@ -58,6 +67,31 @@ layout(set = 0, binding = 2) buffer OutputVertexBuffer {
     Vertex outputVertices[VERTEX_COUNT*INSTANCE_COUNT];
 };
 
+#if CPU_ANIMATION_SAMPLING
+// BONE_COUNT transforms per instance
+layout(set = 1, binding = 0) buffer Palettes {
+    mat4 palettes[];
+};
+
+mat4 loadBoneTransform(uint instanceIndex, int boneID) {
+    // unused influences have a negative ID (and a weight of 0)
+    if(boneID < 0)
+        return mat4(0.0);
+    return palettes[instanceIndex * BONE_COUNT + uint(boneID)];
+}
+
+mat4 computeSkinning(uint instanceIndex, uint vertexIndex) {
+    #define vertex originalVertices[vertexIndex]
+    if(vertex.boneIDs.x < 0)
+        return mat4(1.0);
+
+    return loadBoneTransform(instanceIndex, vertex.boneIDs.x) * vertex.boneWeights.x
+         + loadBoneTransform(instanceIndex, vertex.boneIDs.y) * vertex.boneWeights.y
+         + loadBoneTransform(instanceIndex, vertex.boneIDs.z) * vertex.boneWeights.z
+         + loadBoneTransform(instanceIndex, vertex.boneIDs.w) * vertex.boneWeights.w
+    ;
+}
+#else
 layout(set = 1, binding = 0) buffer Animations {
     Animation animations[];
 };
@@ -119,6 +153,7 @@ mat4 computeSkinning(uint instanceIndex, uint vertexIndex) {
     ;
     return boneTransform;
 }
+#endif
 
 void main() {
     uint vertexIndex = gl_GlobalInvocationID.x;
@@ -0,0 +1,20 @@
+//! Copies alive particles to the scratch buffer and computes their sort key, see Carrot::Particles::compact for the CPU version
+
+#include <includes/particle-simulation.glsl>
+
+layout (local_size_x = UPDATE_GROUP_SIZE) in;
+
+void main() {
+    uint particleIndex = gl_GlobalInvocationID.x;
+    if(particleIndex >= state.aliveCount) return;
+
+    Particle particle = particles[particleIndex];
+    if(particle.life < 0.0f) return;
+
+    uint outputIndex = atomicAdd(state.compactedCount, 1);
+    scratchParticles[outputIndex] = particle;
+
+    // same as Carrot::Particles::computeSortKey: far particles first
+    vec3 toParticle = particle.position - vec3(state.cameraX, state.cameraY, state.cameraZ);
+    sortEntries[outputIndex] = SortEntry(~floatBitsToUint(dot(toParticle, toParticle)), outputIndex);
+}
@@ -0,0 +1,36 @@
+//! Appends the particles requested by emitters after the alive particles, see Carrot::Particles::emit for the CPU version
+
+#include <includes/particle-simulation.glsl>
+
+layout (local_size_x = EMIT_GROUP_SIZE) in;
+
+const float PI = 3.14159265358979323846f;
+
+void main() {
+    uint requested = gl_GlobalInvocationID.x;
+    if(requested >= state.requestedCount) return;
+
+    uint slot = state.aliveCount + requested;
+    if(slot >= MAX_PARTICLE_COUNT) return;
+
+    // few emitters per system: a linear search is enough
+    uint requestIndex = 0;
+    while(requestIndex + 1 < state.emissionRequestCount && emissionRequests[requestIndex + 1].firstParticle <= requested) {
+        requestIndex++;
+    }
+
+    #define request emissionRequests[requestIndex]
+    uint id = request.firstID + (requested - request.firstParticle);
+
+    Particle particle;
+    particle.id = id;
+    particle.life = particleRandom(id, 0) > 0.5f ? PI * 2.0f * 10.0f : PI * 1.0f * 10.0f;
+    particle.size = 1.0f;
+    particle.position = vec3(request.positionX, request.positionY, request.positionZ);
+    particle.velocity = vec3(
+        particleRandom(id, 1) - 0.5f,
+        particleRandom(id, 2) - 0.5f,
+        1.0f + particleRandom(id, 3) * 1.5f
+    );
+    particles[slot] = particle;
+}
@@ -0,0 +1,12 @@
+//! Copies the particles back from the scratch buffer, in sorted order (back to front)
+
+#include <includes/particle-simulation.glsl>
+
+layout (local_size_x = UPDATE_GROUP_SIZE) in;
+
+void main() {
+    uint particleIndex = gl_GlobalInvocationID.x;
+    if(particleIndex >= state.aliveCount) return;
+
+    particles[particleIndex] = scratchParticles[sortEntries[particleIndex].index];
+}
@@ -0,0 +1,27 @@
+//! Single invocation pass updating the counters and indirect arguments used by the next passes of the particle simulation
+
+#include <includes/particle-simulation.glsl>
+
+layout (local_size_x = 1) in;
+
+const uint STAGE_AFTER_EMIT = 0;
+const uint STAGE_AFTER_COMPACT = 1;
+layout(constant_id = 1) const uint STAGE = STAGE_AFTER_EMIT;
+
+uint nextPowerOfTwo(uint value) {
+    if(value <= 1) return value;
+    return 1u << (findMSB(value - 1) + 1);
+}
+
+void main() {
+    if(STAGE == STAGE_AFTER_EMIT) {
+        state.aliveCount = min(state.aliveCount + state.requestedCount, MAX_PARTICLE_COUNT);
+        state.compactedCount = 0;
+    } else {
+        state.aliveCount = state.compactedCount;
+        state.sortCount = nextPowerOfTwo(state.aliveCount);
+        state.sortDispatch = DispatchArguments((state.sortCount / 2 + SORT_GROUP_SIZE - 1) / SORT_GROUP_SIZE, 1, 1);
+        state.draw = DrawArguments(6 * state.aliveCount, 1, 0, 0);
+    }
+    state.updateDispatch = DispatchArguments((state.aliveCount + UPDATE_GROUP_SIZE - 1) / UPDATE_GROUP_SIZE, 1, 1);
+}
@@ -0,0 +1,46 @@
+//! One step of a bitonic sort over the sort entries, see Carrot::Particles::bitonicSort for the CPU version
+
+#include <includes/particle-simulation.glsl>
+
+layout (local_size_x = SORT_GROUP_SIZE) in;
+
+layout(push_constant) uniform Push {
+    uint blockSize;
+    uint distance;
+} sortStep;
+
+bool greaterThan(SortEntry a, SortEntry b) {
+    return a.key > b.key || (a.key == b.key && a.index > b.index);
+}
+
+void main() {
+    // steps for blocks bigger than needed are still recorded (the count is only known by the GPU), but do nothing
+    if(sortStep.blockSize > state.sortCount) return;
+
+    uint thread = gl_GlobalInvocationID.x;
+    if(thread >= state.sortCount / 2) return;
+
+    uint low = (thread / sortStep.distance) * sortStep.distance * 2 + (thread % sortStep.distance);
+    uint high = low + sortStep.distance;
+
+    SortEntry a = sortEntries[low];
+    SortEntry b = sortEntries[high];
+    if(sortStep.blockSize == 2) { // first step: entries after the alive particles are not initialized yet
+        const SortEntry padding = SortEntry(0xFFFFFFFFu, 0xFFFFFFFFu);
+        if(low >= state.aliveCount) {
+            a = padding;
+        }
+        if(high >= state.aliveCount) {
+            b = padding;
+        }
+    }
+
+    bool ascending = (low & sortStep.blockSize) == 0;
+    if(greaterThan(a, b) == ascending) {
+        SortEntry tmp = a;
+        a = b;
+        b = tmp;
+    }
+    sortEntries[low] = a;
+    sortEntries[high] = b;
+}
@@ -0,0 +1,67 @@
+#include <includes/camera.glsl>
+#include <includes/instance-transforms.glsl>
+DEFINE_CAMERA_SET(0)
+
+// Per vertex
+layout(location = 0) in vec4 inPosition;
+layout(location = 1) in vec3 inColor;
+layout(location = 2) in vec3 inNormal;
+layout(location = 3) in vec4 inTangent;
+layout(location = 4) in vec2 inUV;
+
+// Per instance
+layout(location = 5) in vec4 inInstanceColor;
+layout(location = 6) in vec4 inInstanceTransformRows[3];
+layout(location = 9) in uint inPreviousTransformSlot;
+
+// Per instance, picking stream
+layout(location = 10) in uvec4 inUUID;
+
+// PREVIOUS_TRANSFORMS_SET must be defined by the including file, depends on the layout of the pipeline
+DEFINE_PREVIOUS_TRANSFORMS_SET(PREVIOUS_TRANSFORMS_SET)
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 uv;
+layout(location = 2) out vec4 instanceColor;
+layout(location = 3) out vec3 outViewPos;
+layout(location = 4) out vec3 outPreviousFrameViewPos;
+layout(location = 5) out vec3 _unused;
+layout(location = 6) flat out uvec4 outUUID;
+layout(location = 7) out vec3 T;
+layout(location = 8) out vec3 N;
+layout(location = 9) out float outBitangentSign;
+layout(location = 10) out flat mat4 outModelview;
+layout(location = 14) out flat int outDrawID;
+
+void main() {
+    outDrawID = gl_DrawID;
+
+    mat4 instanceTransform = affineToMatrix(inInstanceTransformRows);
+    mat4 lastFrameInstanceTransform = instanceTransform;
+    if(inPreviousTransformSlot != INVALID_TRANSFORM_SLOT) {
+        lastFrameInstanceTransform = affineToMatrix(previousInstanceTransforms[inPreviousTransformSlot].rows);
+    }
+
+    uv = inUV;
+    mat4 modelview = cbo.view * instanceTransform;
+    mat4 previousFrameModelview = previousFrameCBO.view * lastFrameInstanceTransform;
+    vec4 viewPosition = modelview * inPosition;
+    vec4 previousFrameViewPosition = previousFrameModelview * inPosition;
+    gl_Position = cbo.jitteredProjection * viewPosition;
+
+    fragColor = inColor;
+    instanceColor = inInstanceColor;
+    outViewPos = viewPosition.xyz / viewPosition.w;
+    outPreviousFrameViewPos = previousFrameViewPosition.xyz / previousFrameViewPosition.w;
+
+    vec3 t = normalize(inTangent.xyz);
+    vec3 n = normalize(inNormal);
+
+    N = normalize(mat3(modelview) * n);
+    T = normalize(mat3(modelview) * (t - dot(t, n) * n));
+
+    outBitangentSign = inTangent.w;
+
+    outUUID = inUUID;
+    outModelview = modelview;
+}
@@ -0,0 +1,2 @@
+#define PREVIOUS_TRANSFORMS_SET 4
+#include "gBuffer-compact-base.vertex.glsl"
\ No newline at end of file
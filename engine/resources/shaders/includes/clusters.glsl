@@ -1,3 +1,9 @@
+#include <includes/vertex-compression.glsl>
+
+// Keep in sync with ClusterManager.h
+#define CLUSTER_VERTEX_FORMAT_FULL 0
+#define CLUSTER_VERTEX_FORMAT_COMPRESSED 1
+
 struct Cluster {
     VertexBuffer vertices;
     IndexBuffer indices;
@@ -9,8 +15,28 @@ struct Cluster {
     vec4 parentBoundingSphere;
     float error;
     float parentError;
+    vec3 quantizationMin;
+    vec3 quantizationExtent;
+    uint vertexFormat;
 };
 
+// 'vertices' is either a VertexBuffer or a CompressedVertexBuffer, depending on vertexFormat
+Vertex loadClusterVertex(Cluster cluster, uint vertexIndex) {
+    if(cluster.vertexFormat == CLUSTER_VERTEX_FORMAT_COMPRESSED) {
+        CompressedVertexBuffer compressedVertices = CompressedVertexBuffer(uint64_t(cluster.vertices));
+        return decompressVertex(compressedVertices.v[vertexIndex], cluster.quantizationMin, cluster.quantizationExtent);
+    }
+    return cluster.vertices.v[vertexIndex];
+}
+
+vec4 loadClusterVertexPosition(Cluster cluster, uint vertexIndex) {
+    if(cluster.vertexFormat == CLUSTER_VERTEX_FORMAT_COMPRESSED) {
+        CompressedVertexBuffer compressedVertices = CompressedVertexBuffer(uint64_t(cluster.vertices));
+        return vec4(decompressPosition(compressedVertices.v[vertexIndex], cluster.quantizationMin, cluster.quantizationExtent), 1.0);
+    }
+    return cluster.vertices.v[vertexIndex].pos;
+}
+
 struct ClusterInstance {
     uint32_t clusterID;
     uint32_t materialIndex;
@@ -1,3 +1,5 @@
+#include <includes/gbuffer_packing.glsl>
+
 #define IntPropertiesRayTracedLighting          (1u << 0u)
 #define IntPropertiesNegativeViewNormalZ        (1u << 1u)
 #define IntPropertiesNegativeViewTangentZ       (1u << 2u)
@@ -1,3 +1,24 @@
+#if GBUFFER_PACKED
+// Positions are reconstructed from depth, with the camera bound at binding 7: binding 1 (view positions) is not used
+#define DEFINE_GBUFFER_INPUTS(setID)                                                                                    \
+layout(set = setID, binding = 0) uniform texture2D gAlbedo;                                                             \
+layout(set = setID, binding = 2) uniform utexture2D gViewNormalTangents;                                                \
+layout(set = setID, binding = 3) uniform usampler2D gIntPropertiesInput;                                                \
+layout(set = setID, binding = 4) uniform utexture2D gEntityID;                                                          \
+layout(set = setID, binding = 5) uniform texture2D gVelocity;                                                           \
+layout(set = setID, binding = 6) uniform texture2D gEmissive;                                                           \
+layout(set = setID, binding = 7) uniform GBufferCamera {                                                                \
+    mat4 view;                                                                                                          \
+    mat4 inverseView;                                                                                                   \
+    mat4 jitteredProjection;                                                                                            \
+    mat4 nonJitteredProjection;                                                                                         \
+    mat4 inverseJitteredProjection;                                                                                     \
+} gCamera;                                                                                                              \
+layout(set = setID, binding = 8) uniform texture2D gDepth;                                                              \
+layout(set = setID, binding = 9) uniform samplerCube gSkybox3D;                                                         \
+layout(set = setID, binding = 10) uniform sampler gLinearSampler;                                                       \
+layout(set = setID, binding = 11) uniform sampler gNearestSampler;
+#else
 #define DEFINE_GBUFFER_INPUTS(setID)                                                                                    \
 layout(set = setID, binding = 0) uniform texture2D gAlbedo;                                                             \
 layout(set = setID, binding = 1) uniform texture2D gViewPos;                                                            \
@@ -11,3 +32,4 @@ layout(set = setID, binding = 8) uniform texture2D gDepth;
 layout(set = setID, binding = 9) uniform samplerCube gSkybox3D;                                                         \
 layout(set = setID, binding = 10) uniform sampler gLinearSampler;                                                       \
 layout(set = setID, binding = 11) uniform sampler gNearestSampler;
+#endif
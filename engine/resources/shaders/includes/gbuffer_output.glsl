@@ -1,3 +1,12 @@
+#if GBUFFER_PACKED
+// must match PackedTargets inside GBuffer.cpp
+layout(location = 0) out vec4 outColor;
+layout(location = 1) out uvec2 outViewNormalTangent;
+layout(location = 2) out uint intProperty;
+layout(location = 3) out uvec4 entityID;
+layout(location = 4) out vec4 outVelocity;
+layout(location = 5) out vec3 outEmissive;
+#else
 layout(location = 0) out vec4 outColor;
 layout(location = 1) out vec4 outViewPosition;
 layout(location = 2) out vec4 outViewNormalTangent;
@@ -5,6 +14,7 @@ layout(location = 3) out uint intProperty;
 layout(location = 4) out uvec4 entityID;
 layout(location = 5) out vec4 metallicRoughnessVelocityXY;
 layout(location = 6) out vec4 emissiveVelocityZ;
+#endif
 
 GBuffer initGBuffer(mat4 modelview) {
     GBuffer gbuffer;
@@ -29,6 +39,20 @@ GBuffer initGBuffer(mat4 modelview) {
 
 void outputGBuffer(in GBuffer o, mat4 modelview) {
     outColor = o.albedo;
+#if GBUFFER_PACKED
+    // view position is reconstructed from depth
+    vec3 tangent = normalize(o.viewTBN[0]);
+    vec3 normal = normalize(o.viewTBN[2]);
+    outViewNormalTangent = packGBufferNormalTangent(normal, tangent);
+    if(dot(o.viewTBN[1], cross(tangent, normal)) < 0) {
+        o.intProperty |= IntPropertiesNegativeViewBitangent;
+    }
+
+    intProperty = packGBufferFlags(o.intProperty, o.metallicness, o.roughness);
+    entityID = o.entityID;
+    outVelocity = vec4(o.motionVector, 0.0);
+    outEmissive = max(o.emissiveColor, vec3(0.0));
+#else
     outViewPosition = vec4(o.viewPosition, 1.0);
 
     bool nSign = false;
@@ -52,4 +76,5 @@ void outputGBuffer(in GBuffer o, mat4 modelview) {
     entityID = o.entityID;
     metallicRoughnessVelocityXY = vec4(o.metallicness, o.roughness, o.motionVector.x, o.motionVector.y);
     emissiveVelocityZ = vec4(o.emissiveColor, o.motionVector.z);
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,80 @@
+// Packing functions of the packed GBuffer layout.
+// This file is shared between GLSL and C++ (included by engine/render/GBufferPacking.h), so it must only use the subset of GLSL which GLM also provides:
+//  no swizzles, no 'in'/'out' parameters, no struct constructors, float literals need the 'f' suffix
+#ifndef GBUFFER_PACKING_GLSL
+#define GBUFFER_PACKING_GLSL
+
+// 0 = standard layout: full float view positions and normals+tangents, separate flags, metallic+roughness and emissive targets
+// 1 = packed layout: positions reconstructed from depth, octahedral normal+tangent, metallic+roughness inside the flags, R11G11B10 emissive
+// Shaders using the GBuffer are compiled for both layouts by the build (GBUFFER_PACKED=1 for the variants inside packed-gbuffer/),
+// the engine selects the layout at runtime with Configuration::packedGBuffer
+#ifndef GBUFFER_PACKED
+#define GBUFFER_PACKED 0
+#endif
+
+#ifndef GBUFFER_PACKING_FUNCTION
+#define GBUFFER_PACKING_FUNCTION
+#endif
+
+// bits 0-7: IntProperties, bits 8-15: metallicness (unorm8), bits 16-23: roughness (unorm8)
+#define GBufferFlagsIntPropertiesMask   0xFFu
+#define GBufferFlagsMetallicShift       8u
+#define GBufferFlagsRoughnessShift      16u
+
+GBUFFER_PACKING_FUNCTION vec2 gbufferOctahedralEncode(vec3 n) {
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    vec2 encoded = vec2(n.x, n.y);
+    if(n.z < 0.0f) {
+        encoded = (1.0f - abs(vec2(n.y, n.x))) * vec2(n.x >= 0.0f ? 1.0f : -1.0f, n.y >= 0.0f ? 1.0f : -1.0f);
+    }
+    return encoded;
+}
+
+GBUFFER_PACKING_FUNCTION vec3 gbufferOctahedralDecode(vec2 encoded) {
+    vec3 n = vec3(encoded.x, encoded.y, 1.0f - abs(encoded.x) - abs(encoded.y));
+    float t = max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return normalize(n);
+}
+
+/// Normal and tangent as octahedral 2x snorm16 each. The sign of the bitangent is stored inside the flags (IntPropertiesNegativeViewBitangent)
+GBUFFER_PACKING_FUNCTION uvec2 packGBufferNormalTangent(vec3 normal, vec3 tangent) {
+    return uvec2(packSnorm2x16(gbufferOctahedralEncode(normal)), packSnorm2x16(gbufferOctahedralEncode(tangent)));
+}
+
+GBUFFER_PACKING_FUNCTION vec3 unpackGBufferNormal(uvec2 normalTangent) {
+    return gbufferOctahedralDecode(unpackSnorm2x16(normalTangent.x));
+}
+
+GBUFFER_PACKING_FUNCTION vec3 unpackGBufferTangent(uvec2 normalTangent) {
+    return gbufferOctahedralDecode(unpackSnorm2x16(normalTangent.y));
+}
+
+GBUFFER_PACKING_FUNCTION uint packGBufferFlags(uint intProperties, float metallicness, float roughness) {
+    uint metallic8 = uint(round(clamp(metallicness, 0.0f, 1.0f) * 255.0f));
+    uint roughness8 = uint(round(clamp(roughness, 0.0f, 1.0f) * 255.0f));
+    return (intProperties & GBufferFlagsIntPropertiesMask) | (metallic8 << GBufferFlagsMetallicShift) | (roughness8 << GBufferFlagsRoughnessShift);
+}
+
+GBUFFER_PACKING_FUNCTION uint unpackGBufferIntProperties(uint flags) {
+    return flags & GBufferFlagsIntPropertiesMask;
+}
+
+GBUFFER_PACKING_FUNCTION float unpackGBufferMetallicness(uint flags) {
+    return float((flags >> GBufferFlagsMetallicShift) & 0xFFu) / 255.0f;
+}
+
+GBUFFER_PACKING_FUNCTION float unpackGBufferRoughness(uint flags) {
+    return float((flags >> GBufferFlagsRoughnessShift) & 0xFFu) / 255.0f;
+}
+
+/// View space position of a pixel, from its depth (in [0; 1]) and the inverse of the projection used to render it.
+/// 'uv' is in [0; 1], (0,0) being the top-left corner
+GBUFFER_PACKING_FUNCTION vec3 reconstructViewPosition(vec2 uv, float depth, mat4 inverseProjection) {
+    vec4 ndc = vec4(uv.x * 2.0f - 1.0f, uv.y * 2.0f - 1.0f, depth, 1.0f);
+    vec4 viewPosition = inverseProjection * ndc;
+    return vec3(viewPosition.x, viewPosition.y, viewPosition.z) / viewPosition.w;
+}
+
+#endif // GBUFFER_PACKING_GLSL
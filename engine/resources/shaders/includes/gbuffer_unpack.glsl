@@ -1,3 +1,40 @@
+#if GBUFFER_PACKED
+/**
+* Unpacks gbuffer data, without emissive, metallic+roughness nor motion vectors (to reduce strain on texture memory)
+*/
+GBuffer unpackGBufferLight(vec2 uv) {
+    GBuffer gbuffer;
+
+    gbuffer.albedo = texture(sampler2D(gAlbedo, gLinearSampler), uv);
+    const float depth = texture(sampler2D(gDepth, gNearestSampler), uv).r;
+    // same as the cleared view positions of the standard layout
+    gbuffer.viewPosition = depth >= 1.0 ? vec3(0.0) : reconstructViewPosition(uv, depth, gCamera.inverseJitteredProjection);
+    const uint flags = uint(texture(gIntPropertiesInput, uv).r);
+    gbuffer.intProperty = unpackGBufferIntProperties(flags);
+
+    const uvec2 viewNormalTangents = texture(usampler2D(gViewNormalTangents, gNearestSampler), uv).rg;
+    const vec3 normal = unpackGBufferNormal(viewNormalTangents);
+    const vec3 tangent = unpackGBufferTangent(viewNormalTangents);
+    const bool negativeBitangent = (gbuffer.intProperty & IntPropertiesNegativeViewBitangent) == IntPropertiesNegativeViewBitangent;
+    const vec3 bitangent = cross(tangent, normal) * (negativeBitangent ? -1 : 1);
+    gbuffer.viewTBN = mat3(tangent, bitangent, normal);
+
+    gbuffer.entityID = texture(usampler2D(gEntityID, gNearestSampler), uv);
+
+    gbuffer.metallicness = unpackGBufferMetallicness(flags);
+    gbuffer.roughness = unpackGBufferRoughness(flags);
+    return gbuffer;
+}
+
+GBuffer unpackGBuffer(vec2 uv) {
+    GBuffer gbuffer = unpackGBufferLight(uv);
+
+    gbuffer.emissiveColor = texture(sampler2D(gEmissive, gNearestSampler), uv).rgb;
+    gbuffer.motionVector = texture(sampler2D(gVelocity, gNearestSampler), uv).xyz;
+
+    return gbuffer;
+}
+#else
 /**
 * Unpacks gbuffer data, without emissive, metallic+roughness nor motion vectors (to reduce strain on texture memory)
 */
@@ -32,4 +69,5 @@ GBuffer unpackGBuffer(vec2 uv) {
     gbuffer.motionVector = vec3(metallicRoughnessVelocityXY.zw, emissiveVelocityZ.w);
 
     return gbuffer;
-}
\ No newline at end of file
+}
+#endif
@@ -0,0 +1,19 @@
+// Instance transforms used by the VertexWithCompactInstanceData vertex format.
+// Keep in sync with core/render/TransformHistory.h and engine/render/InstanceData.h
+
+#define INVALID_TRANSFORM_SLOT 0xFFFFFFFFu
+
+// 3x4 affine transform, last row is implicitly (0,0,0,1)
+struct AffineTransform {
+    vec4 rows[3];
+};
+
+mat4 affineToMatrix(vec4 rows[3]) {
+    return transpose(mat4(rows[0], rows[1], rows[2], vec4(0, 0, 0, 1)));
+}
+
+// Transforms of the previous frame, indexed by the slot of the instance (see Render::InstanceTransformHistory)
+#define DEFINE_PREVIOUS_TRANSFORMS_SET(setID)                                                                       \
+layout(set = setID, binding = 0) readonly buffer PreviousInstanceTransforms {                                     \
+    AffineTransform previousInstanceTransforms[];                                                                   \
+};
@@ -0,0 +1,76 @@
+// GPU-side state of a particle system, see engine/render/particles/ParticleSimulation.h for the matching C++ structures
+
+struct DispatchArguments {
+    uint x;
+    uint y;
+    uint z;
+};
+
+struct DrawArguments {
+    uint vertexCount;
+    uint instanceCount;
+    uint firstVertex;
+    uint firstInstance;
+};
+
+struct EmissionRequest {
+    float positionX;
+    float positionY;
+    float positionZ;
+    uint count;
+    uint firstParticle;
+    uint firstID;
+};
+
+struct SortEntry {
+    uint key;
+    uint index;
+};
+
+const uint UPDATE_GROUP_SIZE = 1024;
+const uint EMIT_GROUP_SIZE = 64;
+const uint SORT_GROUP_SIZE = 256;
+
+// starts like ParticleStatistics: also bound as the statistics buffer of the blueprint update shaders
+layout(set = 0, binding = 0) buffer ParticleSimulationState {
+    float deltaTime;
+    uint aliveCount;
+
+    uint requestedCount;
+    uint emissionRequestCount;
+    float cameraX;
+    float cameraY;
+    float cameraZ;
+
+    uint compactedCount;
+    uint sortCount;
+    DispatchArguments updateDispatch;
+    DispatchArguments sortDispatch;
+    DrawArguments draw;
+} state;
+
+#include <includes/particles.glsl>
+
+layout(set = 0, binding = 2) buffer ScratchParticles {
+    Particle scratchParticles[MAX_PARTICLE_COUNT];
+};
+
+layout(set = 0, binding = 3) buffer SortEntries {
+    SortEntry sortEntries[];
+};
+
+layout(set = 0, binding = 4) readonly buffer EmissionRequests {
+    EmissionRequest emissionRequests[];
+};
+
+// PCG hash, same as Carrot::Particles::hash
+uint particleHash(uint value) {
+    uint state = value * 747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+// same as Carrot::Particles::randomFloat
+float particleRandom(uint id, uint stream) {
+    return float(particleHash(particleHash(id) ^ stream) >> 8u) / 16777216.0f;
+}
@@ -0,0 +1,59 @@
+// Decoding of the vertex formats of core/render/VertexCompression.h. Keep in sync!
+// Requires includes/buffers.glsl
+
+struct CompressedVertex {
+    uint positionXY; // 2x unorm16, inside the quantization bounds
+    uint positionZBitangentSign; // unorm16 + bitangent sign (0 if positive, 1 if negative)
+    uint normal; // octahedral, 2x snorm16
+    uint tangent; // octahedral, 2x snorm16
+    uint uv; // 2x half float
+    uint color; // 4x unorm8, alpha is unused
+};
+
+struct CompressedSkinnedVertex {
+    CompressedVertex base;
+    uint boneIDs; // 4x uint8
+    uint boneWeights; // 4x unorm8, sum to 1
+};
+
+layout(buffer_reference, scalar) buffer CompressedVertexBuffer {
+    CompressedVertex v[];
+};
+
+layout(buffer_reference, scalar) buffer CompressedSkinnedVertexBuffer {
+    CompressedSkinnedVertex v[];
+};
+
+vec3 decodeOctahedral(uint encoded) {
+    vec2 f = unpackSnorm2x16(encoded);
+    vec3 n = vec3(f.x, f.y, 1.0 - abs(f.x) - abs(f.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+vec3 decompressPosition(CompressedVertex compressed, vec3 boundsMin, vec3 boundsExtent) {
+    vec3 normalized = vec3(unpackUnorm2x16(compressed.positionXY), unpackUnorm2x16(compressed.positionZBitangentSign).x);
+    return boundsMin + normalized * boundsExtent;
+}
+
+Vertex decompressVertex(CompressedVertex compressed, vec3 boundsMin, vec3 boundsExtent) {
+    Vertex v;
+    v.pos = vec4(decompressPosition(compressed, boundsMin, boundsExtent), 1.0);
+    v.color = unpackUnorm4x8(compressed.color).rgb;
+    v.normal = decodeOctahedral(compressed.normal);
+    float bitangentSign = (compressed.positionZBitangentSign >> 16) != 0 ? -1.0 : 1.0;
+    v.tangent = vec4(decodeOctahedral(compressed.tangent), bitangentSign);
+    v.uv = unpackHalf2x16(compressed.uv);
+    return v;
+}
+
+uvec4 decompressBoneIDs(CompressedSkinnedVertex compressed) {
+    uint ids = compressed.boneIDs;
+    return uvec4(ids & 0xFFu, (ids >> 8) & 0xFFu, (ids >> 16) & 0xFFu, (ids >> 24) & 0xFFu);
+}
+
+vec4 decompressBoneWeights(CompressedSkinnedVertex compressed) {
+    return unpackUnorm4x8(compressed.boneWeights);
+}
@@ -124,7 +124,7 @@ void main() {
     uint clusterID = instances[instanceIndex].clusterID;
     uint materialIndex = instances[instanceIndex].materialIndex;
 
-#define getVertex(n) (clusters[clusterID].vertices.v[clusters[clusterID].indices.i[(n)]])
+#define getVertex(n) (loadClusterVertex(clusters[clusterID], clusters[clusterID].indices.i[(n)]))
     Vertex vA = getVertex(triangleIndex * 3 + 0);
     Vertex vB = getVertex(triangleIndex * 3 + 1);
     Vertex vC = getVertex(triangleIndex * 3 + 2);
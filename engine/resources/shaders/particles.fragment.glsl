@@ -1,13 +1,9 @@
 #extension GL_EXT_nonuniform_qualifier : enable
 
 #include "includes/gbuffer.glsl"
+#include "includes/gbuffer_output.glsl"
 #include "includes/particles.glsl"
 
-layout(location = 0) out vec4 outColor;
-layout(location = 1) out vec3 outViewPosition;
-layout(location = 2) out vec3 outNormal;
-layout(location = 3) out uint outIntProperties;
-
 layout(location = 0) in flat uint particleIndex;
 layout(location = 1) in vec2 inFragPosition;
 
@@ -20,6 +16,8 @@ void main() {
     c.b = mod(sin(particleIndex) / 100.0, 1.0);
     c.a = abs(particleIndex);
     c.r = exp(particleIndex);
-    outColor = c;
-    outIntProperties = 0;
+
+    GBuffer o = initGBuffer(mat4(1.0));
+    o.albedo = c;
+    outputGBuffer(o, mat4(1.0));
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 
 layout(set = 0, binding = 0) uniform texture2D currentFrame;
 layout(set = 0, binding = 1) uniform texture2D previousFrame;
+// with the packed GBuffer layout, these are the depth buffers of the current and previous frames
 layout(set = 0, binding = 2) uniform texture2D currentViewPos;
 layout(set = 0, binding = 3) uniform texture2D previousViewPos;
 
@@ -27,6 +28,19 @@ layout(location = 0) out vec4 outColor;
 layout(location = 1) out vec4 outMomentHistoryHistoryLength;
 layout(location = 2) out vec4 outFirstSpatialDenoiseForNextFrame;
 
+// w is 0 for the sky
+vec4 sampleViewPosition(texture2D viewPosTexture, vec2 uv, mat4 inverseProjection) {
+#if GBUFFER_PACKED
+    const float depth = texture(sampler2D(viewPosTexture, nearestSampler), uv).r;
+    if(depth >= 1.0) {
+        return vec4(0.0);
+    }
+    return vec4(reconstructViewPosition(uv, depth, inverseProjection), 1.0);
+#else
+    return texture(sampler2D(viewPosTexture, linearSampler), uv);
+#endif
+}
+
 vec4 AdjustHDRColor(vec4 color)
 {
     /*float luminance = dot(color.rgb, vec3(0.299, 0.587, 0.114));
@@ -39,7 +53,7 @@ void main() {
     GBuffer gbuffer = unpackGBuffer(uv);
     vec4 currentFrameColor = AdjustHDRColor(texture(sampler2D(currentFrame, linearSampler), uv));
 
-    vec4 viewSpacePosH = texture(sampler2D(currentViewPos, linearSampler), uv);
+    vec4 viewSpacePosH = sampleViewPosition(currentViewPos, uv, cbo.inverseJitteredProjection);
     bool isSkybox = viewSpacePosH.w <= 0.01f;
 
     if(isSkybox) {
@@ -60,7 +74,7 @@ void main() {
     prevNDC.xyz /= prevNDC.w;
 
     vec2 reprojectedUV = (prevNDC.xy + gbuffer.motionVector.xy) / 2.0 + 0.5;
-    vec4 previousViewSpacePos = texture(sampler2D(previousViewPos, linearSampler), reprojectedUV);
+    vec4 previousViewSpacePos = sampleViewPosition(previousViewPos, reprojectedUV, previousFrameCBO.inverseJitteredProjection);
     vec4 hPreviousWorldSpacePos = previousFrameCBO.inverseView * previousViewSpacePos;
 
     float reprojected = exp(-distance(hPreviousWorldSpacePos.xyz, hWorldSpacePos.xyz) * 200);
@@ -0,0 +1,37 @@
+#extension GL_EXT_nonuniform_qualifier : enable
+
+#include "includes/materials.glsl"
+#include <includes/gbuffer.glsl>
+#include "includes/gbuffer_output.glsl"
+#include "draw_data.glsl"
+
+MATERIAL_SYSTEM_SET(0)
+// 1 used by vertex shader
+DEFINE_PER_DRAW_BUFFER(2)
+
+layout(location = 0) in vec4 fragColor;
+layout(location = 1) in vec2 uv;
+layout(location = 2) in vec4 instanceColor;
+layout(location = 3) in vec3 viewPosition;
+layout(location = 4) flat in uvec4 inUUID;
+layout(location = 5) flat in mat4 inModelview;
+layout(location = 9) flat in int inDrawID;
+
+void main() {
+    // one draw per atlas page, see SpriteBatcher::submit
+    DrawData instanceDrawData = perDrawData.drawData[perDrawDataOffsets.offset+inDrawID];
+    Material material = materials[instanceDrawData.materialIndex];
+    uint albedoTexture = nonuniformEXT(material.albedo);
+    vec4 texColor = texture(sampler2D(textures[albedoTexture], linearSampler), uv);
+    if(texColor.a < 0.01) {
+        discard;
+    }
+
+    GBuffer o = initGBuffer(inModelview);
+    o.albedo = texColor * fragColor * instanceColor;
+    o.viewPosition = viewPosition;
+    o.intProperty = IntPropertiesRayTracedLighting;
+    o.entityID = inUUID;
+
+    outputGBuffer(o, inModelview);
+}
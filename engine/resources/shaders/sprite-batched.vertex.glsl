@@ -0,0 +1,35 @@
+#include <includes/camera.glsl>
+#include <includes/instance-transforms.glsl>
+DEFINE_CAMERA_SET(1)
+
+// Per vertex (quad centered on origin, see Sprite::getSpriteMesh)
+layout(location = 0) in vec3 inPosition;
+
+// Per sprite, see SpriteInstanceData
+layout(location = 1) in vec4 inInstanceColor;
+layout(location = 2) in uvec4 inUUID;
+layout(location = 3) in vec4 inInstanceTransformRows[3];
+layout(location = 6) in vec4 inUVRect; // xy = min, zw = max, in UV of the atlas page
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out vec2 uv;
+layout(location = 2) out vec4 instanceColor;
+layout(location = 3) out vec3 outViewPos;
+layout(location = 4) out flat uvec4 outUUID;
+layout(location = 5) out flat mat4 outModelview;
+layout(location = 9) out flat int outDrawID;
+
+void main() {
+    outDrawID = gl_DrawID;
+    uv = mix(inUVRect.xy, inUVRect.zw, inPosition.xy + vec2(0.5));
+
+    mat4 modelview = cbo.view * affineToMatrix(inInstanceTransformRows);
+    vec4 viewPosition = modelview * vec4(inPosition, 1.0);
+    gl_Position = cbo.jitteredProjection * viewPosition;
+
+    fragColor = vec4(1.0);
+    instanceColor = inInstanceColor;
+    outViewPos = viewPosition.xyz;
+    outUUID = inUUID;
+    outModelview = modelview;
+}
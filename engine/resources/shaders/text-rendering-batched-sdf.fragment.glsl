@@ -0,0 +1,2 @@
+#define SDF_TEXT
+#include "text-rendering-batched.fragment.glsl"
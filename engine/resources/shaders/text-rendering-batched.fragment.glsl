@@ -0,0 +1,49 @@
+#extension GL_EXT_nonuniform_qualifier : enable
+
+#include "includes/materials.glsl"
+#include <includes/gbuffer.glsl>
+#include "includes/gbuffer_output.glsl"
+#include "draw_data.glsl"
+
+MATERIAL_SYSTEM_SET(0)
+// 1 used by vertex shader
+DEFINE_PER_DRAW_BUFFER(2)
+
+layout(location = 0) in vec4 fragColor;
+layout(location = 1) in vec2 texelCoords;
+layout(location = 2) in vec4 instanceColor;
+layout(location = 3) in vec3 viewPosition;
+layout(location = 4) flat in uvec4 inUUID;
+layout(location = 5) flat in mat4 inModelview;
+layout(location = 9) flat in int inDrawID;
+
+void main() {
+    DrawData instanceDrawData = perDrawData.drawData[perDrawDataOffsets.offset+inDrawID];
+    Material material = materials[instanceDrawData.materialIndex];
+    uint albedoTexture = nonuniformEXT(material.albedo);
+
+    // glyph atlas can grow between frames, texel coordinates stay valid but UVs do not
+    vec2 atlasSize = vec2(textureSize(sampler2D(textures[albedoTexture], linearSampler), 0));
+    float value = texture(sampler2D(textures[albedoTexture], linearSampler), texelCoords / atlasSize).r;
+
+#ifdef SDF_TEXT
+    // distance fields are generated with the outline at 128/255
+    const float onEdge = 128.0 / 255.0;
+    float smoothing = fwidth(value) * 0.75;
+    float coverage = smoothstep(onEdge - smoothing, onEdge + smoothing, value);
+#else
+    float coverage = value;
+#endif
+
+    if(coverage < 0.01) {
+        discard;
+    }
+
+    GBuffer o = initGBuffer(inModelview);
+    o.albedo = vec4(1.0, 1.0, 1.0, coverage) * fragColor * instanceColor;
+    o.viewPosition = viewPosition;
+    o.intProperty = IntPropertiesRayTracedLighting;
+    o.entityID = inUUID;
+
+    outputGBuffer(o, inModelview);
+}
@@ -0,0 +1,38 @@
+#include <includes/camera.glsl>
+DEFINE_CAMERA_SET(1)
+
+// Per vertex (unit quad)
+layout(location = 0) in vec3 inPosition;
+
+// Per glyph
+layout(location = 1) in vec4 inInstanceColor;
+layout(location = 2) in uvec4 inUUID;
+layout(location = 3) in mat4 inInstanceTransform;
+layout(location = 7) in vec4 inGlyphRect; // xy = min, zw = max, in text space
+layout(location = 8) in vec4 inTexelRect; // xy = top-left, zw = bottom-right, in atlas texels
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out vec2 texelCoords;
+layout(location = 2) out vec4 instanceColor;
+layout(location = 3) out vec3 outViewPos;
+layout(location = 4) out flat uvec4 outUUID;
+layout(location = 5) out flat mat4 outModelview;
+layout(location = 9) out flat int outDrawID;
+
+void main() {
+    outDrawID = gl_DrawID;
+    vec2 localPosition = mix(inGlyphRect.xy, inGlyphRect.zw, inPosition.xy);
+
+    // bottom of quad samples bottom of glyph, which is the max Y in atlas
+    texelCoords = vec2(mix(inTexelRect.x, inTexelRect.z, inPosition.x), mix(inTexelRect.w, inTexelRect.y, inPosition.y));
+
+    mat4 modelview = cbo.view * inInstanceTransform;
+    vec4 viewPosition = modelview * vec4(localPosition, 0.0, 1.0);
+    gl_Position = cbo.jitteredProjection * viewPosition;
+
+    fragColor = vec4(1.0);
+    instanceColor = inInstanceColor;
+    outViewPos = viewPosition.xyz;
+    outUUID = inUUID;
+    outModelview = modelview;
+}
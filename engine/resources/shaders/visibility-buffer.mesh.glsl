@@ -2,6 +2,7 @@
 #extension GL_EXT_shader_explicit_arithmetic_types_int8 : require
 #extension GL_EXT_shader_explicit_arithmetic_types_int16 : require
 #extension GL_EXT_shader_explicit_arithmetic_types_int32 : require
+#extension GL_EXT_shader_explicit_arithmetic_types_int64 : require
 #extension GL_EXT_buffer_reference : require
 #extension GL_EXT_buffer_reference2 : require
 #extension GL_EXT_scalar_block_layout : require
@@ -71,7 +72,7 @@ void main() {
 
     const mat4 viewProj = cbo.jitteredProjection * modelview;
     for(uint vertexIndex = gl_LocalInvocationIndex; vertexIndex < cluster.vertexCount; vertexIndex += MESH_WORKGROUP_SIZE) {
-        const vec4 ndcPosition = viewProj * cluster.vertices.v[vertexIndex].pos;
+        const vec4 ndcPosition = viewProj * loadClusterVertexPosition(cluster, vertexIndex);
         gl_MeshVerticesEXT[vertexIndex].gl_Position = ndcPosition;
         outNDCPosition[vertexIndex] = ndcPosition;
         outClusterInstanceID[vertexIndex] = instanceID;
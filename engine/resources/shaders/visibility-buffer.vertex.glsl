@@ -1,6 +1,7 @@
 #extension GL_EXT_shader_explicit_arithmetic_types_int8 : require
 #extension GL_EXT_shader_explicit_arithmetic_types_int16 : require
 #extension GL_EXT_shader_explicit_arithmetic_types_int32 : require
+#extension GL_EXT_shader_explicit_arithmetic_types_int64 : require
 #extension GL_EXT_buffer_reference : require
 #extension GL_EXT_buffer_reference2 : require
 #extension GL_EXT_scalar_block_layout : require
@@ -40,11 +41,11 @@ void main() {
     instanceID = instanceDrawData.uuid0;
     uint clusterID = instances[instanceID].clusterID;
     uint modelDataIndex = instances[instanceID].instanceDataIndex;
-    Vertex vertex = clusters[clusterID].vertices.v[clusters[clusterID].indices.i[gl_VertexIndex]];
+    vec4 vertexPosition = loadClusterVertexPosition(clusters[clusterID], clusters[clusterID].indices.i[gl_VertexIndex]);
 
     mat4 modelview = cbo.view * modelData[modelDataIndex].transform * clusters[clusterID].transform;
 
-    vec4 viewPosition = modelview * vertex.pos;
+    vec4 viewPosition = modelview * vertexPosition;
 
     ndcPosition = cbo.jitteredProjection * viewPosition;
     gl_Position = ndcPosition;
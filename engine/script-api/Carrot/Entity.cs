@@ -1,6 +1,7 @@
 ﻿using System;
 using System.Collections.Generic;
 using System.Runtime.CompilerServices;
+using System.Threading;
 using static Carrot.Utilities;
 
 namespace Carrot {
@@ -19,6 +20,9 @@ namespace Carrot {
             this._userPointer = userPointer;
         }
 
+        internal EntityID ID => _id;
+        internal UInt64 UserPointer => _userPointer;
+
         public override string ToString() { 
             return GetName();
         }
@@ -135,7 +139,23 @@ namespace Carrot {
          * Returns the component on this entity corresponding to the given type, or null if none.
          */
         public T GetComponent<T>() where T : IComponent {
-            return (T)GetComponent(typeof(T));
+            // wrappers are cached per entity object: avoids marshalling the type name and allocating a new wrapper on each call
+            int slot = ComponentTypeCache<T>.Slot;
+            if (_componentCache != null && slot < _componentCache.Length) {
+                IComponent cached = _componentCache[slot];
+                if (cached != null && _HasComponent(_id, _userPointer, ComponentTypeCache<T>.ID)) {
+                    return (T)cached;
+                }
+            }
+
+            T component = (T)GetComponent(typeof(T));
+            if (component != null) {
+                if (_componentCache == null || slot >= _componentCache.Length) {
+                    Array.Resize(ref _componentCache, Math.Max(slot + 1, _componentCacheSlotCount));
+                }
+                _componentCache[slot] = component;
+            }
+            return component;
         }
 
         /**
@@ -151,5 +171,22 @@ namespace Carrot {
 
         [MethodImpl(MethodImplOptions.InternalCall)]
         private extern IComponent GetComponent(string namespaceName, string className);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern UInt64 _GetComponentID(string namespaceName, string className);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern bool _HasComponent(EntityID entity, UInt64 userPointer, UInt64 componentID);
+
+        private IComponent[] _componentCache; // indexed by ComponentTypeCache<T>.Slot
+        private static int _componentCacheSlotCount = 0;
+
+        /**
+         * Per component type values, computed once per type
+         */
+        private static class ComponentTypeCache<T> where T : IComponent {
+            public static readonly UInt64 ID = _GetComponentID(typeof(T).Namespace, typeof(T).Name);
+            public static readonly int Slot = Interlocked.Increment(ref _componentCacheSlotCount) - 1;
+        }
     }
 }
@@ -1,9 +1,19 @@
 ﻿using System;
 using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
 using Carrot.ComponentPropertyAttributes;
 using Carrot.Physics;
 
 namespace Carrot {
+    /**
+     * Blittable state of a rigidbody, read and written with a single internal call
+     */
+    [StructLayout(LayoutKind.Sequential)]
+    public struct RigidBodyState {
+        public TransformData WorldTransform;
+        public Vec3 Velocity;
+    }
+
     /**
      * Represents the rigidbody attached to an entity
      */
@@ -14,6 +24,17 @@ namespace Carrot {
             set => _SetVelocity(value);
         }
             
+        /**
+         * World transform and velocity of the body. Setting it teleports the body
+         */
+        public RigidBodyState State {
+            get {
+                _GetState(owner.ID, owner.UserPointer, out RigidBodyState state);
+                return state;
+            }
+            set => _SetState(owner.ID, owner.UserPointer, ref value);
+        }
+
         private RigidBodyComponent(Entity owner) : base(owner) { }
 
         [MethodImpl(MethodImplOptions.InternalCall)]
@@ -36,5 +57,11 @@ namespace Carrot {
 
         [MethodImpl(MethodImplOptions.InternalCall)]
         private extern void _SetVelocity(Vec3 v);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern void _GetState(EntityID entity, UInt64 userPointer, out RigidBodyState state);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern void _SetState(EntityID entity, UInt64 userPointer, ref RigidBodyState state);
     }
 }
@@ -1,11 +1,39 @@
 ﻿using System;
 using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
 using Carrot.ComponentPropertyAttributes;
 
 namespace Carrot {
+    /**
+     * Blittable view of a transform, same layout as Carrot::Math::Transform
+     */
+    [StructLayout(LayoutKind.Sequential)]
+    public struct TransformData {
+        public Vec3 Position;
+        public Vec3 Scale;
+        public Quat Rotation;
+    }
+
     [InternalComponent]
     public class TransformComponent: IComponent {
 
+        /**
+         * Local transform of this entity, read and written in place inside the engine memory (no copy, single internal call).
+         * Faster than LocalPosition & co. when accessing multiple values, for example:
+         *  ref TransformData t = ref transform.LocalTransform;
+         *  t.Position.X += 1.0f;
+         * The reference must not be kept after the component is removed, get it again each tick.
+         */
+        public unsafe ref TransformData LocalTransform {
+            get {
+                IntPtr pointer = _GetLocalTransformPointer(owner.ID, owner.UserPointer);
+                if (pointer == IntPtr.Zero) {
+                    throw new InvalidOperationException("Entity has no TransformComponent");
+                }
+                return ref *(TransformData*)pointer;
+            }
+        }
+
         public Vec3 LocalPosition {
             get => _GetLocalPosition();
             set => _SetLocalPosition(value);
@@ -57,5 +85,8 @@ namespace Carrot {
         [MethodImpl(MethodImplOptions.InternalCall)]
         private extern Vec3 _GetWorldPosition();
 
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern IntPtr _GetLocalTransformPointer(EntityID entity, UInt64 userPointer);
+
     }
 }
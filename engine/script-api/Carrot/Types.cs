@@ -135,6 +135,23 @@ namespace Carrot {
         }
     }
     
+    /**
+     * Quaternion, same layout as glm::quat (X, Y, Z, W)
+     */
+    public struct Quat {
+        public float X;
+        public float Y;
+        public float Z;
+        public float W;
+        
+        public Quat(float x, float y, float z, float w) {
+            this.X = x;
+            this.Y = y;
+            this.Z = z;
+            this.W = w;
+        }
+    }
+    
     public struct EntityID {
         private UInt32 data0;
         private UInt32 data1;
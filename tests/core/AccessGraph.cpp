@@ -0,0 +1,96 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <core/tasks/AccessGraph.h>
+
+using namespace Carrot::Async;
+
+static ResourceAccess makeAccess(std::initializer_list<std::size_t> reads, std::initializer_list<std::size_t> writes) {
+    ResourceAccess access;
+    access.exclusive = false;
+    for(std::size_t r : reads) {
+        access.reads.set(r);
+    }
+    for(std::size_t w : writes) {
+        access.writes.set(w);
+    }
+    return access;
+}
+
+TEST(AccessGraph, Conflicts) {
+    EXPECT_FALSE(makeAccess({0}, {}).conflictsWith(makeAccess({0}, {}))); // both read
+    EXPECT_TRUE(makeAccess({0}, {}).conflictsWith(makeAccess({}, {0}))); // read-write
+    EXPECT_TRUE(makeAccess({}, {0}).conflictsWith(makeAccess({0}, {}))); // write-read
+    EXPECT_TRUE(makeAccess({}, {0}).conflictsWith(makeAccess({}, {0}))); // write-write
+    EXPECT_FALSE(makeAccess({0}, {1}).conflictsWith(makeAccess({2}, {3})));
+
+    ResourceAccess exclusive;
+    EXPECT_TRUE(exclusive.conflictsWith(makeAccess({}, {})));
+    EXPECT_TRUE(makeAccess({}, {}).conflictsWith(exclusive));
+}
+
+TEST(AccessGraph, IndependentNodesRunTogether) {
+    std::vector<ResourceAccess> nodes {
+        makeAccess({0}, {1}),
+        makeAccess({0}, {2}),
+        makeAccess({0}, {3}),
+    };
+    AccessGraph graph { nodes };
+    EXPECT_EQ(graph.getLevelCount(), 1);
+    for(std::size_t i = 0; i < nodes.size(); i++) {
+        EXPECT_TRUE(graph.getDependencies(i).empty());
+        EXPECT_EQ(graph.getLevel(i), 0);
+    }
+}
+
+TEST(AccessGraph, KeepsOnlyDirectDependencies) {
+    // all nodes write the same resource: they must run in order
+    std::vector<ResourceAccess> nodes {
+        makeAccess({}, {0}),
+        makeAccess({}, {0}),
+        makeAccess({}, {0}),
+    };
+    AccessGraph graph { nodes };
+    EXPECT_EQ(graph.getLevelCount(), 3);
+    ASSERT_EQ(graph.getDependencies(2).size(), 1);
+    EXPECT_EQ(graph.getDependencies(2)[0], 1); // 0 -> 2 is implied by 0 -> 1 -> 2
+    ASSERT_EQ(graph.getDependents(0).size(), 1);
+    EXPECT_EQ(graph.getDependents(0)[0], 1);
+}
+
+TEST(AccessGraph, ExclusiveNodesSplitTheGraph) {
+    std::vector<ResourceAccess> nodes {
+        makeAccess({}, {0}),
+        makeAccess({}, {1}),
+        ResourceAccess{}, // did not declare its accesses
+        makeAccess({}, {2}),
+    };
+    AccessGraph graph { nodes };
+    EXPECT_EQ(graph.getLevel(0), 0);
+    EXPECT_EQ(graph.getLevel(1), 0);
+    EXPECT_EQ(graph.getLevel(2), 1);
+    EXPECT_EQ(graph.getLevel(3), 2);
+    EXPECT_EQ(graph.getDependencies(2).size(), 2);
+}
+
+TEST(AccessGraph, CriticalPath) {
+    // 0 and 1 are independent, 2 needs both
+    std::vector<ResourceAccess> nodes {
+        makeAccess({}, {0}),
+        makeAccess({}, {1}),
+        makeAccess({0, 1}, {2}),
+    };
+    AccessGraph graph { nodes };
+
+    std::vector<double> durations { 1.0, 5.0, 1.0 };
+    EXPECT_EQ(graph.computeCriticalPath(durations), (std::vector<std::size_t>{ 1, 2 }));
+
+    durations = { 5.0, 1.0, 1.0 };
+    EXPECT_EQ(graph.computeCriticalPath(durations), (std::vector<std::size_t>{ 0, 2 }));
+
+    durations = { 1.0, 1.0, 0.0 };
+    EXPECT_EQ(graph.computeCriticalPath(durations).size(), 2);
+}
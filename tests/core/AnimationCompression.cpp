@@ -0,0 +1,154 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <core/render/AnimationCompression.h>
+#include <core/render/AnimationSampler.h>
+#include <core/utils/Assert.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace Carrot;
+
+static glm::mat4 makeTransform(const glm::vec3& translation, float angle, const glm::vec3& axis, float scale) {
+    return glm::scale(glm::rotate(glm::translate(glm::mat4{1.0f}, translation), angle, axis), glm::vec3 { scale });
+}
+
+/// bone 0 does not move, bone 1 translates linearly, bone 2 rotates (non-linearly) and scales
+static Animation makeAnimation(std::size_t keyframeCount) {
+    Animation animation;
+    animation.keyframeCount = static_cast<std::int32_t>(keyframeCount);
+    animation.duration = 2.0f;
+    for(std::size_t i = 0; i < keyframeCount; i++) {
+        const float t = static_cast<float>(i) / static_cast<float>(keyframeCount - 1);
+        Keyframe& keyframe = animation.keyframes.emplace_back(t * animation.duration);
+        keyframe.boneTransforms = {
+            makeTransform(glm::vec3 { 1.0f, 2.0f, 3.0f }, 0.5f, glm::vec3 { 0, 0, 1 }, 1.0f),
+            makeTransform(glm::vec3 { t * 10.0f, 0.0f, 0.0f }, 0.0f, glm::vec3 { 0, 0, 1 }, 1.0f),
+            makeTransform(glm::vec3 { 0.0f, std::sin(t * 6.0f), 0.0f }, t * 3.0f, glm::normalize(glm::vec3 { 1, 1, 0 }), 1.0f + t),
+        };
+    }
+    return animation;
+}
+
+static void expectNear(const glm::mat4& a, const glm::mat4& b, float tolerance) {
+    for(int column = 0; column < 4; column++) {
+        for(int row = 0; row < 4; row++) {
+            EXPECT_NEAR(a[column][row], b[column][row], tolerance) << "column " << column << ", row " << row;
+        }
+    }
+}
+
+TEST(AnimationCompression, PoseRoundTrip) {
+    const glm::mat4 transform = makeTransform(glm::vec3 { 1, -2, 3 }, 1.2f, glm::normalize(glm::vec3 { 0, 1, 1 }), 2.5f);
+    expectNear(BonePose::fromMatrix(transform).toMatrix(), transform, 1e-5f);
+
+    const glm::mat4 mirrored = glm::scale(transform, glm::vec3 { -1, 1, 1 });
+    expectNear(BonePose::fromMatrix(mirrored).toMatrix(), mirrored, 1e-5f);
+}
+
+TEST(AnimationCompression, RemovesRedundantKeys) {
+    const Animation animation = makeAnimation(61);
+    const CompressedAnimation compressed = CompressedAnimation::compress(animation);
+    ASSERT_EQ(compressed.getBoneCount(), 3);
+
+    const auto tracks = compressed.getTracks();
+    // constant
+    EXPECT_EQ(tracks[0].translation.keyCount, 1);
+    EXPECT_EQ(tracks[0].rotation.keyCount, 1);
+    EXPECT_EQ(tracks[0].scale.keyCount, 1);
+    // linear
+    EXPECT_EQ(tracks[1].translation.keyCount, 2);
+    EXPECT_EQ(tracks[1].rotation.keyCount, 1);
+    // non-linear, keys are kept but not all of them
+    EXPECT_GT(tracks[2].translation.keyCount, 2);
+    EXPECT_LT(tracks[2].translation.keyCount, 61);
+    EXPECT_EQ(tracks[2].scale.keyCount, 2);
+
+    EXPECT_LT(compressed.getMemorySize() * 4, CompressedAnimation::getUncompressedMemorySize(animation));
+}
+
+TEST(AnimationCompression, SamplingStaysWithinTolerance) {
+    const Animation animation = makeAnimation(61);
+    AnimationCompressionSettings settings;
+    settings.translationTolerance = 0.001f;
+    settings.rotationTolerance = 0.001f;
+    settings.scaleTolerance = 0.001f;
+    const CompressedAnimation compressed = CompressedAnimation::compress(animation, settings);
+
+    std::vector<BonePose> poses(compressed.getBoneCount());
+    // the last keyframe is skipped: its timestamp is the duration of the animation, which wraps to the first keyframe
+    for(std::size_t keyframeIndex = 0; keyframeIndex + 1 < animation.keyframes.size(); keyframeIndex++) {
+        const Keyframe& keyframe = animation.keyframes[keyframeIndex];
+        AnimationSampler::sample(compressed, keyframe.timestamp, poses);
+        for(std::size_t boneIndex = 0; boneIndex < poses.size(); boneIndex++) {
+            const BonePose expected = BonePose::fromMatrix(keyframe.boneTransforms[boneIndex]);
+            for(int i = 0; i < 3; i++) {
+                EXPECT_NEAR(poses[boneIndex].translation[i], expected.translation[i], settings.translationTolerance);
+                EXPECT_NEAR(poses[boneIndex].scale[i], expected.scale[i], settings.scaleTolerance);
+            }
+            // rotations are normalized after interpolation, which can slightly increase the error
+            EXPECT_GT(std::abs(glm::dot(poses[boneIndex].rotation, expected.rotation)), 1.0f - settings.rotationTolerance);
+        }
+    }
+}
+
+TEST(AnimationCompression, InterpolatesBetweenKeyframes) {
+    const CompressedAnimation compressed = CompressedAnimation::compress(makeAnimation(5));
+
+    std::vector<BonePose> poses(compressed.getBoneCount());
+    AnimationSampler::sample(compressed, 0.25, poses);
+    EXPECT_NEAR(poses[1].translation.x, 1.25f, 0.001f);
+
+    // animations loop
+    AnimationSampler::sample(compressed, 2.25, poses);
+    EXPECT_NEAR(poses[1].translation.x, 1.25f, 0.001f);
+    AnimationSampler::sample(compressed, -0.25, poses);
+    EXPECT_NEAR(poses[1].translation.x, 8.75f, 0.001f);
+}
+
+TEST(AnimationCompression, Blending) {
+    const CompressedAnimation compressed = CompressedAnimation::compress(makeAnimation(5));
+
+    std::vector<BonePose> start(compressed.getBoneCount());
+    std::vector<BonePose> end(compressed.getBoneCount());
+    AnimationSampler::sample(compressed, 0.0, start);
+    AnimationSampler::sample(compressed, 1.0, end);
+
+    // weights are normalized
+    const AnimationLayer layers[] = {
+        { .pAnimation = &compressed, .time = 0.0, .weight = 3.0f },
+        { .pAnimation = &compressed, .time = 1.0, .weight = 1.0f },
+    };
+    std::vector<BonePose> blended(compressed.getBoneCount());
+    AnimationSampler::sampleBlended(layers, blended);
+    EXPECT_NEAR(blended[1].translation.x, glm::mix(start[1].translation.x, end[1].translation.x, 0.25f), 0.001f);
+    EXPECT_NEAR(blended[2].scale.x, glm::mix(start[2].scale.x, end[2].scale.x, 0.25f), 0.001f);
+    EXPECT_NEAR(glm::length(blended[2].rotation), 1.0f, 1e-5f);
+
+    // layers with a weight of 0 are ignored
+    const AnimationLayer ignored[] = {
+        { .pAnimation = &compressed, .time = 1.0, .weight = 0.0f },
+        { .pAnimation = &compressed, .time = 0.0, .weight = 1.0f },
+    };
+    AnimationSampler::sampleBlended(ignored, blended);
+    EXPECT_NEAR(blended[1].translation.x, start[1].translation.x, 1e-5f);
+
+    const AnimationLayer noWeight[] = {
+        { .pAnimation = &compressed, .time = 1.0, .weight = 0.0f },
+    };
+    EXPECT_THROW(AnimationSampler::sampleBlended(noWeight, blended), Carrot::Assertions::Error);
+}
+
+TEST(AnimationCompression, SkinningPaletteMatchesOriginal) {
+    const Animation animation = makeAnimation(31);
+    const CompressedAnimation compressed = CompressedAnimation::compress(animation);
+
+    std::vector<glm::mat4> palette(compressed.getBoneCount());
+    const AnimationLayer layer { .pAnimation = &compressed, .time = animation.keyframes[7].timestamp };
+    AnimationSampler::computeSkinningPalette(std::span { &layer, 1 }, palette);
+    for(std::size_t boneIndex = 0; boneIndex < palette.size(); boneIndex++) {
+        expectNear(palette[boneIndex], animation.keyframes[7].boneTransforms[boneIndex], 0.005f);
+    }
+}
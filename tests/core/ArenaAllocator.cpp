@@ -0,0 +1,116 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <core/allocators/ArenaAllocator.h>
+#include <core/allocators/MallocAllocator.h>
+#include <core/containers/Vector.hpp>
+
+using namespace Carrot;
+
+struct ChunkCountingAllocator: public Allocator {
+    int allocCount = 0;
+    int deallocCount = 0;
+
+    MemoryBlock allocate(std::size_t size, std::size_t alignment) override {
+        allocCount++;
+        return MallocAllocator::instance.allocate(size, alignment);
+    }
+
+    void deallocate(const MemoryBlock& block) override {
+        deallocCount++;
+        return MallocAllocator::instance.deallocate(block);
+    }
+};
+
+TEST(ArenaAllocator, BasicAlloc) {
+    ArenaAllocator arena { MallocAllocator::instance, 1024 };
+    MemoryBlock a = arena.allocate(16);
+    MemoryBlock b = arena.allocate(16);
+    EXPECT_EQ(static_cast<std::uint8_t*>(a.ptr) + 16, b.ptr); // contiguous
+    EXPECT_EQ(arena.getBytesUsed(), 32);
+
+    MemoryBlock aligned = arena.allocate(4, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned.ptr) % 64, 0);
+}
+
+TEST(ArenaAllocator, RollbackLatestAllocation) {
+    ArenaAllocator arena { MallocAllocator::instance, 1024 };
+    MemoryBlock a = arena.allocate(16);
+    MemoryBlock b = arena.allocate(16);
+    arena.deallocate(a); // not the latest, nothing happens
+    EXPECT_EQ(arena.getBytesUsed(), 32);
+
+    arena.deallocate(b);
+    EXPECT_EQ(arena.getBytesUsed(), 16);
+    EXPECT_EQ(arena.allocate(16).ptr, b.ptr);
+}
+
+TEST(ArenaAllocator, ReallocateInPlace) {
+    ArenaAllocator arena { MallocAllocator::instance, 1024 };
+    MemoryBlock a = arena.allocate(16);
+    MemoryBlock grown = arena.reallocate(a, 128);
+    EXPECT_EQ(a.ptr, grown.ptr);
+    EXPECT_EQ(arena.getBytesUsed(), 128);
+
+    Vector<int> v { arena };
+    for(int i = 0; i < 100; i++) {
+        v.pushBack(i);
+    }
+    EXPECT_EQ(v.size(), 100);
+    EXPECT_EQ(v[99], 99);
+    EXPECT_EQ(arena.getChunkCount(), 1); // grown in place each time
+}
+
+TEST(ArenaAllocator, ResetMergesChunks) {
+    ChunkCountingAllocator counting;
+    {
+        ArenaAllocator arena { counting, 256 };
+        for(int i = 0; i < 10; i++) {
+            arena.allocate(200);
+        }
+        EXPECT_EQ(arena.getChunkCount(), 10);
+        EXPECT_EQ(counting.allocCount, 10);
+
+        arena.reset();
+        EXPECT_EQ(arena.getBytesUsedBeforeReset(), 10 * 200);
+        EXPECT_EQ(arena.getBytesUsed(), 0);
+        EXPECT_EQ(arena.getChunkCount(), 1);
+        EXPECT_EQ(counting.allocCount, 11);
+        EXPECT_EQ(counting.deallocCount, 10);
+
+        // same usage than previous frame: no new chunk
+        for(int i = 0; i < 10; i++) {
+            arena.allocate(200);
+        }
+        EXPECT_EQ(arena.getChunkCount(), 1);
+        EXPECT_EQ(counting.allocCount, 11);
+    }
+    EXPECT_EQ(counting.allocCount, counting.deallocCount);
+}
+
+TEST(ArenaAllocator, MakeCallsDestructorsOnReset) {
+    struct Tracked {
+        int& destroyCount;
+        ~Tracked() {
+            destroyCount++;
+        }
+    };
+
+    int destroyCount = 0;
+    ArenaAllocator arena;
+    arena.make<Tracked>(destroyCount);
+    arena.make<Tracked>(destroyCount);
+    int& trivial = arena.make<int>(42);
+    EXPECT_EQ(trivial, 42);
+    EXPECT_EQ(destroyCount, 0);
+
+    arena.reset();
+    EXPECT_EQ(destroyCount, 2);
+
+    arena.make<Tracked>(destroyCount);
+    arena.reset();
+    EXPECT_EQ(destroyCount, 3);
+}
@@ -0,0 +1,79 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <core/render/AtlasPacker.h>
+#include <random>
+
+using namespace Carrot::Render;
+
+struct PackedRect {
+    glm::uvec2 position;
+    glm::uvec2 size;
+};
+
+static bool overlap(const PackedRect& a, const PackedRect& b, std::uint32_t padding) {
+    return a.position.x < b.position.x + b.size.x + padding && b.position.x < a.position.x + a.size.x + padding
+        && a.position.y < b.position.y + b.size.y + padding && b.position.y < a.position.y + a.size.y + padding;
+}
+
+TEST(AtlasPacker, RectanglesDoNotOverlap) {
+    constexpr std::uint32_t Padding = 2;
+    AtlasPacker packer { 512, 512, Padding };
+    std::mt19937 rng { 42 };
+    std::uniform_int_distribution<std::uint32_t> sizes { 4, 48 };
+
+    std::vector<PackedRect> rects;
+    for(int i = 0; i < 200; i++) {
+        const glm::uvec2 size { sizes(rng), sizes(rng) };
+        std::optional<glm::uvec2> position = packer.allocate(size.x, size.y);
+        if(!position.has_value()) {
+            break;
+        }
+        // padding is kept free on the borders of the area too
+        EXPECT_GE(position->x, Padding);
+        EXPECT_GE(position->y, Padding);
+        EXPECT_LE(position->x + size.x + Padding, packer.getWidth());
+        EXPECT_LE(position->y + size.y + Padding, packer.getHeight());
+        rects.push_back(PackedRect { *position, size });
+    }
+    ASSERT_GT(rects.size(), 50);
+    EXPECT_EQ(packer.getAllocationCount(), rects.size());
+
+    for(std::size_t i = 0; i < rects.size(); i++) {
+        for(std::size_t j = i + 1; j < rects.size(); j++) {
+            EXPECT_FALSE(overlap(rects[i], rects[j], Padding)) << i << " and " << j;
+        }
+    }
+}
+
+TEST(AtlasPacker, ReportsFullArea) {
+    AtlasPacker packer { 64, 64, 0 };
+    EXPECT_FALSE(packer.allocate(65, 1).has_value());
+    EXPECT_FALSE(packer.allocate(0, 1).has_value());
+
+    for(int i = 0; i < 4; i++) {
+        EXPECT_TRUE(packer.allocate(32, 32).has_value());
+    }
+    EXPECT_EQ(packer.getUsedArea(), 64 * 64);
+    EXPECT_FALSE(packer.allocate(1, 1).has_value());
+
+    packer.clear();
+    EXPECT_EQ(packer.getAllocationCount(), 0);
+    const std::optional<glm::uvec2> position = packer.allocate(64, 64);
+    ASSERT_TRUE(position.has_value());
+    EXPECT_EQ(*position, glm::uvec2(0, 0));
+}
+
+TEST(AtlasPacker, ReusesShelves) {
+    AtlasPacker packer { 128, 128, 1 };
+    const std::optional<glm::uvec2> first = packer.allocate(16, 16);
+    const std::optional<glm::uvec2> second = packer.allocate(16, 14); // close enough in height to go in the same shelf
+    const std::optional<glm::uvec2> third = packer.allocate(16, 40); // too tall, starts a new shelf
+    ASSERT_TRUE(first.has_value() && second.has_value() && third.has_value());
+    EXPECT_EQ(first->y, second->y);
+    EXPECT_EQ(second->x, first->x + 16 + 2);
+    EXPECT_EQ(third->y, first->y + 16 + 2);
+}
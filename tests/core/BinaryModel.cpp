@@ -0,0 +1,205 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <core/io/MappedFile.h>
+#include <core/scene/BinaryModel.h>
+#include <cstring>
+#include <fstream>
+
+using namespace Carrot::Render;
+
+static LoadedPrimitive makeQuad(const std::string& name, float z, std::int64_t materialIndex) {
+    LoadedPrimitive primitive;
+    primitive.name = name;
+    primitive.materialIndex = materialIndex;
+    for(int i = 0; i < 4; i++) {
+        Carrot::Vertex& v = primitive.vertices.emplace_back();
+        v = {};
+        v.pos = glm::vec4 { static_cast<float>(i % 2), static_cast<float>(i / 2), z, 1.0f };
+        v.uv = glm::vec2 { static_cast<float>(i % 2), static_cast<float>(i / 2) };
+    }
+    primitive.indices = { 0, 1, 2, 2, 1, 3 };
+    primitive.minPos = glm::vec3 { 0.0f, 0.0f, z };
+    primitive.maxPos = glm::vec3 { 1.0f, 1.0f, z };
+    primitive.meshletVertexIndices = { 0, 1, 2, 3 };
+    primitive.meshletIndices = { 0, 1, 2, 2, 1, 3 };
+    primitive.meshlets.push_back(Meshlet { .vertexOffset = 0, .vertexCount = 4, .indexOffset = 0, .indexCount = 6 });
+    return primitive;
+}
+
+static LoadedScene makeScene() {
+    LoadedScene scene;
+    scene.debugName = "test model";
+    scene.primitives.push_back(makeQuad("front", 0.0f, 0));
+    scene.primitives.push_back(makeQuad("back", 1.0f, -1));
+
+    LoadedMaterial& material = scene.materials.emplace_back();
+    material.name = "material";
+    material.blendMode = LoadedMaterial::BlendMode::Blend;
+    material.albedo = Carrot::IO::VFS::Path { "textures/albedo.ktx2" };
+    material.baseColorFactor = glm::vec4 { 0.5f, 0.25f, 1.0f, 1.0f };
+    material.roughnessFactor = 0.5f;
+
+    // root -> child (translated) -> [0, 1], and root -> [0]
+    scene.nodeHierarchy = std::make_unique<Skeleton>(glm::mat4{1.0f});
+    scene.nodeHierarchy->hierarchy.meshIndices = std::vector<std::size_t>{ 0 };
+    SkeletonTreeNode& child = scene.nodeHierarchy->hierarchy.newChild();
+    child.bone.originalTransform = glm::mat4 { 1.0f };
+    child.bone.originalTransform[3] = glm::vec4 { 5.0f, 0.0f, 0.0f, 1.0f };
+    child.meshIndices = std::vector<std::size_t>{ 0, 1 };
+    return scene;
+}
+
+struct alignas(BinaryModel::TableAlignment) AlignedBlock {
+    std::uint8_t bytes[BinaryModel::TableAlignment];
+};
+
+/// copy to storage aligned like a memory-mapped file
+static std::vector<AlignedBlock> toAlignedStorage(const std::vector<std::uint8_t>& bytes) {
+    std::vector<AlignedBlock> storage((bytes.size() + sizeof(AlignedBlock) - 1) / sizeof(AlignedBlock));
+    if(!bytes.empty()) {
+        memcpy(storage.data(), bytes.data(), bytes.size());
+    }
+    return storage;
+}
+
+TEST(BinaryModel, RoundTrip) {
+    const LoadedScene scene = makeScene();
+    const std::vector<std::uint8_t> bytes = BinaryModel::write(scene);
+    const auto storage = toAlignedStorage(bytes);
+    const BinaryModelView view { std::span { reinterpret_cast<const std::uint8_t*>(storage.data()), bytes.size() } };
+
+    EXPECT_EQ(view.getDebugName(), "test model");
+    EXPECT_EQ(view.getVertices().size(), 8);
+    EXPECT_EQ(view.getIndices().size(), 12);
+
+    ASSERT_EQ(view.getPrimitives().size(), 2);
+    for(std::size_t i = 0; i < 2; i++) {
+        const BinaryModel::Primitive& primitive = view.getPrimitives()[i];
+        const LoadedPrimitive& expected = scene.primitives[i];
+        EXPECT_EQ(view.getString(primitive.name), expected.name);
+        EXPECT_EQ(primitive.materialIndex, expected.materialIndex);
+        EXPECT_EQ(primitive.minPos, expected.minPos);
+        EXPECT_EQ(primitive.maxPos, expected.maxPos);
+
+        const auto vertices = view.getVertices(primitive);
+        ASSERT_EQ(vertices.size(), expected.vertices.size());
+        for(std::size_t v = 0; v < vertices.size(); v++) {
+            EXPECT_EQ(vertices[v].pos, expected.vertices[v].pos);
+            EXPECT_EQ(vertices[v].uv, expected.vertices[v].uv);
+        }
+        const auto indices = view.getIndices(primitive);
+        EXPECT_TRUE(std::equal(indices.begin(), indices.end(), expected.indices.begin(), expected.indices.end()));
+        const auto meshletIndices = view.getMeshletIndices(primitive);
+        EXPECT_TRUE(std::equal(meshletIndices.begin(), meshletIndices.end(), expected.meshletIndices.begin(), expected.meshletIndices.end()));
+        const auto meshletVertexIndices = view.getMeshletVertexIndices(primitive);
+        EXPECT_TRUE(std::equal(meshletVertexIndices.begin(), meshletVertexIndices.end(), expected.meshletVertexIndices.begin(), expected.meshletVertexIndices.end()));
+        ASSERT_EQ(view.getMeshlets(primitive).size(), 1);
+        EXPECT_EQ(view.getMeshlets(primitive)[0].indexCount, 6);
+    }
+    // primitives are contiguous
+    EXPECT_EQ(view.getPrimitives()[1].vertices.first, 4);
+    EXPECT_EQ(view.getPrimitives()[1].indices.first, 6);
+
+    ASSERT_EQ(view.getMaterials().size(), 1);
+    const BinaryModel::Material& material = view.getMaterials()[0];
+    EXPECT_EQ(view.getString(material.name), "material");
+    EXPECT_EQ(view.getString(material.albedo), "textures/albedo.ktx2");
+    EXPECT_TRUE(view.getString(material.normalMap).empty());
+    EXPECT_EQ(material.blendMode, static_cast<std::uint32_t>(LoadedMaterial::BlendMode::Blend));
+    EXPECT_EQ(material.baseColorFactor, scene.materials[0].baseColorFactor);
+    EXPECT_EQ(material.roughnessFactor, 0.5f);
+}
+
+TEST(BinaryModel, FlattensHierarchy) {
+    const std::vector<std::uint8_t> bytes = BinaryModel::write(makeScene());
+    const auto storage = toAlignedStorage(bytes);
+    const BinaryModelView view { std::span { reinterpret_cast<const std::uint8_t*>(storage.data()), bytes.size() } };
+
+    const auto instances = view.getInstances();
+    ASSERT_EQ(instances.size(), 3);
+    EXPECT_EQ(instances[0].primitiveIndex, 0);
+    EXPECT_EQ(instances[0].transform[3], glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    EXPECT_EQ(instances[1].primitiveIndex, 0);
+    EXPECT_EQ(instances[1].transform[3], glm::vec4(5.0f, 0.0f, 0.0f, 1.0f));
+    EXPECT_EQ(instances[2].primitiveIndex, 1);
+    EXPECT_EQ(instances[2].transform[3], glm::vec4(5.0f, 0.0f, 0.0f, 1.0f));
+}
+
+TEST(BinaryModel, TablesAreAligned) {
+    const std::vector<std::uint8_t> bytes = BinaryModel::write(makeScene());
+    BinaryModel::Header header;
+    memcpy(&header, bytes.data(), sizeof(header));
+    for(const BinaryModel::Table& table : { header.vertices, header.indices, header.meshlets, header.meshletVertexIndices, header.meshletIndices,
+                                            header.primitives, header.instances, header.materials, header.strings }) {
+        EXPECT_EQ(table.offset % BinaryModel::TableAlignment, 0);
+    }
+}
+
+TEST(BinaryModel, SkinnedScenesAreNotWritable) {
+    LoadedScene scene = makeScene();
+    EXPECT_TRUE(BinaryModel::canWrite(scene));
+    scene.primitives[1].isSkinned = true;
+    EXPECT_FALSE(BinaryModel::canWrite(scene));
+}
+
+TEST(BinaryModel, RejectsInvalidData) {
+    const std::vector<std::uint8_t> bytes = BinaryModel::write(makeScene());
+    auto view = [](std::vector<std::uint8_t> modified) {
+        const auto storage = toAlignedStorage(modified);
+        BinaryModelView { std::span { reinterpret_cast<const std::uint8_t*>(storage.data()), modified.size() } };
+    };
+
+    EXPECT_NO_THROW(view(bytes));
+    EXPECT_THROW(view({}), std::runtime_error);
+
+    // truncated
+    EXPECT_THROW(view({ bytes.begin(), bytes.end() - 16 }), std::runtime_error);
+
+    // wrong magic
+    std::vector<std::uint8_t> modified = bytes;
+    modified[0] = 'X';
+    EXPECT_THROW(view(modified), std::runtime_error);
+
+    // newer version
+    BinaryModel::Header header;
+    memcpy(&header, bytes.data(), sizeof(header));
+    header.version++;
+    modified = bytes;
+    memcpy(modified.data(), &header, sizeof(header));
+    EXPECT_THROW(view(modified), std::runtime_error);
+
+    // primitive pointing outside of the vertex table
+    memcpy(&header, bytes.data(), sizeof(header));
+    BinaryModel::Primitive primitive;
+    memcpy(&primitive, bytes.data() + header.primitives.offset, sizeof(primitive));
+    primitive.vertices.count = 1000;
+    modified = bytes;
+    memcpy(modified.data() + header.primitives.offset, &primitive, sizeof(primitive));
+    EXPECT_THROW(view(modified), std::runtime_error);
+}
+
+TEST(BinaryModel, LoadsFromMappedFile) {
+    const std::vector<std::uint8_t> bytes = BinaryModel::write(makeScene());
+    const std::filesystem::path path = "binary-model-test.cmodel";
+    {
+        std::ofstream out { path, std::ios::binary };
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    {
+        Carrot::IO::MappedFile file { path };
+        ASSERT_EQ(file.getData().size(), bytes.size());
+        EXPECT_EQ(memcmp(file.getData().data(), bytes.data(), bytes.size()), 0);
+
+        const BinaryModelView view { file.getData() };
+        EXPECT_EQ(view.getPrimitives().size(), 2);
+        EXPECT_EQ(view.getVertices()[5].pos, glm::vec4(1.0f, 0.0f, 1.0f, 1.0f));
+    }
+    std::filesystem::remove(path);
+
+    EXPECT_THROW(Carrot::IO::MappedFile { "file-which-does-not-exist.cmodel" }, std::runtime_error);
+}
@@ -0,0 +1,112 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <core/io/BitStream.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Carrot::IO;
+
+TEST(BitStream, RoundTripArbitraryWidths) {
+    std::mt19937 rng { 42 };
+    std::uniform_int_distribution<std::uint32_t> values;
+    std::uniform_int_distribution<std::uint32_t> widths { 1, 32 };
+
+    std::vector<std::pair<std::uint32_t, std::uint8_t>> written;
+    BitWriter writer;
+    for(int i = 0; i < 1000; i++) {
+        const std::uint8_t width = static_cast<std::uint8_t>(widths(rng));
+        const std::uint32_t value = width == 32 ? values(rng) : values(rng) & ((1u << width) - 1);
+        writer.write(value, width);
+        written.emplace_back(value, width);
+    }
+
+    BitReader reader { writer.getBytes() };
+    for(const auto& [value, width] : written) {
+        EXPECT_EQ(reader.read(width), value);
+    }
+    EXPECT_FALSE(reader.hasOverflowed());
+    EXPECT_LT(reader.getRemainingBits(), 8);
+}
+
+TEST(BitStream, BitsArePacked) {
+    BitWriter writer;
+    for(int i = 0; i < 10; i++) {
+        writer.writeBool(i % 3 == 0);
+    }
+    EXPECT_EQ(writer.getBitCount(), 10);
+    EXPECT_EQ(writer.getByteCount(), 2);
+
+    // only the lowest bits are written
+    writer.write(0xFFFFFFFF, 3);
+    EXPECT_EQ(writer.getBitCount(), 13);
+
+    BitReader reader { writer.getBytes() };
+    for(int i = 0; i < 10; i++) {
+        EXPECT_EQ(reader.readBool(), i % 3 == 0);
+    }
+    EXPECT_EQ(reader.read(3), 7);
+    EXPECT_EQ(reader.read(3), 0); // padding
+    EXPECT_FALSE(reader.hasOverflowed());
+}
+
+TEST(BitStream, VarUInt) {
+    BitWriter writer;
+    const std::vector<std::uint32_t> values { 0, 1, 127, 128, 16383, 16384, 0xFFFFFFFF };
+    for(auto v : values) {
+        writer.writeVarUInt(v);
+    }
+    EXPECT_EQ(writer.getByteCount(), 1 + 1 + 1 + 2 + 2 + 3 + 5);
+
+    BitReader reader { writer.getBytes() };
+    for(auto v : values) {
+        EXPECT_EQ(reader.readVarUInt(), v);
+    }
+    EXPECT_FALSE(reader.hasOverflowed());
+}
+
+TEST(BitStream, Append) {
+    BitWriter a;
+    a.write(5, 3);
+    BitWriter b;
+    b.write(0x1234, 13);
+    b.writeBool(true);
+
+    a.append(b);
+    EXPECT_EQ(a.getBitCount(), 17);
+
+    BitReader reader { a.getBytes() };
+    EXPECT_EQ(reader.read(3), 5);
+    EXPECT_EQ(reader.read(13), 0x1234);
+    EXPECT_TRUE(reader.readBool());
+}
+
+TEST(BitStream, ReadingPastTheEnd) {
+    BitWriter writer;
+    writer.write(0xAB, 8);
+
+    BitReader reader { writer.getBytes() };
+    EXPECT_EQ(reader.read(4), 0xB);
+    EXPECT_EQ(reader.read(8), 0);
+    EXPECT_TRUE(reader.hasOverflowed());
+    EXPECT_EQ(reader.getRemainingBits(), 0);
+}
+
+TEST(BitStream, Quantization) {
+    const Quantization q = Quantization::withPrecision(-100.0f, 100.0f, 0.01f);
+    EXPECT_EQ(q.bits, 15); // 20000 steps
+
+    for(float value : { -100.0f, -12.345f, 0.0f, 0.005f, 42.0f, 100.0f }) {
+        EXPECT_NEAR(q.dequantize(q.quantize(value)), value, 0.01f);
+    }
+    // clamped
+    EXPECT_EQ(q.dequantize(q.quantize(1000.0f)), 100.0f);
+    EXPECT_EQ(q.dequantize(q.quantize(-1000.0f)), -100.0f);
+
+    const Quantization full;
+    EXPECT_EQ(full.dequantize(full.quantize(1234.5678f)), 1234.5678f);
+    EXPECT_TRUE(std::isnan(full.dequantize(full.quantize(NAN))));
+}
@@ -0,0 +1,219 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <core/expressions/Expressions.h>
+#include <core/expressions/ExpressionProgram.h>
+#include <cmath>
+#include <random>
+
+using namespace Carrot;
+
+static std::shared_ptr<Expression> get(const std::string& name, std::uint32_t subIndex = 0) {
+    return std::make_shared<GetVariableExpression>(ExpressionTypes::Float, name, subIndex);
+}
+
+static std::shared_ptr<Expression> set(const std::string& name, std::shared_ptr<Expression> value, std::uint32_t subIndex = 0) {
+    return std::make_shared<SetVariableExpression>(name, value, subIndex);
+}
+
+static std::shared_ptr<Expression> constant(float value) {
+    return std::make_shared<ConstantExpression>(value);
+}
+
+/// Binds one array per variable of the program, from the given named arrays
+static std::vector<float*> bindVariables(const ExpressionProgram& program, std::unordered_map<std::string, std::vector<float>>& arrays) {
+    std::vector<float*> pointers;
+    for(const auto& variable : program.getVariables()) {
+        pointers.push_back(arrays.at(variable.name + std::to_string(variable.subIndex)).data());
+    }
+    return pointers;
+}
+
+TEST(Expressions, ParticleUpdateMatchesScalar) {
+    // velocity.y += -9.8 * dt; position.y += velocity.y * dt; size = max(size * 0.5 + sin(life), 0.1)
+    std::vector<std::shared_ptr<Expression>> expressions {
+        set("velocity", std::make_shared<AddExpression>(get("velocity", 1), std::make_shared<MultExpression>(constant(-9.8f), get("dt"))), 1),
+        set("position", std::make_shared<AddExpression>(get("position", 1), std::make_shared<MultExpression>(get("velocity", 1), get("dt"))), 1),
+        set("size", std::make_shared<MaxExpression>(std::make_shared<AddExpression>(std::make_shared<MultExpression>(get("size"), constant(0.5f)), std::make_shared<SinExpression>(get("life"))), constant(0.1f))),
+    };
+
+    constexpr std::size_t Count = 37; // not a multiple of ExpressionProgram::LanesPerBlock
+    std::mt19937 rng { 42 };
+    std::uniform_real_distribution<float> distribution { -10.0f, 10.0f };
+    std::unordered_map<std::string, std::vector<float>> arrays;
+    for(const char* name : { "velocity1", "position1", "size0", "life0", "dt0" }) {
+        auto& array = arrays[name];
+        for(std::size_t i = 0; i < Count; i++) {
+            array.push_back(distribution(rng));
+        }
+    }
+    const auto initial = arrays;
+
+    for(bool optimize : { false, true }) {
+        arrays = initial;
+        ExpressionProgram program = ExpressionProgram::compile(expressions, ExpressionCompileOptions { .foldConstants = optimize, .eliminateDeadNodes = optimize, .reuseSharedNodes = optimize });
+        program.run(bindVariables(program, arrays), Count);
+
+        for(std::size_t i = 0; i < Count; i++) {
+            const float dt = initial.at("dt0")[i];
+            const float velocity = initial.at("velocity1")[i] + -9.8f * dt;
+            const float position = initial.at("position1")[i] + velocity * dt;
+            const float size = std::max(initial.at("size0")[i] * 0.5f + std::sin(initial.at("life0")[i]), 0.1f);
+            EXPECT_FLOAT_EQ(arrays["velocity1"][i], velocity);
+            EXPECT_FLOAT_EQ(arrays["position1"][i], position);
+            EXPECT_FLOAT_EQ(arrays["size0"][i], size);
+            EXPECT_EQ(arrays["life0"][i], initial.at("life0")[i]);
+        }
+    }
+}
+
+TEST(Expressions, LogicAndComparisons) {
+    auto x = get("x");
+    std::vector<std::shared_ptr<Expression>> expressions {
+        // (x < 0 or x >= 5) xor x == 7, negated
+        set("result", std::make_shared<BoolNegateExpression>(std::make_shared<XorExpression>(
+            std::make_shared<OrExpression>(std::make_shared<LessExpression>(x, constant(0.0f)), std::make_shared<GreaterOrEqualsExpression>(x, constant(5.0f))),
+            std::make_shared<EqualsExpression>(x, constant(7.0f))
+        ))),
+    };
+    ExpressionProgram program = ExpressionProgram::compile(expressions);
+
+    std::vector<float> xs;
+    for(int i = -3; i < 10; i++) {
+        xs.push_back(static_cast<float>(i));
+    }
+    std::vector<float> results(xs.size(), -1.0f);
+    std::vector<float*> pointers(program.getVariables().size());
+    pointers[program.findVariable("x").value()] = xs.data();
+    pointers[program.findVariable("result").value()] = results.data();
+    program.run(pointers, xs.size());
+
+    for(std::size_t i = 0; i < xs.size(); i++) {
+        const bool expected = !(((xs[i] < 0.0f) || (xs[i] >= 5.0f)) != (xs[i] == 7.0f));
+        EXPECT_EQ(results[i], expected ? 1.0f : 0.0f) << "x = " << xs[i];
+    }
+}
+
+TEST(Expressions, ModIsFloored) {
+    // same results as GLSL mod (OpFMod) inside particle shaders: x - y * floor(x / y), not std::fmod
+    const std::vector<std::pair<float, float>> operands { { 5.5f, 2.0f }, { -5.5f, 2.0f }, { 5.5f, -2.0f }, { -5.5f, -2.0f }, { -4.0f, 2.0f }, { -0.25f, 1.0f } };
+    for(const auto& [x, y] : operands) {
+        const float expected = x - y * std::floor(x / y);
+
+        // runtime
+        std::vector<std::shared_ptr<Expression>> expressions { set("result", std::make_shared<ModExpression>(get("x"), get("y"))) };
+        ExpressionProgram program = ExpressionProgram::compile(expressions);
+        std::vector<float> xs(5, x);
+        std::vector<float> ys(5, y);
+        std::vector<float> results(5, 0.0f);
+        std::vector<float*> pointers(program.getVariables().size());
+        pointers[program.findVariable("x").value()] = xs.data();
+        pointers[program.findVariable("y").value()] = ys.data();
+        pointers[program.findVariable("result").value()] = results.data();
+        program.run(pointers, results.size());
+        for(float result : results) {
+            EXPECT_FLOAT_EQ(result, expected) << x << " mod " << y;
+        }
+
+        // constant folding
+        std::vector<std::shared_ptr<Expression>> folded { set("result", std::make_shared<ModExpression>(constant(x), constant(y))) };
+        ExpressionProgram foldedProgram = ExpressionProgram::compile(folded);
+        float foldedResult = 0.0f;
+        std::vector<float*> foldedPointers { &foldedResult };
+        foldedProgram.run(foldedPointers, 1);
+        EXPECT_FLOAT_EQ(foldedResult, expected) << x << " mod " << y;
+    }
+}
+
+TEST(Expressions, ConstantFoldingAndDeadNodes) {
+    std::vector<std::shared_ptr<Expression>> expressions {
+        // fully constant: folded to a single store
+        set("a", std::make_shared<MultExpression>(std::make_shared<AddExpression>(constant(1.0f), constant(2.0f)), std::make_shared<SqrtExpression>(constant(16.0f)))),
+        // not stored anywhere: removed
+        std::make_shared<CompoundExpression>(std::vector<std::shared_ptr<Expression>> {
+            std::make_shared<AddExpression>(get("b"), constant(1.0f)),
+        }),
+        // reads 'a' after writing it: uses the stored register instead of loading it again
+        set("c", std::make_shared<AddExpression>(get("a"), get("b"))),
+    };
+
+    ExpressionProgram unoptimized = ExpressionProgram::compile(expressions, ExpressionCompileOptions { .foldConstants = false, .eliminateDeadNodes = false });
+    ExpressionProgram optimized = ExpressionProgram::compile(expressions);
+    EXPECT_LT(optimized.getInstructions().size(), unoptimized.getInstructions().size());
+    // store a, load b, add, store c
+    EXPECT_EQ(optimized.getInstructions().size(), 4u) << optimized.disassemble();
+
+    for(const ExpressionProgram* pProgram : { &unoptimized, &optimized }) {
+        std::vector<float> a(5, 0.0f), b { 1, 2, 3, 4, 5 }, c(5, 0.0f);
+        std::vector<float*> pointers(pProgram->getVariables().size());
+        pointers[pProgram->findVariable("a").value()] = a.data();
+        pointers[pProgram->findVariable("b").value()] = b.data();
+        pointers[pProgram->findVariable("c").value()] = c.data();
+        pProgram->run(pointers, a.size());
+        for(std::size_t i = 0; i < a.size(); i++) {
+            EXPECT_EQ(a[i], 12.0f);
+            EXPECT_EQ(c[i], 12.0f + b[i]);
+        }
+    }
+}
+
+TEST(Expressions, ReusesSharedNodes) {
+    // 'scaled' is used by 3 expressions, but 'x' is modified between the 2nd and 3rd use: only the 3rd use must be recomputed
+    auto scaled = std::make_shared<MultExpression>(get("x"), get("scale"));
+    std::vector<std::shared_ptr<Expression>> expressions {
+        set("a", std::make_shared<AddExpression>(scaled, constant(1.0f))),
+        set("b", std::make_shared<SubExpression>(scaled, constant(1.0f))),
+        set("x", constant(10.0f)),
+        set("c", scaled),
+    };
+
+    ExpressionProgram withoutReuse = ExpressionProgram::compile(expressions, ExpressionCompileOptions { .reuseSharedNodes = false });
+    ExpressionProgram withReuse = ExpressionProgram::compile(expressions);
+    EXPECT_EQ(withReuse.getInstructions().size() + 1, withoutReuse.getInstructions().size()) << withReuse.disassemble();
+
+    for(const ExpressionProgram* pProgram : { &withoutReuse, &withReuse }) {
+        float x = 3.0f, scale = 2.0f, a = 0.0f, b = 0.0f, c = 0.0f;
+        std::vector<float*> pointers(pProgram->getVariables().size());
+        pointers[pProgram->findVariable("x").value()] = &x;
+        pointers[pProgram->findVariable("scale").value()] = &scale;
+        pointers[pProgram->findVariable("a").value()] = &a;
+        pointers[pProgram->findVariable("b").value()] = &b;
+        pointers[pProgram->findVariable("c").value()] = &c;
+        pProgram->run(pointers, 1);
+        EXPECT_EQ(a, 7.0f);
+        EXPECT_EQ(b, 5.0f);
+        EXPECT_EQ(c, 20.0f);
+        EXPECT_EQ(x, 10.0f);
+    }
+}
+
+TEST(Expressions, OnceRunsSharedNodesOnce) {
+    // like templates in the particle editor: the internal expressions are wrapped in a Once, and each use of the output is prefixed by it
+    auto increment = std::make_shared<OnceExpression>(Carrot::UUID(), set("counter", std::make_shared<AddExpression>(get("counter"), constant(1.0f))));
+    auto output = std::make_shared<PrefixedExpression>(increment, get("counter"));
+    std::vector<std::shared_ptr<Expression>> expressions {
+        set("x", output),
+        set("y", std::make_shared<MultExpression>(output, constant(2.0f))),
+    };
+    ExpressionProgram program = ExpressionProgram::compile(expressions);
+
+    float counter = 1.0f, x = 0.0f, y = 0.0f;
+    std::vector<float*> pointers(program.getVariables().size());
+    pointers[program.findVariable("counter").value()] = &counter;
+    pointers[program.findVariable("x").value()] = &x;
+    pointers[program.findVariable("y").value()] = &y;
+    program.run(pointers, 1);
+    EXPECT_EQ(counter, 2.0f);
+    EXPECT_EQ(x, 2.0f);
+    EXPECT_EQ(y, 4.0f);
+}
+
+TEST(Expressions, RejectsPlaceholders) {
+    std::vector<std::shared_ptr<Expression>> expressions {
+        set("x", std::make_shared<PlaceholderExpression>(nullptr, ExpressionTypes::Float)),
+    };
+    EXPECT_THROW(ExpressionProgram::compile(expressions), std::runtime_error);
+}
@@ -0,0 +1,76 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <core/io/BatchedReads.h>
+#include <core/io/FileHandle.h>
+#include <core/utils/Assert.h>
+#include <fstream>
+
+using namespace Carrot::IO;
+
+TEST(FileHandle, ReadAndWriteAtOffsets) {
+    const std::filesystem::path path = "file-handle-test.bin";
+    std::filesystem::remove(path);
+
+    const std::vector<std::uint8_t> contents { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    {
+        FileHandle file { path, OpenMode::NewReadWrite };
+        file.write(contents, 0);
+        file.write(std::vector<std::uint8_t> { 42, 43 }, 4);
+    }
+    EXPECT_THROW(FileHandle(path, OpenMode::NewReadWrite), std::filesystem::filesystem_error); // already exists
+
+    FileHandle file { path, OpenMode::Read };
+    ASSERT_EQ(file.getSize(), contents.size());
+
+    std::uint8_t buffer[3];
+    file.seek(1);
+    file.read(buffer, 3, 3);
+    EXPECT_EQ(buffer[0], 3);
+    EXPECT_EQ(buffer[1], 42);
+    EXPECT_EQ(buffer[2], 43);
+    EXPECT_EQ(file.getCurrentPosition(), 1); // reads at an offset do not move the cursor
+
+    file.skip(2);
+    EXPECT_EQ(file.getCurrentPosition(), 3);
+    file.seekEnd();
+    EXPECT_EQ(file.getCurrentPosition(), contents.size());
+
+    const auto all = file.readAll();
+    EXPECT_EQ(all[9], 9);
+    EXPECT_THROW(file.read(buffer, 3, 8), Carrot::Assertions::Error);
+    file.close();
+
+    std::filesystem::remove(path);
+}
+
+TEST(FileHandle, ThrowsOnMissingFile) {
+    EXPECT_THROW(FileHandle("file-handle-test-missing.bin", OpenMode::Read), std::filesystem::filesystem_error);
+}
+
+TEST(BatchedReads, ReadsAllFiles) {
+    const std::filesystem::path directory = "batched-reads-test";
+    std::filesystem::create_directories(directory);
+
+    // more files than reads in flight at once
+    std::vector<std::filesystem::path> paths;
+    for(int i = 0; i < 200; i++) {
+        const std::filesystem::path& path = paths.emplace_back(directory / (std::to_string(i) + ".txt"));
+        std::ofstream out { path, std::ios::binary };
+        out << std::string(i * 10, 'a' + i % 26);
+    }
+
+    const std::vector<std::vector<std::uint8_t>> contents = readFiles(paths);
+    ASSERT_EQ(contents.size(), paths.size());
+    for(int i = 0; i < 200; i++) {
+        EXPECT_EQ(std::string(contents[i].begin(), contents[i].end()), std::string(i * 10, 'a' + i % 26));
+    }
+
+    paths.push_back(directory / "missing.txt");
+    EXPECT_THROW(readFiles(paths), std::filesystem::filesystem_error);
+
+    std::filesystem::remove_all(directory);
+}
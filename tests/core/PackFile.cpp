@@ -0,0 +1,238 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <core/io/PackFile.h>
+#include <core/io/Resource.h>
+#include <core/io/vfs/VirtualFileSystem.h>
+#include <cstring>
+#include <fstream>
+
+using namespace Carrot::IO;
+
+static std::vector<std::uint8_t> toBytes(std::string_view text) {
+    return std::vector<std::uint8_t> { text.begin(), text.end() };
+}
+
+/// Small files with different sizes, so that blobs need padding
+static Pack::Writer makeWriter(Pack::Compression compression = Pack::Compression::None) {
+    Pack::Writer writer;
+    writer.add("textures/albedo.png", toBytes("albedo"), compression);
+    writer.add("textures/normal.png", toBytes("normal map contents"), compression);
+    writer.add("./models/../models/cube.cmodel", toBytes("cube"), compression); // normalized to models/cube.cmodel
+    writer.add("empty.txt", {}, compression);
+    for(int i = 0; i < 100; i++) {
+        writer.add("generated/" + std::to_string(i) + ".txt", toBytes(std::string(i, 'a' + i % 26)), compression);
+    }
+    return writer;
+}
+
+static void writeToDisk(const std::filesystem::path& path, std::span<const std::uint8_t> bytes) {
+    std::ofstream out { path, std::ios::binary };
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+TEST(PackFile, RoundTrip) {
+    const PackFile pack { makeWriter().write() };
+    ASSERT_EQ(pack.getEntries().size(), 104);
+
+    auto readText = [&](std::string_view path) {
+        const Pack::Entry* pEntry = pack.find(path);
+        EXPECT_NE(pEntry, nullptr) << path;
+        if(pEntry == nullptr) {
+            return std::string {};
+        }
+        const std::vector<std::uint8_t> contents = pack.read(*pEntry);
+        return std::string { contents.begin(), contents.end() };
+    };
+    EXPECT_EQ(readText("textures/albedo.png"), "albedo");
+    EXPECT_EQ(readText("textures/normal.png"), "normal map contents");
+    EXPECT_EQ(readText("models/cube.cmodel"), "cube");
+    EXPECT_EQ(readText("empty.txt"), "");
+    for(int i = 0; i < 100; i++) {
+        EXPECT_EQ(readText("generated/" + std::to_string(i) + ".txt"), std::string(i, 'a' + i % 26));
+    }
+
+    EXPECT_EQ(pack.find("textures/missing.png"), nullptr);
+    EXPECT_EQ(pack.find("textures"), nullptr);
+
+    // uncompressed data can be used in place
+    const Pack::Entry* pAlbedo = pack.find("textures/albedo.png");
+    ASSERT_NE(pAlbedo, nullptr);
+    EXPECT_EQ(pAlbedo->compression, Pack::Compression::None);
+    EXPECT_EQ(memcmp(pack.getStoredData(*pAlbedo).data(), "albedo", 6), 0);
+}
+
+TEST(PackFile, IndexIsSortedAndDataIsAligned) {
+    const PackFile pack { makeWriter().write() };
+    const auto entries = pack.getEntries();
+    for(std::size_t i = 0; i < entries.size(); i++) {
+        EXPECT_EQ(entries[i].offset % Pack::Alignment, 0);
+        EXPECT_EQ(entries[i].pathHash, Pack::hashPath(pack.getPath(entries[i])));
+        if(i > 0) {
+            EXPECT_LE(entries[i - 1].pathHash, entries[i].pathHash);
+        }
+    }
+}
+
+TEST(PackFile, RejectsDuplicatesAndAbsolutePaths) {
+    Pack::Writer writer;
+    writer.add("a/b.txt", toBytes("b"));
+    EXPECT_THROW(writer.add("a/./b.txt", toBytes("b")), Carrot::Assertions::Error);
+    EXPECT_THROW(writer.add("/a/c.txt", toBytes("c")), std::invalid_argument);
+}
+
+TEST(PackFile, Compression) {
+    std::string compressible;
+    for(int i = 0; i < 1000; i++) {
+        compressible += "compressible ";
+    }
+
+    for(const Pack::Compression compression : { Pack::Compression::LZ4, Pack::Compression::Zstd }) {
+        Pack::Writer writer;
+        if(!Pack::isSupported(compression)) {
+            EXPECT_THROW(writer.add("file.txt", toBytes(compressible), compression), std::runtime_error);
+            continue;
+        }
+
+        writer.add("file.txt", toBytes(compressible), compression);
+        writer.add("tiny.txt", toBytes("x"), compression); // not worth compressing
+        const PackFile pack { writer.write() };
+
+        const Pack::Entry* pFile = pack.find("file.txt");
+        ASSERT_NE(pFile, nullptr);
+        EXPECT_EQ(pFile->compression, compression);
+        EXPECT_LT(pFile->storedSize, pFile->size);
+        const std::vector<std::uint8_t> contents = pack.read(*pFile);
+        EXPECT_EQ(std::string(contents.begin(), contents.end()), compressible);
+
+        const Pack::Entry* pTiny = pack.find("tiny.txt");
+        ASSERT_NE(pTiny, nullptr);
+        EXPECT_EQ(pTiny->compression, Pack::Compression::None);
+
+        // mix of compressed and uncompressed entries
+        const PackFile compressedPack { makeWriter(compression).write() };
+        const PackFile uncompressedPack { makeWriter().write() };
+        for(const Pack::Entry& entry : uncompressedPack.getEntries()) {
+            const Pack::Entry* pCompressedEntry = compressedPack.find(uncompressedPack.getPath(entry));
+            ASSERT_NE(pCompressedEntry, nullptr);
+            EXPECT_EQ(compressedPack.read(*pCompressedEntry), uncompressedPack.read(entry));
+        }
+    }
+}
+
+TEST(PackFile, RejectsInvalidData) {
+    const std::vector<std::uint8_t> bytes = makeWriter().write();
+    EXPECT_NO_THROW(PackFile { std::vector<std::uint8_t>(bytes) });
+    EXPECT_THROW(PackFile { std::vector<std::uint8_t>{} }, std::runtime_error);
+
+    // truncated
+    EXPECT_THROW(PackFile(std::vector<std::uint8_t> { bytes.begin(), bytes.end() - 16 }), std::runtime_error);
+
+    // wrong magic
+    std::vector<std::uint8_t> modified = bytes;
+    modified[0] = 'X';
+    EXPECT_THROW(PackFile { std::move(modified) }, std::runtime_error);
+
+    // newer version
+    Pack::Header header;
+    memcpy(&header, bytes.data(), sizeof(header));
+    header.version++;
+    modified = bytes;
+    memcpy(modified.data(), &header, sizeof(header));
+    EXPECT_THROW(PackFile { std::move(modified) }, std::runtime_error);
+
+    // entry pointing outside of the file
+    memcpy(&header, bytes.data(), sizeof(header));
+    Pack::Entry entry;
+    memcpy(&entry, bytes.data() + header.entries.offset, sizeof(entry));
+    entry.storedSize = bytes.size();
+    entry.size = bytes.size();
+    modified = bytes;
+    memcpy(modified.data() + header.entries.offset, &entry, sizeof(entry));
+    EXPECT_THROW(PackFile { std::move(modified) }, std::runtime_error);
+
+    // unsorted index
+    Pack::Entry secondEntry;
+    memcpy(&entry, bytes.data() + header.entries.offset, sizeof(entry));
+    memcpy(&secondEntry, bytes.data() + header.entries.offset + sizeof(entry), sizeof(entry));
+    modified = bytes;
+    memcpy(modified.data() + header.entries.offset, &secondEntry, sizeof(entry));
+    memcpy(modified.data() + header.entries.offset + sizeof(entry), &entry, sizeof(entry));
+    EXPECT_THROW(PackFile { std::move(modified) }, std::runtime_error);
+}
+
+TEST(PackFile, MountedInVFS) {
+    const std::filesystem::path packPath = std::filesystem::absolute("pack-file-test.cpak");
+    writeToDisk(packPath, makeWriter().write());
+
+    VFS vfs;
+    vfs.addPackRoot("pack", packPath);
+    EXPECT_TRUE(vfs.hasRoot("pack"));
+    EXPECT_EQ(vfs.getRoots().size(), 1);
+    EXPECT_THROW(vfs.addRoot("pack", std::filesystem::absolute(".")), Carrot::Assertions::Error);
+    EXPECT_THROW(vfs.addPackRoot("pack", packPath), Carrot::Assertions::Error);
+
+    EXPECT_TRUE(vfs.exists("pack://textures/albedo.png"));
+    EXPECT_TRUE(vfs.exists("textures/normal.png")); // generic paths search packs too
+    EXPECT_FALSE(vfs.exists("pack://textures/missing.png"));
+    EXPECT_EQ(vfs.complete("models/cube.cmodel"), VFS::Path("pack://models/cube.cmodel"));
+    EXPECT_THROW(vfs.resolve("pack://textures/albedo.png"), Carrot::Assertions::Error); // no physical path
+
+    auto packed = vfs.findPacked("pack://models/cube.cmodel");
+    ASSERT_TRUE(packed.has_value());
+    EXPECT_EQ(packed->pack->getPath(*packed->pEntry), "models/cube.cmodel");
+
+    VirtualFileSystem* previousVFS = Resource::vfsToUse;
+    Resource::vfsToUse = &vfs;
+    {
+        const Resource resource { VFS::Path("pack://textures/albedo.png") };
+        EXPECT_EQ(resource.readText(), "albedo");
+        EXPECT_EQ(resource.getName(), "pack://textures/albedo.png");
+
+        // relative to the resource, like files on disk
+        const Resource sibling = resource.relative("normal.png");
+        EXPECT_EQ(sibling.readText(), "normal map contents");
+    }
+    Resource::vfsToUse = previousVFS;
+
+    EXPECT_TRUE(vfs.removeRoot("pack"));
+    EXPECT_FALSE(vfs.exists("pack://textures/albedo.png"));
+    // the pack is still alive while it is referenced
+    EXPECT_EQ(packed->pack->read(*packed->pEntry).size(), 4);
+    packed.reset();
+
+    std::filesystem::remove(packPath);
+}
+
+TEST(PackFile, DirectoryRootsOverridePacks) {
+    const std::filesystem::path packPath = std::filesystem::absolute("pack-file-override-test.cpak");
+    writeToDisk(packPath, makeWriter().write());
+
+    const std::filesystem::path loosePath = std::filesystem::absolute("pack-file-override-test");
+    std::filesystem::create_directories(loosePath / "textures");
+    writeToDisk(loosePath / "textures" / "albedo.png", toBytes("loose albedo"));
+
+    VFS vfs;
+    vfs.addPackRoot("pack", packPath);
+    vfs.addRoot("loose", loosePath);
+
+    EXPECT_EQ(vfs.complete("textures/albedo.png"), VFS::Path("loose://textures/albedo.png"));
+    EXPECT_FALSE(vfs.findPacked("textures/albedo.png").has_value());
+    EXPECT_EQ(vfs.complete("textures/normal.png"), VFS::Path("pack://textures/normal.png")); // only inside the pack
+    EXPECT_TRUE(vfs.findPacked("textures/normal.png").has_value());
+
+    VirtualFileSystem* previousVFS = Resource::vfsToUse;
+    Resource::vfsToUse = &vfs;
+    {
+        EXPECT_EQ(Resource { VFS::Path("textures/albedo.png") }.readText(), "loose albedo");
+        EXPECT_EQ(Resource { VFS::Path("textures/normal.png") }.readText(), "normal map contents");
+        EXPECT_EQ(Resource { VFS::Path("pack://textures/albedo.png") }.readText(), "albedo"); // explicit root still reaches the pack
+    }
+    Resource::vfsToUse = previousVFS;
+
+    std::filesystem::remove_all(loosePath);
+    std::filesystem::remove(packPath);
+}
@@ -0,0 +1,97 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <core/async/ParallelFor.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Carrot::Async;
+
+/// Runs 'job' with 'helperCount' additional threads, like TaskScheduler::parallelFor does with its worker threads
+static void runWithHelpers(const std::shared_ptr<ParallelForJob>& job, std::size_t helperCount) {
+    std::vector<std::thread> helpers;
+    for(std::size_t i = 0; i < helperCount; i++) {
+        helpers.emplace_back([job]() {
+            job->work();
+        });
+    }
+    job->wait();
+    EXPECT_TRUE(job->isDone());
+    for(auto& t : helpers) {
+        t.join();
+    }
+}
+
+TEST(ParallelFor, RunsEachIndexOnce) {
+    constexpr std::size_t Count = 10000;
+    std::vector<std::atomic<int>> visits(Count);
+    std::function<void(std::size_t)> forEach = [&](std::size_t i) {
+        visits[i]++;
+    };
+    runWithHelpers(ParallelForJob::create(Count, forEach, 0, 4), 3);
+    for(std::size_t i = 0; i < Count; i++) {
+        ASSERT_EQ(visits[i].load(), 1) << i;
+    }
+}
+
+TEST(ParallelFor, FixedGranularity) {
+    constexpr std::size_t Count = 1000;
+    std::vector<std::atomic<int>> visits(Count);
+    std::function<void(std::size_t)> forEach = [&](std::size_t i) {
+        visits[i]++;
+    };
+    auto job = ParallelForJob::create(Count, forEach, 64, 2);
+    EXPECT_EQ(job->getChunkSize(), 64);
+    runWithHelpers(job, 1);
+    EXPECT_EQ(job->getChunkSize(), 64);
+    for(std::size_t i = 0; i < Count; i++) {
+        ASSERT_EQ(visits[i].load(), 1) << i;
+    }
+}
+
+TEST(ParallelFor, CallerAloneFinishesTheJob) {
+    // helpers may never start (for instance if all worker threads are busy): the caller must not wait for them
+    std::atomic<std::size_t> sum = 0;
+    std::function<void(std::size_t)> forEach = [&](std::size_t i) {
+        sum += i;
+    };
+    auto job = ParallelForJob::create(100, forEach, 0, 8);
+    job->wait();
+    EXPECT_TRUE(job->isDone());
+    EXPECT_EQ(sum.load(), 99 * 100 / 2);
+
+    // late helper: nothing left to do, must not call forEach anymore
+    job->work();
+    EXPECT_EQ(sum.load(), 99 * 100 / 2);
+}
+
+TEST(ParallelFor, AutomaticGranularityGrowsForCheapWork) {
+    std::vector<float> values(1'000'000, 1.0f);
+    std::function<void(std::size_t)> forEach = [&](std::size_t i) {
+        values[i] = values[i] * 0.5f + 1.0f;
+    };
+    auto job = ParallelForJob::create(values.size(), forEach, 0, 2);
+    job->wait();
+    EXPECT_GT(job->getChunkSize(), 1);
+    EXPECT_LE(job->getChunkSize(), values.size() / 8);
+}
+
+TEST(ParallelFor, NestedJobs) {
+    constexpr std::size_t Outer = 16;
+    constexpr std::size_t Inner = 256;
+    std::vector<std::atomic<int>> visits(Outer * Inner);
+    std::function<void(std::size_t)> outer = [&](std::size_t i) {
+        std::function<void(std::size_t)> inner = [&](std::size_t j) {
+            visits[i * Inner + j]++;
+        };
+        ParallelForJob::create(Inner, inner, 0, 4)->wait();
+    };
+    runWithHelpers(ParallelForJob::create(Outer, outer, 1, 4), 3);
+    for(std::size_t i = 0; i < visits.size(); i++) {
+        ASSERT_EQ(visits[i].load(), 1) << i;
+    }
+}
@@ -0,0 +1,187 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <core/allocators/PoolAllocator.h>
+#include <thread>
+#include <vector>
+
+using namespace Carrot;
+
+struct CountingAllocator: public Allocator {
+    std::atomic<int> allocCount = 0;
+    std::atomic<int> deallocCount = 0;
+
+    MemoryBlock allocate(std::size_t size, std::size_t alignment) override {
+        allocCount++;
+        return MallocAllocator::instance.allocate(size, alignment);
+    }
+
+    void deallocate(const MemoryBlock& block) override {
+        deallocCount++;
+        return MallocAllocator::instance.deallocate(block);
+    }
+};
+
+TEST(PoolAllocator, BasicAlloc) {
+    PoolAllocator allocator;
+    MemoryBlock block = allocator.allocate(20);
+    EXPECT_EQ(block.size, 32); // rounded to size class
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block.ptr) % PoolAllocator::MinAlignment, 0);
+
+    int* pInt = new (block.ptr) int;
+    *pInt = 50;
+    EXPECT_EQ(*pInt, 50); // attempt to access allocated memory
+    allocator.deallocate(block);
+}
+
+TEST(PoolAllocator, SizeClasses) {
+    EXPECT_EQ(PoolAllocator::getSizeClassIndex(1), 0);
+    EXPECT_EQ(PoolAllocator::getSizeClassIndex(16), 0);
+    EXPECT_EQ(PoolAllocator::getSizeClassIndex(17), 1);
+    for(std::size_t size = 1; size <= PoolAllocator::MaxSmallSize; size++) {
+        const std::size_t index = PoolAllocator::getSizeClassIndex(size);
+        EXPECT_GE(PoolAllocator::SizeClasses[index], size);
+        if(index > 0) {
+            EXPECT_LT(PoolAllocator::SizeClasses[index-1], size); // smallest class which fits
+        }
+    }
+}
+
+TEST(PoolAllocator, FreedBlocksAreReused) {
+    PoolAllocator allocator;
+    MemoryBlock block = allocator.allocate(64);
+    allocator.deallocate(block);
+    MemoryBlock block2 = allocator.allocate(64);
+    EXPECT_EQ(block.ptr, block2.ptr);
+    allocator.deallocate(block2);
+}
+
+TEST(PoolAllocator, Alignment) {
+    PoolAllocator allocator;
+    for(std::size_t alignment : { 1, 8, 16, 32, 64, 256, 1024, 4096 }) {
+        MemoryBlock block = allocator.allocate(24, alignment);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block.ptr) % alignment, 0) << "alignment = " << alignment;
+        allocator.deallocate(block);
+    }
+}
+
+TEST(PoolAllocator, BigAllocationsGoToBackingAllocator) {
+    CountingAllocator counting;
+    {
+        PoolAllocator allocator { counting };
+        MemoryBlock small = allocator.allocate(32);
+        EXPECT_EQ(counting.allocCount, 1); // first slab
+
+        MemoryBlock small2 = allocator.allocate(48);
+        EXPECT_EQ(counting.allocCount, 2); // one slab per size class
+
+        MemoryBlock big = allocator.allocate(PoolAllocator::MaxSmallSize + 1);
+        EXPECT_EQ(counting.allocCount, 3);
+        allocator.deallocate(big);
+        EXPECT_EQ(counting.deallocCount, 1);
+
+        allocator.deallocate(small);
+        allocator.deallocate(small2);
+        EXPECT_EQ(counting.deallocCount, 1); // slabs are kept
+    }
+    EXPECT_EQ(counting.allocCount, counting.deallocCount);
+}
+
+TEST(PoolAllocator, ReallocateInsideSizeClass) {
+    PoolAllocator allocator;
+    MemoryBlock block = allocator.allocate(20);
+    MemoryBlock grown = allocator.reallocate(block, 30);
+    EXPECT_EQ(block.ptr, grown.ptr);
+
+    static_cast<std::uint8_t*>(grown.ptr)[0] = 42;
+    MemoryBlock moved = allocator.reallocate(grown, 200);
+    EXPECT_NE(grown.ptr, moved.ptr);
+    EXPECT_EQ(static_cast<std::uint8_t*>(moved.ptr)[0], 42);
+    allocator.deallocate(moved);
+}
+
+TEST(PoolAllocator, CrossThreadFree) {
+    PoolAllocator allocator;
+    MemoryBlock block = allocator.allocate(128);
+
+    std::thread other { [&]() {
+        allocator.deallocate(block);
+    }};
+    other.join();
+
+    // the block freed by the other thread goes back to the cache of this thread
+    MemoryBlock block2 = allocator.allocate(128);
+    EXPECT_EQ(block.ptr, block2.ptr);
+    allocator.deallocate(block2);
+}
+
+TEST(PoolAllocator, Stats) {
+    PoolAllocator allocator;
+    AllocatorStats stats;
+    ASSERT_TRUE(allocator.getStats(stats));
+    EXPECT_EQ(stats.allocationCount, 0);
+    EXPECT_EQ(stats.bytesInUse, 0);
+    EXPECT_EQ(stats.bytesReserved, 0);
+
+    MemoryBlock a = allocator.allocate(20);
+    MemoryBlock b = allocator.allocate(5000);
+    ASSERT_TRUE(allocator.getStats(stats));
+    EXPECT_EQ(stats.allocationCount, 2);
+    EXPECT_EQ(stats.bytesInUse, 32 + 5000);
+    EXPECT_EQ(stats.bytesReserved, PoolAllocator::SlabSize + 5000);
+
+    allocator.deallocate(a);
+    allocator.deallocate(b);
+    ASSERT_TRUE(allocator.getStats(stats));
+    EXPECT_EQ(stats.deallocationCount, 2);
+    EXPECT_EQ(stats.bytesInUse, 0);
+}
+
+TEST(PoolAllocator, MultithreadedChurn) {
+    PoolAllocator allocator;
+    constexpr std::size_t ThreadCount = 8;
+    constexpr std::size_t SlotCount = 256;
+    constexpr std::size_t IterationCount = 20000;
+
+    // threads swap blocks through shared slots, so most blocks are freed by another thread than the one which allocated them
+    std::array<std::atomic<std::uint32_t*>, SlotCount> slots{};
+    std::atomic<bool> corrupted = false;
+    std::vector<std::thread> threads;
+    for(std::size_t threadIndex = 0; threadIndex < ThreadCount; threadIndex++) {
+        threads.emplace_back([&, threadIndex]() {
+            std::uint32_t random = static_cast<std::uint32_t>(threadIndex * 7919 + 1);
+            for(std::size_t i = 0; i < IterationCount; i++) {
+                random ^= random << 13;
+                random ^= random >> 17;
+                random ^= random << 5;
+                const std::size_t slot = random % SlotCount;
+                const std::size_t size = 16 + slot * 4;
+
+                std::uint32_t* pValue = static_cast<std::uint32_t*>(allocator.allocate(size).ptr);
+                *pValue = static_cast<std::uint32_t>(slot);
+                std::uint32_t* pPrevious = slots[slot].exchange(pValue);
+                if(pPrevious != nullptr) {
+                    corrupted = corrupted || *pPrevious != slot;
+                    allocator.deallocate(MemoryBlock { .ptr = pPrevious, .size = size });
+                }
+            }
+        });
+    }
+    for(auto& t : threads) {
+        t.join();
+    }
+    EXPECT_FALSE(corrupted);
+
+    for(std::size_t slot = 0; slot < SlotCount; slot++) {
+        allocator.deallocate(MemoryBlock { .ptr = slots[slot].load(), .size = 16 + slot * 4 });
+    }
+
+    AllocatorStats stats;
+    ASSERT_TRUE(allocator.getStats(stats));
+    EXPECT_EQ(stats.allocationCount, ThreadCount * IterationCount);
+    EXPECT_EQ(stats.allocationCount, stats.deallocationCount);
+    EXPECT_EQ(stats.bytesInUse, 0);
+}
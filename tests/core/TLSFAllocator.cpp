@@ -0,0 +1,171 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <core/allocators/TLSFAllocator.h>
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace Carrot;
+
+TEST(TLSFAllocator, BasicAlloc) {
+    TLSFAllocator allocator;
+    MemoryBlock block = allocator.allocate(20);
+    EXPECT_GE(block.size, 20);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block.ptr) % TLSFAllocator::MinAlignment, 0);
+
+    int* pInt = new (block.ptr) int;
+    *pInt = 50;
+    EXPECT_EQ(*pInt, 50); // attempt to access allocated memory
+    EXPECT_TRUE(allocator.validate());
+
+    allocator.deallocate(block);
+    EXPECT_TRUE(allocator.validate());
+}
+
+TEST(TLSFAllocator, FreeBlocksAreMerged) {
+    TLSFAllocator allocator { MallocAllocator::instance, 4096 };
+    MemoryBlock a = allocator.allocate(1000);
+    MemoryBlock b = allocator.allocate(1000);
+    MemoryBlock c = allocator.allocate(1000);
+    EXPECT_EQ(allocator.getPoolCount(), 1);
+
+    allocator.deallocate(a);
+    allocator.deallocate(c);
+    allocator.deallocate(b); // merges with both neighbours
+    EXPECT_TRUE(allocator.validate());
+
+    // entire pool is available again
+    MemoryBlock big = allocator.allocate(3500);
+    EXPECT_EQ(allocator.getPoolCount(), 1);
+    EXPECT_EQ(big.ptr, a.ptr);
+    allocator.deallocate(big);
+}
+
+TEST(TLSFAllocator, GrowsWithNewPools) {
+    TLSFAllocator allocator { MallocAllocator::instance, 4096 };
+    MemoryBlock a = allocator.allocate(3000);
+    MemoryBlock b = allocator.allocate(3000);
+    EXPECT_EQ(allocator.getPoolCount(), 2);
+
+    MemoryBlock huge = allocator.allocate(100000); // bigger than pool size
+    EXPECT_EQ(allocator.getPoolCount(), 3);
+    EXPECT_TRUE(allocator.validate());
+
+    allocator.deallocate(a);
+    allocator.deallocate(b);
+    allocator.deallocate(huge);
+    EXPECT_TRUE(allocator.validate());
+}
+
+TEST(TLSFAllocator, Alignment) {
+    TLSFAllocator allocator;
+    std::vector<MemoryBlock> blocks;
+    for(std::size_t alignment : { 1, 8, 16, 32, 64, 256, 1024, 4096 }) {
+        MemoryBlock block = allocator.allocate(24, alignment);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block.ptr) % alignment, 0) << "alignment = " << alignment;
+        blocks.push_back(block);
+        EXPECT_TRUE(allocator.validate());
+    }
+    for(const MemoryBlock& block : blocks) {
+        allocator.deallocate(block);
+    }
+    EXPECT_TRUE(allocator.validate());
+}
+
+TEST(TLSFAllocator, ReallocateInPlace) {
+    TLSFAllocator allocator;
+    MemoryBlock block = allocator.allocate(100);
+    std::memset(block.ptr, 42, block.size);
+
+    // next block is free: grows in place
+    MemoryBlock grown = allocator.reallocate(block, 1000);
+    EXPECT_EQ(block.ptr, grown.ptr);
+    EXPECT_GE(grown.size, 1000);
+    EXPECT_EQ(static_cast<std::uint8_t*>(grown.ptr)[99], 42);
+
+    MemoryBlock shrunk = allocator.reallocate(grown, 50);
+    EXPECT_EQ(block.ptr, shrunk.ptr);
+    EXPECT_TRUE(allocator.validate());
+
+    // next block is used: moved
+    MemoryBlock blocker = allocator.allocate(16);
+    MemoryBlock moved = allocator.reallocate(shrunk, 5000);
+    EXPECT_NE(moved.ptr, shrunk.ptr);
+    EXPECT_EQ(static_cast<std::uint8_t*>(moved.ptr)[0], 42);
+    EXPECT_TRUE(allocator.validate());
+
+    allocator.deallocate(blocker);
+    allocator.deallocate(moved);
+    EXPECT_TRUE(allocator.validate());
+}
+
+TEST(TLSFAllocator, RandomAllocations) {
+    TLSFAllocator allocator { MallocAllocator::instance, 64 * 1024 };
+    std::vector<MemoryBlock> blocks;
+    std::uint32_t random = 12345;
+    auto next = [&]() {
+        random ^= random << 13;
+        random ^= random >> 17;
+        random ^= random << 5;
+        return random;
+    };
+
+    for(int i = 0; i < 5000; i++) {
+        if(!blocks.empty() && next() % 3 == 0) {
+            const std::size_t index = next() % blocks.size();
+            allocator.deallocate(blocks[index]);
+            blocks[index] = blocks.back();
+            blocks.pop_back();
+        } else {
+            const std::size_t alignment = std::size_t{1} << (next() % 8);
+            MemoryBlock block = allocator.allocate(1 + next() % 4000, alignment);
+            ASSERT_EQ(reinterpret_cast<std::uintptr_t>(block.ptr) % alignment, 0);
+            blocks.push_back(block);
+        }
+    }
+    ASSERT_TRUE(allocator.validate());
+
+    for(const MemoryBlock& block : blocks) {
+        allocator.deallocate(block);
+    }
+    ASSERT_TRUE(allocator.validate());
+
+    AllocatorStats stats;
+    ASSERT_TRUE(allocator.getStats(stats));
+    EXPECT_EQ(stats.allocationCount, stats.deallocationCount);
+    EXPECT_EQ(stats.bytesInUse, 0);
+    EXPECT_GT(allocator.getPeakBytesInUse(), 0);
+}
+
+TEST(TLSFAllocator, Multithreaded) {
+    TLSFAllocator allocator;
+    std::vector<std::thread> threads;
+    for(int threadIndex = 0; threadIndex < 4; threadIndex++) {
+        threads.emplace_back([&]() {
+            std::vector<MemoryBlock> blocks;
+            for(int i = 0; i < 2000; i++) {
+                blocks.push_back(allocator.allocate(16 + (i % 64) * 16));
+                if(i % 3 == 0) {
+                    allocator.deallocate(blocks.front());
+                    blocks.erase(blocks.begin());
+                }
+            }
+            for(const MemoryBlock& block : blocks) {
+                allocator.deallocate(block);
+            }
+        });
+    }
+    for(auto& t : threads) {
+        t.join();
+    }
+    EXPECT_TRUE(allocator.validate());
+
+    AllocatorStats stats;
+    ASSERT_TRUE(allocator.getStats(stats));
+    EXPECT_EQ(stats.bytesInUse, 0);
+}
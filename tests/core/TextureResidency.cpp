@@ -0,0 +1,215 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <core/render/TextureResidency.h>
+
+using namespace Carrot::Render;
+
+/// sizes of a RGBA8 mip chain, mip 0 is 'size'x'size'
+static std::vector<std::uint64_t> makeMipSizes(std::uint32_t size) {
+    std::vector<std::uint64_t> sizes;
+    for(std::uint32_t s = size; s > 0; s /= 2) {
+        sizes.push_back(static_cast<std::uint64_t>(s) * s * 4);
+    }
+    return sizes;
+}
+
+static void completeAll(TextureResidency& residency, const std::vector<TextureResidency::StreamingRequest>& requests) {
+    for(const auto& request : requests) {
+        residency.onStreamingDone(request);
+    }
+}
+
+TEST(TextureResidency, RequiredMip) {
+    EXPECT_EQ(computeRequiredMip(1024, 1024, 1024.0f, 11), 0);
+    EXPECT_EQ(computeRequiredMip(1024, 1024, 4096.0f, 11), 0);
+    EXPECT_EQ(computeRequiredMip(1024, 1024, 256.0f, 11), 2);
+    EXPECT_EQ(computeRequiredMip(1024, 512, 300.0f, 11), 1);
+    EXPECT_EQ(computeRequiredMip(1024, 1024, 0.5f, 11), 10);
+    EXPECT_EQ(computeRequiredMip(1024, 1024, 0.0f, 11), 10);
+    EXPECT_EQ(computeRequiredMip(1024, 1024, 16.0f, 3), 2);
+}
+
+TEST(TextureResidency, MipTail) {
+    EXPECT_EQ(computeMipTail(1024, 512, 64, 11), 4);
+    EXPECT_EQ(computeMipTail(64, 64, 64, 7), 0);
+    EXPECT_EQ(computeMipTail(4096, 4096, 64, 3), 2); // incomplete mip chain
+}
+
+TEST(TextureResidency, StartsWithMipTail) {
+    TextureResidency residency;
+    const auto mipSizes = makeMipSizes(256);
+    const auto texture = residency.registerTexture(mipSizes, 2);
+
+    const auto info = residency.getTextureInfo(texture);
+    EXPECT_EQ(info.residentMip, 2);
+    EXPECT_EQ(info.wantedMip, 2);
+    EXPECT_EQ(residency.getResidentBytes(), 64*64*4 + 32*32*4 + 16*16*4 + 8*8*4 + 4*4*4 + 2*2*4 + 1*1*4);
+
+    // nothing requested: nothing to stream
+    residency.nextFrame();
+    EXPECT_TRUE(residency.plan(std::numeric_limits<std::uint64_t>::max(), 16).empty());
+}
+
+TEST(TextureResidency, StreamsInOneMipAtATime) {
+    TextureResidency residency;
+    const auto mipSizes = makeMipSizes(256);
+    const auto texture = residency.registerTexture(mipSizes, 3);
+
+    for(std::uint32_t expectedMip = 2; expectedMip != static_cast<std::uint32_t>(-1); expectedMip--) {
+        residency.requestMip(texture, 0);
+        residency.nextFrame();
+        const auto requests = residency.plan(std::numeric_limits<std::uint64_t>::max(), 16);
+        ASSERT_EQ(requests.size(), 1);
+        EXPECT_EQ(requests[0].texture, texture);
+        EXPECT_EQ(requests[0].targetMip, expectedMip);
+        EXPECT_TRUE(residency.getTextureInfo(texture).streaming);
+
+        // in flight: no new request for this texture
+        EXPECT_TRUE(residency.plan(std::numeric_limits<std::uint64_t>::max(), 16).empty());
+        completeAll(residency, requests);
+    }
+    EXPECT_EQ(residency.getTextureInfo(texture).residentMip, 0);
+    EXPECT_EQ(residency.getResidentBytes(), residency.getFullyResidentBytes());
+}
+
+TEST(TextureResidency, CoarseMipsOfAllTexturesFirst) {
+    TextureResidency residency;
+    const auto mipSizes = makeMipSizes(256);
+    const auto a = residency.registerTexture(mipSizes, 3);
+    const auto b = residency.registerTexture(mipSizes, 3);
+
+    residency.requestMip(a, 0);
+    residency.requestMip(b, 2);
+    residency.nextFrame();
+    // a is missing more mips than b, but only one request is allowed
+    auto requests = residency.plan(std::numeric_limits<std::uint64_t>::max(), 1);
+    ASSERT_EQ(requests.size(), 1);
+    EXPECT_EQ(requests[0].texture, a);
+    EXPECT_EQ(requests[0].targetMip, 2);
+    completeAll(residency, requests);
+
+    // both now miss the same amount of mips: lowest ID first
+    requests = residency.plan(std::numeric_limits<std::uint64_t>::max(), 2);
+    ASSERT_EQ(requests.size(), 2);
+    EXPECT_EQ(requests[0].texture, a);
+    EXPECT_EQ(requests[0].targetMip, 1);
+    EXPECT_EQ(requests[1].texture, b);
+    EXPECT_EQ(requests[1].targetMip, 2);
+}
+
+TEST(TextureResidency, StaysUnderBudget) {
+    TextureResidency residency;
+    const auto mipSizes = makeMipSizes(256);
+    const auto a = residency.registerTexture(mipSizes, 3);
+    const auto b = residency.registerTexture(mipSizes, 3);
+
+    // enough for both textures at mip 1, but not for mip 0
+    const std::uint64_t budget = 2 * (residency.getFullyResidentBytes() / 2 - mipSizes[0]);
+    for(int frame = 0; frame < 20; frame++) {
+        residency.requestMip(a, 0);
+        residency.requestMip(b, 0);
+        residency.nextFrame();
+        completeAll(residency, residency.plan(budget, 4));
+        EXPECT_LE(residency.getResidentBytes(), budget);
+    }
+
+    EXPECT_EQ(residency.getTextureInfo(a).residentMip, 1);
+    EXPECT_EQ(residency.getTextureInfo(b).residentMip, 1);
+}
+
+TEST(TextureResidency, EvictsLessImportantMips) {
+    TextureResidency residency;
+    const auto mipSizes = makeMipSizes(256);
+    const auto far = residency.registerTexture(mipSizes, 3);
+    const auto near = residency.registerTexture(mipSizes, 3);
+    const std::uint64_t budget = residency.getResidentBytes() + mipSizes[2] + mipSizes[1];
+
+    // 'far' takes the whole budget
+    for(int frame = 0; frame < 5; frame++) {
+        residency.requestMip(far, 1);
+        residency.nextFrame();
+        completeAll(residency, residency.plan(budget, 4));
+    }
+    ASSERT_EQ(residency.getTextureInfo(far).residentMip, 1);
+
+    // 'near' needs all its mips and is missing more of them: 'far' gives its memory back
+    for(int frame = 0; frame < 10; frame++) {
+        residency.requestMip(far, 1);
+        residency.requestMip(near, 0);
+        residency.nextFrame();
+        completeAll(residency, residency.plan(budget, 4));
+        EXPECT_LE(residency.getResidentBytes(), budget);
+    }
+    EXPECT_EQ(residency.getTextureInfo(far).residentMip, 2);
+    EXPECT_EQ(residency.getTextureInfo(near).residentMip, 2);
+}
+
+TEST(TextureResidency, UnusedTexturesGoBackToMipTail) {
+    TextureResidency residency;
+    const auto mipSizes = makeMipSizes(256);
+    const auto texture = residency.registerTexture(mipSizes, 3);
+
+    for(int frame = 0; frame < 5; frame++) {
+        residency.requestMip(texture, 0);
+        residency.nextFrame();
+        completeAll(residency, residency.plan(std::numeric_limits<std::uint64_t>::max(), 4));
+    }
+    ASSERT_EQ(residency.getTextureInfo(texture).residentMip, 0);
+
+    // briefly out of view: kept resident
+    for(std::uint64_t frame = 0; frame < TextureResidency::RequestLifetime; frame++) {
+        residency.nextFrame();
+        EXPECT_TRUE(residency.plan(std::numeric_limits<std::uint64_t>::max(), 4).empty());
+    }
+
+    residency.nextFrame();
+    residency.nextFrame();
+    const auto requests = residency.plan(std::numeric_limits<std::uint64_t>::max(), 4);
+    ASSERT_EQ(requests.size(), 1);
+    EXPECT_EQ(requests[0].targetMip, 3);
+    completeAll(residency, requests);
+    EXPECT_EQ(residency.getTextureInfo(texture).residentMip, 3);
+}
+
+TEST(TextureResidency, LoweringBudgetEvicts) {
+    TextureResidency residency;
+    const auto mipSizes = makeMipSizes(256);
+    const auto texture = residency.registerTexture(mipSizes, 3);
+    for(int frame = 0; frame < 5; frame++) {
+        residency.requestMip(texture, 0);
+        residency.nextFrame();
+        completeAll(residency, residency.plan(std::numeric_limits<std::uint64_t>::max(), 4));
+    }
+    ASSERT_EQ(residency.getTextureInfo(texture).residentMip, 0);
+
+    const std::uint64_t budget = residency.getFullyResidentBytes() - mipSizes[0] - mipSizes[1];
+    for(int frame = 0; frame < 5; frame++) {
+        residency.requestMip(texture, 0);
+        residency.nextFrame();
+        completeAll(residency, residency.plan(budget, 4));
+    }
+    EXPECT_EQ(residency.getTextureInfo(texture).residentMip, 2);
+    EXPECT_LE(residency.getResidentBytes(), budget);
+}
+
+TEST(TextureResidency, CancelledRequestsAreRetried) {
+    TextureResidency residency;
+    const auto mipSizes = makeMipSizes(256);
+    const auto texture = residency.registerTexture(mipSizes, 3);
+    residency.requestMip(texture, 0);
+    residency.nextFrame();
+
+    auto requests = residency.plan(std::numeric_limits<std::uint64_t>::max(), 4);
+    ASSERT_EQ(requests.size(), 1);
+    residency.onStreamingCancelled(requests[0]);
+    EXPECT_EQ(residency.getTextureInfo(texture).residentMip, 3);
+    EXPECT_FALSE(residency.getTextureInfo(texture).streaming);
+
+    requests = residency.plan(std::numeric_limits<std::uint64_t>::max(), 4);
+    ASSERT_EQ(requests.size(), 1);
+    EXPECT_EQ(requests[0].targetMip, 2);
+}
@@ -0,0 +1,111 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <core/render/TransformHistory.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace Carrot::Render;
+
+TEST(TransformHistory, AffineTransformRoundTrip) {
+    const glm::mat4 matrix = glm::translate(glm::mat4 { 1.0f }, glm::vec3 { 1, 2, 3 })
+                           * glm::rotate(glm::mat4 { 1.0f }, 0.5f, glm::normalize(glm::vec3 { 1, 1, 0 }))
+                           * glm::scale(glm::mat4 { 1.0f }, glm::vec3 { 2, 3, 4 });
+    const AffineTransform affine = AffineTransform::fromMatrix(matrix);
+    EXPECT_EQ(affine.toMatrix(), matrix);
+
+    // rows are what shaders use to transform positions
+    const glm::vec4 p { 5, 6, 7, 1 };
+    const glm::vec4 expected = matrix * p;
+    for(int i = 0; i < 3; i++) {
+        EXPECT_FLOAT_EQ(glm::dot(affine.rows[i], p), expected[i]);
+    }
+}
+
+TEST(TransformHistory, StaticInstancesStopUploading) {
+    TransformHistory history { 2 };
+    std::vector<AffineTransform> buffers[2] { std::vector<AffineTransform>(4), std::vector<AffineTransform>(4) };
+    history.resetBuffer(0, buffers[0].size());
+    history.resetBuffer(1, buffers[1].size());
+
+    const TransformHistory::Slot slot = history.allocateSlot();
+    const glm::mat4 transform = glm::translate(glm::mat4 { 1.0f }, glm::vec3 { 1, 2, 3 });
+
+    // each buffer must receive the transform once
+    EXPECT_TRUE(history.submit(0, buffers[0], slot, transform));
+    EXPECT_TRUE(history.submit(1, buffers[1], slot, transform));
+    EXPECT_EQ(history.resetWrittenBytes(), 2 * sizeof(AffineTransform));
+    EXPECT_EQ(buffers[0][slot], AffineTransform::fromMatrix(transform));
+    EXPECT_EQ(buffers[1][slot], AffineTransform::fromMatrix(transform));
+
+    for(int frame = 0; frame < 10; frame++) {
+        EXPECT_TRUE(history.submit(frame % 2, buffers[frame % 2], slot, transform));
+    }
+    EXPECT_EQ(history.resetWrittenBytes(), 0);
+}
+
+TEST(TransformHistory, MovingInstancesUploadToEachBuffer) {
+    TransformHistory history { 2 };
+    std::vector<AffineTransform> buffers[2] { std::vector<AffineTransform>(4), std::vector<AffineTransform>(4) };
+    history.resetBuffer(0, buffers[0].size());
+    history.resetBuffer(1, buffers[1].size());
+
+    const TransformHistory::Slot slot = history.allocateSlot();
+    for(int frame = 0; frame < 10; frame++) {
+        const glm::mat4 transform = glm::translate(glm::mat4 { 1.0f }, glm::vec3 { frame, 0, 0 });
+        EXPECT_TRUE(history.submit(frame % 2, buffers[frame % 2], slot, transform));
+        EXPECT_EQ(history.resetWrittenBytes(), sizeof(AffineTransform));
+        EXPECT_EQ(buffers[frame % 2][slot], AffineTransform::fromMatrix(transform));
+    }
+
+    // stops moving: the other buffer is still outdated
+    const glm::mat4 finalTransform = glm::translate(glm::mat4 { 1.0f }, glm::vec3 { 9, 0, 0 });
+    EXPECT_TRUE(history.submit(0, buffers[0], slot, finalTransform));
+    EXPECT_TRUE(history.submit(1, buffers[1], slot, finalTransform));
+    EXPECT_EQ(history.resetWrittenBytes(), sizeof(AffineTransform));
+}
+
+TEST(TransformHistory, SlotsOutsideOfBufferAreRejected) {
+    TransformHistory history { 1 };
+    std::vector<AffineTransform> buffer(1);
+    history.resetBuffer(0, buffer.size());
+
+    const TransformHistory::Slot first = history.allocateSlot();
+    const TransformHistory::Slot second = history.allocateSlot();
+    EXPECT_EQ(history.getRequiredCapacity(), 2);
+    EXPECT_TRUE(history.submit(0, buffer, first, glm::mat4 { 1.0f }));
+    EXPECT_FALSE(history.submit(0, buffer, second, glm::mat4 { 1.0f }));
+
+    // buffer is recreated with the required capacity
+    buffer.resize(history.getRequiredCapacity());
+    history.resetBuffer(0, buffer.size());
+    EXPECT_TRUE(history.submit(0, buffer, first, glm::mat4 { 1.0f }));
+    EXPECT_TRUE(history.submit(0, buffer, second, glm::mat4 { 1.0f }));
+    EXPECT_EQ(history.resetWrittenBytes(), 3 * sizeof(AffineTransform));
+}
+
+TEST(TransformHistory, FreedSlotsAreReused) {
+    TransformHistory history { 1 };
+    std::vector<AffineTransform> buffer(2);
+    history.resetBuffer(0, buffer.size());
+
+    const TransformHistory::Slot first = history.allocateSlot();
+    const glm::mat4 transform = glm::translate(glm::mat4 { 1.0f }, glm::vec3 { 1, 2, 3 });
+    EXPECT_TRUE(history.submit(0, buffer, first, transform));
+    history.freeSlot(first);
+
+    const TransformHistory::Slot reused = history.allocateSlot();
+    EXPECT_EQ(reused, first);
+    EXPECT_EQ(history.getRequiredCapacity(), 1);
+
+    // buffer already contains the right value
+    history.resetWrittenBytes();
+    EXPECT_TRUE(history.submit(0, buffer, reused, transform));
+    EXPECT_EQ(history.resetWrittenBytes(), 0);
+
+    EXPECT_TRUE(history.submit(0, buffer, reused, glm::mat4 { 1.0f }));
+    EXPECT_EQ(history.resetWrittenBytes(), sizeof(AffineTransform));
+    EXPECT_EQ(buffer[reused], AffineTransform::fromMatrix(glm::mat4 { 1.0f }));
+}
@@ -0,0 +1,144 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <core/render/TransientAliasing.h>
+
+using namespace Carrot::Render;
+
+TEST(TransientAliasing, DisjointLifetimesShareMemory) {
+    std::vector<TransientResource> resources {
+        { .size = 1024, .firstPass = 0, .lastPass = 1 },
+        { .size = 1024, .firstPass = 2, .lastPass = 3 },
+    };
+    TransientHeapLayout layout = packTransientResources(resources);
+    ASSERT_EQ(layout.heaps.size(), 1);
+    EXPECT_EQ(layout.heaps[0].size, 1024);
+    EXPECT_EQ(layout.placements[0].offset, 0);
+    EXPECT_EQ(layout.placements[1].offset, 0);
+    EXPECT_EQ(layout.unaliasedSize, 2048);
+    EXPECT_EQ(layout.aliasedSize, 1024);
+    EXPECT_EQ(layout.getSavedBytes(), 1024);
+
+    // second resource takes over the memory of the first one
+    EXPECT_TRUE(layout.placements[0].aliasedResources.empty());
+    ASSERT_EQ(layout.placements[1].aliasedResources.size(), 1);
+    EXPECT_EQ(layout.placements[1].aliasedResources[0], 0);
+}
+
+TEST(TransientAliasing, OverlappingLifetimesDoNotShareMemory) {
+    std::vector<TransientResource> resources {
+        { .size = 1024, .firstPass = 0, .lastPass = 2 },
+        { .size = 512, .firstPass = 2, .lastPass = 3 }, // alive at the same time than the first one during pass 2
+    };
+    TransientHeapLayout layout = packTransientResources(resources);
+    ASSERT_EQ(layout.heaps.size(), 1);
+    EXPECT_EQ(layout.heaps[0].size, 1536);
+    EXPECT_EQ(layout.placements[0].offset, 0);
+    EXPECT_EQ(layout.placements[1].offset, 1024);
+    EXPECT_EQ(layout.getSavedBytes(), 0);
+    EXPECT_TRUE(layout.placements[1].aliasedResources.empty());
+}
+
+TEST(TransientAliasing, SmallResourcesFillHoles) {
+    // A lives during the whole graph, B and C are big but short-lived, D and E can fit inside the memory of B after B dies
+    std::vector<TransientResource> resources {
+        { .size = 256, .firstPass = 0, .lastPass = 5 }, // A
+        { .size = 1024, .firstPass = 0, .lastPass = 1 }, // B
+        { .size = 1024, .firstPass = 1, .lastPass = 2 }, // C
+        { .size = 512, .firstPass = 2, .lastPass = 4 }, // D
+        { .size = 512, .firstPass = 3, .lastPass = 5 }, // E
+    };
+    TransientHeapLayout layout = packTransientResources(resources);
+    ASSERT_EQ(layout.heaps.size(), 1);
+    EXPECT_EQ(layout.heaps[0].size, 256 + 1024 + 1024);
+    EXPECT_LT(layout.aliasedSize, layout.unaliasedSize);
+
+    // no two resources alive at the same time overlap in memory
+    for(std::size_t i = 0; i < resources.size(); i++) {
+        for(std::size_t j = i + 1; j < resources.size(); j++) {
+            const bool aliveAtSameTime = resources[i].firstPass <= resources[j].lastPass && resources[j].firstPass <= resources[i].lastPass;
+            const bool sameMemory = layout.placements[i].offset < layout.placements[j].offset + resources[j].size
+                                 && layout.placements[j].offset < layout.placements[i].offset + resources[i].size;
+            EXPECT_FALSE(aliveAtSameTime && sameMemory) << i << " and " << j;
+        }
+    }
+}
+
+TEST(TransientAliasing, RespectsAlignment) {
+    std::vector<TransientResource> resources {
+        { .size = 100, .alignment = 1, .firstPass = 0, .lastPass = 1 },
+        { .size = 100, .alignment = 256, .firstPass = 0, .lastPass = 1 },
+    };
+    TransientHeapLayout layout = packTransientResources(resources);
+    EXPECT_EQ(layout.placements[0].offset, 0);
+    EXPECT_EQ(layout.placements[1].offset, 256);
+    EXPECT_EQ(layout.heaps[0].size, 356);
+
+    // padding is needed without aliasing too
+    EXPECT_EQ(layout.unaliasedSize, 356);
+    EXPECT_EQ(layout.getSavedBytes(), 0);
+}
+
+TEST(TransientAliasing, SavedBytesNeverWrap) {
+    // little overlap and big alignments: the padding must not make the savings negative
+    std::vector<TransientResource> resources {
+        { .size = 300, .alignment = 256, .firstPass = 0, .lastPass = 1 },
+        { .size = 10, .alignment = 1, .firstPass = 1, .lastPass = 2 },
+        { .size = 10, .alignment = 1024, .firstPass = 2, .lastPass = 3 },
+    };
+    TransientHeapLayout layout = packTransientResources(resources);
+    EXPECT_LE(layout.aliasedSize, layout.unaliasedSize);
+    EXPECT_LE(layout.getSavedBytes(), layout.unaliasedSize);
+
+    TransientHeapLayout inconsistent;
+    inconsistent.unaliasedSize = 100;
+    inconsistent.aliasedSize = 200;
+    EXPECT_EQ(inconsistent.getSavedBytes(), 0);
+}
+
+TEST(TransientAliasing, OneHeapPerMemoryType) {
+    std::vector<TransientResource> resources {
+        { .size = 1024, .memoryType = 0, .firstPass = 0, .lastPass = 0 },
+        { .size = 1024, .memoryType = 1, .firstPass = 1, .lastPass = 1 },
+    };
+    TransientHeapLayout layout = packTransientResources(resources);
+    ASSERT_EQ(layout.heaps.size(), 2);
+    EXPECT_NE(layout.placements[0].heapIndex, layout.placements[1].heapIndex);
+    EXPECT_EQ(layout.heaps[layout.placements[1].heapIndex].memoryType, 1);
+    EXPECT_EQ(layout.getSavedBytes(), 0);
+    EXPECT_TRUE(layout.placements[1].aliasedResources.empty());
+}
+
+TEST(TransientAliasing, GroupIsReleasedOnce) {
+    std::vector<Carrot::UUID> released;
+    auto release = [&](const Carrot::UUID& groupID) {
+        released.push_back(groupID);
+    };
+
+    Carrot::UUID firstID;
+    {
+        TransientGroup group { release };
+        firstID = group.getID();
+
+        // moving transfers the ownership, the moved-from group no longer releases anything
+        TransientGroup moved = std::move(group);
+        EXPECT_EQ(moved.getID(), firstID);
+        EXPECT_TRUE(released.empty());
+    }
+    ASSERT_EQ(released.size(), 1);
+    EXPECT_EQ(released[0], firstID);
+
+    // replacing a group (like a render graph rebuilt in place) releases the previous one
+    TransientGroup group { release };
+    const Carrot::UUID secondID = group.getID();
+    group = TransientGroup { release };
+    ASSERT_EQ(released.size(), 2);
+    EXPECT_EQ(released[1], secondID);
+
+    group.release();
+    group.release();
+    EXPECT_EQ(released.size(), 3);
+}
@@ -0,0 +1,210 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <core/render/VertexCompression.h>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace Carrot;
+
+static glm::vec3 randomDirection(std::mt19937& rng) {
+    std::normal_distribution<float> distribution { 0.0f, 1.0f };
+    glm::vec3 direction { 0.0f };
+    while(glm::dot(direction, direction) < 1e-6f) {
+        direction = glm::vec3 { distribution(rng), distribution(rng), distribution(rng) };
+    }
+    return glm::normalize(direction);
+}
+
+static std::vector<Vertex> makeVertices(std::size_t count) {
+    std::mt19937 rng { 42 };
+    std::uniform_real_distribution<float> positions { -50.0f, 50.0f };
+    std::uniform_real_distribution<float> uvs { -4.0f, 4.0f };
+    std::uniform_real_distribution<float> unit { 0.0f, 1.0f };
+    std::vector<Vertex> vertices(count);
+    for(auto& vertex : vertices) {
+        vertex.pos = glm::vec4 { positions(rng), positions(rng), positions(rng), 1.0f };
+        vertex.normal = randomDirection(rng);
+        vertex.tangent = glm::vec4 { randomDirection(rng), unit(rng) < 0.5f ? -1.0f : 1.0f };
+        vertex.uv = glm::vec2 { uvs(rng), uvs(rng) };
+        vertex.color = glm::vec3 { unit(rng), unit(rng), unit(rng) };
+    }
+    return vertices;
+}
+
+TEST(VertexCompression, Sizes) {
+    EXPECT_EQ(sizeof(CompressedVertex), 24);
+    EXPECT_EQ(sizeof(CompressedSkinnedVertex), 32);
+    EXPECT_LT(sizeof(CompressedVertex) * 3, sizeof(Vertex));
+}
+
+TEST(VertexCompression, PositionsStayWithinErrorBound) {
+    const std::vector<Vertex> vertices = makeVertices(4096);
+    const QuantizationBounds bounds = QuantizationBounds::compute(vertices);
+    const glm::vec3 maxError = VertexCompression::getMaxPositionError(bounds);
+
+    for(const auto& vertex : vertices) {
+        const Vertex decompressed = VertexCompression::decompress(VertexCompression::compress(vertex, bounds), bounds);
+        for(int axis = 0; axis < 3; axis++) {
+            // small epsilon for float rounding during decompression
+            EXPECT_LE(std::abs(decompressed.pos[axis] - vertex.pos[axis]), maxError[axis] + 1e-5f);
+        }
+        EXPECT_EQ(decompressed.pos.w, 1.0f);
+    }
+}
+
+TEST(VertexCompression, FlatBoundsDoNotDivideByZero) {
+    std::vector<Vertex> vertices = makeVertices(16);
+    for(auto& vertex : vertices) {
+        vertex.pos.y = 3.0f; // flat mesh
+    }
+    const QuantizationBounds bounds = QuantizationBounds::compute(vertices);
+    EXPECT_EQ(bounds.extent.y, 0.0f);
+    for(const auto& vertex : vertices) {
+        const Vertex decompressed = VertexCompression::decompress(VertexCompression::compress(vertex, bounds), bounds);
+        EXPECT_EQ(decompressed.pos.y, 3.0f);
+    }
+}
+
+TEST(VertexCompression, OctahedralDirectionsStayWithinErrorBound) {
+    // 16 bit octahedral encoding is expected to be well below 0.01 degrees of error
+    const float maxAngle = glm::radians(0.01f);
+    std::mt19937 rng { 1234 };
+
+    std::vector<glm::vec3> directions {
+        { 1, 0, 0 }, { -1, 0, 0 },
+        { 0, 1, 0 }, { 0, -1, 0 },
+        { 0, 0, 1 }, { 0, 0, -1 },
+        glm::normalize(glm::vec3 { 1, 1, -1 }),
+        glm::normalize(glm::vec3 { -1, -1, -1 }),
+    };
+    for(int i = 0; i < 10000; i++) {
+        directions.push_back(randomDirection(rng));
+    }
+
+    for(const glm::vec3& direction : directions) {
+        const glm::vec3 decoded = VertexCompression::decodeOctahedral(VertexCompression::encodeOctahedral(direction));
+        EXPECT_NEAR(glm::length(decoded), 1.0f, 1e-5f);
+        const float angle = std::atan2(glm::length(glm::cross(decoded, direction)), glm::dot(decoded, direction)); // more precise than acos for small angles
+        EXPECT_LE(angle, maxAngle) << direction.x << " " << direction.y << " " << direction.z;
+    }
+}
+
+TEST(VertexCompression, AttributesStayWithinErrorBound) {
+    const std::vector<Vertex> vertices = makeVertices(1024);
+    const QuantizationBounds bounds = QuantizationBounds::compute(vertices);
+
+    for(const auto& vertex : vertices) {
+        const Vertex decompressed = VertexCompression::decompress(VertexCompression::compress(vertex, bounds), bounds);
+
+        EXPECT_EQ(decompressed.tangent.w, vertex.tangent.w);
+        EXPECT_GT(glm::dot(glm::vec3 { decompressed.tangent }, glm::vec3 { vertex.tangent }), 0.99999f);
+        EXPECT_GT(glm::dot(decompressed.normal, vertex.normal), 0.99999f);
+
+        // half floats have 11 bits of precision
+        for(int i = 0; i < 2; i++) {
+            EXPECT_LE(std::abs(decompressed.uv[i] - vertex.uv[i]), std::max(std::abs(vertex.uv[i]), 1.0f) / 2048.0f);
+        }
+        for(int i = 0; i < 3; i++) {
+            EXPECT_LE(std::abs(decompressed.color[i] - vertex.color[i]), 0.5f / 255.0f + 1e-6f);
+        }
+    }
+}
+
+TEST(VertexCompression, BoneWeightsSumToOne) {
+    std::mt19937 rng { 5 };
+    std::uniform_real_distribution<float> unit { 0.0f, 1.0f };
+    for(int i = 0; i < 1000; i++) {
+        glm::vec4 weights { unit(rng), unit(rng), unit(rng), unit(rng) };
+        weights /= weights.x + weights.y + weights.z + weights.w;
+
+        const glm::u8vec4 encoded = VertexCompression::encodeBoneWeights(weights);
+        EXPECT_EQ(encoded.x + encoded.y + encoded.z + encoded.w, 255);
+
+        const glm::vec4 decoded = VertexCompression::decodeBoneWeights(encoded);
+        for(int j = 0; j < 4; j++) {
+            // quantization error + the rounding error given to the heaviest bone
+            EXPECT_LE(std::abs(decoded[j] - weights[j]), 2.0f / 255.0f);
+        }
+    }
+
+    EXPECT_EQ(VertexCompression::encodeBoneWeights(glm::vec4 { 0.0f }), glm::u8vec4 { 0 });
+}
+
+TEST(VertexCompression, SkinnedVertices) {
+    SkinnedVertex vertex;
+    static_cast<Vertex&>(vertex) = makeVertices(1)[0];
+    vertex.addBoneInformation(12, 0.25f);
+    vertex.addBoneInformation(3, 0.75f);
+    vertex.normalizeWeights();
+
+    const QuantizationBounds bounds { .min = glm::vec3 { -50.0f }, .extent = glm::vec3 { 100.0f } };
+    const CompressedSkinnedVertex compressed = VertexCompression::compress(vertex, bounds);
+    const SkinnedVertex decompressed = VertexCompression::decompress(compressed, bounds);
+
+    EXPECT_EQ(decompressed.boneIDs[0], 12);
+    EXPECT_EQ(decompressed.boneIDs[1], 3);
+    EXPECT_EQ(decompressed.boneIDs[2], -1); // unused slots stay unused
+    EXPECT_EQ(decompressed.boneIDs[3], -1);
+    EXPECT_NEAR(decompressed.boneWeights[0], 0.25f, 1.0f / 255.0f);
+    EXPECT_NEAR(decompressed.boneWeights[1], 0.75f, 1.0f / 255.0f);
+    EXPECT_GT(glm::dot(decompressed.normal, vertex.normal), 0.99999f);
+}
+
+TEST(VertexCompression, SharedMeshletVerticesDecodeIdentically) {
+    // two meshlets on opposite sides of the mesh, sharing vertex 2: bounds of each meshlet would be very different
+    std::vector<Vertex> vertices = makeVertices(5);
+    vertices[0].pos = glm::vec4 { -50.0f, -50.0f, -50.0f, 1.0f };
+    vertices[1].pos = glm::vec4 { -49.0f, -48.0f, -50.0f, 1.0f };
+    vertices[2].pos = glm::vec4 { 0.123f, 3.21f, -7.77f, 1.0f };
+    vertices[3].pos = glm::vec4 { 50.0f, 49.0f, 50.0f, 1.0f };
+    vertices[4].pos = glm::vec4 { 48.0f, 50.0f, 49.5f, 1.0f };
+    const std::vector<std::uint32_t> meshletVertexIndices { 0, 1, 2, 2, 3, 4 };
+    const std::vector<Render::Meshlet> meshlets {
+        Render::Meshlet { .vertexOffset = 0, .vertexCount = 3 },
+        Render::Meshlet { .vertexOffset = 3, .vertexCount = 3 },
+    };
+
+    std::vector<CompressedVertex> compressed(meshletVertexIndices.size());
+    const QuantizationBounds bounds = VertexCompression::compressMeshlets(vertices, meshlets, meshletVertexIndices, compressed);
+
+    std::vector<Vertex> decompressed(compressed.size());
+    VertexCompression::decompress(compressed, bounds, decompressed);
+    const glm::vec4 inFirstMeshlet = decompressed[2].pos;
+    const glm::vec4 inSecondMeshlet = decompressed[3].pos;
+    EXPECT_EQ(0, std::memcmp(&inFirstMeshlet, &inSecondMeshlet, sizeof(glm::vec4)));
+
+    const glm::vec3 maxError = VertexCompression::getMaxPositionError(bounds);
+    for(std::size_t i = 0; i < meshletVertexIndices.size(); i++) {
+        const glm::vec3 expected { vertices[meshletVertexIndices[i]].pos };
+        for(int axis = 0; axis < 3; axis++) {
+            EXPECT_LE(std::abs(decompressed[i].pos[axis] - expected[axis]), maxError[axis] * 1.01f);
+        }
+    }
+}
+
+TEST(VertexCompression, BoneIDsKeepAllEightBits) {
+    SkinnedVertex vertex;
+    static_cast<Vertex&>(vertex) = makeVertices(1)[0];
+    vertex.addBoneInformation(VertexCompression::MaxBoneID, 0.5f);
+    vertex.addBoneInformation(200, 0.3f);
+    vertex.addBoneInformation(127, 0.2f);
+    vertex.normalizeWeights();
+
+    const QuantizationBounds bounds { .min = glm::vec3 { -50.0f }, .extent = glm::vec3 { 100.0f } };
+    const CompressedSkinnedVertex compressed = VertexCompression::compress(vertex, bounds);
+    EXPECT_EQ(compressed.boneIDs[0], 255);
+    EXPECT_EQ(compressed.boneIDs[1], 200);
+    EXPECT_EQ(compressed.boneIDs[2], 127);
+
+    // same 8 bits as the original vertex
+    const SkinnedVertex decompressed = VertexCompression::decompress(compressed, bounds);
+    for(int i = 0; i < 3; i++) {
+        EXPECT_EQ(decompressed.boneIDs[i], vertex.boneIDs[i]);
+    }
+    EXPECT_EQ(decompressed.boneIDs[3], -1);
+}
@@ -0,0 +1,161 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include "engine/Engine.h"
+#include "engine/ecs/World.h"
+#include "engine/ecs/components/ForceSinPosition.h"
+#include "engine/ecs/components/Kinematics.h"
+#include "engine/ecs/components/TransformComponent.h"
+#include "engine/scene/BinaryScene.h"
+#include "engine/scene/Scene.h"
+
+#define _START_ENGINE_INTERNAL(APP_NAME)                    \
+Carrot::Configuration config;                               \
+config.applicationName = APP_NAME;                          \
+Carrot::Engine e{ config };
+
+#define START_ENGINE() _START_ENGINE_INTERNAL(__FUNCTION__)
+
+using namespace Carrot::ECS;
+
+/// Enough entities to split columns in several tasks. Transform and Kinematics have a binary representation, ForceSinPosition is stored as JSON
+static void fillScene(Carrot::Scene& scene, std::size_t entityCount) {
+    scene.lighting.ambient = glm::vec3 { 0.25f, 0.5f, 0.75f };
+    Entity root = scene.world.newEntity("Root").addComponent<TransformComponent>();
+    for(std::size_t i = 0; i < entityCount; i++) {
+        Entity entity = scene.world.newEntity("Entity " + std::to_string(i)).addComponent<TransformComponent>();
+        auto& transform = entity.getComponent<TransformComponent>()->localTransform;
+        transform.position = glm::vec3 { static_cast<float>(i), 1.0f, -2.0f };
+        transform.scale = glm::vec3 { 2.0f };
+        transform.rotation = glm::angleAxis(static_cast<float>(i) * 0.01f, glm::vec3 { 0, 1, 0 });
+        if(i % 2 == 0) {
+            entity.addComponent<Kinematics>();
+            entity.getComponent<Kinematics>()->velocity = glm::vec3 { 0.0f, static_cast<float>(i), 0.0f };
+        }
+        if(i % 10 == 0) {
+            entity.addComponent<ForceSinPosition>();
+            entity.getComponent<ForceSinPosition>()->amplitude = glm::vec3 { static_cast<float>(i) };
+            entity.setParent(root);
+            entity.setFlags(EntityFlags::Hidden);
+        }
+    }
+    scene.world.tick(0.0);
+}
+
+static void expectSameScenes(const Carrot::Scene& expected, const Carrot::Scene& actual) {
+    EXPECT_EQ(expected.lighting.ambient, actual.lighting.ambient);
+    ASSERT_EQ(expected.world.getAllEntities().size(), actual.world.getAllEntities().size());
+    for(const auto& entity : expected.world.getAllEntities()) {
+        ASSERT_TRUE(actual.world.exists(entity.getID()));
+        const Entity actualEntity = actual.world.wrap(entity.getID());
+        EXPECT_EQ(entity.getName(), actualEntity.getName());
+        EXPECT_EQ(entity.getFlags(), actualEntity.getFlags());
+        EXPECT_EQ(entity.getParent().has_value(), actualEntity.getParent().has_value());
+        if(entity.getParent().has_value() && actualEntity.getParent().has_value()) {
+            EXPECT_EQ(entity.getParent()->getID(), actualEntity.getParent()->getID());
+        }
+        EXPECT_EQ(entity.getAllComponents().size(), actualEntity.getAllComponents().size());
+
+        auto expectedTransform = expected.world.getComponent<TransformComponent>(entity.getID());
+        auto actualTransform = actual.world.getComponent<TransformComponent>(entity.getID());
+        ASSERT_TRUE(actualTransform.hasValue());
+        EXPECT_EQ(expectedTransform->localTransform.position, actualTransform->localTransform.position);
+        EXPECT_EQ(expectedTransform->localTransform.scale, actualTransform->localTransform.scale);
+        EXPECT_EQ(expectedTransform->localTransform.rotation, actualTransform->localTransform.rotation);
+
+        if(auto expectedKinematics = expected.world.getComponent<Kinematics>(entity.getID())) {
+            auto actualKinematics = actual.world.getComponent<Kinematics>(entity.getID());
+            ASSERT_TRUE(actualKinematics.hasValue());
+            EXPECT_EQ(expectedKinematics->velocity, actualKinematics->velocity);
+        }
+        if(auto expectedSin = expected.world.getComponent<ForceSinPosition>(entity.getID())) {
+            auto actualSin = actual.world.getComponent<ForceSinPosition>(entity.getID());
+            ASSERT_TRUE(actualSin.hasValue());
+            EXPECT_EQ(expectedSin->amplitude, actualSin->amplitude);
+        }
+    }
+}
+
+TEST(BinaryScene, RoundTrip) {
+    START_ENGINE();
+
+    Carrot::Scene original;
+    fillScene(original, 2000);
+    const std::vector<std::uint8_t> binary = original.serialiseBinary();
+
+    const Carrot::BinarySceneView view { binary };
+    ASSERT_EQ(view.getColumns().size(), 3u);
+    for(const auto& column : view.getColumns()) {
+        const bool isJSON = view.getString(column.componentName) == "ForceSinPosition";
+        EXPECT_EQ(column.encoding, isJSON ? Carrot::BinaryScene::Encoding::JSON : Carrot::BinaryScene::Encoding::Binary);
+    }
+
+    Carrot::Scene loaded;
+    loaded.deserialiseBinary(binary);
+    loaded.world.tick(0.0);
+    expectSameScenes(original, loaded);
+}
+
+TEST(BinaryScene, ConvertsFromAndToJSON) {
+    START_ENGINE();
+
+    Carrot::Scene original;
+    fillScene(original, 100);
+    rapidjson::Document json;
+    json.SetObject();
+    original.serialise(json);
+
+    const std::vector<std::uint8_t> binary = Carrot::BinaryScene::convertFromJSON(json);
+    Carrot::Scene fromBinary;
+    fromBinary.deserialiseBinary(binary);
+    fromBinary.world.tick(0.0);
+    expectSameScenes(original, fromBinary);
+
+    rapidjson::Document convertedBack;
+    Carrot::BinaryScene::convertToJSON(binary, convertedBack);
+    Carrot::Scene fromJSON;
+    fromJSON.deserialise(convertedBack);
+    fromJSON.world.tick(0.0);
+    expectSameScenes(original, fromJSON);
+}
+
+TEST(BinaryScene, RejectsInvalidData) {
+    START_ENGINE();
+
+    Carrot::Scene original;
+    fillScene(original, 10);
+    const std::vector<std::uint8_t> binary = original.serialiseBinary();
+
+    {
+        std::vector<std::uint8_t> wrongMagic = binary;
+        wrongMagic[0] ^= 0xFF;
+        EXPECT_THROW(Carrot::BinarySceneView { wrongMagic }, std::runtime_error);
+    }
+    {
+        std::vector<std::uint8_t> wrongVersion = binary;
+        const std::uint32_t version = Carrot::BinaryScene::Version + 1;
+        memcpy(wrongVersion.data() + offsetof(Carrot::BinaryScene::Header, version), &version, sizeof(version));
+        EXPECT_THROW(Carrot::BinarySceneView { wrongVersion }, std::runtime_error);
+    }
+    {
+        std::vector<std::uint8_t> truncated = binary;
+        truncated.resize(truncated.size() / 2);
+        EXPECT_THROW(Carrot::BinarySceneView { truncated }, std::runtime_error);
+    }
+    {
+        // valid structure, but the transform data is too short
+        std::vector<std::uint8_t> corrupted = binary;
+        Carrot::BinaryScene::Header header;
+        memcpy(&header, corrupted.data(), sizeof(header));
+        Carrot::BinaryScene::Cell cell;
+        memcpy(&cell, corrupted.data() + header.cells.offset, sizeof(cell));
+        cell.size = 4;
+        memcpy(corrupted.data() + header.cells.offset, &cell, sizeof(cell));
+
+        Carrot::Scene loaded;
+        EXPECT_THROW(loaded.deserialiseBinary(corrupted), std::runtime_error);
+    }
+}
@@ -0,0 +1,101 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <engine/render/GBuffer.h>
+#include <engine/render/GBufferPacking.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+using namespace Carrot::Render;
+
+static glm::vec3 randomUnitVector(std::mt19937& rng) {
+    std::uniform_real_distribution<float> distribution { -1.0f, 1.0f };
+    glm::vec3 v;
+    do {
+        v = glm::vec3 { distribution(rng), distribution(rng), distribution(rng) };
+    } while(glm::dot(v, v) < 1e-4f);
+    return glm::normalize(v);
+}
+
+TEST(GBufferPacking, NormalTangentRoundTrip) {
+    std::mt19937 rng { 42 };
+    float maxError = 0.0f;
+    for(int i = 0; i < 100'000; i++) {
+        const glm::vec3 normal = randomUnitVector(rng);
+        const glm::vec3 tangent = randomUnitVector(rng);
+        const glm::uvec2 packed = GBufferPacking::packGBufferNormalTangent(normal, tangent);
+
+        const glm::vec3 unpackedNormal = GBufferPacking::unpackGBufferNormal(packed);
+        const glm::vec3 unpackedTangent = GBufferPacking::unpackGBufferTangent(packed);
+        maxError = glm::max(maxError, glm::distance(normal, unpackedNormal));
+        maxError = glm::max(maxError, glm::distance(tangent, unpackedTangent));
+    }
+    // distance between unit vectors ~= angle in radians: 2x snorm16 octahedral encoding is well below 0.01 degrees of error
+    EXPECT_LT(glm::degrees(maxError), 0.01f);
+
+    // axes are exact
+    for(const glm::vec3& axis : { glm::vec3 { 1, 0, 0 }, glm::vec3 { 0, -1, 0 }, glm::vec3 { 0, 0, 1 }, glm::vec3 { 0, 0, -1 } }) {
+        const glm::uvec2 packed = GBufferPacking::packGBufferNormalTangent(axis, axis);
+        EXPECT_LT(glm::distance(GBufferPacking::unpackGBufferNormal(packed), axis), 1e-6f);
+    }
+}
+
+TEST(GBufferPacking, FlagsRoundTrip) {
+    for(std::uint32_t intProperties = 0; intProperties < 16; intProperties++) {
+        for(float value = 0.0f; value <= 1.0f; value += 1.0f / 64.0f) {
+            const std::uint32_t packed = GBufferPacking::packGBufferFlags(intProperties, value, 1.0f - value);
+            EXPECT_EQ(GBufferPacking::unpackGBufferIntProperties(packed), intProperties);
+            EXPECT_NEAR(GBufferPacking::unpackGBufferMetallicness(packed), value, 0.5f / 255.0f + 1e-6f);
+            EXPECT_NEAR(GBufferPacking::unpackGBufferRoughness(packed), 1.0f - value, 0.5f / 255.0f + 1e-6f);
+        }
+    }
+
+    // out of range values are clamped and do not overwrite other fields
+    const std::uint32_t packed = GBufferPacking::packGBufferFlags(0xFFFFFFFFu, 2.0f, -1.0f);
+    EXPECT_EQ(GBufferPacking::unpackGBufferIntProperties(packed), 0xFFu);
+    EXPECT_EQ(GBufferPacking::unpackGBufferMetallicness(packed), 1.0f);
+    EXPECT_EQ(GBufferPacking::unpackGBufferRoughness(packed), 0.0f);
+}
+
+TEST(GBufferPacking, EmissiveRoundTrip) {
+    std::mt19937 rng { 42 };
+    std::uniform_real_distribution<float> distribution { 0.0f, 100.0f };
+    for(int i = 0; i < 10'000; i++) {
+        const glm::vec3 emissive { distribution(rng), distribution(rng), distribution(rng) };
+        const glm::vec3 unpacked = GBufferPacking::unpackEmissive(GBufferPacking::packEmissive(emissive));
+
+        // 6 bits of mantissa for R and G, 5 bits for B
+        EXPECT_NEAR(unpacked.r, emissive.r, emissive.r / 64.0f);
+        EXPECT_NEAR(unpacked.g, emissive.g, emissive.g / 64.0f);
+        EXPECT_NEAR(unpacked.b, emissive.b, emissive.b / 32.0f);
+    }
+    EXPECT_EQ(GBufferPacking::unpackEmissive(GBufferPacking::packEmissive(glm::vec3 { -1.0f })), glm::vec3 { 0.0f });
+}
+
+TEST(GBufferPacking, PositionFromDepth) {
+    glm::mat4 projection = glm::perspectiveRH_ZO(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+    projection[1][1] *= -1; // Vulkan Y axis, like Camera
+    const glm::mat4 inverseProjection = glm::inverse(projection);
+
+    std::mt19937 rng { 42 };
+    std::uniform_real_distribution<float> xy { -10.0f, 10.0f };
+    std::uniform_real_distribution<float> z { -500.0f, -1.0f };
+    for(int i = 0; i < 10'000; i++) {
+        const glm::vec3 viewPosition { xy(rng), xy(rng), z(rng) };
+        const glm::vec4 clip = projection * glm::vec4(viewPosition, 1.0f);
+        const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        const glm::vec2 uv = glm::vec2(ndc) * 0.5f + 0.5f;
+
+        const glm::vec3 reconstructed = GBufferPacking::reconstructViewPosition(uv, ndc.z, inverseProjection);
+        EXPECT_LT(glm::distance(reconstructed, viewPosition), -viewPosition.z * 1e-3f);
+    }
+}
+
+TEST(GBufferPacking, BytesPerPixel) {
+    EXPECT_EQ(Carrot::GBuffer::getColorBytesPerPixel(Carrot::GBuffer::Layout::Standard), 104u);
+    EXPECT_EQ(Carrot::GBuffer::getColorBytesPerPixel(Carrot::GBuffer::Layout::Packed), 44u);
+    EXPECT_EQ(Carrot::GBuffer::getColorTargetCount(Carrot::GBuffer::Layout::Standard), 7u);
+    EXPECT_EQ(Carrot::GBuffer::getColorTargetCount(Carrot::GBuffer::Layout::Packed), 6u);
+}
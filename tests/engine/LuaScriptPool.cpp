@@ -0,0 +1,112 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+#include <core/io/IO.h>
+#include "engine/Engine.h"
+#include "engine/scripting/LuaScriptPool.h"
+
+#define _START_ENGINE_INTERNAL(APP_NAME)                    \
+Carrot::Configuration config;                               \
+config.applicationName = APP_NAME;                          \
+Carrot::Engine e{ config };
+
+#define START_ENGINE() _START_ENGINE_INTERNAL(__FUNCTION__)
+
+static void writeScript(const std::filesystem::path& path, const char* code) {
+    Carrot::IO::writeFile(path.string(), (void*)code, std::strlen(code));
+}
+
+TEST(LuaScriptPool, OneVMPerThread) {
+    START_ENGINE();
+
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "CarrotLuaScriptPoolTests";
+    std::filesystem::create_directories(root);
+    writeScript(root / "stateless.lua", R"lua(
+-- moves the entity
+--!stateless
+function eachTick(entity, dt) end
+)lua");
+    writeScript(root / "stateful.lua", R"lua(
+counter = 0
+function start(entity) counter = counter + 1 end
+)lua");
+    GetVFS().addRoot("luapooltests", root);
+
+    Carrot::Lua::ScriptPool& pool = Carrot::Lua::ScriptPool::instance();
+    pool.clear();
+
+    const Carrot::IO::VFS::Path statelessPath { "luapooltests://stateless.lua" };
+    const Carrot::IO::VFS::Path statefulPath { "luapooltests://stateful.lua" };
+    EXPECT_TRUE(pool.isStateless(statelessPath));
+    EXPECT_FALSE(pool.isStateless(statefulPath));
+    EXPECT_FALSE(pool.isStateless("luapooltests://missing.lua"));
+    EXPECT_EQ(pool.getVMCount(), 0u); // statelessness is read from the source, scripts are not run
+
+    // entry points are loaded once per VM
+    const Carrot::Lua::EntryPoints* pEntryPoints = pool.getEntryPoints(statelessPath);
+    ASSERT_NE(pEntryPoints, nullptr);
+    EXPECT_EQ(pEntryPoints, pool.getEntryPoints(statelessPath));
+    EXPECT_TRUE(pEntryPoints->eachTick.valid());
+    EXPECT_FALSE(pEntryPoints->start.valid());
+    EXPECT_EQ(pool.getVMCount(), 1u);
+
+    const Carrot::Lua::EntryPoints* pOtherThreadEntryPoints = nullptr;
+    std::thread otherThread([&]() {
+        pOtherThreadEntryPoints = pool.getEntryPoints(statelessPath);
+    });
+    otherThread.join();
+    EXPECT_NE(pOtherThreadEntryPoints, nullptr);
+    EXPECT_NE(pOtherThreadEntryPoints, pEntryPoints);
+    EXPECT_EQ(pool.getVMCount(), 2u);
+    EXPECT_GT(pool.getMemoryUsage(), 0u);
+
+    pool.clear();
+    EXPECT_EQ(pool.getVMCount(), 0u);
+    GetVFS().removeRoot("luapooltests");
+}
+
+TEST(LuaScriptPool, StatelessAnnotation) {
+    START_ENGINE();
+
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "CarrotLuaScriptPoolTests";
+    std::filesystem::create_directories(root);
+    writeScript(root / "annotation_after_code.lua", R"lua(
+function eachTick(entity, dt) end
+--!stateless
+)lua");
+    writeScript(root / "global_flag.lua", R"lua(
+stateless = true
+)lua");
+    writeScript(root / "reloaded.lua", R"lua(
+--!stateless
+function eachTick(entity, dt) end
+)lua");
+    GetVFS().addRoot("luapooltests", root);
+
+    Carrot::Lua::ScriptPool& pool = Carrot::Lua::ScriptPool::instance();
+    pool.clear();
+    EXPECT_FALSE(pool.isStateless("luapooltests://annotation_after_code.lua"));
+    EXPECT_FALSE(pool.isStateless("luapooltests://global_flag.lua"));
+
+    // scripts are loaded again after clear()
+    const Carrot::IO::VFS::Path reloadedPath { "luapooltests://reloaded.lua" };
+    EXPECT_TRUE(pool.isStateless(reloadedPath));
+    ASSERT_NE(pool.getEntryPoints(reloadedPath), nullptr);
+    EXPECT_TRUE(pool.getEntryPoints(reloadedPath)->eachTick.valid());
+    writeScript(root / "reloaded.lua", R"lua(
+--!stateless
+function eachFrame(entity, renderContext) end
+)lua");
+    pool.clear();
+    ASSERT_NE(pool.getEntryPoints(reloadedPath), nullptr);
+    EXPECT_FALSE(pool.getEntryPoints(reloadedPath)->eachTick.valid());
+    EXPECT_TRUE(pool.getEntryPoints(reloadedPath)->eachFrame.valid());
+
+    pool.clear();
+    GetVFS().removeRoot("luapooltests");
+}
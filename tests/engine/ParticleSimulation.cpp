@@ -0,0 +1,135 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <engine/render/particles/ParticleSimulation.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace Carrot;
+
+static std::vector<Particle> makeParticles(std::size_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<float> position { -100.0f, 100.0f };
+    std::uniform_real_distribution<float> life { -1.0f, 1.0f };
+    std::vector<Particle> particles { count };
+    for(std::size_t i = 0; i < count; i++) {
+        particles[i].position = glm::vec3 { position(rng), position(rng), position(rng) };
+        particles[i].life = life(rng);
+        particles[i].id = static_cast<std::uint32_t>(i);
+    }
+    return particles;
+}
+
+TEST(ParticleSimulation, EmitAppendsRequestedParticles) {
+    std::vector<Particle> pool { 10 };
+    const std::vector<Particles::EmissionRequest> requests {
+        { .positionX = 1.0f, .positionY = 2.0f, .positionZ = 3.0f, .count = 2, .firstParticle = 0, .firstID = 100 },
+        { .positionX = -1.0f, .positionY = 0.0f, .positionZ = 0.0f, .count = 3, .firstParticle = 2, .firstID = 7 },
+    };
+
+    const std::uint32_t aliveCount = Particles::emit(pool, 4, requests);
+    EXPECT_EQ(aliveCount, 9);
+    EXPECT_EQ(pool[4].id, 100);
+    EXPECT_EQ(pool[5].id, 101);
+    EXPECT_EQ(pool[6].id, 7);
+    EXPECT_EQ(pool[8].id, 9);
+    EXPECT_EQ(pool[4].position, glm::vec3(1.0f, 2.0f, 3.0f));
+    EXPECT_EQ(pool[8].position, glm::vec3(-1.0f, 0.0f, 0.0f));
+
+    for(std::size_t i = 4; i < 9; i++) {
+        EXPECT_GT(pool[i].life, 0.0f);
+        EXPECT_GE(pool[i].velocity.x, -0.5f);
+        EXPECT_LT(pool[i].velocity.x, 0.5f);
+        EXPECT_GE(pool[i].velocity.z, 1.0f);
+        EXPECT_LT(pool[i].velocity.z, 2.5f);
+    }
+
+    // same id, same particle: the GPU computes the same values
+    const Particle respawned = Particles::spawnParticle(requests[1], 2);
+    EXPECT_EQ(respawned.velocity, pool[8].velocity);
+    EXPECT_EQ(respawned.life, pool[8].life);
+}
+
+TEST(ParticleSimulation, EmitStopsAtCapacity) {
+    std::vector<Particle> pool { 8 };
+    const std::vector<Particles::EmissionRequest> requests {
+        { .count = 5, .firstParticle = 0, .firstID = 0 },
+    };
+    EXPECT_EQ(Particles::emit(pool, 6, requests), 8);
+    EXPECT_EQ(pool[6].id, 0);
+    EXPECT_EQ(pool[7].id, 1);
+}
+
+TEST(ParticleSimulation, CompactRemovesDeadParticles) {
+    std::mt19937 rng { 42 };
+    const auto particles = makeParticles(1000, rng);
+    std::vector<Particle> output { particles.size() };
+
+    const std::uint32_t count = Particles::compact(particles, output);
+    const auto expectedCount = std::count_if(particles.begin(), particles.end(), [](const Particle& p) { return p.life >= 0.0f; });
+    ASSERT_EQ(count, expectedCount);
+
+    std::uint32_t previousID = 0;
+    for(std::uint32_t i = 0; i < count; i++) {
+        EXPECT_GE(output[i].life, 0.0f);
+        if(i > 0) {
+            EXPECT_GT(output[i].id, previousID);
+        }
+        previousID = output[i].id;
+    }
+}
+
+TEST(ParticleSimulation, BitonicSortMatchesStdSort) {
+    std::mt19937 rng { 42 };
+    std::uniform_int_distribution<std::uint32_t> keys { 0, 50 }; // many duplicated keys
+    constexpr std::uint32_t Capacity = 1500;
+    for(std::uint32_t count : { 0u, 1u, 2u, 3u, 17u, 64u, 1000u, Capacity }) {
+        std::vector<Particles::SortEntry> entries { Particles::nextPowerOfTwo(count) };
+        for(std::uint32_t i = 0; i < count; i++) {
+            entries[i] = Particles::SortEntry { .key = keys(rng), .index = i };
+        }
+        // garbage after the real entries, like on the GPU
+        for(std::uint32_t i = count; i < entries.size(); i++) {
+            entries[i] = Particles::SortEntry { .key = 0, .index = 0 };
+        }
+        std::vector<Particles::SortEntry> expected { entries.begin(), entries.begin() + count };
+        std::sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) { return b > a; });
+
+        Particles::bitonicSort(entries, count, Capacity);
+        for(std::uint32_t i = 0; i < count; i++) {
+            EXPECT_EQ(entries[i].key, expected[i].key) << "count = " << count << ", i = " << i;
+            EXPECT_EQ(entries[i].index, expected[i].index) << "count = " << count << ", i = " << i;
+        }
+    }
+}
+
+TEST(ParticleSimulation, CompactAndSortBackToFront) {
+    std::mt19937 rng { 1234 };
+    auto pool = makeParticles(777, rng);
+    const auto initial = pool;
+    const glm::vec3 camera { 10.0f, -5.0f, 2.0f };
+
+    const std::uint32_t count = Particles::compactAndSort(pool, 700, camera);
+
+    std::vector<std::uint32_t> expectedIDs;
+    for(std::size_t i = 0; i < 700; i++) {
+        if(initial[i].life >= 0.0f) {
+            expectedIDs.push_back(initial[i].id);
+        }
+    }
+    ASSERT_EQ(count, expectedIDs.size());
+
+    std::vector<std::uint32_t> ids;
+    for(std::uint32_t i = 0; i < count; i++) {
+        ids.push_back(pool[i].id);
+        if(i > 0) {
+            const float previousDistance = glm::dot(pool[i-1].position - camera, pool[i-1].position - camera);
+            const float distance = glm::dot(pool[i].position - camera, pool[i].position - camera);
+            EXPECT_GE(previousDistance, distance);
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(ids, expectedIDs);
+}
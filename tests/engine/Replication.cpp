@@ -0,0 +1,302 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <engine/network/replication/Snapshots.h>
+#include <deque>
+#include <random>
+
+using namespace Carrot::Network::Replication;
+
+static Schema makeSchema() {
+    const auto position = Carrot::IO::Quantization::withPrecision(-512.0f, 512.0f, 0.01f);
+    Schema schema;
+    schema.components.push_back(ComponentSchema {
+        .name = "Transform",
+        .fields = {
+            { "x", position },
+            { "y", position },
+            { "z", position },
+        },
+    });
+    schema.components.push_back(ComponentSchema {
+        .name = "Health",
+        .fields = {
+            { "value", Carrot::IO::Quantization::withPrecision(0.0f, 100.0f, 1.0f) },
+        },
+    });
+    return schema;
+}
+
+static EntityState makeEntity(const Schema& schema, float x, std::optional<float> health = {}) {
+    EntityState entity;
+    entity.entityID = Carrot::UUID { 1, 2, 3, static_cast<std::uint32_t>(x * 1000.0f) };
+    entity.components.resize(schema.components.size());
+    entity.componentMask = 1;
+    const auto& q = schema.components[0].fields[0].quantization;
+    entity.components[0] = { q.quantize(x), q.quantize(0.0f), q.quantize(0.0f) };
+    if(health.has_value()) {
+        entity.componentMask |= 2;
+        entity.components[1] = { schema.components[1].fields[0].quantization.quantize(health.value()) };
+    }
+    return entity;
+}
+
+static void expectSameState(const WorldState& actual, const WorldState& expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for(const auto& [id, entity] : expected) {
+        auto it = actual.find(id);
+        ASSERT_NE(it, actual.end()) << "missing entity " << id;
+        EXPECT_EQ(it->second.entityID, entity.entityID);
+        EXPECT_EQ(it->second.componentMask, entity.componentMask);
+        for(std::size_t c = 0; c < entity.components.size(); c++) {
+            if(entity.hasComponent(c)) {
+                EXPECT_EQ(it->second.components[c], entity.components[c]) << "entity " << id << ", component " << c;
+            }
+        }
+    }
+}
+
+TEST(Replication, OnlyChangedFieldsAreSent) {
+    const Schema schema = makeSchema();
+    SnapshotWriter writer { schema };
+    SnapshotReader reader { schema };
+    std::vector<EntityChange> changes;
+
+    WorldState state;
+    for(NetID id = 0; id < 10; id++) {
+        state[id] = makeEntity(schema, static_cast<float>(id), 50.0f);
+    }
+
+    auto snapshot = writer.write(0, state);
+    ASSERT_EQ(reader.read(snapshot, changes), 0);
+    EXPECT_EQ(changes.size(), 10);
+    EXPECT_EQ(changes[0].type, EntityChange::Type::Created);
+    EXPECT_EQ(changes[0].addedComponents, 3);
+    expectSameState(reader.getState(), state);
+    const std::size_t fullSize = snapshot.size();
+
+    // not acknowledged yet: everything is sent again
+    snapshot = writer.write(1, state);
+    EXPECT_EQ(snapshot.size(), fullSize);
+    writer.acknowledge(0); // older than the last snapshot, which contained the same values: nothing is considered synced
+    writer.acknowledge(1);
+    EXPECT_EQ(writer.getInFlightCount(), 0);
+
+    snapshot = writer.write(2, state);
+    EXPECT_EQ(writer.getLastStatistics().entitiesWritten, 0);
+    EXPECT_LE(snapshot.size(), 7); // header only
+
+    const auto& q = schema.components[0].fields[1].quantization;
+    state[3].components[0][1] = q.quantize(10.0f);
+    snapshot = writer.write(3, state);
+    EXPECT_EQ(writer.getLastStatistics().entitiesWritten, 1);
+    // 1 field of 15 bits, a few flags: much smaller than sending the entity
+    EXPECT_LE(snapshot.size(), 7 + 5);
+
+    changes.clear();
+    ASSERT_EQ(reader.read(snapshot, changes), 3);
+    ASSERT_EQ(changes.size(), 1);
+    EXPECT_EQ(changes[0].id, 3);
+    EXPECT_EQ(changes[0].type, EntityChange::Type::Updated);
+    EXPECT_EQ(changes[0].changedComponents, 1);
+    expectSameState(reader.getState(), state);
+}
+
+TEST(Replication, ComponentsAndEntitiesLifetime) {
+    const Schema schema = makeSchema();
+    SnapshotWriter writer { schema };
+    SnapshotReader reader { schema };
+    std::vector<EntityChange> changes;
+
+    WorldState state;
+    state[0] = makeEntity(schema, 1.0f);
+    state[1] = makeEntity(schema, 2.0f, 10.0f);
+    Tick tick = 0;
+    auto exchange = [&]() {
+        changes.clear();
+        auto snapshot = writer.write(tick, state);
+        auto ack = reader.read(snapshot, changes);
+        ASSERT_TRUE(ack.has_value());
+        writer.acknowledge(ack.value());
+        tick++;
+    };
+
+    exchange();
+    expectSameState(reader.getState(), state);
+
+    // add a component
+    state[0].componentMask |= 2;
+    state[0].components[1] = { 42 };
+    exchange();
+    ASSERT_EQ(changes.size(), 1);
+    EXPECT_EQ(changes[0].addedComponents, 2);
+    expectSameState(reader.getState(), state);
+
+    // remove it, then add it back with the same value: must be sent again because the reader forgot it
+    state[0].componentMask &= ~2ull;
+    state[0].components[1].clear();
+    exchange();
+    ASSERT_EQ(changes.size(), 1);
+    EXPECT_EQ(changes[0].removedComponents, 2);
+    state[0].componentMask |= 2;
+    state[0].components[1] = { 42 };
+    exchange();
+    expectSameState(reader.getState(), state);
+
+    // destroy
+    state.erase(1);
+    exchange();
+    ASSERT_EQ(changes.size(), 1);
+    EXPECT_EQ(changes[0].type, EntityChange::Type::Destroyed);
+    EXPECT_EQ(changes[0].id, 1);
+    expectSameState(reader.getState(), state);
+
+    exchange();
+    EXPECT_TRUE(changes.empty());
+}
+
+TEST(Replication, OutOfOrderSnapshotsAreIgnored) {
+    const Schema schema = makeSchema();
+    SnapshotWriter writer { schema };
+    SnapshotReader reader { schema };
+    std::vector<EntityChange> changes;
+
+    WorldState state;
+    state[0] = makeEntity(schema, 1.0f);
+    auto first = writer.write(0, state);
+    state[0].components[0][0] = 1234;
+    auto second = writer.write(1, state);
+
+    EXPECT_EQ(reader.read(second, changes), 1);
+    EXPECT_FALSE(reader.read(first, changes).has_value());
+    expectSameState(reader.getState(), state);
+}
+
+TEST(Replication, RejectsMismatchedSchema) {
+    const Schema schema = makeSchema();
+    Schema otherSchema = makeSchema();
+    otherSchema.components[1].fields[0].quantization.bits = 8;
+
+    SnapshotWriter writer { schema };
+    SnapshotReader reader { otherSchema };
+    std::vector<EntityChange> changes;
+    WorldState state;
+    state[0] = makeEntity(schema, 1.0f);
+    EXPECT_THROW(reader.read(writer.write(0, state), changes), std::runtime_error);
+
+    SnapshotReader validReader { schema };
+    auto snapshot = writer.write(1, state);
+    snapshot.resize(snapshot.size() / 2);
+    EXPECT_THROW(validReader.read(snapshot, changes), std::runtime_error);
+    EXPECT_TRUE(validReader.getState().empty());
+}
+
+TEST(Replication, BudgetFavorsRelevantEntities) {
+    const Schema schema = makeSchema();
+    SnapshotWriter writer { schema };
+    writer.setBudget(300);
+    SnapshotReader reader { schema };
+    std::vector<EntityChange> changes;
+
+    WorldState state;
+    for(NetID id = 0; id < 100; id++) {
+        state[id] = makeEntity(schema, static_cast<float>(id));
+    }
+
+    auto relevance = [](NetID id, const EntityState&) {
+        return id < 10 ? 100.0f : 1.0f;
+    };
+    auto snapshot = writer.write(0, state, relevance);
+    EXPECT_LE(snapshot.size(), 300);
+    EXPECT_GT(writer.getLastStatistics().entitiesDeferred, 0);
+    ASSERT_EQ(reader.read(snapshot, changes), 0);
+    for(NetID id = 0; id < 10; id++) {
+        EXPECT_TRUE(reader.getState().contains(id)) << id;
+    }
+    writer.acknowledge(0);
+
+    // everything ends up being sent, less relevant entities accumulate priority until they are sent
+    for(Tick tick = 1; tick < 20; tick++) {
+        snapshot = writer.write(tick, state, relevance);
+        EXPECT_LE(snapshot.size(), 300);
+        ASSERT_EQ(reader.read(snapshot, changes), tick);
+        writer.acknowledge(tick);
+    }
+    expectSameState(reader.getState(), state);
+}
+
+/// Server and client exchanging snapshots and acknowledgements over a network losing and reordering packets
+TEST(Replication, ConvergesOverLossyLink) {
+    const Schema schema = makeSchema();
+    SnapshotWriter writer { schema };
+    writer.setBudget(400);
+    SnapshotReader reader { schema };
+    std::vector<EntityChange> changes;
+
+    std::mt19937 rng { 1234 };
+    std::uniform_real_distribution<float> position { -500.0f, 500.0f };
+    std::uniform_int_distribution<int> percent { 0, 99 };
+
+    struct InFlight {
+        int deliveryTick = 0;
+        std::vector<std::uint8_t> data;
+    };
+    std::deque<InFlight> toClient;
+    std::deque<std::pair<int, Tick>> toServer;
+
+    WorldState state;
+    NetID nextID = 0;
+    for(; nextID < 200; nextID++) {
+        state[nextID] = makeEntity(schema, position(rng), 50.0f);
+    }
+    const auto& q = schema.components[0].fields[0].quantization;
+
+    for(int tick = 0; tick < 300; tick++) {
+        if(tick < 250) {
+            // churn: moves, spawns, deaths
+            for(int i = 0; i < 20; i++) {
+                auto it = state.find(rng() % nextID);
+                if(it != state.end()) {
+                    it->second.components[0][0] = q.quantize(position(rng));
+                }
+            }
+            if(percent(rng) < 20) {
+                state[nextID] = makeEntity(schema, position(rng));
+                nextID++;
+            }
+            if(percent(rng) < 20) {
+                state.erase(rng() % nextID);
+            }
+        }
+
+        auto snapshot = writer.write(tick, state);
+        EXPECT_LE(snapshot.size(), 400);
+        if(percent(rng) >= 30) { // 30% loss
+            toClient.push_back({ tick + 1 + static_cast<int>(rng() % 4), std::move(snapshot) });
+        }
+
+        for(auto it = toClient.begin(); it != toClient.end();) {
+            if(it->deliveryTick > tick) {
+                ++it;
+                continue;
+            }
+            auto ack = reader.read(it->data, changes);
+            if(ack.has_value() && percent(rng) >= 30) {
+                toServer.emplace_back(tick + 1 + static_cast<int>(rng() % 4), ack.value());
+            }
+            it = toClient.erase(it);
+        }
+        for(auto it = toServer.begin(); it != toServer.end();) {
+            if(it->first > tick) {
+                ++it;
+                continue;
+            }
+            writer.acknowledge(it->second);
+            it = toServer.erase(it);
+        }
+    }
+
+    expectSameState(reader.getState(), state);
+}
@@ -0,0 +1,210 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <core/data/ShaderReflection.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <spirv_cross.hpp>
+#include <spirv_parser.hpp>
+
+using namespace ShaderCompiler;
+
+/// Shaders compiled by the build, next to the executables like the engine expects them
+static const std::filesystem::path ShadersFolder = "resources/shaders";
+
+static std::vector<std::uint8_t> readFile(const std::filesystem::path& path) {
+    std::ifstream file { path, std::ios::binary };
+    return std::vector<std::uint8_t> { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
+static std::vector<std::filesystem::path> findCompiledShaders() {
+    std::vector<std::filesystem::path> shaders;
+    if(std::filesystem::exists(ShadersFolder)) {
+        for(const auto& entry : std::filesystem::recursive_directory_iterator(ShadersFolder)) {
+            if(entry.is_regular_file() && entry.path().extension() == ".spv") {
+                shaders.push_back(entry.path());
+            }
+        }
+    }
+    return shaders;
+}
+
+/// Reflection done like ShaderModule did before reflection was baked, independently of Reflection::fromSPIRV
+static Reflection reflectLikeShaderModule(const std::vector<std::uint8_t>& code) {
+    std::vector<std::uint32_t> asWords;
+    asWords.resize(code.size() / sizeof(std::uint32_t));
+    std::memcpy(asWords.data(), code.data(), code.size());
+    spirv_cross::Parser parser(std::move(asWords));
+    parser.parse();
+    spirv_cross::Compiler compiler { std::move(parser.get_parsed_ir()) };
+    const auto resources = compiler.get_shader_resources();
+
+    Reflection reflection;
+    auto createBindingsSet = [&](ResourceType type, const spirv_cross::SmallVector<spirv_cross::Resource>& resourceList) {
+        for(const auto& resource : resourceList) {
+            const auto& resourceType = compiler.get_type(resource.type_id);
+            Reflection::Resource& binding = reflection.resources.emplace_back();
+            binding.name = resource.name;
+            binding.set = compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
+            binding.binding = compiler.get_decoration(resource.id, spv::DecorationBinding);
+            binding.type = type;
+            if(!resourceType.array.empty()) {
+                if(resourceType.array_size_literal[0]) {
+                    binding.count = resourceType.array[0];
+                } else {
+                    const std::uint32_t varId = resourceType.array[0];
+                    binding.count = compiler.get_constant(varId).scalar(); // default value
+                    binding.countConstant = compiler.get_name(varId);
+                }
+            }
+        }
+    };
+    createBindingsSet(ResourceType::UniformBuffer, resources.uniform_buffers);
+    createBindingsSet(ResourceType::Sampler, resources.separate_samplers);
+    createBindingsSet(ResourceType::CombinedImageSampler, resources.sampled_images);
+    createBindingsSet(ResourceType::SampledImage, resources.separate_images);
+    createBindingsSet(ResourceType::InputAttachment, resources.subpass_inputs);
+    createBindingsSet(ResourceType::StorageBuffer, resources.storage_buffers);
+    createBindingsSet(ResourceType::StorageImage, resources.storage_images);
+    createBindingsSet(ResourceType::AccelerationStructure, resources.acceleration_structures);
+
+    if(resources.push_constant_buffers.size() != 0) {
+        const auto& pushConstant = resources.push_constant_buffers[0];
+        std::uint32_t offset = std::numeric_limits<std::uint32_t>::max();
+        std::uint32_t size = 0;
+        for(const auto& r : compiler.get_active_buffer_ranges(pushConstant.id)) {
+            offset = std::min(static_cast<std::uint32_t>(r.offset), offset);
+            size = std::max(static_cast<std::uint32_t>(r.offset + r.range), size);
+        }
+        reflection.pushConstants = Reflection::PushConstantBlock {
+            .name = pushConstant.name,
+            .offset = offset,
+            .size = size,
+        };
+    }
+    return reflection;
+}
+
+/// Descriptor bindings, in an order which does not depend on the extraction
+static std::vector<Reflection::Resource> sortedResources(std::vector<Reflection::Resource> resources) {
+    std::sort(resources.begin(), resources.end(), [](const Reflection::Resource& a, const Reflection::Resource& b) {
+        if(a.set != b.set) {
+            return a.set < b.set;
+        }
+        if(a.binding != b.binding) {
+            return a.binding < b.binding;
+        }
+        return a.name < b.name;
+    });
+    return resources;
+}
+
+/// The sidecars written by shadercompiler must describe the same layout as the SPIRV-Cross extraction ShaderModule used to do
+TEST(ShaderReflection, BakedMatchesSPIRVCross) {
+    const std::vector<std::filesystem::path> shaders = findCompiledShaders();
+    ASSERT_FALSE(shaders.empty()) << "No compiled shader inside " << ShadersFolder << ", tests must run from the build folder";
+
+    for(const auto& shaderPath : shaders) {
+        SCOPED_TRACE(shaderPath.string());
+        const std::filesystem::path sidecarPath = Reflection::getSidecarPath(shaderPath);
+        ASSERT_TRUE(std::filesystem::exists(sidecarPath));
+
+        const std::vector<std::uint8_t> code = readFile(shaderPath);
+        const Reflection baked = Reflection::deserialise(readFile(sidecarPath));
+        const Reflection expected = reflectLikeShaderModule(code);
+        EXPECT_EQ(baked.codeHash, Reflection::hashCode(code));
+        EXPECT_EQ(sortedResources(baked.resources), sortedResources(expected.resources));
+        EXPECT_EQ(baked.pushConstants, expected.pushConstants);
+
+        // fallback used when the sidecar is missing or outdated
+        EXPECT_EQ(baked, Reflection::fromSPIRV(code));
+    }
+}
+
+static Reflection makeReflection() {
+    Reflection reflection;
+    reflection.codeHash = 0x0123456789ABCDEFull;
+    reflection.resources.push_back(Reflection::Resource {
+        .name = "Camera",
+        .set = 0,
+        .binding = 0,
+        .type = ResourceType::UniformBuffer,
+    });
+    reflection.resources.push_back(Reflection::Resource {
+        .name = "textures",
+        .set = 1,
+        .binding = 3,
+        .type = ResourceType::SampledImage,
+        .count = 16,
+        .countConstant = "MAX_TEXTURES",
+    });
+    reflection.resources.push_back(Reflection::Resource {
+        .name = "topLevelAS",
+        .set = 2,
+        .binding = 1,
+        .type = ResourceType::AccelerationStructure,
+    });
+    reflection.pushConstants = Reflection::PushConstantBlock {
+        .name = "push",
+        .offset = 16,
+        .size = 48,
+    };
+    return reflection;
+}
+
+TEST(ShaderReflection, RoundTrip) {
+    const Reflection original = makeReflection();
+    EXPECT_EQ(original, Reflection::deserialise(original.serialise()));
+
+    Reflection withoutPushConstants = original;
+    withoutPushConstants.pushConstants.reset();
+    EXPECT_EQ(withoutPushConstants, Reflection::deserialise(withoutPushConstants.serialise()));
+
+    const Reflection empty;
+    EXPECT_EQ(empty, Reflection::deserialise(empty.serialise()));
+}
+
+TEST(ShaderReflection, RejectsInvalidData) {
+    const std::vector<std::uint8_t> data = makeReflection().serialise();
+    {
+        std::vector<std::uint8_t> wrongMagic = data;
+        wrongMagic[0] ^= 0xFF;
+        EXPECT_THROW(Reflection::deserialise(wrongMagic), std::runtime_error);
+    }
+    {
+        std::vector<std::uint8_t> wrongVersion = data;
+        const std::uint32_t version = Reflection::Version + 1;
+        memcpy(wrongVersion.data() + sizeof(std::uint32_t), &version, sizeof(version));
+        EXPECT_THROW(Reflection::deserialise(wrongVersion), std::runtime_error);
+    }
+    {
+        std::vector<std::uint8_t> truncated = data;
+        truncated.resize(truncated.size() - 1);
+        EXPECT_THROW(Reflection::deserialise(truncated), std::runtime_error);
+    }
+    {
+        // huge length for the name of the first resource
+        std::vector<std::uint8_t> corrupted = data;
+        const std::size_t firstNameOffset = 2 * sizeof(std::uint32_t) + sizeof(std::uint64_t) + sizeof(std::uint32_t);
+        const std::uint32_t length = 0xFFFFFFFFu;
+        memcpy(corrupted.data() + firstNameOffset, &length, sizeof(length));
+        EXPECT_THROW(Reflection::deserialise(corrupted), std::runtime_error);
+    }
+    EXPECT_THROW(Reflection::fromSPIRV(std::vector<std::uint8_t>(7)), std::runtime_error);
+}
+
+TEST(ShaderReflection, HashDetectsChanges) {
+    std::vector<std::uint8_t> code(256);
+    for(std::size_t i = 0; i < code.size(); i++) {
+        code[i] = static_cast<std::uint8_t>(i);
+    }
+    const std::uint64_t hash = Reflection::hashCode(code);
+    EXPECT_EQ(hash, Reflection::hashCode(code));
+    code[100] ^= 1;
+    EXPECT_NE(hash, Reflection::hashCode(code));
+}
@@ -0,0 +1,70 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "engine/Engine.h"
+#include "engine/ecs/World.h"
+#include "engine/ecs/components/Kinematics.h"
+#include "engine/ecs/components/TransformComponent.h"
+#include "engine/ecs/systems/SystemKinematics.h"
+
+#define _START_ENGINE_INTERNAL(APP_NAME)                    \
+Carrot::Configuration config;                               \
+config.applicationName = APP_NAME;                          \
+Carrot::Engine e{ config };
+
+#define START_ENGINE() _START_ENGINE_INTERNAL(__FUNCTION__)
+
+TEST(World, MoveContentRestoresSavedWorld) {
+    using namespace Carrot::ECS;
+
+    START_ENGINE();
+
+    World current;
+    current.addLogicSystem<SystemKinematics>();
+    Entity moving = current.newEntity("Moving").addComponent<TransformComponent>().addComponent<Kinematics>();
+    moving.getComponent<Kinematics>()->velocity = glm::vec3 { 1.0f, 0.0f, 0.0f };
+    current.tick(0.0);
+
+    // same steps as entering and leaving play mode in the editor
+    World saved;
+    saved = current;
+    current.tick(10.0);
+    EXPECT_NEAR(current.getComponent<TransformComponent>(moving.getID())->localTransform.position.x, 10.0f, 0.01f);
+
+    current.moveContentFrom(saved);
+    EXPECT_TRUE(saved.getAllEntities().empty());
+    EXPECT_TRUE(saved.getLogicSystems().empty());
+    ASSERT_TRUE(current.exists(moving.getID()));
+    auto transform = current.getComponent<TransformComponent>(moving.getID());
+    ASSERT_TRUE(transform.hasValue());
+    EXPECT_EQ(transform->localTransform.position.x, 0.0f);
+    EXPECT_EQ(&transform->getEntity().getWorld(), &current);
+
+    // systems were recreated for 'current'
+    ASSERT_EQ(current.getLogicSystems().size(), 1);
+    current.tick(5.0);
+    EXPECT_NEAR(current.getComponent<TransformComponent>(moving.getID())->localTransform.position.x, 5.0f, 0.01f);
+}
+
+TEST(World, SystemsDeclareComponentAccesses) {
+    using namespace Carrot::ECS;
+
+    START_ENGINE();
+
+    World world;
+    auto& kinematics = world.addLogicSystem<SystemKinematics>();
+    const Carrot::Async::ResourceAccess& access = kinematics.getComponentAccess();
+    EXPECT_FALSE(access.exclusive);
+    EXPECT_TRUE(access.writes.test(Carrot::Signature::getIndex(TransformComponent::getID())));
+    EXPECT_FALSE(access.writes.test(Carrot::Signature::getIndex(Kinematics::getID())));
+    EXPECT_TRUE(access.reads.test(Carrot::Signature::getIndex(Kinematics::getID())));
+
+    // scheduling must give the same result as running systems one after the other
+    Entity moving = world.newEntity("Moving").addComponent<TransformComponent>().addComponent<Kinematics>();
+    moving.getComponent<Kinematics>()->velocity = glm::vec3 { 0.0f, 2.0f, 0.0f };
+    world.tick(0.0);
+    world.tick(1.0);
+    EXPECT_NEAR(world.getComponent<TransformComponent>(moving.getID())->localTransform.position.y, 2.0f, 0.01f);
+}
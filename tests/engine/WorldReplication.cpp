@@ -0,0 +1,233 @@
+//
+// Created by jglrxavpok on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <deque>
+#include <random>
+#include "engine/Engine.h"
+#include "engine/ecs/World.h"
+#include "engine/ecs/components/Kinematics.h"
+#include "engine/ecs/components/TransformComponent.h"
+#include "engine/network/replication/WorldReplication.h"
+
+#define _START_ENGINE_INTERNAL(APP_NAME)                    \
+Carrot::Configuration config;                               \
+config.applicationName = APP_NAME;                          \
+Carrot::Engine e{ config };
+
+#define START_ENGINE() _START_ENGINE_INTERNAL(__FUNCTION__)
+
+using namespace Carrot::ECS;
+using namespace Carrot::Network::Replication;
+
+static void addTransformReplication(ReplicationRegistry& registry) {
+    registry.add<TransformComponent>()
+        .vector<glm::vec3>("position", Carrot::IO::Quantization::withPrecision(-1024.0f, 1024.0f, 0.01f),
+                           [](const TransformComponent& t) { return t.localTransform.position; },
+                           [](TransformComponent& t, const glm::vec3& v) { t.localTransform.position = v; })
+        .vector<glm::quat>("rotation", Carrot::IO::Quantization { .min = -1.0f, .max = 1.0f, .bits = 12 },
+                           [](const TransformComponent& t) { return t.localTransform.rotation; },
+                           [](TransformComponent& t, const glm::quat& q) { t.localTransform.rotation = q; })
+        .vector<glm::vec3>("scale", Carrot::IO::Quantization::withPrecision(0.0f, 16.0f, 0.01f),
+                           [](const TransformComponent& t) { return t.localTransform.scale; },
+                           [](TransformComponent& t, const glm::vec3& v) { t.localTransform.scale = v; });
+}
+
+/// Server world replicated to two in-process client worlds, snapshots and acknowledgements are delivered the next tick
+struct Loopback {
+    World& serverWorld;
+    WorldReplicator replicator;
+
+    struct ClientSide {
+        Carrot::UUID id;
+        World world;
+        WorldReplica replica;
+        std::deque<std::vector<std::uint8_t>> incoming;
+        std::size_t bytesReceived = 0;
+
+        explicit ClientSide(const ReplicationRegistry& registry): replica(world, registry) {}
+    };
+    std::vector<std::unique_ptr<ClientSide>> clients;
+    std::deque<std::pair<Carrot::UUID, Tick>> acks;
+
+    Loopback(World& serverWorld, const ReplicationRegistry& registry): serverWorld(serverWorld), replicator(serverWorld, registry) {
+        for(int i = 0; i < 2; i++) {
+            auto& client = clients.emplace_back(std::make_unique<ClientSide>(registry));
+            replicator.addClient(client->id);
+        }
+    }
+
+    void tick() {
+        serverWorld.tick(1.0 / 60.0);
+        for(const auto& [client, tick] : acks) {
+            replicator.acknowledge(client, tick);
+        }
+        acks.clear();
+
+        replicator.tick([&](const Carrot::UUID& clientID, std::vector<std::uint8_t>&& snapshot) {
+            for(auto& client : clients) {
+                if(client->id == clientID) {
+                    client->bytesReceived += snapshot.size();
+                    client->incoming.push_back(std::move(snapshot));
+                }
+            }
+        });
+
+        for(auto& client : clients) {
+            for(const auto& snapshot : client->incoming) {
+                if(auto tick = client->replica.apply(snapshot)) {
+                    acks.emplace_back(client->id, tick.value());
+                }
+            }
+            client->incoming.clear();
+            client->world.tick(1.0 / 60.0);
+        }
+    }
+
+    bool isSynchronised(float tolerance) const {
+        for(const auto& client : clients) {
+            for(const auto& serverEntity : serverWorld.getAllEntities()) {
+                auto serverTransform = serverWorld.getComponent<TransformComponent>(serverEntity.getID());
+                if(!serverTransform.hasValue()) {
+                    continue;
+                }
+                auto clientTransform = client->world.getComponent<TransformComponent>(serverEntity.getID());
+                if(!clientTransform.hasValue()) {
+                    return false;
+                }
+                if(glm::any(glm::greaterThan(glm::abs(clientTransform->localTransform.position - serverTransform->localTransform.position), glm::vec3(tolerance)))) {
+                    return false;
+                }
+            }
+            for(const auto& clientEntity : client->world.getAllEntities()) {
+                if(!serverWorld.exists(clientEntity.getID())) {
+                    return false;
+                }
+                // replicated components removed on the server must be removed on clients
+                if(client->world.getComponent<TransformComponent>(clientEntity.getID()).hasValue()
+                   && !serverWorld.getComponent<TransformComponent>(clientEntity.getID()).hasValue()) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+TEST(WorldReplication, LoopbackWith1kEntities) {
+    START_ENGINE();
+
+    ReplicationRegistry registry;
+    addTransformReplication(registry);
+
+    std::mt19937 rng { 42 };
+    std::uniform_real_distribution<float> position { -1000.0f, 1000.0f };
+
+    World serverWorld;
+    std::vector<Entity> entities;
+    for(int i = 0; i < 1000; i++) {
+        Entity entity = serverWorld.newEntity("Entity").addComponent<TransformComponent>();
+        entity.getComponent<TransformComponent>()->localTransform.position = glm::vec3 { position(rng), position(rng), position(rng) };
+        entities.push_back(entity);
+    }
+    // not replicated: no replicated component
+    serverWorld.newEntity("Local").addComponent<Kinematics>();
+
+    Loopback loopback { serverWorld, registry };
+
+    // initial state is sent over multiple ticks because of the bandwidth budget
+    int ticks = 0;
+    for(; ticks < 200 && !loopback.isSynchronised(0.01f); ticks++) {
+        loopback.tick();
+        for(const auto& client : loopback.clients) {
+            EXPECT_LE(loopback.replicator.getStatistics(client->id).bytes, WorldReplicator::DefaultBytesPerTick);
+        }
+    }
+    ASSERT_TRUE(loopback.isSynchronised(0.01f)) << "not synchronised after " << ticks << " ticks";
+    EXPECT_GT(ticks, 1);
+
+    // steady state: 10% of the entities move each tick
+    for(auto& client : loopback.clients) {
+        client->bytesReceived = 0;
+    }
+    constexpr int SteadyTicks = 60;
+    std::uniform_real_distribution<float> offset { -1.0f, 1.0f };
+    for(int tick = 0; tick < SteadyTicks; tick++) {
+        for(std::size_t i = 0; i < entities.size() / 10; i++) {
+            auto& transform = entities[rng() % entities.size()].getComponent<TransformComponent>()->localTransform;
+            transform.position += glm::vec3 { offset(rng), offset(rng), offset(rng) };
+        }
+        loopback.tick();
+    }
+    std::vector<double> bytesPerTick;
+    for(const auto& client : loopback.clients) {
+        bytesPerTick.push_back(static_cast<double>(client->bytesReceived) / SteadyTicks);
+    }
+
+    // let the last changes arrive, some may have been deferred by the budget
+    for(int tick = 0; tick < 50 && !loopback.isSynchronised(0.01f); tick++) {
+        loopback.tick();
+    }
+    EXPECT_TRUE(loopback.isSynchronised(0.01f));
+
+    for(double bytes : bytesPerTick) {
+        EXPECT_LE(bytes, WorldReplicator::DefaultBytesPerTick);
+        RecordProperty("BytesPerClientPerTick", std::to_string(bytes));
+    }
+}
+
+TEST(WorldReplication, ComponentAndEntityRemoval) {
+    START_ENGINE();
+
+    ReplicationRegistry registry;
+    addTransformReplication(registry);
+
+    World serverWorld;
+    Entity kept = serverWorld.newEntity("Kept").addComponent<TransformComponent>();
+    Entity removed = serverWorld.newEntity("Removed").addComponent<TransformComponent>();
+    Entity stripped = serverWorld.newEntity("Stripped").addComponent<TransformComponent>().addComponent<Kinematics>();
+    kept.getComponent<TransformComponent>()->localTransform.rotation = glm::angleAxis(1.0f, glm::vec3(0, 0, 1));
+
+    Loopback loopback { serverWorld, registry };
+    loopback.tick();
+    loopback.tick();
+    ASSERT_TRUE(loopback.isSynchronised(0.01f));
+
+    auto& clientWorld = loopback.clients[0]->world;
+    auto rotation = clientWorld.getComponent<TransformComponent>(kept.getID())->localTransform.rotation;
+    EXPECT_NEAR(glm::angle(rotation), 1.0f, 0.01f);
+    // only replicated components are created
+    EXPECT_FALSE(clientWorld.getComponent<Kinematics>(stripped.getID()).hasValue());
+
+    // client-side component, which is not replicated
+    clientWorld.wrap(stripped.getID()).addComponent<Kinematics>();
+
+    serverWorld.removeEntity(removed);
+    stripped.removeComponent<TransformComponent>();
+    loopback.tick();
+    loopback.tick();
+    loopback.tick();
+
+    EXPECT_TRUE(clientWorld.exists(kept.getID()));
+    EXPECT_FALSE(clientWorld.exists(removed.getID()));
+    // without replicated components, the entity is not destroyed: only its replicated components are removed
+    ASSERT_TRUE(clientWorld.exists(stripped.getID()));
+    EXPECT_FALSE(clientWorld.getComponent<TransformComponent>(stripped.getID()).hasValue());
+    EXPECT_TRUE(clientWorld.getComponent<Kinematics>(stripped.getID()).hasValue());
+    EXPECT_TRUE(loopback.isSynchronised(0.01f));
+
+    // replicated components come back on the same entity
+    stripped.addComponent<TransformComponent>();
+    stripped.getComponent<TransformComponent>()->localTransform.position = glm::vec3 { 1.0f, 2.0f, 3.0f };
+    loopback.tick();
+    loopback.tick();
+    loopback.tick();
+
+    ASSERT_TRUE(clientWorld.exists(stripped.getID()));
+    auto transform = clientWorld.getComponent<TransformComponent>(stripped.getID());
+    ASSERT_TRUE(transform.hasValue());
+    EXPECT_NEAR(transform->localTransform.position.y, 2.0f, 0.01f);
+    EXPECT_TRUE(clientWorld.getComponent<Kinematics>(stripped.getID()).hasValue());
+    EXPECT_TRUE(loopback.isSynchronised(0.01f));
+}